@@ -756,6 +756,7 @@ struct ipa_sys_connect_params {
  * struct ipa_tx_meta - metadata for the TX packet
  * @dma_address: dma mapped address of TX packet
  * @dma_address_valid: is above field valid?
+ * @xmit_more: more packets follow, the pipe doorbell may be left to them
  */
 struct ipa_tx_meta {
 	u8 pkt_init_dst_ep;
@@ -763,6 +764,7 @@ struct ipa_tx_meta {
 	bool pkt_init_dst_ep_remote;
 	dma_addr_t dma_address;
 	bool dma_address_valid;
+	bool xmit_more;
 };
 
 /**
@@ -1407,6 +1409,22 @@ struct ipa_socksv5_info {
 	uint16_t handle;
 };
 
+/**
+ * struct ipa_page_recycle_stats - rx page recycling counters of a pipe
+ * @total_replenished: pages posted to the rx ring
+ * @page_recycled: posted pages taken from the recycle list
+ * @tmp_alloc: posted pages taken from the tmp alloc cache
+ * @alloc_fail: replenish passes that stopped with both sources empty
+ * @sort_tasklet_sched: times the free page sort tasklet was scheduled
+ */
+struct ipa_page_recycle_stats {
+	u64 total_replenished;
+	u64 page_recycled;
+	u64 tmp_alloc;
+	u64 alloc_fail;
+	u64 sort_tasklet_sched;
+};
+
 struct ipa_ipv6_nat_uc_tmpl {
 	uint16_t cmd_id;
 	uint16_t rsv;
@@ -1643,6 +1661,18 @@ int ipa_register_notifier(void *fn_ptr);
  */
 int ipa_unregister_notifier(void *fn_ptr);
 
+/*
+ * ipa_get_page_recycle_stats - Get rx page recycling stats of a pipe
+ *
+ * @client - WAN_COAL, WAN or low latency data consumer
+ * @stats - [out] recycle counters of the pipe
+ *
+ * This funciton will return 0 on success, -EINVAL if the client does not
+ * use page recycling.
+ */
+int ipa_get_page_recycle_stats(enum ipa_client_type client,
+	struct ipa_page_recycle_stats *stats);
+
 void ipa_free_skb(struct ipa_rx_data *data);
 
 /*
@@ -2083,6 +2113,12 @@ static inline int ipa_unregister_notifier(void *fn_ptr)
 	return -EPERM;
 }
 
+static inline int ipa_get_page_recycle_stats(enum ipa_client_type client,
+	struct ipa_page_recycle_stats *stats)
+{
+	return -EPERM;
+}
+
 static inline void ipa_free_skb(struct ipa_rx_data *rx_in)
 {
 }
@@ -5931,6 +5931,7 @@ int _ipa_init_rt4_v3(void)
 		i++)
 		ipa3_ctx->rt_idx_bitmap[IPA_IP_v4] |= (1 << i);
 	IPADBG("v4 rt bitmap 0x%lx\n", ipa3_ctx->rt_idx_bitmap[IPA_IP_v4]);
+	ipa3_ctx->rt_tbl_set[IPA_IP_v4].layout_dirty = true;
 
 	rc = ipahal_rt_generate_empty_img(IPA_MEM_PART(v4_rt_num_index),
 		IPA_MEM_PART(v4_rt_hash_size), IPA_MEM_PART(v4_rt_nhash_size),
@@ -6005,6 +6006,7 @@ int _ipa_init_rt6_v3(void)
 		i++)
 		ipa3_ctx->rt_idx_bitmap[IPA_IP_v6] |= (1 << i);
 	IPADBG("v6 rt bitmap 0x%lx\n", ipa3_ctx->rt_idx_bitmap[IPA_IP_v6]);
+	ipa3_ctx->rt_tbl_set[IPA_IP_v6].layout_dirty = true;
 
 	rc = ipahal_rt_generate_empty_img(IPA_MEM_PART(v6_rt_num_index),
 		IPA_MEM_PART(v6_rt_hash_size), IPA_MEM_PART(v6_rt_nhash_size),
@@ -6073,6 +6075,8 @@ int _ipa_init_flt4_v3(void)
 	struct ipahal_imm_cmd_pyld *cmd_pyld;
 	int rc;
 
+	ipa3_ctx->flt_layout_dirty[IPA_IP_v4] = true;
+
 	rc = ipahal_flt_generate_empty_img(ipa3_ctx->ep_flt_num,
 		IPA_MEM_PART(v4_flt_hash_size),
 		IPA_MEM_PART(v4_flt_nhash_size), ipa3_ctx->ep_flt_bitmap,
@@ -6141,6 +6145,8 @@ int _ipa_init_flt6_v3(void)
 	struct ipahal_imm_cmd_pyld *cmd_pyld;
 	int rc;
 
+	ipa3_ctx->flt_layout_dirty[IPA_IP_v6] = true;
+
 	rc = ipahal_flt_generate_empty_img(ipa3_ctx->ep_flt_num,
 		IPA_MEM_PART(v6_flt_hash_size),
 		IPA_MEM_PART(v6_flt_nhash_size), ipa3_ctx->ep_flt_bitmap,
@@ -9402,6 +9408,8 @@ static int ipa3_pre_init(const struct ipa3_plat_drv_res *resource_p,
 	ipa3_ctx->lan_rx_napi_enable = resource_p->lan_rx_napi_enable;
 	ipa3_ctx->tx_napi_enable = resource_p->tx_napi_enable;
 	ipa3_ctx->tx_poll = resource_p->tx_poll;
+	ipa3_ctx->tx_db_batch_budget = IPA_TX_DB_BATCH_BUDGET_DFLT;
+	ipa3_ctx->tx_db_batch_timeout_us = IPA_TX_DB_BATCH_TIMEOUT_US_DFLT;
 	ipa3_ctx->ipa_gpi_event_rp_ddr = resource_p->ipa_gpi_event_rp_ddr;
 	ipa3_ctx->rmnet_ctl_enable = resource_p->rmnet_ctl_enable;
 	ipa3_ctx->lan_coal_enable = resource_p->lan_coal_enable;
@@ -9780,6 +9788,7 @@ static int ipa3_pre_init(const struct ipa3_plat_drv_res *resource_p,
 	/* Init the various list heads for both SRAM/DDR */
 	for (hdr_tbl = HDR_TBL_LCL; hdr_tbl < HDR_TBLS_TOTAL; hdr_tbl++) {
 		INIT_LIST_HEAD(&ipa3_ctx->hdr_tbl[hdr_tbl].head_hdr_entry_list);
+		hash_init(ipa3_ctx->hdr_tbl[hdr_tbl].name_htable);
 		for (i = 0; i < IPA_HDR_BIN_MAX; i++) {
 			INIT_LIST_HEAD(&ipa3_ctx->hdr_tbl[hdr_tbl].head_offset_list[i]);
 			INIT_LIST_HEAD(&ipa3_ctx->hdr_tbl[hdr_tbl].head_free_offset_list[i]);
@@ -9792,10 +9801,13 @@ static int ipa3_pre_init(const struct ipa3_plat_drv_res *resource_p,
 		INIT_LIST_HEAD(
 			&ipa3_ctx->hdr_proc_ctx_tbl.head_free_offset_list[i]);
 	}
+	ipa3_ctx->fltrt_dirty_commit = true;
 	INIT_LIST_HEAD(&ipa3_ctx->rt_tbl_set[IPA_IP_v4].head_rt_tbl_list);
 	idr_init(&ipa3_ctx->rt_tbl_set[IPA_IP_v4].rule_ids);
+	hash_init(ipa3_ctx->rt_tbl_set[IPA_IP_v4].name_htable);
 	INIT_LIST_HEAD(&ipa3_ctx->rt_tbl_set[IPA_IP_v6].head_rt_tbl_list);
 	idr_init(&ipa3_ctx->rt_tbl_set[IPA_IP_v6].rule_ids);
+	hash_init(ipa3_ctx->rt_tbl_set[IPA_IP_v6].name_htable);
 
 	rset = &ipa3_ctx->reap_rt_tbl_set[IPA_IP_v4];
 	INIT_LIST_HEAD(&rset->head_rt_tbl_list);
@@ -1613,6 +1613,181 @@ static ssize_t ipa3_read_stats(struct file *file, char __user *ubuf,
 	return simple_read_from_buffer(ubuf, count, ppos, dbg_buff, cnt);
 }
 
+static int ipa3_print_fltrt_commit_stats(char *buf, int size,
+	const char *name, struct ipa3_fltrt_commit_stats *stats)
+{
+	return scnprintf(buf, size,
+		"%s: full=%llu dirty=%llu fallback=%llu\n"
+		"%s: rebuild_ns=%llu max_rebuild_ns=%llu\n"
+		"%s: bytes_dma=%llu bytes_sys=%llu\n",
+		name, stats->full, stats->dirty, stats->fallback,
+		name, stats->rebuild_ns, stats->max_rebuild_ns,
+		name, stats->bytes_dma, stats->bytes_sys);
+}
+
+static ssize_t ipa3_read_fltrt_commit(struct file *file, char __user *ubuf,
+		size_t count, loff_t *ppos)
+{
+	int cnt;
+
+	cnt = scnprintf(dbg_buff, IPA_MAX_MSG_LEN, "dirty_commit=%u\n",
+		ipa3_ctx->fltrt_dirty_commit);
+	cnt += ipa3_print_fltrt_commit_stats(dbg_buff + cnt,
+		IPA_MAX_MSG_LEN - cnt, "ip4_rt",
+		&ipa3_ctx->rt_commit_stats[IPA_IP_v4]);
+	cnt += ipa3_print_fltrt_commit_stats(dbg_buff + cnt,
+		IPA_MAX_MSG_LEN - cnt, "ip6_rt",
+		&ipa3_ctx->rt_commit_stats[IPA_IP_v6]);
+	cnt += ipa3_print_fltrt_commit_stats(dbg_buff + cnt,
+		IPA_MAX_MSG_LEN - cnt, "ip4_flt",
+		&ipa3_ctx->flt_commit_stats[IPA_IP_v4]);
+	cnt += ipa3_print_fltrt_commit_stats(dbg_buff + cnt,
+		IPA_MAX_MSG_LEN - cnt, "ip6_flt",
+		&ipa3_ctx->flt_commit_stats[IPA_IP_v6]);
+
+	return simple_read_from_buffer(ubuf, count, ppos, dbg_buff, cnt);
+}
+
+static ssize_t ipa3_write_fltrt_commit(struct file *file,
+		const char __user *buf, size_t count, loff_t *ppos)
+{
+	int ret;
+	u8 dirty_commit;
+
+	if (count >= sizeof(dbg_buff))
+		return -EFAULT;
+
+	ret = kstrtou8_from_user(buf, count, 0, &dirty_commit);
+	if (ret)
+		return ret;
+
+	/* 0 commits all the flt/rt tables on every commit */
+	mutex_lock(&ipa3_ctx->lock);
+	ipa3_ctx->fltrt_dirty_commit = dirty_commit;
+	mutex_unlock(&ipa3_ctx->lock);
+
+	return count;
+}
+
+static ssize_t ipa3_read_tx_db_batch(struct file *file, char __user *ubuf,
+		size_t count, loff_t *ppos)
+{
+	struct ipa3_sys_context *sys;
+	struct ipa3_tx_db_stats stats;
+	int cnt;
+	int i;
+
+	cnt = scnprintf(dbg_buff, IPA_MAX_MSG_LEN,
+		"budget=%u timeout_us=%u\n",
+		ipa3_ctx->tx_db_batch_budget,
+		ipa3_ctx->tx_db_batch_timeout_us);
+
+	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
+		sys = ipa3_ctx->ep[i].sys;
+		if (!ipa3_ctx->ep[i].valid || !sys ||
+			!IPA_CLIENT_IS_PROD(ipa3_ctx->ep[i].client))
+			continue;
+
+		spin_lock_bh(&sys->spinlock);
+		stats = sys->db_stats;
+		spin_unlock_bh(&sys->spinlock);
+
+		cnt += scnprintf(dbg_buff + cnt, IPA_MAX_MSG_LEN - cnt,
+			"%s: rings=%llu descs=%llu desc_per_db=%llu max=%u deferred=%llu budget=%llu timeout=%llu\n",
+			ipa_clients_strings[ipa3_ctx->ep[i].client],
+			stats.rings, stats.descs,
+			stats.rings ? div64_u64(stats.descs, stats.rings) : 0,
+			stats.max_batch, stats.deferred, stats.budget,
+			stats.timeout);
+	}
+
+	return simple_read_from_buffer(ubuf, count, ppos, dbg_buff, cnt);
+}
+
+static ssize_t ipa3_write_tx_db_batch(struct file *file,
+		const char __user *buf, size_t count, loff_t *ppos)
+{
+	int ret;
+	u32 budget;
+
+	if (count >= sizeof(dbg_buff))
+		return -EFAULT;
+
+	ret = kstrtou32_from_user(buf, count, 0, &budget);
+	if (ret)
+		return ret;
+
+	/* 0 rings the doorbell on every send */
+	ipa3_ctx->tx_db_batch_budget = budget;
+
+	return count;
+}
+
+static int ipa3_print_rx_mod_hist(char *buf, int len, const char *name,
+	const u64 *hist)
+{
+	int cnt;
+	int i;
+
+	cnt = scnprintf(buf, len, "  %s:", name);
+	for (i = 0; i < IPA_RX_MOD_HIST_BUCKETS; i++)
+		cnt += scnprintf(buf + cnt, len - cnt, " %llu", hist[i]);
+	cnt += scnprintf(buf + cnt, len - cnt, "\n");
+
+	return cnt;
+}
+
+static ssize_t ipa3_read_rx_moderation(struct file *file, char __user *ubuf,
+		size_t count, loff_t *ppos)
+{
+	struct ipa3_sys_context *sys;
+	struct ipa3_rx_mod_ctx mod;
+	int cnt;
+	int i;
+
+	cnt = scnprintf(dbg_buff, IPA_MAX_MSG_LEN,
+		"pinned=%u\nhist buckets (usec): <4 <16 <64 <256 <1K <4K <16K more\n",
+		ipa3_ctx->rx_mod_pinned);
+
+	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
+		sys = ipa3_ctx->ep[i].sys;
+		if (!ipa3_ctx->ep[i].valid || !sys ||
+			!IPA_CLIENT_IS_CONS(ipa3_ctx->ep[i].client))
+			continue;
+
+		mod = sys->rx_mod;
+		cnt += scnprintf(dbg_buff + cnt, IPA_MAX_MSG_LEN - cnt,
+			"%s: rate=%u/ms linger_us=%u lingered=%llu\n",
+			ipa_clients_strings[ipa3_ctx->ep[i].client],
+			mod.rate, mod.linger_us, mod.lingered);
+		cnt += ipa3_print_rx_mod_hist(dbg_buff + cnt,
+			IPA_MAX_MSG_LEN - cnt, "intr", mod.intr_hist);
+		cnt += ipa3_print_rx_mod_hist(dbg_buff + cnt,
+			IPA_MAX_MSG_LEN - cnt, "poll", mod.poll_hist);
+	}
+
+	return simple_read_from_buffer(ubuf, count, ppos, dbg_buff, cnt);
+}
+
+static ssize_t ipa3_write_rx_moderation(struct file *file,
+		const char __user *buf, size_t count, loff_t *ppos)
+{
+	int ret;
+	bool pinned;
+
+	if (count >= sizeof(dbg_buff))
+		return -EFAULT;
+
+	ret = kstrtobool_from_user(buf, count, &pinned);
+	if (ret)
+		return ret;
+
+	/* 1 goes back to the fixed interrupt/poll switching */
+	ipa3_ctx->rx_mod_pinned = pinned;
+
+	return count;
+}
+
 static ssize_t ipa3_read_odlstats(struct file *file, char __user *ubuf,
 		size_t count, loff_t *ppos)
 {
@@ -1646,35 +1821,51 @@ static ssize_t ipa3_read_page_recycle_stats(struct file *file,
 		"COAL   : Total number of packets replenished =%llu\n"
 		"COAL   : Number of page recycled packets  =%llu\n"
 		"COAL   : Number of tmp alloc packets  =%llu\n"
+		"COAL   : Number of replenish alloc failures  =%llu\n"
 		"COAL   : Number of times tasklet scheduled  =%llu\n"
 
 		"DEF    : Total number of packets replenished =%llu\n"
 		"DEF    : Number of page recycled packets =%llu\n"
 		"DEF    : Number of tmp alloc packets  =%llu\n"
+		"DEF    : Number of replenish alloc failures  =%llu\n"
 		"DEF    : Number of times tasklet scheduled  =%llu\n"
 
+		"LL     : Total number of packets replenished =%llu\n"
+		"LL     : Number of page recycled packets =%llu\n"
+		"LL     : Number of tmp alloc packets  =%llu\n"
+		"LL     : Number of replenish alloc failures  =%llu\n"
+		"LL     : Number of times tasklet scheduled  =%llu\n"
+
 		"COMMON : Number of page recycled in tasklet  =%llu\n"
 		"COMMON : Number of times free pages not found in tasklet =%llu\n",
 
 		ipa3_ctx->stats.page_recycle_stats[0].total_replenished,
 		ipa3_ctx->stats.page_recycle_stats[0].page_recycled,
 		ipa3_ctx->stats.page_recycle_stats[0].tmp_alloc,
+		ipa3_ctx->stats.page_recycle_stats[0].alloc_fail,
 		ipa3_ctx->stats.num_sort_tasklet_sched[0],
 
 		ipa3_ctx->stats.page_recycle_stats[1].total_replenished,
 		ipa3_ctx->stats.page_recycle_stats[1].page_recycled,
 		ipa3_ctx->stats.page_recycle_stats[1].tmp_alloc,
+		ipa3_ctx->stats.page_recycle_stats[1].alloc_fail,
 		ipa3_ctx->stats.num_sort_tasklet_sched[1],
 
+		ipa3_ctx->stats.page_recycle_stats[2].total_replenished,
+		ipa3_ctx->stats.page_recycle_stats[2].page_recycled,
+		ipa3_ctx->stats.page_recycle_stats[2].tmp_alloc,
+		ipa3_ctx->stats.page_recycle_stats[2].alloc_fail,
+		ipa3_ctx->stats.num_sort_tasklet_sched[2],
+
 		ipa3_ctx->stats.page_recycle_cnt_in_tasklet,
 		ipa3_ctx->stats.num_of_times_wq_reschd);
 
 	cnt += nbytes;
 
-	for (k = 0; k < 2; k++) {
+	for (k = 0; k < ARRAY_SIZE(ipa3_ctx->stats.page_recycle_stats); k++) {
 		for (i = 0; i < ipa3_ctx->page_poll_threshold; i++) {
 			nbytes = scnprintf(
-				dbg_buff + cnt, IPA_MAX_MSG_LEN,
+				dbg_buff + cnt, IPA_MAX_MSG_LEN - cnt,
 				"COMMON  : Page replenish efficiency[%d][%d]  =%llu\n",
 				k, i, ipa3_ctx->stats.page_recycle_cnt[k][i]);
 			cnt += nbytes;
@@ -4139,10 +4330,25 @@ static const struct ipa3_debugfs_file debugfs_files[] = {
 			.read = ipa3_read_flt_hw,
 			.open = ipa3_open_dbg,
 		}
+	}, {
+		"fltrt_commit", IPA_READ_WRITE_MODE, NULL, {
+			.read = ipa3_read_fltrt_commit,
+			.write = ipa3_write_fltrt_commit,
+		}
 	}, {
 		"stats", IPA_READ_ONLY_MODE, NULL, {
 			.read = ipa3_read_stats,
 		}
+	}, {
+		"tx_db_batch", IPA_READ_WRITE_MODE, NULL, {
+			.read = ipa3_read_tx_db_batch,
+			.write = ipa3_write_tx_db_batch,
+		}
+	}, {
+		"rx_moderation", IPA_READ_WRITE_MODE, NULL, {
+			.read = ipa3_read_rx_moderation,
+			.write = ipa3_write_rx_moderation,
+		}
 	}, {
 		"wstats", IPA_READ_ONLY_MODE, NULL, {
 			.read = ipa3_read_wstats,
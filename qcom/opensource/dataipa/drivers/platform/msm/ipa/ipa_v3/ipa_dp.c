@@ -41,6 +41,11 @@
 #define POLLING_INACTIVITY_TX 40
 #define POLLING_MIN_SLEEP_TX 400
 #define POLLING_MAX_SLEEP_TX 500
+/* adaptive rx moderation: packet rates are in packets per ms */
+#define IPA_RX_MOD_RATE_HIGH 64
+#define IPA_RX_MOD_RATE_LOW 8
+#define IPA_RX_MOD_LINGER_US_MAX 200
+#define IPA_RX_MOD_INACTIVITY_MIN 4
 #define SUSPEND_MIN_SLEEP_RX 1000
 #define SUSPEND_MAX_SLEEP_RX 1005
 /* 8K less 1 nominal MTU (1500 bytes) rounded to units of KB */
@@ -530,6 +535,51 @@ poll_tx:
 	return min(tx_done, budget);
 }
 
+/*
+ * account for the doorbell just rung for the descriptors pending on the
+ * channel, sys->spinlock held
+ */
+static void ipa3_tx_db_rung(struct ipa3_sys_context *sys, bool batched)
+{
+	struct ipa3_tx_db_stats *stats = &sys->db_stats;
+
+	stats->rings++;
+	stats->descs += sys->db_pending;
+	if (sys->db_pending > stats->max_batch)
+		stats->max_batch = sys->db_pending;
+	sys->db_pending = 0;
+	if (batched)
+		hrtimer_try_to_cancel(&sys->db_batch_timer);
+}
+
+/* ring the doorbell of a deferred batch, sys->spinlock held */
+static void ipa3_tx_db_flush(struct ipa3_sys_context *sys)
+{
+	if (!sys->db_pending)
+		return;
+
+	if (gsi_queue_xfer(sys->ep->gsi_chan_hdl, 0, NULL, true)) {
+		IPAERR_RL("ch:%lu doorbell failed\n", sys->ep->gsi_chan_hdl);
+		return;
+	}
+	ipa3_tx_db_rung(sys, true);
+}
+
+static enum hrtimer_restart ipa3_tx_db_batch_timer_fn(struct hrtimer *param)
+{
+	struct ipa3_sys_context *sys = container_of(param,
+		struct ipa3_sys_context, db_batch_timer);
+
+	spin_lock_bh(&sys->spinlock);
+	if (sys->db_pending) {
+		sys->db_stats.timeout++;
+		ipa3_tx_db_flush(sys);
+	}
+	spin_unlock_bh(&sys->spinlock);
+
+	return HRTIMER_NORESTART;
+}
+
 static void ipa3_send_nop_desc(struct work_struct *work)
 {
 	struct ipa3_sys_context *sys = container_of(work,
@@ -586,6 +636,9 @@ static void ipa3_send_nop_desc(struct work_struct *work)
 	}
 	sys->len++;
 	sys->nop_pending = false;
+	/* the NOP doorbell also covers a deferred batch */
+	sys->db_pending++;
+	ipa3_tx_db_rung(sys, sys->db_pending > 1);
 	spin_unlock_bh(&sys->spinlock);
 
 	/* make sure TAG process is sent before clocks are gated */
@@ -594,11 +647,12 @@ static void ipa3_send_nop_desc(struct work_struct *work)
 
 
 /**
- * ipa3_send() - Send multiple descriptors in one HW transaction
+ * __ipa3_send() - Send multiple descriptors in one HW transaction
  * @sys: system pipe context
  * @num_desc: number of packets
  * @desc: packets to send (may be immediate command or data)
  * @in_atomic:  whether caller is in atomic context
+ * @xmit_more: more packets follow, the doorbell may be left to them
  *
  * This function is used for GPI connection.
  * - ipa3_tx_pkt_wrapper will be used for each ipa
@@ -607,13 +661,17 @@ static void ipa3_send_nop_desc(struct work_struct *work)
  *   contain information which will be later used by the user callbacks
  * - Each packet (command or data) that will be sent will also be saved in
  *   ipa3_sys_context for later check that all data was sent
+ * - With @xmit_more the channel doorbell is not rung until a send without
+ *   it, tx_db_batch_budget descriptors are pending, or the batch timer
+ *   fires, so a burst of packets costs one doorbell write
  *
  * Return codes: 0: success, -EFAULT: failure
  */
-int ipa3_send(struct ipa3_sys_context *sys,
+static int __ipa3_send(struct ipa3_sys_context *sys,
 		u32 num_desc,
 		struct ipa3_desc *desc,
-		bool in_atomic)
+		bool in_atomic,
+		bool xmit_more)
 {
 	struct ipa3_tx_pkt_wrapper *tx_pkt, *tx_pkt_first = NULL;
 	struct ipahal_imm_cmd_pyld *tag_pyld_ret = NULL;
@@ -626,6 +684,9 @@ int ipa3_send(struct ipa3_sys_context *sys,
 	const struct ipa_gsi_ep_config *gsi_ep_cfg;
 	bool send_nop = false;
 	unsigned int max_desc;
+	u32 budget = ipa3_ctx->tx_db_batch_budget;
+	bool ring_db;
+	bool batched;
 
 	if (unlikely(!in_atomic))
 		mem_flag = GFP_KERNEL;
@@ -785,15 +846,34 @@ int ipa3_send(struct ipa3_sys_context *sys,
 		}
 	}
 
+	batched = sys->db_pending;
+	ring_db = !xmit_more || !budget || sys->db_pending + num_desc >= budget;
+
 	IPADBG_LOW("ch:%lu queue xfer\n", sys->ep->gsi_chan_hdl);
 	result = gsi_queue_xfer(sys->ep->gsi_chan_hdl, num_desc,
-			gsi_xfer, true);
+			gsi_xfer, ring_db);
 	if (result != GSI_STATUS_SUCCESS) {
 		IPAERR_RL("GSI xfer failed.\n");
+		/* let the hw drain the batch, the ring may be full of it */
+		ipa3_tx_db_flush(sys);
 		result = -EFAULT;
 		goto failure;
 	}
 
+	sys->db_pending += num_desc;
+	if (ring_db) {
+		if (xmit_more && budget)
+			sys->db_stats.budget++;
+		ipa3_tx_db_rung(sys, batched);
+	} else {
+		sys->db_stats.deferred++;
+		if (!batched)
+			hrtimer_start(&sys->db_batch_timer,
+				ns_to_ktime((u64)ipa3_ctx->tx_db_batch_timeout_us *
+					NSEC_PER_USEC),
+				HRTIMER_MODE_REL_SOFT);
+	}
+
 	if (send_nop && !sys->nop_pending)
 		sys->nop_pending = true;
 	else
@@ -847,6 +927,26 @@ failure:
 	return result;
 }
 
+/**
+ * ipa3_send() - Send multiple descriptors in one HW transaction
+ * @sys: system pipe context
+ * @num_desc: number of packets
+ * @desc: packets to send (may be immediate command or data)
+ * @in_atomic:  whether caller is in atomic context
+ *
+ * Rings the channel doorbell, for these descriptors and any deferred before
+ * them. See __ipa3_send().
+ *
+ * Return codes: 0: success, -EFAULT: failure
+ */
+int ipa3_send(struct ipa3_sys_context *sys,
+		u32 num_desc,
+		struct ipa3_desc *desc,
+		bool in_atomic)
+{
+	return __ipa3_send(sys, num_desc, desc, in_atomic, false);
+}
+
 /**
  * ipa3_send_one() - Send a single descriptor
  * @sys:	system pipe context
@@ -1154,6 +1254,106 @@ static int ipa3_tx_switch_to_intr_mode(struct ipa3_sys_context *sys) {
 	return ret;
 }
 
+/* log4 usec buckets: <4us, <16us, ... <16ms, longer */
+static void ipa3_rx_mod_hist_add(u64 *hist, ktime_t start, ktime_t end)
+{
+	s64 us = ktime_us_delta(end, start);
+	int bucket = 0;
+
+	if (!ktime_to_ns(start))
+		return;
+
+	if (us > 0)
+		bucket = min_t(int, ilog2(us) / 2,
+			IPA_RX_MOD_HIST_BUCKETS - 1);
+	hist[bucket]++;
+}
+
+static void ipa3_rx_mod_enter_poll(struct ipa3_sys_context *sys)
+{
+	struct ipa3_rx_mod_ctx *mod = &sys->rx_mod;
+	ktime_t now = ktime_get();
+
+	ipa3_rx_mod_hist_add(mod->intr_hist, mod->mode_ts, now);
+	mod->mode_ts = now;
+	mod->linger_until = now;
+}
+
+/*
+ * Measure the packet rate of the interrupt + polling cycle that just ended
+ * and pick how long the pipe lingers in polling mode on the next cycle.
+ */
+static void ipa3_rx_mod_enter_intr(struct ipa3_sys_context *sys)
+{
+	struct ipa3_rx_mod_ctx *mod = &sys->rx_mod;
+	ktime_t now = ktime_get();
+	s64 cycle_us;
+	u32 rate;
+
+	ipa3_rx_mod_hist_add(mod->poll_hist, mod->mode_ts, now);
+	mod->mode_ts = now;
+
+	cycle_us = ktime_us_delta(now, mod->cycle_ts);
+	if (ktime_to_ns(mod->cycle_ts) && cycle_us > 0) {
+		rate = div64_u64(mod->cycle_pkts * USEC_PER_MSEC, cycle_us);
+		mod->rate = (3 * mod->rate + rate) / 4;
+	}
+	mod->cycle_ts = now;
+	mod->cycle_pkts = 0;
+
+	if (mod->rate >= IPA_RX_MOD_RATE_HIGH)
+		mod->linger_us = IPA_RX_MOD_LINGER_US_MAX;
+	else if (mod->rate >= IPA_RX_MOD_RATE_LOW)
+		mod->linger_us = IPA_RX_MOD_LINGER_US_MAX / 4;
+	else
+		mod->linger_us = 0;
+}
+
+static inline void ipa3_rx_mod_account(struct ipa3_sys_context *sys, int cnt)
+{
+	if (cnt > 0)
+		sys->rx_mod.cycle_pkts += cnt;
+}
+
+/**
+ * ipa3_rx_mod_linger() - check if a NAPI poll that ran out of work should
+ * keep the pipe in polling mode
+ * @sys: rx pipe being polled
+ * @cnt: work done by the poll
+ *
+ * Busy pipes keep polling for linger_us after the last poll that found
+ * work, so the next packets of a burst do not cost an interrupt and a
+ * NAPI schedule. Idle pipes go back to interrupt mode right away.
+ *
+ * Returns true if the pipe should stay in polling mode
+ */
+static bool ipa3_rx_mod_linger(struct ipa3_sys_context *sys, int cnt)
+{
+	struct ipa3_rx_mod_ctx *mod = &sys->rx_mod;
+	ktime_t now;
+
+	if (ipa3_ctx->rx_mod_pinned || !mod->linger_us)
+		return false;
+
+	now = ktime_get();
+	if (cnt > 0)
+		mod->linger_until = ktime_add_us(now, mod->linger_us);
+	if (ktime_after(now, mod->linger_until))
+		return false;
+
+	mod->lingered++;
+	return true;
+}
+
+/* idle polling cycles before a workqueue polled pipe re-arms its interrupt */
+static int ipa3_rx_mod_inactivity(struct ipa3_sys_context *sys)
+{
+	if (ipa3_ctx->rx_mod_pinned || sys->rx_mod.linger_us)
+		return POLLING_INACTIVITY_RX;
+
+	return IPA_RX_MOD_INACTIVITY_MIN;
+}
+
 /**
  * ipa3_rx_switch_to_intr_mode() - Operate the Rx data path in interrupt mode
  */
@@ -1163,6 +1363,7 @@ static int ipa3_rx_switch_to_intr_mode(struct ipa3_sys_context *sys)
 
 	atomic_set(&sys->curr_polling_state, 0);
 	__ipa3_update_curr_poll_state(sys->ep->client, 0);
+	ipa3_rx_mod_enter_intr(sys);
 	ipa_pm_deferred_deactivate(sys->pm_hdl);
 	ipa3_dec_release_wakelock();
 	ret = gsi_config_channel_mode(sys->ep->gsi_chan_hdl,
@@ -1173,6 +1374,7 @@ static int ipa3_rx_switch_to_intr_mode(struct ipa3_sys_context *sys)
 			ipa3_inc_acquire_wakelock();
 			atomic_set(&sys->curr_polling_state, 1);
 			__ipa3_update_curr_poll_state(sys->ep->client, 1);
+			ipa3_rx_mod_enter_poll(sys);
 		} else {
 			IPAERR("Failed to switch to intr mode %d ch_id %d\n",
 			 sys->curr_polling_state, sys->ep->gsi_chan_hdl);
@@ -1194,14 +1396,17 @@ static void ipa3_handle_rx(struct ipa3_sys_context *sys)
 {
 	enum ipa_client_type client_type;
 	int inactive_cycles;
+	int max_inactive;
 	int cnt;
 	int ret;
 
 start_poll:
 	ipa_pm_activate_sync(sys->pm_hdl);
 	inactive_cycles = 0;
+	max_inactive = ipa3_rx_mod_inactivity(sys);
 	do {
 		cnt = ipa3_handle_rx_core(sys, true, true);
+		ipa3_rx_mod_account(sys, cnt);
 		if (cnt == 0)
 			inactive_cycles++;
 		else
@@ -1219,7 +1424,7 @@ start_poll:
 		if (sys->len == 0)
 			break;
 
-	} while (inactive_cycles <= POLLING_INACTIVITY_RX);
+	} while (inactive_cycles <= max_inactive);
 
 	trace_poll_to_intr3(sys->ep->client);
 	ret = ipa3_rx_switch_to_intr_mode(sys);
@@ -1535,6 +1740,9 @@ int ipa_setup_sys_pipe(struct ipa_sys_connect_params *sys_in, u32 *clnt_hdl)
 		hrtimer_init(&ep->sys->db_timer, CLOCK_MONOTONIC,
 			HRTIMER_MODE_REL);
 		ep->sys->db_timer.function = ipa3_ring_doorbell_timer_fn;
+		hrtimer_init(&ep->sys->db_batch_timer, CLOCK_MONOTONIC,
+			HRTIMER_MODE_REL_SOFT);
+		ep->sys->db_batch_timer.function = ipa3_tx_db_batch_timer_fn;
 
 		/* create IPA PM resources for handling polling mode */
 		if (sys_in->client == IPA_CLIENT_APPS_WAN_CONS &&
@@ -1992,6 +2200,7 @@ int ipa_teardown_sys_pipe(u32 clnt_hdl)
 		do {
 			spin_lock_bh(&ep->sys->spinlock);
 			atomic_set(&ep->disconnect_in_progress, 1);
+			ipa3_tx_db_flush(ep->sys);
 			empty = list_empty(&ep->sys->head_desc_list);
 			spin_unlock_bh(&ep->sys->spinlock);
 			if (!empty)
@@ -1999,6 +2208,7 @@ int ipa_teardown_sys_pipe(u32 clnt_hdl)
 			else
 				break;
 		} while (1);
+		hrtimer_cancel(&ep->sys->db_batch_timer);
 
 		delete_avail_tx_wrapper_list(ep);
 		/* Delete NAPI TX object. For WAN_PROD, it is deleted
@@ -2337,6 +2547,9 @@ void ipa3_tx_cmd_comp(void *user1, int user2)
  * Once this send was done from transport point-of-view the IPA driver will
  * get notified by the supplied callback.
  *
+ * If meta->xmit_more is set the pipe doorbell may be left to the packets that
+ * follow, the caller must then send one without it before going idle.
+ *
  * Returns:	0 on success, negative on failure
  */
 int ipa_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
@@ -2352,6 +2565,7 @@ int ipa_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 	int data_idx;
 	unsigned int max_desc;
 	enum ipa_client_type type;
+	bool xmit_more = meta && meta->xmit_more;
 
 	if (unlikely(!ipa3_ctx)) {
 		IPAERR("IPA3 driver was not initialized\n");
@@ -2521,7 +2735,8 @@ int ipa_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 			desc[skb_idx].callback = NULL;
 		}
 
-		if (ipa3_send(sys, num_frags + data_idx, desc, true)) {
+		if (__ipa3_send(sys, num_frags + data_idx, desc, true,
+			xmit_more)) {
 			IPAERR_RL("fail to send skb %pK num_frags %u SWP\n",
 				skb, num_frags);
 			goto fail_send;
@@ -2552,7 +2767,8 @@ int ipa_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 			desc[data_idx].dma_address = meta->dma_address;
 		}
 		if (num_frags == 0) {
-			if (ipa3_send(sys, data_idx + 1, desc, true)) {
+			if (__ipa3_send(sys, data_idx + 1, desc, true,
+				xmit_more)) {
 				IPAERR_RL("fail to send skb %pK HWP\n", skb);
 				goto fail_mem;
 			}
@@ -2571,8 +2787,8 @@ int ipa_tx_dp(enum ipa_client_type dst, struct sk_buff *skb,
 			desc[data_idx+f].user2 = desc[data_idx].user2;
 			desc[data_idx].callback = NULL;
 
-			if (ipa3_send(sys, num_frags + data_idx + 1,
-				desc, true)) {
+			if (__ipa3_send(sys, num_frags + data_idx + 1,
+				desc, true, xmit_more)) {
 				IPAERR_RL("fail to send skb %pK num_frags %u\n",
 					skb, num_frags);
 				goto fail_mem;
@@ -2888,36 +3104,8 @@ static inline void __trigger_repl_work(struct ipa3_sys_context *sys)
 	}
 }
 
-static struct ipa3_rx_pkt_wrapper * ipa3_get_free_page
-(
-	struct ipa3_sys_context *sys,
-	u32 stats_i
-)
+static void ipa3_sched_find_freepage(struct ipa3_sys_context *sys, u32 stats_i)
 {
-	struct ipa3_rx_pkt_wrapper *rx_pkt = NULL;
-	struct ipa3_rx_pkt_wrapper *tmp = NULL;
-	struct page *cur_page;
-	int i = 0;
-	u8 LOOP_THRESHOLD = ipa3_ctx->page_poll_threshold;
-
-	spin_lock_bh(&sys->common_sys->spinlock);
-	list_for_each_entry_safe(rx_pkt, tmp,
-		&sys->page_recycle_repl->page_repl_head, link) {
-		if (i == LOOP_THRESHOLD)
-			break;
-		cur_page = rx_pkt->page_data.page;
-		if (page_ref_count(cur_page) == 1) {
-			/* Found a free page. */
-			page_ref_inc(cur_page);
-			list_del_init(&rx_pkt->link);
-			++ipa3_ctx->stats.page_recycle_cnt[stats_i][i];
-			sys->common_sys->napi_sort_page_thrshld_cnt = 0;
-			spin_unlock_bh(&sys->common_sys->spinlock);
-			return rx_pkt;
-		}
-		i++;
-	}
-	spin_unlock_bh(&sys->common_sys->spinlock);
 	IPADBG_LOW("napi_sort_page_thrshld_cnt = %d ipa_max_napi_sort_page_thrshld = %d\n",
 			sys->common_sys->napi_sort_page_thrshld_cnt,
 			ipa3_ctx->ipa_max_napi_sort_page_thrshld);
@@ -2943,9 +3131,120 @@ static struct ipa3_rx_pkt_wrapper * ipa3_get_free_page
 			}
 			spin_unlock(&ipa3_ctx->notifier_lock);
 	}
-	return NULL;
 }
 
+/**
+ * ipa3_harvest_free_pages() - move up to @want idle pages off the
+ * recycle list in a single locked pass
+ * @sys: pipe being replenished
+ * @stats_i: page recycle stats index of the pipe
+ * @free_list: [out] list the idle rx_pkt wrappers are moved to
+ * @want: number of pages the caller can post
+ *
+ * Pages still held by the network stack are rotated to the tail, so the
+ * next pass starts from the oldest posted pages instead of re-checking
+ * the same busy ones. The pass stops after page_poll_threshold busy
+ * pages in a row.
+ *
+ * Returns the number of wrappers moved to @free_list
+ */
+static int ipa3_harvest_free_pages(struct ipa3_sys_context *sys,
+	u32 stats_i, struct list_head *free_list, int want)
+{
+	struct ipa3_rx_pkt_wrapper *rx_pkt = NULL;
+	struct ipa3_rx_pkt_wrapper *tmp = NULL;
+	struct list_head *head = &sys->page_recycle_repl->page_repl_head;
+	struct page *cur_page;
+	u8 LOOP_THRESHOLD = ipa3_ctx->page_poll_threshold;
+	int busy = 0;
+	int found = 0;
+
+	spin_lock_bh(&sys->common_sys->spinlock);
+	list_for_each_entry_safe(rx_pkt, tmp, head, link) {
+		if (found == want || busy == LOOP_THRESHOLD)
+			break;
+		cur_page = rx_pkt->page_data.page;
+		if (page_ref_count(cur_page) == 1) {
+			/* Found a free page. */
+			page_ref_inc(cur_page);
+			list_move_tail(&rx_pkt->link, free_list);
+			++ipa3_ctx->stats.page_recycle_cnt[stats_i][busy];
+			busy = 0;
+			found++;
+		} else {
+			list_move_tail(&rx_pkt->link, head);
+			busy++;
+		}
+	}
+	if (found)
+		sys->common_sys->napi_sort_page_thrshld_cnt = 0;
+	spin_unlock_bh(&sys->common_sys->spinlock);
+
+	if (found < want)
+		ipa3_sched_find_freepage(sys, stats_i);
+
+	return found;
+}
+
+/* give back harvested pages that could not be posted */
+static void ipa3_return_free_pages(struct ipa3_sys_context *sys,
+	struct list_head *free_list)
+{
+	struct ipa3_rx_pkt_wrapper *rx_pkt;
+
+	if (list_empty(free_list))
+		return;
+
+	list_for_each_entry(rx_pkt, free_list, link)
+		page_ref_dec(rx_pkt->page_data.page);
+
+	spin_lock_bh(&sys->common_sys->spinlock);
+	list_splice_init(free_list,
+		&sys->page_recycle_repl->page_repl_head);
+	spin_unlock_bh(&sys->common_sys->spinlock);
+}
+
+static int ipa3_page_recycle_stats_idx(enum ipa_client_type client)
+{
+	switch (client) {
+	case IPA_CLIENT_APPS_WAN_COAL_CONS:
+		return 0;
+	case IPA_CLIENT_APPS_WAN_CONS:
+		return 1;
+	case IPA_CLIENT_APPS_WAN_LOW_LAT_DATA_CONS:
+		return 2;
+	default:
+		return -EINVAL;
+	}
+}
+
+int ipa_get_page_recycle_stats(enum ipa_client_type client,
+	struct ipa_page_recycle_stats *stats)
+{
+	struct ipa3_page_recycle_stats *recycle;
+	int stats_i;
+
+	if (!ipa3_ctx || !stats)
+		return -EINVAL;
+
+	stats_i = ipa3_page_recycle_stats_idx(client);
+	if (stats_i < 0) {
+		IPAERR_RL("no page recycling on client %d\n", client);
+		return stats_i;
+	}
+
+	recycle = &ipa3_ctx->stats.page_recycle_stats[stats_i];
+	stats->total_replenished = recycle->total_replenished;
+	stats->page_recycled = recycle->page_recycled;
+	stats->tmp_alloc = recycle->tmp_alloc;
+	stats->alloc_fail = recycle->alloc_fail;
+	stats->sort_tasklet_sched =
+		ipa3_ctx->stats.num_sort_tasklet_sched[stats_i];
+
+	return 0;
+}
+EXPORT_SYMBOL(ipa_get_page_recycle_stats);
+
 int ipa_register_notifier(void *fn_ptr)
 {
 	struct ipa_notifier_block_data *ipa_notifier_block;
@@ -3002,41 +3301,51 @@ EXPORT_SYMBOL(ipa_unregister_notifier);
 	struct gsi_xfer_elem gsi_xfer_elem_array[IPA_REPL_XFER_MAX];
 	u32 curr_wq;
 	int idx = 0;
-	u32 stats_i = 0;
+	int stats_i;
+	int want;
+	bool harvest = true;
+	LIST_HEAD(free_list);
 
 	/* start replenish only when buffers go lower than the threshold */
 	if (sys->rx_pool_sz - sys->len < IPA_REPL_XFER_THRESH)
 		return;
-	switch (sys->ep->client) {
-		case IPA_CLIENT_APPS_WAN_COAL_CONS:
-			stats_i = 0;
-			break;
-		case IPA_CLIENT_APPS_WAN_CONS:
-			stats_i = 1;
-			break;
-		case IPA_CLIENT_APPS_WAN_LOW_LAT_DATA_CONS:
-			stats_i = 2;
-			break;
-		default:
-			IPAERR_RL("Unexpected client%d\n", sys->ep->client);
+	stats_i = ipa3_page_recycle_stats_idx(sys->ep->client);
+	if (stats_i < 0) {
+		IPAERR_RL("Unexpected client%d\n", sys->ep->client);
+		stats_i = 0;
 	}
 
 	rx_len_cached = sys->len;
 	curr_wq = atomic_read(&sys->repl->head_idx);
 
 	while (rx_len_cached < sys->rx_pool_sz) {
-		/* check for an idle page that can be used */
-		if (atomic_read(&sys->common_sys->page_avilable) &&
-			((rx_pkt = ipa3_get_free_page(sys,stats_i)) != NULL)) {
+		/*
+		 * Pull idle pages in batches of at most one doorbell worth,
+		 * and stop asking once a pass comes back short.
+		 */
+		if (harvest && list_empty(&free_list) &&
+			atomic_read(&sys->common_sys->page_avilable)) {
+			want = min_t(int, IPA_REPL_XFER_MAX,
+				sys->rx_pool_sz - rx_len_cached);
+			if (ipa3_harvest_free_pages(sys, stats_i,
+				&free_list, want) < want)
+				harvest = false;
+		}
+
+		rx_pkt = list_first_entry_or_null(&free_list,
+			struct ipa3_rx_pkt_wrapper, link);
+		if (rx_pkt) {
+			list_del_init(&rx_pkt->link);
 			ipa3_ctx->stats.page_recycle_stats[stats_i].page_recycled++;
-
 		} else {
 			/*
-			 * Could not find idle page at curr index.
-			 * Allocate a new one.
+			 * No idle page left on the recycle list.
+			 * Use one from the tmp alloc cache.
 			 */
-			if (curr_wq == atomic_read(&sys->repl->tail_idx))
+			if (curr_wq == atomic_read(&sys->repl->tail_idx)) {
+				ipa3_ctx->stats.page_recycle_stats[stats_i].alloc_fail++;
 				break;
+			}
 			ipa3_ctx->stats.page_recycle_stats[stats_i].tmp_alloc++;
 			rx_pkt = sys->repl->cache[curr_wq];
 			curr_wq = (++curr_wq == sys->repl->capacity) ?
@@ -3078,6 +3387,8 @@ EXPORT_SYMBOL(ipa_unregister_notifier);
 			idx = 0;
 		}
 	}
+	ipa3_return_free_pages(sys, &free_list);
+
 	/* only ring doorbell once here */
 	ret = gsi_queue_xfer(sys->ep->gsi_chan_hdl, idx,
 			gsi_xfer_elem_array, true);
@@ -6479,6 +6790,7 @@ void __ipa_gsi_irq_rx_scedule_poll(struct ipa3_sys_context *sys)
 
 	atomic_set(&sys->curr_polling_state, 1);
 	__ipa3_update_curr_poll_state(sys->ep->client, 1);
+	ipa3_rx_mod_enter_poll(sys);
 
 	ipa3_inc_acquire_wakelock();
 	/*
@@ -6579,6 +6891,7 @@ static void ipa_dma_gsi_irq_rx_notify_cb(struct gsi_chan_xfer_notify *notify)
 				GSI_CHAN_MODE_POLL);
 			ipa3_inc_acquire_wakelock();
 			atomic_set(&sys->curr_polling_state, 1);
+			ipa3_rx_mod_enter_poll(sys);
 			queue_work(sys->wq, &sys->work);
 		}
 		break;
@@ -7204,7 +7517,8 @@ start_poll:
 		}
 	}
 	cnt += weight - remain_aggr_weight * IPA_LAN_AGGR_PKT_CNT;
-	if (cnt < weight) {
+	ipa3_rx_mod_account(ep->sys, cnt);
+	if (cnt < weight && !ipa3_rx_mod_linger(ep->sys, cnt)) {
 		napi_complete(ep->sys->napi_obj);
 		ret = ipa3_rx_switch_to_intr_mode(ep->sys);
 		if (ret == -GSI_STATUS_PENDING_IRQ &&
@@ -7212,6 +7526,9 @@ start_poll:
 			goto start_poll;
 
 		IPA_ACTIVE_CLIENTS_DEC_EP_NO_BLOCK(ep->client);
+	} else {
+		/* keep NAPI scheduled while the pipe lingers in polling */
+		cnt = weight;
 	}
 
 	return cnt;
@@ -7298,6 +7615,7 @@ start_poll:
 		}
 	}
 	cnt += weight - remain_aggr_weight * ipa3_ctx->ipa_wan_aggr_pkt_cnt;
+	ipa3_rx_mod_account(ep->sys, cnt);
 	/* call repl_hdlr before napi_reschedule / napi_complete */
 	ep->sys->repl_hdlr(ep->sys);
 	wan_def_sys->repl_hdlr(wan_def_sys);
@@ -7308,7 +7626,8 @@ start_poll:
 	 * mode, wait for napi-poll and replenish again.
 	 */
 	if (cnt < weight && ep->sys->len > IPA_DEFAULT_SYS_YELLOW_WM &&
-		wan_def_sys->len > IPA_DEFAULT_SYS_YELLOW_WM) {
+		wan_def_sys->len > IPA_DEFAULT_SYS_YELLOW_WM &&
+		!ipa3_rx_mod_linger(ep->sys, cnt)) {
 		napi_complete(ep->sys->napi_obj);
 		ret = ipa3_rx_switch_to_intr_mode(ep->sys);
 		if (ret == -GSI_STATUS_PENDING_IRQ &&
@@ -7529,6 +7848,7 @@ start_poll:
 		}
 	}
 	cnt += budget - remain_aggr_weight * ipa3_ctx->ipa_wan_aggr_pkt_cnt;
+	ipa3_rx_mod_account(sys, cnt);
 	/* call repl_hdlr before napi_reschedule / napi_complete */
 	sys->repl_hdlr(sys);
 	/* Scheduling RMNET LOW LAT DATA collect stats work queue */
@@ -7537,7 +7857,8 @@ start_poll:
 	/* When not able to replenish enough descriptors, keep in polling
 	 * mode, wait for napi-poll and replenish again.
 	 */
-	if (cnt < budget && (sys->len > IPA_DEFAULT_SYS_YELLOW_WM)) {
+	if (cnt < budget && (sys->len > IPA_DEFAULT_SYS_YELLOW_WM) &&
+		!ipa3_rx_mod_linger(sys, cnt)) {
 		napi_complete(napi_rx);
 		ret = ipa3_rx_switch_to_intr_mode(sys);
 		if (ret == -GSI_STATUS_PENDING_IRQ &&
@@ -184,6 +184,59 @@ static int ipa_prep_flt_tbl_for_cmt(enum ipa_ip_type ip,
 	return 0;
 }
 
+/**
+ * ipa_gen_flt_sys_tbl_body() - generate the body of a sys memory flt table
+ * @ip: the ip address family type
+ * @rlt: the type of the rules to generate (hashable or non-hashable)
+ * @tbl: the flt tbl, prepared for commit
+ *
+ * The new body becomes the current one of the table. The body it replaces
+ * is kept as the previous one, to be reaped once the hw no longer uses it.
+ *
+ * Returns: 0 on success, negative on failure
+ *
+ * caller needs to hold any needed locks to ensure integrity
+ */
+static int ipa_gen_flt_sys_tbl_body(enum ipa_ip_type ip,
+	enum ipa_rule_type rlt, struct ipa3_flt_tbl *tbl)
+{
+	struct ipa_mem_buffer tbl_mem;
+	struct ipa3_flt_entry *entry;
+	u8 *tbl_mem_buf;
+
+	/* only body (no header) */
+	tbl_mem.size = tbl->sz[rlt] - ipahal_get_hw_tbl_hdr_width();
+	/* Add prefetech buf size. */
+	tbl_mem.size += ipahal_get_hw_prefetch_buf_size();
+	if (ipahal_fltrt_allocate_hw_sys_tbl(&tbl_mem)) {
+		IPAERR("fail to alloc sys tbl of size %d\n", tbl_mem.size);
+		return -ENOMEM;
+	}
+
+	tbl_mem_buf = tbl_mem.base;
+
+	/* generate the rule-set */
+	list_for_each_entry(entry, &tbl->head_flt_rule_list, link) {
+		if (IPA_FLT_GET_RULE_TYPE(entry) != rlt)
+			continue;
+		if (ipa3_generate_flt_hw_rule(ip, entry, tbl_mem_buf)) {
+			IPAERR("failed to gen HW FLT rule\n");
+			ipahal_free_dma_mem(&tbl_mem);
+			return -EPERM;
+		}
+		tbl_mem_buf += entry->hw_len;
+	}
+
+	if (tbl->curr_mem[rlt].phys_base) {
+		WARN_ON(tbl->prev_mem[rlt].phys_base);
+		tbl->prev_mem[rlt] = tbl->curr_mem[rlt];
+	}
+	tbl->curr_mem[rlt] = tbl_mem;
+	ipa3_ctx->flt_commit_stats[ip].bytes_sys += tbl_mem.size;
+
+	return 0;
+}
+
 /**
  * ipa_translate_flt_tbl_to_hw_fmt() - translate the flt driver structures
  *  (rules and tables) to HW format and fill it in the given buffers
@@ -206,8 +259,6 @@ static int ipa_translate_flt_tbl_to_hw_fmt(enum ipa_ip_type ip,
 	u8 *body_i;
 	int res;
 	struct ipa3_flt_entry *entry;
-	u8 *tbl_mem_buf;
-	struct ipa_mem_buffer tbl_mem;
 	struct ipa3_flt_tbl *tbl;
 	int i;
 	int hdr_idx = 0;
@@ -222,45 +273,15 @@ static int ipa_translate_flt_tbl_to_hw_fmt(enum ipa_ip_type ip,
 			continue;
 		}
 		if (tbl->in_sys[rlt] || tbl->force_sys[rlt]) {
-			/* only body (no header) */
-			tbl_mem.size = tbl->sz[rlt] -
-				ipahal_get_hw_tbl_hdr_width();
-			/* Add prefetech buf size. */
-			tbl_mem.size +=
-				ipahal_get_hw_prefetch_buf_size();
-			if (ipahal_fltrt_allocate_hw_sys_tbl(&tbl_mem)) {
-				IPAERR("fail to alloc sys tbl of size %d\n",
-					tbl_mem.size);
+			if (ipa_gen_flt_sys_tbl_body(ip, rlt, tbl))
 				goto err;
-			}
 
-			if (ipahal_fltrt_write_addr_to_hdr(tbl_mem.phys_base,
-				hdr, hdr_idx, true)) {
+			if (ipahal_fltrt_write_addr_to_hdr(
+				tbl->curr_mem[rlt].phys_base, hdr, hdr_idx,
+				true)) {
 				IPAERR("fail to wrt sys tbl addr to hdr\n");
-				goto hdr_update_fail;
-			}
-
-			tbl_mem_buf = tbl_mem.base;
-
-			/* generate the rule-set */
-			list_for_each_entry(entry, &tbl->head_flt_rule_list,
-				link) {
-				if (IPA_FLT_GET_RULE_TYPE(entry) != rlt)
-					continue;
-				res = ipa3_generate_flt_hw_rule(
-					ip, entry, tbl_mem_buf);
-				if (res) {
-					IPAERR("failed to gen HW FLT rule\n");
-					goto hdr_update_fail;
-				}
-				tbl_mem_buf += entry->hw_len;
-			}
-
-			if (tbl->curr_mem[rlt].phys_base) {
-				WARN_ON(tbl->prev_mem[rlt].phys_base);
-				tbl->prev_mem[rlt] = tbl->curr_mem[rlt];
+				goto err;
 			}
-			tbl->curr_mem[rlt] = tbl_mem;
 		} else {
 			offset = body_i - base + body_ofst;
 
@@ -268,7 +289,7 @@ static int ipa_translate_flt_tbl_to_hw_fmt(enum ipa_ip_type ip,
 			if (ipahal_fltrt_write_addr_to_hdr(offset, hdr,
 				hdr_idx, false)) {
 				IPAERR("fail to wrt lcl tbl ofst to hdr\n");
-				goto hdr_update_fail;
+				goto err;
 			}
 
 			/* generate the rule-set */
@@ -298,8 +319,6 @@ static int ipa_translate_flt_tbl_to_hw_fmt(enum ipa_ip_type ip,
 
 	return 0;
 
-hdr_update_fail:
-	ipahal_free_dma_mem(&tbl_mem);
 err:
 	return -EPERM;
 }
@@ -473,7 +492,152 @@ static bool ipa_flt_skip_pipe_config(int pipe)
 }
 
 /**
- * __ipa_commit_flt_v3() - commit flt tables to the hw
+ * ipa_flt_add_flush_cmds() - add the imm cmds preceding a flt tables update
+ * @ip: the ip address family type
+ * @desc: descriptors of the commit
+ * @cmd_pyld: imm cmds payloads of the commit
+ * @num_cmd: [IN/OUT] number of imm cmds of the commit
+ *
+ * Closes the coalescing frame if coalescing is enabled, and flushes the ipa
+ * internal hashable flt rules cache if hashable tables are supported.
+ *
+ * Return: 0 on success, negative on failure
+ */
+static int ipa_flt_add_flush_cmds(enum ipa_ip_type ip, struct ipa3_desc *desc,
+	struct ipahal_imm_cmd_pyld **cmd_pyld, int *num_cmd)
+{
+	struct ipahal_imm_cmd_register_write reg_write_cmd = {0};
+	struct ipahal_imm_cmd_register_write reg_write_coal_close;
+	struct ipahal_reg_valmask valmask;
+	int i;
+
+	/* IC to close the coal frame before HPS Clear if coal is enabled */
+	if (ipa_get_ep_mapping(IPA_CLIENT_APPS_WAN_COAL_CONS) != -1
+		&& !ipa3_ctx->ulso_wa) {
+		u32 offset = 0;
+
+		i = ipa_get_ep_mapping(IPA_CLIENT_APPS_WAN_COAL_CONS);
+		reg_write_coal_close.skip_pipeline_clear = false;
+		reg_write_coal_close.pipeline_clear_options = IPAHAL_HPS_CLEAR;
+		if (ipa3_ctx->ipa_hw_type < IPA_HW_v5_0)
+			offset = ipahal_get_reg_ofst(
+				IPA_AGGR_FORCE_CLOSE);
+		else
+			offset = ipahal_get_ep_reg_offset(
+				IPA_AGGR_FORCE_CLOSE_n, i);
+		reg_write_coal_close.offset = offset;
+		ipahal_get_aggr_force_close_valmask(i, &valmask);
+		reg_write_coal_close.value = valmask.val;
+		reg_write_coal_close.value_mask = valmask.mask;
+		cmd_pyld[*num_cmd] = ipahal_construct_imm_cmd(
+			IPA_IMM_CMD_REGISTER_WRITE,
+			&reg_write_coal_close, false);
+		if (!cmd_pyld[*num_cmd]) {
+			IPAERR("failed to construct coal close IC\n");
+			return -ENOMEM;
+		}
+		ipa3_init_imm_cmd_desc(&desc[*num_cmd], cmd_pyld[*num_cmd]);
+		++*num_cmd;
+	}
+
+	/*
+	 * SRAM memory not allocated to hash tables. Sending
+	 * command to hash tables(filer/routing) operation not supported.
+	 */
+	if (!ipa3_ctx->ipa_fltrt_not_hashable) {
+		/* flushing ipa internal hashable flt rules cache */
+		if (ipa3_ctx->ipa_hw_type >= IPA_HW_v5_0) {
+			struct ipahal_reg_fltrt_cache_flush flush_cache;
+
+			memset(&flush_cache, 0, sizeof(flush_cache));
+			flush_cache.flt = true;
+			ipahal_get_fltrt_cache_flush_valmask(
+				&flush_cache, &valmask);
+			reg_write_cmd.offset = ipahal_get_reg_ofst(
+				IPA_FILT_ROUT_CACHE_FLUSH);
+		} else {
+			struct ipahal_reg_fltrt_hash_flush flush_hash;
+
+			memset(&flush_hash, 0, sizeof(flush_hash));
+			if (ip == IPA_IP_v4)
+				flush_hash.v4_flt = true;
+			else
+				flush_hash.v6_flt = true;
+			ipahal_get_fltrt_hash_flush_valmask(
+				&flush_hash, &valmask);
+			reg_write_cmd.offset = ipahal_get_reg_ofst(
+				IPA_FILT_ROUT_HASH_FLUSH);
+		}
+		reg_write_cmd.skip_pipeline_clear = false;
+		reg_write_cmd.pipeline_clear_options = IPAHAL_HPS_CLEAR;
+		reg_write_cmd.value = valmask.val;
+		reg_write_cmd.value_mask = valmask.mask;
+		cmd_pyld[*num_cmd] = ipahal_construct_imm_cmd(
+				IPA_IMM_CMD_REGISTER_WRITE, &reg_write_cmd,
+							false);
+		if (!cmd_pyld[*num_cmd]) {
+			IPAERR(
+			"fail construct register_write imm cmd: IP %d\n", ip);
+			return -ENOMEM;
+		}
+		ipa3_init_imm_cmd_desc(&desc[*num_cmd], cmd_pyld[*num_cmd]);
+		++*num_cmd;
+	}
+
+	return 0;
+}
+
+/**
+ * ipa_flt_send_cmds() - send the imm cmds of a flt tables commit
+ * @desc: descriptors of the commit
+ * @num_cmd: number of imm cmds of the commit
+ *
+ * Return: 0 on success, negative on failure
+ */
+static int ipa_flt_send_cmds(struct ipa3_desc *desc, int num_cmd)
+{
+	int num_cmd_to_send;
+
+	/*
+	 * Avoid sending longs chain that may surpass number of TLVs available
+	 * for the system pipe.
+	 */
+	while (num_cmd > 0) {
+		num_cmd_to_send =
+			num_cmd > IPA_FLT_MAX_IMM_CMD_CHAIN_LENGTH ?
+			IPA_FLT_MAX_IMM_CMD_CHAIN_LENGTH : num_cmd;
+		num_cmd -= num_cmd_to_send;
+
+		if (ipa3_send_cmd(num_cmd_to_send, desc)) {
+			IPAERR("fail to send immediate command batch\n");
+			return -EFAULT;
+		}
+		desc += num_cmd_to_send;
+	}
+
+	return 0;
+}
+
+/**
+ * ipa_flt_skip_pipes() - get the filtering pipes to skip the configuration of
+ *
+ * Return: bitmap of the pipes ipa_flt_skip_pipe_config() skips
+ */
+static u64 ipa_flt_skip_pipes(void)
+{
+	u64 skip_pipes = 0;
+	int i;
+
+	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
+		if (ipa_is_ep_support_flt(i) && ipa_flt_skip_pipe_config(i))
+			skip_pipes |= BIT_ULL(i);
+	}
+
+	return skip_pipes;
+}
+
+/**
+ * ipa_flt_commit_all_tbls() - commit all the flt tables to the hw
  *  commit the headers and the bodies if are local with internal cache flushing.
  *  The headers (and local bodies) will first be created into dma buffers and
  *  then written via IC to the SRAM
@@ -481,26 +645,27 @@ static bool ipa_flt_skip_pipe_config(int pipe)
  *
  * Return: 0 on success, negative on failure
  */
-int __ipa_commit_flt_v3(enum ipa_ip_type ip)
+static int ipa_flt_commit_all_tbls(enum ipa_ip_type ip)
 {
 	struct ipahal_fltrt_alloc_imgs_params alloc_params;
 	int rc = 0;
-	struct ipa3_desc *desc, *desc_to_send;
-	struct ipahal_imm_cmd_register_write reg_write_cmd = {0};
+	struct ipa3_desc *desc;
 	struct ipahal_imm_cmd_dma_shared_mem mem_cmd = {0};
 	struct ipahal_imm_cmd_pyld **cmd_pyld;
-	int num_cmd = 0, remaining_num_cmd = 0, num_cmd_to_send = 0;
+	struct ipa3_fltrt_commit_stats *stats = &ipa3_ctx->flt_commit_stats[ip];
+	int num_cmd = 0;
 	int i;
 	int hdr_idx;
 	u32 lcl_hash_hdr, lcl_nhash_hdr;
 	u32 lcl_hash_bdy, lcl_nhash_bdy;
 	bool lcl_hash, lcl_nhash;
-	struct ipahal_reg_valmask valmask;
 	u32 tbl_hdr_width;
 	struct ipa3_flt_tbl *tbl;
 	struct ipa3_flt_tbl_nhash_lcl *lcl_tbl;
 	u16 entries;
-	struct ipahal_imm_cmd_register_write reg_write_coal_close;
+	u64 skip_pipes = 0;
+	u32 bytes_dma = 0;
+	u64 start_ns;
 
 	tbl_hdr_width = ipahal_get_hw_tbl_hdr_width();
 	memset(&alloc_params, 0, sizeof(alloc_params));
@@ -535,6 +700,7 @@ int __ipa_commit_flt_v3(enum ipa_ip_type ip)
 		lcl_nhash = ipa3_ctx->flt_tbl_nhash_lcl[IPA_IP_v6];
 	}
 
+	start_ns = ktime_get_ns();
 	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
 		if (!ipa_is_ep_support_flt(i))
 			continue;
@@ -598,6 +764,7 @@ int __ipa_commit_flt_v3(enum ipa_ip_type ip)
 		rc = -EFAULT;
 		goto prep_failed;
 	}
+	ipa3_fltrt_commit_stats_rebuild(stats, start_ns);
 
 	/* +4: 2 for bodies (hashable and non-hashable), 1 for flushing and 1
 	 * for closing the colaescing frame
@@ -609,79 +776,9 @@ int __ipa_commit_flt_v3(enum ipa_ip_type ip)
 		goto fail_size_valid;
 	}
 
-	/* IC to close the coal frame before HPS Clear if coal is enabled */
-	if (ipa_get_ep_mapping(IPA_CLIENT_APPS_WAN_COAL_CONS) != -1
-		&& !ipa3_ctx->ulso_wa) {
-		u32 offset = 0;
-
-		i = ipa_get_ep_mapping(IPA_CLIENT_APPS_WAN_COAL_CONS);
-		reg_write_coal_close.skip_pipeline_clear = false;
-		reg_write_coal_close.pipeline_clear_options = IPAHAL_HPS_CLEAR;
-		if (ipa3_ctx->ipa_hw_type < IPA_HW_v5_0)
-			offset = ipahal_get_reg_ofst(
-				IPA_AGGR_FORCE_CLOSE);
-		else
-			offset = ipahal_get_ep_reg_offset(
-				IPA_AGGR_FORCE_CLOSE_n, i);
-		reg_write_coal_close.offset = offset;
-		ipahal_get_aggr_force_close_valmask(i, &valmask);
-		reg_write_coal_close.value = valmask.val;
-		reg_write_coal_close.value_mask = valmask.mask;
-		cmd_pyld[num_cmd] = ipahal_construct_imm_cmd(
-			IPA_IMM_CMD_REGISTER_WRITE,
-			&reg_write_coal_close, false);
-		if (!cmd_pyld[num_cmd]) {
-			IPAERR("failed to construct coal close IC\n");
-			rc = -ENOMEM;
-			goto fail_reg_write_construct;
-		}
-		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
-		++num_cmd;
-	}
-
-	/*
-	 * SRAM memory not allocated to hash tables. Sending
-	 * command to hash tables(filer/routing) operation not supported.
-	 */
-	if (!ipa3_ctx->ipa_fltrt_not_hashable) {
-		/* flushing ipa internal hashable flt rules cache */
-		if (ipa3_ctx->ipa_hw_type >= IPA_HW_v5_0) {
-			struct ipahal_reg_fltrt_cache_flush flush_cache;
-
-			memset(&flush_cache, 0, sizeof(flush_cache));
-			flush_cache.flt = true;
-			ipahal_get_fltrt_cache_flush_valmask(
-				&flush_cache, &valmask);
-			reg_write_cmd.offset = ipahal_get_reg_ofst(
-				IPA_FILT_ROUT_CACHE_FLUSH);
-		} else {
-			struct ipahal_reg_fltrt_hash_flush flush_hash;
-
-			memset(&flush_hash, 0, sizeof(flush_hash));
-			if (ip == IPA_IP_v4)
-				flush_hash.v4_flt = true;
-			else
-				flush_hash.v6_flt = true;
-			ipahal_get_fltrt_hash_flush_valmask(
-				&flush_hash, &valmask);
-			reg_write_cmd.offset = ipahal_get_reg_ofst(
-				IPA_FILT_ROUT_HASH_FLUSH);
-		}
-		reg_write_cmd.skip_pipeline_clear = false;
-		reg_write_cmd.pipeline_clear_options = IPAHAL_HPS_CLEAR;
-		reg_write_cmd.value = valmask.val;
-		reg_write_cmd.value_mask = valmask.mask;
-		cmd_pyld[num_cmd] = ipahal_construct_imm_cmd(
-				IPA_IMM_CMD_REGISTER_WRITE, &reg_write_cmd,
-							false);
-		if (!cmd_pyld[num_cmd]) {
-			IPAERR(
-			"fail construct register_write imm cmd: IP %d\n", ip);
-			rc = -EFAULT;
-			goto fail_imm_cmd_construct;
-		}
-		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
-		++num_cmd;
+	if (ipa_flt_add_flush_cmds(ip, desc, cmd_pyld, &num_cmd)) {
+		rc = -ENOMEM;
+		goto fail_imm_cmd_construct;
 	}
 
 	hdr_idx = 0;
@@ -692,6 +789,7 @@ int __ipa_commit_flt_v3(enum ipa_ip_type ip)
 		}
 
 		if (ipa_flt_skip_pipe_config(i)) {
+			skip_pipes |= BIT_ULL(i);
 			hdr_idx++;
 			continue;
 		}
@@ -724,6 +822,7 @@ int __ipa_commit_flt_v3(enum ipa_ip_type ip)
 		}
 		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
 		++num_cmd;
+		bytes_dma += mem_cmd.size;
 
 		/*
 		 * SRAM memory not allocated to hash tables. Sending command
@@ -751,6 +850,7 @@ int __ipa_commit_flt_v3(enum ipa_ip_type ip)
 			ipa3_init_imm_cmd_desc(&desc[num_cmd],
 						cmd_pyld[num_cmd]);
 			++num_cmd;
+			bytes_dma += mem_cmd.size;
 		}
 		++hdr_idx;
 	}
@@ -779,6 +879,7 @@ int __ipa_commit_flt_v3(enum ipa_ip_type ip)
 		}
 		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
 		++num_cmd;
+		bytes_dma += mem_cmd.size;
 	}
 	if (lcl_hash) {
 		if (num_cmd >= entries) {
@@ -804,28 +905,15 @@ int __ipa_commit_flt_v3(enum ipa_ip_type ip)
 		}
 		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
 		++num_cmd;
+		bytes_dma += mem_cmd.size;
 	}
 
-	remaining_num_cmd = num_cmd;
-	desc_to_send = desc;
-
-	/*
-	 * Avoid sending longs chain that may surpass number of TLVs available
-	 * for the system pipe.
-	 */
-	while (remaining_num_cmd > 0) {
-		num_cmd_to_send =
-			remaining_num_cmd > IPA_FLT_MAX_IMM_CMD_CHAIN_LENGTH ?
-			IPA_FLT_MAX_IMM_CMD_CHAIN_LENGTH : remaining_num_cmd;
-		remaining_num_cmd -= num_cmd_to_send;
-
-		if (ipa3_send_cmd(num_cmd_to_send, desc_to_send)) {
-			IPAERR("fail to send immediate command batch\n");
-			rc = -EFAULT;
-			goto fail_imm_cmd_construct;
-		}
-		desc_to_send += num_cmd_to_send;
+	if (ipa_flt_send_cmds(desc, num_cmd)) {
+		rc = -EFAULT;
+		goto fail_imm_cmd_construct;
 	}
+	stats->bytes_dma += bytes_dma;
+	ipa3_ctx->flt_skip_pipes[ip] = skip_pipes;
 
 	IPADBG_LOW("Hashable HEAD\n");
 	IPA_DUMP_BUFF(alloc_params.hash_hdr.base,
@@ -855,7 +943,6 @@ int __ipa_commit_flt_v3(enum ipa_ip_type ip)
 fail_imm_cmd_construct:
 	for (i = 0 ; i < num_cmd ; i++)
 		ipahal_destroy_imm_cmd(cmd_pyld[i]);
-fail_reg_write_construct:
 	kfree(desc);
 	kfree(cmd_pyld);
 fail_size_valid:
@@ -870,6 +957,277 @@ prep_failed:
 	return rc;
 }
 
+/**
+ * ipa_flt_rollback_sys_tbls() - give the dirty flt tables back the sys
+ *  bodies the hw still uses, after a failed commit of their new ones
+ * @ip: the ip address family type
+ */
+static void ipa_flt_rollback_sys_tbls(enum ipa_ip_type ip)
+{
+	struct ipa3_flt_tbl *tbl;
+	int i, rlt;
+
+	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
+		if (!ipa_is_ep_support_flt(i))
+			continue;
+		tbl = &ipa3_ctx->flt_tbl[i][ip];
+		if (!tbl->dirty)
+			continue;
+		for (rlt = 0; rlt < IPA_RULE_TYPE_MAX; rlt++) {
+			if (!tbl->prev_mem[rlt].phys_base)
+				continue;
+			ipahal_free_dma_mem(&tbl->curr_mem[rlt]);
+			tbl->curr_mem[rlt] = tbl->prev_mem[rlt];
+			memset(&tbl->prev_mem[rlt], 0,
+				sizeof(tbl->prev_mem[rlt]));
+		}
+	}
+}
+
+/**
+ * ipa_flt_commit_dirty_tbls() - commit the flt tables changed since the
+ *  last commit to the hw
+ * @ip: the ip address family type
+ *
+ * The sys bodies of the dirty tables are regenerated and their header
+ * entries are rewritten in place, one imm cmd each, leaving the rest of the
+ * header and the other tables as the hw has them. Tables that may live in
+ * the sram are packed back-to-back, and the pipes whose configuration is
+ * skipped have their headers left to the modem, so changes touching either
+ * are left to a full commit.
+ *
+ * Return: 0 on success, -EAGAIN if a full commit is needed, other negative
+ *  on failure
+ */
+static int ipa_flt_commit_dirty_tbls(enum ipa_ip_type ip)
+{
+	struct ipa3_fltrt_commit_stats *stats = &ipa3_ctx->flt_commit_stats[ip];
+	struct ipahal_imm_cmd_dma_shared_mem mem_cmd = {0};
+	struct ipahal_imm_cmd_pyld **cmd_pyld = NULL;
+	struct ipa3_desc *desc = NULL;
+	struct ipa_mem_buffer hdr_mem;
+	struct ipa3_flt_tbl *tbl;
+	u32 lcl_hdr[IPA_RULE_TYPE_MAX];
+	u32 old_sz[IPA_RULE_TYPE_MAX];
+	u32 tbl_hdr_width;
+	u64 skip_pipes;
+	int num_dirty = 0;
+	int num_hdr = 0;
+	int num_cmd = 0;
+	int hdr_idx = 0;
+	u64 start_ns;
+	int rc = 0;
+	int i, rlt;
+
+	if (!ipa3_ctx->fltrt_dirty_commit || ipa3_ctx->flt_layout_dirty[ip])
+		return -EAGAIN;
+
+	skip_pipes = ipa_flt_skip_pipes();
+	if (skip_pipes != ipa3_ctx->flt_skip_pipes[ip])
+		goto fallback;
+
+	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
+		if (!ipa_is_ep_support_flt(i))
+			continue;
+		tbl = &ipa3_ctx->flt_tbl[i][ip];
+		if (!tbl->dirty)
+			continue;
+		if (!tbl->in_sys[IPA_RULE_HASHABLE] ||
+			!tbl->in_sys[IPA_RULE_NON_HASHABLE] ||
+			tbl->prev_mem[IPA_RULE_HASHABLE].phys_base ||
+			tbl->prev_mem[IPA_RULE_NON_HASHABLE].phys_base ||
+			(skip_pipes & BIT_ULL(i)))
+			goto fallback;
+		num_dirty++;
+	}
+
+	if (!num_dirty)
+		return 0;
+
+	tbl_hdr_width = ipahal_get_hw_tbl_hdr_width();
+	if (ip == IPA_IP_v4) {
+		lcl_hdr[IPA_RULE_HASHABLE] = ipa3_ctx->smem_restricted_bytes +
+			IPA_MEM_PART(v4_flt_hash_ofst) +
+			tbl_hdr_width; /* to skip the bitmap */
+		lcl_hdr[IPA_RULE_NON_HASHABLE] =
+			ipa3_ctx->smem_restricted_bytes +
+			IPA_MEM_PART(v4_flt_nhash_ofst) +
+			tbl_hdr_width; /* to skip the bitmap */
+	} else {
+		lcl_hdr[IPA_RULE_HASHABLE] = ipa3_ctx->smem_restricted_bytes +
+			IPA_MEM_PART(v6_flt_hash_ofst) +
+			tbl_hdr_width; /* to skip the bitmap */
+		lcl_hdr[IPA_RULE_NON_HASHABLE] =
+			ipa3_ctx->smem_restricted_bytes +
+			IPA_MEM_PART(v6_flt_nhash_ofst) +
+			tbl_hdr_width; /* to skip the bitmap */
+	}
+
+	start_ns = ktime_get_ns();
+	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
+		if (!ipa_is_ep_support_flt(i))
+			continue;
+		tbl = &ipa3_ctx->flt_tbl[i][ip];
+		if (!tbl->dirty)
+			continue;
+		memcpy(old_sz, tbl->sz, sizeof(old_sz));
+		if (ipa_prep_flt_tbl_for_cmt(ip, tbl, i))
+			return -EPERM;
+		for (rlt = 0; rlt < IPA_RULE_TYPE_MAX; rlt++) {
+			/* the header entry has to point to the empty table */
+			if (old_sz[rlt] && !tbl->sz[rlt])
+				goto fallback;
+			if (tbl->sz[rlt])
+				num_hdr++;
+		}
+	}
+
+	/* +2: for closing the coalescing frame and for flushing */
+	if (ipa_flt_alloc_cmd_buffers(ip, num_hdr + 2, &desc, &cmd_pyld))
+		return -ENOMEM;
+
+	hdr_mem.size = max(num_hdr, 1) * tbl_hdr_width;
+	hdr_mem.base = dma_alloc_coherent(ipa3_ctx->pdev, hdr_mem.size,
+		&hdr_mem.phys_base, GFP_KERNEL);
+	if (!hdr_mem.base) {
+		IPAERR("fail to alloc hdr entries of size %d ip %d\n",
+			hdr_mem.size, ip);
+		rc = -ENOMEM;
+		goto fail_hdr_alloc;
+	}
+
+	if (ipa_flt_add_flush_cmds(ip, desc, cmd_pyld, &num_cmd)) {
+		rc = -ENOMEM;
+		goto fail_imm_cmd_construct;
+	}
+
+	num_hdr = 0;
+	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
+		if (!ipa_is_ep_support_flt(i))
+			continue;
+		tbl = &ipa3_ctx->flt_tbl[i][ip];
+		if (!tbl->dirty) {
+			hdr_idx++;
+			continue;
+		}
+		for (rlt = 0; rlt < IPA_RULE_TYPE_MAX; rlt++) {
+			if (!tbl->sz[rlt])
+				continue;
+			if (ipa_gen_flt_sys_tbl_body(ip, rlt, tbl)) {
+				rc = -EPERM;
+				goto fail_imm_cmd_construct;
+			}
+			/*
+			 * SRAM memory not allocated to hash tables. Sending
+			 * command to hash tables(filer/routing) operation not
+			 * supported.
+			 */
+			if (rlt == IPA_RULE_HASHABLE &&
+				ipa3_ctx->ipa_fltrt_not_hashable)
+				continue;
+
+			if (ipahal_fltrt_write_addr_to_hdr(
+				tbl->curr_mem[rlt].phys_base, hdr_mem.base,
+				num_hdr, true)) {
+				IPAERR_RL("fail to wrt sys tbl addr to hdr\n");
+				rc = -EPERM;
+				goto fail_imm_cmd_construct;
+			}
+			mem_cmd.is_read = false;
+			mem_cmd.skip_pipeline_clear = false;
+			mem_cmd.pipeline_clear_options = IPAHAL_HPS_CLEAR;
+			mem_cmd.size = tbl_hdr_width;
+			mem_cmd.system_addr = hdr_mem.phys_base +
+				num_hdr * tbl_hdr_width;
+			mem_cmd.local_addr = lcl_hdr[rlt] +
+				hdr_idx * tbl_hdr_width;
+			cmd_pyld[num_cmd] = ipahal_construct_imm_cmd(
+				IPA_IMM_CMD_DMA_SHARED_MEM, &mem_cmd, false);
+			if (!cmd_pyld[num_cmd]) {
+				IPAERR(
+				"fail construct dma_shared_mem cmd: IP = %d\n",
+					ip);
+				rc = -ENOMEM;
+				goto fail_imm_cmd_construct;
+			}
+			ipa3_init_imm_cmd_desc(&desc[num_cmd],
+				cmd_pyld[num_cmd]);
+			++num_cmd;
+			++num_hdr;
+		}
+		hdr_idx++;
+	}
+	ipa3_fltrt_commit_stats_rebuild(stats, start_ns);
+
+	if (ipa_flt_send_cmds(desc, num_cmd)) {
+		rc = -EFAULT;
+		goto fail_imm_cmd_construct;
+	}
+	stats->bytes_dma += num_hdr * tbl_hdr_width;
+
+	IPADBG_LOW("committed %d dirty flt tbls, %d hdr entries. IP %d\n",
+		num_dirty, num_hdr, ip);
+
+	__ipa_reap_sys_flt_tbls(ip, IPA_RULE_HASHABLE);
+	__ipa_reap_sys_flt_tbls(ip, IPA_RULE_NON_HASHABLE);
+
+fail_imm_cmd_construct:
+	if (rc)
+		ipa_flt_rollback_sys_tbls(ip);
+	for (i = 0 ; i < num_cmd ; i++)
+		ipahal_destroy_imm_cmd(cmd_pyld[i]);
+	dma_free_coherent(ipa3_ctx->pdev, hdr_mem.size, hdr_mem.base,
+		hdr_mem.phys_base);
+fail_hdr_alloc:
+	kfree(desc);
+	kfree(cmd_pyld);
+	return rc;
+
+fallback:
+	stats->fallback++;
+	return -EAGAIN;
+}
+
+/**
+ * __ipa_commit_flt_v3() - commit flt tables to the hw
+ * @ipt: the ip address family type
+ *
+ * Only the tables changed since the last commit are committed when
+ * fltrt_dirty_commit is set and their layout allows it, all the tables are
+ * committed otherwise.
+ *
+ * Return: 0 on success, negative on failure
+ */
+int __ipa_commit_flt_v3(enum ipa_ip_type ip)
+{
+	struct ipa3_fltrt_commit_stats *stats = &ipa3_ctx->flt_commit_stats[ip];
+	int rc;
+	int i;
+
+	rc = ipa_flt_commit_dirty_tbls(ip);
+	if (rc == -EAGAIN) {
+		rc = ipa_flt_commit_all_tbls(ip);
+		if (!rc)
+			stats->full++;
+	} else if (!rc) {
+		stats->dirty++;
+	}
+
+	if (rc) {
+		/* the hw may have any of the tables, rebuild them all */
+		ipa3_ctx->flt_layout_dirty[ip] = true;
+		return rc;
+	}
+
+	ipa3_ctx->flt_layout_dirty[ip] = false;
+	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
+		if (ipa_is_ep_support_flt(i))
+			ipa3_ctx->flt_tbl[i][ip].dirty = false;
+	}
+
+	return 0;
+}
+
 static int __ipa_validate_flt_rule(const struct ipa_flt_rule_i *rule,
 		struct ipa3_rt_tbl **rt_tbl, enum ipa_ip_type ip)
 {
@@ -1007,6 +1365,7 @@ static int __ipa_finish_flt_rule_add(struct ipa3_flt_tbl *tbl,
 {
 	int id;
 
+	tbl->dirty = true;
 	if (tbl->rule_cnt < IPA_RULE_CNT_MAX)
 		tbl->rule_cnt++;
 	else
@@ -1138,6 +1497,7 @@ static int __ipa_del_flt_rule(u32 rule_hdl)
 
 	list_del(&entry->link);
 	entry->tbl->rule_cnt--;
+	entry->tbl->dirty = true;
 	if (entry->rt_tbl && !ipa3_check_idr_if_freed(entry->rt_tbl))
 		entry->rt_tbl->ref_cnt--;
 	IPADBG("del flt rule rule_cnt=%d rule_id=%d\n",
@@ -1181,6 +1541,7 @@ static int __ipa_mdfy_flt_rule(struct ipa_flt_rule_mdfy_i *frule,
 
 	entry->rule = frule->rule;
 	entry->rt_tbl = rt_tbl;
+	entry->tbl->dirty = true;
 	if (entry->rt_tbl)
 		entry->rt_tbl->ref_cnt++;
 	entry->hw_len = 0;
@@ -1900,6 +2261,7 @@ int ipa3_reset_flt(enum ipa_ip_type ip, bool user_only)
 	}
 
 	mutex_lock(&ipa3_ctx->lock);
+	ipa3_ctx->flt_layout_dirty[ip] = true;
 	for (i = 0; i < ipa3_ctx->ipa_num_pipes; i++) {
 		if (!ipa_is_ep_support_flt(i))
 			continue;
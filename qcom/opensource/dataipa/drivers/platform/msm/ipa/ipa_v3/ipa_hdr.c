@@ -699,16 +699,43 @@ bad_len:
 	return -EPERM;
 }
 
+static struct ipa3_hdr_entry *__ipa_find_hdr(const char *name)
+{
+	struct ipa3_hdr_entry *entry;
+	struct ipa3_hdr_tbl *htbl;
+	enum hdr_tbl_storage hdr_tbl_loc;
+	u32 key;
+
+	if (strnlen(name, IPA_RESOURCE_NAME_MAX) == IPA_RESOURCE_NAME_MAX) {
+		IPAERR_RL("Header name too long: %s\n", name);
+		return NULL;
+	}
+
+	/*
+	 * the index holds the entries of each table in the list order, so
+	 * when a name is used twice the one the list walk found is returned
+	 */
+	key = ipa3_name_hash(name);
+	for (hdr_tbl_loc = HDR_TBL_LCL; hdr_tbl_loc < HDR_TBLS_TOTAL; hdr_tbl_loc++) {
+		htbl = &ipa3_ctx->hdr_tbl[hdr_tbl_loc];
+		hash_for_each_possible(htbl->name_htable, entry, name_node, key) {
+			if (!strcmp(name, entry->name))
+				return entry;
+		}
+	}
+
+	return NULL;
+}
+
 static int __ipa_add_hdr(struct ipa_hdr_add *hdr, bool user,
 	struct ipa3_hdr_entry **entry_out)
 {
-	struct ipa3_hdr_entry *entry, *entry_t, *next;
+	struct ipa3_hdr_entry *entry, *entry_t;
 	struct ipa_hdr_offset_entry *offset = NULL;
 	u32 bin;
 	struct ipa3_hdr_tbl *htbl;
 	int id;
 	int mem_size;
-	enum hdr_tbl_storage hdr_tbl_loc;
 
 	if (hdr->hdr_len > IPA_HDR_MAX_SIZE) {
 		IPAERR_RL("bad param\n");
@@ -740,23 +767,19 @@ static int __ipa_add_hdr(struct ipa_hdr_add *hdr, bool user,
 			 !IPA_MEM_PART(apps_hdr_size)) ? false : true;
 
 	/* check to see if adding header entry with duplicate name */
-	for (hdr_tbl_loc = HDR_TBL_LCL; hdr_tbl_loc < HDR_TBLS_TOTAL; hdr_tbl_loc++) {
-		list_for_each_entry_safe(entry_t, next,
-			&ipa3_ctx->hdr_tbl[hdr_tbl_loc].head_hdr_entry_list, link) {
+	entry_t = user ? __ipa_find_hdr(entry->name) : NULL;
 
-			/* return if adding the same name */
-			if (!strcmp(entry_t->name, entry->name) && (user == true)) {
-				IPAERR_RL("IPACM Trying to add hdr %s len=%d, duplicate entry, return old one\n",
-					entry->name, entry->hdr_len);
+	/* return if adding the same name */
+	if (entry_t) {
+		IPAERR_RL("IPACM Trying to add hdr %s len=%d, duplicate entry, return old one\n",
+			entry->name, entry->hdr_len);
 
-				/* return the original entry */
-				if (entry_out)
-					*entry_out = entry_t;
+		/* return the original entry */
+		if (entry_out)
+			*entry_out = entry_t;
 
-				kmem_cache_free(ipa3_ctx->hdr_cache, entry);
-				return 0;
-			}
-		}
+		kmem_cache_free(ipa3_ctx->hdr_cache, entry);
+		return 0;
 	}
 
 	if (hdr->hdr_len <= ipa_hdr_bin_sz[IPA_HDR_BIN0])
@@ -851,6 +874,8 @@ create_entry:
 free_list:
 
 	list_add(&entry->link, &htbl->head_hdr_entry_list);
+	hash_add(htbl->name_htable, &entry->name_node,
+		 ipa3_name_hash(entry->name));
 	htbl->hdr_cnt++;
 	IPADBG("add hdr of sz=%d hdr_cnt=%d ofst=%d to %s table\n",
 			hdr->hdr_len,
@@ -879,6 +904,7 @@ ipa_insert_failed:
 	entry->offset_entry = NULL;
 	htbl->hdr_cnt--;
 	list_del(&entry->link);
+	hash_del(&entry->name_node);
 
 bad_hdr_len:
 	entry->cookie = 0;
@@ -926,6 +952,8 @@ static int __ipa3_del_hdr_proc_ctx(u32 proc_ctx_hdl,
 	htbl->proc_ctx_cnt--;
 	entry->cookie = 0;
 	kmem_cache_free(ipa3_ctx->hdr_proc_ctx_cache, entry);
+	/* rt rules still pointing to it are generated without it */
+	ipa3_rt_set_layout_dirty();
 
 	/* remove the handle from the database */
 	ipa3_id_remove(proc_ctx_hdl);
@@ -1013,9 +1041,12 @@ int __ipa3_del_hdr(u32 hdr_hdl, bool by_user)
 		list_move(&entry->offset_entry->link,
 			&htbl->head_free_offset_list[entry->offset_entry->bin]);
 	list_del(&entry->link);
+	hash_del(&entry->name_node);
 	htbl->hdr_cnt--;
 	entry->cookie = 0;
 	kmem_cache_free(ipa3_ctx->hdr_cache, entry);
+	/* rt rules still pointing to it are generated without it */
+	ipa3_rt_set_layout_dirty();
 
 	/* remove the handle from the database */
 	ipa3_id_remove(hdr_hdl);
@@ -1524,6 +1555,7 @@ int ipa3_reset_hdr(bool user_only)
 
 				/* delete the hdr entry from headers list */
 				list_del(&entry->link);
+				hash_del(&entry->name_node);
 				ipa3_ctx->hdr_tbl[hdr_tbl_loc].hdr_cnt--;
 				entry->ref_cnt = 0;
 				entry->cookie = 0;
@@ -1630,27 +1662,6 @@ int ipa3_reset_hdr(bool user_only)
 }
 EXPORT_SYMBOL(ipa3_reset_hdr);
 
-static struct ipa3_hdr_entry *__ipa_find_hdr(const char *name)
-{
-	struct ipa3_hdr_entry *entry;
-	enum hdr_tbl_storage hdr_tbl_loc;
-
-	if (strnlen(name, IPA_RESOURCE_NAME_MAX) == IPA_RESOURCE_NAME_MAX) {
-		IPAERR_RL("Header name too long: %s\n", name);
-		return NULL;
-	}
-	for (hdr_tbl_loc = HDR_TBL_LCL; hdr_tbl_loc < HDR_TBLS_TOTAL; hdr_tbl_loc++) {
-		list_for_each_entry(entry,
-				    &ipa3_ctx->hdr_tbl[hdr_tbl_loc].head_hdr_entry_list,
-				    link) {
-			if (!strcmp(name, entry->name))
-				return entry;
-		}
-	}
-
-	return NULL;
-}
-
 static struct ipa3_hdr_proc_ctx_entry* __ipa_find_hdr_proc_ctx(const char *name)
 {
 	struct ipa3_hdr_entry *entry;
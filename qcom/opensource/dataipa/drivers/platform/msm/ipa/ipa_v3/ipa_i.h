@@ -11,7 +11,9 @@
 #include <linux/bitops.h>
 #include <linux/cdev.h>
 #include <linux/export.h>
+#include <linux/hashtable.h>
 #include <linux/idr.h>
+#include <linux/jhash.h>
 #include <linux/list.h>
 #include <linux/mutex.h>
 #include <linux/skbuff.h>
@@ -302,8 +304,13 @@ enum hdr_tbl_storage {
 #define IPA3_ACTIVE_CLIENTS_LOG_LINE_LEN 96
 #define IPA3_ACTIVE_CLIENTS_LOG_HASHTABLE_SIZE 50
 #define IPA3_ACTIVE_CLIENTS_LOG_NAME_LEN 40
+#define IPA_RT_TBL_NAME_HASH_BITS 6
+#define IPA_HDR_NAME_HASH_BITS 8
 #define SMEM_IPA_FILTER_TABLE 497
 #define IPA_TX_WRAPPER_CACHE_MAX_THRESHOLD 2000
+#define IPA_TX_DB_BATCH_BUDGET_DFLT 32
+#define IPA_TX_DB_BATCH_TIMEOUT_US_DFLT 100
+#define IPA_RX_MOD_HIST_BUCKETS 8
 
 enum {
 	SMEM_APPS,
@@ -813,6 +820,8 @@ struct ipa3_flt_entry {
  * @prev_mem: previous routing table block in sys memory
  * @id: routing table id
  * @rule_ids: common idr structure that holds the rule_id for each rule
+ * @dirty: rules of the table changed since the last commit
+ * @name_node: table's node in the name index of its collection
  */
 struct ipa3_rt_tbl {
 	struct list_head link;
@@ -829,6 +838,8 @@ struct ipa3_rt_tbl {
 	struct ipa_mem_buffer prev_mem[IPA_RULE_TYPE_MAX];
 	int id;
 	struct idr *rule_ids;
+	bool dirty;
+	struct hlist_node name_node;
 };
 
 /**
@@ -849,6 +860,7 @@ struct ipa3_rt_tbl {
  * @user_deleted: is the header deleted by the user?
  * @ipacm_installed: indicate if installed by ipacm
  * @is_lcl: is the entry in the SRAM?
+ * @name_node: entry's node in the name index of its header table
  */
 struct ipa3_hdr_entry {
 	struct list_head link;
@@ -867,6 +879,7 @@ struct ipa3_hdr_entry {
 	bool user_deleted;
 	bool ipacm_installed;
 	bool is_lcl;
+	struct hlist_node name_node;
 };
 
 /**
@@ -876,6 +889,7 @@ struct ipa3_hdr_entry {
  * @head_free_offset_list: header free offset list
  * @hdr_cnt: number of headers
  * @end: the last header index
+ * @name_htable: header entries of head_hdr_entry_list indexed by name
  */
 struct ipa3_hdr_tbl {
 	struct list_head head_hdr_entry_list;
@@ -883,6 +897,7 @@ struct ipa3_hdr_tbl {
 	struct list_head head_free_offset_list[IPA_HDR_BIN_MAX];
 	u32 hdr_cnt;
 	u32 end;
+	DECLARE_HASHTABLE(name_htable, IPA_HDR_NAME_HASH_BITS);
 };
 
 /**
@@ -959,6 +974,7 @@ struct ipa3_hdr_proc_ctx_tbl {
  * @rule_ids: common idr structure that holds the rule_id for each rule
  * @force_sys: flag indicating if filter table is forced to be
 			located in system memory
+ * @dirty: rules of the table changed since the last commit
  */
 struct ipa3_flt_tbl {
 	struct list_head head_flt_rule_list;
@@ -970,6 +986,7 @@ struct ipa3_flt_tbl {
 	bool sticky_rear;
 	struct idr *rule_ids;
 	bool force_sys[IPA_RULE_TYPE_MAX];
+	bool dirty;
 };
 
 struct ipa3_flt_tbl_nhash_lcl {
@@ -1015,11 +1032,36 @@ struct ipa3_rt_entry {
  * @head_rt_tbl_list: collection of routing tables
  * @tbl_cnt: number of routing tables
  * @rule_ids: idr structure that holds the rule_id for each rule
+ * @layout_dirty: tables were removed, or the hw tables were reset, since the
+ *  last commit, so the next one has to rebuild all the tables
+ * @name_htable: tables of head_rt_tbl_list indexed by name
  */
 struct ipa3_rt_tbl_set {
 	struct list_head head_rt_tbl_list;
 	u32 tbl_cnt;
 	struct idr rule_ids;
+	bool layout_dirty;
+	DECLARE_HASHTABLE(name_htable, IPA_RT_TBL_NAME_HASH_BITS);
+};
+
+/**
+ * struct ipa3_fltrt_commit_stats - flt/rt tables commit statistics
+ * @full: number of commits that rebuilt all the tables
+ * @dirty: number of commits that rebuilt the changed tables only
+ * @fallback: number of changed tables commits turned into full ones
+ * @rebuild_ns: total time spent generating the tables images
+ * @max_rebuild_ns: longest time spent generating the tables images
+ * @bytes_dma: number of bytes written to the sram by immediate commands
+ * @bytes_sys: number of bytes of sys memory table bodies generated
+ */
+struct ipa3_fltrt_commit_stats {
+	u64 full;
+	u64 dirty;
+	u64 fallback;
+	u64 rebuild_ns;
+	u64 max_rebuild_ns;
+	u64 bytes_dma;
+	u64 bytes_sys;
 };
 
 /**
@@ -1195,6 +1237,48 @@ struct ipa3_page_repl_ctx {
 	atomic_t pending;
 };
 
+/**
+ * struct ipa3_tx_db_stats - doorbell statistics of a GPI tx pipe
+ * @rings: number of doorbells rung for the pipe
+ * @descs: number of descriptors covered by these doorbells
+ * @max_batch: most descriptors covered by a single doorbell
+ * @deferred: number of sends which left the doorbell to a later one
+ * @budget: number of doorbells rung because the batch budget was reached
+ * @timeout: number of doorbells rung by the batch timer
+ */
+struct ipa3_tx_db_stats {
+	u64 rings;
+	u64 descs;
+	u32 max_batch;
+	u64 deferred;
+	u64 budget;
+	u64 timeout;
+};
+
+/**
+ * struct ipa3_rx_mod_ctx - adaptive interrupt/poll moderation of a rx pipe
+ * @mode_ts: time the pipe entered its current mode
+ * @cycle_ts: time the pipe last went back to interrupt mode
+ * @linger_until: time a NAPI poll without work may keep the pipe polling
+ * @cycle_pkts: packets handled since @cycle_ts
+ * @rate: smoothed packet rate over the last cycles, in packets per ms
+ * @linger_us: how long the pipe keeps polling after the last busy poll
+ * @lingered: polls kept in polling mode by @linger_us
+ * @intr_hist: time spent in interrupt mode, in log4 usec buckets
+ * @poll_hist: time spent in polling mode, in log4 usec buckets
+ */
+struct ipa3_rx_mod_ctx {
+	ktime_t mode_ts;
+	ktime_t cycle_ts;
+	ktime_t linger_until;
+	u64 cycle_pkts;
+	u32 rate;
+	u32 linger_us;
+	u64 lingered;
+	u64 intr_hist[IPA_RX_MOD_HIST_BUCKETS];
+	u64 poll_hist[IPA_RX_MOD_HIST_BUCKETS];
+};
+
 /**
  * struct ipa3_sys_context - IPA GPI pipes context
  * @head_desc_list: header descriptors list
@@ -1212,6 +1296,10 @@ struct ipa3_page_repl_ctx {
  * @buff_size: rx packet length
  * @page_order: page order of the rx pipe based on the ioctl version
  * @ext_ioctl_v2: specifies if it's new version of ingress/egress ioctl
+ * @db_pending: descriptors queued to the tx channel since its last doorbell
+ * @db_stats: doorbell statistics of the tx channel
+ * @db_batch_timer: rings the doorbell of a batch no send completed in time
+ * @rx_mod: adaptive interrupt/poll moderation state of the rx channel
  *
  * IPA context specific to the GPI pipes a.k.a LAN IN/OUT and WAN
  */
@@ -1259,6 +1347,9 @@ struct ipa3_sys_context {
 	bool common_buff_pool;
 	atomic_t page_avilable;
 	u32 napi_sort_page_thrshld_cnt;
+	u32 db_pending;
+	struct ipa3_tx_db_stats db_stats;
+	struct ipa3_rx_mod_ctx rx_mod;
 
 	/* ordering is important - mutable fields go above */
 	struct ipa3_ep_context *ep;
@@ -1268,6 +1359,7 @@ struct ipa3_sys_context {
 	u32 avail_tx_wrapper;
 	spinlock_t spinlock;
 	struct hrtimer db_timer;
+	struct hrtimer db_batch_timer;
 	struct workqueue_struct *wq;
 	struct workqueue_struct *repl_wq;
 	struct ipa3_status_stats *status_stat;
@@ -1592,6 +1684,7 @@ struct ipa3_page_recycle_stats {
 	u64 total_replenished;
 	u64 page_recycled;
 	u64 tmp_alloc;
+	u64 alloc_fail;
 };
 
 struct ipa3_cache_recycle_stats {
@@ -2339,6 +2432,11 @@ enum ipa_per_usb_enum_type_e {
  * @app_vote: holds userspace application clock vote count
  * IPA context - holds all relevant info about IPA driver and its state
  * @lan_rx_napi_enable: flag if NAPI is enabled on the LAN dp
+ * @tx_db_batch_budget: most descriptors a tx pipe may queue without ringing
+ *  its doorbell while senders report more packets to follow, 0 disables it
+ * @tx_db_batch_timeout_us: longest a tx pipe doorbell may be deferred
+ * @rx_mod_pinned: rx pipes use the fixed interrupt/poll switching instead of
+ *  the adaptive moderation
  * @generic_ndev: dummy netdev for LAN rx NAPI and tx NAPI
  * @napi_lan_rx: NAPI object for LAN rx
  * @ipa_wan_skb_page - page recycling enabled on wwan data path
@@ -2354,6 +2452,13 @@ enum ipa_per_usb_enum_type_e {
  * @eth_info: ethernet client mapping
  * @max_num_smmu_cb: number of smmu s1 cb supported
  * @non_hash_flt_lcl_sys_switch: number of times non-hash flt table moved
+ * @fltrt_dirty_commit: commit only the flt/rt tables that changed since the
+ *  last commit, as long as the layout of the tables allows it
+ * @flt_layout_dirty: the next flt commit has to rebuild all the tables
+ * @flt_skip_pipes: filtering pipes whose headers the last full flt commit
+ *  left to the modem
+ * @rt_commit_stats: rt tables commit statistics
+ * @flt_commit_stats: flt tables commit statistics
  * mhi_ctrl_state: state of mhi ctrl pipes
  * @per_stats_smem_pa: Peripheral stats physical address to be passed to Q6
  * @per_stats_smem_va: Peripheral stats virtual address to update stats from Apps
@@ -2408,6 +2513,11 @@ struct ipa3_context {
 	bool flt_tbl_hash_lcl[IPA_IP_MAX];
 	bool flt_tbl_nhash_lcl[IPA_IP_MAX];
 	struct list_head flt_tbl_nhash_lcl_list[IPA_IP_MAX];
+	bool fltrt_dirty_commit;
+	bool flt_layout_dirty[IPA_IP_MAX];
+	u64 flt_skip_pipes[IPA_IP_MAX];
+	struct ipa3_fltrt_commit_stats rt_commit_stats[IPA_IP_MAX];
+	struct ipa3_fltrt_commit_stats flt_commit_stats[IPA_IP_MAX];
 	struct ipa3_active_clients ipa3_active_clients;
 	struct ipa3_active_clients_log_ctx ipa3_active_clients_logging;
 	struct workqueue_struct *power_mgmt_wq;
@@ -2562,6 +2672,9 @@ struct ipa3_context {
 	bool lan_rx_napi_enable;
 	bool tx_napi_enable;
 	bool tx_poll;
+	u32 tx_db_batch_budget;
+	u32 tx_db_batch_timeout_us;
+	bool rx_mod_pinned;
 	struct net_device generic_ndev;
 	struct napi_struct napi_lan_rx;
 	u32 icc_num_cases;
@@ -3425,6 +3538,9 @@ int _ipa_init_flt6_v3(void);
 
 int __ipa_commit_flt_v3(enum ipa_ip_type ip);
 int __ipa_commit_rt_v3(enum ipa_ip_type ip);
+void ipa3_rt_set_layout_dirty(void);
+void ipa3_fltrt_commit_stats_rebuild(struct ipa3_fltrt_commit_stats *stats,
+	u64 start_ns);
 
 int __ipa_commit_hdr_v3_0(void);
 void ipa3_skb_recycle(struct sk_buff *skb);
@@ -3774,6 +3890,15 @@ static inline void *alloc_and_init(u32 size, u32 init_val)
 	return ptr;
 }
 
+/**
+ * ipa3_name_hash() - hash key of a routing table or header name
+ * @name: the name, shorter than IPA_RESOURCE_NAME_MAX
+ */
+static inline u32 ipa3_name_hash(const char *name)
+{
+	return jhash(name, strnlen(name, IPA_RESOURCE_NAME_MAX), 0);
+}
+
 /**
  * The following used as defaults for struct ipa_ioc_coal_evict_policy.
  */
@@ -16,6 +16,7 @@
 #define IPA_RT_STATUS_OF_MDFY_FAILED (-1)
 
 #define IPA_RT_MAX_NUM_OF_COMMIT_TABLES_CMD_DESC 6
+#define IPA_RT_MAX_NUM_OF_DIRTY_TBLS 4
 
 #define IPA_RT_GET_RULE_TYPE(__entry) \
 	( \
@@ -133,6 +134,59 @@ static int ipa_generate_rt_hw_rule(enum ipa_ip_type ip,
 	return res;
 }
 
+/**
+ * ipa_gen_rt_sys_tbl_body() - generate the body of a sys memory rt table
+ * @ip: the ip address family type
+ * @rlt: the type of the rules to generate (hashable or non-hashable)
+ * @tbl: the rt tbl, prepared for commit
+ *
+ * The new body becomes the current one of the table. The body it replaces
+ * is kept as the previous one, to be reaped once the hw no longer uses it.
+ *
+ * Returns: 0 on success, negative on failure
+ *
+ * caller needs to hold any needed locks to ensure integrity
+ */
+static int ipa_gen_rt_sys_tbl_body(enum ipa_ip_type ip,
+	enum ipa_rule_type rlt, struct ipa3_rt_tbl *tbl)
+{
+	struct ipa_mem_buffer tbl_mem;
+	struct ipa3_rt_entry *entry;
+	u8 *tbl_mem_buf;
+
+	/* only body (no header) */
+	tbl_mem.size = tbl->sz[rlt] - ipahal_get_hw_tbl_hdr_width();
+	/* Add prefetech buf size. */
+	tbl_mem.size += ipahal_get_hw_prefetch_buf_size();
+	if (ipahal_fltrt_allocate_hw_sys_tbl(&tbl_mem)) {
+		IPAERR_RL("fail to alloc sys tbl of size %d\n", tbl_mem.size);
+		return -ENOMEM;
+	}
+
+	tbl_mem_buf = tbl_mem.base;
+
+	/* generate the rule-set */
+	list_for_each_entry(entry, &tbl->head_rt_rule_list, link) {
+		if (IPA_RT_GET_RULE_TYPE(entry) != rlt)
+			continue;
+		if (ipa_generate_rt_hw_rule(ip, entry, tbl_mem_buf)) {
+			IPAERR_RL("failed to gen HW RT rule\n");
+			ipahal_free_dma_mem(&tbl_mem);
+			return -EPERM;
+		}
+		tbl_mem_buf += entry->hw_len;
+	}
+
+	if (tbl->curr_mem[rlt].phys_base) {
+		WARN_ON(tbl->prev_mem[rlt].phys_base);
+		tbl->prev_mem[rlt] = tbl->curr_mem[rlt];
+	}
+	tbl->curr_mem[rlt] = tbl_mem;
+	ipa3_ctx->rt_commit_stats[ip].bytes_sys += tbl_mem.size;
+
+	return 0;
+}
+
 /**
  * ipa_translate_rt_tbl_to_hw_fmt() - translate the routing driver structures
  *  (rules and tables) to HW format and fill it in the given buffers
@@ -155,8 +209,6 @@ static int ipa_translate_rt_tbl_to_hw_fmt(enum ipa_ip_type ip,
 {
 	struct ipa3_rt_tbl_set *set;
 	struct ipa3_rt_tbl *tbl;
-	struct ipa_mem_buffer tbl_mem;
-	u8 *tbl_mem_buf;
 	struct ipa3_rt_entry *entry;
 	int res;
 	u64 offset;
@@ -168,45 +220,15 @@ static int ipa_translate_rt_tbl_to_hw_fmt(enum ipa_ip_type ip,
 		if (tbl->sz[rlt] == 0)
 			continue;
 		if (tbl->in_sys[rlt]) {
-			/* only body (no header) */
-			tbl_mem.size = tbl->sz[rlt] -
-				ipahal_get_hw_tbl_hdr_width();
-			/* Add prefetech buf size. */
-			tbl_mem.size +=
-				ipahal_get_hw_prefetch_buf_size();
-			if (ipahal_fltrt_allocate_hw_sys_tbl(&tbl_mem)) {
-				IPAERR_RL("fail to alloc sys tbl of size %d\n",
-					tbl_mem.size);
+			if (ipa_gen_rt_sys_tbl_body(ip, rlt, tbl))
 				goto err;
-			}
 
-			if (ipahal_fltrt_write_addr_to_hdr(tbl_mem.phys_base,
-				hdr, tbl->idx - apps_start_idx, true)) {
+			if (ipahal_fltrt_write_addr_to_hdr(
+				tbl->curr_mem[rlt].phys_base, hdr,
+				tbl->idx - apps_start_idx, true)) {
 				IPAERR_RL("fail to wrt sys tbl addr to hdr\n");
-				goto hdr_update_fail;
-			}
-
-			tbl_mem_buf = tbl_mem.base;
-
-			/* generate the rule-set */
-			list_for_each_entry(entry, &tbl->head_rt_rule_list,
-					link) {
-				if (IPA_RT_GET_RULE_TYPE(entry) != rlt)
-					continue;
-				res = ipa_generate_rt_hw_rule(ip, entry,
-					tbl_mem_buf);
-				if (res) {
-					IPAERR_RL("failed to gen HW RT rule\n");
-					goto hdr_update_fail;
-				}
-				tbl_mem_buf += entry->hw_len;
-			}
-
-			if (tbl->curr_mem[rlt].phys_base) {
-				WARN_ON(tbl->prev_mem[rlt].phys_base);
-				tbl->prev_mem[rlt] = tbl->curr_mem[rlt];
+				goto err;
 			}
-			tbl->curr_mem[rlt] = tbl_mem;
 		} else {
 			offset = body_i - base + body_ofst;
 
@@ -214,7 +236,7 @@ static int ipa_translate_rt_tbl_to_hw_fmt(enum ipa_ip_type ip,
 			if (ipahal_fltrt_write_addr_to_hdr(offset, hdr,
 				tbl->idx, false)) {
 				IPAERR_RL("fail to wrt lcl tbl ofst to hdr\n");
-				goto hdr_update_fail;
+				goto err;
 			}
 
 			/* generate the rule-set */
@@ -244,8 +266,6 @@ static int ipa_translate_rt_tbl_to_hw_fmt(enum ipa_ip_type ip,
 
 	return 0;
 
-hdr_update_fail:
-	ipahal_free_dma_mem(&tbl_mem);
 err:
 	return -EPERM;
 }
@@ -455,19 +475,115 @@ static bool ipa_rt_valid_lcl_tbl_size(enum ipa_ip_type ipt,
 }
 
 /**
- * __ipa_commit_rt_v3() - commit rt tables to the hw
+ * ipa_rt_add_flush_cmds() - add the imm cmds preceding a rt tables update
+ * @ip: the ip address family type
+ * @desc: descriptors of the commit
+ * @cmd_pyld: imm cmds payloads of the commit
+ * @num_cmd: [IN/OUT] number of imm cmds of the commit
+ *
+ * Closes the coalescing frame if coalescing is enabled, and flushes the ipa
+ * internal hashable rt rules cache if hashable tables are supported.
+ *
+ * Return: 0 on success, negative on failure
+ */
+static int ipa_rt_add_flush_cmds(enum ipa_ip_type ip, struct ipa3_desc *desc,
+	struct ipahal_imm_cmd_pyld **cmd_pyld, int *num_cmd)
+{
+	struct ipahal_imm_cmd_register_write reg_write_cmd = {0};
+	struct ipahal_imm_cmd_register_write reg_write_coal_close;
+	struct ipahal_reg_valmask valmask;
+	int i;
+
+	/* IC to close the coal frame before HPS Clear if coal is enabled */
+	if (ipa_get_ep_mapping(IPA_CLIENT_APPS_WAN_COAL_CONS) != -1
+		&& !ipa3_ctx->ulso_wa) {
+		u32 offset = 0;
+
+		i = ipa_get_ep_mapping(IPA_CLIENT_APPS_WAN_COAL_CONS);
+		reg_write_coal_close.skip_pipeline_clear = false;
+		reg_write_coal_close.pipeline_clear_options = IPAHAL_HPS_CLEAR;
+		if (ipa3_ctx->ipa_hw_type < IPA_HW_v5_0)
+			offset = ipahal_get_reg_ofst(
+				IPA_AGGR_FORCE_CLOSE);
+		else
+			offset = ipahal_get_ep_reg_offset(
+				IPA_AGGR_FORCE_CLOSE_n, i);
+		reg_write_coal_close.offset = offset;
+		ipahal_get_aggr_force_close_valmask(i, &valmask);
+		reg_write_coal_close.value = valmask.val;
+		reg_write_coal_close.value_mask = valmask.mask;
+		cmd_pyld[*num_cmd] = ipahal_construct_imm_cmd(
+			IPA_IMM_CMD_REGISTER_WRITE,
+			&reg_write_coal_close, false);
+		if (!cmd_pyld[*num_cmd]) {
+			IPAERR("failed to construct coal close IC\n");
+			return -ENOMEM;
+		}
+		ipa3_init_imm_cmd_desc(&desc[*num_cmd], cmd_pyld[*num_cmd]);
+		++*num_cmd;
+	}
+
+	/*
+	 * SRAM memory not allocated to hash tables. Sending
+	 * command to hash tables(filer/routing) operation not supported.
+	 */
+	if (!ipa3_ctx->ipa_fltrt_not_hashable) {
+		/* flushing ipa internal hashable rt rules cache */
+		if (ipa3_ctx->ipa_hw_type >= IPA_HW_v5_0) {
+			struct ipahal_reg_fltrt_cache_flush flush_cache;
+
+			memset(&flush_cache, 0, sizeof(flush_cache));
+			flush_cache.rt = true;
+			ipahal_get_fltrt_cache_flush_valmask(
+				&flush_cache, &valmask);
+			reg_write_cmd.offset = ipahal_get_reg_ofst(
+				IPA_FILT_ROUT_CACHE_FLUSH);
+		} else {
+			struct ipahal_reg_fltrt_hash_flush flush_hash;
+
+			memset(&flush_hash, 0, sizeof(flush_hash));
+			if (ip == IPA_IP_v4)
+				flush_hash.v4_rt = true;
+			else
+				flush_hash.v6_rt = true;
+			ipahal_get_fltrt_hash_flush_valmask(
+				&flush_hash, &valmask);
+			reg_write_cmd.offset = ipahal_get_reg_ofst(
+				IPA_FILT_ROUT_HASH_FLUSH);
+		}
+		reg_write_cmd.skip_pipeline_clear = false;
+		reg_write_cmd.pipeline_clear_options = IPAHAL_HPS_CLEAR;
+		reg_write_cmd.value = valmask.val;
+		reg_write_cmd.value_mask = valmask.mask;
+		cmd_pyld[*num_cmd] = ipahal_construct_imm_cmd(
+				IPA_IMM_CMD_REGISTER_WRITE, &reg_write_cmd,
+							false);
+		if (!cmd_pyld[*num_cmd]) {
+			IPAERR(
+			"fail construct register_write imm cmd. IP %d\n", ip);
+			return -ENOMEM;
+		}
+		ipa3_init_imm_cmd_desc(&desc[*num_cmd], cmd_pyld[*num_cmd]);
+		++*num_cmd;
+	}
+
+	return 0;
+}
+
+/**
+ * ipa_rt_commit_all_tbls() - commit all the rt tables to the hw
  * commit the headers and the bodies if are local with internal cache flushing
  * @ipt: the ip address family type
  *
  * Return: 0 on success, negative on failure
  */
-int __ipa_commit_rt_v3(enum ipa_ip_type ip)
+static int ipa_rt_commit_all_tbls(enum ipa_ip_type ip)
 {
 	struct ipa3_desc desc[IPA_RT_MAX_NUM_OF_COMMIT_TABLES_CMD_DESC];
-	struct ipahal_imm_cmd_register_write reg_write_cmd = {0};
 	struct ipahal_imm_cmd_dma_shared_mem  mem_cmd = {0};
 	struct ipahal_imm_cmd_pyld
 		*cmd_pyld[IPA_RT_MAX_NUM_OF_COMMIT_TABLES_CMD_DESC];
+	struct ipa3_fltrt_commit_stats *stats = &ipa3_ctx->rt_commit_stats[ip];
 	int num_cmd = 0;
 	struct ipahal_fltrt_alloc_imgs_params alloc_params;
 	u32 num_modem_rt_index;
@@ -475,12 +591,12 @@ int __ipa_commit_rt_v3(enum ipa_ip_type ip)
 	u32 lcl_hash_hdr, lcl_nhash_hdr;
 	u32 lcl_hash_bdy, lcl_nhash_bdy;
 	bool lcl_hash, lcl_nhash;
-	struct ipahal_reg_valmask valmask;
 	int i;
 	struct ipa3_rt_tbl_set *set;
 	struct ipa3_rt_tbl *tbl;
 	u32 tbl_hdr_width;
-	struct ipahal_imm_cmd_register_write reg_write_coal_close;
+	u32 bytes_dma = 0;
+	u64 start_ns;
 
 	tbl_hdr_width = ipahal_get_hw_tbl_hdr_width();
 	memset(desc, 0, sizeof(desc));
@@ -532,6 +648,7 @@ int __ipa_commit_rt_v3(enum ipa_ip_type ip)
 		goto no_rt_tbls;
 	}
 
+	start_ns = ktime_get_ns();
 	set = &ipa3_ctx->rt_tbl_set[ip];
 	list_for_each_entry(tbl, &set->head_rt_tbl_list, link) {
 		if (ipa_prep_rt_tbl_for_cmt(ip, tbl)) {
@@ -559,6 +676,7 @@ int __ipa_commit_rt_v3(enum ipa_ip_type ip)
 		rc = -EFAULT;
 		goto no_rt_tbls;
 	}
+	ipa3_fltrt_commit_stats_rebuild(stats, start_ns);
 
 	if (!ipa_rt_valid_lcl_tbl_size(ip, IPA_RULE_HASHABLE,
 		&alloc_params.hash_bdy)) {
@@ -571,77 +689,9 @@ int __ipa_commit_rt_v3(enum ipa_ip_type ip)
 		goto fail_size_valid;
 	}
 
-	/* IC to close the coal frame before HPS Clear if coal is enabled */
-	if (ipa_get_ep_mapping(IPA_CLIENT_APPS_WAN_COAL_CONS) != -1
-		&& !ipa3_ctx->ulso_wa) {
-		u32 offset = 0;
-
-		i = ipa_get_ep_mapping(IPA_CLIENT_APPS_WAN_COAL_CONS);
-		reg_write_coal_close.skip_pipeline_clear = false;
-		reg_write_coal_close.pipeline_clear_options = IPAHAL_HPS_CLEAR;
-		if (ipa3_ctx->ipa_hw_type < IPA_HW_v5_0)
-			offset = ipahal_get_reg_ofst(
-				IPA_AGGR_FORCE_CLOSE);
-		else
-			offset = ipahal_get_ep_reg_offset(
-				IPA_AGGR_FORCE_CLOSE_n, i);
-		reg_write_coal_close.offset = offset;
-		ipahal_get_aggr_force_close_valmask(i, &valmask);
-		reg_write_coal_close.value = valmask.val;
-		reg_write_coal_close.value_mask = valmask.mask;
-		cmd_pyld[num_cmd] = ipahal_construct_imm_cmd(
-			IPA_IMM_CMD_REGISTER_WRITE,
-			&reg_write_coal_close, false);
-		if (!cmd_pyld[num_cmd]) {
-			IPAERR("failed to construct coal close IC\n");
-			goto fail_size_valid;
-		}
-		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
-		++num_cmd;
-	}
-
-	/*
-	 * SRAM memory not allocated to hash tables. Sending
-	 * command to hash tables(filer/routing) operation not supported.
-	 */
-	if (!ipa3_ctx->ipa_fltrt_not_hashable) {
-		/* flushing ipa internal hashable rt rules cache */
-		if (ipa3_ctx->ipa_hw_type >= IPA_HW_v5_0) {
-			struct ipahal_reg_fltrt_cache_flush flush_cache;
-
-			memset(&flush_cache, 0, sizeof(flush_cache));
-			flush_cache.rt = true;
-			ipahal_get_fltrt_cache_flush_valmask(
-				&flush_cache, &valmask);
-			reg_write_cmd.offset = ipahal_get_reg_ofst(
-				IPA_FILT_ROUT_CACHE_FLUSH);
-		} else {
-			struct ipahal_reg_fltrt_hash_flush flush_hash;
-
-			memset(&flush_hash, 0, sizeof(flush_hash));
-			if (ip == IPA_IP_v4)
-				flush_hash.v4_rt = true;
-			else
-				flush_hash.v6_rt = true;
-			ipahal_get_fltrt_hash_flush_valmask(
-				&flush_hash, &valmask);
-			reg_write_cmd.offset = ipahal_get_reg_ofst(
-				IPA_FILT_ROUT_HASH_FLUSH);
-		}
-		reg_write_cmd.skip_pipeline_clear = false;
-		reg_write_cmd.pipeline_clear_options = IPAHAL_HPS_CLEAR;
-		reg_write_cmd.value = valmask.val;
-		reg_write_cmd.value_mask = valmask.mask;
-		cmd_pyld[num_cmd] = ipahal_construct_imm_cmd(
-				IPA_IMM_CMD_REGISTER_WRITE, &reg_write_cmd,
-							false);
-		if (!cmd_pyld[num_cmd]) {
-			IPAERR(
-			"fail construct register_write imm cmd. IP %d\n", ip);
-			goto fail_imm_cmd_construct;
-		}
-		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
-		num_cmd++;
+	if (ipa_rt_add_flush_cmds(ip, desc, cmd_pyld, &num_cmd)) {
+		rc = -ENOMEM;
+		goto fail_imm_cmd_construct;
 	}
 
 	mem_cmd.is_read = false;
@@ -658,6 +708,7 @@ int __ipa_commit_rt_v3(enum ipa_ip_type ip)
 	}
 	ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
 	num_cmd++;
+	bytes_dma += mem_cmd.size;
 
 	/*
 	 * SRAM memory not allocated to hash tables. Sending
@@ -679,6 +730,7 @@ int __ipa_commit_rt_v3(enum ipa_ip_type ip)
 		}
 		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
 		num_cmd++;
+		bytes_dma += mem_cmd.size;
 	}
 
 	if (lcl_nhash) {
@@ -704,6 +756,7 @@ int __ipa_commit_rt_v3(enum ipa_ip_type ip)
 		}
 		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
 		num_cmd++;
+		bytes_dma += mem_cmd.size;
 	}
 	if (lcl_hash) {
 		if (num_cmd >= IPA_RT_MAX_NUM_OF_COMMIT_TABLES_CMD_DESC) {
@@ -728,6 +781,7 @@ int __ipa_commit_rt_v3(enum ipa_ip_type ip)
 		}
 		ipa3_init_imm_cmd_desc(&desc[num_cmd], cmd_pyld[num_cmd]);
 		num_cmd++;
+		bytes_dma += mem_cmd.size;
 	}
 
 	if (ipa3_send_cmd(num_cmd, desc)) {
@@ -735,6 +789,7 @@ int __ipa_commit_rt_v3(enum ipa_ip_type ip)
 		rc = -EFAULT;
 		goto fail_imm_cmd_construct;
 	}
+	stats->bytes_dma += bytes_dma;
 
 	IPADBG_LOW("Hashable HEAD\n");
 	IPA_DUMP_BUFF(alloc_params.hash_hdr.base,
@@ -776,6 +831,287 @@ no_rt_tbls:
 	return rc;
 }
 
+/**
+ * ipa_rt_rollback_sys_tbls() - give the dirty rt tables back the sys bodies
+ *  the hw still uses, after a failed commit of their new ones
+ * @ip: the ip address family type
+ */
+static void ipa_rt_rollback_sys_tbls(enum ipa_ip_type ip)
+{
+	struct ipa3_rt_tbl *tbl;
+	int i;
+
+	list_for_each_entry(tbl, &ipa3_ctx->rt_tbl_set[ip].head_rt_tbl_list,
+		link) {
+		if (!tbl->dirty)
+			continue;
+		for (i = 0; i < IPA_RULE_TYPE_MAX; i++) {
+			if (!tbl->prev_mem[i].phys_base)
+				continue;
+			ipahal_free_dma_mem(&tbl->curr_mem[i]);
+			tbl->curr_mem[i] = tbl->prev_mem[i];
+			memset(&tbl->prev_mem[i], 0, sizeof(tbl->prev_mem[i]));
+		}
+	}
+}
+
+/**
+ * ipa_rt_commit_dirty_tbls() - commit the rt tables changed since the last
+ *  commit to the hw
+ * @ip: the ip address family type
+ *
+ * The sys bodies of the dirty tables are regenerated and their header
+ * entries are rewritten in place, one imm cmd each, leaving the rest of the
+ * header and the other tables as the hw has them. Local bodies are packed
+ * back-to-back and tables moving in or out of the header need the whole of
+ * it, so such changes are left to a full commit.
+ *
+ * Return: 0 on success, -EAGAIN if a full commit is needed, other negative
+ *  on failure
+ */
+static int ipa_rt_commit_dirty_tbls(enum ipa_ip_type ip)
+{
+	struct ipa3_rt_tbl_set *set = &ipa3_ctx->rt_tbl_set[ip];
+	struct ipa3_fltrt_commit_stats *stats = &ipa3_ctx->rt_commit_stats[ip];
+	struct ipahal_imm_cmd_dma_shared_mem mem_cmd = {0};
+	struct ipahal_imm_cmd_pyld **cmd_pyld;
+	struct ipa3_desc *desc;
+	struct ipa_mem_buffer hdr_mem;
+	struct ipa3_rt_tbl *tbl;
+	u32 lcl_hdr[IPA_RULE_TYPE_MAX];
+	u32 old_sz[IPA_RULE_TYPE_MAX];
+	u32 num_modem_rt_index;
+	u32 apps_start_idx;
+	u32 tbl_hdr_width;
+	int num_dirty = 0;
+	int num_hdr = 0;
+	int num_cmd = 0;
+	u64 start_ns;
+	int rc = 0;
+	int i;
+
+	if (!ipa3_ctx->fltrt_dirty_commit || set->layout_dirty)
+		return -EAGAIN;
+
+	list_for_each_entry(tbl, &set->head_rt_tbl_list, link) {
+		if (!tbl->dirty)
+			continue;
+		if (!tbl->in_sys[IPA_RULE_HASHABLE] ||
+			!tbl->in_sys[IPA_RULE_NON_HASHABLE] ||
+			tbl->prev_mem[IPA_RULE_HASHABLE].phys_base ||
+			tbl->prev_mem[IPA_RULE_NON_HASHABLE].phys_base ||
+			++num_dirty > IPA_RT_MAX_NUM_OF_DIRTY_TBLS)
+			goto fallback;
+	}
+
+	if (!num_dirty)
+		return 0;
+
+	tbl_hdr_width = ipahal_get_hw_tbl_hdr_width();
+	if (ip == IPA_IP_v4) {
+		num_modem_rt_index =
+			IPA_MEM_PART(v4_modem_rt_index_hi) -
+			IPA_MEM_PART(v4_modem_rt_index_lo) + 1;
+		lcl_hdr[IPA_RULE_HASHABLE] = ipa3_ctx->smem_restricted_bytes +
+			IPA_MEM_PART(v4_rt_hash_ofst);
+		lcl_hdr[IPA_RULE_NON_HASHABLE] =
+			ipa3_ctx->smem_restricted_bytes +
+			IPA_MEM_PART(v4_rt_nhash_ofst);
+		apps_start_idx = IPA_MEM_PART(v4_apps_rt_index_lo);
+	} else {
+		num_modem_rt_index =
+			IPA_MEM_PART(v6_modem_rt_index_hi) -
+			IPA_MEM_PART(v6_modem_rt_index_lo) + 1;
+		lcl_hdr[IPA_RULE_HASHABLE] = ipa3_ctx->smem_restricted_bytes +
+			IPA_MEM_PART(v6_rt_hash_ofst);
+		lcl_hdr[IPA_RULE_NON_HASHABLE] =
+			ipa3_ctx->smem_restricted_bytes +
+			IPA_MEM_PART(v6_rt_nhash_ofst);
+		apps_start_idx = IPA_MEM_PART(v6_apps_rt_index_lo);
+	}
+	for (i = 0; i < IPA_RULE_TYPE_MAX; i++)
+		lcl_hdr[i] += num_modem_rt_index * tbl_hdr_width;
+
+	start_ns = ktime_get_ns();
+	list_for_each_entry(tbl, &set->head_rt_tbl_list, link) {
+		if (!tbl->dirty)
+			continue;
+		memcpy(old_sz, tbl->sz, sizeof(old_sz));
+		if (ipa_prep_rt_tbl_for_cmt(ip, tbl))
+			return -EPERM;
+		for (i = 0; i < IPA_RULE_TYPE_MAX; i++) {
+			/* the header entry has to point to the empty table */
+			if (old_sz[i] && !tbl->sz[i])
+				goto fallback;
+			if (tbl->sz[i])
+				num_hdr++;
+		}
+	}
+
+	/* +2: for closing the coalescing frame and for flushing */
+	desc = kcalloc(num_hdr + 2, sizeof(*desc), GFP_KERNEL);
+	cmd_pyld = kcalloc(num_hdr + 2, sizeof(*cmd_pyld), GFP_KERNEL);
+	hdr_mem.size = max(num_hdr, 1) * tbl_hdr_width;
+	hdr_mem.base = dma_alloc_coherent(ipa3_ctx->pdev, hdr_mem.size,
+		&hdr_mem.phys_base, GFP_KERNEL);
+	if (!desc || !cmd_pyld || !hdr_mem.base) {
+		IPAERR("fail to alloc dirty tbls commit buffers. IP %d\n", ip);
+		rc = -ENOMEM;
+		goto fail_alloc;
+	}
+
+	if (ipa_rt_add_flush_cmds(ip, desc, cmd_pyld, &num_cmd)) {
+		rc = -ENOMEM;
+		goto fail_imm_cmd_construct;
+	}
+
+	num_hdr = 0;
+	list_for_each_entry(tbl, &set->head_rt_tbl_list, link) {
+		if (!tbl->dirty)
+			continue;
+		for (i = 0; i < IPA_RULE_TYPE_MAX; i++) {
+			if (!tbl->sz[i])
+				continue;
+			if (ipa_gen_rt_sys_tbl_body(ip, i, tbl)) {
+				rc = -EPERM;
+				goto fail_imm_cmd_construct;
+			}
+			/*
+			 * SRAM memory not allocated to hash tables. Sending
+			 * command to hash tables(filer/routing) operation not
+			 * supported.
+			 */
+			if (i == IPA_RULE_HASHABLE &&
+				ipa3_ctx->ipa_fltrt_not_hashable)
+				continue;
+
+			if (ipahal_fltrt_write_addr_to_hdr(
+				tbl->curr_mem[i].phys_base, hdr_mem.base,
+				num_hdr, true)) {
+				IPAERR_RL("fail to wrt sys tbl addr to hdr\n");
+				rc = -EPERM;
+				goto fail_imm_cmd_construct;
+			}
+			mem_cmd.is_read = false;
+			mem_cmd.skip_pipeline_clear = false;
+			mem_cmd.pipeline_clear_options = IPAHAL_HPS_CLEAR;
+			mem_cmd.size = tbl_hdr_width;
+			mem_cmd.system_addr = hdr_mem.phys_base +
+				num_hdr * tbl_hdr_width;
+			mem_cmd.local_addr = lcl_hdr[i] +
+				(tbl->idx - apps_start_idx) * tbl_hdr_width;
+			cmd_pyld[num_cmd] = ipahal_construct_imm_cmd(
+				IPA_IMM_CMD_DMA_SHARED_MEM, &mem_cmd, false);
+			if (!cmd_pyld[num_cmd]) {
+				IPAERR(
+				"fail construct dma_shared_mem cmd. IP %d\n",
+					ip);
+				rc = -ENOMEM;
+				goto fail_imm_cmd_construct;
+			}
+			ipa3_init_imm_cmd_desc(&desc[num_cmd],
+				cmd_pyld[num_cmd]);
+			num_cmd++;
+			num_hdr++;
+		}
+	}
+	ipa3_fltrt_commit_stats_rebuild(stats, start_ns);
+
+	if (ipa3_send_cmd(num_cmd, desc)) {
+		IPAERR_RL("fail to send immediate command\n");
+		rc = -EFAULT;
+		goto fail_imm_cmd_construct;
+	}
+	stats->bytes_dma += num_hdr * tbl_hdr_width;
+
+	IPADBG_LOW("committed %d dirty rt tbls, %d hdr entries. IP %d\n",
+		num_dirty, num_hdr, ip);
+
+	__ipa_reap_sys_rt_tbls(ip);
+
+fail_imm_cmd_construct:
+	if (rc)
+		ipa_rt_rollback_sys_tbls(ip);
+	for (i = 0 ; i < num_cmd ; i++)
+		ipahal_destroy_imm_cmd(cmd_pyld[i]);
+fail_alloc:
+	if (hdr_mem.base)
+		dma_free_coherent(ipa3_ctx->pdev, hdr_mem.size, hdr_mem.base,
+			hdr_mem.phys_base);
+	kfree(cmd_pyld);
+	kfree(desc);
+	return rc;
+
+fallback:
+	stats->fallback++;
+	return -EAGAIN;
+}
+
+/**
+ * __ipa_commit_rt_v3() - commit rt tables to the hw
+ * @ipt: the ip address family type
+ *
+ * Only the tables changed since the last commit are committed when
+ * fltrt_dirty_commit is set and their layout allows it, all the tables are
+ * committed otherwise.
+ *
+ * Return: 0 on success, negative on failure
+ */
+int __ipa_commit_rt_v3(enum ipa_ip_type ip)
+{
+	struct ipa3_rt_tbl_set *set = &ipa3_ctx->rt_tbl_set[ip];
+	struct ipa3_fltrt_commit_stats *stats = &ipa3_ctx->rt_commit_stats[ip];
+	struct ipa3_rt_tbl *tbl;
+	int rc;
+
+	rc = ipa_rt_commit_dirty_tbls(ip);
+	if (rc == -EAGAIN) {
+		rc = ipa_rt_commit_all_tbls(ip);
+		if (!rc)
+			stats->full++;
+	} else if (!rc) {
+		stats->dirty++;
+	}
+
+	if (rc) {
+		/* the hw may have any of the tables, rebuild them all */
+		set->layout_dirty = true;
+		return rc;
+	}
+
+	set->layout_dirty = false;
+	list_for_each_entry(tbl, &set->head_rt_tbl_list, link)
+		tbl->dirty = false;
+
+	return 0;
+}
+
+/**
+ * ipa3_rt_set_layout_dirty() - have the next commit of each ip family
+ *  rebuild all the rt tables
+ */
+void ipa3_rt_set_layout_dirty(void)
+{
+	ipa3_ctx->rt_tbl_set[IPA_IP_v4].layout_dirty = true;
+	ipa3_ctx->rt_tbl_set[IPA_IP_v6].layout_dirty = true;
+}
+
+/**
+ * ipa3_fltrt_commit_stats_rebuild() - account the time spent generating
+ *  flt/rt tables images
+ * @stats: commit statistics to update
+ * @start_ns: ktime_get_ns() when the generation started
+ */
+void ipa3_fltrt_commit_stats_rebuild(struct ipa3_fltrt_commit_stats *stats,
+	u64 start_ns)
+{
+	u64 rebuild_ns = ktime_get_ns() - start_ns;
+
+	stats->rebuild_ns += rebuild_ns;
+	if (rebuild_ns > stats->max_rebuild_ns)
+		stats->max_rebuild_ns = rebuild_ns;
+}
+
 /**
  * __ipa3_find_rt_tbl() - find the routing table
  *			which name is given as parameter
@@ -796,8 +1132,9 @@ struct ipa3_rt_tbl *__ipa3_find_rt_tbl(enum ipa_ip_type ip, const char *name)
 	}
 
 	set = &ipa3_ctx->rt_tbl_set[ip];
-	list_for_each_entry(entry, &set->head_rt_tbl_list, link) {
-		if (!ipa3_check_idr_if_freed(entry) &&
+	hash_for_each_possible(set->name_htable, entry, name_node,
+		ipa3_name_hash(name)) {
+		if (ipa3_id_find(entry->id) == entry &&
 			!strcmp(name, entry->name))
 			return entry;
 	}
@@ -897,6 +1234,8 @@ static struct ipa3_rt_tbl *__ipa_add_rt_tbl(enum ipa_ip_type ip,
 		set->tbl_cnt++;
 		entry->rule_ids = &set->rule_ids;
 		list_add(&entry->link, &set->head_rt_tbl_list);
+		hash_add(set->name_htable, &entry->name_node,
+			ipa3_name_hash(entry->name));
 
 		IPADBG("add rt tbl idx=%d tbl_cnt=%d ip=%d\n", entry->idx,
 				set->tbl_cnt, ip);
@@ -914,6 +1253,7 @@ static struct ipa3_rt_tbl *__ipa_add_rt_tbl(enum ipa_ip_type ip,
 ipa_insert_failed:
 	set->tbl_cnt--;
 	list_del(&entry->link);
+	hash_del(&entry->name_node);
 	idr_destroy(entry->rule_ids);
 fail_rt_idx_alloc:
 	entry->cookie = 0;
@@ -949,7 +1289,9 @@ static int __ipa_del_rt_tbl(struct ipa3_rt_tbl *entry)
 
 	rset = &ipa3_ctx->reap_rt_tbl_set[ip];
 
+	entry->set->layout_dirty = true;
 	entry->rule_ids = NULL;
+	hash_del(&entry->name_node);
 	if (entry->in_sys[IPA_RULE_HASHABLE] ||
 		entry->in_sys[IPA_RULE_NON_HASHABLE]) {
 		list_move(&entry->link, &rset->head_rt_tbl_list);
@@ -1107,6 +1449,7 @@ static int __ipa_finish_rt_rule_add(struct ipa3_rt_entry *entry, u32 *rule_hdl,
 {
 	int id, res = 0;
 
+	tbl->dirty = true;
 	if (tbl->rule_cnt < IPA_RULE_CNT_MAX)
 		tbl->rule_cnt++;
 	else {
@@ -1827,6 +2170,7 @@ int __ipa3_del_rt_rule(u32 rule_hdl)
 		__ipa3_release_hdr_proc_ctx(entry->proc_ctx->id);
 	list_del(&entry->link);
 	entry->tbl->rule_cnt--;
+	entry->tbl->dirty = true;
 	IPADBG("del rt rule tbl_idx=%d rule_cnt=%d rule_id=%d\n ref_cnt=%u",
 		entry->tbl->idx, entry->tbl->rule_cnt,
 		entry->rule_id, entry->tbl->ref_cnt);
@@ -1972,6 +2316,7 @@ int ipa3_reset_rt(enum ipa_ip_type ip, bool user_only)
 	rset = &ipa3_ctx->reap_rt_tbl_set[ip];
 	mutex_lock(&ipa3_ctx->lock);
 	IPADBG("reset rt ip=%d\n", ip);
+	set->layout_dirty = true;
 	list_for_each_entry_safe(tbl, tbl_next, &set->head_rt_tbl_list, link) {
 		tbl_user = false;
 		list_for_each_entry_safe(rule, rule_next,
@@ -2052,6 +2397,7 @@ int ipa3_reset_rt(enum ipa_ip_type ip, bool user_only)
 		if (tbl->idx != apps_start_idx) {
 			if (!user_only || tbl_user) {
 				tbl->rule_ids = NULL;
+				hash_del(&tbl->name_node);
 				if (tbl->in_sys[IPA_RULE_HASHABLE] ||
 					tbl->in_sys[IPA_RULE_NON_HASHABLE]) {
 					list_move(&tbl->link,
@@ -2248,6 +2594,7 @@ static int __ipa_mdfy_rt_rule(struct ipa_rt_rule_mdfy_i *rtrule)
 	entry->rule = rtrule->rule;
 	entry->hdr = hdr;
 	entry->proc_ctx = proc_ctx;
+	entry->tbl->dirty = true;
 
 	if (entry->hdr)
 		entry->hdr->ref_cnt++;
@@ -1431,6 +1431,7 @@ static netdev_tx_t ipa3_wwan_xmit(struct sk_buff *skb, struct net_device *dev)
 	bool qmap_check;
 	struct ipa3_wwan_private *wwan_ptr = netdev_priv(dev);
 	unsigned long flags;
+	struct ipa_tx_meta meta;
 
 	if (rmnet_ipa3_ctx->ipa_config_is_apq) {
 		IPAWANERR_RL("IPA embedded data on APQ platform\n");
@@ -1525,11 +1526,22 @@ send:
 	atomic_inc(&wwan_ptr->outstanding_pkts);
 	spin_unlock_irqrestore(&wwan_ptr->lock, flags);
 
+	/*
+	 * let a burst of packets share one doorbell, unless the queue got
+	 * stopped and the stack will not send the rest of it
+	 */
+	memset(&meta, 0, sizeof(meta));
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 2, 0))
+	meta.xmit_more = netdev_xmit_more() && !netif_queue_stopped(dev);
+#else
+	meta.xmit_more = skb->xmit_more && !netif_queue_stopped(dev);
+#endif
+
 	/*
 	 * both data packets and command will be routed to
 	 * IPA_CLIENT_Q6_WAN_CONS based on status configuration
 	 */
-	ret = ipa_tx_dp(IPA_CLIENT_APPS_WAN_PROD, skb, NULL);
+	ret = ipa_tx_dp(IPA_CLIENT_APPS_WAN_PROD, skb, &meta);
 	if (ret) {
 		atomic_dec(&wwan_ptr->outstanding_pkts);
 		if (ret == -EPIPE) {
@@ -168,6 +168,45 @@ int ipa_nat_add_ipv4_rule(uint32_t table_handle,
 int ipa_nat_del_ipv4_rule(uint32_t table_handle,
 				uint32_t rule_handle);
 
+/**
+ * ipa_nat_add_ipv4_rules() - to insert a batch of new ipv4 rules
+ * @table_handle: [in] handle of ipv4 nat table
+ * @rules: [in] array of new rules
+ * @num_rules: [in] number of rules in @rules
+ * @rule_handles: [out] handles of the inserted rules, in @rules order
+ * @num_added: [out] number of rules inserted
+ *
+ * Same as calling ipa_nat_add_ipv4_rule() for each rule, but the
+ * table is locked once for the whole batch and the DMA commands of
+ * the rules are coalesced into as few driver calls as possible.
+ * On failure, the first @num_added rules have been inserted.
+ *
+ * Returns:	0  On Success, negative on failure
+ */
+int ipa_nat_add_ipv4_rules(uint32_t table_handle,
+				const ipa_nat_ipv4_rule *rules,
+				uint32_t num_rules,
+				uint32_t *rule_handles,
+				uint32_t *num_added);
+
+/**
+ * ipa_nat_del_ipv4_rules() - to delete a batch of ipv4 nat rules
+ * @table_handle: [in] handle of ipv4 nat table
+ * @rule_handles: [in] array of ipv4 nat rule handles
+ * @num_rules: [in] number of handles in @rule_handles
+ * @num_deleted: [out] number of rules deleted
+ *
+ * Same as calling ipa_nat_del_ipv4_rule() for each handle, but with
+ * the DMA commands coalesced as for ipa_nat_add_ipv4_rules().
+ * On failure, the first @num_deleted rules have been deleted.
+ *
+ * Returns:	0  On Success, negative on failure
+ */
+int ipa_nat_del_ipv4_rules(uint32_t table_handle,
+				const uint32_t *rule_handles,
+				uint32_t num_rules,
+				uint32_t *num_deleted);
+
 
 /**
  * ipa_nat_query_timestamp() - to query timestamp
@@ -267,5 +306,20 @@ int ipa_nat_switch_to(
 	enum ipa3_nat_mem_in nmi,
 	bool                 hold_state );
 
+/**
+ * ipa_nat_set_switch_chunk() - While in HYBRID mode only, sets how a
+ * switch from SRAM to DDR, or the reverse, moves the rules
+ * @rules_per_step: [in] when zero (the default), all rules are moved
+ *                  at once, when the switch happens. Otherwise, the
+ *                  switch moves at most this many rules, and each
+ *                  later rule add/delete moves at most this many more
+ *                  until done. Meanwhile, new rules go to the memory
+ *                  type switched to and rules are looked for in both.
+ *
+ * Returns:	0  On Success, negative on failure
+ */
+int ipa_nat_set_switch_chunk(
+	uint32_t rules_per_step );
+
 #endif
 
@@ -308,6 +308,17 @@ int ipa_nati_add_ipv4_rule(uint32_t tbl_hdl,
 int ipa_nati_del_ipv4_rule(uint32_t tbl_hdl,
 				uint32_t rule_hdl);
 
+int ipa_nati_add_ipv4_rules(uint32_t tbl_hdl,
+				const ipa_nat_ipv4_rule *clnt_rules,
+				uint32_t num_rules,
+				uint32_t *rule_hdls,
+				uint32_t *num_added);
+
+int ipa_nati_del_ipv4_rules(uint32_t tbl_hdl,
+				const uint32_t *rule_hdls,
+				uint32_t num_rules,
+				uint32_t *num_deleted);
+
 int ipa_nati_get_sram_size(
 	uint32_t* size_ptr);
 
@@ -379,6 +390,18 @@ int ipa_NATI_walk_ipv4_tbl(
 	ipa_table_walk_cb walk_cb,
 	void*             arb_data_ptr );
 
+/*
+ * As above, but starting at the start_index'th record. A walk_cb
+ * returning a positive value stops the walk early, and that value is
+ * returned.
+ */
+int ipa_NATI_walk_ipv4_tbl_from(
+	uint32_t          tbl_hdl,
+	WhichTbl2Use      which,
+	uint16_t          start_index,
+	ipa_table_walk_cb walk_cb,
+	void*             arb_data_ptr );
+
 int ipa_NATI_ipv4_tbl_stats(
 	uint32_t            tbl_hdl,
 	ipa_nati_tbl_stats* nat_stats_ptr,
@@ -398,7 +421,43 @@ int ipa_NATI_del_ipv4_rule(
 	uint32_t tbl_hdl,
 	uint32_t rule_hdl);
 
+int ipa_NATI_add_ipv4_rules(
+	uint32_t                 tbl_hdl,
+	const ipa_nat_ipv4_rule* clnt_rules,
+	uint32_t                 num_rules,
+	uint32_t*                rule_hdls,
+	uint32_t*                num_added);
+
+int ipa_NATI_del_ipv4_rules(
+	uint32_t        tbl_hdl,
+	const uint32_t* rule_hdls,
+	uint32_t        num_rules,
+	uint32_t*       num_deleted);
+
 int ipa_NATI_post_ipv4_init_cmd(
 	uint32_t tbl_hdl );
 
+/*
+ * The hashes the IPA computes to pick the heads of the NAT table
+ * (ie. dst) and NAT index table (ie. src) lists a rule goes in. The
+ * size is the base table's number of entries minus one. Exposed so
+ * that host-side tools (eg. ipanathashsim) use exactly the same.
+ */
+uint16_t ipa_nati_dst_hash(
+	enum ipa_hw_type ver,
+	uint32_t         public_ip,
+	uint32_t         trgt_ip,
+	uint16_t         trgt_port,
+	uint16_t         public_port,
+	uint8_t          proto,
+	uint16_t         size);
+
+uint16_t ipa_nati_src_hash(
+	uint32_t priv_ip,
+	uint16_t priv_port,
+	uint32_t trgt_ip,
+	uint16_t trgt_port,
+	uint8_t  proto,
+	uint16_t size);
+
 #endif /* #ifndef IPA_NAT_DRVI_H */
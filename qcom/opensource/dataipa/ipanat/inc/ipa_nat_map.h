@@ -79,6 +79,14 @@ static inline const char* ipa_which_map_as_str(
 	return "???";
 }
 
+/*
+ * Pre-size a map so that num_keys keys can be added without the map
+ * having to grow. Maps still grow on demand past this.
+ */
+int ipa_nat_map_reserve(
+	ipa_which_map which,
+	uint32_t      num_keys );
+
 int ipa_nat_map_add(
 	ipa_which_map which,
 	uint32_t      key,
@@ -89,6 +97,14 @@ int ipa_nat_map_find(
 	uint32_t      key,
 	uint32_t*     val_ptr );
 
+/*
+ * Like ipa_nat_map_find(), but quietly. Returns non-zero when key is
+ * in the map.
+ */
+int ipa_nat_map_contains(
+	ipa_which_map which,
+	uint32_t      key );
+
 int ipa_nat_map_del(
 	ipa_which_map which,
 	uint32_t      key,
@@ -102,6 +102,8 @@ typedef enum {
 	NATI_TRIG_GOTO_DDR   =  9,
 	NATI_TRIG_GOTO_SRAM  = 10,
 	NATI_TRIG_GET_TSTAMP = 11,
+	NATI_TRIG_ADD_RULES  = 12,
+	NATI_TRIG_DEL_RULES  = 13,
 
 	NATI_TRIG_LAST
 } ipa_nati_trigger;
@@ -114,8 +116,40 @@ typedef struct
 {
 	uint32_t pass;
 	uint32_t fail;
+	/*
+	 * The following describe the last (or the in progress) switch.
+	 * A switch done in one go is one step. When switching
+	 * incrementally (see ipa_nat_set_switch_chunk()), fail above
+	 * counts failed steps, which are retried on the next step.
+	 *
+	 * rules_total is what's in the source when the switch starts,
+	 * less the rules deleted from it before being moved, hence
+	 * rules_moved + rules_left == rules_total throughout.
+	 */
+	uint32_t steps;
+	uint32_t rules_total;
+	uint32_t rules_moved;
+	uint32_t rules_left;
+	uint64_t switch_ns;    /* from start to the last rule moved */
+	uint64_t stall_ns;     /* time rule add/del was held off for  */
+	uint64_t max_stall_ns; /* longest single hold off, ever       */
 } nati_switch_stats;
 
+/******************************************************************************/
+/**
+ * The following structure used to track an incremental switch (ie. a
+ * migration of rules from one memory type to the other that is done
+ * a chunk at a time).
+ */
+typedef struct
+{
+	bool     active;
+	uint32_t src_sub;    /* DDR_SUB or SRAM_SUB (see below) */
+	uint16_t next_index; /* where in the source table to resume */
+	uint64_t start;
+	bool     worker;     /* mig_worker() is running */
+} nati_migration;
+
 /******************************************************************************/
 /**
  * The following structure used to direct map usage.
@@ -159,6 +193,12 @@ typedef struct
 	 * sw_stats[1] for sram
 	 */
 	nati_switch_stats sw_stats[2];
+	/*
+	 * Rules moved per step when switching incrementally, or zero
+	 * to move them all at once
+	 */
+	uint32_t       switch_chunk;
+	nati_migration mig;
 } ipa_nati_obj;
 
 /*
@@ -201,8 +241,13 @@ typedef struct
 	( nati_obj.curr_state == NATI_STATE_SRAM_ONLY || \
 	  nati_obj.curr_state == NATI_STATE_HYBRID )
 
+#undef  MIGRATION_IN_PROGRESS
+#define MIGRATION_IN_PROGRESS() \
+	( nati_obj.mig.active )
+
 #define SRAM_TO_BE_ACCESSED(t) \
 	( SRAM_CURRENTLY_ACTIVE() || \
+	  MIGRATION_IN_PROGRESS() || \
 	  (t) == NATI_TRIG_GOTO_SRAM || \
 	  (t) == NATI_TRIG_TBL_SWITCH )
 
@@ -294,4 +339,27 @@ int ipa_nati_statemach(
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr );
 
+/******************************************************************************/
+/**
+ * FUNCTION: ipa_nati_get_switch_stats
+ *
+ * PARAMS:
+ *
+ *   @nmi       (IN)  The memory type switched from
+ *
+ *   @stats_ptr (OUT) Where to put the stats
+ *
+ * DESCRIPTION:
+ *
+ *   Retrieve the stats of switches, while in hybrid mode, from the
+ *   memory type given.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+int ipa_nati_get_switch_stats(
+	enum ipa3_nat_mem_in nmi,
+	nati_switch_stats*   stats_ptr );
+
 #endif /* #if !defined(_IPA_NAT_STATEMACH_H_) */
@@ -81,6 +81,15 @@
 #define MAX_DMA_ENTRIES_FOR_ADD 4
 #define MAX_DMA_ENTRIES_FOR_DEL 3
 
+/*
+ * Upper bound on the number of entries the driver accepts in a single
+ * IPA_IOC_TABLE_DMA_CMD. The driver drops it by one when the WAN
+ * coalescing pipe is in use, hence the minimum below, which is also
+ * the most a single rule add or delete ever generates.
+ */
+#define MAX_DMA_ENTRIES_PER_CMD 4
+#define MIN_DMA_ENTRIES_PER_CMD 3
+
 #if !defined(MSM_IPA_TESTS) && !defined(FEATURE_IPA_ANDROID)
 #ifdef USE_GLIB
 #include <glib.h>
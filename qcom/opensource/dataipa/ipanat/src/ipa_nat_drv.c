@@ -169,6 +169,109 @@ int ipa_nat_del_ipv4_rule(
 	return 0;
 }
 
+/**
+ * ipa_nat_add_ipv4_rules() - to insert a batch of new ipv4 rules
+ * @table_handle: [in] handle of ipv4 nat table
+ * @rules: [in] array of new rules
+ * @num_rules: [in] number of rules in @rules
+ * @rule_handles: [out] handles of the inserted rules, in @rules order
+ * @num_added: [out] number of rules inserted
+ *
+ * To insert several ipv4 nat rules into ipv4 nat table at once
+ *
+ * Returns:	0  On Success, negative on failure
+ */
+int ipa_nat_add_ipv4_rules(
+	uint32_t tbl_hdl,
+	const ipa_nat_ipv4_rule *clnt_rules,
+	uint32_t num_rules,
+	uint32_t *rule_hdls,
+	uint32_t *num_added)
+{
+	int result;
+
+	if ( ! VALID_TBL_HDL(tbl_hdl) ||
+		 clnt_rules == NULL ||
+		 rule_hdls == NULL ||
+		 num_added == NULL ) {
+		IPAERR(
+			"Invalid parameters tbl_hdl=%d clnt_rules=%pK rule_hdls=%pK num_added=%pK\n",
+			tbl_hdl, clnt_rules, rule_hdls, num_added);
+		return -EINVAL;
+	}
+
+	IPADBG("Passed Table handle: 0x%x and %u rules\n", tbl_hdl, num_rules);
+
+	*num_added = 0;
+
+	result = ipa_nati_add_ipv4_rules(
+		tbl_hdl, clnt_rules, num_rules, rule_hdls, num_added);
+	if (result) {
+		IPAERR(
+			"Only %u of %u rules added to NAT table with handle 0x%08X\n",
+			*num_added, num_rules, tbl_hdl);
+		return result;
+	}
+
+	return 0;
+}
+
+/**
+ * ipa_nat_del_ipv4_rules() - to delete a batch of ipv4 nat rules
+ * @table_handle: [in] handle of ipv4 nat table
+ * @rule_handles: [in] array of ipv4 nat rule handles
+ * @num_rules: [in] number of handles in @rule_handles
+ * @num_deleted: [out] number of rules deleted
+ *
+ * To delete several ipv4 nat rules from ipv4 nat table at once
+ *
+ * Returns:	0  On Success, negative on failure
+ */
+int ipa_nat_del_ipv4_rules(
+	uint32_t tbl_hdl,
+	const uint32_t *rule_hdls,
+	uint32_t num_rules,
+	uint32_t *num_deleted)
+{
+	uint32_t i;
+	int result;
+
+	if ( ! VALID_TBL_HDL(tbl_hdl) ||
+		 rule_hdls == NULL ||
+		 num_deleted == NULL )
+	{
+		IPAERR("Invalid parameters tbl_hdl=0x%08X rule_hdls=%pK num_deleted=%pK\n",
+			   tbl_hdl, rule_hdls, num_deleted);
+		return -EINVAL;
+	}
+
+	*num_deleted = 0;
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		if ( ! VALID_RULE_HDL(rule_hdls[i]) )
+		{
+			IPAERR("Invalid parameter rule_hdls[%u]=0x%08X\n",
+				   i, rule_hdls[i]);
+			return -EINVAL;
+		}
+	}
+
+	IPADBG("Passed Table: 0x%08X and %u rule handles\n", tbl_hdl, num_rules);
+
+	result = ipa_nati_del_ipv4_rules(
+		tbl_hdl, rule_hdls, num_rules, num_deleted);
+	if (result) {
+		IPAERR(
+			"Only %u of %u rules deleted "
+			"from hw for NAT table with handle 0x%08X\n",
+			*num_deleted, num_rules, tbl_hdl);
+		return result;
+	}
+
+	return 0;
+}
+
 /**
  * ipa_nat_query_timestamp() - to query timestamp
  * @table_handle: [in] handle of ipv4 nat table
@@ -955,7 +955,8 @@ static void ipa_nati_copy_second_index_entry_to_head(
 }
 
 /**
- * dst_hash() - Find the index into ipv4 base table
+ * ipa_nati_dst_hash() - Find the index into ipv4 base table
+ * @ver: [in] IPA h/w version the hash is to match
  * @public_ip: [in] public_ip
  * @trgt_ip: [in] Target IP address
  * @trgt_port: [in]  Target port
@@ -970,8 +971,8 @@ static void ipa_nati_copy_second_index_entry_to_head(
  *
  * Returns: >0 index into ipv4 base table, negative on failure
  */
-static uint16_t dst_hash(
-	struct ipa_nat_cache* nat_cache_ptr,
+uint16_t ipa_nati_dst_hash(
+	enum ipa_hw_type ver,
 	uint32_t public_ip,
 	uint32_t trgt_ip,
 	uint16_t trgt_port,
@@ -992,7 +993,7 @@ static uint16_t dst_hash(
 	IPADBG("target_ip: 0x%08X target_port: 0x%04X\n", trgt_ip, trgt_port);
 	IPADBG("proto: 0x%02X size: 0x%04X\n", proto, size);
 
-	if (nat_cache_ptr->ipa_desc->ver >= IPA_HW_v4_0)
+	if (ver >= IPA_HW_v4_0)
 		hash ^=
 			((uint16_t)(public_ip)) ^
 			((uint16_t)(public_ip >> 16));
@@ -1011,7 +1012,7 @@ static uint16_t dst_hash(
 		hash = size;
 	}
 
-	IPADBG("dst_hash returning value: %d\n", hash);
+	IPADBG("ipa_nati_dst_hash returning value: %d\n", hash);
 
 	IPADBG("Out\n");
 
@@ -1019,7 +1020,7 @@ static uint16_t dst_hash(
 }
 
 /**
- * src_hash() - Find the index into ipv4 index base table
+ * ipa_nati_src_hash() - Find the index into ipv4 index base table
  * @priv_ip: [in] Private IP address
  * @priv_port: [in]  Private port
  * @trgt_ip: [in]  Target IP address
@@ -1034,7 +1035,7 @@ static uint16_t dst_hash(
  *
  * Returns: >0 index into ipv4 index base table, negative on failure
  */
-static uint16_t src_hash(
+uint16_t ipa_nati_src_hash(
 	uint32_t priv_ip,
 	uint16_t priv_port,
 	uint32_t trgt_ip,
@@ -1071,7 +1072,7 @@ static uint16_t src_hash(
 		hash = size;
 	}
 
-	IPADBG("src_hash returning value: %d\n", hash);
+	IPADBG("ipa_nati_src_hash returning value: %d\n", hash);
 
 	IPADBG("Out\n");
 
@@ -1624,6 +1625,185 @@ bail:
 	return ret;
 }
 
+/*
+ * Verify that a client rule can be added (ie. valid protocol and PDN)
+ */
+static int ipa_nati_check_ipv4_rule(
+	const ipa_nat_ipv4_rule* clnt_rule)
+{
+	if (clnt_rule->protocol == IPAHAL_NAT_INVALID_PROTOCOL) {
+		IPAERR("invalid parameter protocol=%d\n", clnt_rule->protocol);
+		return -EINVAL;
+	}
+
+	/*
+	 * Verify that the rule's PDN is valid
+	 */
+	if (clnt_rule->pdn_index >= IPA_MAX_PDN_NUM ||
+		pdns[clnt_rule->pdn_index].public_ip == 0) {
+		IPAERR("invalid parameters, pdn index %d, public ip = 0x%X\n",
+			   clnt_rule->pdn_index,
+			   (clnt_rule->pdn_index < IPA_MAX_PDN_NUM) ?
+			   pdns[clnt_rule->pdn_index].public_ip : 0);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/*
+ * Calculate the NAT table and NAT index table slots that a rule
+ * hashes to (ie. the heads of the lists the rule will be added to)
+ */
+static void ipa_nati_calc_rule_hashes(
+	struct ipa_nat_cache*           nat_cache_ptr,
+	struct ipa_nat_ip4_table_cache* nat_table,
+	const ipa_nat_ipv4_rule*        clnt_rule,
+	uint16_t*                       entry_index_ptr,
+	uint16_t*                       index_entry_index_ptr)
+{
+	IPADBG("In\n");
+
+	/* src_only */
+	if (clnt_rule->src_only) {
+		*entry_index_ptr = ipa_nati_dst_hash(
+			nat_cache_ptr->ipa_desc->ver,
+			pdns[clnt_rule->pdn_index].public_ip,
+			clnt_rule->target_ip,
+			clnt_rule->target_port,
+			clnt_rule->public_port,
+			clnt_rule->protocol,
+			nat_table->table.table_entries - 1) + Hash_token;
+		*entry_index_ptr = (*entry_index_ptr & (nat_table->table.table_entries - 1));
+		if (*entry_index_ptr == 0) {
+			*entry_index_ptr = nat_table->table.table_entries - 1;
+		}
+		Hash_token++;
+	} else {
+		*entry_index_ptr = ipa_nati_dst_hash(
+			nat_cache_ptr->ipa_desc->ver,
+			pdns[clnt_rule->pdn_index].public_ip,
+			clnt_rule->target_ip,
+			clnt_rule->target_port,
+			clnt_rule->public_port,
+			clnt_rule->protocol,
+			nat_table->table.table_entries - 1);
+	}
+
+	/* dst_only */
+	if (clnt_rule->dst_only) {
+		*index_entry_index_ptr =
+			ipa_nati_src_hash(clnt_rule->private_ip,
+				 clnt_rule->private_port,
+				 clnt_rule->target_ip,
+				 clnt_rule->target_port,
+				 clnt_rule->protocol,
+				 nat_table->table.table_entries - 1) + Hash_token;
+		*index_entry_index_ptr = (*index_entry_index_ptr & (nat_table->table.table_entries - 1));
+		if (*index_entry_index_ptr == 0) {
+			*index_entry_index_ptr = nat_table->table.table_entries - 1;
+		}
+		Hash_token++;
+	} else {
+		*index_entry_index_ptr =
+			ipa_nati_src_hash(clnt_rule->private_ip,
+				 clnt_rule->private_port,
+				 clnt_rule->target_ip,
+				 clnt_rule->target_port,
+				 clnt_rule->protocol,
+				 nat_table->table.table_entries - 1);
+	}
+
+	IPADBG("Out\n");
+}
+
+/*
+ * Add a rule to the NAT and NAT index tables and put the DMA entries
+ * needed to enable it into cmd. Nothing is posted to the driver here,
+ * and on failure, whatever was added is erased again.
+ */
+static int ipa_nati_prep_add_ipv4_rule(
+	struct ipa_nat_ip4_table_cache* nat_table,
+	const ipa_nat_ipv4_rule*        clnt_rule,
+	uint16_t*                       entry_index_ptr,
+	uint16_t*                       index_entry_index_ptr,
+	uint32_t*                       rule_hdl_ptr,
+	struct ipa_ioc_nat_dma_cmd*     cmd)
+{
+	struct ipa_nat_rule* rule;
+
+#ifdef NAT_DEBUG
+	/*
+	 * Only for IPADBG() below; this is on the batch add path...
+	 */
+	char buf[1024];
+#endif
+	int  ret;
+
+	IPADBG("In\n");
+
+	ret = ipa_table_add_entry(
+		&nat_table->table,
+		(void*) clnt_rule,
+		entry_index_ptr,
+		rule_hdl_ptr,
+		cmd);
+
+	if (ret) {
+		IPAERR("Failed to add a new NAT entry\n");
+		goto bail;
+	}
+
+	ret = ipa_table_add_entry(
+		&nat_table->index_table,
+		(void*) entry_index_ptr,
+		index_entry_index_ptr,
+		NULL,
+		cmd);
+
+	if (ret) {
+		IPAERR("failed to add a new NAT index entry\n");
+		goto fail_add_index_entry;
+	}
+
+	rule = ipa_table_get_entry_by_index(
+		&nat_table->table,
+		*entry_index_ptr);
+
+	if (rule == NULL) {
+		IPAERR("Failed to retrieve the entry in index %d for NAT table\n",
+			   *entry_index_ptr);
+		ret = -EPERM;
+		goto fail_get_entry;
+	}
+
+	rule->indx_tbl_entry = *index_entry_index_ptr;
+
+	rule->redirect   = clnt_rule->redirect;
+	rule->enable     = clnt_rule->enable;
+	rule->time_stamp = clnt_rule->time_stamp;
+
+	IPADBG("new entry:%d, new index entry: %d\n",
+		   *entry_index_ptr, *index_entry_index_ptr);
+
+	IPADBG("rule_hdl(0x%08X) -> %s\n",
+		   *rule_hdl_ptr,
+		   prep_nat_rule_4print(rule, buf, sizeof(buf)));
+
+	goto bail;
+
+fail_get_entry:
+	ipa_table_erase_entry(&nat_table->index_table, *index_entry_index_ptr);
+
+fail_add_index_entry:
+	ipa_table_erase_entry(&nat_table->table, *entry_index_ptr);
+
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
 int ipa_NATI_add_ipv4_rule(
 	uint32_t                 tbl_hdl,
 	const ipa_nat_ipv4_rule* clnt_rule,
@@ -1639,7 +1819,6 @@ int ipa_NATI_add_ipv4_rule(
 	enum ipa3_nat_mem_in            nmi;
 	struct ipa_nat_cache*           nat_cache_ptr;
 	struct ipa_nat_ip4_table_cache* nat_table;
-	struct ipa_nat_rule*            rule;
 
 	uint16_t new_entry_index;
 	uint16_t new_index_tbl_entry_index;
@@ -1683,20 +1862,9 @@ int ipa_NATI_add_ipv4_rule(
 
 	nat_table = &nat_cache_ptr->ip4_tbl[tbl_hdl - 1];
 
-	if (clnt_rule->protocol == IPAHAL_NAT_INVALID_PROTOCOL) {
-		IPAERR("invalid parameter protocol=%d\n", clnt_rule->protocol);
-		ret = -EINVAL;
-		goto done;
-	}
+	ret = ipa_nati_check_ipv4_rule(clnt_rule);
 
-	/*
-	 * Verify that the rule's PDN is valid
-	 */
-	if (clnt_rule->pdn_index >= IPA_MAX_PDN_NUM ||
-		pdns[clnt_rule->pdn_index].public_ip == 0) {
-		IPAERR("invalid parameters, pdn index %d, public ip = 0x%X\n",
-			   clnt_rule->pdn_index, pdns[clnt_rule->pdn_index].public_ip);
-		ret = -EINVAL;
+	if (ret) {
 		goto done;
 	}
 
@@ -1712,103 +1880,26 @@ int ipa_NATI_add_ipv4_rule(
 		goto unlock;
 	}
 
-	/* src_only */
-	if (clnt_rule->src_only) {
-		new_entry_index = dst_hash(
-			nat_cache_ptr,
-			pdns[clnt_rule->pdn_index].public_ip,
-			clnt_rule->target_ip,
-			clnt_rule->target_port,
-			clnt_rule->public_port,
-			clnt_rule->protocol,
-			nat_table->table.table_entries - 1) + Hash_token;
-		new_entry_index = (new_entry_index & (nat_table->table.table_entries - 1));
-		if (new_entry_index == 0) {
-			new_entry_index = nat_table->table.table_entries - 1;
-		}
-		Hash_token++;
-	} else {
-	new_entry_index = dst_hash(
+	ipa_nati_calc_rule_hashes(
 		nat_cache_ptr,
-		pdns[clnt_rule->pdn_index].public_ip,
-		clnt_rule->target_ip,
-		clnt_rule->target_port,
-		clnt_rule->public_port,
-		clnt_rule->protocol,
-		nat_table->table.table_entries - 1);
-	}
+		nat_table,
+		clnt_rule,
+		&new_entry_index,
+		&new_index_tbl_entry_index);
 
-	ret = ipa_table_add_entry(
-		&nat_table->table,
-		(void*) clnt_rule,
+	ret = ipa_nati_prep_add_ipv4_rule(
+		nat_table,
+		clnt_rule,
 		&new_entry_index,
+		&new_index_tbl_entry_index,
 		&new_entry_handle,
 		cmd);
 
 	if (ret) {
-		IPAERR("Failed to add a new NAT entry\n");
+		IPAERR("Failed to add a new NAT rule\n");
 		goto unlock;
 	}
 
-	/* dst_only */
-	if (clnt_rule->dst_only) {
-		new_index_tbl_entry_index =
-			src_hash(clnt_rule->private_ip,
-				 clnt_rule->private_port,
-				 clnt_rule->target_ip,
-				 clnt_rule->target_port,
-				 clnt_rule->protocol,
-				 nat_table->table.table_entries - 1) + Hash_token;
-		new_index_tbl_entry_index = (new_index_tbl_entry_index & (nat_table->table.table_entries - 1));
-		if (new_index_tbl_entry_index == 0) {
-			new_index_tbl_entry_index = nat_table->table.table_entries - 1;
-		}
-		Hash_token++;
-	} else {
-	new_index_tbl_entry_index =
-		src_hash(clnt_rule->private_ip,
-				 clnt_rule->private_port,
-				 clnt_rule->target_ip,
-				 clnt_rule->target_port,
-				 clnt_rule->protocol,
-				 nat_table->table.table_entries - 1);
-	}
-	ret = ipa_table_add_entry(
-		&nat_table->index_table,
-		(void*) &new_entry_index,
-		&new_index_tbl_entry_index,
-		NULL,
-		cmd);
-
-	if (ret) {
-		IPAERR("failed to add a new NAT index entry\n");
-		goto fail_add_index_entry;
-	}
-
-	rule = ipa_table_get_entry_by_index(
-		&nat_table->table,
-		new_entry_index);
-
-	if (rule == NULL) {
-		IPAERR("Failed to retrieve the entry in index %d for NAT table with handle=%d\n",
-			   new_entry_index, tbl_hdl);
-		ret = -EPERM;
-		goto bail;
-	}
-
-	rule->indx_tbl_entry = new_index_tbl_entry_index;
-
-	rule->redirect   = clnt_rule->redirect;
-	rule->enable     = clnt_rule->enable;
-	rule->time_stamp = clnt_rule->time_stamp;
-
-	IPADBG("new entry:%d, new index entry: %d\n",
-		   new_entry_index, new_index_tbl_entry_index);
-
-	IPADBG("rule_hdl(0x%08X) -> %s\n",
-		   new_entry_handle,
-		   prep_nat_rule_4print(rule, buf, sizeof(buf)));
-
 	ret = ipa_nati_post_ipv4_dma_cmd(nat_cache_ptr, cmd);
 
 	if (ret) {
@@ -1830,8 +1921,6 @@ int ipa_NATI_add_ipv4_rule(
 
 bail:
 	ipa_table_erase_entry(&nat_table->index_table, new_index_tbl_entry_index);
-
-fail_add_index_entry:
 	ipa_table_erase_entry(&nat_table->table, new_entry_index);
 
 unlock:
@@ -1843,62 +1932,25 @@ done:
 	return ret;
 }
 
-int ipa_NATI_del_ipv4_rule(
-	uint32_t tbl_hdl,
-	uint32_t rule_hdl )
+/*
+ * Set up the iterators needed to delete a rule from the NAT and NAT
+ * index tables. Nothing in the tables is changed here.
+ */
+static int ipa_nati_get_del_iterators(
+	struct ipa_nat_ip4_table_cache* nat_table,
+	uint32_t                        rule_hdl,
+	ipa_table_iterator*             table_iterator,
+	ipa_table_iterator*             index_table_iterator)
 {
-	uint32_t cmd_sz =
-		sizeof(struct ipa_ioc_nat_dma_cmd) +
-		(MAX_DMA_ENTRIES_FOR_DEL * sizeof(struct ipa_ioc_nat_dma_one));
-	char cmd_buf[cmd_sz];
-	struct ipa_ioc_nat_dma_cmd* cmd =
-		(struct ipa_ioc_nat_dma_cmd*) cmd_buf;
-
-	enum ipa3_nat_mem_in            nmi;
-	struct ipa_nat_cache*           nat_cache_ptr;
-	struct ipa_nat_ip4_table_cache* nat_table;
-	struct ipa_nat_rule*            table_rule;
-	struct ipa_nat_indx_tbl_rule*   index_table_rule;
-
-	ipa_table_iterator table_iterator;
-	ipa_table_iterator index_table_iterator;
+	struct ipa_nat_rule*          table_rule;
+	struct ipa_nat_indx_tbl_rule* index_table_rule;
 
 	uint16_t index;
 	char     buf[1024];
-	int      ret = 0;
+	int      ret;
 
 	IPADBG("In\n");
 
-	memset(cmd_buf, 0, sizeof(cmd_buf));
-
-	IPADBG("tbl_hdl(0x%08X) rule_hdl(%u)\n", tbl_hdl, rule_hdl);
-
-	BREAK_TBL_HDL(tbl_hdl, nmi, tbl_hdl);
-
-	if ( ! IPA_VALID_NAT_MEM_IN(nmi) ) {
-		IPAERR("Bad cache type argument passed\n");
-		ret = -EINVAL;
-		goto done;
-	}
-
-	IPADBG("nmi(%s)\n", ipa3_nat_mem_in_as_str(nmi));
-
-	nat_cache_ptr = &ipv4_nat_cache[nmi];
-
-	nat_table = &nat_cache_ptr->ip4_tbl[tbl_hdl - 1];
-
-	if (pthread_mutex_lock(&nat_mutex)) {
-		IPAERR("Unable to lock the nat mutex\n");
-		ret = -EINVAL;
-		goto done;
-	}
-
-	if (! nat_table->mem_desc.valid) {
-		IPAERR("Invalid table handle 0x%08X\n", tbl_hdl);
-		ret = -EINVAL;
-		goto unlock;
-	}
-
 	ret = ipa_table_get_entry(
 		&nat_table->table,
 		rule_hdl,
@@ -1907,7 +1959,7 @@ int ipa_NATI_del_ipv4_rule(
 
 	if (ret) {
 		IPAERR("Unable to retrive the entry with rule_hdl=%u\n", rule_hdl);
-		goto unlock;
+		goto bail;
 	}
 
 	IPADBG("rule_hdl(0x%08X) -> %s\n",
@@ -1915,16 +1967,16 @@ int ipa_NATI_del_ipv4_rule(
 		   prep_nat_rule_4print(table_rule, buf, sizeof(buf)));
 
 	ret = ipa_table_iterator_init(
-		&table_iterator,
+		table_iterator,
 		&nat_table->table,
 		table_rule,
 		index);
 
 	if (ret) {
 		IPAERR("Unable to create iterator which points to the "
-			   "entry %u in NAT table with handle=0x%08X\n",
-			   index, tbl_hdl);
-		goto unlock;
+			   "entry %u in NAT table\n",
+			   index);
+		goto bail;
 	}
 
 	index = table_rule->indx_tbl_entry;
@@ -1934,81 +1986,793 @@ int ipa_NATI_del_ipv4_rule(
 
 	if (index_table_rule == NULL) {
 		IPAERR("Unable to retrieve the entry in index %u "
-			   "in NAT index table with handle=0x%08X\n",
-			   index, tbl_hdl);
+			   "in NAT index table\n",
+			   index);
 		ret = -EPERM;
-		goto unlock;
+		goto bail;
 	}
 
 	ret = ipa_table_iterator_init(
-		&index_table_iterator,
+		index_table_iterator,
 		&nat_table->index_table,
 		index_table_rule,
 		index);
 
 	if (ret) {
 		IPAERR("Unable to create iterator which points to the "
-			   "entry %u in NAT index table with handle=0x%08X\n",
-			   index, tbl_hdl);
-		goto unlock;
+			   "entry %u in NAT index table\n",
+			   index);
+		goto bail;
 	}
 
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/*
+ * Put the DMA entries that delete the rule, as located by the
+ * iterators, into cmd. When the rule's index table record heads a
+ * list, the second record of the list is copied into the head and the
+ * index table iterator is moved on to it (ie. to the record that is
+ * really going away).
+ */
+static int ipa_nati_create_del_cmds(
+	struct ipa_nat_ip4_table_cache* nat_table,
+	ipa_table_iterator*             table_iterator,
+	ipa_table_iterator*             index_table_iterator,
+	struct ipa_ioc_nat_dma_cmd*     cmd)
+{
+	uint16_t index = index_table_iterator->curr_index;
+	int      ret   = 0;
+
+	IPADBG("In\n");
+
 	ipa_table_create_delete_command(
 		&nat_table->index_table,
 		cmd,
-		&index_table_iterator);
+		index_table_iterator);
 
-	if (ipa_table_iterator_is_head_with_tail(&index_table_iterator)) {
+	if (ipa_table_iterator_is_head_with_tail(index_table_iterator)) {
 
 		ipa_nati_copy_second_index_entry_to_head(
-			nat_table, &index_table_iterator, cmd);
+			nat_table, index_table_iterator, cmd);
 		/*
 		 * Iterate to the next entry which should be deleted
 		 */
 		ret = ipa_table_iterator_next(
-			&index_table_iterator, &nat_table->index_table);
+			index_table_iterator, &nat_table->index_table);
 
 		if (ret) {
 			IPAERR("Unable to move the iterator to the next entry "
 				   "(points to the entry %u in NAT index table)\n",
 				   index);
-			goto unlock;
+			goto bail;
 		}
 	}
 
 	ipa_table_create_delete_command(
 		&nat_table->table,
 		cmd,
-		&table_iterator);
+		table_iterator);
 
-	ret = ipa_nati_post_ipv4_dma_cmd(nat_cache_ptr, cmd);
+bail:
+	IPADBG("Out\n");
 
-	if (ret) {
-		IPAERR("Unable to post dma command\n");
-		goto unlock;
-	}
+	return ret;
+}
+
+/*
+ * Bring the software view of the tables in line with what the IPA
+ * did when it executed the DMA entries made by
+ * ipa_nati_create_del_cmds()
+ */
+static void ipa_nati_finish_del_ipv4_rule(
+	struct ipa_nat_ip4_table_cache* nat_table,
+	ipa_table_iterator*             table_iterator,
+	ipa_table_iterator*             index_table_iterator)
+{
+	IPADBG("In\n");
 
-	if (! ipa_table_iterator_is_head_with_tail(&table_iterator)) {
+	if (! ipa_table_iterator_is_head_with_tail(table_iterator)) {
 		/* The entry can be deleted */
 		uint8_t is_prev_empty =
-			(table_iterator.prev_entry != NULL &&
-			 ((struct ipa_nat_rule*)table_iterator.prev_entry)->protocol ==
+			(table_iterator->prev_entry != NULL &&
+			 ((struct ipa_nat_rule*)table_iterator->prev_entry)->protocol ==
 			 IPAHAL_NAT_INVALID_PROTOCOL);
 
 		ipa_table_delete_entry(
-			&nat_table->table, &table_iterator, is_prev_empty);
+			&nat_table->table, table_iterator, is_prev_empty);
 	}
 
 	ipa_table_delete_entry(
 		&nat_table->index_table,
-		&index_table_iterator,
+		index_table_iterator,
 		FALSE);
 
-	if (index_table_iterator.curr_index >= nat_table->index_table.table_entries)
+	if (index_table_iterator->curr_index >= nat_table->index_table.table_entries)
 		nat_table->index_expn_table_meta[
-			index_table_iterator.curr_index - nat_table->index_table.table_entries].
+			index_table_iterator->curr_index - nat_table->index_table.table_entries].
 			prev_index = IPA_TABLE_INVALID_ENTRY;
 
+	IPADBG("Out\n");
+}
+
+int ipa_NATI_del_ipv4_rule(
+	uint32_t tbl_hdl,
+	uint32_t rule_hdl )
+{
+	uint32_t cmd_sz =
+		sizeof(struct ipa_ioc_nat_dma_cmd) +
+		(MAX_DMA_ENTRIES_FOR_DEL * sizeof(struct ipa_ioc_nat_dma_one));
+	char cmd_buf[cmd_sz];
+	struct ipa_ioc_nat_dma_cmd* cmd =
+		(struct ipa_ioc_nat_dma_cmd*) cmd_buf;
+
+	enum ipa3_nat_mem_in            nmi;
+	struct ipa_nat_cache*           nat_cache_ptr;
+	struct ipa_nat_ip4_table_cache* nat_table;
+
+	ipa_table_iterator table_iterator;
+	ipa_table_iterator index_table_iterator;
+
+	int ret = 0;
+
+	IPADBG("In\n");
+
+	memset(cmd_buf, 0, sizeof(cmd_buf));
+
+	IPADBG("tbl_hdl(0x%08X) rule_hdl(%u)\n", tbl_hdl, rule_hdl);
+
+	BREAK_TBL_HDL(tbl_hdl, nmi, tbl_hdl);
+
+	if ( ! IPA_VALID_NAT_MEM_IN(nmi) ) {
+		IPAERR("Bad cache type argument passed\n");
+		ret = -EINVAL;
+		goto done;
+	}
+
+	IPADBG("nmi(%s)\n", ipa3_nat_mem_in_as_str(nmi));
+
+	nat_cache_ptr = &ipv4_nat_cache[nmi];
+
+	nat_table = &nat_cache_ptr->ip4_tbl[tbl_hdl - 1];
+
+	if (pthread_mutex_lock(&nat_mutex)) {
+		IPAERR("Unable to lock the nat mutex\n");
+		ret = -EINVAL;
+		goto done;
+	}
+
+	if (! nat_table->mem_desc.valid) {
+		IPAERR("Invalid table handle 0x%08X\n", tbl_hdl);
+		ret = -EINVAL;
+		goto unlock;
+	}
+
+	ret = ipa_nati_get_del_iterators(
+		nat_table,
+		rule_hdl,
+		&table_iterator,
+		&index_table_iterator);
+
+	if (ret) {
+		goto unlock;
+	}
+
+	ret = ipa_nati_create_del_cmds(
+		nat_table,
+		&table_iterator,
+		&index_table_iterator,
+		cmd);
+
+	if (ret) {
+		goto unlock;
+	}
+
+	ret = ipa_nati_post_ipv4_dma_cmd(nat_cache_ptr, cmd);
+
+	if (ret) {
+		IPAERR("Unable to post dma command\n");
+		goto unlock;
+	}
+
+	ipa_nati_finish_del_ipv4_rule(
+		nat_table,
+		&table_iterator,
+		&index_table_iterator);
+
+unlock:
+	if (pthread_mutex_unlock(&nat_mutex)) {
+		IPAERR("Unable to unlock the nat mutex\n");
+		ret = (ret) ? ret : -EPERM;
+	}
+
+done:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * Batched rule add/delete
+ *
+ * The rules of a batch are handled under a single lock acquisition
+ * and their DMA entries are coalesced into as few IPA_IOC_TABLE_DMA_CMD
+ * ioctls as the driver will take.
+ *
+ * NOTE WELL: A NAT table record only becomes enabled, and an index
+ * table head only gets its tbl_entry, when the IPA executes the DMA
+ * command.  Until the command is posted, the records of a pending
+ * rule look empty to subsequent adds.  Likewise, deletes rely on the
+ * prev/next links of their neighbours being current.  Hence the
+ * pending entries are posted before handling a rule that hashes onto
+ * the same list as a pending rule, that needs a NAT expansion slot
+ * while a pending rule took one, or whose neighbours overlap with
+ * those of a pending delete.
+ * ----------------------------------------------------------------------------
+ */
+#define BATCH_NUM_TOUCHED 4
+
+typedef struct
+{
+	uint8_t            num_dma;
+	uint16_t           touched[2][BATCH_NUM_TOUCHED]; /* [0] NAT [1] index */
+	uint16_t           entry_index;
+	uint16_t           index_entry_index;
+	uint32_t           rule_hdl;
+	ipa_table_iterator table_iterator;
+	ipa_table_iterator index_table_iterator;
+} ipa_nati_batch_rule;
+
+typedef struct
+{
+	struct ipa_ioc_nat_dma_cmd* cmd;
+	ipa_nati_batch_rule         rules[MAX_DMA_ENTRIES_PER_CMD];
+	uint8_t                     num_rules;
+	bool                        expn_pending;
+} ipa_nati_batch;
+
+/*
+ * Lowered to MIN_DMA_ENTRIES_PER_CMD the first time the driver
+ * refuses a coalesced command
+ */
+static uint8_t dma_entries_per_cmd = MAX_DMA_ENTRIES_PER_CMD;
+
+static void ipa_nati_batch_reset(
+	ipa_nati_batch* batch)
+{
+	batch->cmd->entries = 0;
+	batch->num_rules    = 0;
+	batch->expn_pending = false;
+}
+
+static bool ipa_nati_batch_touches(
+	ipa_nati_batch* batch,
+	int             which,
+	uint16_t        index)
+{
+	uint8_t i, j;
+
+	if ( ! VALID_INDEX(index) )
+		return false;
+
+	for ( i = 0; i < batch->num_rules; i++ )
+		for ( j = 0; j < BATCH_NUM_TOUCHED; j++ )
+			if ( batch->rules[i].touched[which][j] == index )
+				return true;
+
+	return false;
+}
+
+static bool ipa_nati_batch_overlaps(
+	ipa_nati_batch*      batch,
+	ipa_nati_batch_rule* rule)
+{
+	int which, j;
+
+	for ( which = 0; which < 2; which++ )
+		for ( j = 0; j < BATCH_NUM_TOUCHED; j++ )
+			if ( ipa_nati_batch_touches(batch, which, rule->touched[which][j]) )
+				return true;
+
+	return false;
+}
+
+static void ipa_nati_batch_append(
+	ipa_nati_batch*                   batch,
+	ipa_nati_batch_rule*              rule,
+	const struct ipa_ioc_nat_dma_cmd* rule_cmd)
+{
+	memcpy(&batch->cmd->dma[batch->cmd->entries],
+		   rule_cmd->dma,
+		   rule_cmd->entries * sizeof(struct ipa_ioc_nat_dma_one));
+
+	batch->cmd->entries += rule_cmd->entries;
+
+	rule->num_dma = rule_cmd->entries;
+
+	batch->rules[batch->num_rules++] = *rule;
+}
+
+/*
+ * Post the pending DMA entries. Should the driver refuse a coalesced
+ * command, the entries are reposted one rule at a time and the per
+ * command limit is lowered for the rest of the session.
+ *
+ * On return, *num_posted holds the number of leading pending rules
+ * the IPA has executed.
+ */
+static int ipa_nati_batch_post(
+	struct ipa_nat_cache* nat_cache_ptr,
+	ipa_nati_batch*       batch,
+	uint8_t*              num_posted)
+{
+	uint32_t cmd_sz =
+		sizeof(struct ipa_ioc_nat_dma_cmd) +
+		(MIN_DMA_ENTRIES_PER_CMD * sizeof(struct ipa_ioc_nat_dma_one));
+	char cmd_buf[cmd_sz];
+	struct ipa_ioc_nat_dma_cmd* cmd =
+		(struct ipa_ioc_nat_dma_cmd*) cmd_buf;
+
+	uint8_t i, offset;
+	int     ret = 0;
+
+	IPADBG("In\n");
+
+	*num_posted = 0;
+
+	if ( batch->num_rules == 0 )
+		goto bail;
+
+	IPADBG("Posting %u DMA entries for %u rules\n",
+		   batch->cmd->entries, batch->num_rules);
+
+	ret = ipa_nati_post_ipv4_dma_cmd(nat_cache_ptr, batch->cmd);
+
+	if ( ret == 0 )
+	{
+		*num_posted = batch->num_rules;
+		goto bail;
+	}
+
+	if ( batch->num_rules == 1 )
+		goto bail;
+
+	IPAWARN("Coalesced DMA command of %u entries refused, "
+			"reposting per rule\n", batch->cmd->entries);
+
+	dma_entries_per_cmd = MIN_DMA_ENTRIES_PER_CMD;
+
+	for ( i = 0, offset = 0; i < batch->num_rules; i++ )
+	{
+		memset(cmd_buf, 0, sizeof(cmd_buf));
+
+		cmd->entries = batch->rules[i].num_dma;
+
+		memcpy(cmd->dma,
+			   &batch->cmd->dma[offset],
+			   cmd->entries * sizeof(struct ipa_ioc_nat_dma_one));
+
+		ret = ipa_nati_post_ipv4_dma_cmd(nat_cache_ptr, cmd);
+
+		if ( ret )
+			break;
+
+		offset += cmd->entries;
+
+		(*num_posted)++;
+	}
+
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/*
+ * Post the pending adds and hand out their rule handles. The adds the
+ * IPA did not execute are taken back out of the tables.
+ */
+static int ipa_nati_batch_flush_adds(
+	struct ipa_nat_cache*           nat_cache_ptr,
+	struct ipa_nat_ip4_table_cache* nat_table,
+	ipa_nati_batch*                 batch,
+	uint32_t*                       rule_hdls,
+	uint32_t*                       num_added)
+{
+	uint8_t num_posted, i;
+	int     ret;
+
+	ret = ipa_nati_batch_post(nat_cache_ptr, batch, &num_posted);
+
+	for ( i = 0; i < num_posted; i++ )
+	{
+		rule_hdls[(*num_added)++] = batch->rules[i].rule_hdl;
+	}
+
+	for ( i = batch->num_rules; i > num_posted; i-- )
+	{
+		ipa_table_erase_entry(
+			&nat_table->index_table, batch->rules[i - 1].index_entry_index);
+		ipa_table_erase_entry(
+			&nat_table->table, batch->rules[i - 1].entry_index);
+	}
+
+	ipa_nati_batch_reset(batch);
+
+	return ret;
+}
+
+/*
+ * Post the pending deletes and bring the software view of the tables
+ * up to date for the ones the IPA executed
+ */
+static int ipa_nati_batch_flush_dels(
+	struct ipa_nat_cache*           nat_cache_ptr,
+	struct ipa_nat_ip4_table_cache* nat_table,
+	ipa_nati_batch*                 batch,
+	uint32_t*                       num_deleted)
+{
+	uint8_t num_posted, i;
+	int     ret;
+
+	ret = ipa_nati_batch_post(nat_cache_ptr, batch, &num_posted);
+
+	for ( i = 0; i < num_posted; i++ )
+	{
+		ipa_nati_finish_del_ipv4_rule(
+			nat_table,
+			&batch->rules[i].table_iterator,
+			&batch->rules[i].index_table_iterator);
+
+		(*num_deleted)++;
+	}
+
+	ipa_nati_batch_reset(batch);
+
+	return ret;
+}
+
+/*
+ * Record the NAT and index table records whose links a delete reads
+ * or modifies
+ */
+static void ipa_nati_del_touched(
+	struct ipa_nat_ip4_table_cache* nat_table,
+	ipa_nati_batch_rule*            rule)
+{
+	ipa_table_iterator* ti  = &rule->table_iterator;
+	ipa_table_iterator* iti = &rule->index_table_iterator;
+
+	memset(rule->touched, 0, sizeof(rule->touched));
+
+	rule->touched[0][0] = ti->prev_index;
+	rule->touched[0][1] = ti->curr_index;
+	rule->touched[0][2] = ti->next_index;
+
+	rule->touched[1][0] = iti->prev_index;
+	rule->touched[1][1] = iti->curr_index;
+	rule->touched[1][2] = iti->next_index;
+
+	if ( ipa_table_iterator_is_head_with_tail(iti) )
+	{
+		rule->touched[1][3] =
+			nat_table->index_table.entry_interface->entry_get_next_index(
+				iti->next_entry);
+	}
+}
+
+int ipa_NATI_add_ipv4_rules(
+	uint32_t                 tbl_hdl,
+	const ipa_nat_ipv4_rule* clnt_rules,
+	uint32_t                 num_rules,
+	uint32_t*                rule_hdls,
+	uint32_t*                num_added)
+{
+	uint32_t cmd_sz =
+		sizeof(struct ipa_ioc_nat_dma_cmd) +
+		(MAX_DMA_ENTRIES_PER_CMD * sizeof(struct ipa_ioc_nat_dma_one));
+	char cmd_buf[cmd_sz];
+	uint32_t rule_cmd_sz =
+		sizeof(struct ipa_ioc_nat_dma_cmd) +
+		(MAX_DMA_ENTRIES_FOR_ADD * sizeof(struct ipa_ioc_nat_dma_one));
+	char rule_cmd_buf[rule_cmd_sz];
+	struct ipa_ioc_nat_dma_cmd* rule_cmd =
+		(struct ipa_ioc_nat_dma_cmd*) rule_cmd_buf;
+
+	enum ipa3_nat_mem_in            nmi;
+	struct ipa_nat_cache*           nat_cache_ptr;
+	struct ipa_nat_ip4_table_cache* nat_table;
+
+	ipa_nati_batch      batch;
+	ipa_nati_batch_rule rule;
+
+	uint32_t i;
+	int      ret = 0, flush_ret;
+
+	IPADBG("In\n");
+
+	if ( ! VALID_TBL_HDL(tbl_hdl) ||
+		 ! clnt_rules ||
+		 ! rule_hdls ||
+		 ! num_added )
+	{
+		IPAERR("Bad arg: tbl_hdl(0x%08X) and/or clnt_rules(%p) "
+			   "and/or rule_hdls(%p) and/or num_added(%p)\n",
+			   tbl_hdl, clnt_rules, rule_hdls, num_added);
+		ret = -EINVAL;
+		goto done;
+	}
+
+	*num_added = 0;
+
+	IPADBG("tbl_hdl(0x%08X) num_rules(%u)\n", tbl_hdl, num_rules);
+
+	BREAK_TBL_HDL(tbl_hdl, nmi, tbl_hdl);
+
+	if ( ! IPA_VALID_NAT_MEM_IN(nmi) ) {
+		IPAERR("Bad cache type argument passed\n");
+		ret = -EINVAL;
+		goto done;
+	}
+
+	nat_cache_ptr = &ipv4_nat_cache[nmi];
+
+	nat_table = &nat_cache_ptr->ip4_tbl[tbl_hdl - 1];
+
+	memset(cmd_buf, 0, sizeof(cmd_buf));
+
+	batch.cmd = (struct ipa_ioc_nat_dma_cmd*) cmd_buf;
+
+	ipa_nati_batch_reset(&batch);
+
+	if (pthread_mutex_lock(&nat_mutex)) {
+		IPAERR("unable to lock the nat mutex\n");
+		ret = -EINVAL;
+		goto done;
+	}
+
+	if (! nat_table->mem_desc.valid) {
+		IPAERR("invalid table handle %d\n", tbl_hdl);
+		ret = -EINVAL;
+		goto unlock;
+	}
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		const ipa_nat_ipv4_rule* clnt_rule = &clnt_rules[i];
+
+		ret = ipa_nati_check_ipv4_rule(clnt_rule);
+
+		if (ret) {
+			break;
+		}
+
+		memset(&rule, 0, sizeof(rule));
+
+		ipa_nati_calc_rule_hashes(
+			nat_cache_ptr,
+			nat_table,
+			clnt_rule,
+			&rule.entry_index,
+			&rule.index_entry_index);
+
+		rule.touched[0][0] = rule.entry_index;
+		rule.touched[1][0] = rule.index_entry_index;
+
+		if ( ipa_nati_batch_overlaps(&batch, &rule) ||
+			 (batch.expn_pending &&
+			  nat_table->table.entry_interface->entry_is_valid(
+				  GOTO_REC(&nat_table->table, rule.entry_index))) )
+		{
+			ret = ipa_nati_batch_flush_adds(
+				nat_cache_ptr, nat_table, &batch, rule_hdls, num_added);
+
+			if (ret) {
+				break;
+			}
+		}
+
+		memset(rule_cmd_buf, 0, sizeof(rule_cmd_buf));
+
+		ret = ipa_nati_prep_add_ipv4_rule(
+			nat_table,
+			clnt_rule,
+			&rule.entry_index,
+			&rule.index_entry_index,
+			&rule.rule_hdl,
+			rule_cmd);
+
+		if (ret) {
+			IPAERR("Failed to add NAT rule %u of %u\n", i, num_rules);
+			break;
+		}
+
+		if ( batch.cmd->entries + rule_cmd->entries > dma_entries_per_cmd )
+		{
+			ret = ipa_nati_batch_flush_adds(
+				nat_cache_ptr, nat_table, &batch, rule_hdls, num_added);
+
+			if (ret) {
+				ipa_table_erase_entry(&nat_table->index_table, rule.index_entry_index);
+				ipa_table_erase_entry(&nat_table->table, rule.entry_index);
+				break;
+			}
+		}
+
+		ipa_nati_batch_append(&batch, &rule, rule_cmd);
+
+		if ( rule.entry_index >= nat_table->table.table_entries )
+			batch.expn_pending = true;
+	}
+
+	flush_ret = ipa_nati_batch_flush_adds(
+		nat_cache_ptr, nat_table, &batch, rule_hdls, num_added);
+
+	ret = (ret) ? ret : flush_ret;
+
+unlock:
+	if (pthread_mutex_unlock(&nat_mutex)) {
+		IPAERR("unable to unlock the nat mutex\n");
+		ret = (ret) ? ret : -EPERM;
+	}
+
+done:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+int ipa_NATI_del_ipv4_rules(
+	uint32_t        tbl_hdl,
+	const uint32_t* rule_hdls,
+	uint32_t        num_rules,
+	uint32_t*       num_deleted)
+{
+	uint32_t cmd_sz =
+		sizeof(struct ipa_ioc_nat_dma_cmd) +
+		(MAX_DMA_ENTRIES_PER_CMD * sizeof(struct ipa_ioc_nat_dma_one));
+	char cmd_buf[cmd_sz];
+	uint32_t rule_cmd_sz =
+		sizeof(struct ipa_ioc_nat_dma_cmd) +
+		(MAX_DMA_ENTRIES_FOR_DEL * sizeof(struct ipa_ioc_nat_dma_one));
+	char rule_cmd_buf[rule_cmd_sz];
+	struct ipa_ioc_nat_dma_cmd* rule_cmd =
+		(struct ipa_ioc_nat_dma_cmd*) rule_cmd_buf;
+
+	enum ipa3_nat_mem_in            nmi;
+	struct ipa_nat_cache*           nat_cache_ptr;
+	struct ipa_nat_ip4_table_cache* nat_table;
+
+	ipa_nati_batch      batch;
+	ipa_nati_batch_rule rule;
+
+	uint32_t i;
+	int      ret = 0, flush_ret;
+
+	IPADBG("In\n");
+
+	if ( ! VALID_TBL_HDL(tbl_hdl) ||
+		 ! rule_hdls ||
+		 ! num_deleted )
+	{
+		IPAERR("Bad arg: tbl_hdl(0x%08X) and/or rule_hdls(%p) "
+			   "and/or num_deleted(%p)\n",
+			   tbl_hdl, rule_hdls, num_deleted);
+		ret = -EINVAL;
+		goto done;
+	}
+
+	*num_deleted = 0;
+
+	IPADBG("tbl_hdl(0x%08X) num_rules(%u)\n", tbl_hdl, num_rules);
+
+	BREAK_TBL_HDL(tbl_hdl, nmi, tbl_hdl);
+
+	if ( ! IPA_VALID_NAT_MEM_IN(nmi) ) {
+		IPAERR("Bad cache type argument passed\n");
+		ret = -EINVAL;
+		goto done;
+	}
+
+	nat_cache_ptr = &ipv4_nat_cache[nmi];
+
+	nat_table = &nat_cache_ptr->ip4_tbl[tbl_hdl - 1];
+
+	memset(cmd_buf, 0, sizeof(cmd_buf));
+
+	batch.cmd = (struct ipa_ioc_nat_dma_cmd*) cmd_buf;
+
+	ipa_nati_batch_reset(&batch);
+
+	if (pthread_mutex_lock(&nat_mutex)) {
+		IPAERR("Unable to lock the nat mutex\n");
+		ret = -EINVAL;
+		goto done;
+	}
+
+	if (! nat_table->mem_desc.valid) {
+		IPAERR("Invalid table handle 0x%08X\n", tbl_hdl);
+		ret = -EINVAL;
+		goto unlock;
+	}
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		memset(&rule, 0, sizeof(rule));
+
+		rule.rule_hdl = rule_hdls[i];
+
+		ret = ipa_nati_get_del_iterators(
+			nat_table,
+			rule.rule_hdl,
+			&rule.table_iterator,
+			&rule.index_table_iterator);
+
+		if (ret) {
+			break;
+		}
+
+		ipa_nati_del_touched(nat_table, &rule);
+
+		if ( ipa_nati_batch_overlaps(&batch, &rule) )
+		{
+			ret = ipa_nati_batch_flush_dels(
+				nat_cache_ptr, nat_table, &batch, num_deleted);
+
+			if (ret) {
+				break;
+			}
+
+			/*
+			 * The flush changed the neighbourhood, so start over
+			 */
+			ret = ipa_nati_get_del_iterators(
+				nat_table,
+				rule.rule_hdl,
+				&rule.table_iterator,
+				&rule.index_table_iterator);
+
+			if (ret) {
+				break;
+			}
+
+			ipa_nati_del_touched(nat_table, &rule);
+		}
+
+		memset(rule_cmd_buf, 0, sizeof(rule_cmd_buf));
+
+		ret = ipa_nati_create_del_cmds(
+			nat_table,
+			&rule.table_iterator,
+			&rule.index_table_iterator,
+			rule_cmd);
+
+		if (ret) {
+			break;
+		}
+
+		if ( batch.cmd->entries + rule_cmd->entries > dma_entries_per_cmd )
+		{
+			ret = ipa_nati_batch_flush_dels(
+				nat_cache_ptr, nat_table, &batch, num_deleted);
+
+			if (ret) {
+				break;
+			}
+		}
+
+		ipa_nati_batch_append(&batch, &rule, rule_cmd);
+	}
+
+	flush_ret = ipa_nati_batch_flush_dels(
+		nat_cache_ptr, nat_table, &batch, num_deleted);
+
+	ret = (ret) ? ret : flush_ret;
+
 unlock:
 	if (pthread_mutex_unlock(&nat_mutex)) {
 		IPAERR("Unable to unlock the nat mutex\n");
@@ -2334,6 +3098,17 @@ int ipa_NATI_walk_ipv4_tbl(
 	WhichTbl2Use      which,
 	ipa_table_walk_cb walk_cb,
 	void*             arb_data_ptr )
+{
+	return ipa_NATI_walk_ipv4_tbl_from(
+		tbl_hdl, which, 0, walk_cb, arb_data_ptr);
+}
+
+int ipa_NATI_walk_ipv4_tbl_from(
+	uint32_t          tbl_hdl,
+	WhichTbl2Use      which,
+	uint16_t          start_index,
+	ipa_table_walk_cb walk_cb,
+	void*             arb_data_ptr )
 {
 	enum ipa3_nat_mem_in            nmi;
 	uint32_t                        broken_tbl_hdl;
@@ -2391,9 +3166,10 @@ int ipa_NATI_walk_ipv4_tbl(
 		&nat_table->table     :
 		&nat_table->index_table;
 
-	ret = ipa_table_walk(ipa_tbl_ptr, 0, WHEN_SLOT_FILLED, walk_cb, arb_data_ptr);
+	ret = ipa_table_walk(
+		ipa_tbl_ptr, start_index, WHEN_SLOT_FILLED, walk_cb, arb_data_ptr);
 
-	if ( ret != 0 )
+	if ( ret < 0 )
 	{
 		IPAERR("ipa_table_walk returned non-zero (%d)\n", ret);
 		goto unlock;
@@ -26,14 +26,292 @@
  * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
  * IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
-#include <map>
-#include <iterator>
+#include <new>
+#include <vector>
+#include <algorithm>
 
 #include "ipa_nat_utils.h"
 
 #include "ipa_nat_map.h"
 
-static std::map<uint32_t, uint32_t> map_array[MAP_NUM_MAX];
+/*
+ * The rule handle translation maps are hit for every rule that is
+ * added, deleted or migrated while in hybrid mode, so rather than
+ * a node based tree, they are kept in a flat, open addressed table
+ * (linear probing, backward shift deletion, no tombstones). The
+ * table is a power of two in size and is kept at most 3/4 full.
+ */
+#define FLAT_MAP_MIN_SLOTS 16
+
+class ipa_nat_flat_map
+{
+public:
+	ipa_nat_flat_map() : mask(0), count(0) {}
+
+	/*
+	 * Make room for at least num_keys keys without further
+	 * allocation. Never shrinks.
+	 */
+	bool reserve(
+		uint32_t num_keys )
+	{
+		uint32_t want = FLAT_MAP_MIN_SLOTS;
+
+		while ( want - (want >> 2) < num_keys && want < 0x80000000 )
+		{
+			want <<= 1;
+		}
+
+		if ( want <= slots.size() )
+		{
+			return true;
+		}
+
+		return rehash(want);
+	}
+
+	bool insert(
+		uint32_t key,
+		uint32_t val )
+	{
+		uint32_t i, size = slots.size();
+
+		if ( count + 1 > size - (size >> 2) &&
+			 ! rehash(size ? size << 1 : FLAT_MAP_MIN_SLOTS) )
+		{
+			return false;
+		}
+
+		for ( i = hash(key) & mask; slots[i].used; i = (i + 1) & mask )
+		{
+			if ( slots[i].key == key )
+			{
+				return false;
+			}
+		}
+
+		slots[i].key  = key;
+		slots[i].val  = val;
+		slots[i].used = 1;
+
+		count++;
+
+		return true;
+	}
+
+	bool find(
+		uint32_t  key,
+		uint32_t* val_ptr ) const
+	{
+		int32_t i = lookup(key);
+
+		if ( i < 0 )
+		{
+			return false;
+		}
+
+		if ( val_ptr )
+		{
+			*val_ptr = slots[i].val;
+		}
+
+		return true;
+	}
+
+	bool erase(
+		uint32_t  key,
+		uint32_t* val_ptr )
+	{
+		int32_t  hole = lookup(key);
+		uint32_t i, home;
+
+		if ( hole < 0 )
+		{
+			return false;
+		}
+
+		if ( val_ptr )
+		{
+			*val_ptr = slots[hole].val;
+		}
+
+		/*
+		 * Pull back any entry further along the probe run that
+		 * would become unreachable with the hole left in place.
+		 */
+		for ( i = (hole + 1) & mask; slots[i].used; i = (i + 1) & mask )
+		{
+			home = hash(slots[i].key) & mask;
+
+			if ( ((i - home) & mask) >= ((i - hole) & mask) )
+			{
+				slots[hole] = slots[i];
+				hole = i;
+			}
+		}
+
+		slots[hole].used = 0;
+
+		count--;
+
+		return true;
+	}
+
+	void clear()
+	{
+		uint32_t i;
+
+		if ( count )
+		{
+			for ( i = 0; i < slots.size(); i++ )
+			{
+				slots[i].used = 0;
+			}
+		}
+
+		count = 0;
+	}
+
+	/*
+	 * Fill keys in ascending order, as the std::map based version
+	 * of this file used to, so that dumps remain comparable.
+	 */
+	void sorted_keys(
+		std::vector<uint32_t>& keys ) const
+	{
+		uint32_t i;
+
+		keys.clear();
+		keys.reserve(count);
+
+		for ( i = 0; i < slots.size(); i++ )
+		{
+			if ( slots[i].used )
+			{
+				keys.push_back(slots[i].key);
+			}
+		}
+
+		std::sort(keys.begin(), keys.end());
+	}
+
+private:
+	struct slot
+	{
+		uint32_t key;
+		uint32_t val;
+		uint32_t used;
+	};
+
+	std::vector<slot> slots;
+	uint32_t          mask;
+	uint32_t          count;
+
+	/*
+	 * Rule handles are small, mostly sequential integers, so mix
+	 * all bits before masking (murmur3 finalizer).
+	 */
+	static inline uint32_t hash(
+		uint32_t key )
+	{
+		key ^= key >> 16;
+		key *= 0x85EBCA6B;
+		key ^= key >> 13;
+		key *= 0xC2B2AE35;
+		key ^= key >> 16;
+
+		return key;
+	}
+
+	int32_t lookup(
+		uint32_t key ) const
+	{
+		uint32_t i;
+
+		if ( slots.empty() )
+		{
+			return -1;
+		}
+
+		for ( i = hash(key) & mask; slots[i].used; i = (i + 1) & mask )
+		{
+			if ( slots[i].key == key )
+			{
+				return (int32_t) i;
+			}
+		}
+
+		return -1;
+	}
+
+	bool rehash(
+		uint32_t num_slots )
+	{
+		std::vector<slot> old;
+		uint32_t          i, j;
+
+		try
+		{
+			old.swap(slots);
+			slots.assign(num_slots, slot());
+		}
+		catch ( const std::bad_alloc& )
+		{
+			old.swap(slots);
+			return false;
+		}
+
+		mask = num_slots - 1;
+
+		for ( i = 0; i < old.size(); i++ )
+		{
+			if ( old[i].used )
+			{
+				for ( j = hash(old[i].key) & mask; slots[j].used; j = (j + 1) & mask );
+
+				slots[j] = old[i];
+			}
+		}
+
+		return true;
+	}
+};
+
+static ipa_nat_flat_map map_array[MAP_NUM_MAX];
+
+/******************************************************************************/
+
+int ipa_nat_map_reserve(
+	ipa_which_map which,
+	uint32_t      num_keys )
+{
+	int ret_val = 0;
+
+	IPADBG("In\n");
+
+	if ( ! VALID_IPA_USE_MAP(which) )
+	{
+		IPAERR("Bad arg which(%u)\n", which);
+		ret_val = -1;
+		goto bail;
+	}
+
+	IPADBG("[%s] num_keys(%u)\n",
+		   ipa_which_map_as_str(which), num_keys);
+
+	if ( ! map_array[which].reserve(num_keys) )
+	{
+		IPAERR("[%s] unable to reserve room for %u keys\n",
+			   ipa_which_map_as_str(which),
+			   num_keys);
+		ret_val = -1;
+	}
+
+bail:
+	IPADBG("Out\n");
+
+	return ret_val;
+}
 
 /******************************************************************************/
 
@@ -44,8 +322,6 @@ int ipa_nat_map_add(
 {
 	int ret_val = 0;
 
-	std::pair<std::map<uint32_t, uint32_t>::iterator, bool> ret;
-
 	IPADBG("In\n");
 
 	if ( ! VALID_IPA_USE_MAP(which) )
@@ -58,15 +334,20 @@ int ipa_nat_map_add(
 	IPADBG("[%s] key(%u) -> val(%u)\n",
 		   ipa_which_map_as_str(which), key, val);
 
-	ret = map_array[which].insert(std::pair<uint32_t, uint32_t>(key, val));
-
-	if ( ret.second == false )
+	if ( map_array[which].find(key, NULL) )
 	{
 		IPAERR("[%s] key(%u) already exists in map\n",
 			   ipa_which_map_as_str(which),
 			   key);
 		ret_val = -1;
 	}
+	else if ( ! map_array[which].insert(key, val) )
+	{
+		IPAERR("[%s] key(%u) unable to grow map\n",
+			   ipa_which_map_as_str(which),
+			   key);
+		ret_val = -1;
+	}
 
 bail:
 	IPADBG("Out\n");
@@ -83,8 +364,6 @@ int ipa_nat_map_find(
 {
 	int ret_val = 0;
 
-	std::map<uint32_t, uint32_t>::iterator it;
-
 	IPADBG("In\n");
 
 	if ( ! VALID_IPA_USE_MAP(which) )
@@ -97,9 +376,7 @@ int ipa_nat_map_find(
 	IPADBG("[%s] key(%u)\n",
 		   ipa_which_map_as_str(which), key);
 
-	it = map_array[which].find(key);
-
-	if ( it == map_array[which].end() )
+	if ( ! map_array[which].find(key, val_ptr) )
 	{
 		IPAERR("[%s] key(%u) not found in map\n",
 			   ipa_which_map_as_str(which),
@@ -110,7 +387,6 @@ int ipa_nat_map_find(
 	{
 		if ( val_ptr )
 		{
-			*val_ptr = it->second;
 			IPADBG("[%s] key(%u) -> val(%u)\n",
 				   ipa_which_map_as_str(which),
 				   key, *val_ptr);
@@ -125,6 +401,21 @@ bail:
 
 /******************************************************************************/
 
+int ipa_nat_map_contains(
+	ipa_which_map which,
+	uint32_t      key )
+{
+	if ( ! VALID_IPA_USE_MAP(which) )
+	{
+		IPAERR("Bad arg which(%u)\n", which);
+		return 0;
+	}
+
+	return map_array[which].find(key, NULL) ? 1 : 0;
+}
+
+/******************************************************************************/
+
 int ipa_nat_map_del(
 	ipa_which_map which,
 	uint32_t      key,
@@ -132,8 +423,6 @@ int ipa_nat_map_del(
 {
 	int ret_val = 0;
 
-	std::map<uint32_t, uint32_t>::iterator it;
-
 	IPADBG("In\n");
 
 	if ( ! VALID_IPA_USE_MAP(which) )
@@ -146,9 +435,7 @@ int ipa_nat_map_del(
 	IPADBG("[%s] key(%u)\n",
 		   ipa_which_map_as_str(which), key);
 
-	it = map_array[which].find(key);
-
-	if ( it == map_array[which].end() )
+	if ( ! map_array[which].erase(key, val_ptr) )
 	{
 		IPAERR("[%s] key(%u) not found in map\n",
 			   ipa_which_map_as_str(which),
@@ -159,12 +446,10 @@ int ipa_nat_map_del(
 	{
 		if ( val_ptr )
 		{
-			*val_ptr = it->second;
 			IPADBG("[%s] key(%u) -> val(%u)\n",
 				   ipa_which_map_as_str(which),
 				   key, *val_ptr);
 		}
-		map_array[which].erase(it);
 	}
 
 bail:
@@ -198,7 +483,9 @@ bail:
 int ipa_nat_map_dump(
 	ipa_which_map which )
 {
-	std::map<uint32_t, uint32_t>::iterator it;
+	std::vector<uint32_t> keys;
+
+	uint32_t i, val = 0;
 
 	int ret_val = 0;
 
@@ -213,15 +500,23 @@ int ipa_nat_map_dump(
 
 	printf("Dumping: %s\n", ipa_which_map_as_str(which));
 
-	for ( it  = map_array[which].begin();
-		  it != map_array[which].end();
-		  it++ )
+	map_array[which].sorted_keys(keys);
+
+	for ( i = 0; i < keys.size(); i++ )
 	{
+		if ( ! map_array[which].find(keys[i], &val) )
+		{
+			IPAERR("[%s] key(%u) not found in map\n",
+				   ipa_which_map_as_str(which),
+				   keys[i]);
+			continue;
+		}
+
 		printf("  Key[%u|0x%08X] -> Value[%u|0x%08X]\n",
-			   it->first,
-			   it->first,
-			   it->second,
-			   it->second);
+			   keys[i],
+			   keys[i],
+			   val,
+			   val);
 	}
 
 bail:
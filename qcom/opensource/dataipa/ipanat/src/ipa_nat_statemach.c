@@ -62,6 +62,7 @@
  */
 #include <errno.h>
 #include <pthread.h>
+#include <unistd.h>
 
 #include "ipa_nat_drv.h"
 #include "ipa_nat_drvi.h"
@@ -96,6 +97,24 @@
 #define CHOOSE_SW_STATS() \
 	&(nati_obj.sw_stats[CHOOSE_MEM_SUB()])
 
+#undef  OTHER_SUB
+#define OTHER_SUB(sub) \
+	( ((sub) == DDR_SUB) ? SRAM_SUB : DDR_SUB )
+
+#undef  SUB_TBL_HDL
+#define SUB_TBL_HDL(sub) \
+	( ((sub) == DDR_SUB) ? nati_obj.ddr_tbl_hdl : nati_obj.sram_tbl_hdl )
+
+#undef  SUB_AS_STR
+#define SUB_AS_STR(sub) \
+	( ((sub) == DDR_SUB) ? "DDR" : "SRAM" )
+
+/*
+ * How often mig_worker() moves a chunk of an incremental switch...
+ */
+#undef  MIG_STEP_INTERVAL_US
+#define MIG_STEP_INTERVAL_US 1000
+
 /*
  * BACKROUND INFORMATION
  *
@@ -170,6 +189,11 @@ static ipa_nati_obj nati_obj = {
 	 *   sw_stats[1] for sram
 	 */
 	.sw_stats = { {0, 0}, {0, 0} },
+	/*
+	 * Switches move all rules at once by default...
+	 */
+	.switch_chunk = 0,
+	.mig = { .active = false },
 };
 
 /*
@@ -434,6 +458,60 @@ int ipa_nati_del_ipv4_rule(
 	return ret;
 }
 
+int ipa_nati_add_ipv4_rules(
+	uint32_t                 tbl_hdl,
+	const ipa_nat_ipv4_rule* clnt_rules,
+	uint32_t                 num_rules,
+	uint32_t*                rule_hdls,
+	uint32_t*                num_added )
+{
+	arb_t* args[] = {
+		(arb_t*)(arb_t)tbl_hdl,
+		(arb_t*) clnt_rules,
+		(arb_t*)(arb_t)num_rules,
+		(arb_t*) rule_hdls,
+		(arb_t*) num_added,
+	};
+
+	int ret;
+
+	IPADBG("In\n");
+
+	ret = ipa_nati_statemach(&nati_obj, NATI_TRIG_ADD_RULES, args);
+
+	IPADBG("num_added val(%u)\n", *num_added);
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+int ipa_nati_del_ipv4_rules(
+	uint32_t        tbl_hdl,
+	const uint32_t* rule_hdls,
+	uint32_t        num_rules,
+	uint32_t*       num_deleted )
+{
+	arb_t* args[] = {
+		(arb_t*)(arb_t)tbl_hdl,
+		(arb_t*) rule_hdls,
+		(arb_t*)(arb_t)num_rules,
+		(arb_t*) num_deleted,
+	};
+
+	int ret;
+
+	IPADBG("In\n");
+
+	ret = ipa_nati_statemach(&nati_obj, NATI_TRIG_DEL_RULES, args);
+
+	IPADBG("num_deleted val(%u)\n", *num_deleted);
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
 int ipa_nati_query_timestamp(
 	uint32_t  tbl_hdl,
 	uint32_t  rule_hdl,
@@ -609,6 +687,69 @@ bool ipa_nat_is_sram_supported(void)
 	return VALID_TBL_HDL(nati_obj.sram_tbl_hdl);
 }
 
+int ipa_nat_set_switch_chunk(
+	uint32_t rules_per_step )
+{
+	int ret;
+
+	IPADBG("In\n");
+
+	ret = take_mutex();
+
+	if ( ret != 0 )
+	{
+		goto bail;
+	}
+
+	/*
+	 * If a switch is in progress and rules_per_step is zero, the
+	 * remainder will be moved on the next step...
+	 */
+	nati_obj.switch_chunk = rules_per_step;
+
+	IPADBG("switch_chunk(%u)\n", nati_obj.switch_chunk);
+
+	ret = give_mutex();
+
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+int ipa_nati_get_switch_stats(
+	enum ipa3_nat_mem_in nmi,
+	nati_switch_stats*   stats_ptr )
+{
+	int ret;
+
+	IPADBG("In\n");
+
+	if ( ! IPA_VALID_NAT_MEM_IN(nmi) || ! stats_ptr )
+	{
+		IPAERR("Bad arg: nmi(%u) and/or stats_ptr(%p)\n", nmi, stats_ptr);
+		ret = -EINVAL;
+		goto bail;
+	}
+
+	ret = take_mutex();
+
+	if ( ret != 0 )
+	{
+		goto bail;
+	}
+
+	*stats_ptr =
+		nati_obj.sw_stats[(nmi == IPA_NAT_MEM_IN_SRAM) ? SRAM_SUB : DDR_SUB];
+
+	ret = give_mutex();
+
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
 /******************************************************************************/
 /*
  * FUNCTION: migrate_rule
@@ -805,65 +946,135 @@ bail:
 	return ret;
 }
 
+/******************************************************************************/
 /*
- * ****************************************************************************
- *
- * STATE MACHINE CODE BEGINS HERE
- *
- * ****************************************************************************
+ * The following is used to carry a migration step's context through
+ * the table walk to migrate_rule_step() below...
  */
-static int _smUndef(
-	ipa_nati_obj*    nati_obj_ptr,
-	ipa_nati_trigger trigger,
-	arb_t*           arb_data_ptr ); /* forward declaration */
+typedef struct
+{
+	uint32_t src_tbl_hdl;
+	uint32_t dst_tbl_hdl;
+	uint32_t budget;
+	uint32_t moved;
+	uint16_t next_index;
+} mig_step_help;
 
 /******************************************************************************/
 /*
- * FUNCTION: _smDelTbl
+ * FUNCTION: migrate_rule_step
  *
  * PARAMS:
  *
- *   nati_obj_ptr (IN) A pointer to an initialized nati object
- *
- *   trigger      (IN) The trigger to run through the state machine
+ *   Same as migrate_rule() above, except for:
  *
- *   arb_data_ptr (IN) Whatever you like
+ *   arb_data_ptr      (IN) A pointer to a mig_step_help
  *
  * DESCRIPTION:
  *
- *   The following will cause the destruction of the DDR based NAT
- *   table.
+ *   Used when switching incrementally. Moves a rule via
+ *   migrate_rule(), then removes it from the source table and maps,
+ *   so that, at any time, a rule lives in exactly one table.
+ *
+ *   Stops the walk, by returning a positive value, once the step's
+ *   budget of rules has been moved.
  *
  * RETURNS:
  *
- *   zero on success, otherwise non-zero
+ *   Returns 0 on success, positive to stop, negative on failure
  */
-static int _smDelTbl(
-	ipa_nati_obj*    nati_obj_ptr,
-	ipa_nati_trigger trigger,
-	arb_t*           arb_data_ptr )
+static int migrate_rule_step(
+	ipa_table*      table_ptr,
+	uint32_t        tbl_rule_hdl,
+	void*           record_ptr,
+	uint16_t        record_index,
+	void*           meta_record_ptr,
+	uint16_t        meta_record_index,
+	void*           arb_data_ptr )
 {
-	arb_t**  args = arb_data_ptr;
+	mig_step_help*       msh_ptr      = (mig_step_help*) arb_data_ptr;
+	struct ipa_nat_rule* nat_rule_ptr = (struct ipa_nat_rule*) record_ptr;
 
-	uint32_t tbl_hdl = (uint32_t) args[0];
+	uint32_t             src_sub;
+	uint32_t             orig_rule_hdl;
 
-	int ret;
+	int                  ret = 0;
 
 	IPADBG("In\n");
 
-	IPADBG("tbl_hdl(0x%08X)\n", tbl_hdl);
+	if ( nat_rule_ptr->protocol == IPA_NAT_INVALID_PROTO_FIELD_VALUE_IN_RULE )
+	{
+		/*
+		 * A deleted "first rule in list"; see migrate_rule()...
+		 */
+		goto bail;
+	}
 
-	ret = ipa_NATI_del_ipv4_table(tbl_hdl);
+	if ( msh_ptr->budget && msh_ptr->moved >= msh_ptr->budget )
+	{
+		/*
+		 * Budget spent. The next step picks up here...
+		 */
+		msh_ptr->next_index = record_index;
+		ret = 1;
+		goto bail;
+	}
 
-	if ( ret == 0 && ! IN_HYBRID_STATE() )
+	src_sub = (table_ptr->nmi == IPA_NAT_MEM_IN_SRAM) ? SRAM_SUB : DDR_SUB;
+
+	if ( ipa_nat_map_find(
+			 nati_obj.map_pairs[src_sub].new2orig_map,
+			 tbl_rule_hdl,
+			 &orig_rule_hdl) != 0 )
 	{
 		/*
-		 * The following will create the preferred "initial state" for
-		 * restart...
+		 * Can only be a rule whose removal from the source failed
+		 * after it was moved (see below), hence skip it...
 		 */
-		BACK2_UNSTARTED_STATE();
+		IPAWARN("Skipping unmapped rule_hdl(0x%08X) in %s\n",
+				tbl_rule_hdl, SUB_AS_STR(src_sub));
+		goto bail;
+	}
+
+	ret = migrate_rule(
+		table_ptr,
+		tbl_rule_hdl,
+		record_ptr,
+		record_index,
+		meta_record_ptr,
+		meta_record_index,
+		(void*)(arb_t) msh_ptr->dst_tbl_hdl);
+
+	if ( ret != 0 )
+	{
+		ret = (ret < 0) ? ret : -EINVAL;
+		goto bail;
+	}
+
+	msh_ptr->moved++;
+
+	/*
+	 * The rule is now in, and mapped to, the destination...
+	 */
+	ipa_nat_map_del(nati_obj.map_pairs[src_sub].orig2new_map, orig_rule_hdl, NULL);
+	ipa_nat_map_del(nati_obj.map_pairs[src_sub].new2orig_map, tbl_rule_hdl, NULL);
+
+	/*
+	 * Counted in the destination now, whether or not its removal
+	 * below works...
+	 */
+	nati_obj.tot_rules_in_table[src_sub]--;
+
+	ret = ipa_NATI_del_ipv4_rule(msh_ptr->src_tbl_hdl, tbl_rule_hdl);
+
+	if ( ret != 0 )
+	{
+		IPAERR("Unable to remove moved rule_hdl(0x%08X) from %s\n",
+			   tbl_rule_hdl, SUB_AS_STR(src_sub));
+		goto bail;
 	}
 
+bail:
 	IPADBG("Out\n");
 
 	return ret;
@@ -871,53 +1082,125 @@ static int _smDelTbl(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smFirstTbl
+ * FUNCTION: mig_step
  *
  * PARAMS:
  *
  *   nati_obj_ptr (IN) A pointer to an initialized nati object
  *
- *   trigger      (IN) The trigger to run through the state machine
- *
- *   arb_data_ptr (IN) Whatever you like
+ *   budget       (IN) The most rules to move, or zero for all
  *
  * DESCRIPTION:
  *
- *   The following will cause the creation of the very first NAT table(s)
- *   before any others have ever been created...
+ *   If an incremental switch is in progress, move up to budget more
+ *   rules from the source table to the destination table, and
+ *   account for it in the source's switch stats. The switch
+ *   ends when the source table has been walked to the end.
+ *
+ *   A failed step is counted, and left to be retried by the next
+ *   one.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smFirstTbl(
-	ipa_nati_obj*    nati_obj_ptr,
-	ipa_nati_trigger trigger,
-	arb_t*           arb_data_ptr )
+static int mig_step(
+	ipa_nati_obj* nati_obj_ptr,
+	uint32_t      budget )
 {
-	arb_t**   args = arb_data_ptr;
+	nati_migration*    mig_ptr = &nati_obj_ptr->mig;
+	uint32_t           src_sub = mig_ptr->src_sub;
+	uint32_t           dst_sub = OTHER_SUB(src_sub);
 
-	uint32_t    public_ip_addr    = (uint32_t)    args[0];
-	uint16_t    number_of_entries = (uint16_t)    args[1];
-	uint32_t*   tbl_hdl_ptr       = (uint32_t*)   args[2];
-	const char* mem_type_ptr      = (const char*) args[3];
+	nati_switch_stats* sw_stats_ptr = &nati_obj_ptr->sw_stats[src_sub];
 
-	int ret;
+	mig_step_help      msh;
+
+	uint64_t           start = 0, stop = 0;
+
+	int                ret = 0;
 
 	IPADBG("In\n");
 
-	/*
-	 * This is the first time in here.  Let the ipacm's XML config (or
-	 * state_to_hold) drive initial state...
-	 */
-	SET_NATIOBJ_STATE(
-		nati_obj_ptr,
-		(nati_obj_ptr->hold_state && nati_obj_ptr->state_to_hold) ?
-		nati_obj_ptr->state_to_hold                               :
-		mem_type_str_to_ipa_nati_state(mem_type_ptr));
+	if ( ! mig_ptr->active )
+	{
+		goto bail;
+	}
 
-	ret = ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_ADD_TABLE, args);
+	memset(&msh, 0, sizeof(msh));
+
+	msh.src_tbl_hdl = SUB_TBL_HDL(src_sub);
+	msh.dst_tbl_hdl = SUB_TBL_HDL(dst_sub);
+	msh.budget      = budget;
+
+	currTimeAs(TimeAsNanSecs, &start);
+
+	ret = ipa_NATI_walk_ipv4_tbl_from(
+		msh.src_tbl_hdl,
+		USE_NAT_TABLE,
+		mig_ptr->next_index,
+		migrate_rule_step,
+		&msh);
+
+	currTimeAs(TimeAsNanSecs, &stop);
+
+	sw_stats_ptr->steps       += 1;
+	sw_stats_ptr->rules_moved += msh.moved;
+	sw_stats_ptr->rules_left   = nati_obj_ptr->tot_rules_in_table[src_sub];
+
+	if ( sw_stats_ptr->rules_moved + sw_stats_ptr->rules_left
+		 != sw_stats_ptr->rules_total )
+	{
+		IPAWARN("%s: rules_moved(%u) + rules_left(%u) != rules_total(%u)\n",
+				SUB_AS_STR(src_sub),
+				sw_stats_ptr->rules_moved,
+				sw_stats_ptr->rules_left,
+				sw_stats_ptr->rules_total);
+	}
+	sw_stats_ptr->stall_ns    += stop - start;
+
+	if ( stop - start > sw_stats_ptr->max_stall_ns )
+	{
+		sw_stats_ptr->max_stall_ns = stop - start;
+	}
+
+	if ( ret > 0 )
+	{
+		/*
+		 * Budget spent, more to do...
+		 */
+		mig_ptr->next_index = msh.next_index;
+
+		ret = 0;
+	}
+	else if ( ret == 0 )
+	{
+		mig_ptr->active = false;
+
+		sw_stats_ptr->pass     += 1;
+		sw_stats_ptr->switch_ns = stop - mig_ptr->start;
+
+		IPADBG("Transistion from %s to %s took %f microseconds, "
+			   "%u rules in %u steps, stalled for %f microseconds\n",
+			   SUB_AS_STR(src_sub),
+			   SUB_AS_STR(dst_sub),
+			   (float) sw_stats_ptr->switch_ns / 1000.0,
+			   sw_stats_ptr->rules_moved,
+			   sw_stats_ptr->steps,
+			   (float) sw_stats_ptr->stall_ns / 1000.0);
+	}
+	else
+	{
+		sw_stats_ptr->fail += 1;
+
+		IPAERR("Transistion step from %s to %s failed (%d) with %u rules left\n",
+			   SUB_AS_STR(src_sub),
+			   SUB_AS_STR(dst_sub),
+			   ret,
+			   sw_stats_ptr->rules_left);
+	}
 
+bail:
 	IPADBG("Out\n");
 
 	return ret;
@@ -925,152 +1208,182 @@ static int _smFirstTbl(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smAddDdrTbl
+ * FUNCTION: mig_step_after_rule_op
  *
  * PARAMS:
  *
  *   nati_obj_ptr (IN) A pointer to an initialized nati object
  *
- *   trigger      (IN) The trigger to run through the state machine
+ * DESCRIPTION:
  *
- *   arb_data_ptr (IN) Whatever you like
+ *   Called after each rule add/delete while in a hybrid state, to
+ *   move the next chunk of an incremental switch in progress. The
+ *   outcome of the step is not the rule operation's concern, hence
+ *   it's not returned.
+ */
+static void mig_step_after_rule_op(
+	ipa_nati_obj* nati_obj_ptr )
+{
+	if ( nati_obj_ptr->mig.active )
+	{
+		mig_step(nati_obj_ptr, nati_obj_ptr->switch_chunk);
+	}
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: mig_worker
+ *
+ * PARAMS:
+ *
+ *   arg (IN) A pointer to an initialized nati object
  *
  * DESCRIPTION:
  *
- *   The following will cause the creation of a NAT table in DDR.
+ *   Started by switch_incrementally(). Moves a chunk of rules every
+ *   MIG_STEP_INTERVAL_US, until the switch is done, so that a switch
+ *   finishes even when no rules are added or deleted. The mutex is
+ *   let go of between steps, hence rule adds/deletes are never held
+ *   off for more than a step.
  *
  * RETURNS:
  *
- *   zero on success, otherwise non-zero
+ *   NULL
  */
-static int _smAddDdrTbl(
-	ipa_nati_obj*    nati_obj_ptr,
-	ipa_nati_trigger trigger,
-	arb_t*           arb_data_ptr )
+static void* mig_worker(
+	void* arg )
 {
-	arb_t**   args = arb_data_ptr;
-
-	uint32_t  public_ip_addr    = (uint32_t)  args[0];
-	uint16_t  number_of_entries = (uint16_t)  args[1];
-	uint32_t* tbl_hdl_ptr       = (uint32_t*) args[2];
+	ipa_nati_obj* nati_obj_ptr = (ipa_nati_obj*) arg;
 
-	int ret;
+	bool          done         = false;
 
 	IPADBG("In\n");
 
-	IPADBG("public_ip_addr(0x%08X) number_of_entries(%u) tbl_hdl_ptr(%p)\n",
-		   public_ip_addr, number_of_entries, tbl_hdl_ptr);
+	while ( ! done )
+	{
+		usleep(MIG_STEP_INTERVAL_US);
 
-	ret = ipa_NATI_add_ipv4_tbl(
-		IPA_NAT_MEM_IN_DDR,
-		public_ip_addr,
-		number_of_entries,
-		&nati_obj_ptr->ddr_tbl_hdl);
+		if ( take_mutex() != 0 )
+		{
+			continue;
+		}
 
-	if ( ret == 0 )
-	{
-		*tbl_hdl_ptr = nati_obj_ptr->ddr_tbl_hdl;
+		mig_step_after_rule_op(nati_obj_ptr);
 
-		IPADBG("DDR table creation successful: tbl_hdl(0x%08X)\n",
-			   *tbl_hdl_ptr);
+		if ( ! nati_obj_ptr->mig.active )
+		{
+			/*
+			 * Cleared under the mutex, so the next switch knows to
+			 * start another worker...
+			 */
+			nati_obj_ptr->mig.worker = false;
+			done = true;
+		}
+
+		give_mutex();
 	}
 
 	IPADBG("Out\n");
 
-	return ret;
+	return NULL;
 }
 
 /******************************************************************************/
 /*
- * FUNCTION: _smAddSramTbl
+ * FUNCTION: mig_start_worker
  *
  * PARAMS:
  *
  *   nati_obj_ptr (IN) A pointer to an initialized nati object
  *
- *   trigger      (IN) The trigger to run through the state machine
+ * DESCRIPTION:
  *
- *   arb_data_ptr (IN) Whatever you like
+ *   Start mig_worker(), if an incremental switch is in progress and
+ *   it's not running already. Should it fail to start, the switch
+ *   still moves along after rule adds/deletes.
+ */
+static void mig_start_worker(
+	ipa_nati_obj* nati_obj_ptr )
+{
+	pthread_t tid;
+
+	int       ret;
+
+	if ( ! nati_obj_ptr->mig.active || nati_obj_ptr->mig.worker )
+	{
+		return;
+	}
+
+	ret = pthread_create(&tid, NULL, mig_worker, nati_obj_ptr);
+
+	if ( ret != 0 )
+	{
+		IPAWARN("Unable to start the switch worker (%d)\n", ret);
+		return;
+	}
+
+	pthread_detach(tid);
+
+	nati_obj_ptr->mig.worker = true;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: mig_del_src_rule
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr  (IN) A pointer to an initialized nati object
+ *
+ *   orig_rule_hdl (IN) The application's handle of the rule
  *
  * DESCRIPTION:
  *
- *   The following will cause the creation of a NAT table in SRAM.
+ *   While an incremental switch is in progress, delete a rule that
+ *   has not been moved yet, ie. that still lives in the source
+ *   table.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smAddSramTbl(
-	ipa_nati_obj*    nati_obj_ptr,
-	ipa_nati_trigger trigger,
-	arb_t*           arb_data_ptr )
+static int mig_del_src_rule(
+	ipa_nati_obj* nati_obj_ptr,
+	uint32_t      orig_rule_hdl )
 {
-	arb_t**   args = arb_data_ptr;
-
-	uint32_t  public_ip_addr    = (uint32_t)  args[0];
-	uint16_t  number_of_entries = (uint16_t)  args[1];
-	uint32_t* tbl_hdl_ptr       = (uint32_t*) args[2];
-
-	uint32_t  sram_size = 0;
+	uint32_t src_sub = nati_obj_ptr->mig.src_sub;
+	uint32_t new_rule_hdl;
 
-	int ret;
+	int      ret;
 
 	IPADBG("In\n");
 
-	IPADBG("public_ip_addr(0x%08X) tbl_hdl_ptr(%p)\n",
-		   public_ip_addr, tbl_hdl_ptr);
-
-	ret = ipa_nati_get_sram_size(&sram_size);
+	ret = ipa_nat_map_del(
+		nati_obj_ptr->map_pairs[src_sub].orig2new_map,
+		orig_rule_hdl,
+		&new_rule_hdl);
 
 	if ( ret == 0 )
 	{
-		ret = ipa_calc_num_sram_table_entries(
-			sram_size,
-			sizeof(struct ipa_nat_rule),
-			sizeof(struct ipa_nat_indx_tbl_rule),
-			&nati_obj_ptr->tot_slots_in_sram);
-
-		if ( ret == 0 )
-		{
-			nati_obj_ptr->back_to_sram_thresh =
-				PRCNT_OF(nati_obj_ptr->tot_slots_in_sram);
-
-			IPADBG("sram_size(%u or 0x%x) tot_slots_in_sram(%u) back_to_sram_thresh(%u)\n",
-				   sram_size,
-				   sram_size,
-				   nati_obj_ptr->tot_slots_in_sram,
-				   nati_obj_ptr->back_to_sram_thresh);
-
-			IPADBG("Voting clock on for sram table creation\n");
-
-			if ( (ret = ipa_nat_vote_clock(IPA_APP_CLK_VOTE)) != 0 )
-			{
-				IPAERR("Voting clock on failed\n");
-				goto done;
-			}
+		IPADBG("%s: orig_rule_hdl(0x%08X) -> new_rule_hdl(0x%08X)\n",
+			   SUB_AS_STR(src_sub), orig_rule_hdl, new_rule_hdl);
 
-			ret = ipa_NATI_add_ipv4_tbl(
-				IPA_NAT_MEM_IN_SRAM,
-				public_ip_addr,
-				nati_obj_ptr->tot_slots_in_sram,
-				&nati_obj_ptr->sram_tbl_hdl);
+		ipa_nat_map_del(
+			nati_obj_ptr->map_pairs[src_sub].new2orig_map, new_rule_hdl, NULL);
 
-			if ( ipa_nat_vote_clock(IPA_APP_CLK_DEVOTE) != 0 )
-			{
-				IPAWARN("Voting clock off failed\n");
-			}
+		ret = ipa_NATI_del_ipv4_rule(SUB_TBL_HDL(src_sub), new_rule_hdl);
 
-			if ( ret == 0 )
-			{
-				*tbl_hdl_ptr = nati_obj_ptr->sram_tbl_hdl;
+		if ( ret == 0 )
+		{
+			nati_obj_ptr->tot_rules_in_table[src_sub]--;
 
-				IPADBG("SRAM table creation successful: tbl_hdl(0x%08X)\n",
-					   *tbl_hdl_ptr);
-			}
+			/*
+			 * One less to move...
+			 */
+			nati_obj_ptr->sw_stats[src_sub].rules_total--;
 		}
 	}
 
-done:
 	IPADBG("Out\n");
 
 	return ret;
@@ -1078,109 +1391,114 @@ done:
 
 /******************************************************************************/
 /*
- * FUNCTION: _smAddSramAndDdrTbl
+ * FUNCTION: switch_incrementally
  *
  * PARAMS:
  *
  *   nati_obj_ptr (IN) A pointer to an initialized nati object
  *
- *   trigger      (IN) The trigger to run through the state machine
+ *   goto_trigger (IN) NATI_TRIG_GOTO_DDR or NATI_TRIG_GOTO_SRAM
  *
- *   arb_data_ptr (IN) Whatever you like
+ *   src_sub      (IN) The memory type being switched from
  *
  * DESCRIPTION:
  *
- *   The following will cause the creation of NAT tables in both DDR
- *   and in SRAM.
+ *   Start an incremental switch: focus the IPA on the destination
+ *   table, which is where rules get added from here on, and move the
+ *   first chunk of rules. mig_step() moves the rest, a chunk at a
+ *   time, after later rule adds/deletes and from mig_worker().
+ *
+ *   If a switch in the other direction is still in progress, the
+ *   destination holds the rules not yet moved by it, so it's not
+ *   cleared and the switch simply heads back the other way.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smAddSramAndDdrTbl(
+static int switch_incrementally(
 	ipa_nati_obj*    nati_obj_ptr,
-	ipa_nati_trigger trigger,
-	arb_t*           arb_data_ptr )
+	ipa_nati_trigger goto_trigger,
+	uint32_t         src_sub )
 {
-	arb_t**   args = arb_data_ptr;
-
-	uint32_t  public_ip_addr    = (uint32_t)  args[0];
-	uint16_t  number_of_entries = (uint16_t)  args[1];
-	uint32_t* tbl_hdl_ptr       = (uint32_t*) args[2];
+	nati_migration*    mig_ptr      = &nati_obj_ptr->mig;
+	uint32_t           dst_sub      = OTHER_SUB(src_sub);
+	nati_switch_stats* sw_stats_ptr = &nati_obj_ptr->sw_stats[src_sub];
 
-	uint32_t tbl_hdl;
+	bool               reverse      = mig_ptr->active;
 
-	int ret;
+	int                ret;
 
 	IPADBG("In\n");
 
-	nati_obj_ptr->tot_rules_in_table[SRAM_SUB] = 0;
-	nati_obj_ptr->tot_rules_in_table[DDR_SUB]  = 0;
-
-	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].orig2new_map);
-	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].new2orig_map);
-	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map);
-	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].new2orig_map);
-
-	ret = _smAddSramTbl(nati_obj_ptr, trigger, arb_data_ptr);
+	ret = ipa_nati_statemach(nati_obj_ptr, goto_trigger, 0);
 
-	if ( ret == 0 )
+	if ( ret != 0 )
 	{
-		if ( nati_obj_ptr->tot_slots_in_sram >= number_of_entries )
-		{
-			/*
-			 * The number of slots in SRAM can accommodate what was
-			 * being requested for DDR, hence no need to use DDR and
-			 * we will continue by using SRAM only...
-			 */
-			SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_SRAM_ONLY);
-		}
-		else
-		{
-			/*
-			 * SRAM not big enough. Let's create secondary DDR based
-			 * table...
-			 */
-			arb_t*   new_args[] = {
-				(arb_t*)(arb_t)public_ip_addr,
-				(arb_t*)(arb_t)number_of_entries,
-				(arb_t*) &tbl_hdl,  /* to protect app's table handle above */
-			};
-
-			ret = _smAddDdrTbl(nati_obj_ptr, trigger, new_args);
+		goto bail;
+	}
 
-			if ( ret == 0 )
-			{
-				/*
-				 * The following will tell the IPA to change focus to
-				 * SRAM...
-				 */
-				ret = ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_GOTO_SRAM, 0);
-			}
-		}
+	if ( reverse )
+	{
+		IPAINFO("Reversing switch to %s with %u rules still in %s\n",
+				SUB_AS_STR(src_sub),
+				nati_obj_ptr->tot_rules_in_table[dst_sub],
+				SUB_AS_STR(dst_sub));
 	}
 	else
 	{
-		/*
-		 * SRAM table creation in HYBRID mode failed.  Can we fall
-		 * back to DDR only?  We need to try and see what happens...
-		 */
-		ret = _smAddDdrTbl(nati_obj_ptr, trigger, arb_data_ptr);
+		nati_obj_ptr->tot_rules_in_table[dst_sub] = 0;
 
-		if ( ret == 0 )
+		ipa_nat_map_clear(nati_obj_ptr->map_pairs[dst_sub].orig2new_map);
+		ipa_nat_map_clear(nati_obj_ptr->map_pairs[dst_sub].new2orig_map);
+
+		ret = ipa_NATI_clear_ipv4_tbl(SUB_TBL_HDL(dst_sub));
+
+		if ( ret != 0 )
 		{
-			SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_DDR_ONLY);
+			sw_stats_ptr->fail += 1;
+			goto bail;
 		}
 	}
 
+	mig_ptr->active     = true;
+	mig_ptr->src_sub    = src_sub;
+	mig_ptr->next_index = 0;
+
+	currTimeAs(TimeAsNanSecs, &mig_ptr->start);
+
+	sw_stats_ptr->steps       = 0;
+	sw_stats_ptr->rules_total = nati_obj_ptr->tot_rules_in_table[src_sub];
+	sw_stats_ptr->rules_moved = 0;
+	sw_stats_ptr->rules_left  = sw_stats_ptr->rules_total;
+	sw_stats_ptr->switch_ns   = 0;
+	sw_stats_ptr->stall_ns    = 0;
+
+	mig_step(nati_obj_ptr, nati_obj_ptr->switch_chunk);
+
+	mig_start_worker(nati_obj_ptr);
+
+bail:
 	IPADBG("Out\n");
 
 	return ret;
 }
 
+/*
+ * ****************************************************************************
+ *
+ * STATE MACHINE CODE BEGINS HERE
+ *
+ * ****************************************************************************
+ */
+static int _smUndef(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr ); /* forward declaration */
+
 /******************************************************************************/
 /*
- * FUNCTION: _smDelSramAndDdrTbl
+ * FUNCTION: _smDelTbl
  *
  * PARAMS:
  *
@@ -1192,42 +1510,31 @@ static int _smAddSramAndDdrTbl(
  *
  * DESCRIPTION:
  *
- *   The following will cause the destruction of the SRAM, then DDR
- *   based NAT tables.
+ *   The following will cause the destruction of the DDR based NAT
+ *   table.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smDelSramAndDdrTbl(
+static int _smDelTbl(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
-	int ret;
-
-	IPADBG("In\n");
+	arb_t**  args = arb_data_ptr;
 
-	nati_obj_ptr->tot_rules_in_table[SRAM_SUB] = 0;
-	nati_obj_ptr->tot_rules_in_table[DDR_SUB]  = 0;
+	uint32_t tbl_hdl = (uint32_t) args[0];
 
-	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].orig2new_map);
-	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].new2orig_map);
-	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map);
-	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].new2orig_map);
+	int ret;
 
-	ret = _smDelTbl(nati_obj_ptr, trigger, arb_data_ptr);
+	IPADBG("In\n");
 
-	if ( ret == 0 )
-	{
-		arb_t* new_args[] = {
-			(arb_t*)(arb_t)nati_obj_ptr->ddr_tbl_hdl,
-		};
+	IPADBG("tbl_hdl(0x%08X)\n", tbl_hdl);
 
-		ret = _smDelTbl(nati_obj_ptr, trigger, new_args);
-	}
+	ret = ipa_NATI_del_ipv4_table(tbl_hdl);
 
-	if ( ret == 0 )
+	if ( ret == 0 && ! IN_HYBRID_STATE() )
 	{
 		/*
 		 * The following will create the preferred "initial state" for
@@ -1243,7 +1550,7 @@ static int _smDelSramAndDdrTbl(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smClrTbl
+ * FUNCTION: _smFirstTbl
  *
  * PARAMS:
  *
@@ -1255,48 +1562,41 @@ static int _smDelSramAndDdrTbl(
  *
  * DESCRIPTION:
  *
- *   The following will cause the clearing of a table.
+ *   The following will cause the creation of the very first NAT table(s)
+ *   before any others have ever been created...
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smClrTbl(
+static int _smFirstTbl(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
-	arb_t**  args = arb_data_ptr;
-
-	uint32_t tbl_hdl = (uint32_t) args[0];
+	arb_t**   args = arb_data_ptr;
 
-	enum ipa3_nat_mem_in nmi;
-	uint32_t             unused_hdl, sub;
+	uint32_t    public_ip_addr    = (uint32_t)    args[0];
+	uint16_t    number_of_entries = (uint16_t)    args[1];
+	uint32_t*   tbl_hdl_ptr       = (uint32_t*)   args[2];
+	const char* mem_type_ptr      = (const char*) args[3];
 
 	int ret;
 
 	IPADBG("In\n");
 
-	IPADBG("tbl_hdl(0x%08X)\n", tbl_hdl);
+	/*
+	 * This is the first time in here.  Let the ipacm's XML config (or
+	 * state_to_hold) drive initial state...
+	 */
+	SET_NATIOBJ_STATE(
+		nati_obj_ptr,
+		(nati_obj_ptr->hold_state && nati_obj_ptr->state_to_hold) ?
+		nati_obj_ptr->state_to_hold                               :
+		mem_type_str_to_ipa_nati_state(mem_type_ptr));
 
-	BREAK_TBL_HDL(tbl_hdl, nmi, unused_hdl);
-
-	if ( ! IPA_VALID_NAT_MEM_IN(nmi) ) {
-		IPAERR("Bad cache type\n");
-		ret = -EINVAL;
-		goto bail;
-	}
-
-	sub = (nmi == IPA_NAT_MEM_IN_SRAM) ? SRAM_SUB : DDR_SUB;
-
-	nati_obj_ptr->tot_rules_in_table[sub] = 0;
-
-	ipa_nat_map_clear(nati_obj.map_pairs[sub].orig2new_map);
-	ipa_nat_map_clear(nati_obj.map_pairs[sub].new2orig_map);
-
-	ret = ipa_NATI_clear_ipv4_tbl(tbl_hdl);
+	ret = ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_ADD_TABLE, args);
 
-bail:
 	IPADBG("Out\n");
 
 	return ret;
@@ -1304,7 +1604,7 @@ bail:
 
 /******************************************************************************/
 /*
- * FUNCTION: _smClrTblHybrid
+ * FUNCTION: _smAddDdrTbl
  *
  * PARAMS:
  *
@@ -1316,33 +1616,43 @@ bail:
  *
  * DESCRIPTION:
  *
- *   The following will cause the clearing of the appropriate hybrid
- *   table.
+ *   The following will cause the creation of a NAT table in DDR.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smClrTblHybrid(
+static int _smAddDdrTbl(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
-	arb_t**  args = arb_data_ptr;
-
-	uint32_t tbl_hdl = (uint32_t) args[0];
+	arb_t**   args = arb_data_ptr;
 
-	arb_t*   new_args[] = {
-		(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
-		         tbl_hdl :
-		         nati_obj_ptr->ddr_tbl_hdl,
-	};
+	uint32_t  public_ip_addr    = (uint32_t)  args[0];
+	uint16_t  number_of_entries = (uint16_t)  args[1];
+	uint32_t* tbl_hdl_ptr       = (uint32_t*) args[2];
 
 	int ret;
 
 	IPADBG("In\n");
 
-	ret = _smClrTbl(nati_obj_ptr, trigger, new_args);
+	IPADBG("public_ip_addr(0x%08X) number_of_entries(%u) tbl_hdl_ptr(%p)\n",
+		   public_ip_addr, number_of_entries, tbl_hdl_ptr);
+
+	ret = ipa_NATI_add_ipv4_tbl(
+		IPA_NAT_MEM_IN_DDR,
+		public_ip_addr,
+		number_of_entries,
+		&nati_obj_ptr->ddr_tbl_hdl);
+
+	if ( ret == 0 )
+	{
+		*tbl_hdl_ptr = nati_obj_ptr->ddr_tbl_hdl;
+
+		IPADBG("DDR table creation successful: tbl_hdl(0x%08X)\n",
+			   *tbl_hdl_ptr);
+	}
 
 	IPADBG("Out\n");
 
@@ -1351,7 +1661,7 @@ static int _smClrTblHybrid(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smWalkTbl
+ * FUNCTION: _smAddSramTbl
  *
  * PARAMS:
  *
@@ -1363,32 +1673,83 @@ static int _smClrTblHybrid(
  *
  * DESCRIPTION:
  *
- *   The following will cause the walk of a table.
+ *   The following will cause the creation of a NAT table in SRAM.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smWalkTbl(
+static int _smAddSramTbl(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
-	arb_t** args = arb_data_ptr;
+	arb_t**   args = arb_data_ptr;
 
-	uint32_t          tbl_hdl = (uint32_t)          args[0];
-	WhichTbl2Use      which   = (WhichTbl2Use)      args[1];
-	ipa_table_walk_cb walk_cb = (ipa_table_walk_cb) args[2];
-	arb_t*            wadp    = (arb_t*)            args[3];
+	uint32_t  public_ip_addr    = (uint32_t)  args[0];
+	uint16_t  number_of_entries = (uint16_t)  args[1];
+	uint32_t* tbl_hdl_ptr       = (uint32_t*) args[2];
+
+	uint32_t  sram_size = 0;
 
 	int ret;
 
 	IPADBG("In\n");
 
-	IPADBG("tbl_hdl(0x%08X)\n", tbl_hdl);
+	IPADBG("public_ip_addr(0x%08X) tbl_hdl_ptr(%p)\n",
+		   public_ip_addr, tbl_hdl_ptr);
 
-	ret = ipa_NATI_walk_ipv4_tbl(tbl_hdl, which, walk_cb, wadp);
+	ret = ipa_nati_get_sram_size(&sram_size);
+
+	if ( ret == 0 )
+	{
+		ret = ipa_calc_num_sram_table_entries(
+			sram_size,
+			sizeof(struct ipa_nat_rule),
+			sizeof(struct ipa_nat_indx_tbl_rule),
+			&nati_obj_ptr->tot_slots_in_sram);
+
+		if ( ret == 0 )
+		{
+			nati_obj_ptr->back_to_sram_thresh =
+				PRCNT_OF(nati_obj_ptr->tot_slots_in_sram);
+
+			IPADBG("sram_size(%u or 0x%x) tot_slots_in_sram(%u) back_to_sram_thresh(%u)\n",
+				   sram_size,
+				   sram_size,
+				   nati_obj_ptr->tot_slots_in_sram,
+				   nati_obj_ptr->back_to_sram_thresh);
+
+			IPADBG("Voting clock on for sram table creation\n");
+
+			if ( (ret = ipa_nat_vote_clock(IPA_APP_CLK_VOTE)) != 0 )
+			{
+				IPAERR("Voting clock on failed\n");
+				goto done;
+			}
+
+			ret = ipa_NATI_add_ipv4_tbl(
+				IPA_NAT_MEM_IN_SRAM,
+				public_ip_addr,
+				nati_obj_ptr->tot_slots_in_sram,
+				&nati_obj_ptr->sram_tbl_hdl);
+
+			if ( ipa_nat_vote_clock(IPA_APP_CLK_DEVOTE) != 0 )
+			{
+				IPAWARN("Voting clock off failed\n");
+			}
+
+			if ( ret == 0 )
+			{
+				*tbl_hdl_ptr = nati_obj_ptr->sram_tbl_hdl;
+
+				IPADBG("SRAM table creation successful: tbl_hdl(0x%08X)\n",
+					   *tbl_hdl_ptr);
+			}
+		}
+	}
 
+done:
 	IPADBG("Out\n");
 
 	return ret;
@@ -1396,7 +1757,7 @@ static int _smWalkTbl(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smWalkTblHybrid
+ * FUNCTION: _smAddSramAndDdrTbl
  *
  * PARAMS:
  *
@@ -1408,39 +1769,105 @@ static int _smWalkTbl(
  *
  * DESCRIPTION:
  *
- *   The following will cause the walk of the appropriate hybrid
- *   table.
+ *   The following will cause the creation of NAT tables in both DDR
+ *   and in SRAM.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smWalkTblHybrid(
+static int _smAddSramAndDdrTbl(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
-	arb_t** args = arb_data_ptr;
+	arb_t**   args = arb_data_ptr;
 
-	uint32_t          tbl_hdl = (uint32_t)          args[0];
-	WhichTbl2Use      which   = (WhichTbl2Use)      args[1];
-	ipa_table_walk_cb walk_cb = (ipa_table_walk_cb) args[2];
-	arb_t*            wadp    = (arb_t*)            args[3];
+	uint32_t  public_ip_addr    = (uint32_t)  args[0];
+	uint16_t  number_of_entries = (uint16_t)  args[1];
+	uint32_t* tbl_hdl_ptr       = (uint32_t*) args[2];
 
-	arb_t* new_args[] = {
-		(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
-		         tbl_hdl :
-		         nati_obj_ptr->ddr_tbl_hdl,
-		(arb_t*) which,
-		(arb_t*) walk_cb,
-		(arb_t*) wadp,
-	};
+	uint32_t tbl_hdl;
 
 	int ret;
 
 	IPADBG("In\n");
 
-	ret = _smWalkTbl(nati_obj_ptr, trigger, new_args);
+	nati_obj_ptr->tot_rules_in_table[SRAM_SUB] = 0;
+	nati_obj_ptr->tot_rules_in_table[DDR_SUB]  = 0;
+
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].orig2new_map);
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].new2orig_map);
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map);
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].new2orig_map);
+
+	ret = _smAddSramTbl(nati_obj_ptr, trigger, arb_data_ptr);
+
+	if ( ret == 0 )
+	{
+		if ( nati_obj_ptr->tot_slots_in_sram >= number_of_entries )
+		{
+			/*
+			 * The number of slots in SRAM can accommodate what was
+			 * being requested for DDR, hence no need to use DDR and
+			 * we will continue by using SRAM only...
+			 */
+			SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_SRAM_ONLY);
+		}
+		else
+		{
+			/*
+			 * SRAM not big enough. Let's create secondary DDR based
+			 * table...
+			 */
+			arb_t*   new_args[] = {
+				(arb_t*)(arb_t)public_ip_addr,
+				(arb_t*)(arb_t)number_of_entries,
+				(arb_t*) &tbl_hdl,  /* to protect app's table handle above */
+			};
+
+			ret = _smAddDdrTbl(nati_obj_ptr, trigger, new_args);
+
+			if ( ret == 0 )
+			{
+				/*
+				 * Size the handle maps for the worst case now, so
+				 * that adds and migrations don't have to grow them...
+				 */
+				ipa_nat_map_reserve(
+					nati_obj_ptr->map_pairs[SRAM_SUB].orig2new_map,
+					nati_obj_ptr->tot_slots_in_sram);
+				ipa_nat_map_reserve(
+					nati_obj_ptr->map_pairs[SRAM_SUB].new2orig_map,
+					nati_obj_ptr->tot_slots_in_sram);
+				ipa_nat_map_reserve(
+					nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map,
+					number_of_entries);
+				ipa_nat_map_reserve(
+					nati_obj_ptr->map_pairs[DDR_SUB].new2orig_map,
+					number_of_entries);
+
+				/*
+				 * The following will tell the IPA to change focus to
+				 * SRAM...
+				 */
+				ret = ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_GOTO_SRAM, 0);
+			}
+		}
+	}
+	else
+	{
+		/*
+		 * SRAM table creation in HYBRID mode failed.  Can we fall
+		 * back to DDR only?  We need to try and see what happens...
+		 */
+		ret = _smAddDdrTbl(nati_obj_ptr, trigger, arb_data_ptr);
+
+		if ( ret == 0 )
+		{
+			SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_DDR_ONLY);
+		}
+	}
 
 	IPADBG("Out\n");
 
@@ -1449,7 +1876,7 @@ static int _smWalkTblHybrid(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smStatTbl
+ * FUNCTION: _smDelSramAndDdrTbl
  *
  * PARAMS:
  *
@@ -1461,30 +1888,51 @@ static int _smWalkTblHybrid(
  *
  * DESCRIPTION:
  *
- *   The following will get size/usage stats for a table.
+ *   The following will cause the destruction of the SRAM, then DDR
+ *   based NAT tables.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smStatTbl(
+static int _smDelSramAndDdrTbl(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
-	arb_t** args = arb_data_ptr;
-
-	uint32_t            tbl_hdl       = (uint32_t)            args[0];
-	ipa_nati_tbl_stats* nat_stats_ptr = (ipa_nati_tbl_stats*) args[1];
-	ipa_nati_tbl_stats* idx_stats_ptr = (ipa_nati_tbl_stats*) args[2];
-
 	int ret;
 
 	IPADBG("In\n");
 
-	IPADBG("tbl_hdl(0x%08X)\n", tbl_hdl);
+	nati_obj_ptr->tot_rules_in_table[SRAM_SUB] = 0;
+	nati_obj_ptr->tot_rules_in_table[DDR_SUB]  = 0;
 
-	ret = ipa_NATI_ipv4_tbl_stats(tbl_hdl, nat_stats_ptr, idx_stats_ptr);
+	nati_obj_ptr->mig.active = false;
+
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].orig2new_map);
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[SRAM_SUB].new2orig_map);
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].orig2new_map);
+	ipa_nat_map_clear(nati_obj_ptr->map_pairs[DDR_SUB].new2orig_map);
+
+	ret = _smDelTbl(nati_obj_ptr, trigger, arb_data_ptr);
+
+	if ( ret == 0 )
+	{
+		arb_t* new_args[] = {
+			(arb_t*)(arb_t)nati_obj_ptr->ddr_tbl_hdl,
+		};
+
+		ret = _smDelTbl(nati_obj_ptr, trigger, new_args);
+	}
+
+	if ( ret == 0 )
+	{
+		/*
+		 * The following will create the preferred "initial state" for
+		 * restart...
+		 */
+		BACK2_UNSTARTED_STATE();
+	}
 
 	IPADBG("Out\n");
 
@@ -1493,7 +1941,7 @@ static int _smStatTbl(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smStatTblHybrid
+ * FUNCTION: _smClrTbl
  *
  * PARAMS:
  *
@@ -1505,38 +1953,115 @@ static int _smStatTbl(
  *
  * DESCRIPTION:
  *
- *   The following will cause the retrieval of table size/usage stats
- *   for the appropriate hybrid table.
+ *   The following will cause the clearing of a table.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smStatTblHybrid(
+static int _smClrTbl(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
-	arb_t** args = arb_data_ptr;
+	arb_t**  args = arb_data_ptr;
 
-	uint32_t            tbl_hdl       = (uint32_t)            args[0];
-	ipa_nati_tbl_stats* nat_stats_ptr = (ipa_nati_tbl_stats*) args[1];
-	ipa_nati_tbl_stats* idx_stats_ptr = (ipa_nati_tbl_stats*) args[2];
+	uint32_t tbl_hdl = (uint32_t) args[0];
 
-	arb_t* new_args[] = {
+	enum ipa3_nat_mem_in nmi;
+	uint32_t             unused_hdl, sub;
+
+	int ret;
+
+	IPADBG("In\n");
+
+	IPADBG("tbl_hdl(0x%08X)\n", tbl_hdl);
+
+	BREAK_TBL_HDL(tbl_hdl, nmi, unused_hdl);
+
+	if ( ! IPA_VALID_NAT_MEM_IN(nmi) ) {
+		IPAERR("Bad cache type\n");
+		ret = -EINVAL;
+		goto bail;
+	}
+
+	sub = (nmi == IPA_NAT_MEM_IN_SRAM) ? SRAM_SUB : DDR_SUB;
+
+	nati_obj_ptr->tot_rules_in_table[sub] = 0;
+
+	ipa_nat_map_clear(nati_obj.map_pairs[sub].orig2new_map);
+	ipa_nat_map_clear(nati_obj.map_pairs[sub].new2orig_map);
+
+	ret = ipa_NATI_clear_ipv4_tbl(tbl_hdl);
+
+bail:
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: _smClrTblHybrid
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the clearing of the appropriate hybrid
+ *   table.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smClrTblHybrid(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t**  args = arb_data_ptr;
+
+	uint32_t tbl_hdl = (uint32_t) args[0];
+
+	arb_t*   new_args[] = {
 		(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
 		         tbl_hdl :
 		         nati_obj_ptr->ddr_tbl_hdl,
-		(arb_t*) nat_stats_ptr,
-		(arb_t*) idx_stats_ptr,
 	};
 
 	int ret;
 
 	IPADBG("In\n");
 
-	ret = _smStatTbl(nati_obj_ptr, trigger, new_args);
+	if ( nati_obj_ptr->mig.active )
+	{
+		/*
+		 * Some rules are still in the table being switched from...
+		 */
+		arb_t* src_args[] = {
+			(arb_t*)(arb_t)SUB_TBL_HDL(nati_obj_ptr->mig.src_sub),
+		};
+
+		ret = _smClrTbl(nati_obj_ptr, trigger, src_args);
+
+		if ( ret != 0 )
+		{
+			goto bail;
+		}
+
+		nati_obj_ptr->mig.active = false;
+	}
+
+	ret = _smClrTbl(nati_obj_ptr, trigger, new_args);
 
+bail:
 	IPADBG("Out\n");
 
 	return ret;
@@ -1544,7 +2069,7 @@ static int _smStatTblHybrid(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smAddRuleToTbl
+ * FUNCTION: _smWalkTbl
  *
  * PARAMS:
  *
@@ -1556,46 +2081,91 @@ static int _smStatTblHybrid(
  *
  * DESCRIPTION:
  *
- *   The following will cause the addtion of a NAT rule into the DDR
- *   based table.
+ *   The following will cause the walk of a table.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smAddRuleToTbl(
+static int _smWalkTbl(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
 	arb_t** args = arb_data_ptr;
 
-	uint32_t           tbl_hdl   = (uint32_t)           args[0];
-	ipa_nat_ipv4_rule* clnt_rule = (ipa_nat_ipv4_rule*) args[1];
-	uint32_t*          rule_hdl  = (uint32_t*)          args[2];
-
-	char buf[1024];
+	uint32_t          tbl_hdl = (uint32_t)          args[0];
+	WhichTbl2Use      which   = (WhichTbl2Use)      args[1];
+	ipa_table_walk_cb walk_cb = (ipa_table_walk_cb) args[2];
+	arb_t*            wadp    = (arb_t*)            args[3];
 
 	int ret;
 
 	IPADBG("In\n");
 
-	IPADBG("tbl_hdl(0x%08X) clnt_rule_ptr(%p) rule_hdl_ptr(%p) %s\n",
-		   tbl_hdl, clnt_rule, rule_hdl,
-		   prep_nat_ipv4_rule_4print(clnt_rule, buf, sizeof(buf)));
+	IPADBG("tbl_hdl(0x%08X)\n", tbl_hdl);
 
-	clnt_rule->redirect = clnt_rule->enable = clnt_rule->time_stamp = 0;
+	ret = ipa_NATI_walk_ipv4_tbl(tbl_hdl, which, walk_cb, wadp);
 
-	ret = ipa_NATI_add_ipv4_rule(tbl_hdl, clnt_rule, rule_hdl);
+	IPADBG("Out\n");
 
-	if ( ret == 0 )
-	{
-		uint32_t* cnt_ptr = CHOOSE_CNTR();
+	return ret;
+}
 
-		(*cnt_ptr)++;
+/******************************************************************************/
+/*
+ * FUNCTION: _smWalkTblHybrid
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the walk of the appropriate hybrid
+ *   table.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smWalkTblHybrid(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t** args = arb_data_ptr;
 
-		IPADBG("rule_hdl value(%u or 0x%08X)\n",
-			   *rule_hdl, *rule_hdl);
+	uint32_t          tbl_hdl = (uint32_t)          args[0];
+	WhichTbl2Use      which   = (WhichTbl2Use)      args[1];
+	ipa_table_walk_cb walk_cb = (ipa_table_walk_cb) args[2];
+	arb_t*            wadp    = (arb_t*)            args[3];
+
+	arb_t* new_args[] = {
+		(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
+		         tbl_hdl :
+		         nati_obj_ptr->ddr_tbl_hdl,
+		(arb_t*) which,
+		(arb_t*) walk_cb,
+		(arb_t*) wadp,
+	};
+
+	int ret;
+
+	IPADBG("In\n");
+
+	/*
+	 * Have all rules in one table...
+	 */
+	ret = mig_step(nati_obj_ptr, 0);
+
+	if ( ret == 0 )
+	{
+		ret = _smWalkTbl(nati_obj_ptr, trigger, new_args);
 	}
 
 	IPADBG("Out\n");
@@ -1605,7 +2175,7 @@ static int _smAddRuleToTbl(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smDelRuleFromTbl
+ * FUNCTION: _smStatTbl
  *
  * PARAMS:
  *
@@ -1617,37 +2187,596 @@ static int _smAddRuleToTbl(
  *
  * DESCRIPTION:
  *
- *   The following will cause the deletion of a NAT rule from the DDR
- *   based table.
+ *   The following will get size/usage stats for a table.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smDelRuleFromTbl(
+static int _smStatTbl(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
-	arb_t**  args = arb_data_ptr;
+	arb_t** args = arb_data_ptr;
 
-	uint32_t tbl_hdl  = (uint32_t) args[0];
-	uint32_t rule_hdl = (uint32_t) args[1];
+	uint32_t            tbl_hdl       = (uint32_t)            args[0];
+	ipa_nati_tbl_stats* nat_stats_ptr = (ipa_nati_tbl_stats*) args[1];
+	ipa_nati_tbl_stats* idx_stats_ptr = (ipa_nati_tbl_stats*) args[2];
 
 	int ret;
 
 	IPADBG("In\n");
 
-	IPADBG("tbl_hdl(0x%08X) rule_hdl(%u)\n", tbl_hdl, rule_hdl);
+	IPADBG("tbl_hdl(0x%08X)\n", tbl_hdl);
 
-	ret = ipa_NATI_del_ipv4_rule(tbl_hdl, rule_hdl);
+	ret = ipa_NATI_ipv4_tbl_stats(tbl_hdl, nat_stats_ptr, idx_stats_ptr);
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: _smStatTblHybrid
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the retrieval of table size/usage stats
+ *   for the appropriate hybrid table.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smStatTblHybrid(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t** args = arb_data_ptr;
+
+	uint32_t            tbl_hdl       = (uint32_t)            args[0];
+	ipa_nati_tbl_stats* nat_stats_ptr = (ipa_nati_tbl_stats*) args[1];
+	ipa_nati_tbl_stats* idx_stats_ptr = (ipa_nati_tbl_stats*) args[2];
+
+	arb_t* new_args[] = {
+		(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
+		         tbl_hdl :
+		         nati_obj_ptr->ddr_tbl_hdl,
+		(arb_t*) nat_stats_ptr,
+		(arb_t*) idx_stats_ptr,
+	};
+
+	int ret;
+
+	IPADBG("In\n");
+
+	/*
+	 * Have all rules in one table...
+	 */
+	ret = mig_step(nati_obj_ptr, 0);
 
 	if ( ret == 0 )
 	{
-		uint32_t* cnt_ptr = CHOOSE_CNTR();
+		ret = _smStatTbl(nati_obj_ptr, trigger, new_args);
+	}
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: _smAddRuleToTbl
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the addtion of a NAT rule into the DDR
+ *   based table.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smAddRuleToTbl(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t** args = arb_data_ptr;
+
+	uint32_t           tbl_hdl   = (uint32_t)           args[0];
+	ipa_nat_ipv4_rule* clnt_rule = (ipa_nat_ipv4_rule*) args[1];
+	uint32_t*          rule_hdl  = (uint32_t*)          args[2];
+
+	char buf[1024];
+
+	int ret;
+
+	IPADBG("In\n");
+
+	IPADBG("tbl_hdl(0x%08X) clnt_rule_ptr(%p) rule_hdl_ptr(%p) %s\n",
+		   tbl_hdl, clnt_rule, rule_hdl,
+		   prep_nat_ipv4_rule_4print(clnt_rule, buf, sizeof(buf)));
+
+	clnt_rule->redirect = clnt_rule->enable = clnt_rule->time_stamp = 0;
+
+	ret = ipa_NATI_add_ipv4_rule(tbl_hdl, clnt_rule, rule_hdl);
+
+	if ( ret == 0 )
+	{
+		uint32_t* cnt_ptr = CHOOSE_CNTR();
+
+		(*cnt_ptr)++;
+
+		IPADBG("rule_hdl value(%u or 0x%08X)\n",
+			   *rule_hdl, *rule_hdl);
+	}
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: _smDelRuleFromTbl
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the deletion of a NAT rule from the DDR
+ *   based table.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smDelRuleFromTbl(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t**  args = arb_data_ptr;
+
+	uint32_t tbl_hdl  = (uint32_t) args[0];
+	uint32_t rule_hdl = (uint32_t) args[1];
+
+	int ret;
+
+	IPADBG("In\n");
+
+	IPADBG("tbl_hdl(0x%08X) rule_hdl(%u)\n", tbl_hdl, rule_hdl);
+
+	ret = ipa_NATI_del_ipv4_rule(tbl_hdl, rule_hdl);
+
+	if ( ret == 0 )
+	{
+		uint32_t* cnt_ptr = CHOOSE_CNTR();
+
+		(*cnt_ptr)--;
+	}
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: _smAddRuleHybrid
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the addition of a NAT rule into either
+ *   the SRAM or DDR based table.
+ *
+ *   *** !!! HOWEVER *** REMEMBER !!! ***
+ *
+ *   We're here because we're in a HYBRID state...with the potential
+ *   moving between SRAM and DDR.  THIS HAS IMLICATIONS AS IT RELATES
+ *   TO RULE MAPPING.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smAddRuleHybrid(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t** args = arb_data_ptr;
+
+	uint32_t           tbl_hdl   = (uint32_t)           args[0];
+	ipa_nat_ipv4_rule* clnt_rule = (ipa_nat_ipv4_rule*) args[1];
+	uint32_t*          rule_hdl  = (uint32_t*)          args[2];
+
+	arb_t*             new_args[] = {
+		(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
+		         tbl_hdl :
+		         nati_obj_ptr->ddr_tbl_hdl,
+		(arb_t*) clnt_rule,
+		(arb_t*) rule_hdl,
+	};
+
+	uint32_t orig2new_map, new2orig_map;
+
+	int ret;
+
+	IPADBG("In\n");
+
+	ret = _smAddRuleToTbl(nati_obj_ptr, trigger, new_args);
+
+	if ( ret == 0 )
+	{
+		/*
+		 * The rule_hdl is used to find a rule in the nat table.  It
+		 * is, in effect, an index into the table.  The applcation
+		 * above us retains it for future manipulation of the rule in
+		 * the table.
+		 *
+		 * In hybrid mode, a rule can and will move between SRAM and
+		 * DDR.  Because of this, its handle will change.  The
+		 * application has only the original handle and doesn't know
+		 * of the new handle.  A mapping, used in hybrid mode, will
+		 * maintain a relationship between the original handle and the
+		 * rule's current real handle...
+		 *
+		 * To help you get a mindset of how this is done:
+		 *
+		 *   The original handle will map (point) to the new and new
+		 *   handle will map (point) back to original.
+		 *
+		 * NOTE WELL: There are two sets of maps.  One for each memory
+		 *            type...
+		 */
+		CHOOSE_MAPS(orig2new_map, new2orig_map);
+
+		ret = ipa_nat_map_add(orig2new_map, *rule_hdl, *rule_hdl);
+
+		if ( ret == 0 )
+		{
+			ret = ipa_nat_map_add(new2orig_map, *rule_hdl, *rule_hdl);
+		}
+	}
+	else
+	{
+		if ( nati_obj_ptr->curr_state == NATI_STATE_HYBRID
+			 &&
+			 ! nati_obj_ptr->hold_state )
+		{
+			/*
+			 * In hybrid mode, we always start in SRAM...hence
+			 * NATI_STATE_HYBRID implies SRAM.  The rule addition
+			 * above did not work, meaning the SRAM table is full,
+			 * hence let's jump to DDR...
+			 *
+			 * The following will focus us on DDR and cause the copy
+			 * of data from SRAM to DDR.
+			 */
+			IPAINFO("Add of rule failed...attempting table switch\n");
+
+			ret = ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_TBL_SWITCH, 0);
+
+			if ( ret == 0 )
+			{
+				SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_HYBRID_DDR);
+
+				/*
+				 * Now add the rule to DDR...
+				 */
+				ret = ipa_nati_statemach(nati_obj_ptr, trigger, arb_data_ptr);
+			}
+		}
+	}
+
+	mig_step_after_rule_op(nati_obj_ptr);
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: _smDelRuleHybrid
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the deletion of a NAT rule from either
+ *   the SRAM or DDR based table.
+ *
+ *   *** !!! HOWEVER *** REMEMBER !!! ***
+ *
+ *   We're here because we're in a HYBRID state...with the potential
+ *   moving between SRAM and DDR.  THIS HAS IMLICATIONS AS IT RELATES
+ *   TO RULE MAPPING.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smDelRuleHybrid(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t**  args = arb_data_ptr;
+
+	uint32_t tbl_hdl       = (uint32_t) args[0];
+	uint32_t orig_rule_hdl = (uint32_t) args[1];
+
+	uint32_t new_rule_hdl;
+
+	uint32_t orig2new_map,  new2orig_map;
+
+	int      ret;
+
+	IPADBG("In\n");
+
+	CHOOSE_MAPS(orig2new_map, new2orig_map);
+
+	/*
+	 * The rule_hdl is used to find a rule in the nat table.  It is,
+	 * in effect, an index into the table.  The applcation above us
+	 * retains it for future manipulation of the rule in the table.
+	 *
+	 * In hybrid mode, a rule can and will move between SRAM and DDR.
+	 * Because of this, its handle will change.  The application has
+	 * only the original handle and doesn't know of the new handle.  A
+	 * mapping, used in hybrid mode, will maintain a relationship
+	 * between the original handle and the rule's current real
+	 * handle...
+	 *
+	 * To help you get a mindset of how this is done:
+	 *
+	 *   The original handle will map (point) to the new and new
+	 *   handle will map (point) back to original.
+	 *
+	 * NOTE WELL: There are two sets of maps.  One for each memory
+	 *            type...
+	 *
+	 * While switching incrementally, a rule not moved yet is still
+	 * in, and mapped to, the table being switched from...
+	 */
+	if ( nati_obj_ptr->mig.active
+		 &&
+		 ! ipa_nat_map_contains(orig2new_map, orig_rule_hdl) )
+	{
+		ret = mig_del_src_rule(nati_obj_ptr, orig_rule_hdl);
+		goto step;
+	}
+
+	ret = ipa_nat_map_del(orig2new_map, orig_rule_hdl, &new_rule_hdl);
+
+	if ( ret == 0 )
+	{
+		arb_t* new_args[]  = {
+			(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
+			        tbl_hdl :
+			        nati_obj_ptr->ddr_tbl_hdl,
+			(arb_t*)(arb_t)new_rule_hdl,
+		};
+
+		IPADBG("orig_rule_hdl(0x%08X) -> new_rule_hdl(0x%08X)\n",
+			   orig_rule_hdl, new_rule_hdl);
+
+		ipa_nat_map_del(new2orig_map, new_rule_hdl, NULL);
+
+		ret = _smDelRuleFromTbl(nati_obj_ptr, trigger, new_args);
+
+		if ( ret == 0
+			 &&
+			 nati_obj_ptr->curr_state == NATI_STATE_HYBRID_DDR
+			 &&
+			 ! nati_obj_ptr->mig.active )
+		{
+			/*
+			 * We need to check when/if we can go back to SRAM.
+			 *
+			 * How/why can we go back?
+			 *
+			 *   Given enough deletions, and when we get to a user
+			 *   defined threshold (ie. a percentage of what SRAM can
+			 *   hold), we can pop back to using SRAM.
+			 */
+			uint32_t* cnt_ptr = CHOOSE_CNTR();
+
+			if ( *cnt_ptr <= nati_obj_ptr->back_to_sram_thresh
+				 &&
+				 ! nati_obj_ptr->hold_state )
+			{
+				/*
+				 * The following will focus us on SRAM and cause the copy
+				 * of data from DDR to SRAM.
+				 */
+				IPAINFO("Switch back to SRAM threshold has been reached -> "
+						"Total rules in DDR(%u) <= SRAM THRESH(%u)\n",
+						*cnt_ptr,
+						nati_obj_ptr->back_to_sram_thresh);
+
+				ret = ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_TBL_SWITCH, 0);
+
+				if ( ret == 0 )
+				{
+					SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_HYBRID);
+				}
+				else
+				{
+					/*
+					 * The following will force us stay in DDR for
+					 * now, but the next delete will trigger the
+					 * switch logic above to run again...perhaps it
+					 * will work then.
+					 */
+					ret = 0;
+				}
+			}
+		}
+	}
+
+step:
+	mig_step_after_rule_op(nati_obj_ptr);
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: _smAddRulesToTbl
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the addtion of a batch of NAT rules into
+ *   the DDR based table.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smAddRulesToTbl(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t** args = arb_data_ptr;
+
+	uint32_t           tbl_hdl    = (uint32_t)           args[0];
+	ipa_nat_ipv4_rule* clnt_rules = (ipa_nat_ipv4_rule*) args[1];
+	uint32_t           num_rules  = (uint32_t)           args[2];
+	uint32_t*          rule_hdls  = (uint32_t*)          args[3];
+	uint32_t*          num_added  = (uint32_t*)          args[4];
+
+	uint32_t* cnt_ptr;
+	uint32_t  i;
+
+	int ret;
+
+	IPADBG("In\n");
+
+	IPADBG("tbl_hdl(0x%08X) clnt_rules_ptr(%p) num_rules(%u) rule_hdls_ptr(%p)\n",
+		   tbl_hdl, clnt_rules, num_rules, rule_hdls);
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		clnt_rules[i].redirect = clnt_rules[i].enable = clnt_rules[i].time_stamp = 0;
+	}
+
+	ret = ipa_NATI_add_ipv4_rules(tbl_hdl, clnt_rules, num_rules, rule_hdls, num_added);
+
+	cnt_ptr = CHOOSE_CNTR();
+
+	(*cnt_ptr) += *num_added;
+
+	IPADBG("num_added value(%u)\n", *num_added);
+
+	IPADBG("Out\n");
+
+	return ret;
+}
+
+/******************************************************************************/
+/*
+ * FUNCTION: _smDelRulesFromTbl
+ *
+ * PARAMS:
+ *
+ *   nati_obj_ptr (IN) A pointer to an initialized nati object
+ *
+ *   trigger      (IN) The trigger to run through the state machine
+ *
+ *   arb_data_ptr (IN) Whatever you like
+ *
+ * DESCRIPTION:
+ *
+ *   The following will cause the deletion of a batch of NAT rules
+ *   from the DDR based table.
+ *
+ * RETURNS:
+ *
+ *   zero on success, otherwise non-zero
+ */
+static int _smDelRulesFromTbl(
+	ipa_nati_obj*    nati_obj_ptr,
+	ipa_nati_trigger trigger,
+	arb_t*           arb_data_ptr )
+{
+	arb_t**   args = arb_data_ptr;
+
+	uint32_t  tbl_hdl     = (uint32_t)  args[0];
+	uint32_t* rule_hdls   = (uint32_t*) args[1];
+	uint32_t  num_rules   = (uint32_t)  args[2];
+	uint32_t* num_deleted = (uint32_t*) args[3];
+
+	uint32_t* cnt_ptr;
+
+	int ret;
+
+	IPADBG("In\n");
+
+	IPADBG("tbl_hdl(0x%08X) rule_hdls_ptr(%p) num_rules(%u)\n",
+		   tbl_hdl, rule_hdls, num_rules);
+
+	ret = ipa_NATI_del_ipv4_rules(tbl_hdl, rule_hdls, num_rules, num_deleted);
+
+	cnt_ptr = CHOOSE_CNTR();
 
-		(*cnt_ptr)--;
-	}
+	(*cnt_ptr) -= *num_deleted;
+
+	IPADBG("num_deleted value(%u)\n", *num_deleted);
 
 	IPADBG("Out\n");
 
@@ -1656,7 +2785,7 @@ static int _smDelRuleFromTbl(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smAddRuleHybrid
+ * FUNCTION: _smAddRulesHybrid
  *
  * PARAMS:
  *
@@ -1668,109 +2797,106 @@ static int _smDelRuleFromTbl(
  *
  * DESCRIPTION:
  *
- *   The following will cause the addition of a NAT rule into either
- *   the SRAM or DDR based table.
- *
- *   *** !!! HOWEVER *** REMEMBER !!! ***
- *
- *   We're here because we're in a HYBRID state...with the potential
- *   moving between SRAM and DDR.  THIS HAS IMLICATIONS AS IT RELATES
- *   TO RULE MAPPING.
+ *   The batch version of _smAddRuleHybrid().  Should SRAM fill up
+ *   part way through the batch, the table switch happens and the
+ *   remainder of the batch goes to DDR.
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smAddRuleHybrid(
+static int _smAddRulesHybrid(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
 	arb_t** args = arb_data_ptr;
 
-	uint32_t           tbl_hdl   = (uint32_t)           args[0];
-	ipa_nat_ipv4_rule* clnt_rule = (ipa_nat_ipv4_rule*) args[1];
-	uint32_t*          rule_hdl  = (uint32_t*)          args[2];
+	uint32_t           tbl_hdl    = (uint32_t)           args[0];
+	ipa_nat_ipv4_rule* clnt_rules = (ipa_nat_ipv4_rule*) args[1];
+	uint32_t           num_rules  = (uint32_t)           args[2];
+	uint32_t*          rule_hdls  = (uint32_t*)          args[3];
+	uint32_t*          num_added  = (uint32_t*)          args[4];
 
 	arb_t*             new_args[] = {
 		(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
 		         tbl_hdl :
 		         nati_obj_ptr->ddr_tbl_hdl,
-		(arb_t*) clnt_rule,
-		(arb_t*) rule_hdl,
+		(arb_t*) clnt_rules,
+		(arb_t*)(arb_t)num_rules,
+		(arb_t*) rule_hdls,
+		(arb_t*) num_added,
 	};
 
 	uint32_t orig2new_map, new2orig_map;
 
-	int ret;
+	uint32_t i;
+
+	int ret, map_ret = 0;
 
 	IPADBG("In\n");
 
-	ret = _smAddRuleToTbl(nati_obj_ptr, trigger, new_args);
+	ret = _smAddRulesToTbl(nati_obj_ptr, trigger, new_args);
 
-	if ( ret == 0 )
-	{
-		/*
-		 * The rule_hdl is used to find a rule in the nat table.  It
-		 * is, in effect, an index into the table.  The applcation
-		 * above us retains it for future manipulation of the rule in
-		 * the table.
-		 *
-		 * In hybrid mode, a rule can and will move between SRAM and
-		 * DDR.  Because of this, its handle will change.  The
-		 * application has only the original handle and doesn't know
-		 * of the new handle.  A mapping, used in hybrid mode, will
-		 * maintain a relationship between the original handle and the
-		 * rule's current real handle...
-		 *
-		 * To help you get a mindset of how this is done:
-		 *
-		 *   The original handle will map (point) to the new and new
-		 *   handle will map (point) back to original.
-		 *
-		 * NOTE WELL: There are two sets of maps.  One for each memory
-		 *            type...
-		 */
-		CHOOSE_MAPS(orig2new_map, new2orig_map);
+	/*
+	 * See _smAddRuleHybrid() in re the mapping...
+	 */
+	CHOOSE_MAPS(orig2new_map, new2orig_map);
 
-		ret = ipa_nat_map_add(orig2new_map, *rule_hdl, *rule_hdl);
+	for ( i = 0; i < *num_added && map_ret == 0; i++ )
+	{
+		map_ret = ipa_nat_map_add(orig2new_map, rule_hdls[i], rule_hdls[i]);
 
-		if ( ret == 0 )
+		if ( map_ret == 0 )
 		{
-			ret = ipa_nat_map_add(new2orig_map, *rule_hdl, *rule_hdl);
+			map_ret = ipa_nat_map_add(new2orig_map, rule_hdls[i], rule_hdls[i]);
 		}
 	}
-	else
+
+	if ( map_ret )
 	{
-		if ( nati_obj_ptr->curr_state == NATI_STATE_HYBRID
-			 &&
-			 ! nati_obj_ptr->hold_state )
-		{
-			/*
-			 * In hybrid mode, we always start in SRAM...hence
-			 * NATI_STATE_HYBRID implies SRAM.  The rule addition
-			 * above did not work, meaning the SRAM table is full,
-			 * hence let's jump to DDR...
-			 *
-			 * The following will focus us on DDR and cause the copy
-			 * of data from SRAM to DDR.
-			 */
-			IPAINFO("Add of rule failed...attempting table switch\n");
+		ret = map_ret;
+	}
+	else if ( ret
+			  &&
+			  *num_added < num_rules
+			  &&
+			  nati_obj_ptr->curr_state == NATI_STATE_HYBRID
+			  &&
+			  ! nati_obj_ptr->hold_state )
+	{
+		uint32_t done = *num_added;
+		uint32_t more = 0;
+
+		arb_t*   rest_args[] = {
+			(arb_t*)(arb_t)tbl_hdl,
+			(arb_t*) (clnt_rules + done),
+			(arb_t*)(arb_t)(num_rules - done),
+			(arb_t*) (rule_hdls + done),
+			(arb_t*) &more,
+		};
 
-			ret = ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_TBL_SWITCH, 0);
+		/*
+		 * SRAM is full, hence let's jump to DDR and put the rest of
+		 * the batch there...
+		 */
+		IPAINFO("Add of rule %u of %u failed...attempting table switch\n",
+				done, num_rules);
 
-			if ( ret == 0 )
-			{
-				SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_HYBRID_DDR);
+		ret = ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_TBL_SWITCH, 0);
 
-				/*
-				 * Now add the rule to DDR...
-				 */
-				ret = ipa_nati_statemach(nati_obj_ptr, trigger, arb_data_ptr);
-			}
+		if ( ret == 0 )
+		{
+			SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_HYBRID_DDR);
+
+			ret = ipa_nati_statemach(nati_obj_ptr, trigger, rest_args);
+
+			*num_added = done + more;
 		}
 	}
 
+	mig_step_after_rule_op(nati_obj_ptr);
+
 	IPADBG("Out\n");
 
 	return ret;
@@ -1778,7 +2904,7 @@ static int _smAddRuleHybrid(
 
 /******************************************************************************/
 /*
- * FUNCTION: _smDelRuleHybrid
+ * FUNCTION: _smDelRulesHybrid
  *
  * PARAMS:
  *
@@ -1790,123 +2916,150 @@ static int _smAddRuleHybrid(
  *
  * DESCRIPTION:
  *
- *   The following will cause the deletion of a NAT rule from either
- *   the SRAM or DDR based table.
- *
- *   *** !!! HOWEVER *** REMEMBER !!! ***
- *
- *   We're here because we're in a HYBRID state...with the potential
- *   moving between SRAM and DDR.  THIS HAS IMLICATIONS AS IT RELATES
- *   TO RULE MAPPING.
+ *   The batch version of _smDelRuleHybrid().
  *
  * RETURNS:
  *
  *   zero on success, otherwise non-zero
  */
-static int _smDelRuleHybrid(
+static int _smDelRulesHybrid(
 	ipa_nati_obj*    nati_obj_ptr,
 	ipa_nati_trigger trigger,
 	arb_t*           arb_data_ptr )
 {
-	arb_t**  args = arb_data_ptr;
+	arb_t**   args = arb_data_ptr;
 
-	uint32_t tbl_hdl       = (uint32_t) args[0];
-	uint32_t orig_rule_hdl = (uint32_t) args[1];
+	uint32_t  tbl_hdl        = (uint32_t)  args[0];
+	uint32_t* orig_rule_hdls = (uint32_t*) args[1];
+	uint32_t  num_rules      = (uint32_t)  args[2];
+	uint32_t* num_deleted    = (uint32_t*) args[3];
 
-	uint32_t new_rule_hdl;
+	uint32_t* new_rule_hdls;
+	uint32_t  num_mapped;
 
-	uint32_t orig2new_map,  new2orig_map;
+	uint32_t  orig2new_map,  new2orig_map;
 
-	int      ret;
+	uint32_t  i;
+
+	int       ret = 0, del_ret;
 
 	IPADBG("In\n");
 
-	CHOOSE_MAPS(orig2new_map, new2orig_map);
+	*num_deleted = 0;
+
+	if ( num_rules == 0 )
+	{
+		goto bail;
+	}
+
+	if ( nati_obj_ptr->mig.active )
+	{
+		/*
+		 * While switching incrementally, the rules can be in either
+		 * table, hence go one at a time...
+		 */
+		for ( i = 0; i < num_rules; i++ )
+		{
+			arb_t* one_args[] = {
+				(arb_t*)(arb_t)tbl_hdl,
+				(arb_t*)(arb_t)orig_rule_hdls[i],
+			};
+
+			ret = _smDelRuleHybrid(nati_obj_ptr, NATI_TRIG_DEL_RULE, one_args);
+
+			if ( ret != 0 )
+			{
+				break;
+			}
+
+			(*num_deleted)++;
+		}
+
+		goto bail;
+	}
+
+	new_rule_hdls = calloc(num_rules, sizeof(uint32_t));
+
+	if ( new_rule_hdls == NULL )
+	{
+		IPAERR("Failed to allocate %u rule handles\n", num_rules);
+		ret = -ENOMEM;
+		goto bail;
+	}
 
 	/*
-	 * The rule_hdl is used to find a rule in the nat table.  It is,
-	 * in effect, an index into the table.  The applcation above us
-	 * retains it for future manipulation of the rule in the table.
-	 *
-	 * In hybrid mode, a rule can and will move between SRAM and DDR.
-	 * Because of this, its handle will change.  The application has
-	 * only the original handle and doesn't know of the new handle.  A
-	 * mapping, used in hybrid mode, will maintain a relationship
-	 * between the original handle and the rule's current real
-	 * handle...
-	 *
-	 * To help you get a mindset of how this is done:
-	 *
-	 *   The original handle will map (point) to the new and new
-	 *   handle will map (point) back to original.
-	 *
-	 * NOTE WELL: There are two sets of maps.  One for each memory
-	 *            type...
+	 * See _smDelRuleHybrid() in re the mapping...
 	 */
-	ret = ipa_nat_map_del(orig2new_map, orig_rule_hdl, &new_rule_hdl);
+	CHOOSE_MAPS(orig2new_map, new2orig_map);
+
+	for ( num_mapped = 0; num_mapped < num_rules; num_mapped++ )
+	{
+		ret = ipa_nat_map_find(
+			orig2new_map,
+			orig_rule_hdls[num_mapped],
+			&new_rule_hdls[num_mapped]);
+
+		if ( ret )
+		{
+			IPAERR("No mapping for orig_rule_hdl(0x%08X)\n",
+				   orig_rule_hdls[num_mapped]);
+			break;
+		}
+	}
 
-	if ( ret == 0 )
 	{
 		arb_t* new_args[]  = {
 			(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
 			        tbl_hdl :
 			        nati_obj_ptr->ddr_tbl_hdl,
-			(arb_t*)(arb_t)new_rule_hdl,
+			(arb_t*) new_rule_hdls,
+			(arb_t*)(arb_t)num_mapped,
+			(arb_t*) num_deleted,
 		};
 
-		IPADBG("orig_rule_hdl(0x%08X) -> new_rule_hdl(0x%08X)\n",
-			   orig_rule_hdl, new_rule_hdl);
+		del_ret = _smDelRulesFromTbl(nati_obj_ptr, trigger, new_args);
+	}
 
-		ipa_nat_map_del(new2orig_map, new_rule_hdl, NULL);
+	for ( i = 0; i < *num_deleted; i++ )
+	{
+		ipa_nat_map_del(orig2new_map, orig_rule_hdls[i], NULL);
+		ipa_nat_map_del(new2orig_map, new_rule_hdls[i], NULL);
+	}
 
-		ret = _smDelRuleFromTbl(nati_obj_ptr, trigger, new_args);
+	free(new_rule_hdls);
 
-		if ( ret == 0 && nati_obj_ptr->curr_state == NATI_STATE_HYBRID_DDR )
-		{
-			/*
-			 * We need to check when/if we can go back to SRAM.
-			 *
-			 * How/why can we go back?
-			 *
-			 *   Given enough deletions, and when we get to a user
-			 *   defined threshold (ie. a percentage of what SRAM can
-			 *   hold), we can pop back to using SRAM.
-			 */
-			uint32_t* cnt_ptr = CHOOSE_CNTR();
+	ret = (ret) ? ret : del_ret;
 
-			if ( *cnt_ptr <= nati_obj_ptr->back_to_sram_thresh
-				 &&
-				 ! nati_obj_ptr->hold_state )
-			{
-				/*
-				 * The following will focus us on SRAM and cause the copy
-				 * of data from DDR to SRAM.
-				 */
-				IPAINFO("Switch back to SRAM threshold has been reached -> "
-						"Total rules in DDR(%u) <= SRAM THRESH(%u)\n",
-						*cnt_ptr,
-						nati_obj_ptr->back_to_sram_thresh);
+	if ( *num_deleted
+		 &&
+		 nati_obj_ptr->curr_state == NATI_STATE_HYBRID_DDR
+		 &&
+		 ! nati_obj_ptr->mig.active )
+	{
+		/*
+		 * See _smDelRuleHybrid() in re going back to SRAM...
+		 */
+		uint32_t* cnt_ptr = CHOOSE_CNTR();
 
-				ret = ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_TBL_SWITCH, 0);
+		if ( *cnt_ptr <= nati_obj_ptr->back_to_sram_thresh
+			 &&
+			 ! nati_obj_ptr->hold_state )
+		{
+			IPAINFO("Switch back to SRAM threshold has been reached -> "
+					"Total rules in DDR(%u) <= SRAM THRESH(%u)\n",
+					*cnt_ptr,
+					nati_obj_ptr->back_to_sram_thresh);
 
-				if ( ret == 0 )
-				{
-					SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_HYBRID);
-				}
-				else
-				{
-					/*
-					 * The following will force us stay in DDR for
-					 * now, but the next delete will trigger the
-					 * switch logic above to run again...perhaps it
-					 * will work then.
-					 */
-					ret = 0;
-				}
+			if ( ipa_nati_statemach(nati_obj_ptr, NATI_TRIG_TBL_SWITCH, 0) == 0 )
+			{
+				SET_NATIOBJ_STATE(nati_obj_ptr, NATI_STATE_HYBRID);
 			}
 		}
 	}
 
+	mig_step_after_rule_op(nati_obj_ptr);
+
+bail:
 	IPADBG("Out\n");
 
 	return ret;
@@ -2038,6 +3191,24 @@ static int _smSwitchFromDdrToSram(
 
 	IPADBG("In\n");
 
+	if ( nati_obj_ptr->switch_chunk )
+	{
+		ret = switch_incrementally(nati_obj_ptr, NATI_TRIG_GOTO_SRAM, DDR_SUB);
+		goto bail;
+	}
+
+	/*
+	 * Moving all rules at once. If an incremental switch the other
+	 * way is still in progress, finish it first, since the table
+	 * about to be cleared below still holds some of the rules...
+	 */
+	ret = mig_step(nati_obj_ptr, 0);
+
+	if ( ret != 0 )
+	{
+		goto bail;
+	}
+
 	stats_ret = (collect_stats) ?
 		ipa_NATI_ipv4_tbl_stats(
 			nati_obj_ptr->ddr_tbl_hdl, &nat_stats, &idx_stats) :
@@ -2073,6 +3244,18 @@ static int _smSwitchFromDdrToSram(
 
 		currTimeAs(TimeAsNanSecs, &stop);
 
+		sw_stats_ptr->steps        = 1;
+		sw_stats_ptr->rules_total  = *cnt_ptr;
+		sw_stats_ptr->rules_moved  = *cnt_ptr;
+		sw_stats_ptr->rules_left   = 0;
+		sw_stats_ptr->switch_ns    = stop - start;
+		sw_stats_ptr->stall_ns     = stop - start;
+
+		if ( stop - start > sw_stats_ptr->max_stall_ns )
+		{
+			sw_stats_ptr->max_stall_ns = stop - start;
+		}
+
 		if ( ret == 0 )
 		{
 			sw_stats_ptr->pass += 1;
@@ -2161,6 +3344,7 @@ static int _smSwitchFromDdrToSram(
 		}
 	}
 
+bail:
 	IPADBG("Out\n");
 
 	return ret;
@@ -2208,6 +3392,24 @@ static int _smSwitchFromSramToDdr(
 
 	IPADBG("In\n");
 
+	if ( nati_obj_ptr->switch_chunk )
+	{
+		ret = switch_incrementally(nati_obj_ptr, NATI_TRIG_GOTO_DDR, SRAM_SUB);
+		goto bail;
+	}
+
+	/*
+	 * Moving all rules at once. If an incremental switch the other
+	 * way is still in progress, finish it first, since the table
+	 * about to be cleared below still holds some of the rules...
+	 */
+	ret = mig_step(nati_obj_ptr, 0);
+
+	if ( ret != 0 )
+	{
+		goto bail;
+	}
+
 	stats_ret = (collect_stats) ?
 		ipa_NATI_ipv4_tbl_stats(
 			nati_obj_ptr->sram_tbl_hdl, &nat_stats, &idx_stats) :
@@ -2243,6 +3445,18 @@ static int _smSwitchFromSramToDdr(
 
 		currTimeAs(TimeAsNanSecs, &stop);
 
+		sw_stats_ptr->steps        = 1;
+		sw_stats_ptr->rules_total  = *cnt_ptr;
+		sw_stats_ptr->rules_moved  = *cnt_ptr;
+		sw_stats_ptr->rules_left   = 0;
+		sw_stats_ptr->switch_ns    = stop - start;
+		sw_stats_ptr->stall_ns     = stop - start;
+
+		if ( stop - start > sw_stats_ptr->max_stall_ns )
+		{
+			sw_stats_ptr->max_stall_ns = stop - start;
+		}
+
 		if ( ret == 0 )
 		{
 			sw_stats_ptr->pass += 1;
@@ -2331,6 +3545,7 @@ static int _smSwitchFromSramToDdr(
 		}
 	}
 
+bail:
 	IPADBG("Out\n");
 
 	return ret;
@@ -2421,20 +3636,38 @@ static int _smGetTmStmpHybrid(
 
 	uint32_t  orig2new_map, new2orig_map;
 
+	uint32_t  src_sub;
+
+	uint32_t  rule_tbl_hdl =
+		(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
+		tbl_hdl :
+		nati_obj_ptr->ddr_tbl_hdl;
+
 	int       ret;
 
 	IPADBG("In\n");
 
 	CHOOSE_MAPS(orig2new_map, new2orig_map);
 
+	if ( nati_obj_ptr->mig.active
+		 &&
+		 ! ipa_nat_map_contains(orig2new_map, orig_rule_hdl) )
+	{
+		/*
+		 * Not moved yet by the switch in progress...
+		 */
+		src_sub = nati_obj_ptr->mig.src_sub;
+
+		orig2new_map = nati_obj_ptr->map_pairs[src_sub].orig2new_map;
+		rule_tbl_hdl = SUB_TBL_HDL(src_sub);
+	}
+
 	ret = ipa_nat_map_find(orig2new_map, orig_rule_hdl, &new_rule_hdl);
 
 	if ( ret == 0 )
 	{
 		arb_t* new_args[] = {
-			(arb_t*)(arb_t)(nati_obj_ptr->curr_state == NATI_STATE_HYBRID) ?
-			         tbl_hdl :
-			         nati_obj_ptr->ddr_tbl_hdl,
+			(arb_t*)(arb_t)rule_tbl_hdl,
 			(arb_t*)(arb_t)new_rule_hdl,
 			(arb_t*) time_stamp,
 		};
@@ -2468,6 +3701,8 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_GOTO_DDR,   _smUndef ),
 		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_GOTO_SRAM,  _smUndef ),
 		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_GET_TSTAMP, _smUndef ),
+		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_ADD_RULES,  _smUndef ),
+		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_DEL_RULES,  _smUndef ),
 		SM_ROW( NATI_STATE_NULL,       NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2484,6 +3719,8 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_GOTO_DDR,   _smUndef ),
 		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_GOTO_SRAM,  _smUndef ),
 		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_GET_TSTAMP, _smGetTmStmp ),
+		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_ADD_RULES,  _smAddRulesToTbl ),
+		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_DEL_RULES,  _smDelRulesFromTbl ),
 		SM_ROW( NATI_STATE_DDR_ONLY,   NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2500,6 +3737,8 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_GOTO_DDR,   _smUndef ),
 		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_GOTO_SRAM,  _smUndef ),
 		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_GET_TSTAMP, _smGetTmStmp ),
+		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_ADD_RULES,  _smAddRulesToTbl ),
+		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_DEL_RULES,  _smDelRulesFromTbl ),
 		SM_ROW( NATI_STATE_SRAM_ONLY,  NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2516,6 +3755,8 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_GOTO_DDR,   _smGoToDdr ),
 		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_GOTO_SRAM,  _smGoToSram ),
 		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_GET_TSTAMP, _smGetTmStmpHybrid ),
+		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_ADD_RULES,  _smAddRulesHybrid ),
+		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_DEL_RULES,  _smDelRulesHybrid ),
 		SM_ROW( NATI_STATE_HYBRID,     NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2532,6 +3773,8 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_GOTO_DDR,   _smGoToDdr ),
 		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_GOTO_SRAM,  _smGoToSram ),
 		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_GET_TSTAMP, _smGetTmStmpHybrid ),
+		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_ADD_RULES,  _smAddRulesHybrid ),
+		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_DEL_RULES,  _smDelRulesHybrid ),
 		SM_ROW( NATI_STATE_HYBRID_DDR, NATI_TRIG_LAST,       _smUndef ),
 	},
 
@@ -2548,6 +3791,8 @@ _state_mach_tbl[NATI_STATE_LAST+1][NATI_TRIG_LAST+1] =
 		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_GOTO_DDR,   _smUndef ),
 		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_GOTO_SRAM,  _smUndef ),
 		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_GET_TSTAMP, _smUndef ),
+		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_ADD_RULES,  _smUndef ),
+		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_DEL_RULES,  _smUndef ),
 		SM_ROW( NATI_STATE_LAST,       NATI_TRIG_LAST,       _smUndef ),
 	},
 };
@@ -0,0 +1,845 @@
+/*
+ * Copyright (c) 2019 The Linux Foundation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of The Linux Foundation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+ * IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*=========================================================================*/
+/*!
+	@file
+	ipa_nat_hash_sim.c
+
+	@brief
+	Host-side simulation of how a flow trace spreads over an IPv4 NAT
+	table, per hash function.
+
+	Each flow is put in a NAT table (at its dst hash) and a NAT index
+	table (at its src hash) laid out the way ipa_table.c does it:
+
+	  o the base and expansion table sizes come from
+	    ipa_table_calculate_entries_num() for the memory type,
+	  o a hash of zero uses the last base slot,
+	  o on collision, the first empty expansion slot is appended to
+	    the tail of the base slot's list.
+
+	Reported per hash and table are the chain length distribution,
+	the number of records probed to find each flow (ie. its position
+	in its list) and the flows that did not fit.
+
+	The "hw" hash is the library's own (see ipa_nati_dst_hash() and
+	ipa_nati_src_hash()), ie. what the IPA computes for the h/w
+	version given. The others are candidate mixes for evaluation
+	only: the IPA does not compute them, so a table can't use them.
+
+	Run thusly:
+
+	# ipanathashsim [-v ver] [-m mt] [-e N] [-t trace]
+	                [-f N] [-c N] [-s N] [-p ip] [-r seed]
+
+	Where:
+	  -v ver   IPA h/w version, eg. 3.5.1 or 4.5 (default 4.5)
+	  -m mt    DDR or SRAM sizing (default DDR)
+	  -e N     Number of table entries (default 4096)
+	  -t trace Replay the flows in file trace, one per line:
+	             proto private_ip private_port target_ip target_port [public_port]
+	           with proto tcp, udp or a number, and '#' starting a
+	           comment. Without a public_port, one is allocated.
+	  -f N     Number of synthetic flows, when no trace (default -e / 2)
+	  -c N     Synthetic clients, all in one /24 (default 64)
+	  -s N     Synthetic servers, all in one /24 (default 16)
+	  -p ip    Public ip (default 10.0.0.1)
+	  -r seed  Random seed for the synthetic flows (default 1)
+*/
+/*=========================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include "ipa_nat_drv.h"
+#include "ipa_nat_drvi.h"
+
+#undef  array_sz
+#define array_sz(a) \
+	( sizeof(a)/sizeof(a[0]) )
+
+#undef  SIM_NUM_BUCKETS
+#define SIM_NUM_BUCKETS 7
+
+#undef  SIM_FIRST_PUBLIC_PORT
+#define SIM_FIRST_PUBLIC_PORT 1024
+
+typedef struct
+{
+	uint8_t  proto;
+	uint32_t private_ip;
+	uint16_t private_port;
+	uint32_t target_ip;
+	uint16_t target_port;
+	uint16_t public_port;
+} sim_flow;
+
+typedef struct
+{
+	const char*      name;
+	uint16_t       (*dst)(enum ipa_hw_type, uint32_t, const sim_flow*, uint16_t);
+	uint16_t       (*src)(enum ipa_hw_type, uint32_t, const sim_flow*, uint16_t);
+} sim_hash;
+
+/*
+ * A table laid out as per ipa_table.c, keeping only the list links
+ */
+typedef struct
+{
+	const char* name;
+	uint16_t    table_entries;
+	uint16_t    expn_table_entries;
+	uint16_t*   next_index;
+	uint8_t*    in_use;
+	uint16_t    next_expn_hint;
+	uint32_t    filled;
+	uint32_t    expn_filled;
+	uint32_t    fails;
+	uint64_t    tot_probes;
+	uint32_t    max_probes;
+} sim_table;
+
+static const struct
+{
+	const char*      name;
+	enum ipa_hw_type ver;
+} hw_versions[] = {
+	{ "3.0",   IPA_HW_v3_0   },
+	{ "3.1",   IPA_HW_v3_1   },
+	{ "3.5",   IPA_HW_v3_5   },
+	{ "3.5.1", IPA_HW_v3_5_1 },
+	{ "4.0",   IPA_HW_v4_0   },
+	{ "4.1",   IPA_HW_v4_1   },
+	{ "4.2",   IPA_HW_v4_2   },
+	{ "4.5",   IPA_HW_v4_5   },
+	{ "4.7",   IPA_HW_v4_7   },
+	{ "4.9",   IPA_HW_v4_9   },
+	{ "4.11",  IPA_HW_v4_11  },
+	{ "5.0",   IPA_HW_v5_0   },
+	{ "5.1",   IPA_HW_v5_1   },
+	{ "5.2",   IPA_HW_v5_2   },
+	{ "5.5",   IPA_HW_v5_5   },
+	{ "6.0",   IPA_HW_v6_0   },
+};
+
+static const char* bucket_names[SIM_NUM_BUCKETS] = {
+	"1", "2", "3", "4", "5-8", "9-16", "17+"
+};
+
+/*
+ * As the library does with a hash's result...
+ */
+static uint16_t fit_to_table(
+	uint32_t hash,
+	uint16_t size )
+{
+	uint16_t idx = (uint16_t) (hash & size);
+
+	return ( idx ) ? idx : size;
+}
+
+static inline uint16_t swap16(
+	uint16_t v )
+{
+	return (uint16_t) ((v << 8) | (v >> 8));
+}
+
+static inline uint32_t fmix32(
+	uint32_t h )
+{
+	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+
+	return h;
+}
+
+static inline uint32_t fnv1a32(
+	uint32_t h,
+	uint32_t v,
+	int      num_bytes )
+{
+	while ( num_bytes-- )
+	{
+		h ^= v & 0xFF;
+		h *= 0x01000193;
+		v >>= 8;
+	}
+
+	return h;
+}
+
+/*
+ * hw: the library's (ie. the IPA's) hashes
+ */
+static uint16_t hw_dst(
+	enum ipa_hw_type ver,
+	uint32_t         public_ip,
+	const sim_flow*  f,
+	uint16_t         size )
+{
+	return ipa_nati_dst_hash(
+		ver, public_ip, f->target_ip, f->target_port, f->public_port,
+		f->proto, size);
+}
+
+static uint16_t hw_src(
+	enum ipa_hw_type ver,
+	uint32_t         public_ip,
+	const sim_flow*  f,
+	uint16_t         size )
+{
+	return ipa_nati_src_hash(
+		f->private_ip, f->private_port, f->target_ip, f->target_port,
+		f->proto, size);
+}
+
+/*
+ * swapxor: the h/w's xor of 16 bit halves, but with some halves byte
+ * swapped first, so that the bytes that vary most (eg. the host part
+ * of addresses sharing a /24) don't all land on the same bits
+ */
+static uint16_t swapxor_dst(
+	enum ipa_hw_type ver,
+	uint32_t         public_ip,
+	const sim_flow*  f,
+	uint16_t         size )
+{
+	uint16_t hash =
+		((uint16_t)(f->target_ip))             ^
+		swap16((uint16_t)(f->target_ip >> 16)) ^
+		(f->target_port)                       ^
+		(f->public_port)                       ^
+		(f->proto)                             ^
+		swap16((uint16_t)(public_ip))          ^
+		((uint16_t)(public_ip >> 16));
+
+	return fit_to_table(hash, size);
+}
+
+static uint16_t swapxor_src(
+	enum ipa_hw_type ver,
+	uint32_t         public_ip,
+	const sim_flow*  f,
+	uint16_t         size )
+{
+	uint16_t hash =
+		((uint16_t)(f->private_ip))             ^
+		swap16((uint16_t)(f->private_ip >> 16)) ^
+		(f->private_port)                       ^
+		swap16((uint16_t)(f->target_ip))        ^
+		((uint16_t)(f->target_ip >> 16))        ^
+		swap16(f->target_port)                  ^
+		(f->proto);
+
+	return fit_to_table(hash, size);
+}
+
+/*
+ * fnv1a: FNV-1a over the tuple's bytes, folded to 16 bits
+ */
+static uint16_t fnv1a_dst(
+	enum ipa_hw_type ver,
+	uint32_t         public_ip,
+	const sim_flow*  f,
+	uint16_t         size )
+{
+	uint32_t h = 0x811c9dc5;
+
+	h = fnv1a32(h, public_ip,      4);
+	h = fnv1a32(h, f->target_ip,   4);
+	h = fnv1a32(h, f->target_port, 2);
+	h = fnv1a32(h, f->public_port, 2);
+	h = fnv1a32(h, f->proto,       1);
+
+	return fit_to_table(h ^ (h >> 16), size);
+}
+
+static uint16_t fnv1a_src(
+	enum ipa_hw_type ver,
+	uint32_t         public_ip,
+	const sim_flow*  f,
+	uint16_t         size )
+{
+	uint32_t h = 0x811c9dc5;
+
+	h = fnv1a32(h, f->private_ip,   4);
+	h = fnv1a32(h, f->private_port, 2);
+	h = fnv1a32(h, f->target_ip,    4);
+	h = fnv1a32(h, f->target_port,  2);
+	h = fnv1a32(h, f->proto,        1);
+
+	return fit_to_table(h ^ (h >> 16), size);
+}
+
+/*
+ * murmur: the murmur3 finalizer, chained over the tuple's words
+ */
+static uint16_t murmur_dst(
+	enum ipa_hw_type ver,
+	uint32_t         public_ip,
+	const sim_flow*  f,
+	uint16_t         size )
+{
+	uint32_t h;
+
+	h = fmix32(public_ip ^ 0x9e3779b9);
+	h = fmix32(h ^ f->target_ip);
+	h = fmix32(h ^ (((uint32_t) f->target_port << 16) | f->public_port));
+	h = fmix32(h ^ f->proto);
+
+	return fit_to_table(h ^ (h >> 16), size);
+}
+
+static uint16_t murmur_src(
+	enum ipa_hw_type ver,
+	uint32_t         public_ip,
+	const sim_flow*  f,
+	uint16_t         size )
+{
+	uint32_t h;
+
+	h = fmix32(f->private_ip ^ 0x9e3779b9);
+	h = fmix32(h ^ f->target_ip);
+	h = fmix32(h ^ (((uint32_t) f->private_port << 16) | f->target_port));
+	h = fmix32(h ^ f->proto);
+
+	return fit_to_table(h ^ (h >> 16), size);
+}
+
+static const sim_hash hashes[] = {
+	{ "hw",      hw_dst,      hw_src      },
+	{ "swapxor", swapxor_dst, swapxor_src },
+	{ "fnv1a",   fnv1a_dst,   fnv1a_src   },
+	{ "murmur",  murmur_dst,  murmur_src  },
+};
+
+static int sim_table_init(
+	sim_table*           st,
+	const char*          name,
+	uint16_t             number_of_entries,
+	enum ipa3_nat_mem_in nmi )
+{
+	ipa_table tbl;
+	uint32_t  tot;
+
+	memset(&tbl, 0, sizeof(tbl));
+	memset(st, 0, sizeof(*st));
+
+	strlcpy(tbl.name, name, IPA_RESOURCE_NAME_MAX);
+
+	if ( ipa_table_calculate_entries_num(&tbl, number_of_entries, nmi) )
+	{
+		return -1;
+	}
+
+	st->name               = name;
+	st->table_entries      = tbl.table_entries;
+	st->expn_table_entries = tbl.expn_table_entries;
+
+	tot = st->table_entries + st->expn_table_entries;
+
+	st->next_index = calloc(tot, sizeof(*st->next_index));
+	st->in_use     = calloc(tot, sizeof(*st->in_use));
+
+	if ( ! st->next_index || ! st->in_use )
+	{
+		IPAERR("Unable to allocate %u entries for %s\n", tot, name);
+		return -1;
+	}
+
+	st->next_expn_hint = st->table_entries;
+
+	return 0;
+}
+
+static void sim_table_free(
+	sim_table* st )
+{
+	free(st->next_index);
+	free(st->in_use);
+}
+
+/*
+ * Mirrors ipa_table_add_entry(): head insert when the base slot is
+ * free, otherwise append the first empty expansion slot to the list
+ */
+static void sim_table_add(
+	sim_table* st,
+	uint16_t   index )
+{
+	uint32_t tot = st->table_entries + st->expn_table_entries;
+	uint32_t probes = 1;
+	uint16_t i;
+
+	if ( ! st->in_use[index] )
+	{
+		st->in_use[index] = 1;
+		st->filled++;
+	}
+	else
+	{
+		while ( st->next_index[index] )
+		{
+			index = st->next_index[index];
+			probes++;
+		}
+
+		/*
+		 * Only adds, hence no expansion slot before the hint frees
+		 * up...
+		 */
+		for ( i = st->next_expn_hint; i < tot && st->in_use[i]; i++ );
+
+		if ( i >= tot )
+		{
+			st->fails++;
+			return;
+		}
+
+		st->next_expn_hint = i + 1;
+
+		st->in_use[i]            = 1;
+		st->next_index[index]    = i;
+		st->expn_filled++;
+
+		probes++;
+	}
+
+	st->tot_probes += probes;
+
+	if ( probes > st->max_probes )
+	{
+		st->max_probes = probes;
+	}
+}
+
+static unsigned chain_bucket(
+	uint32_t len )
+{
+	if ( len <= 4 )  return len - 1;
+	if ( len <= 8 )  return 4;
+	if ( len <= 16 ) return 5;
+
+	return 6;
+}
+
+static void sim_table_report(
+	const sim_hash*  sh,
+	const sim_table* st )
+{
+	uint32_t buckets[SIM_NUM_BUCKETS];
+	uint32_t i, len, max_len = 0, stored;
+	uint16_t idx;
+
+	memset(buckets, 0, sizeof(buckets));
+
+	for ( i = 1; i < st->table_entries; i++ )
+	{
+		if ( ! st->in_use[i] )
+		{
+			continue;
+		}
+
+		for ( len = 1, idx = st->next_index[i]; idx; idx = st->next_index[idx] )
+		{
+			len++;
+		}
+
+		buckets[chain_bucket(len)]++;
+
+		if ( len > max_len )
+		{
+			max_len = len;
+		}
+	}
+
+	stored = st->filled + st->expn_filled;
+
+	printf("  %-8s %-5s base(%5u/%5u) expn(%5u/%5u) fails(%5u) "
+		   "max_chain(%3u) probes avg(%5.2f) max(%3u) chains:",
+		   sh->name,
+		   st->name,
+		   st->filled, st->table_entries,
+		   st->expn_filled, st->expn_table_entries,
+		   st->fails,
+		   max_len,
+		   (stored) ? (double) st->tot_probes / stored : 0.0,
+		   st->max_probes);
+
+	for ( i = 0; i < SIM_NUM_BUCKETS; i++ )
+	{
+		printf(" %s:%u", bucket_names[i], buckets[i]);
+	}
+
+	printf("\n");
+}
+
+static int parse_ip(
+	const char* str,
+	uint32_t*   ip_ptr )
+{
+	struct in_addr addr;
+
+	if ( inet_pton(AF_INET, str, &addr) != 1 )
+	{
+		return -1;
+	}
+
+	*ip_ptr = ntohl(addr.s_addr);
+
+	return 0;
+}
+
+static int parse_proto(
+	const char* str,
+	uint8_t*    proto_ptr )
+{
+	if ( ! strcasecmp(str, "tcp") )
+	{
+		*proto_ptr = IPPROTO_TCP;
+	}
+	else if ( ! strcasecmp(str, "udp") )
+	{
+		*proto_ptr = IPPROTO_UDP;
+	}
+	else
+	{
+		*proto_ptr = (uint8_t) atoi(str);
+	}
+
+	return ( *proto_ptr ) ? 0 : -1;
+}
+
+static int load_trace(
+	const char* path,
+	sim_flow**  flows_ptr,
+	uint32_t*   num_flows_ptr )
+{
+	char      line[256], proto[16], pip[64], tip[64];
+	unsigned  pport, tport, pubport;
+	uint32_t  num = 0, max = 0, line_num = 0;
+	uint16_t  next_public_port = SIM_FIRST_PUBLIC_PORT;
+	sim_flow* flows = NULL;
+	FILE*     fp;
+	int       n, ret = 0;
+
+	if ( ! (fp = fopen(path, "r")) )
+	{
+		IPAERR("Unable to open %s\n", path);
+		return -1;
+	}
+
+	while ( fgets(line, sizeof(line), fp) )
+	{
+		char* cp = strchr(line, '#');
+
+		line_num++;
+
+		if ( cp )
+		{
+			*cp = '\0';
+		}
+
+		pubport = 0;
+
+		n = sscanf(line, "%15s %63s %u %63s %u %u",
+				   proto, pip, &pport, tip, &tport, &pubport);
+
+		if ( n <= 0 )
+		{
+			continue;
+		}
+
+		if ( num == max )
+		{
+			sim_flow* tmp;
+
+			max = ( max ) ? max * 2 : 1024;
+
+			if ( ! (tmp = realloc(flows, max * sizeof(*flows))) )
+			{
+				IPAERR("Unable to allocate %u flows\n", max);
+				ret = -1;
+				break;
+			}
+
+			flows = tmp;
+		}
+
+		if ( n < 5 ||
+			 parse_proto(proto, &flows[num].proto) ||
+			 parse_ip(pip, &flows[num].private_ip) ||
+			 parse_ip(tip, &flows[num].target_ip) )
+		{
+			IPAERR("%s:%u: malformed flow\n", path, line_num);
+			ret = -1;
+			break;
+		}
+
+		flows[num].private_port = (uint16_t) pport;
+		flows[num].target_port  = (uint16_t) tport;
+		flows[num].public_port  =
+			( pubport ) ? (uint16_t) pubport : next_public_port++;
+
+		num++;
+	}
+
+	fclose(fp);
+
+	if ( ret )
+	{
+		free(flows);
+		return ret;
+	}
+
+	*flows_ptr     = flows;
+	*num_flows_ptr = num;
+
+	return 0;
+}
+
+/*
+ * The troublesome case: a handful of clients, sharing a /24, talking
+ * to a handful of servers, sharing a /24, mostly on the same port
+ */
+static int make_flows(
+	uint32_t   num_flows,
+	uint32_t   num_clients,
+	uint32_t   num_servers,
+	sim_flow** flows_ptr )
+{
+	static const uint16_t target_ports[] = { 443, 443, 443, 80, 53 };
+
+	sim_flow* flows;
+	uint32_t  i;
+
+	if ( ! num_clients || num_clients > 254 || ! num_servers || num_servers > 254 )
+	{
+		IPAERR("Bad arg: clients(%u) and/or servers(%u) not in 1..254\n",
+			   num_clients, num_servers);
+		return -1;
+	}
+
+	if ( ! (flows = calloc(num_flows, sizeof(*flows))) )
+	{
+		IPAERR("Unable to allocate %u flows\n", num_flows);
+		return -1;
+	}
+
+	for ( i = 0; i < num_flows; i++ )
+	{
+		flows[i].target_port  = target_ports[rand() % array_sz(target_ports)];
+		flows[i].proto        =
+			( flows[i].target_port == 53 ) ? IPPROTO_UDP : IPPROTO_TCP;
+		flows[i].private_ip   = 0xC0A8E100 + 1 + (rand() % num_clients); /* 192.168.225.0/24 */
+		flows[i].private_port = 32768 + (rand() % 28232);
+		flows[i].target_ip    = 0x8EFAB400 + 1 + (rand() % num_servers); /* 142.250.180.0/24 */
+		flows[i].public_port  = SIM_FIRST_PUBLIC_PORT + i;
+	}
+
+	*flows_ptr = flows;
+
+	return 0;
+}
+
+static int simulate(
+	const sim_hash*      sh,
+	enum ipa_hw_type     ver,
+	enum ipa3_nat_mem_in nmi,
+	uint16_t             number_of_entries,
+	uint32_t             public_ip,
+	const sim_flow*      flows,
+	uint32_t             num_flows )
+{
+	sim_table nat, idx;
+	uint32_t  i;
+	int       ret = -1;
+
+	if ( sim_table_init(&nat, "nat", number_of_entries, nmi) ||
+		 sim_table_init(&idx, "index", number_of_entries, nmi) )
+	{
+		goto bail;
+	}
+
+	for ( i = 0; i < num_flows; i++ )
+	{
+		sim_table_add(&nat, sh->dst(ver, public_ip, &flows[i], nat.table_entries - 1));
+		sim_table_add(&idx, sh->src(ver, public_ip, &flows[i], idx.table_entries - 1));
+	}
+
+	sim_table_report(sh, &nat);
+	sim_table_report(sh, &idx);
+
+	ret = 0;
+
+bail:
+	sim_table_free(&nat);
+	sim_table_free(&idx);
+
+	return ret;
+}
+
+static void usage(
+	const char* prog )
+{
+	printf("Usage: %s [-v ver] [-m DDR|SRAM] [-e N] [-t trace] "
+		   "[-f N] [-c N] [-s N] [-p ip] [-r seed]\n", prog);
+}
+
+int main(
+	int   argc,
+	char* argv[] )
+{
+	const char*          ver_name    = "4.5";
+	enum ipa_hw_type     ver         = IPA_HW_None;
+	enum ipa3_nat_mem_in nmi         = IPA_NAT_MEM_IN_DDR;
+	uint32_t             entries     = 4096;
+	uint32_t             num_flows   = 0;
+	uint32_t             num_clients = 64;
+	uint32_t             num_servers = 16;
+	uint32_t             public_ip   = 0x0A000001;
+	unsigned             seed        = 1;
+	const char*          trace       = NULL;
+	sim_flow*            flows       = NULL;
+	uint32_t             i;
+	int                  c, ret = 0;
+
+	while ( (c = getopt(argc, argv, "v:m:e:t:f:c:s:p:r:?")) != -1 )
+	{
+		switch ( c )
+		{
+		case 'v':
+			ver_name = optarg;
+			break;
+		case 'm':
+			if ( ! strcasecmp(optarg, "DDR") )
+			{
+				nmi = IPA_NAT_MEM_IN_DDR;
+			}
+			else if ( ! strcasecmp(optarg, "SRAM") )
+			{
+				nmi = IPA_NAT_MEM_IN_SRAM;
+			}
+			else
+			{
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 'e':
+			entries = atoi(optarg);
+			break;
+		case 't':
+			trace = optarg;
+			break;
+		case 'f':
+			num_flows = atoi(optarg);
+			break;
+		case 'c':
+			num_clients = atoi(optarg);
+			break;
+		case 's':
+			num_servers = atoi(optarg);
+			break;
+		case 'p':
+			if ( parse_ip(optarg, &public_ip) )
+			{
+				usage(argv[0]);
+				return 1;
+			}
+			break;
+		case 'r':
+			seed = atoi(optarg);
+			break;
+		default:
+			usage(argv[0]);
+			return 0;
+		}
+	}
+
+	for ( i = 0; i < array_sz(hw_versions); i++ )
+	{
+		if ( ! strcmp(ver_name, hw_versions[i].name) )
+		{
+			ver = hw_versions[i].ver;
+			break;
+		}
+	}
+
+	if ( ver == IPA_HW_None || entries == 0 || entries > IPA_TABLE_MAX_ENTRIES )
+	{
+		IPAERR("Bad arg: ver(%s) and/or entries(%u)\n", ver_name, entries);
+		return 1;
+	}
+
+	if ( trace )
+	{
+		ret = load_trace(trace, &flows, &num_flows);
+	}
+	else
+	{
+		srand(seed);
+
+		num_flows = ( num_flows ) ? num_flows : entries / 2;
+
+		ret = make_flows(num_flows, num_clients, num_servers, &flows);
+	}
+
+	if ( ret )
+	{
+		return 1;
+	}
+
+	printf("%u flows into a %s table of %u entries, IPA h/w v%s: "
+		   "hw hash %s the public ip\n",
+		   num_flows,
+		   ( nmi == IPA_NAT_MEM_IN_SRAM ) ? "SRAM" : "DDR",
+		   entries,
+		   ver_name,
+		   ( ver >= IPA_HW_v4_0 ) ? "includes" : "excludes");
+
+	for ( i = 0; i < array_sz(hashes) && ret == 0; i++ )
+	{
+		ret = simulate(&hashes[i], ver, nmi, entries, public_ip, flows, num_flows);
+	}
+
+	printf("Only hw is what the IPA computes; the others are for evaluation only\n");
+
+	free(flows);
+
+	return ( ret ) ? 1 : 0;
+}
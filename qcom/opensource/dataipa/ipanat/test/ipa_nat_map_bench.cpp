@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2019 The Linux Foundation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of The Linux Foundation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+ * IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*=========================================================================*/
+/*!
+	@file
+	ipa_nat_map_bench.cpp
+
+	@brief
+	Micro-benchmark of the rule handle maps (see ipa_nat_map.cpp)
+	against the std::map they replaced, using the access pattern of
+	a DDR<->SRAM migration: add every handle, look every handle up,
+	then delete every handle.
+
+	Run thusly:
+
+	# ipanatmapbench [-n N] [-i N]
+
+	Where -n is the number of keys (default 65536, ie. a 64K entry
+	table) and -i the number of iterations (default 10).
+*/
+/*=========================================================================*/
+
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+
+extern "C"
+{
+#include "ipa_nat_utils.h"
+}
+
+#include "ipa_nat_map.h"
+
+#define BENCH_MAP MAP_NUM_99
+
+typedef struct
+{
+	const char* name;
+	uint64_t    add_ns;
+	uint64_t    find_ns;
+	uint64_t    del_ns;
+} bench_result;
+
+static uint64_t now_ns(void)
+{
+	uint64_t t = 0;
+
+	currTimeAs(TimeAsNanSecs, &t);
+
+	return t;
+}
+
+/*
+ * Rule handles are allocated per table slot, so they are small and
+ * dense; looking them up happens in table walk order, which relative
+ * to the allocation order is effectively random.
+ */
+static void make_keys(
+	std::vector<uint32_t>& keys,
+	std::vector<uint32_t>& order,
+	uint32_t               num_keys )
+{
+	uint32_t i;
+
+	keys.resize(num_keys);
+	order.resize(num_keys);
+
+	for ( i = 0; i < num_keys; i++ )
+	{
+		keys[i]  = i + 1;
+		order[i] = i + 1;
+	}
+
+	srand(num_keys);
+
+	for ( i = num_keys - 1; i > 0; i-- )
+	{
+		std::swap(order[i], order[rand() % (i + 1)]);
+	}
+}
+
+static int bench_std_map(
+	const std::vector<uint32_t>& keys,
+	const std::vector<uint32_t>& order,
+	bench_result*                res )
+{
+	std::map<uint32_t, uint32_t>           m;
+	std::map<uint32_t, uint32_t>::iterator it;
+
+	uint64_t t;
+	uint32_t i;
+
+	t = now_ns();
+	for ( i = 0; i < keys.size(); i++ )
+	{
+		m.insert(std::pair<uint32_t, uint32_t>(keys[i], ~keys[i]));
+	}
+	res->add_ns += now_ns() - t;
+
+	t = now_ns();
+	for ( i = 0; i < order.size(); i++ )
+	{
+		it = m.find(order[i]);
+
+		if ( it == m.end() || it->second != ~order[i] )
+		{
+			IPAERR("std::map lookup of key(%u) failed\n", order[i]);
+			return -1;
+		}
+	}
+	res->find_ns += now_ns() - t;
+
+	t = now_ns();
+	for ( i = 0; i < order.size(); i++ )
+	{
+		m.erase(order[i]);
+	}
+	res->del_ns += now_ns() - t;
+
+	return m.empty() ? 0 : -1;
+}
+
+static int bench_nat_map(
+	const std::vector<uint32_t>& keys,
+	const std::vector<uint32_t>& order,
+	bench_result*                res )
+{
+	uint64_t t;
+	uint32_t i, val;
+
+	/*
+	 * As done on table creation...
+	 */
+	if ( ipa_nat_map_reserve(BENCH_MAP, keys.size()) )
+	{
+		return -1;
+	}
+
+	t = now_ns();
+	for ( i = 0; i < keys.size(); i++ )
+	{
+		if ( ipa_nat_map_add(BENCH_MAP, keys[i], ~keys[i]) )
+		{
+			return -1;
+		}
+	}
+	res->add_ns += now_ns() - t;
+
+	t = now_ns();
+	for ( i = 0; i < order.size(); i++ )
+	{
+		if ( ipa_nat_map_find(BENCH_MAP, order[i], &val) || val != ~order[i] )
+		{
+			IPAERR("nat map lookup of key(%u) failed\n", order[i]);
+			return -1;
+		}
+	}
+	res->find_ns += now_ns() - t;
+
+	t = now_ns();
+	for ( i = 0; i < order.size(); i++ )
+	{
+		if ( ipa_nat_map_del(BENCH_MAP, order[i], NULL) )
+		{
+			return -1;
+		}
+	}
+	res->del_ns += now_ns() - t;
+
+	return 0;
+}
+
+static void print_result(
+	const bench_result* res,
+	uint32_t            num_ops )
+{
+	printf("  %-12s add(%6.1f ns/op) find(%6.1f ns/op) del(%6.1f ns/op)\n",
+		   res->name,
+		   (double) res->add_ns  / num_ops,
+		   (double) res->find_ns / num_ops,
+		   (double) res->del_ns  / num_ops);
+}
+
+int main(
+	int   argc,
+	char* argv[] )
+{
+	std::vector<uint32_t> keys, order;
+
+	bench_result std_res = { "std::map",    0, 0, 0 };
+	bench_result nat_res = { "ipa_nat_map", 0, 0, 0 };
+
+	uint32_t num_keys = 65536;
+	uint32_t iters    = 10;
+	uint32_t i;
+
+	int c;
+
+	while ( (c = getopt(argc, argv, "n:i:?")) != -1 )
+	{
+		switch ( c )
+		{
+		case 'n':
+			num_keys = atoi(optarg);
+			break;
+		case 'i':
+			iters = atoi(optarg);
+			break;
+		default:
+			printf("Usage: %s [-n num_keys] [-i iterations]\n", argv[0]);
+			return 0;
+		}
+	}
+
+	if ( num_keys == 0 || iters == 0 )
+	{
+		IPAERR("Bad arg num_keys(%u) iters(%u)\n", num_keys, iters);
+		return 1;
+	}
+
+	make_keys(keys, order, num_keys);
+
+	for ( i = 0; i < iters; i++ )
+	{
+		if ( bench_std_map(keys, order, &std_res) ||
+			 bench_nat_map(keys, order, &nat_res) )
+		{
+			IPAERR("Benchmark failed on iteration %u\n", i);
+			return 1;
+		}
+	}
+
+	printf("%u keys, %u iterations:\n", num_keys, iters);
+
+	print_result(&std_res, num_keys * iters);
+	print_result(&nat_res, num_keys * iters);
+
+	return 0;
+}
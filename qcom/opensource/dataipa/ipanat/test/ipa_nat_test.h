@@ -177,4 +177,18 @@ int ipa_nat_test022(const char*, u32, int, u32, int, void*);
 int ipa_nat_test023(const char*, u32, int, u32, int, void*);
 int ipa_nat_test024(const char*, u32, int, u32, int, void*);
 int ipa_nat_test025(const char*, u32, int, u32, int, void*);
+int ipa_nat_test026(const char*, u32, int, u32, int, void*);
+int ipa_nat_test027(const char*, u32, int, u32, int, void*);
 int ipa_nat_test999(const char*, u32, int, u32, int, void*);
+
+/*
+ * The mocked IPA driver (see ipa_nat_test_mock.c)
+ */
+#undef  MOCK_SRAM_SIZE
+#define MOCK_SRAM_SIZE (32 * 1024)
+
+int  ipa_nat_test_mock_enable(void);
+bool ipa_nat_test_mock_enabled(void);
+void ipa_nat_test_mock_set_max_dma_entries(uint8_t);
+void ipa_nat_test_mock_set_sram_size(u32);
+void ipa_nat_test_mock_get_stats(u32*, u32*);
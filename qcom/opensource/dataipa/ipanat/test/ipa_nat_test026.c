@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2019 The Linux Foundation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of The Linux Foundation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+ * IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*=========================================================================*/
+/*!
+	@file
+	ipa_nat_test026.c
+
+	@brief
+	Benchmark rule add/delete throughput (rules/sec), one rule per call
+	versus batched:
+	1. Add N random rules one at a time, then delete them one at a time
+	2. Add the same N rules via ipa_nat_add_ipv4_rules(), then delete
+	   them via ipa_nat_del_ipv4_rules()
+	3. Verify the table after each step and that both ways leave an
+	   empty table behind
+
+	When run against the mocked driver (ie. -k), the number of DMA
+	commands posted for each way is reported and the batched way is
+	expected to post fewer of them.
+*/
+/*=========================================================================*/
+
+#include "ipa_nat_test.h"
+
+#undef  BATCH_SZ
+#define BATCH_SZ 64
+
+typedef struct
+{
+	u32      num_rules;
+	uint64_t add_ns;
+	uint64_t del_ns;
+	u32      add_cmds;
+	u32      del_cmds;
+} bench_result;
+
+static uint64_t now_ns(void)
+{
+	uint64_t t = 0;
+
+	currTimeAs(TimeAsNanSecs, &t);
+
+	return t;
+}
+
+static double rules_per_sec(
+	u32      num_rules,
+	uint64_t ns )
+{
+	return (ns) ? ((double) num_rules * 1000000000.0) / (double) ns : 0.0;
+}
+
+static u32 mock_cmds(void)
+{
+	u32 cmds = 0, ents = 0;
+
+	if ( ipa_nat_test_mock_enabled() )
+	{
+		ipa_nat_test_mock_get_stats(&cmds, &ents);
+	}
+
+	return cmds;
+}
+
+static int table_is_empty(
+	u32 tbl_hdl )
+{
+	ipa_nati_tbl_stats nstats, istats;
+
+	if ( ipa_nati_ipv4_tbl_stats(tbl_hdl, &nstats, &istats) )
+	{
+		return 0;
+	}
+
+	return
+		nstats.tot_base_ents_filled == 0 && nstats.tot_expn_ents_filled == 0 &&
+		istats.tot_base_ents_filled == 0 && istats.tot_expn_ents_filled == 0;
+}
+
+static int bench_single(
+	u32                      tbl_hdl,
+	const ipa_nat_ipv4_rule* rules,
+	u32*                     rule_hdls,
+	u32                      num_rules,
+	bench_result*            res )
+{
+	uint64_t t;
+	u32      cmds, i;
+	int      ret = 0;
+
+	cmds = mock_cmds();
+	t    = now_ns();
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		ret = ipa_nat_add_ipv4_rule(tbl_hdl, &rules[i], &rule_hdls[i]);
+
+		if ( ret || rule_hdls[i] == 0 )
+		{
+			IPAERR("ipa_nat_add_ipv4_rule() of rule %u failed\n", i);
+			return -1;
+		}
+	}
+
+	res->add_ns   = now_ns() - t;
+	res->add_cmds = mock_cmds() - cmds;
+
+	ret = ipa_nat_validate_ipv4_table(tbl_hdl);
+	CHECK_ERR(ret);
+
+	cmds = mock_cmds();
+	t    = now_ns();
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		ret = ipa_nat_del_ipv4_rule(tbl_hdl, rule_hdls[i]);
+		CHECK_ERR(ret);
+	}
+
+	res->del_ns   = now_ns() - t;
+	res->del_cmds = mock_cmds() - cmds;
+
+	res->num_rules = num_rules;
+
+	return 0;
+}
+
+static int bench_batched(
+	u32                      tbl_hdl,
+	const ipa_nat_ipv4_rule* rules,
+	u32*                     rule_hdls,
+	u32                      num_rules,
+	bench_result*            res )
+{
+	uint64_t t;
+	u32      cmds, i, n, done;
+	int      ret = 0;
+
+	cmds = mock_cmds();
+	t    = now_ns();
+
+	for ( i = 0; i < num_rules; i += n )
+	{
+		n = ( num_rules - i < BATCH_SZ ) ? num_rules - i : BATCH_SZ;
+
+		ret = ipa_nat_add_ipv4_rules(tbl_hdl, &rules[i], n, &rule_hdls[i], &done);
+
+		if ( ret || done != n )
+		{
+			IPAERR("ipa_nat_add_ipv4_rules() added %u of %u rules\n", done, n);
+			return -1;
+		}
+	}
+
+	res->add_ns   = now_ns() - t;
+	res->add_cmds = mock_cmds() - cmds;
+
+	ret = ipa_nat_validate_ipv4_table(tbl_hdl);
+	CHECK_ERR(ret);
+
+	cmds = mock_cmds();
+	t    = now_ns();
+
+	for ( i = 0; i < num_rules; i += n )
+	{
+		n = ( num_rules - i < BATCH_SZ ) ? num_rules - i : BATCH_SZ;
+
+		ret = ipa_nat_del_ipv4_rules(tbl_hdl, &rule_hdls[i], n, &done);
+
+		if ( ret || done != n )
+		{
+			IPAERR("ipa_nat_del_ipv4_rules() deleted %u of %u rules\n", done, n);
+			return -1;
+		}
+	}
+
+	res->del_ns   = now_ns() - t;
+	res->del_cmds = mock_cmds() - cmds;
+
+	res->num_rules = num_rules;
+
+	return 0;
+}
+
+static void report(
+	const char*         how,
+	const bench_result* res )
+{
+	IPAINFO("%-8s add: %u rules in %llu ns (%.0f rules/sec) %u DMA cmds\n",
+			how, res->num_rules, (unsigned long long) res->add_ns,
+			rules_per_sec(res->num_rules, res->add_ns), res->add_cmds);
+
+	IPAINFO("%-8s del: %u rules in %llu ns (%.0f rules/sec) %u DMA cmds\n",
+			how, res->num_rules, (unsigned long long) res->del_ns,
+			rules_per_sec(res->num_rules, res->del_ns), res->del_cmds);
+}
+
+int ipa_nat_test026(
+	const char* nat_mem_type,
+	u32 pub_ip_add,
+	int total_entries,
+	u32 tbl_hdl,
+	int sep,
+	void* arb_data_ptr)
+{
+	int* tbl_hdl_ptr = (int*) arb_data_ptr;
+
+	ipa_nat_ipv4_rule* rules     = NULL;
+	u32*               rule_hdls = NULL;
+
+	bench_result       single, batched;
+
+	u32                num_rules = total_entries / 2;
+	u32                i;
+
+	int ret = -1;
+
+	IPADBG("In\n");
+
+	if ( sep )
+	{
+		ret = ipa_nat_add_ipv4_tbl(pub_ip_add, nat_mem_type, total_entries, &tbl_hdl);
+		CHECK_ERR_TBL_STOP(ret, tbl_hdl);
+	}
+
+	ret = ipa_nati_clear_ipv4_tbl(tbl_hdl);
+	CHECK_ERR_TBL_STOP(ret, tbl_hdl);
+
+	rules     = calloc(num_rules, sizeof(*rules));
+	rule_hdls = calloc(num_rules, sizeof(*rule_hdls));
+
+	if ( ! rules || ! rule_hdls )
+	{
+		IPAERR("Unable to allocate %u rules\n", num_rules);
+		ret = -1;
+		goto bail;
+	}
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		rules[i].protocol     = IPPROTO_TCP;
+		rules[i].public_port  = RAN_PORT;
+		rules[i].target_ip    = RAN_ADDR;
+		rules[i].target_port  = RAN_PORT;
+		rules[i].private_ip   = RAN_ADDR;
+		rules[i].private_port = RAN_PORT;
+	}
+
+	memset(&single,  0, sizeof(single));
+	memset(&batched, 0, sizeof(batched));
+
+	ret = bench_single(tbl_hdl, rules, rule_hdls, num_rules, &single);
+	CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto bail);
+
+	if ( ! table_is_empty(tbl_hdl) )
+	{
+		IPAERR("Table not empty after one at a time deletes\n");
+		ret = -1;
+		goto bail;
+	}
+
+	memset(rule_hdls, 0, num_rules * sizeof(*rule_hdls));
+
+	ret = bench_batched(tbl_hdl, rules, rule_hdls, num_rules, &batched);
+	CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto bail);
+
+	if ( ! table_is_empty(tbl_hdl) )
+	{
+		IPAERR("Table not empty after batched deletes\n");
+		ret = -1;
+		goto bail;
+	}
+
+	report("single", &single);
+	report("batched", &batched);
+
+	if ( ipa_nat_test_mock_enabled() &&
+		 ( batched.add_cmds > single.add_cmds ||
+		   batched.del_cmds > single.del_cmds ) )
+	{
+		IPAERR("Batching posted more DMA commands than one at a time\n");
+		ret = -1;
+	}
+
+bail:
+	free(rules);
+	free(rule_hdls);
+
+	if ( sep )
+	{
+		ipa_nat_del_ipv4_tbl(tbl_hdl);
+		*tbl_hdl_ptr = 0;
+	}
+
+	IPADBG("Out\n");
+
+	return ret;
+}
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2019 The Linux Foundation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of The Linux Foundation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+ * IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*=========================================================================*/
+/*!
+	@file
+	ipa_nat_test027.c
+
+	@brief
+	Verify the incremental switch of a HYBRID table (see
+	ipa_nat_set_switch_chunk()):
+	1. Add rules, one at a time, until SRAM overflows and the switch
+	   to DDR starts
+	2. While the switch is in progress, verify that every rule added
+	   so far can be found (ie. is in either SRAM or DDR)
+	3. Delete some of the rules, while still switching, then stop
+	   adding and deleting, and verify that the switch finishes on
+	   its own (ie. driven by the library's worker)
+	4. Verify the switch's stats, in particular that the rules moved
+	   and the rules left always add up to the rules to move, and
+	   the table
+	5. Delete the remaining rules and verify the table ends up empty
+
+	Only runs on a HYBRID table with SRAM available (eg. -k -m HYBRID).
+*/
+/*=========================================================================*/
+
+#include <unistd.h>
+
+#include "ipa_nat_test.h"
+#include "ipa_nat_statemach.h"
+
+#undef  SWITCH_CHUNK
+#define SWITCH_CHUNK 8
+
+/*
+ * Every DEL_STRIDE'th rule is deleted while switching
+ */
+#undef  DEL_STRIDE
+#define DEL_STRIDE 31
+
+/*
+ * How long to wait for the switch to finish with no rule adds/deletes
+ */
+#undef  IDLE_WAIT_MS
+#define IDLE_WAIT_MS 5000
+
+static int stats_add_up(
+	const nati_switch_stats* stats_ptr )
+{
+	if ( stats_ptr->rules_moved + stats_ptr->rules_left
+		 != stats_ptr->rules_total )
+	{
+		IPAERR("rules_moved(%u) + rules_left(%u) != rules_total(%u)\n",
+			   stats_ptr->rules_moved,
+			   stats_ptr->rules_left,
+			   stats_ptr->rules_total);
+		return 0;
+	}
+
+	return 1;
+}
+
+static int all_rules_found(
+	u32        tbl_hdl,
+	const u32* rule_hdls,
+	u32        num_rules )
+{
+	u32 i, time_stamp;
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		if ( rule_hdls[i] == 0 )
+		{
+			continue;
+		}
+
+		if ( ipa_nat_query_timestamp(tbl_hdl, rule_hdls[i], &time_stamp) )
+		{
+			IPAERR("Rule %u (hdl 0x%08X) not found\n", i, rule_hdls[i]);
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static int table_is_empty(
+	u32 tbl_hdl )
+{
+	ipa_nati_tbl_stats nstats, istats;
+
+	if ( ipa_nati_ipv4_tbl_stats(tbl_hdl, &nstats, &istats) )
+	{
+		return 0;
+	}
+
+	return
+		nstats.tot_base_ents_filled == 0 && nstats.tot_expn_ents_filled == 0 &&
+		istats.tot_base_ents_filled == 0 && istats.tot_expn_ents_filled == 0;
+}
+
+int ipa_nat_test027(
+	const char* nat_mem_type,
+	u32 pub_ip_add,
+	int total_entries,
+	u32 tbl_hdl,
+	int sep,
+	void* arb_data_ptr)
+{
+	int* tbl_hdl_ptr = (int*) arb_data_ptr;
+
+	ipa_nat_ipv4_rule  rule;
+	u32*               rule_hdls = NULL;
+
+	nati_switch_stats  before, stats;
+
+	u32                num_rules = total_entries / 2;
+	u32                i, j, in_progress = 0;
+
+	int ret = 0;
+
+	IPADBG("In\n");
+
+	if ( strcmp(nat_mem_type, "HYBRID") )
+	{
+		IPAINFO("Not a HYBRID table, skipping\n");
+		return 0;
+	}
+
+	if ( sep )
+	{
+		ret = ipa_nat_add_ipv4_tbl(pub_ip_add, nat_mem_type, total_entries, &tbl_hdl);
+		CHECK_ERR_TBL_STOP(ret, tbl_hdl);
+	}
+
+	if ( ! ipa_nat_is_sram_supported() )
+	{
+		IPAINFO("No SRAM available, skipping\n");
+		goto bail;
+	}
+
+	ret = ipa_nati_clear_ipv4_tbl(tbl_hdl);
+	CHECK_ERR_TBL_STOP(ret, tbl_hdl);
+
+	rule_hdls = calloc(num_rules, sizeof(*rule_hdls));
+
+	if ( ! rule_hdls )
+	{
+		IPAERR("Unable to allocate %u rule handles\n", num_rules);
+		ret = -1;
+		goto bail;
+	}
+
+	ret = ipa_nat_set_switch_chunk(SWITCH_CHUNK);
+	CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto bail);
+
+	ipa_nati_get_switch_stats(IPA_NAT_MEM_IN_SRAM, &before);
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		memset(&rule, 0, sizeof(rule));
+
+		rule.protocol     = IPPROTO_TCP;
+		rule.public_port  = RAN_PORT;
+		rule.target_ip    = RAN_ADDR;
+		rule.target_port  = RAN_PORT;
+		rule.private_ip   = RAN_ADDR;
+		rule.private_port = RAN_PORT;
+
+		ret = ipa_nat_add_ipv4_rule(tbl_hdl, &rule, &rule_hdls[i]);
+
+		if ( ret || rule_hdls[i] == 0 )
+		{
+			IPAERR("ipa_nat_add_ipv4_rule() of rule %u failed\n", i);
+			ret = -1;
+			goto bail;
+		}
+
+		ipa_nati_get_switch_stats(IPA_NAT_MEM_IN_SRAM, &stats);
+
+		if ( stats.rules_left && ! in_progress )
+		{
+			in_progress = i + 1;
+
+			IPAINFO("Switch to DDR started at rule %u, %u rules left to move\n",
+					i, stats.rules_left);
+
+			if ( ! stats_add_up(&stats)
+				 ||
+				 ! all_rules_found(tbl_hdl, rule_hdls, i + 1) )
+			{
+				ret = -1;
+				goto bail;
+			}
+
+			/*
+			 * Delete some of the rules while they're being moved,
+			 * few enough to leave most of the switch to the
+			 * worker. Not validating the table here, since the
+			 * walks involved would finish the switch...
+			 */
+			for ( j = 0; j < i; j += DEL_STRIDE )
+			{
+				ret = ipa_nat_del_ipv4_rule(tbl_hdl, rule_hdls[j]);
+
+				if ( ret )
+				{
+					IPAERR("ipa_nat_del_ipv4_rule() of rule %u failed\n", j);
+					goto bail;
+				}
+
+				rule_hdls[j] = 0;
+			}
+
+			ipa_nati_get_switch_stats(IPA_NAT_MEM_IN_SRAM, &stats);
+
+			if ( ! stats_add_up(&stats)
+				 ||
+				 ! all_rules_found(tbl_hdl, rule_hdls, i + 1) )
+			{
+				ret = -1;
+				goto bail;
+			}
+
+			/*
+			 * No more rule adds/deletes, from here on...
+			 */
+			break;
+		}
+	}
+
+	if ( ! in_progress )
+	{
+		IPAERR("%u rules did not overflow SRAM, use a larger -e\n", num_rules);
+		ret = -1;
+		goto bail;
+	}
+
+	/*
+	 * Nothing but the library's worker moves rules now...
+	 */
+	for ( j = 0; j < IDLE_WAIT_MS; j++ )
+	{
+		ipa_nati_get_switch_stats(IPA_NAT_MEM_IN_SRAM, &stats);
+
+		if ( ! stats_add_up(&stats) )
+		{
+			ret = -1;
+			goto bail;
+		}
+
+		if ( stats.pass != before.pass )
+		{
+			break;
+		}
+
+		usleep(1000);
+	}
+
+	if ( stats.pass == before.pass )
+	{
+		IPAERR("Switch not done after %u ms without rule adds/deletes\n",
+			   IDLE_WAIT_MS);
+		ret = -1;
+		goto bail;
+	}
+
+	IPAINFO("Switch done %u ms after the last rule add/delete\n", j);
+
+	ret = ipa_nat_validate_ipv4_table(tbl_hdl);
+	CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto bail);
+
+	IPAINFO("SRAM to DDR: steps(%u) rules_total(%u) rules_moved(%u) "
+			"rules_left(%u) switch_ns(%llu) stall_ns(%llu) "
+			"max_stall_ns(%llu)\n",
+			stats.steps, stats.rules_total, stats.rules_moved, stats.rules_left,
+			(unsigned long long) stats.switch_ns,
+			(unsigned long long) stats.stall_ns,
+			(unsigned long long) stats.max_stall_ns);
+
+	if ( stats.pass != before.pass + 1 || stats.rules_left || stats.steps < 2
+		 ||
+		 ! stats_add_up(&stats) )
+	{
+		IPAERR("Unexpected switch stats\n");
+		ret = -1;
+		goto bail;
+	}
+
+	if ( ! all_rules_found(tbl_hdl, rule_hdls, num_rules) )
+	{
+		ret = -1;
+		goto bail;
+	}
+
+	for ( i = 0; i < num_rules; i++ )
+	{
+		if ( rule_hdls[i] )
+		{
+			ret = ipa_nat_del_ipv4_rule(tbl_hdl, rule_hdls[i]);
+			CHECK_ERR_TBL_ACTION(ret, tbl_hdl, goto bail);
+
+			rule_hdls[i] = 0;
+		}
+	}
+
+	/*
+	 * Deleting has likely started a switch back to SRAM, which the
+	 * stats retrieval below finishes...
+	 */
+	if ( ! table_is_empty(tbl_hdl) )
+	{
+		IPAERR("Table not empty after deletes\n");
+		ret = -1;
+	}
+
+bail:
+	ipa_nat_set_switch_chunk(0);
+
+	free(rule_hdls);
+
+	if ( sep )
+	{
+		ipa_nat_del_ipv4_tbl(tbl_hdl);
+		*tbl_hdl_ptr = 0;
+	}
+
+	IPADBG("Out\n");
+
+	return ret;
+}
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2019 The Linux Foundation. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *  * Neither the name of The Linux Foundation nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED
+ * WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT
+ * ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR
+ * BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+ * IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*=========================================================================*/
+/*!
+	@file
+	ipa_nat_test_mock.c
+
+	@brief
+	A stand-in for the IPA driver, so that the NAT library can be
+	exercised (eg. benchmarked) on a target without IPA hardware.
+
+	When enabled (see ipanattest's -k option), the open, close, ioctl
+	and mmap calls the NAT library makes against /dev/ipa and
+	/dev/ipaNatTable are intercepted here:
+
+	  o the NAT table memory is plain anonymous memory,
+	  o IPA_IOC_TABLE_DMA_CMD entries are applied to that memory,
+	    directly, the way the IPA would, and are counted,
+	  o the entry limit of a DMA command is enforced as the driver
+	    does, and
+	  o the remaining NAT ioctls simply succeed.
+
+	By default, SRAM is reported as unavailable, hence only DDR tables
+	can be mocked. Once ipa_nat_test_mock_set_sram_size() is given a
+	non-zero size, a table that fits in that size is put in a mocked
+	SRAM, which allows HYBRID tables to be exercised. Everything else
+	is passed through to the C library.
+*/
+/*=========================================================================*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <sys/mman.h>
+
+#include "ipa_nat_test.h"
+
+#undef  MOCK_NAT_DEV_PATH
+#define MOCK_NAT_DEV_PATH "/dev/" IPA_NAT_DEV_NAME
+
+#undef  MOCK_MAX_FDS
+#define MOCK_MAX_FDS 8
+
+/*
+ * Table types (ie. dma base_addr) as per the IPA NAT DMA command
+ */
+#undef  MOCK_NUM_TBL_TYPES
+#define MOCK_NUM_TBL_TYPES 4
+
+typedef int   (*open_fn_t)(const char*, int, ...);
+typedef int   (*close_fn_t)(int);
+typedef int   (*ioctl_fn_t)(int, unsigned long, ...);
+typedef void* (*mmap_fn_t)(void*, size_t, int, int, int, off_t);
+
+static struct
+{
+	bool       enabled;
+
+	open_fn_t  real_open;
+	close_fn_t real_close;
+	ioctl_fn_t real_ioctl;
+	mmap_fn_t  real_mmap;
+
+	int        fds[MOCK_MAX_FDS];
+	int        nat_fd;
+
+	u32        sram_size;
+	uint8_t    alloc_mem_type;
+
+	uint8_t*   nat_base[IPA_NAT_MEM_IN_MAX];
+	uint32_t   tbl_offset[IPA_NAT_MEM_IN_MAX][MOCK_NUM_TBL_TYPES];
+
+	uint8_t    max_dma_entries;
+
+	u32        num_dma_cmds;
+	u32        num_dma_entries;
+} mock = {
+	.nat_fd          = -1,
+	.max_dma_entries = MAX_DMA_ENTRIES_PER_CMD,
+};
+
+static void mock_resolve(void)
+{
+	if ( ! mock.real_open )
+	{
+		mock.real_open  = (open_fn_t)  dlsym(RTLD_NEXT, "open");
+		mock.real_close = (close_fn_t) dlsym(RTLD_NEXT, "close");
+		mock.real_ioctl = (ioctl_fn_t) dlsym(RTLD_NEXT, "ioctl");
+		mock.real_mmap  = (mmap_fn_t)  dlsym(RTLD_NEXT, "mmap");
+	}
+}
+
+static bool mock_fd(
+	int fd )
+{
+	int i;
+
+	if ( ! mock.enabled || fd < 0 )
+		return false;
+
+	for ( i = 0; i < MOCK_MAX_FDS; i++ )
+		if ( mock.fds[i] == fd + 1 )
+			return true;
+
+	return false;
+}
+
+int ipa_nat_test_mock_enable(void)
+{
+	mock_resolve();
+
+	if ( ! mock.real_open || ! mock.real_close ||
+		 ! mock.real_ioctl || ! mock.real_mmap )
+	{
+		IPAERR("Unable to resolve the C library's open/close/ioctl/mmap\n");
+		return -ENOENT;
+	}
+
+	mock.enabled = true;
+
+	return 0;
+}
+
+bool ipa_nat_test_mock_enabled(void)
+{
+	return mock.enabled;
+}
+
+void ipa_nat_test_mock_set_max_dma_entries(
+	uint8_t max_entries )
+{
+	mock.max_dma_entries = max_entries;
+}
+
+void ipa_nat_test_mock_set_sram_size(
+	u32 sram_size )
+{
+	mock.sram_size = sram_size;
+}
+
+void ipa_nat_test_mock_get_stats(
+	u32* num_dma_cmds,
+	u32* num_dma_entries )
+{
+	*num_dma_cmds    = mock.num_dma_cmds;
+	*num_dma_entries = mock.num_dma_entries;
+}
+
+static int mock_table_dma(
+	struct ipa_ioc_nat_dma_cmd* cmd )
+{
+	uint8_t i;
+
+	if ( cmd->entries == 0 || cmd->entries > mock.max_dma_entries )
+	{
+		IPAERR("Invalid number of entries %u\n", cmd->entries);
+		errno = EPERM;
+		return -1;
+	}
+
+	if ( cmd->mem_type >= IPA_NAT_MEM_IN_MAX )
+	{
+		IPAERR("Invalid mem_type %u\n", cmd->mem_type);
+		errno = EPERM;
+		return -1;
+	}
+
+	if ( ! mock.nat_base[cmd->mem_type] )
+	{
+		IPAERR("NAT table memory not mapped\n");
+		errno = EINVAL;
+		return -1;
+	}
+
+	for ( i = 0; i < cmd->entries; i++ )
+	{
+		struct ipa_ioc_nat_dma_one* dma = &cmd->dma[i];
+
+		if ( dma->base_addr >= MOCK_NUM_TBL_TYPES )
+		{
+			IPAERR("Invalid base_addr %u\n", dma->base_addr);
+			errno = EPERM;
+			return -1;
+		}
+	}
+
+	/*
+	 * Like the IPA, all or nothing...
+	 */
+	for ( i = 0; i < cmd->entries; i++ )
+	{
+		struct ipa_ioc_nat_dma_one* dma = &cmd->dma[i];
+
+		uint8_t* addr =
+			mock.nat_base[cmd->mem_type] +
+			mock.tbl_offset[cmd->mem_type][dma->base_addr] +
+			dma->offset;
+
+		memcpy(addr, &dma->data, sizeof(dma->data));
+	}
+
+	mock.num_dma_cmds++;
+	mock.num_dma_entries += cmd->entries;
+
+	return 0;
+}
+
+static int mock_ioctl(
+	unsigned long req,
+	void*         arg )
+{
+	if ( req == IPA_IOC_GET_HW_VERSION )
+	{
+		*((enum ipa_hw_type*) arg) = IPA_HW_v4_5;
+		return 0;
+	}
+
+	if ( req == IPA_IOC_GET_NAT_IN_SRAM_INFO )
+	{
+		struct ipa_nat_in_sram_info* info = arg;
+
+		if ( ! mock.sram_size )
+		{
+			errno = ENOTSUP;
+			return -1;
+		}
+
+		info->sram_mem_available_for_nat = mock.sram_size;
+		info->nat_table_offset_into_mmap = 0;
+		info->best_nat_in_sram_size_rqst = mock.sram_size;
+
+		return 0;
+	}
+
+	if ( req == IPA_IOC_ALLOC_NAT_TABLE )
+	{
+		struct ipa_ioc_nat_ipv6ct_table_alloc* alloc = arg;
+
+		/*
+		 * Same decision the library makes, hence the next mmap of
+		 * the NAT device is for this memory type...
+		 */
+		mock.alloc_mem_type =
+			( mock.sram_size && alloc->size <= mock.sram_size ) ?
+			IPA_NAT_MEM_IN_SRAM                               :
+			IPA_NAT_MEM_IN_DDR;
+
+		alloc->offset = 0;
+
+		return 0;
+	}
+
+	if ( req == IPA_IOC_V4_INIT_NAT )
+	{
+		struct ipa_ioc_v4_nat_init* init = arg;
+		uint32_t* offs;
+
+		if ( init->mem_type >= IPA_NAT_MEM_IN_MAX )
+		{
+			errno = EPERM;
+			return -1;
+		}
+
+		offs = mock.tbl_offset[init->mem_type];
+
+		offs[IPA_NAT_BASE_TBL]       = init->ipv4_rules_offset;
+		offs[IPA_NAT_EXPN_TBL]       = init->expn_rules_offset;
+		offs[IPA_NAT_INDX_TBL]       = init->index_offset;
+		offs[IPA_NAT_INDEX_EXPN_TBL] = init->index_expn_offset;
+
+		return 0;
+	}
+
+	if ( req == IPA_IOC_TABLE_DMA_CMD )
+	{
+		return mock_table_dma((struct ipa_ioc_nat_dma_cmd*) arg);
+	}
+
+	/*
+	 * IPA_IOC_DEL_NAT_TABLE, IPA_IOC_NAT_MODIFY_PDN,
+	 * IPA_IOC_APP_CLOCK_VOTE and the like...
+	 */
+	return 0;
+}
+
+/*
+ * The interposers...
+ */
+int open(
+	const char* path,
+	int         flags,
+	... )
+{
+	mode_t mode = 0;
+	int    fd, i;
+
+	mock_resolve();
+
+	if ( flags & O_CREAT )
+	{
+		va_list ap;
+
+		va_start(ap, flags);
+		mode = va_arg(ap, int);
+		va_end(ap);
+	}
+
+	if ( ! mock.enabled ||
+		 ( strcmp(path, IPA_DEV_NAME) &&
+		   strcmp(path, MOCK_NAT_DEV_PATH) ) )
+	{
+		return mock.real_open(path, flags, mode);
+	}
+
+	/*
+	 * Hand out a real descriptor, so that close() and friends keep
+	 * working, and remember it as ours...
+	 */
+	fd = mock.real_open("/dev/null", O_RDWR);
+
+	for ( i = 0; fd >= 0 && i < MOCK_MAX_FDS; i++ )
+	{
+		if ( mock.fds[i] == 0 )
+		{
+			mock.fds[i] = fd + 1;
+			break;
+		}
+	}
+
+	if ( ! strcmp(path, MOCK_NAT_DEV_PATH) )
+		mock.nat_fd = fd;
+
+	return fd;
+}
+
+int close(
+	int fd )
+{
+	int i;
+
+	mock_resolve();
+
+	if ( mock_fd(fd) )
+	{
+		for ( i = 0; i < MOCK_MAX_FDS; i++ )
+			if ( mock.fds[i] == fd + 1 )
+				mock.fds[i] = 0;
+
+		if ( fd == mock.nat_fd )
+			mock.nat_fd = -1;
+	}
+
+	return mock.real_close(fd);
+}
+
+#if defined(__BIONIC__)
+int ioctl(
+	int fd,
+	int req,
+	... )
+#else
+int ioctl(
+	int           fd,
+	unsigned long req,
+	... )
+#endif
+{
+	void*   arg;
+	va_list ap;
+
+	mock_resolve();
+
+	va_start(ap, req);
+	arg = va_arg(ap, void*);
+	va_end(ap);
+
+	if ( mock_fd(fd) )
+		return mock_ioctl((unsigned long) req, arg);
+
+	return mock.real_ioctl(fd, req, arg);
+}
+
+void* mmap(
+	void*  addr,
+	size_t len,
+	int    prot,
+	int    flags,
+	int    fd,
+	off_t  offset )
+{
+	void* ptr;
+
+	mock_resolve();
+
+	if ( ! mock_fd(fd) )
+		return mock.real_mmap(addr, len, prot, flags, fd, offset);
+
+	ptr = mock.real_mmap(
+		NULL, len, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if ( ptr != MAP_FAILED && fd == mock.nat_fd )
+		mock.nat_base[mock.alloc_mem_type] = ptr;
+
+	return ptr;
+}
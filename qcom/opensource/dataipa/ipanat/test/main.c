@@ -309,10 +309,11 @@ _dispUsage(
 	const char* progNamePtr )
 {
 	printf(
-		"Usage: %s [-d -r N -i N -e N -m mt]\n"
+		"Usage: %s [-d -k -r N -i N -e N -m mt]\n"
 		"Where:\n"
 		"  -d     Each test is discrete (create table, add rules, destroy table)\n"
 		"         If not specified, only one table create and destroy for all tests\n"
+		"  -k     Run against a mocked IPA driver (no IPA hardware needed)\n"
 		"  -r N   Where N is the number of times to run the inotify regression test\n"
 		"  -i N   Where N is the number of times (iterations) to run test\n"
 		"  -e N   Where N is the number of entries in the NAT\n"
@@ -351,6 +352,8 @@ static NatTests nt_array[] = {
 	NAT_TEST_ENTRY(ipa_nat_test023, IPA_NAT_TEST_PRE_COND_TE, 0),
 	NAT_TEST_ENTRY(ipa_nat_test024, IPA_NAT_TEST_PRE_COND_TE, 0),
 	NAT_TEST_ENTRY(ipa_nat_test025, IPA_NAT_TEST_PRE_COND_TE, 0),
+	NAT_TEST_ENTRY(ipa_nat_test026, IPA_NAT_TEST_PRE_COND_TE, 0),
+	NAT_TEST_ENTRY(ipa_nat_test027, IPA_NAT_TEST_PRE_COND_TE, 0),
 	/*
 	 * Add new tests just above this comment. Keep the following two
 	 * at the end...
@@ -386,13 +389,20 @@ int main(
 
 	IPADBG("Testing user space nat driver\n");
 
-	while ( (c = getopt(argc, argv, "dr:i:e:m:h:g:?")) != -1 )
+	while ( (c = getopt(argc, argv, "dkr:i:e:m:h:g:?")) != -1 )
 	{
 		switch (c)
 		{
 		case 'd':
 			sep = 1;
 			break;
+		case 'k':
+			if ( ipa_nat_test_mock_enable() )
+			{
+				fprintf(stderr, "Unable to enable the mocked IPA driver\n");
+				exit(0);
+			}
+			break;
 		case 'r':
 			ireg = atoi(optarg);
 			break;
@@ -431,6 +441,14 @@ int main(
 		}
 	}
 
+	/*
+	 * Give the mocked driver some SRAM, when it's to be used...
+	 */
+	if ( ipa_nat_test_mock_enabled() && strcmp(nat_mem_type, "DDR") )
+	{
+		ipa_nat_test_mock_set_sram_size(MOCK_SRAM_SIZE);
+	}
+
 	srand(time(&t));
 
 	pub_ip_addr = RAN_ADDR;
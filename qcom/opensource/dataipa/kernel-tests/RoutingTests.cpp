@@ -66,6 +66,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <stdint.h>
+#include <time.h>
 #include "hton.h" // for htonl
 
 
@@ -6140,6 +6141,236 @@ public:
 };
 
 
+#define IPA_RT_SCALE_NUM_TBLS (4)
+#define IPA_RT_SCALE_RULES_PER_TBL (96)
+#define IPA_RT_SCALE_ROUNDS (4)
+#define IPA_RT_SCALE_LOOKUPS_PER_TBL (256)
+
+class IpaRoutingBlockTest060 : public IpaRoutingBlockTestFixture
+{
+public:
+	IpaRoutingBlockTest060()
+	{
+		m_name = "IpaRoutingBlockTest060";
+		m_description = " \
+		Routing block test 060 - Routing tables and rules install scale test \
+		1. For IPv4 and IPv6, add IPA_RT_SCALE_RULES_PER_TBL rules to each \
+		   of IPA_RT_SCALE_NUM_TBLS routing tables, one rule per ioctl, \
+		   and commit \
+		2. Look up every table by name IPA_RT_SCALE_LOOKUPS_PER_TBL times \
+		3. Delete all the rules, which deletes the tables, and commit \
+		4. Repeat IPA_RT_SCALE_ROUNDS times and report the average and \
+		   the worst install, lookup and delete latencies";
+		m_IpaIPType = IPA_IP_v4;
+		Register(*this);
+	}
+
+	static uint64_t NowUsec()
+	{
+		struct timespec ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+	}
+
+	struct Latency {
+		uint64_t total;
+		uint64_t max;
+		uint32_t cnt;
+
+		void Add(uint64_t start)
+		{
+			uint64_t delta = NowUsec() - start;
+
+			total += delta;
+			if (delta > max)
+				max = delta;
+			cnt++;
+		}
+
+		void Print(const char *what)
+		{
+			printf("%s: %u ops, avg %llu usec, max %llu usec\n", what,
+				cnt, cnt ? (unsigned long long)(total / cnt) : 0,
+				(unsigned long long)max);
+		}
+	};
+
+	bool AddRule(enum ipa_ip_type ip, int tbl, int i, uint32_t *hdl)
+	{
+		struct ipa_ioc_add_rt_rule *rt_rule;
+		struct ipa_rt_rule_add *rt_rule_entry;
+		uint64_t start;
+		bool res;
+
+		rt_rule = (struct ipa_ioc_add_rt_rule *)
+			calloc(1, sizeof(struct ipa_ioc_add_rt_rule) +
+			       sizeof(struct ipa_rt_rule_add));
+		if (!rt_rule) {
+			printf("Failed memory allocation for rt_rule\n");
+			return false;
+		}
+
+		rt_rule->commit = 0;
+		rt_rule->num_rules = 1;
+		rt_rule->ip = ip;
+		snprintf(rt_rule->rt_tbl_name, sizeof(rt_rule->rt_tbl_name),
+			"scale_rt_%d", tbl);
+
+		rt_rule_entry = &rt_rule->rules[0];
+		rt_rule_entry->at_rear = 1;
+		rt_rule_entry->rule.dst = IPA_CLIENT_TEST2_CONS;
+		rt_rule_entry->rule.attrib.attrib_mask = IPA_FLT_DST_ADDR;
+		if (ip == IPA_IP_v4) {
+			// DST_IP == 10.tbl.(i / 256).(i % 256)
+			rt_rule_entry->rule.attrib.u.v4.dst_addr =
+				0x0A000000 | (tbl << 16) | i;
+			rt_rule_entry->rule.attrib.u.v4.dst_addr_mask =
+				0xFFFFFFFF;
+		} else {
+			rt_rule_entry->rule.attrib.u.v6.dst_addr[0] = 0x20010DB8;
+			rt_rule_entry->rule.attrib.u.v6.dst_addr[2] = tbl;
+			rt_rule_entry->rule.attrib.u.v6.dst_addr[3] = i;
+			for (int j = 0; j < 4; j++)
+				rt_rule_entry->rule.attrib.u.v6.dst_addr_mask[j] =
+					0xFFFFFFFF;
+		}
+
+		start = NowUsec();
+		res = m_routing.AddRoutingRule(rt_rule);
+		m_install.Add(start);
+		if (res && rt_rule_entry->status)
+			res = false;
+		*hdl = rt_rule_entry->rt_rule_hdl;
+
+		free(rt_rule);
+		return res;
+	}
+
+	bool LookupTables(enum ipa_ip_type ip)
+	{
+		struct ipa_ioc_get_rt_tbl st_rt_tbl;
+		uint64_t start;
+
+		for (int i = 0; i < IPA_RT_SCALE_LOOKUPS_PER_TBL; i++) {
+			for (int tbl = 0; tbl < IPA_RT_SCALE_NUM_TBLS; tbl++) {
+				memset(&st_rt_tbl, 0, sizeof(st_rt_tbl));
+				st_rt_tbl.ip = ip;
+				snprintf(st_rt_tbl.name, sizeof(st_rt_tbl.name),
+					"scale_rt_%d", tbl);
+				start = NowUsec();
+				if (!m_routing.GetRoutingTable(&st_rt_tbl)) {
+					printf("Lookup of %s failed!\n",
+						st_rt_tbl.name);
+					return false;
+				}
+				m_lookup.Add(start);
+				m_routing.PutRoutingTable(st_rt_tbl.hdl);
+			}
+		}
+
+		return true;
+	}
+
+	bool DeleteRules(enum ipa_ip_type ip, uint32_t *hdls, int num)
+	{
+		struct ipa_ioc_del_rt_rule *ruleTable;
+		uint64_t start;
+		bool res = true;
+
+		ruleTable = (struct ipa_ioc_del_rt_rule *)
+			calloc(1, sizeof(struct ipa_ioc_del_rt_rule) +
+				   sizeof(struct ipa_rt_rule_del));
+		if (!ruleTable) {
+			printf("Failed memory allocation for ruleTable\n");
+			return false;
+		}
+
+		for (int i = 0; i < num; i++) {
+			ruleTable->commit = 0;
+			ruleTable->ip = ip;
+			ruleTable->num_hdls = 1;
+			ruleTable->hdl[0].hdl = hdls[i];
+			ruleTable->hdl[0].status = 0;
+			start = NowUsec();
+			if (!m_routing.DeleteRoutingRule(ruleTable) ||
+				ruleTable->hdl[0].status) {
+				printf("Routing rule %d deletion failed!\n", i);
+				res = false;
+			}
+			m_delete.Add(start);
+		}
+
+		free(ruleTable);
+		return res;
+	}
+
+	bool RunRound(enum ipa_ip_type ip)
+	{
+		uint32_t hdls[IPA_RT_SCALE_NUM_TBLS * IPA_RT_SCALE_RULES_PER_TBL];
+		int num = 0;
+		bool res = true;
+
+		/* interleave the tables as IPACM does when adding clients */
+		for (int i = 0; i < IPA_RT_SCALE_RULES_PER_TBL && res; i++) {
+			for (int tbl = 0; tbl < IPA_RT_SCALE_NUM_TBLS; tbl++) {
+				if (!AddRule(ip, tbl, i, &hdls[num])) {
+					printf("Routing rule %d of tbl %d addition failed!\n",
+						i, tbl);
+					res = false;
+					break;
+				}
+				num++;
+			}
+		}
+
+		if (res && !m_routing.Commit(ip)) {
+			printf("Routing commit failed!\n");
+			res = false;
+		}
+
+		if (res)
+			res = LookupTables(ip);
+
+		if (!DeleteRules(ip, hdls, num))
+			res = false;
+
+		if (!m_routing.Commit(ip)) {
+			printf("Routing commit failed!\n");
+			res = false;
+		}
+
+		return res;
+	}
+
+	bool Run()
+	{
+		enum ipa_ip_type ips[] = { IPA_IP_v4, IPA_IP_v6 };
+		bool res = true;
+
+		memset(&m_install, 0, sizeof(m_install));
+		memset(&m_lookup, 0, sizeof(m_lookup));
+		memset(&m_delete, 0, sizeof(m_delete));
+
+		for (int round = 0; round < IPA_RT_SCALE_ROUNDS && res; round++) {
+			for (int i = 0; i < 2 && res; i++)
+				res = RunRound(ips[i]);
+		}
+
+		m_install.Print("rt rule install");
+		m_lookup.Print("rt tbl lookup");
+		m_delete.Print("rt rule delete");
+
+		return res;
+	}
+
+private:
+	Latency m_install;
+	Latency m_lookup;
+	Latency m_delete;
+};
+
+
 static class IpaRoutingBlockTest1 ipaRoutingBlockTest1;
 static class IpaRoutingBlockTest2 ipaRoutingBlockTest2;
 static class IpaRoutingBlockTest3 ipaRoutingBlockTest3;
@@ -6179,3 +6410,5 @@ static class IpaRoutingBlockTest050 ipaRoutingBlockTest050;
 static class IpaRoutingBlockTest051 ipaRoutingBlockTest051;
 static class IpaRoutingBlockTest052 ipaRoutingBlockTest052;
 static class IpaRoutingBlockTest053 ipaRoutingBlockTest053;
+
+static class IpaRoutingBlockTest060 ipaRoutingBlockTest060;
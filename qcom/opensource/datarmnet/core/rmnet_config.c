@@ -853,13 +853,20 @@ static int __init rmnet_init(void)
 {
 	int rc;
 
-	rc = register_netdevice_notifier(&rmnet_dev_notifier);
+	rc = rmnet_descriptor_module_init();
 	if (rc != 0)
 		return rc;
 
+	rc = register_netdevice_notifier(&rmnet_dev_notifier);
+	if (rc != 0) {
+		rmnet_descriptor_exit();
+		return rc;
+	}
+
 	rc = rtnl_link_register(&rmnet_link_ops);
 	if (rc != 0) {
 		unregister_netdevice_notifier(&rmnet_dev_notifier);
+		rmnet_descriptor_exit();
 		return rc;
 	}
 
@@ -867,6 +874,7 @@ static int __init rmnet_init(void)
 	if (rc != 0) {
 		unregister_netdevice_notifier(&rmnet_dev_notifier);
 		rtnl_link_unregister(&rmnet_link_ops);
+		rmnet_descriptor_exit();
 		return rc;
 	}
 
@@ -882,6 +890,7 @@ static void __exit rmnet_exit(void)
 	rtnl_link_unregister(&rmnet_link_ops);
 	rmnet_ll_exit();
 	rmnet_core_genl_deinit();
+	rmnet_descriptor_exit();
 
 	module_put(THIS_MODULE);
 }
@@ -57,6 +57,21 @@ struct rmnet_endpoint {
 struct rmnet_agg_stats {
 	u64 ul_agg_reuse;
 	u64 ul_agg_alloc;
+	u64 ul_agg_ring_grow;
+	u64 ul_agg_ring_shrink;
+	u64 ul_agg_reuse_hist[5];
+	u64 ul_agg_alloc_hist[5];
+	u64 ul_agg_ring_hist[5];
+	u64 ul_agg_wait_hist[6];
+};
+
+struct rmnet_desc_cache_stats {
+	u64 desc_hit;
+	u64 desc_miss;
+	u64 desc_spill;
+	u64 frag_hit;
+	u64 frag_miss;
+	u64 frag_spill;
 };
 
 struct rmnet_port_priv_stats {
@@ -80,6 +95,7 @@ struct rmnet_port_priv_stats {
 	u64 pb_marker_seq;
 	u64 chained_packets_recvd;
 	u64 packets_chained;
+	struct rmnet_desc_cache_stats desc_cache;
 };
 
 struct rmnet_egress_agg_params {
@@ -111,12 +127,21 @@ struct rmnet_aggregation_state {
 	struct list_head agg_list;
 	struct rmnet_agg_page *agg_head;
 	struct rmnet_agg_stats *stats;
+	/* Page recycler sizing */
+	u16 agg_ring_size;
+	u16 agg_window_reuse;
+	u16 agg_window_alloc;
+	u16 agg_in_flight;
+	int agg_resize;
+	struct work_struct agg_resize_wq;
 };
 
 
 struct rmnet_agg_page {
 	struct list_head list;
 	struct page *page;
+	ktime_t last_use;
+	bool in_flight;
 };
 
 
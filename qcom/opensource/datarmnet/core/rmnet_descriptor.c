@@ -14,6 +14,7 @@
  *
  */
 
+#include <linux/cpuhotplug.h>
 #include <linux/ip.h>
 #include <linux/ipv6.h>
 #include <linux/inet.h>
@@ -54,31 +55,140 @@ typedef void (*rmnet_perf_tether_ingress_hook_t)(struct tcphdr *tp, struct sk_bu
 rmnet_perf_tether_ingress_hook_t rmnet_perf_tether_ingress_hook __rcu __read_mostly;
 EXPORT_SYMBOL(rmnet_perf_tether_ingress_hook);
 
+/* Fragments have no port to hang a pool off, so they get a per-CPU cache of
+ * their own. Misses go to the slab, and overflow is handed back in bulk.
+ */
+#define RMNET_FRAG_PCPU_CACHE_SIZE 64
+#define RMNET_FRAG_PCPU_CACHE_BATCH 32
+
+struct rmnet_frag_pcpu_cache {
+	struct rmnet_fragment *frags[RMNET_FRAG_PCPU_CACHE_SIZE];
+	u32 count;
+	u64 hit;
+	u64 miss;
+	u64 spill;
+};
+
+static DEFINE_PER_CPU(struct rmnet_frag_pcpu_cache, rmnet_frag_cache);
+static enum cpuhp_state rmnet_frag_cpuhp_state;
+static enum cpuhp_state rmnet_desc_cpuhp_state;
+
+static struct rmnet_fragment *rmnet_frag_alloc(void)
+{
+	struct rmnet_frag_pcpu_cache *cache;
+	struct rmnet_fragment *frag;
+	unsigned long flags;
+
+	local_irq_save(flags);
+	cache = this_cpu_ptr(&rmnet_frag_cache);
+	if (cache->count) {
+		cache->hit++;
+		frag = cache->frags[--cache->count];
+		local_irq_restore(flags);
+		memset(frag, 0, sizeof(*frag));
+		return frag;
+	}
+
+	cache->miss++;
+	local_irq_restore(flags);
+	return kzalloc(sizeof(*frag), GFP_ATOMIC);
+}
+
+static void rmnet_frag_free(struct rmnet_fragment *frag)
+{
+	struct rmnet_frag_pcpu_cache *cache;
+	unsigned long flags;
+
+	local_irq_save(flags);
+	cache = this_cpu_ptr(&rmnet_frag_cache);
+	if (cache->count == RMNET_FRAG_PCPU_CACHE_SIZE) {
+		cache->spill++;
+		cache->count -= RMNET_FRAG_PCPU_CACHE_BATCH;
+		kfree_bulk(RMNET_FRAG_PCPU_CACHE_BATCH,
+			   (void **)&cache->frags[cache->count]);
+	}
+
+	cache->frags[cache->count++] = frag;
+	local_irq_restore(flags);
+}
+
+static struct rmnet_fragment *
+rmnet_frag_get(struct rmnet_frag_descriptor *frag_desc)
+{
+	u8 free_map = ~frag_desc->inline_map;
+	struct rmnet_fragment *frag;
+	int i;
+
+	if (free_map) {
+		i = __ffs(free_map);
+		if (i < RMNET_FRAG_DESC_INLINE_FRAGS) {
+			frag_desc->inline_map |= BIT(i);
+			frag = &frag_desc->inline_frags[i];
+			memset(frag, 0, sizeof(*frag));
+			return frag;
+		}
+	}
+
+	return rmnet_frag_alloc();
+}
+
+static void rmnet_frag_put(struct rmnet_frag_descriptor *frag_desc,
+			   struct rmnet_fragment *frag)
+{
+	struct rmnet_fragment *inline_frags = frag_desc->inline_frags;
+
+	if (frag >= inline_frags &&
+	    frag < inline_frags + RMNET_FRAG_DESC_INLINE_FRAGS) {
+		frag_desc->inline_map &= ~BIT(frag - inline_frags);
+		return;
+	}
+
+	rmnet_frag_free(frag);
+}
+
 struct rmnet_frag_descriptor *
 rmnet_get_frag_descriptor(struct rmnet_port *port)
 {
 	struct rmnet_frag_descriptor_pool *pool = port->frag_desc_pool;
 	struct rmnet_frag_descriptor *frag_desc;
+	struct rmnet_desc_pcpu_cache *cache;
 	unsigned long flags;
 
-	spin_lock_irqsave(&port->desc_pool_lock, flags);
-	if (!list_empty(&pool->free_list)) {
+	local_irq_save(flags);
+	cache = this_cpu_ptr(pool->pcpu_cache);
+	if (cache->count) {
+		cache->hit++;
+		frag_desc = cache->descs[--cache->count];
+		goto out;
+	}
+
+	/* Local cache is empty. Grab a batch from the shared pool */
+	cache->miss++;
+	spin_lock(&port->desc_pool_lock);
+	while (cache->count < RMNET_DESC_PCPU_CACHE_BATCH &&
+	       !list_empty(&pool->free_list)) {
 		frag_desc = list_first_entry(&pool->free_list,
 					     struct rmnet_frag_descriptor,
 					     list);
 		list_del_init(&frag_desc->list);
+		cache->descs[cache->count++] = frag_desc;
+	}
+
+	if (cache->count) {
+		frag_desc = cache->descs[--cache->count];
 	} else {
 		frag_desc = kzalloc(sizeof(*frag_desc), GFP_ATOMIC);
-		if (!frag_desc)
-			goto out;
-
-		INIT_LIST_HEAD(&frag_desc->list);
-		INIT_LIST_HEAD(&frag_desc->frags);
-		pool->pool_size++;
+		if (frag_desc) {
+			INIT_LIST_HEAD(&frag_desc->list);
+			INIT_LIST_HEAD(&frag_desc->frags);
+			pool->pool_size++;
+		}
 	}
 
+	spin_unlock(&port->desc_pool_lock);
+
 out:
-	spin_unlock_irqrestore(&port->desc_pool_lock, flags);
+	local_irq_restore(flags);
 	return frag_desc;
 }
 EXPORT_SYMBOL(rmnet_get_frag_descriptor);
@@ -87,6 +197,7 @@ void rmnet_recycle_frag_descriptor(struct rmnet_frag_descriptor *frag_desc,
 				   struct rmnet_port *port)
 {
 	struct rmnet_frag_descriptor_pool *pool = port->frag_desc_pool;
+	struct rmnet_desc_pcpu_cache *cache;
 	struct rmnet_fragment *frag, *tmp;
 	unsigned long flags;
 
@@ -99,15 +210,30 @@ void rmnet_recycle_frag_descriptor(struct rmnet_frag_descriptor *frag_desc,
 			put_page(page);
 
 		list_del(&frag->list);
-		kfree(frag);
+		rmnet_frag_put(frag_desc, frag);
 	}
 
-	memset(frag_desc, 0, sizeof(*frag_desc));
+	/* The inline fragments are reinitialized when handed out */
+	memset(frag_desc, 0, offsetof(struct rmnet_frag_descriptor,
+				      inline_frags));
 	INIT_LIST_HEAD(&frag_desc->list);
 	INIT_LIST_HEAD(&frag_desc->frags);
-	spin_lock_irqsave(&port->desc_pool_lock, flags);
-	list_add_tail(&frag_desc->list, &pool->free_list);
-	spin_unlock_irqrestore(&port->desc_pool_lock, flags);
+
+	local_irq_save(flags);
+	cache = this_cpu_ptr(pool->pcpu_cache);
+	if (cache->count == RMNET_DESC_PCPU_CACHE_SIZE) {
+		/* Local cache is full. Give a batch back to the shared pool */
+		cache->spill++;
+		spin_lock(&port->desc_pool_lock);
+		while (cache->count > RMNET_DESC_PCPU_CACHE_SIZE -
+				      RMNET_DESC_PCPU_CACHE_BATCH)
+			list_add_tail(&cache->descs[--cache->count]->list,
+				      &pool->free_list);
+		spin_unlock(&port->desc_pool_lock);
+	}
+
+	cache->descs[cache->count++] = frag_desc;
+	local_irq_restore(flags);
 }
 EXPORT_SYMBOL(rmnet_recycle_frag_descriptor);
 
@@ -139,7 +265,7 @@ void *rmnet_frag_pull(struct rmnet_frag_descriptor *frag_desc,
 			list_del(&frag->list);
 			size -= frag_size;
 			frag_desc->len -= frag_size;
-			kfree(frag);
+			rmnet_frag_put(frag_desc, frag);
 			continue;
 		}
 
@@ -189,7 +315,7 @@ void *rmnet_frag_trim(struct rmnet_frag_descriptor *frag_desc,
 			list_del(&frag->list);
 			eat -= frag_size;
 			frag_desc->len -= frag_size;
-			kfree(frag);
+			rmnet_frag_put(frag_desc, frag);
 			continue;
 		}
 
@@ -283,7 +409,7 @@ int rmnet_frag_descriptor_add_frag(struct rmnet_frag_descriptor *frag_desc,
 {
 	struct rmnet_fragment *frag;
 
-	frag = kzalloc(sizeof(*frag), GFP_ATOMIC);
+	frag = rmnet_frag_get(frag_desc);
 	if (!frag)
 		return -ENOMEM;
 
@@ -1156,9 +1282,11 @@ static void __rmnet_frag_segment_data(struct rmnet_frag_descriptor *coal_desc,
 		return;
 
 	/* Header information and most metadata is the same as the original */
-	memcpy(new_desc, coal_desc, sizeof(*coal_desc));
+	memcpy(new_desc, coal_desc,
+	       offsetof(struct rmnet_frag_descriptor, inline_map));
 	INIT_LIST_HEAD(&new_desc->list);
 	INIT_LIST_HEAD(&new_desc->frags);
+	new_desc->inline_map = 0;
 	new_desc->len = 0;
 
 	/* Add the header fragments */
@@ -1246,12 +1374,40 @@ recycle:
 	rmnet_recycle_frag_descriptor(new_desc, port);
 }
 
+/* Fold len bytes at offset into the checksum, one fragment at a time */
+static int rmnet_frag_csum(struct rmnet_map_csum_state *state,
+			   struct rmnet_frag_descriptor *frag_desc,
+			   u32 offset, u32 len)
+{
+	struct rmnet_fragment *frag;
+
+	rmnet_descriptor_for_each_frag(frag, frag_desc) {
+		u32 frag_size = skb_frag_size(&frag->frag);
+		u32 chunk;
+
+		if (!len)
+			break;
+
+		if (offset >= frag_size) {
+			offset -= frag_size;
+			continue;
+		}
+
+		chunk = min_t(u32, frag_size - offset, len);
+		rmnet_map_csum_add(state, skb_frag_address(&frag->frag) +
+				   offset, chunk);
+		len -= chunk;
+		offset = 0;
+	}
+
+	return len ? -EINVAL : 0;
+}
+
 static bool rmnet_frag_validate_csum(struct rmnet_frag_descriptor *frag_desc)
 {
 	u8 *data = rmnet_frag_data_ptr(frag_desc);
+	struct rmnet_map_csum_state state;
 	unsigned int datagram_len;
-	__wsum csum;
-	__sum16 pseudo;
 
 	/* Keep analysis tools happy, since they will see that
 	 * rmnet_frag_data_ptr() could return NULL. It can't in this case,
@@ -1260,24 +1416,17 @@ static bool rmnet_frag_validate_csum(struct rmnet_frag_descriptor *frag_desc)
 	if (unlikely(!data))
 		return false;
 
+	/* The whole coalesced frame is covered in a single pass over its
+	 * fragments, wherever the segment boundaries fall.
+	 */
 	datagram_len = frag_desc->len - frag_desc->ip_len;
-	if (frag_desc->ip_proto == 4) {
-		struct iphdr *iph = (struct iphdr *)data;
-
-		pseudo = ~csum_tcpudp_magic(iph->saddr, iph->daddr,
-					    datagram_len,
-					    frag_desc->trans_proto, 0);
-	} else {
-		struct ipv6hdr *ip6h = (struct ipv6hdr *)data;
-
-		pseudo = ~csum_ipv6_magic(&ip6h->saddr, &ip6h->daddr,
-					  datagram_len, frag_desc->trans_proto,
-					  0);
-	}
+	rmnet_map_csum_start(&state, frag_desc->ip_proto, data, datagram_len,
+			     frag_desc->trans_proto);
+	if (rmnet_frag_csum(&state, frag_desc, frag_desc->ip_len,
+			    datagram_len))
+		return false;
 
-	csum = csum_partial(data + frag_desc->ip_len, datagram_len,
-			    csum_unfold(pseudo));
-	return !csum_fold(csum);
+	return rmnet_map_csum_valid(&state);
 }
 
 /* Converts the coalesced frame into a list of descriptors */
@@ -1607,11 +1756,10 @@ rmnet_frag_data_check_coal_header(struct rmnet_frag_descriptor *frag_desc,
 static int rmnet_frag_checksum_pkt(struct rmnet_frag_descriptor *frag_desc)
 {
 	struct rmnet_priv *priv = netdev_priv(frag_desc->dev);
-	struct rmnet_fragment *frag;
+	struct rmnet_map_csum_state state;
 	int offset = sizeof(struct rmnet_map_header) +
 		     sizeof(struct rmnet_map_v5_csum_header);
 	u8 *version, __version;
-	__wsum csum;
 	u16 csum_len;
 
 	version = rmnet_frag_header_ptr(frag_desc, offset, sizeof(*version),
@@ -1649,9 +1797,8 @@ static int rmnet_frag_checksum_pkt(struct rmnet_frag_descriptor *frag_desc)
 
 		frag_desc->ip_proto = 4;
 		frag_desc->trans_proto = iph->protocol;
-		csum = ~csum_tcpudp_magic(iph->saddr, iph->daddr,
-					  csum_len,
-					  frag_desc->trans_proto, 0);
+		rmnet_map_csum_start(&state, 4, iph, csum_len,
+				     frag_desc->trans_proto);
 	} else if ((*version & 0xF0) == 0x60) {
 		struct ipv6hdr *ip6h, __ip6h;
 		int ip_len;
@@ -1680,9 +1827,8 @@ static int rmnet_frag_checksum_pkt(struct rmnet_frag_descriptor *frag_desc)
 			return -EINVAL;
 
 		frag_desc->trans_proto = protocol;
-		csum = ~csum_ipv6_magic(&ip6h->saddr, &ip6h->daddr,
-					csum_len,
-					frag_desc->trans_proto, 0);
+		rmnet_map_csum_start(&state, 6, ip6h, csum_len,
+				     frag_desc->trans_proto);
 	} else {
 		/* Not checksumable */
 		return -EINVAL;
@@ -1717,27 +1863,11 @@ static int rmnet_frag_checksum_pkt(struct rmnet_frag_descriptor *frag_desc)
 	}
 
 	/* Walk the frags and checksum each chunk */
-	list_for_each_entry(frag, &frag_desc->frags, list) {
-		u32 frag_size = skb_frag_size(&frag->frag);
-
-		if (!csum_len)
-			break;
-
-		if (offset < frag_size) {
-			void *addr = skb_frag_address(&frag->frag) + offset;
-			u32 len = min_t(u32, csum_len, frag_size - offset);
-
-			/* Checksum 'len' bytes and add them in */
-			csum = csum_partial(addr, len, csum);
-			csum_len -= len;
-			offset = 0;
-		} else {
-			offset -= frag_size;
-		}
-	}
+	if (rmnet_frag_csum(&state, frag_desc, offset, csum_len))
+		return -EINVAL;
 
 	priv->stats.csum_sw++;
-	return !csum_fold(csum);
+	return rmnet_map_csum_valid(&state);
 }
 
 /* Process a QMAPv5 packet header */
@@ -2018,9 +2148,28 @@ void rmnet_descriptor_deinit(struct rmnet_port *port)
 {
 	struct rmnet_frag_descriptor_pool *pool;
 	struct rmnet_frag_descriptor *frag_desc, *tmp;
+	int cpu;
 
 	pool = port->frag_desc_pool;
 	if (pool) {
+		if (!hlist_unhashed(&pool->cpuhp_node))
+			cpuhp_state_remove_instance_nocalls(rmnet_desc_cpuhp_state,
+							    &pool->cpuhp_node);
+
+		/* Return everything parked in the per-CPU caches first */
+		if (pool->pcpu_cache) {
+			for_each_possible_cpu(cpu) {
+				struct rmnet_desc_pcpu_cache *cache;
+
+				cache = per_cpu_ptr(pool->pcpu_cache, cpu);
+				while (cache->count)
+					list_add_tail(&cache->descs[--cache->count]->list,
+						      &pool->free_list);
+			}
+
+			free_percpu(pool->pcpu_cache);
+		}
+
 		list_for_each_entry_safe(frag_desc, tmp, &pool->free_list, list) {
 			kfree(frag_desc);
 			pool->pool_size--;
@@ -2034,7 +2183,7 @@ void rmnet_descriptor_deinit(struct rmnet_port *port)
 int rmnet_descriptor_init(struct rmnet_port *port)
 {
 	struct rmnet_frag_descriptor_pool *pool;
-	int i;
+	int i, rc;
 
 	spin_lock_init(&port->desc_pool_lock);
 	pool = kzalloc(sizeof(*pool), GFP_ATOMIC);
@@ -2042,8 +2191,18 @@ int rmnet_descriptor_init(struct rmnet_port *port)
 		return -ENOMEM;
 
 	INIT_LIST_HEAD(&pool->free_list);
+	pool->port = port;
 	port->frag_desc_pool = pool;
 
+	pool->pcpu_cache = alloc_percpu(struct rmnet_desc_pcpu_cache);
+	if (!pool->pcpu_cache)
+		return -ENOMEM;
+
+	rc = cpuhp_state_add_instance_nocalls(rmnet_desc_cpuhp_state,
+					      &pool->cpuhp_node);
+	if (rc)
+		return rc;
+
 	for (i = 0; i < RMNET_FRAG_DESCRIPTOR_POOL_SIZE; i++) {
 		struct rmnet_frag_descriptor *frag_desc;
 
@@ -2059,3 +2218,127 @@ int rmnet_descriptor_init(struct rmnet_port *port)
 
 	return 0;
 }
+
+/* The caches of a CPU going offline are flushed once it is dead, so that
+ * they do not sit there until it comes back.
+ */
+static int rmnet_frag_cpu_dead(unsigned int cpu)
+{
+	struct rmnet_frag_pcpu_cache *cache;
+
+	cache = per_cpu_ptr(&rmnet_frag_cache, cpu);
+	kfree_bulk(cache->count, (void **)cache->frags);
+	cache->count = 0;
+	return 0;
+}
+
+static int rmnet_desc_cpu_dead(unsigned int cpu, struct hlist_node *node)
+{
+	struct rmnet_frag_descriptor_pool *pool;
+	struct rmnet_desc_pcpu_cache *cache;
+	unsigned long flags;
+
+	pool = hlist_entry(node, struct rmnet_frag_descriptor_pool,
+			   cpuhp_node);
+	cache = per_cpu_ptr(pool->pcpu_cache, cpu);
+	spin_lock_irqsave(&pool->port->desc_pool_lock, flags);
+	while (cache->count)
+		list_add_tail(&cache->descs[--cache->count]->list,
+			      &pool->free_list);
+	spin_unlock_irqrestore(&pool->port->desc_pool_lock, flags);
+	return 0;
+}
+
+/* Called on module load, before any port is set up */
+int rmnet_descriptor_module_init(void)
+{
+	int rc;
+
+	rc = cpuhp_setup_state_nocalls(CPUHP_BP_PREPARE_DYN,
+				       "net/rmnet/frag:dead", NULL,
+				       rmnet_frag_cpu_dead);
+	if (rc < 0)
+		return rc;
+
+	rmnet_frag_cpuhp_state = rc;
+	rc = cpuhp_setup_state_multi(CPUHP_BP_PREPARE_DYN,
+				     "net/rmnet/desc:dead", NULL,
+				     rmnet_desc_cpu_dead);
+	if (rc < 0) {
+		cpuhp_remove_state_nocalls(rmnet_frag_cpuhp_state);
+		return rc;
+	}
+
+	rmnet_desc_cpuhp_state = rc;
+	return 0;
+}
+
+/* Called on module unload, once all ports are gone */
+void rmnet_descriptor_exit(void)
+{
+	int cpu;
+
+	cpuhp_remove_multi_state(rmnet_desc_cpuhp_state);
+	cpuhp_remove_state_nocalls(rmnet_frag_cpuhp_state);
+
+	for_each_possible_cpu(cpu) {
+		struct rmnet_frag_pcpu_cache *cache;
+
+		cache = per_cpu_ptr(&rmnet_frag_cache, cpu);
+		kfree_bulk(cache->count, (void **)cache->frags);
+		cache->count = 0;
+	}
+}
+
+/* Fold the per-CPU cache counters into the port stats. The fragment
+ * counters are shared by all ports.
+ */
+void rmnet_descriptor_get_cache_stats(struct rmnet_port *port)
+{
+	struct rmnet_desc_cache_stats *stats = &port->stats.desc_cache;
+	struct rmnet_frag_descriptor_pool *pool = port->frag_desc_pool;
+	int cpu;
+
+	memset(stats, 0, sizeof(*stats));
+	for_each_possible_cpu(cpu) {
+		struct rmnet_frag_pcpu_cache *frag_cache;
+
+		frag_cache = per_cpu_ptr(&rmnet_frag_cache, cpu);
+		stats->frag_hit += frag_cache->hit;
+		stats->frag_miss += frag_cache->miss;
+		stats->frag_spill += frag_cache->spill;
+
+		if (pool && pool->pcpu_cache) {
+			struct rmnet_desc_pcpu_cache *cache;
+
+			cache = per_cpu_ptr(pool->pcpu_cache, cpu);
+			stats->desc_hit += cache->hit;
+			stats->desc_miss += cache->miss;
+			stats->desc_spill += cache->spill;
+		}
+	}
+}
+
+void rmnet_descriptor_reset_cache_stats(struct rmnet_port *port)
+{
+	struct rmnet_frag_descriptor_pool *pool = port->frag_desc_pool;
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		struct rmnet_frag_pcpu_cache *frag_cache;
+
+		frag_cache = per_cpu_ptr(&rmnet_frag_cache, cpu);
+		frag_cache->hit = 0;
+		frag_cache->miss = 0;
+		frag_cache->spill = 0;
+
+		if (pool && pool->pcpu_cache) {
+			struct rmnet_desc_pcpu_cache *cache;
+
+			cache = per_cpu_ptr(pool->pcpu_cache, cpu);
+			cache->hit = 0;
+			cache->miss = 0;
+			cache->spill = 0;
+		}
+	}
+}
@@ -23,9 +23,27 @@
 #include "rmnet_config.h"
 #include "rmnet_map.h"
 
+/* Per-CPU descriptor cache. Refilled from and spilled to the shared port
+ * pool in batches, so desc_pool_lock is only taken once per batch.
+ */
+#define RMNET_DESC_PCPU_CACHE_SIZE 32
+#define RMNET_DESC_PCPU_CACHE_BATCH 16
+
+struct rmnet_desc_pcpu_cache {
+	struct rmnet_frag_descriptor *descs[RMNET_DESC_PCPU_CACHE_SIZE];
+	u32 count;
+	u64 hit;
+	u64 miss;
+	u64 spill;
+};
+
 struct rmnet_frag_descriptor_pool {
 	struct list_head free_list;
 	u32 pool_size;
+	struct rmnet_desc_pcpu_cache __percpu *pcpu_cache;
+	/* Flushes the cache of a dead CPU back to free_list */
+	struct hlist_node cpuhp_node;
+	struct rmnet_port *port;
 };
 
 struct rmnet_fragment {
@@ -33,6 +51,12 @@ struct rmnet_fragment {
 	skb_frag_t frag;
 };
 
+/* Fragments embedded in each descriptor. Deaggregated packets carry one
+ * and segmented coalesced packets carry two (headers and data), so these
+ * cover the ingress path. Anything beyond falls back to an allocation.
+ */
+#define RMNET_FRAG_DESC_INLINE_FRAGS 4
+
 struct rmnet_frag_descriptor {
 	struct list_head list;
 	struct list_head frags;
@@ -60,6 +84,11 @@ struct rmnet_frag_descriptor {
 	   flush_shs:1,
 	   tcp_flags_set:1,
 	   reserved:2;
+	/* Bitmap of the inline_frags in use. Must stay last before them, as
+	 * recycling only clears the descriptor up to inline_frags.
+	 */
+	u8 inline_map;
+	struct rmnet_fragment inline_frags[RMNET_FRAG_DESC_INLINE_FRAGS];
 };
 
 /* Descriptor management */
@@ -102,6 +131,10 @@ void rmnet_frag_ingress_handler(struct sk_buff *skb,
 
 int rmnet_descriptor_init(struct rmnet_port *port);
 void rmnet_descriptor_deinit(struct rmnet_port *port);
+int rmnet_descriptor_module_init(void);
+void rmnet_descriptor_exit(void);
+void rmnet_descriptor_get_cache_stats(struct rmnet_port *port);
+void rmnet_descriptor_reset_cache_stats(struct rmnet_port *port);
 
 static inline void *rmnet_frag_data_ptr(struct rmnet_frag_descriptor *frag_desc)
 {
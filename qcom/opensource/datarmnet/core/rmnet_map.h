@@ -14,7 +14,9 @@
 #ifndef _RMNET_MAP_H_
 #define _RMNET_MAP_H_
 
+#include <linux/bitops.h>
 #include <linux/skbuff.h>
+#include <net/checksum.h>
 #include "rmnet_config.h"
 
 struct rmnet_map_control_command {
@@ -281,6 +283,78 @@ static inline bool rmnet_map_get_csum_valid(struct sk_buff *skb)
 	return ((struct rmnet_map_v5_csum_header *)data)->csum_valid_required;
 }
 
+/* Software checksum engine shared by the skb and frag descriptor paths.
+ * Data is summed one contiguous chunk at a time, wherever it lives, so
+ * nothing needs to be linearized or copied. 32 bit words are added up in
+ * a 64 bit accumulator, which no packet can overflow, so carries are only
+ * folded once at the end.
+ */
+struct rmnet_map_csum_state {
+	u64 sum;
+	u32 pos;
+};
+
+static inline u32 rmnet_map_csum_fold64(u64 sum)
+{
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	return (u32)sum;
+}
+
+static inline u64 rmnet_map_csum_words(const u8 *data, u32 len)
+{
+	u64 sum = 0;
+	u32 word;
+	u16 half;
+
+	for (; len >= sizeof(word); data += sizeof(word), len -= sizeof(word)) {
+		memcpy(&word, data, sizeof(word));
+		sum += word;
+	}
+
+	if (len & 2) {
+		memcpy(&half, data, sizeof(half));
+		sum += half;
+		data += sizeof(half);
+	}
+
+	/* A trailing byte is the first one of a 16 bit word */
+	if (len & 1) {
+#ifdef __LITTLE_ENDIAN
+		sum += *data;
+#else
+		sum += (u32)*data << 8;
+#endif
+	}
+
+	return sum;
+}
+
+static inline void rmnet_map_csum_add(struct rmnet_map_csum_state *state,
+				      const void *addr, u32 len)
+{
+	u64 sum = rmnet_map_csum_words(addr, len);
+
+	/* A chunk starting at an odd position was summed with the bytes of
+	 * each 16 bit word swapped.
+	 */
+	if (unlikely(state->pos & 1))
+		sum = ror32(rmnet_map_csum_fold64(sum), 8);
+
+	state->sum += sum;
+	state->pos += len;
+}
+
+static inline bool rmnet_map_csum_valid(struct rmnet_map_csum_state *state)
+{
+	return !csum_fold((__force __wsum)rmnet_map_csum_fold64(state->sum));
+}
+
+void rmnet_map_csum_start(struct rmnet_map_csum_state *state, u8 ip_proto,
+			  void *iph, u32 datagram_len, u8 trans_proto);
+int rmnet_map_csum_skb(struct rmnet_map_csum_state *state,
+		       struct sk_buff *skb, u32 offset, u32 len);
+
 struct sk_buff *rmnet_map_deaggregate(struct sk_buff *skb,
 				      struct rmnet_port *port);
 struct rmnet_map_header *rmnet_map_add_map_header(struct sk_buff *skb,
@@ -29,6 +29,13 @@
 #define RMNET_MAP_DEAGGR_SPACING  64
 #define RMNET_MAP_DEAGGR_HEADROOM (RMNET_MAP_DEAGGR_SPACING / 2)
 #define RMNET_PAGE_COUNT 384
+#define RMNET_PAGE_COUNT_MIN 64
+#define RMNET_PAGE_COUNT_MAX 1024
+#define RMNET_PAGE_COUNT_STEP 64
+/* Number of recycler lookups between two ring size adjustments */
+#define RMNET_PAGE_ADAPT_WINDOW 256
+/* Grow the ring if fewer lookups than this (in %) found a free page */
+#define RMNET_PAGE_GROW_REUSE_PCT 90
 
 struct rmnet_map_coal_metadata {
 	void *ip_header;
@@ -878,32 +885,100 @@ __rmnet_map_segment_coal_skb(struct sk_buff *coal_skb,
 	coal_meta->pkt_count = 0;
 }
 
-static bool rmnet_map_validate_csum(struct sk_buff *skb,
-				    struct rmnet_map_coal_metadata *meta)
+/* Seed the engine with the pseudo header of a TCP/UDP datagram */
+void rmnet_map_csum_start(struct rmnet_map_csum_state *state, u8 ip_proto,
+			  void *iph, u32 datagram_len, u8 trans_proto)
 {
-	u8 *data = rmnet_map_data_ptr(skb);
-	unsigned int datagram_len;
-	__wsum csum;
 	__sum16 pseudo;
 
-	datagram_len = skb->len - meta->ip_len;
-	if (meta->ip_proto == 4) {
-		struct iphdr *iph = (struct iphdr *)data;
+	if (ip_proto == 4) {
+		struct iphdr *ip4h = iph;
 
-		pseudo = ~csum_tcpudp_magic(iph->saddr, iph->daddr,
-					    datagram_len,
-					    meta->trans_proto, 0);
+		pseudo = ~csum_tcpudp_magic(ip4h->saddr, ip4h->daddr,
+					    datagram_len, trans_proto, 0);
 	} else {
-		struct ipv6hdr *ip6h = (struct ipv6hdr *)data;
+		struct ipv6hdr *ip6h = iph;
 
 		pseudo = ~csum_ipv6_magic(&ip6h->saddr, &ip6h->daddr,
-					  datagram_len, meta->trans_proto,
-					  0);
+					  datagram_len, trans_proto, 0);
 	}
 
-	csum = skb_checksum(skb, meta->ip_len, datagram_len,
-			    csum_unfold(pseudo));
-	return !csum_fold(csum);
+	state->sum = (__force u32)csum_unfold(pseudo);
+	state->pos = 0;
+}
+EXPORT_SYMBOL(rmnet_map_csum_start);
+
+/* Fold len bytes at offset into the checksum, walking the linear area,
+ * the page frags and the frag_list in place.
+ */
+int rmnet_map_csum_skb(struct rmnet_map_csum_state *state,
+		       struct sk_buff *skb, u32 offset, u32 len)
+{
+	struct skb_shared_info *shinfo = skb_shinfo(skb);
+	struct sk_buff *frag_iter;
+	u32 chunk;
+	int i;
+
+	chunk = skb_headlen(skb);
+	if (offset < chunk) {
+		chunk = min_t(u32, chunk - offset, len);
+		rmnet_map_csum_add(state, skb->data + offset, chunk);
+		len -= chunk;
+		offset = 0;
+	} else {
+		offset -= chunk;
+	}
+
+	for (i = 0; len && i < shinfo->nr_frags; i++) {
+		skb_frag_t *frag = &shinfo->frags[i];
+		u32 frag_size = skb_frag_size(frag);
+
+		if (offset >= frag_size) {
+			offset -= frag_size;
+			continue;
+		}
+
+		chunk = min_t(u32, frag_size - offset, len);
+		rmnet_map_csum_add(state, skb_frag_address(frag) + offset,
+				   chunk);
+		len -= chunk;
+		offset = 0;
+	}
+
+	skb_walk_frags(skb, frag_iter) {
+		if (!len)
+			break;
+
+		if (offset >= frag_iter->len) {
+			offset -= frag_iter->len;
+			continue;
+		}
+
+		chunk = min_t(u32, frag_iter->len - offset, len);
+		if (rmnet_map_csum_skb(state, frag_iter, offset, chunk))
+			return -EINVAL;
+
+		len -= chunk;
+		offset = 0;
+	}
+
+	return len ? -EINVAL : 0;
+}
+EXPORT_SYMBOL(rmnet_map_csum_skb);
+
+static bool rmnet_map_validate_csum(struct sk_buff *skb,
+				    struct rmnet_map_coal_metadata *meta)
+{
+	struct rmnet_map_csum_state state;
+	unsigned int datagram_len;
+
+	datagram_len = skb->len - meta->ip_len;
+	rmnet_map_csum_start(&state, meta->ip_proto, rmnet_map_data_ptr(skb),
+			     datagram_len, meta->trans_proto);
+	if (rmnet_map_csum_skb(&state, skb, meta->ip_len, datagram_len))
+		return false;
+
+	return rmnet_map_csum_valid(&state);
 }
 
 /* Converts the coalesced SKB into a list of SKBs.
@@ -1339,12 +1414,245 @@ static void rmnet_free_agg_pages(struct rmnet_aggregation_state *state)
 	}
 
 	state->agg_head = NULL;
+	state->agg_ring_size = 0;
+	state->agg_window_reuse = 0;
+	state->agg_window_alloc = 0;
+	state->agg_in_flight = 0;
+	state->agg_resize = 0;
+}
+
+static struct rmnet_agg_page *
+rmnet_agg_page_next(struct rmnet_aggregation_state *state,
+		    struct rmnet_agg_page *agg_page)
+{
+	/* Wrap around without landing on the list head */
+	if (list_is_last(&agg_page->list, &state->agg_list))
+		return list_first_entry(&state->agg_list,
+					struct rmnet_agg_page, list);
+
+	return list_next_entry(agg_page, list);
+}
+
+static struct rmnet_agg_page *
+__rmnet_alloc_agg_pages(u8 order, gfp_t gfp)
+{
+	struct rmnet_agg_page *agg_page;
+	struct page *page;
+	int rc;
+	int pageorder = 2;
+
+	agg_page = kzalloc(sizeof(*agg_page), gfp);
+	if (!agg_page)
+		return NULL;
+
+	page = rmnet_mem_get_pages_entry(gfp, order, &rc, &pageorder,
+					 RMNET_CORE_ID);
+
+	if (!page) {
+		kfree(agg_page);
+		return NULL;
+	}
+
+	agg_page->page = page;
+	agg_page->last_use = ktime_get();
+	INIT_LIST_HEAD(&agg_page->list);
+
+	return agg_page;
+}
+
+static void rmnet_agg_update_wait_hist(struct rmnet_aggregation_state *state,
+				       struct rmnet_agg_page *agg_page,
+				       ktime_t now)
+{
+	s64 wait_us = ktime_us_delta(now, agg_page->last_use);
+	int index = 0;
+
+	while (index < 5 && wait_us >= 100) {
+		wait_us /= 10;
+		index++;
+	}
+
+	state->stats->ul_agg_wait_hist[index]++;
+}
+
+static void rmnet_agg_update_hist(struct rmnet_aggregation_state *state,
+				  u32 reuse_pct, u32 allocs)
+{
+	struct rmnet_agg_stats *stats = state->stats;
+	int index;
+
+	if (reuse_pct < 50)
+		index = 0;
+	else if (reuse_pct < 75)
+		index = 1;
+	else if (reuse_pct < 90)
+		index = 2;
+	else if (reuse_pct < 99)
+		index = 3;
+	else
+		index = 4;
+	stats->ul_agg_reuse_hist[index]++;
+
+	if (!allocs)
+		index = 0;
+	else if (allocs <= 8)
+		index = 1;
+	else if (allocs <= 32)
+		index = 2;
+	else if (allocs <= 128)
+		index = 3;
+	else
+		index = 4;
+	stats->ul_agg_alloc_hist[index]++;
+
+	if (state->agg_ring_size <= 64)
+		index = 0;
+	else if (state->agg_ring_size <= 128)
+		index = 1;
+	else if (state->agg_ring_size <= 256)
+		index = 2;
+	else if (state->agg_ring_size <= 512)
+		index = 3;
+	else
+		index = 4;
+	stats->ul_agg_ring_hist[index]++;
+}
+
+/* Decide once per window whether the recycling ring should grow or
+ * shrink. Grow it when lookups keep missing because most of the ring is
+ * still in flight, and hand idle pages back when most of the ring sits
+ * unused. The resize itself is left to rmnet_agg_resize_work().
+ */
+static void rmnet_agg_adapt_ring(struct rmnet_aggregation_state *state)
+{
+	u32 reuse = state->agg_window_reuse;
+	u32 allocs = state->agg_window_alloc;
+	u32 reuse_pct = reuse * 100 / (reuse + allocs);
+	u32 in_flight = state->agg_in_flight;
+
+	state->agg_window_reuse = 0;
+	state->agg_window_alloc = 0;
+
+	rmnet_agg_update_hist(state, reuse_pct, allocs);
+
+	if (reuse_pct < RMNET_PAGE_GROW_REUSE_PCT &&
+	    in_flight * 4 >= state->agg_ring_size * 3 &&
+	    state->agg_ring_size < RMNET_PAGE_COUNT_MAX)
+		state->agg_resize = 1;
+	else if (in_flight * 4 < state->agg_ring_size &&
+		 state->agg_ring_size > RMNET_PAGE_COUNT_MIN)
+		state->agg_resize = -1;
+	else
+		return;
+
+	schedule_work(&state->agg_resize_wq);
+}
+
+static void rmnet_agg_grow_ring(struct rmnet_aggregation_state *state)
+{
+	struct rmnet_agg_page *agg_page, *tmp;
+	LIST_HEAD(new_pages);
+	u8 order;
+	int i;
+
+	spin_lock_bh(&state->agg_lock);
+	order = state->agg_size_order;
+	spin_unlock_bh(&state->agg_lock);
+
+	for (i = 0; i < RMNET_PAGE_COUNT_STEP; i++) {
+		agg_page = __rmnet_alloc_agg_pages(order, GFP_KERNEL);
+		if (!agg_page)
+			break;
+
+		list_add_tail(&agg_page->list, &new_pages);
+	}
+
+	spin_lock_bh(&state->agg_lock);
+	/* Drop the pages if the ring was reconfigured meanwhile */
+	if (state->agg_head && state->agg_size_order == order &&
+	    (state->params.agg_features & RMNET_PAGE_RECYCLE)) {
+		i = 0;
+		list_for_each_entry_safe(agg_page, tmp, &new_pages, list) {
+			if (state->agg_ring_size >= RMNET_PAGE_COUNT_MAX)
+				break;
+
+			/* Behind the head, so that they are probed last */
+			list_move_tail(&agg_page->list,
+				       &state->agg_head->list);
+			state->agg_ring_size++;
+			i++;
+		}
+
+		if (i)
+			state->stats->ul_agg_ring_grow++;
+	}
+	spin_unlock_bh(&state->agg_lock);
+
+	list_for_each_entry_safe(agg_page, tmp, &new_pages, list) {
+		list_del(&agg_page->list);
+		rmnet_mem_put_page_entry(agg_page->page);
+		kfree(agg_page);
+	}
+}
+
+static void rmnet_agg_shrink_ring(struct rmnet_aggregation_state *state)
+{
+	struct rmnet_agg_page *agg_page, *tmp;
+	LIST_HEAD(idle_pages);
+	int i = 0;
+
+	spin_lock_bh(&state->agg_lock);
+	list_for_each_entry_safe(agg_page, tmp, &state->agg_list, list) {
+		if (i == RMNET_PAGE_COUNT_STEP ||
+		    state->agg_ring_size <= RMNET_PAGE_COUNT_MIN)
+			break;
+
+		if (agg_page == state->agg_head ||
+		    page_ref_count(agg_page->page) != 1)
+			continue;
+
+		if (agg_page->in_flight)
+			state->agg_in_flight--;
+		list_move_tail(&agg_page->list, &idle_pages);
+		state->agg_ring_size--;
+		i++;
+	}
+
+	if (i)
+		state->stats->ul_agg_ring_shrink++;
+	spin_unlock_bh(&state->agg_lock);
+
+	list_for_each_entry_safe(agg_page, tmp, &idle_pages, list) {
+		list_del(&agg_page->list);
+		rmnet_mem_put_page_entry(agg_page->page);
+		kfree(agg_page);
+	}
+}
+
+static void rmnet_agg_resize_work(struct work_struct *work)
+{
+	struct rmnet_aggregation_state *state;
+	int resize;
+
+	state = container_of(work, struct rmnet_aggregation_state,
+			     agg_resize_wq);
+
+	spin_lock_bh(&state->agg_lock);
+	resize = state->agg_resize;
+	state->agg_resize = 0;
+	spin_unlock_bh(&state->agg_lock);
+
+	if (resize > 0)
+		rmnet_agg_grow_ring(state);
+	else if (resize < 0)
+		rmnet_agg_shrink_ring(state);
 }
 
 static struct page *rmnet_get_agg_pages(struct rmnet_aggregation_state *state)
 {
 	struct rmnet_agg_page *agg_page;
 	struct page *page = NULL;
+	ktime_t now;
 	int i = 0;
 	int rc;
 	int pageorder = 2;
@@ -1352,24 +1660,44 @@ static struct page *rmnet_get_agg_pages(struct rmnet_aggregation_state *state)
 	if (!(state->params.agg_features & RMNET_PAGE_RECYCLE))
 		goto alloc;
 
-	do {
-		agg_page = state->agg_head;
-		if (unlikely(!agg_page))
-			break;
+	agg_page = state->agg_head;
+	if (unlikely(!agg_page))
+		goto alloc;
 
+	now = ktime_get();
+	do {
 		if (page_ref_count(agg_page->page) == 1) {
+			/* Back from the stack since it was last handed out */
+			if (agg_page->in_flight) {
+				agg_page->in_flight = false;
+				state->agg_in_flight--;
+			}
+
 			page = agg_page->page;
 			page_ref_inc(agg_page->page);
+			agg_page->in_flight = true;
+			state->agg_in_flight++;
 
 			state->stats->ul_agg_reuse++;
-			state->agg_head = list_next_entry(agg_page, list);
+			state->agg_window_reuse++;
+			rmnet_agg_update_wait_hist(state, agg_page, now);
+			agg_page->last_use = now;
+			state->agg_head = rmnet_agg_page_next(state, agg_page);
 			break;
 		}
 
-		state->agg_head = list_next_entry(agg_page, list);
+		agg_page = rmnet_agg_page_next(state, agg_page);
+		state->agg_head = agg_page;
 		i++;
 	} while (i <= 5);
 
+	if (!page)
+		state->agg_window_alloc++;
+
+	if (state->agg_window_reuse + state->agg_window_alloc >=
+	    RMNET_PAGE_ADAPT_WINDOW)
+		rmnet_agg_adapt_ring(state);
+
 alloc:
 	if (!page) {
 		page = rmnet_mem_get_pages_entry(GFP_ATOMIC, state->agg_size_order, &rc,
@@ -1381,42 +1709,19 @@ alloc:
 	return page;
 }
 
-static struct rmnet_agg_page *
-__rmnet_alloc_agg_pages(struct rmnet_aggregation_state *state)
-{
-	struct rmnet_agg_page *agg_page;
-	struct page *page;
-	int rc;
-	int pageorder = 2;
-
-	agg_page = kzalloc(sizeof(*agg_page), GFP_ATOMIC);
-	if (!agg_page)
-		return NULL;
-
-	page = rmnet_mem_get_pages_entry(GFP_ATOMIC, state->agg_size_order, &rc,
-					 &pageorder, RMNET_CORE_ID);
-
-	if (!page) {
-		kfree(agg_page);
-		return NULL;
-	}
-
-	agg_page->page = page;
-	INIT_LIST_HEAD(&agg_page->list);
-
-	return agg_page;
-}
-
 static void rmnet_alloc_agg_pages(struct rmnet_aggregation_state *state)
 {
 	struct rmnet_agg_page *agg_page = NULL;
 	int i = 0;
 
 	for (i = 0; i < RMNET_PAGE_COUNT; i++) {
-		agg_page = __rmnet_alloc_agg_pages(state);
+		agg_page = __rmnet_alloc_agg_pages(state->agg_size_order,
+						   GFP_ATOMIC);
 
-		if (agg_page)
+		if (agg_page) {
 			list_add_tail(&agg_page->list, &state->agg_list);
+			state->agg_ring_size++;
+		}
 	}
 
 	state->agg_head = list_first_entry_or_null(&state->agg_list,
@@ -1594,6 +1899,7 @@ void rmnet_map_tx_aggregate_init(struct rmnet_port *port)
 			     HRTIMER_MODE_REL);
 		state->hrtimer.function = rmnet_map_flush_tx_packet_queue;
 		INIT_WORK(&state->agg_wq, rmnet_map_flush_tx_packet_work);
+		INIT_WORK(&state->agg_resize_wq, rmnet_agg_resize_work);
 		state->stats = &port->stats.agg;
 
 		/* Since PAGE_SIZE - 1 is specified here, no pages are
@@ -1619,6 +1925,7 @@ void rmnet_map_tx_aggregate_exit(struct rmnet_port *port)
 
 		hrtimer_cancel(&state->hrtimer);
 		cancel_work_sync(&state->agg_wq);
+		cancel_work_sync(&state->agg_resize_wq);
 	}
 
 	for (i = RMNET_DEFAULT_AGG_STATE; i < RMNET_MAX_AGG_STATE; i++) {
@@ -30,6 +30,7 @@
 #include "rmnet_handlers.h"
 #include "rmnet_private.h"
 #include "rmnet_map.h"
+#include "rmnet_descriptor.h"
 #include "rmnet_vnd.h"
 #include "rmnet_genl.h"
 #include "rmnet_ll.h"
@@ -561,6 +562,29 @@ static const char rmnet_port_gstrings_stats[][ETH_GSTRING_LEN] = {
 	"DL trailer pkts received",
 	"UL agg reuse",
 	"UL agg alloc",
+	"UL agg ring grow",
+	"UL agg ring shrink",
+	"UL agg reuse % [0-50)",
+	"UL agg reuse % [50-75)",
+	"UL agg reuse % [75-90)",
+	"UL agg reuse % [90-99)",
+	"UL agg reuse % [99-100]",
+	"UL agg allocs = 0",
+	"UL agg allocs [1-8]",
+	"UL agg allocs [9-32]",
+	"UL agg allocs [33-128]",
+	"UL agg allocs > 128",
+	"UL agg ring <= 64",
+	"UL agg ring (64-128]",
+	"UL agg ring (128-256]",
+	"UL agg ring (256-512]",
+	"UL agg ring > 512",
+	"UL agg page wait < 100us",
+	"UL agg page wait < 1ms",
+	"UL agg page wait < 10ms",
+	"UL agg page wait < 100ms",
+	"UL agg page wait < 1s",
+	"UL agg page wait >= 1s",
 	"DL chaining [0-10)",
 	"DL chaining [10-20)",
 	"DL chaining [20-30)",
@@ -578,6 +602,12 @@ static const char rmnet_port_gstrings_stats[][ETH_GSTRING_LEN] = {
 	"PB Byte Marker Seq",
 	"Chained packets received",
 	"Packets chained",
+	"Desc cache hit",
+	"Desc cache miss",
+	"Desc cache spill",
+	"Frag cache hit",
+	"Frag cache miss",
+	"Frag cache spill",
 };
 
 static const char rmnet_ll_gstrings_stats[][ETH_GSTRING_LEN] = {
@@ -658,6 +688,7 @@ static void rmnet_get_ethtool_stats(struct net_device *dev,
 	if (!data || !port)
 		return;
 
+	rmnet_descriptor_get_cache_stats(port);
 	stp = &port->stats;
 	llp = rmnet_ll_get_stats();
 
@@ -690,6 +721,7 @@ static int rmnet_stats_reset(struct net_device *dev)
 	stp = &port->stats;
 
 	memset(stp, 0, sizeof(*stp));
+	rmnet_descriptor_reset_cache_stats(port);
 
 	st = &priv->stats;
 
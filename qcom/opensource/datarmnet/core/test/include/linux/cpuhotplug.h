@@ -0,0 +1,2 @@
+/* Host build, see rmnet_test_kernel.h */
+#include "rmnet_test_kernel.h"
@@ -0,0 +1,672 @@
+/* Copyright (c) 2023, Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 and
+ * only version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * RMNET host test kernel environment
+ *
+ * Just enough of the kernel API to build the rmnet core sources as user
+ * space programs. Everything runs on one CPU, locks are no-ops and pages
+ * are malloc'ed buffers. Helpers the tests never reach abort.
+ */
+#ifndef _RMNET_TEST_KERNEL_H_
+#define _RMNET_TEST_KERNEL_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
+typedef uint8_t __u8;
+typedef uint16_t __u16;
+typedef uint32_t __u32;
+typedef uint64_t __u64;
+typedef uint16_t __be16;
+typedef uint32_t __be32;
+typedef uint64_t __be64;
+typedef uint16_t __le16;
+typedef uint32_t __le32;
+typedef uint16_t __sum16;
+typedef uint32_t __wsum;
+typedef unsigned int gfp_t;
+typedef long long ktime_t;
+typedef struct { int counter; } atomic_t;
+typedef struct { int rlock; } spinlock_t;
+
+#define __force
+#define __percpu
+#define __rcu
+#define __init
+#define __exit
+#define likely(x) __builtin_expect(!!(x), 1)
+#define unlikely(x) __builtin_expect(!!(x), 0)
+#define EXPORT_SYMBOL(x)
+#define BIT(n) (1UL << (n))
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+#define GFP_ATOMIC 0
+#define GFP_KERNEL 0
+#define READ_ONCE(x) (x)
+#define WRITE_ONCE(x, v) ((x) = (v))
+
+#define container_of(ptr, type, member) \
+	((type *)((char *)(ptr) - offsetof(type, member)))
+#define min_t(t, a, b) ((t)(a) < (t)(b) ? (t)(a) : (t)(b))
+#define max_t(t, a, b) ((t)(a) > (t)(b) ? (t)(a) : (t)(b))
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+
+static inline unsigned long __ffs(unsigned long w)
+{
+	return __builtin_ctzl(w);
+}
+
+static inline u32 ror32(u32 word, unsigned int shift)
+{
+	return (word >> (shift & 31)) | (word << ((-shift) & 31));
+}
+
+/* Lists */
+struct list_head {
+	struct list_head *next, *prev;
+};
+
+struct hlist_node {
+	struct hlist_node *next, **pprev;
+};
+
+struct hlist_head {
+	struct hlist_node *first;
+};
+
+#define LIST_HEAD_INIT(name) { &(name), &(name) }
+#define LIST_HEAD(name) struct list_head name = LIST_HEAD_INIT(name)
+
+static inline void INIT_LIST_HEAD(struct list_head *list)
+{
+	list->next = list;
+	list->prev = list;
+}
+
+static inline void __list_add(struct list_head *new, struct list_head *prev,
+			      struct list_head *next)
+{
+	next->prev = new;
+	new->next = next;
+	new->prev = prev;
+	prev->next = new;
+}
+
+static inline void list_add(struct list_head *new, struct list_head *head)
+{
+	__list_add(new, head, head->next);
+}
+
+static inline void list_add_tail(struct list_head *new,
+				 struct list_head *head)
+{
+	__list_add(new, head->prev, head);
+}
+
+static inline void list_del(struct list_head *entry)
+{
+	entry->next->prev = entry->prev;
+	entry->prev->next = entry->next;
+	entry->next = NULL;
+	entry->prev = NULL;
+}
+
+static inline void list_del_init(struct list_head *entry)
+{
+	entry->next->prev = entry->prev;
+	entry->prev->next = entry->next;
+	INIT_LIST_HEAD(entry);
+}
+
+static inline int list_empty(const struct list_head *head)
+{
+	return head->next == head;
+}
+
+static inline void list_splice_init(struct list_head *list,
+				    struct list_head *head)
+{
+	if (!list_empty(list)) {
+		struct list_head *first = list->next, *last = list->prev;
+
+		first->prev = head;
+		last->next = head->next;
+		head->next->prev = last;
+		head->next = first;
+		INIT_LIST_HEAD(list);
+	}
+}
+
+static inline void list_splice_tail_init(struct list_head *list,
+					 struct list_head *head)
+{
+	if (!list_empty(list)) {
+		struct list_head *first = list->next, *last = list->prev;
+
+		first->prev = head->prev;
+		head->prev->next = first;
+		last->next = head;
+		head->prev = last;
+		INIT_LIST_HEAD(list);
+	}
+}
+
+static inline void list_move_tail(struct list_head *list,
+				  struct list_head *head)
+{
+	list_del(list);
+	list_add_tail(list, head);
+}
+
+#define list_entry(ptr, type, member) container_of(ptr, type, member)
+#define list_first_entry(ptr, type, member) \
+	list_entry((ptr)->next, type, member)
+#define list_last_entry(ptr, type, member) \
+	list_entry((ptr)->prev, type, member)
+#define list_next_entry(pos, member) \
+	list_entry((pos)->member.next, __typeof__(*(pos)), member)
+#define list_for_each_entry(pos, head, member) \
+	for (pos = list_first_entry(head, __typeof__(*pos), member); \
+	     &pos->member != (head); pos = list_next_entry(pos, member))
+#define list_prev_entry(pos, member) \
+	list_entry((pos)->member.prev, __typeof__(*(pos)), member)
+#define list_first_entry_or_null(ptr, type, member) \
+	(!list_empty(ptr) ? list_first_entry(ptr, type, member) : NULL)
+#define list_for_each_entry_safe_reverse(pos, n, head, member) \
+	for (pos = list_last_entry(head, __typeof__(*pos), member), \
+	     n = list_prev_entry(pos, member); &pos->member != (head); \
+	     pos = n, n = list_prev_entry(n, member))
+#define list_for_each_entry_safe(pos, n, head, member) \
+	for (pos = list_first_entry(head, __typeof__(*pos), member), \
+	     n = list_next_entry(pos, member); &pos->member != (head); \
+	     pos = n, n = list_next_entry(n, member))
+
+#define INIT_HLIST_HEAD(ptr) ((ptr)->first = NULL)
+#define hlist_entry(ptr, type, member) container_of(ptr, type, member)
+
+static inline int hlist_unhashed(const struct hlist_node *h)
+{
+	return !h->pprev;
+}
+
+/* Memory */
+static inline void *kzalloc(size_t size, gfp_t flags)
+{
+	return calloc(1, size);
+}
+
+static inline void *kmalloc(size_t size, gfp_t flags)
+{
+	return malloc(size);
+}
+
+static inline void kfree(const void *p)
+{
+	free((void *)p);
+}
+
+static inline void kfree_bulk(size_t size, void **p)
+{
+	while (size--)
+		free(p[size]);
+}
+
+/* Everything runs on CPU 0 */
+#define DEFINE_PER_CPU(type, name) type name
+#define this_cpu_ptr(ptr) (ptr)
+#define per_cpu_ptr(ptr, cpu) ((void)(cpu), (ptr))
+#define for_each_possible_cpu(cpu) for ((cpu) = 0; (cpu) < 1; (cpu)++)
+#define alloc_percpu(type) ((type *)calloc(1, sizeof(type)))
+#define free_percpu(ptr) free(ptr)
+
+#define local_irq_save(flags) ((void)(flags))
+#define local_irq_restore(flags) ((void)(flags))
+#define spin_lock_init(l) ((void)(l))
+#define spin_lock(l) ((void)(l))
+#define spin_unlock(l) ((void)(l))
+#define spin_lock_bh(l) ((void)(l))
+#define spin_unlock_bh(l) ((void)(l))
+#define spin_lock_irqsave(l, f) ((void)(l), (void)(f))
+#define spin_unlock_irqrestore(l, f) ((void)(l), (void)(f))
+#define rcu_read_lock()
+#define rcu_read_unlock()
+#define rcu_dereference(p) (p)
+
+/* CPU hotplug, rmnet_test_cpu_dead() runs the dead callbacks */
+enum cpuhp_state {
+	CPUHP_BP_PREPARE_DYN = 1,
+};
+
+int cpuhp_setup_state_nocalls(enum cpuhp_state state, const char *name,
+			      int (*startup)(unsigned int cpu),
+			      int (*teardown)(unsigned int cpu));
+int cpuhp_setup_state_multi(enum cpuhp_state state, const char *name,
+			    int (*startup)(unsigned int cpu,
+					   struct hlist_node *node),
+			    int (*teardown)(unsigned int cpu,
+					    struct hlist_node *node));
+int cpuhp_state_add_instance_nocalls(enum cpuhp_state state,
+				     struct hlist_node *node);
+int cpuhp_state_remove_instance_nocalls(enum cpuhp_state state,
+					struct hlist_node *node);
+void cpuhp_remove_state_nocalls(enum cpuhp_state state);
+void cpuhp_remove_multi_state(enum cpuhp_state state);
+void rmnet_test_cpu_dead(unsigned int cpu);
+
+/* Misc */
+#define __read_mostly
+#define __aligned(x) __attribute__((__aligned__(x)))
+#define __packed __attribute__((__packed__))
+#define __LITTLE_ENDIAN 1234
+#define __LITTLE_ENDIAN_BITFIELD
+#define IFNAMSIZ 16
+#define INET6_ADDRSTRLEN 48
+#define pr_info(fmt, ...) ((void)0)
+#define pr_err(fmt, ...) ((void)0)
+#define netdev_dbg(dev, fmt, ...) ((void)0)
+#define do_div(n, base) ({ u32 __rem = (n) % (base); (n) /= (base); __rem; })
+
+static inline u16 htons(u16 x) { return __builtin_bswap16(x); }
+static inline u16 ntohs(u16 x) { return __builtin_bswap16(x); }
+static inline u32 htonl(u32 x) { return __builtin_bswap32(x); }
+static inline u32 ntohl(u32 x) { return __builtin_bswap32(x); }
+
+struct timespec64 { s64 tv_sec; long tv_nsec; };
+struct hrtimer { int unused; };
+struct work_struct { int unused; };
+struct delayed_work { struct work_struct work; };
+struct u64_stats_sync { int unused; };
+struct napi_struct { int unused; };
+struct gro_cells { void *cells; };
+struct rtnl_link_ops { int unused; };
+struct net_device;
+struct netlink_ext_ack;
+struct sk_buff_head;
+
+/* Pages are malloc'ed buffers with a reference count */
+struct page {
+	int refcount;
+	unsigned int size;
+	void *addr;
+};
+
+static inline void get_page(struct page *page)
+{
+	page->refcount++;
+}
+
+void put_page(struct page *page);
+struct page *rmnet_test_alloc_page(unsigned int size);
+void rmnet_test_free_page(struct page *page);
+
+static inline unsigned long page_size(struct page *page)
+{
+	return page->size;
+}
+
+static inline unsigned long page_to_pfn(struct page *page)
+{
+	return (unsigned long)page;
+}
+
+static inline void *page_address(struct page *page)
+{
+	return page->addr;
+}
+
+typedef struct {
+	struct page *bv_page;
+	unsigned int bv_len;
+	unsigned int bv_offset;
+} skb_frag_t;
+
+static inline void __skb_frag_set_page(skb_frag_t *frag, struct page *page)
+{
+	frag->bv_page = page;
+}
+
+static inline struct page *skb_frag_page(const skb_frag_t *frag)
+{
+	return frag->bv_page;
+}
+
+static inline unsigned int skb_frag_size(const skb_frag_t *frag)
+{
+	return frag->bv_len;
+}
+
+static inline void skb_frag_size_set(skb_frag_t *frag, unsigned int size)
+{
+	frag->bv_len = size;
+}
+
+static inline void skb_frag_size_sub(skb_frag_t *frag, int delta)
+{
+	frag->bv_len -= delta;
+}
+
+static inline unsigned int skb_frag_off(const skb_frag_t *frag)
+{
+	return frag->bv_offset;
+}
+
+static inline void skb_frag_off_set(skb_frag_t *frag, unsigned int offset)
+{
+	frag->bv_offset = offset;
+}
+
+static inline void skb_frag_off_add(skb_frag_t *frag, int delta)
+{
+	frag->bv_offset += delta;
+}
+
+static inline void *skb_frag_address(const skb_frag_t *frag)
+{
+	return (char *)page_address(skb_frag_page(frag)) + skb_frag_off(frag);
+}
+
+/* Socket buffers, the frags sit right after the sk_buff */
+#define MAX_SKB_FRAGS 17
+#define CHECKSUM_NONE 0
+#define CHECKSUM_UNNECESSARY 1
+#define CHECKSUM_COMPLETE 2
+#define CHECKSUM_PARTIAL 3
+#define SKB_GSO_TCPV4 (1 << 0)
+#define SKB_GSO_TCPV6 (1 << 4)
+#define SKB_GSO_UDP_L4 (1 << 17)
+#define NETIF_F_RXCSUM (1ULL << 0)
+#define NETIF_F_GRO_HW (1ULL << 1)
+#define ETH_P_IP 0x0800
+#define ETH_P_IPV6 0x86DD
+#define ETH_P_MAP 0xDA1A
+#define IPPROTO_ICMP 1
+#define IPPROTO_TCP 6
+#define IPPROTO_UDP 17
+#define IPPROTO_ICMPV6 58
+#define NEXTHDR_HOP 0
+#define NEXTHDR_ROUTING 43
+#define NEXTHDR_FRAGMENT 44
+#define NEXTHDR_AUTH 51
+#define NEXTHDR_NONE 59
+#define NEXTHDR_DEST 60
+#define IP_MF 0x2000
+#define IP_OFFSET 0x1FFF
+
+/* uapi/linux/if_link.h */
+#define RMNET_FLAGS_INGRESS_DEAGGREGATION (1U << 0)
+#define RMNET_FLAGS_INGRESS_MAP_COMMANDS (1U << 1)
+#define RMNET_FLAGS_INGRESS_MAP_CKSUMV4 (1U << 2)
+#define RMNET_FLAGS_EGRESS_MAP_CKSUMV4 (1U << 3)
+
+typedef int rx_handler_result_t;
+#define RX_HANDLER_CONSUMED 0
+#define RX_HANDLER_PASS 3
+
+struct sk_buff {
+	struct sk_buff *next;
+	struct net_device *dev;
+	unsigned int len;
+	unsigned int data_len;
+	u32 priority;
+	u32 hash;
+	u8 ip_summed;
+	u8 sw_hash;
+	__be16 protocol;
+	u16 csum_start;
+	u16 csum_offset;
+	u16 transport_header;
+	u16 network_header;
+	unsigned char *head;
+	unsigned char *data;
+	char cb[48];
+};
+
+struct skb_shared_info {
+	u8 nr_frags;
+	unsigned short gso_size;
+	unsigned short gso_segs;
+	unsigned int gso_type;
+	struct sk_buff *frag_list;
+	skb_frag_t frags[MAX_SKB_FRAGS];
+};
+
+struct skb_shared_info *skb_shinfo(const struct sk_buff *skb);
+
+#define skb_walk_frags(skb, iter) \
+	for (iter = skb_shinfo(skb)->frag_list; iter; iter = iter->next)
+
+static inline bool skb_is_nonlinear(const struct sk_buff *skb)
+{
+	return skb->data_len;
+}
+
+struct sk_buff *alloc_skb(unsigned int size, gfp_t priority);
+struct sk_buff *rmnet_test_alloc_frag_skb(void);
+void rmnet_test_skb_add_frag(struct sk_buff *skb, struct page *page,
+			     unsigned int off, unsigned int size);
+void consume_skb(struct sk_buff *skb);
+void *skb_put(struct sk_buff *skb, unsigned int len);
+void skb_reserve(struct sk_buff *skb, int len);
+void skb_reset_network_header(struct sk_buff *skb);
+void skb_set_transport_header(struct sk_buff *skb, const int offset);
+int skb_transport_offset(const struct sk_buff *skb);
+void *__pskb_pull_tail(struct sk_buff *skb, int delta);
+int skb_copy_bits(const struct sk_buff *skb, int offset, void *to, int len);
+void skb_add_rx_frag(struct sk_buff *skb, int i, struct page *page,
+		     int off, int size, unsigned int truesize);
+__wsum skb_checksum(const struct sk_buff *skb, int offset, int len,
+		    __wsum csum);
+
+/* Network devices */
+struct net_device_ops {
+	int (*ndo_start_xmit)(struct sk_buff *skb, struct net_device *dev);
+};
+
+struct net_device {
+	char name[IFNAMSIZ];
+	u64 features;
+	const struct net_device_ops *netdev_ops;
+};
+
+void *netdev_priv(const struct net_device *dev);
+void netif_tx_lock(struct net_device *dev);
+void netif_tx_unlock(struct net_device *dev);
+
+/* Protocol headers */
+struct iphdr {
+	u8 ihl:4,
+	   version:4;
+	u8 tos;
+	__be16 tot_len;
+	__be16 id;
+	__be16 frag_off;
+	u8 ttl;
+	u8 protocol;
+	__sum16 check;
+	__be32 saddr;
+	__be32 daddr;
+};
+
+struct in6_addr {
+	u8 s6_addr[16];
+};
+
+struct ipv6hdr {
+	u8 priority:4,
+	   version:4;
+	u8 flow_lbl[3];
+	__be16 payload_len;
+	u8 nexthdr;
+	u8 hop_limit;
+	struct in6_addr saddr;
+	struct in6_addr daddr;
+};
+
+struct ipv6_opt_hdr {
+	u8 nexthdr;
+	u8 hdrlen;
+};
+
+struct frag_hdr {
+	u8 nexthdr;
+	u8 reserved;
+	__be16 frag_off;
+	__be32 identification;
+};
+
+struct tcphdr {
+	__be16 source;
+	__be16 dest;
+	__be32 seq;
+	__be32 ack_seq;
+	u16 res1:4,
+	    doff:4,
+	    fin:1,
+	    syn:1,
+	    rst:1,
+	    psh:1,
+	    ack:1,
+	    urg:1,
+	    ece:1,
+	    cwr:1;
+	__be16 window;
+	__sum16 check;
+	__be16 urg_ptr;
+};
+
+union tcp_word_hdr {
+	struct tcphdr hdr;
+	__be32 words[5];
+};
+
+#define tcp_flag_word(tp) (((union tcp_word_hdr *)(tp))->words[3])
+#define TCP_FLAG_FIN htonl(0x00010000)
+#define TCP_FLAG_PSH htonl(0x00080000)
+
+struct udphdr {
+	__be16 source;
+	__be16 dest;
+	__be16 len;
+	__sum16 check;
+};
+
+struct iphdr *ip_hdr(const struct sk_buff *skb);
+struct ipv6hdr *ipv6_hdr(const struct sk_buff *skb);
+struct tcphdr *tcp_hdr(const struct sk_buff *skb);
+struct udphdr *udp_hdr(const struct sk_buff *skb);
+
+static inline bool ip_is_fragment(const struct iphdr *iph)
+{
+	return (iph->frag_off & htons(IP_MF | IP_OFFSET)) != 0;
+}
+
+static inline bool ipv6_ext_hdr(u8 nexthdr)
+{
+	return nexthdr == NEXTHDR_HOP || nexthdr == NEXTHDR_ROUTING ||
+	       nexthdr == NEXTHDR_FRAGMENT || nexthdr == NEXTHDR_AUTH ||
+	       nexthdr == NEXTHDR_NONE || nexthdr == NEXTHDR_DEST;
+}
+
+#define ipv6_optlen(p) (((p)->hdrlen + 1) << 3)
+
+/* Checksums, as the generic lib/checksum.c */
+__wsum csum_partial(const void *buff, int len, __wsum sum);
+__sum16 ip_fast_csum(const void *iph, unsigned int ihl);
+__sum16 csum_ipv6_magic(const struct in6_addr *saddr,
+			const struct in6_addr *daddr, u32 len, u8 proto,
+			__wsum csum);
+__wsum csum_tcpudp_nofold(__be32 saddr, __be32 daddr, u32 len, u8 proto,
+			  __wsum sum);
+
+static inline __sum16 csum_fold(__wsum csum)
+{
+	u32 sum = (u32)csum;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+	return (__sum16)~sum;
+}
+
+static inline __wsum csum_add(__wsum csum, __wsum addend)
+{
+	u32 res = (u32)csum;
+
+	res += (u32)addend;
+	return (__wsum)(res + (res < (u32)addend));
+}
+
+static inline __wsum csum_sub(__wsum csum, __wsum addend)
+{
+	return csum_add(csum, ~addend);
+}
+
+static inline __sum16 csum16_add(__sum16 csum, __be16 addend)
+{
+	u16 res = (u16)csum;
+
+	res += (u16)addend;
+	return (__sum16)(res + (res < (u16)addend));
+}
+
+static inline __wsum csum_unfold(__sum16 n)
+{
+	return (__wsum)n;
+}
+
+static inline __wsum csum_block_add(__wsum csum, __wsum csum2, int offset)
+{
+	u32 sum = (u32)csum2;
+
+	/* rotate sum to align it with a 16b boundary */
+	if (offset & 1)
+		sum = (sum << 24) | ((sum >> 8) & 0x00ff00ff) |
+		      ((sum << 8) & 0xff000000);
+	return csum_add(csum, (__wsum)sum);
+}
+
+static inline void csum_replace2(__sum16 *sum, __be16 old, __be16 new)
+{
+	u16 res = ~csum16_add(csum16_add(~(*sum), ~old), new);
+
+	*sum = res;
+}
+
+static inline __sum16 csum_tcpudp_magic(__be32 saddr, __be32 daddr, u32 len,
+					u8 proto, __wsum sum)
+{
+	return csum_fold(csum_tcpudp_nofold(saddr, daddr, len, proto, sum));
+}
+
+/* Trace events compile to nothing */
+#define TP_PROTO(args...) args
+#define TP_ARGS(args...) args
+#define TRACE_EVENT(name, proto, ...) \
+	static inline void trace_##name(proto) {} \
+	static inline bool trace_##name##_enabled(void) { return false; }
+#define DECLARE_EVENT_CLASS(name, ...)
+#define DEFINE_EVENT(template, name, proto, ...) \
+	static inline void trace_##name(proto) {} \
+	static inline bool trace_##name##_enabled(void) { return false; }
+
+#endif /* _RMNET_TEST_KERNEL_H_ */
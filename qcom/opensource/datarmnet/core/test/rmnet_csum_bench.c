@@ -0,0 +1,200 @@
+/* Copyright (c) 2023, Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 and
+ * only version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * RMNET software checksum engine benchmark
+ *
+ * Compares the engine in rmnet_map.h with summing each chunk through
+ * csum_partial(), as the engine used to, over the chunk layouts the
+ * ingress paths see. Both must agree on every layout, and on random ones.
+ *
+ *   rmnet_csum_bench [--verify]
+ *
+ */
+
+#include <time.h>
+#include "rmnet_map.h"
+
+#define BENCH_BUF_SIZE (1 << 20)
+#define BENCH_MAX_CHUNKS 4096
+#define BENCH_BYTES (64 << 20)
+#define BENCH_RANDOM_LAYOUTS 10000
+
+struct bench_layout {
+	const char *name;
+	u32 num;
+	u32 off[BENCH_MAX_CHUNKS];
+	u32 len[BENCH_MAX_CHUNKS];
+	u32 total;
+};
+
+static u8 bench_buf[BENCH_BUF_SIZE];
+
+/* The engine as it was, one csum_partial() call per chunk */
+struct bench_ref_state {
+	__wsum csum;
+	u32 pos;
+};
+
+static void bench_ref_add(struct bench_ref_state *state, const void *addr,
+			  u32 len)
+{
+	if (!(state->pos & 1))
+		state->csum = csum_partial(addr, len, state->csum);
+	else
+		state->csum = csum_block_add(state->csum,
+					     csum_partial(addr, len, 0),
+					     state->pos);
+
+	state->pos += len;
+}
+
+static __sum16 bench_ref(struct bench_layout *layout, __wsum seed)
+{
+	struct bench_ref_state state = { seed, 0 };
+	u32 i;
+
+	for (i = 0; i < layout->num; i++)
+		bench_ref_add(&state, bench_buf + layout->off[i],
+			      layout->len[i]);
+
+	return csum_fold(state.csum);
+}
+
+static __sum16 bench_engine(struct bench_layout *layout, __wsum seed)
+{
+	struct rmnet_map_csum_state state = { seed, 0 };
+	u32 i;
+
+	for (i = 0; i < layout->num; i++)
+		rmnet_map_csum_add(&state, bench_buf + layout->off[i],
+				   layout->len[i]);
+
+	return csum_fold((__wsum)rmnet_map_csum_fold64(state.sum));
+}
+
+static void bench_add_chunk(struct bench_layout *layout, u32 *pos, u32 len,
+			    u32 gap)
+{
+	if (layout->num == BENCH_MAX_CHUNKS ||
+	    *pos + len + gap > BENCH_BUF_SIZE)
+		abort();
+
+	layout->off[layout->num] = *pos;
+	layout->len[layout->num++] = len;
+	layout->total += len;
+	*pos += len + gap;
+}
+
+/* @num chunks of @len bytes, or header and payload pairs if @hdr_len */
+static void bench_build(struct bench_layout *layout, const char *name,
+			u32 num, u32 hdr_len, u32 len)
+{
+	u32 pos = 0, i;
+
+	memset(layout, 0, sizeof(*layout));
+	layout->name = name;
+	for (i = 0; i < num; i++) {
+		if (hdr_len)
+			bench_add_chunk(layout, &pos, hdr_len, 64 - hdr_len);
+
+		/* Keep the chunks apart, as page fragments are */
+		bench_add_chunk(layout, &pos, len, 64 - (len & 63));
+	}
+}
+
+static void bench_build_random(struct bench_layout *layout)
+{
+	u32 pos = 0, num, i;
+
+	memset(layout, 0, sizeof(*layout));
+	layout->name = "random";
+	num = 1 + rand() % 64;
+	for (i = 0; i < num; i++)
+		bench_add_chunk(layout, &pos, 1 + rand() % 1600, rand() % 8);
+}
+
+static u64 bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Returns picoseconds per byte */
+static u64 bench_run(struct bench_layout *layout,
+		     __sum16 (*fn)(struct bench_layout *, __wsum))
+{
+	u32 iters = BENCH_BYTES / layout->total + 1, i;
+	volatile __sum16 sink = 0;
+	u64 start;
+
+	start = bench_now_ns();
+	for (i = 0; i < iters; i++)
+		sink += fn(layout, i);
+
+	return (bench_now_ns() - start) * 1000 / ((u64)iters * layout->total);
+}
+
+int main(int argc, char **argv)
+{
+	static struct bench_layout layouts[5], random_layout;
+	bool verify_only = argc > 1 && !strcmp(argv[1], "--verify");
+	int failures = 0;
+	u32 i;
+
+	srand(1);
+	for (i = 0; i < BENCH_BUF_SIZE; i++)
+		bench_buf[i] = rand();
+
+	bench_build(&layouts[0], "linear 64K", 1, 0, 65536);
+	bench_build(&layouts[1], "1500B frags", 43, 0, 1500);
+	bench_build(&layouts[2], "1499B frags", 43, 0, 1499);
+	bench_build(&layouts[3], "52B hdr + 1448B", 43, 52, 1448);
+	bench_build(&layouts[4], "64B chunks", 1024, 0, 64);
+
+	for (i = 0; i < ARRAY_SIZE(layouts); i++) {
+		if (bench_ref(&layouts[i], i) != bench_engine(&layouts[i], i)) {
+			fprintf(stderr, "%s: checksum mismatch\n",
+				layouts[i].name);
+			failures++;
+		}
+	}
+
+	for (i = 0; i < BENCH_RANDOM_LAYOUTS; i++) {
+		bench_build_random(&random_layout);
+		if (bench_ref(&random_layout, i) !=
+		    bench_engine(&random_layout, i)) {
+			fprintf(stderr, "random layout %u: checksum mismatch\n",
+				i);
+			failures++;
+		}
+	}
+
+	if (failures) {
+		fprintf(stderr, "rmnet_csum_bench: %d mismatches\n", failures);
+		return 1;
+	}
+
+	if (verify_only) {
+		printf("rmnet_csum_bench: checksums match\n");
+		return 0;
+	}
+
+	printf("%-16s %10s %10s\n", "layout", "ref ps/B", "ps/B");
+	for (i = 0; i < ARRAY_SIZE(layouts); i++)
+		printf("%-16s %10llu %10llu\n", layouts[i].name,
+		       (unsigned long long)bench_run(&layouts[i], bench_ref),
+		       (unsigned long long)bench_run(&layouts[i],
+						     bench_engine));
+
+	return 0;
+}
@@ -0,0 +1,449 @@
+/* Copyright (c) 2023, Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 and
+ * only version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * RMNET Packet Descriptor Framework host tests
+ *
+ * Runs rmnet_descriptor.c as is, to check that fragments are embedded in
+ * the descriptor first and only spill over to allocated ones past
+ * RMNET_FRAG_DESC_INLINE_FRAGS.
+ *
+ */
+
+#include "rmnet_config.h"
+#include "rmnet_descriptor.h"
+#include "rmnet_handlers.h"
+#include "rmnet_map.h"
+#include "rmnet_private.h"
+#include "qmi_rmnet.h"
+
+#define TEST_PAGE_SIZE 4096
+#define TEST_FRAG_SIZE 100
+
+static int test_failures;
+
+#define TEST_CHECK(cond) \
+	do { \
+		if (!(cond)) { \
+			fprintf(stderr, "%s:%d: %s: check failed: %s\n", \
+				__FILE__, __LINE__, __func__, #cond); \
+			test_failures++; \
+		} \
+	} while (0)
+
+/* Other rmnet units. The paths under test do not reach them. */
+
+void rmnet_map_csum_start(struct rmnet_map_csum_state *state, u8 ip_proto,
+			  void *iph, u32 datagram_len, u8 trans_proto)
+{
+	abort();
+}
+
+bool rmnet_map_v5_csum_buggy(struct rmnet_map_v5_coal_header *coal_hdr)
+{
+	abort();
+}
+
+void rmnet_map_dl_hdr_notify_v2(struct rmnet_port *port,
+				struct rmnet_map_dl_ind_hdr *dl_hdr,
+				struct rmnet_map_control_command_header *qcmd)
+{
+	abort();
+}
+
+void rmnet_map_dl_trl_notify_v2(struct rmnet_port *port,
+				struct rmnet_map_dl_ind_trl *dltrl,
+				struct rmnet_map_control_command_header *qcmd)
+{
+	abort();
+}
+
+void rmnet_map_pb_ind_notify(struct rmnet_port *port,
+			     struct rmnet_map_pb_ind_hdr *pbhdr)
+{
+	abort();
+}
+
+struct rmnet_endpoint *rmnet_get_endpoint(struct rmnet_port *port, u8 mux_id)
+{
+	abort();
+}
+
+void rmnet_deliver_skb(struct sk_buff *skb, struct rmnet_port *port)
+{
+	abort();
+}
+
+void rmnet_set_skb_proto(struct sk_buff *skb)
+{
+	abort();
+}
+
+int rmnet_vnd_do_flow_control(struct net_device *dev, int enable)
+{
+	abort();
+}
+
+void qmi_rmnet_set_dl_msg_active(void *port)
+{
+	abort();
+}
+
+void qmi_rmnet_work_maybe_restart(void *port, void *desc, struct sk_buff *skb)
+{
+	abort();
+}
+
+/* Helpers */
+
+static bool test_frag_is_inline(struct rmnet_frag_descriptor *frag_desc,
+				struct rmnet_fragment *frag)
+{
+	return frag >= frag_desc->inline_frags &&
+	       frag < frag_desc->inline_frags + RMNET_FRAG_DESC_INLINE_FRAGS;
+}
+
+static void test_count_frags(struct rmnet_frag_descriptor *frag_desc,
+			     u32 *inline_frags, u32 *external_frags)
+{
+	struct rmnet_fragment *frag;
+
+	*inline_frags = 0;
+	*external_frags = 0;
+	list_for_each_entry(frag, &frag_desc->frags, list) {
+		if (test_frag_is_inline(frag_desc, frag))
+			(*inline_frags)++;
+		else
+			(*external_frags)++;
+	}
+}
+
+static void test_add_frags(struct rmnet_frag_descriptor *frag_desc,
+			   struct page *page, u32 num)
+{
+	u32 i;
+
+	for (i = 0; i < num; i++)
+		TEST_CHECK(!rmnet_frag_descriptor_add_frag(frag_desc, page,
+							   i * TEST_FRAG_SIZE,
+							   TEST_FRAG_SIZE));
+}
+
+/* The fragments must come back in the order they were added */
+static void test_check_order(struct rmnet_frag_descriptor *frag_desc)
+{
+	struct rmnet_fragment *frag;
+	u32 off = 0;
+
+	list_for_each_entry(frag, &frag_desc->frags, list) {
+		TEST_CHECK(skb_frag_off(&frag->frag) == off);
+		off += TEST_FRAG_SIZE;
+	}
+}
+
+static u32 test_free_descs(struct rmnet_port *port)
+{
+	struct rmnet_frag_descriptor *frag_desc;
+	u32 num = 0;
+
+	list_for_each_entry(frag_desc, &port->frag_desc_pool->free_list, list)
+		num++;
+
+	return num;
+}
+
+/* Tests */
+
+static void test_inline_only(struct rmnet_port *port, struct page *page)
+{
+	struct rmnet_desc_cache_stats *stats = &port->stats.desc_cache;
+	struct rmnet_frag_descriptor *frag_desc;
+	u32 inline_frags, external_frags;
+
+	rmnet_descriptor_reset_cache_stats(port);
+	frag_desc = rmnet_get_frag_descriptor(port);
+	TEST_CHECK(frag_desc);
+	TEST_CHECK(list_empty(&frag_desc->frags));
+	TEST_CHECK(!frag_desc->inline_map);
+
+	test_add_frags(frag_desc, page, RMNET_FRAG_DESC_INLINE_FRAGS);
+	test_count_frags(frag_desc, &inline_frags, &external_frags);
+	TEST_CHECK(inline_frags == RMNET_FRAG_DESC_INLINE_FRAGS);
+	TEST_CHECK(!external_frags);
+	TEST_CHECK(frag_desc->inline_map ==
+		   BIT(RMNET_FRAG_DESC_INLINE_FRAGS) - 1);
+	TEST_CHECK(frag_desc->len ==
+		   RMNET_FRAG_DESC_INLINE_FRAGS * TEST_FRAG_SIZE);
+	TEST_CHECK(page->refcount == 1 + RMNET_FRAG_DESC_INLINE_FRAGS);
+	test_check_order(frag_desc);
+
+	rmnet_descriptor_get_cache_stats(port);
+	TEST_CHECK(!stats->frag_hit && !stats->frag_miss);
+
+	rmnet_recycle_frag_descriptor(frag_desc, port);
+	TEST_CHECK(page->refcount == 1);
+}
+
+static void test_overflow(struct rmnet_port *port, struct page *page)
+{
+	struct rmnet_desc_cache_stats *stats = &port->stats.desc_cache;
+	struct rmnet_frag_descriptor *frag_desc;
+	u32 inline_frags, external_frags;
+	struct rmnet_fragment *frag;
+	u32 i = 0;
+
+	rmnet_descriptor_reset_cache_stats(port);
+	frag_desc = rmnet_get_frag_descriptor(port);
+	test_add_frags(frag_desc, page, RMNET_FRAG_DESC_INLINE_FRAGS + 2);
+	test_count_frags(frag_desc, &inline_frags, &external_frags);
+	TEST_CHECK(inline_frags == RMNET_FRAG_DESC_INLINE_FRAGS);
+	TEST_CHECK(external_frags == 2);
+	TEST_CHECK(frag_desc->len ==
+		   (RMNET_FRAG_DESC_INLINE_FRAGS + 2) * TEST_FRAG_SIZE);
+	test_check_order(frag_desc);
+
+	/* The inline slots are used up first */
+	list_for_each_entry(frag, &frag_desc->frags, list)
+		TEST_CHECK(test_frag_is_inline(frag_desc, frag) ==
+			   (i++ < RMNET_FRAG_DESC_INLINE_FRAGS));
+
+	/* The fragment cache starts out empty */
+	rmnet_descriptor_get_cache_stats(port);
+	TEST_CHECK(!stats->frag_hit && stats->frag_miss == 2);
+
+	rmnet_recycle_frag_descriptor(frag_desc, port);
+	TEST_CHECK(page->refcount == 1);
+
+	/* The recycled external fragments are served from the cache */
+	frag_desc = rmnet_get_frag_descriptor(port);
+	TEST_CHECK(!frag_desc->inline_map);
+	TEST_CHECK(list_empty(&frag_desc->frags));
+	test_add_frags(frag_desc, page, RMNET_FRAG_DESC_INLINE_FRAGS + 2);
+	rmnet_descriptor_get_cache_stats(port);
+	TEST_CHECK(stats->frag_hit == 2 && stats->frag_miss == 2);
+
+	rmnet_recycle_frag_descriptor(frag_desc, port);
+	TEST_CHECK(page->refcount == 1);
+}
+
+static void test_slot_reuse(struct rmnet_port *port, struct page *page)
+{
+	struct rmnet_frag_descriptor *frag_desc;
+	u32 inline_frags, external_frags;
+	struct rmnet_fragment *frag;
+
+	frag_desc = rmnet_get_frag_descriptor(port);
+	test_add_frags(frag_desc, page, RMNET_FRAG_DESC_INLINE_FRAGS + 1);
+
+	/* Pulling the whole first fragment frees its inline slot */
+	TEST_CHECK(rmnet_frag_pull(frag_desc, port, TEST_FRAG_SIZE + 10));
+	TEST_CHECK(frag_desc->inline_map ==
+		   ((BIT(RMNET_FRAG_DESC_INLINE_FRAGS) - 1) & ~BIT(0)));
+	TEST_CHECK(page->refcount == 1 + RMNET_FRAG_DESC_INLINE_FRAGS);
+
+	frag = list_first_entry(&frag_desc->frags, struct rmnet_fragment,
+				list);
+	TEST_CHECK(skb_frag_off(&frag->frag) == TEST_FRAG_SIZE + 10);
+	TEST_CHECK(skb_frag_size(&frag->frag) == TEST_FRAG_SIZE - 10);
+
+	/* and the next fragment takes it back, at the tail of the list */
+	TEST_CHECK(!rmnet_frag_descriptor_add_frag(frag_desc, page, 0,
+						   TEST_FRAG_SIZE));
+	frag = list_last_entry(&frag_desc->frags, struct rmnet_fragment,
+			       list);
+	TEST_CHECK(frag == &frag_desc->inline_frags[0]);
+	test_count_frags(frag_desc, &inline_frags, &external_frags);
+	TEST_CHECK(inline_frags == RMNET_FRAG_DESC_INLINE_FRAGS);
+	TEST_CHECK(external_frags == 1);
+
+	rmnet_recycle_frag_descriptor(frag_desc, port);
+	TEST_CHECK(page->refcount == 1);
+}
+
+/* A segment takes the fragments of the coalesced packet it covers */
+static void test_add_frags_from(struct rmnet_port *port, struct page *page)
+{
+	struct rmnet_frag_descriptor *coal_desc, *seg_desc;
+	u32 inline_frags, external_frags;
+
+	coal_desc = rmnet_get_frag_descriptor(port);
+	seg_desc = rmnet_get_frag_descriptor(port);
+	test_add_frags(coal_desc, page, RMNET_FRAG_DESC_INLINE_FRAGS + 2);
+
+	/* From the middle of the second fragment to the end of the last */
+	TEST_CHECK(!rmnet_frag_descriptor_add_frags_from(seg_desc, coal_desc,
+							 TEST_FRAG_SIZE + 50,
+							 coal_desc->len -
+							 TEST_FRAG_SIZE - 50));
+	test_count_frags(seg_desc, &inline_frags, &external_frags);
+	TEST_CHECK(inline_frags == RMNET_FRAG_DESC_INLINE_FRAGS);
+	TEST_CHECK(external_frags == 1);
+	TEST_CHECK(seg_desc->len == coal_desc->len - TEST_FRAG_SIZE - 50);
+	TEST_CHECK(page->refcount == 1 + 2 * RMNET_FRAG_DESC_INLINE_FRAGS + 3);
+
+	rmnet_recycle_frag_descriptor(seg_desc, port);
+	rmnet_recycle_frag_descriptor(coal_desc, port);
+	TEST_CHECK(page->refcount == 1);
+}
+
+/* Builds a MAPv5 packet with a checksum offload header at @off in @page */
+static u32 test_put_mapv5_pkt(struct page *page, u32 off, u16 payload_len,
+			      u8 fill)
+{
+	struct rmnet_map_v5_csum_header *csum_hdr;
+	struct rmnet_map_header *maph;
+	u8 *data = (u8 *)page_address(page) + off;
+
+	maph = (struct rmnet_map_header *)data;
+	memset(maph, 0, sizeof(*maph));
+	maph->next_hdr = 1;
+	maph->mux_id = 1;
+	maph->pkt_len = htons(payload_len);
+
+	csum_hdr = (struct rmnet_map_v5_csum_header *)(maph + 1);
+	memset(csum_hdr, 0, sizeof(*csum_hdr));
+	csum_hdr->header_type = RMNET_MAP_HEADER_TYPE_CSUM_OFFLOAD;
+
+	memset(csum_hdr + 1, fill, payload_len);
+	return sizeof(*maph) + sizeof(*csum_hdr) + payload_len;
+}
+
+static bool test_desc_has_pkt(struct rmnet_frag_descriptor *frag_desc,
+			      u16 payload_len, u8 fill)
+{
+	u32 hdrs = sizeof(struct rmnet_map_header) +
+		   sizeof(struct rmnet_map_v5_csum_header);
+	struct rmnet_fragment *frag;
+	u32 pos = 0, i;
+
+	list_for_each_entry(frag, &frag_desc->frags, list) {
+		u8 *data = skb_frag_address(&frag->frag);
+
+		for (i = 0; i < skb_frag_size(&frag->frag); i++, pos++)
+			if (pos >= hdrs && data[i] != fill)
+				return false;
+	}
+
+	return pos == hdrs + payload_len;
+}
+
+/* An aggregated frame is split into one descriptor per MAPv5 packet. The
+ * packet that crosses more page fragments than there are inline slots
+ * spills over to allocated fragments.
+ */
+static void test_mapv5_deaggregate(struct rmnet_port *port,
+				   struct page *page)
+{
+	struct rmnet_frag_descriptor *frag_desc, *tmp;
+	u32 inline_frags, external_frags;
+	struct sk_buff *skb;
+	LIST_HEAD(list);
+	u32 len, i, num = 0;
+
+	port->data_format = RMNET_PRIV_FLAGS_INGRESS_MAP_CKSUMV5;
+	skb = rmnet_test_alloc_frag_skb();
+
+	/* First packet in one fragment */
+	len = test_put_mapv5_pkt(page, 0, 60, 0xa5);
+	rmnet_test_skb_add_frag(skb, page, 0, len);
+
+	/* Second packet scattered over six 16 byte fragments */
+	len = test_put_mapv5_pkt(page, 1024, 88, 0x5a);
+	TEST_CHECK(len == 6 * 16);
+	for (i = 0; i < 6; i++) {
+		/* Move the chunks apart, so no two fragments are adjacent */
+		memmove((u8 *)page_address(page) + 2048 + i * 32,
+			(u8 *)page_address(page) + 1024 + i * 16, 16);
+		rmnet_test_skb_add_frag(skb, page, 2048 + i * 32, 16);
+	}
+
+	rmnet_frag_deaggregate(skb, port, &list, 0);
+
+	list_for_each_entry(frag_desc, &list, list) {
+		test_count_frags(frag_desc, &inline_frags, &external_frags);
+		if (!num) {
+			TEST_CHECK(inline_frags == 1 && !external_frags);
+			TEST_CHECK(test_desc_has_pkt(frag_desc, 60, 0xa5));
+		} else {
+			TEST_CHECK(inline_frags ==
+				   RMNET_FRAG_DESC_INLINE_FRAGS);
+			TEST_CHECK(external_frags ==
+				   6 - RMNET_FRAG_DESC_INLINE_FRAGS);
+			TEST_CHECK(test_desc_has_pkt(frag_desc, 88, 0x5a));
+		}
+		num++;
+	}
+	TEST_CHECK(num == 2);
+	TEST_CHECK(page->refcount == 1 + 7);
+
+	list_for_each_entry_safe(frag_desc, tmp, &list, list)
+		rmnet_recycle_frag_descriptor(frag_desc, port);
+	TEST_CHECK(page->refcount == 1);
+
+	free(skb);
+	port->data_format = 0;
+}
+
+/* Whatever a dead CPU had cached goes back where it came from */
+static void test_cpu_dead(struct rmnet_port *port, struct page *page)
+{
+	struct rmnet_desc_cache_stats *stats = &port->stats.desc_cache;
+	struct rmnet_frag_descriptor *frag_desc;
+
+	frag_desc = rmnet_get_frag_descriptor(port);
+	test_add_frags(frag_desc, page, RMNET_FRAG_DESC_INLINE_FRAGS + 2);
+	rmnet_recycle_frag_descriptor(frag_desc, port);
+	TEST_CHECK(test_free_descs(port) < port->frag_desc_pool->pool_size);
+
+	rmnet_test_cpu_dead(0);
+	TEST_CHECK(test_free_descs(port) == port->frag_desc_pool->pool_size);
+
+	rmnet_descriptor_reset_cache_stats(port);
+	frag_desc = rmnet_get_frag_descriptor(port);
+	test_add_frags(frag_desc, page, RMNET_FRAG_DESC_INLINE_FRAGS + 2);
+	rmnet_descriptor_get_cache_stats(port);
+	TEST_CHECK(stats->desc_miss == 1 && !stats->desc_hit);
+	TEST_CHECK(stats->frag_miss == 2 && !stats->frag_hit);
+
+	rmnet_recycle_frag_descriptor(frag_desc, port);
+	TEST_CHECK(page->refcount == 1);
+}
+
+int main(void)
+{
+	struct rmnet_port *port;
+	struct page *page;
+
+	TEST_CHECK(!rmnet_descriptor_module_init());
+	port = calloc(1, sizeof(*port));
+	TEST_CHECK(port && !rmnet_descriptor_init(port));
+	page = rmnet_test_alloc_page(TEST_PAGE_SIZE);
+
+	test_inline_only(port, page);
+	test_overflow(port, page);
+	test_slot_reuse(port, page);
+	test_add_frags_from(port, page);
+	test_mapv5_deaggregate(port, page);
+	test_cpu_dead(port, page);
+
+	rmnet_descriptor_deinit(port);
+	rmnet_descriptor_exit();
+	rmnet_test_free_page(page);
+	free(port);
+
+	if (test_failures) {
+		fprintf(stderr, "rmnet_descriptor_test: %d checks failed\n",
+			test_failures);
+		return 1;
+	}
+
+	printf("rmnet_descriptor_test: all tests passed\n");
+	return 0;
+}
@@ -0,0 +1,401 @@
+/* Copyright (c) 2023, Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 and
+ * only version 2 as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * RMNET host test kernel environment
+ *
+ */
+
+#include "rmnet_test_kernel.h"
+
+#define RMNET_TEST_UNREACHED(name) \
+	do { \
+		fprintf(stderr, "%s() is not supported by the host tests\n", \
+			name); \
+		abort(); \
+	} while (0)
+
+/* Pages */
+
+struct page *rmnet_test_alloc_page(unsigned int size)
+{
+	struct page *page;
+
+	page = calloc(1, sizeof(*page));
+	if (!page)
+		abort();
+
+	page->addr = calloc(1, size);
+	if (!page->addr)
+		abort();
+
+	page->size = size;
+	page->refcount = 1;
+	return page;
+}
+
+void rmnet_test_free_page(struct page *page)
+{
+	free(page->addr);
+	free(page);
+}
+
+/* The test owns the pages, so they are only counted here */
+void put_page(struct page *page)
+{
+	if (--page->refcount < 0) {
+		fprintf(stderr, "page %p put once too often\n", page);
+		abort();
+	}
+}
+
+/* Socket buffers */
+
+struct rmnet_test_skb {
+	struct sk_buff skb;
+	struct skb_shared_info shinfo;
+};
+
+struct skb_shared_info *skb_shinfo(const struct sk_buff *skb)
+{
+	return &container_of(skb, struct rmnet_test_skb, skb)->shinfo;
+}
+
+struct sk_buff *rmnet_test_alloc_frag_skb(void)
+{
+	struct rmnet_test_skb *tskb;
+
+	tskb = calloc(1, sizeof(*tskb));
+	if (!tskb)
+		abort();
+
+	return &tskb->skb;
+}
+
+void rmnet_test_skb_add_frag(struct sk_buff *skb, struct page *page,
+			     unsigned int off, unsigned int size)
+{
+	struct skb_shared_info *shinfo = skb_shinfo(skb);
+	skb_frag_t *frag;
+
+	if (shinfo->nr_frags == MAX_SKB_FRAGS)
+		abort();
+
+	frag = &shinfo->frags[shinfo->nr_frags++];
+	__skb_frag_set_page(frag, page);
+	skb_frag_off_set(frag, off);
+	skb_frag_size_set(frag, size);
+	skb->len += size;
+	skb->data_len += size;
+}
+
+/* Only paged data is supported, which is what the ingress path gets */
+int skb_copy_bits(const struct sk_buff *skb, int offset, void *to, int len)
+{
+	struct skb_shared_info *shinfo = skb_shinfo(skb);
+	u8 *dst = to;
+	int i;
+
+	if (offset < 0 || len < 0 || (unsigned int)(offset + len) > skb->len)
+		return -EFAULT;
+
+	for (i = 0; i < shinfo->nr_frags && len; i++) {
+		skb_frag_t *frag = &shinfo->frags[i];
+		int size = skb_frag_size(frag);
+		int copy;
+
+		if (offset >= size) {
+			offset -= size;
+			continue;
+		}
+
+		copy = min(len, size - offset);
+		memcpy(dst, (u8 *)skb_frag_address(frag) + offset, copy);
+		dst += copy;
+		len -= copy;
+		offset = 0;
+	}
+
+	return len ? -EFAULT : 0;
+}
+
+struct sk_buff *alloc_skb(unsigned int size, gfp_t priority)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+void consume_skb(struct sk_buff *skb)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+void *skb_put(struct sk_buff *skb, unsigned int len)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+void skb_reserve(struct sk_buff *skb, int len)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+void skb_reset_network_header(struct sk_buff *skb)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+void skb_set_transport_header(struct sk_buff *skb, const int offset)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+int skb_transport_offset(const struct sk_buff *skb)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+void *__pskb_pull_tail(struct sk_buff *skb, int delta)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+void skb_add_rx_frag(struct sk_buff *skb, int i, struct page *page,
+		     int off, int size, unsigned int truesize)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+__wsum skb_checksum(const struct sk_buff *skb, int offset, int len,
+		    __wsum csum)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+struct iphdr *ip_hdr(const struct sk_buff *skb)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+struct ipv6hdr *ipv6_hdr(const struct sk_buff *skb)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+struct tcphdr *tcp_hdr(const struct sk_buff *skb)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+struct udphdr *udp_hdr(const struct sk_buff *skb)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+/* Network devices */
+
+void *netdev_priv(const struct net_device *dev)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+void netif_tx_lock(struct net_device *dev)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+void netif_tx_unlock(struct net_device *dev)
+{
+	RMNET_TEST_UNREACHED(__func__);
+}
+
+/* Checksums, as the generic lib/checksum.c */
+
+static u32 rmnet_test_from64to32(u64 x)
+{
+	x = (x & 0xffffffff) + (x >> 32);
+	x = (x & 0xffffffff) + (x >> 32);
+	return (u32)x;
+}
+
+static unsigned int rmnet_test_do_csum(const unsigned char *buff, int len)
+{
+	unsigned int result = 0;
+	int odd;
+
+	if (len <= 0)
+		return 0;
+
+	odd = 1 & (unsigned long)buff;
+	if (odd) {
+		result += (*buff << 8);
+		len--;
+		buff++;
+	}
+
+	if (len >= 2) {
+		if (2 & (unsigned long)buff) {
+			result += *(unsigned short *)buff;
+			len -= 2;
+			buff += 2;
+		}
+
+		if (len >= 4) {
+			const unsigned char *end;
+			unsigned int carry = 0;
+
+			end = buff + ((unsigned int)len & ~3);
+
+			do {
+				unsigned int w = *(unsigned int *)buff;
+
+				buff += 4;
+				result += carry;
+				result += w;
+				carry = (w > result);
+			} while (buff < end);
+
+			result += carry;
+			result = (result & 0xffff) + (result >> 16);
+		}
+
+		if (len & 2) {
+			result += *(unsigned short *)buff;
+			buff += 2;
+		}
+	}
+
+	if (len & 1)
+		result += *buff;
+
+	result = (result & 0xffff) + (result >> 16);
+	result = (result & 0xffff) + (result >> 16);
+	if (odd)
+		result = ((result >> 8) & 0xff) | ((result & 0xff) << 8);
+
+	return result;
+}
+
+__wsum csum_partial(const void *buff, int len, __wsum wsum)
+{
+	unsigned int sum = (unsigned int)wsum;
+	unsigned int result = rmnet_test_do_csum(buff, len);
+
+	/* add in old sum, and carry.. */
+	result += sum;
+	if (sum > result)
+		result += 1;
+
+	return (__wsum)result;
+}
+
+__sum16 ip_fast_csum(const void *iph, unsigned int ihl)
+{
+	return (__sum16)~rmnet_test_do_csum(iph, ihl * 4);
+}
+
+__wsum csum_tcpudp_nofold(__be32 saddr, __be32 daddr, u32 len, u8 proto,
+			  __wsum sum)
+{
+	u64 s = (u32)sum;
+
+	s += (u32)saddr;
+	s += (u32)daddr;
+	s += htonl(len + proto);
+	return (__wsum)rmnet_test_from64to32(s);
+}
+
+__sum16 csum_ipv6_magic(const struct in6_addr *saddr,
+			const struct in6_addr *daddr, u32 len, u8 proto,
+			__wsum csum)
+{
+	u64 sum = (u32)csum;
+	u32 word;
+	int i;
+
+	for (i = 0; i < 16; i += 4) {
+		memcpy(&word, &saddr->s6_addr[i], sizeof(word));
+		sum += word;
+		memcpy(&word, &daddr->s6_addr[i], sizeof(word));
+		sum += word;
+	}
+
+	sum += htonl(len);
+	sum += htonl(proto);
+	return csum_fold((__wsum)rmnet_test_from64to32(sum));
+}
+
+/* CPU hotplug */
+
+static int (*rmnet_test_dead_cb)(unsigned int cpu);
+static int (*rmnet_test_dead_multi_cb)(unsigned int cpu,
+				       struct hlist_node *node);
+static struct hlist_node *rmnet_test_instances;
+
+int cpuhp_setup_state_nocalls(enum cpuhp_state state, const char *name,
+			      int (*startup)(unsigned int cpu),
+			      int (*teardown)(unsigned int cpu))
+{
+	rmnet_test_dead_cb = teardown;
+	return CPUHP_BP_PREPARE_DYN;
+}
+
+int cpuhp_setup_state_multi(enum cpuhp_state state, const char *name,
+			    int (*startup)(unsigned int cpu,
+					   struct hlist_node *node),
+			    int (*teardown)(unsigned int cpu,
+					    struct hlist_node *node))
+{
+	rmnet_test_dead_multi_cb = teardown;
+	return CPUHP_BP_PREPARE_DYN + 1;
+}
+
+int cpuhp_state_add_instance_nocalls(enum cpuhp_state state,
+				     struct hlist_node *node)
+{
+	node->next = rmnet_test_instances;
+	if (node->next)
+		node->next->pprev = &node->next;
+	node->pprev = &rmnet_test_instances;
+	rmnet_test_instances = node;
+	return 0;
+}
+
+int cpuhp_state_remove_instance_nocalls(enum cpuhp_state state,
+					struct hlist_node *node)
+{
+	*node->pprev = node->next;
+	if (node->next)
+		node->next->pprev = node->pprev;
+	node->next = NULL;
+	node->pprev = NULL;
+	return 0;
+}
+
+void cpuhp_remove_state_nocalls(enum cpuhp_state state)
+{
+	rmnet_test_dead_cb = NULL;
+}
+
+void cpuhp_remove_multi_state(enum cpuhp_state state)
+{
+	rmnet_test_dead_multi_cb = NULL;
+}
+
+void rmnet_test_cpu_dead(unsigned int cpu)
+{
+	struct hlist_node *node;
+
+	if (rmnet_test_dead_cb)
+		rmnet_test_dead_cb(cpu);
+
+	if (rmnet_test_dead_multi_cb)
+		for (node = rmnet_test_instances; node; node = node->next)
+			rmnet_test_dead_multi_cb(cpu, node);
+}
@@ -9,6 +9,9 @@
 #include <linux/mempool.h>
 #include <linux/mm.h>
 #include <linux/err.h>
+#include <linux/bitmap.h>
+#include <linux/hash.h>
+#include <linux/ktime.h>
 #include <linux/of.h>
 #include <linux/version.h>
 #include "cnss_common.h"
@@ -34,6 +37,9 @@ struct cnss_pool {
 	struct kmem_cache *cache;
 	void **pool_ptrs;
 	int table_capacity;
+	unsigned long *slot_map;
+	int *slot_hash;
+	unsigned int hash_bits;
 };
 
 /**
@@ -52,6 +58,10 @@ struct cnss_pool {
  *      cache : A pointer to cache. Updated during init.
  *      pool_ptrs: A table to keep track of memory allocated from the pool.
  *      table_capacity: Total capacity of the tracker table for the pool.
+ *      slot_map: Bitmap of the pool_ptrs slots in use.
+ *      slot_hash: Open addressing hash of the allocated memory address to
+ *                 its pool_ptrs slot + 1, 0 for an empty bucket.
+ *      hash_bits: log2 of the number of slot_hash buckets.
  * 2. Always keep the table in increasing order
  * 3. Please keep the reserve pool as minimum as possible as it's always
  *    preallocated.
@@ -90,6 +100,68 @@ struct cnss_pool *cnss_pools;
 unsigned int cnss_prealloc_pool_size = ARRAY_SIZE(cnss_pools_default);
 spinlock_t pool_table_lock;
 
+static uint bench_count;
+module_param(bench_count, uint, 0600);
+MODULE_PARM_DESC(bench_count,
+		 "Buffers per pool churned through get/put when the pools are created, 0 to skip");
+
+/**
+ * wcnss_pool_table_resize() - Allocate the tracker table of a pool
+ * @pool: Memory pool
+ * @capacity: New capacity of the table, not below the current one
+ * @gfp: GFP flags of the allocations
+ *
+ * The tracked memory keeps its slot. The address hash is sized to at least
+ * twice the capacity, so that it is never more than half full and a probe
+ * always ends on an empty bucket.
+ *
+ * Return: 0 - success, otherwise error code.
+ */
+static int wcnss_pool_table_resize(struct cnss_pool *pool, int capacity,
+				   gfp_t gfp)
+{
+	unsigned int bits = ilog2(roundup_pow_of_two(capacity * 2));
+	unsigned int mask = (1 << bits) - 1;
+	unsigned long *slot_map;
+	void **pool_ptrs;
+	int *slot_hash;
+	unsigned int h;
+	int slot;
+
+	pool_ptrs = kcalloc(capacity, sizeof(void *), gfp);
+	slot_map = bitmap_zalloc(capacity, gfp);
+	slot_hash = kcalloc(mask + 1, sizeof(int), gfp);
+	if (!pool_ptrs || !slot_map || !slot_hash) {
+		kfree(pool_ptrs);
+		bitmap_free(slot_map);
+		kfree(slot_hash);
+		return -ENOMEM;
+	}
+
+	for (slot = 0; slot < pool->table_capacity; slot++) {
+		if (!pool->pool_ptrs[slot])
+			continue;
+
+		pool_ptrs[slot] = pool->pool_ptrs[slot];
+		__set_bit(slot, slot_map);
+		h = hash_ptr(pool_ptrs[slot], bits);
+		while (slot_hash[h])
+			h = (h + 1) & mask;
+		slot_hash[h] = slot + 1;
+	}
+
+	kfree(pool->pool_ptrs);
+	bitmap_free(pool->slot_map);
+	kfree(pool->slot_hash);
+	pool->pool_ptrs = pool_ptrs;
+	pool->slot_map = slot_map;
+	pool->slot_hash = slot_hash;
+	pool->hash_bits = bits;
+	pool->table_capacity = capacity;
+
+	return 0;
+}
+
 /**
  * cnss_pool_alloc_threshold() - Allocation threshold
  *
@@ -144,11 +216,9 @@ static int cnss_pool_init(void)
 			continue;
 		}
 
-		cnss_pools[i].table_capacity = cnss_pools[i].min;
-		cnss_pools[i].pool_ptrs = kzalloc(cnss_pools[i].min * sizeof(void *),
-						  GFP_KERNEL);
-
-		if (!cnss_pools[i].pool_ptrs) {
+		if (wcnss_pool_table_resize(&cnss_pools[i],
+					    max(cnss_pools[i].min, 1),
+					    GFP_KERNEL)) {
 			pr_err("cnss_prealloc: failed to create mempool %s of min size %d * %zu\n",
 			       cnss_pools[i].name, cnss_pools[i].min,
 			       cnss_pools[i].size);
@@ -187,6 +257,11 @@ static void cnss_pool_deinit(void)
 		cnss_pools[i].cache = NULL;
 		kfree(cnss_pools[i].pool_ptrs);
 		cnss_pools[i].pool_ptrs = NULL;
+		bitmap_free(cnss_pools[i].slot_map);
+		cnss_pools[i].slot_map = NULL;
+		kfree(cnss_pools[i].slot_hash);
+		cnss_pools[i].slot_hash = NULL;
+		cnss_pools[i].table_capacity = 0;
 	}
 }
 
@@ -215,10 +290,62 @@ static void cnss_assign_prealloc_pool(unsigned long device_id)
 	}
 }
 
+/**
+ * cnss_pool_benchmark() - Time wcnss_prealloc_get/put churn on each pool
+ *
+ * Takes bench_count buffers from each pool, then puts back the odd ones
+ * and the even ones, so that the tracker table grows past its reserve and
+ * is emptied from all over. Results are reported in the kernel log.
+ */
+static void cnss_pool_benchmark(void)
+{
+	u64 get_ns, put_ns;
+	unsigned int n, got;
+	ktime_t start;
+	void **mem;
+	int i;
+
+	if (!bench_count)
+		return;
+
+	mem = kcalloc(bench_count, sizeof(*mem), GFP_KERNEL);
+	if (!mem)
+		return;
+
+	for (i = 0; i < cnss_prealloc_pool_size; i++) {
+		if (!cnss_pools[i].mp)
+			continue;
+
+		start = ktime_get();
+		for (got = 0; got < bench_count; got++) {
+			mem[got] = wcnss_prealloc_get(cnss_pools[i].size);
+			if (!mem[got])
+				break;
+		}
+		get_ns = ktime_to_ns(ktime_sub(ktime_get(), start));
+
+		start = ktime_get();
+		for (n = 1; n < got; n += 2)
+			wcnss_prealloc_put(mem[n]);
+		for (n = 0; n < got; n += 2)
+			wcnss_prealloc_put(mem[n]);
+		put_ns = ktime_to_ns(ktime_sub(ktime_get(), start));
+
+		pr_info("cnss_prealloc: %s bench %u bufs get %llu ns/op put %llu ns/op table size %d\n",
+			cnss_pools[i].name, got,
+			got ? div_u64(get_ns, got) : 0,
+			got ? div_u64(put_ns, got) : 0,
+			cnss_pools[i].table_capacity);
+	}
+
+	kfree(mem);
+}
+
 void cnss_initialize_prealloc_pool(unsigned long device_id)
 {
 	cnss_assign_prealloc_pool(device_id);
 	cnss_pool_init();
+	cnss_pool_benchmark();
 }
 EXPORT_SYMBOL(cnss_initialize_prealloc_pool);
 
@@ -240,13 +367,13 @@ void wcnss_check_pool_lists(void)
 	for (i = 0; i < cnss_prealloc_pool_size; i++) {
 		pool = cnss_pools[i].pool_ptrs;
 		count = cnss_pools[i].table_capacity;
-		for (ptr_idx = 0; ptr_idx < count; ptr_idx++) {
-			if (pool[ptr_idx]) {
-				pr_err("%p not freed in %s pool at index %zu\n",
-					pool[ptr_idx], cnss_pools[i].name,
-					ptr_idx);
-				WARN_ON(1);
-			}
+		if (!cnss_pools[i].slot_map)
+			continue;
+
+		for_each_set_bit(ptr_idx, cnss_pools[i].slot_map, count) {
+			pr_err("%p not freed in %s pool at index %zu\n",
+			       pool[ptr_idx], cnss_pools[i].name, ptr_idx);
+			WARN_ON(1);
 		}
 	}
 }
@@ -254,57 +381,77 @@ EXPORT_SYMBOL(wcnss_check_pool_lists);
 
 static int wcnss_find_pool_table_slot(int pool, void *mem)
 {
-	void **pool_table;
-	size_t ptr_idx;
-	int new_capacity;
-
-	pool_table = cnss_pools[pool].pool_ptrs;
-	for (ptr_idx = 0; ptr_idx < cnss_pools[pool].table_capacity; ptr_idx++) {
-		if (!pool_table[ptr_idx]) {
-			pool_table[ptr_idx] = mem;
-			return 0;
+	struct cnss_pool *mempool = &cnss_pools[pool];
+	unsigned int mask;
+	unsigned int h;
+	int slot;
+
+	slot = find_first_zero_bit(mempool->slot_map,
+				   mempool->table_capacity);
+	if (slot >= mempool->table_capacity) {
+		/* Grow geometrically, the tracked memory keeps its slot */
+		if (wcnss_pool_table_resize(mempool,
+					    mempool->table_capacity * 2,
+					    GFP_ATOMIC)) {
+			pr_debug("%s pool is full, failed to increase table size to %d\n",
+				 mempool->name, mempool->table_capacity * 2);
+			return -EPERM;
 		}
-	}
-
-	new_capacity = cnss_pools[pool].table_capacity + 1;
 
-
-	cnss_pools[pool].pool_ptrs = krealloc(cnss_pools[pool].pool_ptrs,
-					      new_capacity * sizeof(void *),
-					      GFP_ATOMIC);
-
-	if (!cnss_pools[pool].pool_ptrs) {
-		pr_debug("%s pool is full, failed to increase table size to %d\n",
-			 cnss_pools[pool].name, cnss_pools[pool].table_capacity);
-		return -EPERM;
+		pr_debug("%s pool is full, increasing table size to %d\n",
+			 mempool->name, mempool->table_capacity);
 	}
 
-	cnss_pools[pool].pool_ptrs[ptr_idx] = mem;
-	cnss_pools[pool].table_capacity += 1;
+	mask = (1 << mempool->hash_bits) - 1;
+	h = hash_ptr(mem, mempool->hash_bits);
+	while (mempool->slot_hash[h])
+		h = (h + 1) & mask;
 
-	pr_debug("%s pool is full, increasing table size to %d\n",
-		 cnss_pools[pool].name, cnss_pools[pool].table_capacity);
+	mempool->slot_hash[h] = slot + 1;
+	mempool->pool_ptrs[slot] = mem;
+	__set_bit(slot, mempool->slot_map);
 
 	return 0;
 }
 
-static int wcnss_free_pool_table_slot(struct cnss_pool mempool, void *mem)
+static int wcnss_free_pool_table_slot(struct cnss_pool *mempool, void *mem)
 {
-	void **pool_table;
-	size_t ptr_idx;
+	unsigned int mask = (1 << mempool->hash_bits) - 1;
+	unsigned int h, j, home;
+	int slot = -EPERM;
+
+	for (h = hash_ptr(mem, mempool->hash_bits); mempool->slot_hash[h];
+	     h = (h + 1) & mask) {
+		slot = mempool->slot_hash[h] - 1;
+		if (mempool->pool_ptrs[slot] == mem)
+			break;
+	}
 
-	pool_table = mempool.pool_ptrs;
-	for (ptr_idx = 0; ptr_idx < mempool.table_capacity; ptr_idx++) {
-		if (pool_table[ptr_idx] == mem) {
-			pool_table[ptr_idx] = NULL;
-			return ptr_idx;
-		}
+	if (!mempool->slot_hash[h]) {
+		pr_debug("wcnss prealloc put ptr %p not found in %s pool mem addr %p\n",
+			 mem, mempool->name, mempool->pool_ptrs);
+		return -EPERM;
 	}
 
-	pr_debug("wcnss prealloc put ptr %p not found in %s pool mem addr %p\n",
-		 mem, mempool.name, mempool.pool_ptrs);
+	mempool->pool_ptrs[slot] = NULL;
+	__clear_bit(slot, mempool->slot_map);
+
+	/*
+	 * Shift back the following entries of the probe sequence whose home
+	 * bucket is not between the hole and themselves, so that lookups
+	 * never need tombstones.
+	 */
+	for (j = (h + 1) & mask; mempool->slot_hash[j]; j = (j + 1) & mask) {
+		home = hash_ptr(mempool->pool_ptrs[mempool->slot_hash[j] - 1],
+				mempool->hash_bits);
+		if (((j - home) & mask) >= ((j - h) & mask)) {
+			mempool->slot_hash[h] = mempool->slot_hash[j];
+			h = j;
+		}
+	}
+	mempool->slot_hash[h] = 0;
 
-	return -EPERM;
+	return slot;
 }
 
 /**
@@ -397,7 +544,7 @@ int wcnss_prealloc_put(void *mem)
 				break;
 			}
 			spin_lock_irqsave(&pool_table_lock, irq_flags);
-			ret = wcnss_free_pool_table_slot(cnss_pools[i],
+			ret = wcnss_free_pool_table_slot(&cnss_pools[i],
 							 mem);
 			spin_unlock_irqrestore(&pool_table_lock,
 					       irq_flags);
@@ -467,7 +614,7 @@ int wcnss_prealloc_put(void *mem)
 			return 0;
 		}
 		spin_lock_irqsave(&pool_table_lock, irq_flags);
-		ret = wcnss_free_pool_table_slot(cnss_pools[i], mem);
+		ret = wcnss_free_pool_table_slot(&cnss_pools[i], mem);
 		spin_unlock_irqrestore(&pool_table_lock, irq_flags);
 		if (ret >= 0) {
 			mempool_free(mem, cnss_pools[i].mp);
@@ -88,17 +88,48 @@ struct cdp_hist_bucket {
 	uint64_t freq[CDP_HIST_BUCKET_MAX];
 };
 
+/*
+ * Log-linear histogram geometry: values below 2^CDP_HIST_LOG_SUB_BITS get a
+ * bucket each, every power of two above that is split into
+ * CDP_HIST_LOG_SUB_BUCKETS equal buckets. Values of 2^CDP_HIST_LOG_MAX_BITS
+ * and above are counted in the last bucket.
+ */
+#define CDP_HIST_LOG_SUB_BITS 2
+#define CDP_HIST_LOG_SUB_BUCKETS (1 << CDP_HIST_LOG_SUB_BITS)
+#define CDP_HIST_LOG_MAX_BITS 20
+#define CDP_HIST_LOG_BUCKET_MAX \
+	((CDP_HIST_LOG_MAX_BITS - CDP_HIST_LOG_SUB_BITS + 1) * \
+	 CDP_HIST_LOG_SUB_BUCKETS)
+
+/**
+ * struct cdp_hist_log - Log-linear frequency distribution
+ * @freq: Frequency of each log-linear bucket
+ */
+struct cdp_hist_log {
+	uint32_t freq[CDP_HIST_LOG_BUCKET_MAX];
+};
+
 /**
  * struct cdp_hist_stats - Histogram of a stats type
  * @hist: Frequency distribution
+ * @count: Number of samples
+ * @sum: Sum of all the samples
  * @max: Max frequency
  * @min: Minimum frequency
  * @avg: Average frequency
+ * @p50: 50th percentile, 0 when percentile stats are disabled
+ * @p99: 99th percentile, 0 when percentile stats are disabled
+ * @p999: 99.9th percentile, 0 when percentile stats are disabled
  */
 struct cdp_hist_stats {
 	struct cdp_hist_bucket hist;
+	uint64_t count;
+	uint64_t sum;
 	int max;
 	int min;
 	int avg;
+	int p50;
+	int p99;
+	int p999;
 };
 #endif /* _CDP_TXRX_HIST_STRUCT_H_ */
@@ -194,21 +194,126 @@ const char *dp_hist_delay_percentile_str(uint8_t index)
 
 /**
  * dp_hist_find_bucket_idx() - Find the bucket index
- * @bucket_array: Bucket array
+ * @bucket_array: Bucket array, sorted on the bucket lower bound
  * @value: Frequency value
  *
- * Return: The bucket index
+ * Return: The index of the last bucket whose lower bound is <= @value
  */
-static int dp_hist_find_bucket_idx(int16_t *bucket_array, int value)
+static int dp_hist_find_bucket_idx(uint16_t *bucket_array, int value)
 {
-	uint8_t idx = CDP_HIST_BUCKET_0;
+	uint8_t lo = CDP_HIST_BUCKET_0;
+	uint8_t hi = CDP_HIST_BUCKET_MAX - 1;
+	uint8_t mid;
 
-	for (; idx < (CDP_HIST_BUCKET_MAX - 1); idx++) {
-		if (value < bucket_array[idx + 1])
-			break;
+	while (lo < hi) {
+		mid = (lo + hi + 1) >> 1;
+		if (value < bucket_array[mid])
+			hi = mid - 1;
+		else
+			lo = mid;
 	}
 
-	return idx;
+	return lo;
+}
+
+/**
+ * dp_hist_log_bucket_idx() - Find the log-linear bucket index
+ * @value: Frequency value
+ *
+ * Return: The log-linear bucket index of @value
+ */
+static inline uint32_t dp_hist_log_bucket_idx(uint32_t value)
+{
+	uint32_t shift;
+
+	if (value < CDP_HIST_LOG_SUB_BUCKETS)
+		return value;
+
+	if (qdf_unlikely(value >= (1U << CDP_HIST_LOG_MAX_BITS)))
+		return CDP_HIST_LOG_BUCKET_MAX - 1;
+
+	shift = qdf_fls(value) - 1 - CDP_HIST_LOG_SUB_BITS;
+
+	return ((shift + 1) << CDP_HIST_LOG_SUB_BITS) +
+	       ((value >> shift) & (CDP_HIST_LOG_SUB_BUCKETS - 1));
+}
+
+/**
+ * dp_hist_log_bucket_max() - Find the largest value of a log-linear bucket
+ * @idx: Log-linear bucket index
+ *
+ * Return: The largest value that maps to bucket @idx
+ */
+static uint32_t dp_hist_log_bucket_max(uint32_t idx)
+{
+	uint32_t shift;
+
+	if (idx < CDP_HIST_LOG_SUB_BUCKETS)
+		return idx;
+
+	shift = (idx >> CDP_HIST_LOG_SUB_BITS) - 1;
+
+	return ((CDP_HIST_LOG_SUB_BUCKETS +
+		 (idx & (CDP_HIST_LOG_SUB_BUCKETS - 1))) << shift) +
+	       (1U << shift) - 1;
+}
+
+/**
+ * dp_hist_log_rank() - Rank of a percentile
+ * @count: Number of samples
+ * @num: Percentile numerator
+ * @denom: Percentile denominator
+ *
+ * Return: The 1-based rank of the sample at @num / @denom
+ */
+static inline uint64_t dp_hist_log_rank(uint64_t count, uint32_t num,
+					uint32_t denom)
+{
+	return qdf_do_div(count * num + denom - 1, denom);
+}
+
+/**
+ * dp_hist_compute_summary() - Compute the average and the percentiles
+ * @hist_stats: Histogram stats
+ * @log: Log-linear buckets of @hist_stats, or NULL
+ *
+ * The percentiles are reported as the upper bound of the log-linear bucket
+ * they fall in, capped by the exact max. They are left at 0 without @log.
+ *
+ * Return: void
+ */
+static void dp_hist_compute_summary(struct cdp_hist_stats *hist_stats,
+				    struct cdp_hist_log *log)
+{
+	uint64_t rank[3], cum = 0;
+	int *pct[3] = { &hist_stats->p50, &hist_stats->p99, &hist_stats->p999 };
+	uint32_t idx;
+	uint8_t i = 0;
+
+	hist_stats->p50 = 0;
+	hist_stats->p99 = 0;
+	hist_stats->p999 = 0;
+
+	if (!hist_stats->count)
+		return;
+
+	hist_stats->avg = qdf_do_div(hist_stats->sum, hist_stats->count);
+
+	if (!log)
+		return;
+
+	rank[0] = dp_hist_log_rank(hist_stats->count, 50, 100);
+	rank[1] = dp_hist_log_rank(hist_stats->count, 99, 100);
+	rank[2] = dp_hist_log_rank(hist_stats->count, 999, 1000);
+
+	for (idx = 0; idx < CDP_HIST_LOG_BUCKET_MAX && i < 3; idx++) {
+		cum += log->freq[idx];
+		while (i < 3 && cum >= rank[i]) {
+			*pct[i] = QDF_MIN(dp_hist_log_bucket_max(idx),
+					  (uint32_t)hist_stats->max);
+			i++;
+		}
+	}
 }
 
 /**
@@ -260,8 +365,11 @@ static void dp_hist_fill_buckets(struct cdp_hist_bucket *hist_bucket, int value)
 	hist_bucket->freq[idx]++;
 }
 
-void dp_hist_update_stats(struct cdp_hist_stats *hist_stats, int value)
+void dp_hist_update_stats(struct cdp_hist_stats *hist_stats,
+			  struct cdp_hist_log *log, int value)
 {
+	uint32_t sample;
+
 	if (qdf_unlikely(!hist_stats))
 		return;
 
@@ -271,57 +379,76 @@ void dp_hist_update_stats(struct cdp_hist_stats *hist_stats, int value)
 	dp_hist_fill_buckets(&hist_stats->hist, value);
 
 	/*
-	 * Compute the min, max and average. Average computed is weighted
-	 * average
+	 * Each stats object is only updated from its own reap context, so
+	 * the log-linear buckets are plain counters; the average and the
+	 * percentiles are only worked out when the stats are read.
 	 */
+	sample = value < 0 ? 0 : value;
+	if (log)
+		log->freq[dp_hist_log_bucket_idx(sample)]++;
+	hist_stats->count++;
+	hist_stats->sum += sample;
+
 	if (value < hist_stats->min)
 		hist_stats->min = value;
 
 	if (value > hist_stats->max)
 		hist_stats->max = value;
-
-	if (qdf_unlikely(!hist_stats->avg))
-		hist_stats->avg = value;
-	else
-		hist_stats->avg = (hist_stats->avg + value) / 2;
 }
 
 void dp_copy_hist_stats(struct cdp_hist_stats *src_hist_stats,
-			struct cdp_hist_stats *dst_hist_stats)
+			struct cdp_hist_log *src_log,
+			struct cdp_hist_stats *dst_hist_stats,
+			struct cdp_hist_log *dst_log)
 {
 	uint8_t index;
 
 	for (index = 0; index < CDP_HIST_BUCKET_MAX; index++)
 		dst_hist_stats->hist.freq[index] =
 			src_hist_stats->hist.freq[index];
+	if (dst_log) {
+		if (src_log)
+			qdf_mem_copy(dst_log, src_log, sizeof(*dst_log));
+		else
+			qdf_mem_zero(dst_log, sizeof(*dst_log));
+	}
+	dst_hist_stats->count = src_hist_stats->count;
+	dst_hist_stats->sum = src_hist_stats->sum;
 	dst_hist_stats->min = src_hist_stats->min;
 	dst_hist_stats->max = src_hist_stats->max;
 	dst_hist_stats->avg = src_hist_stats->avg;
+	dp_hist_compute_summary(dst_hist_stats, dst_log);
 }
 
 void dp_accumulate_hist_stats(struct cdp_hist_stats *src_hist_stats,
-			      struct cdp_hist_stats *dst_hist_stats)
+			      struct cdp_hist_log *src_log,
+			      struct cdp_hist_stats *dst_hist_stats,
+			      struct cdp_hist_log *dst_log)
 {
-	uint8_t index, hist_stats_valid = 0;
+	uint32_t index;
 
-	for (index = 0; index < CDP_HIST_BUCKET_MAX; index++) {
-		dst_hist_stats->hist.freq[index] +=
-			src_hist_stats->hist.freq[index];
-		if (src_hist_stats->hist.freq[index])
-			hist_stats_valid = 1;
-	}
 	/*
-	 * If at least one hist-bucket has non-zero count,
-	 * proceed with the detailed calculation.
+	 * Only merge objects which have seen at least one sample, so that
+	 * the min of an idle reap context does not leak in.
 	 */
-	if (hist_stats_valid) {
-		dst_hist_stats->min = QDF_MIN(src_hist_stats->min,
-					      dst_hist_stats->min);
-		dst_hist_stats->max = QDF_MAX(src_hist_stats->max,
-					      dst_hist_stats->max);
-		dst_hist_stats->avg = (src_hist_stats->avg +
-				       dst_hist_stats->avg) >> 1;
-	}
+	if (!src_hist_stats->count)
+		return;
+
+	for (index = 0; index < CDP_HIST_BUCKET_MAX; index++)
+		dst_hist_stats->hist.freq[index] +=
+			src_hist_stats->hist.freq[index];
+
+	if (dst_log && src_log)
+		for (index = 0; index < CDP_HIST_LOG_BUCKET_MAX; index++)
+			dst_log->freq[index] += src_log->freq[index];
+	dst_hist_stats->count += src_hist_stats->count;
+	dst_hist_stats->sum += src_hist_stats->sum;
+
+	dst_hist_stats->min = QDF_MIN(src_hist_stats->min,
+				      dst_hist_stats->min);
+	dst_hist_stats->max = QDF_MAX(src_hist_stats->max,
+				      dst_hist_stats->max);
+	dp_hist_compute_summary(dst_hist_stats, dst_log);
 }
 
 void dp_hist_init(struct cdp_hist_stats *hist_stats,
@@ -30,11 +30,14 @@
 /**
  * dp_hist_update_stats() - Update histogram stats
  * @hist_stats: Delay histogram
+ * @log: Log-linear buckets of @hist_stats, NULL if the percentiles are
+ *	 not tracked
  * @value: Delay value
  *
  * Return: void
  */
-void dp_hist_update_stats(struct cdp_hist_stats *hist_stats, int value);
+void dp_hist_update_stats(struct cdp_hist_stats *hist_stats,
+			  struct cdp_hist_log *log, int value);
 
 /**
  * dp_hist_init() - Initialize the histogram object
@@ -47,22 +50,38 @@ void dp_hist_init(struct cdp_hist_stats *hist_stats,
 /**
  * dp_accumulate_hist_stats() - Accumulate the hist src to dst
  * @src_hist_stats: Source histogram stats
+ * @src_log: Log-linear buckets of @src_hist_stats, or NULL
  * @dst_hist_stats: Destination histogram stats
+ * @dst_log: Log-linear buckets of @dst_hist_stats, or NULL
+ *
+ * The average of @dst_hist_stats is recomputed over everything accumulated
+ * into it so far, and so are the p50/p99/p99.9 if both @src_log and
+ * @dst_log are given.
  *
  * Return: void
  */
 void dp_accumulate_hist_stats(struct cdp_hist_stats *src_hist_stats,
-			      struct cdp_hist_stats *dst_hist_stats);
+			      struct cdp_hist_log *src_log,
+			      struct cdp_hist_stats *dst_hist_stats,
+			      struct cdp_hist_log *dst_log);
 
 /**
  * dp_copy_hist_stats() - Copy the histogram stats
  * @src_hist_stats: Source histogram stats
+ * @src_log: Log-linear buckets of @src_hist_stats, or NULL
  * @dst_hist_stats: Destination histogram stats
+ * @dst_log: Log-linear buckets of @dst_hist_stats, or NULL
+ *
+ * The average of @dst_hist_stats is computed from the copied samples, and
+ * so are the percentiles if @dst_log is given; it is cleared when there is
+ * no @src_log.
  *
  * Return: void
  */
 void dp_copy_hist_stats(struct cdp_hist_stats *src_hist_stats,
-			struct cdp_hist_stats *dst_hist_stats);
+			struct cdp_hist_log *src_log,
+			struct cdp_hist_stats *dst_hist_stats,
+			struct cdp_hist_log *dst_log);
 
 const char *dp_hist_tx_hw_delay_str(uint8_t index);
 const char *dp_hist_delay_percentile_str(uint8_t index);
@@ -2631,6 +2631,18 @@ void dp_peer_find_detach(struct dp_soc *soc);
  */
 void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer);
 
+/**
+ * dp_peer_find_hash_readd() - add a reused peer back to peer_hash_table
+ * @soc: soc handle
+ * @peer: peer handle, removed from the table and being reused
+ *
+ * Unlike dp_peer_find_hash_add(), safe for a peer that lookups may still
+ * be walking past, without waiting for an RCU grace period.
+ *
+ * Return: none
+ */
+void dp_peer_find_hash_readd(struct dp_soc *soc, struct dp_peer *peer);
+
 /**
  * dp_peer_find_hash_remove() - remove peer from peer_hash_table
  * @soc: soc handle
@@ -3577,6 +3589,14 @@ void dp_dump_srng_high_wm_stats(struct dp_soc *soc, uint64_t srng_mask)
  */
 void dp_print_soc_rx_stats(struct dp_soc *soc);
 
+/**
+ * dp_print_peer_hash_stats() - Print peer hash table lookup stats
+ * @soc: DP_SOC Handle
+ *
+ * Return: void
+ */
+void dp_print_peer_hash_stats(struct dp_soc *soc);
+
 /**
  * dp_get_mac_id_for_pdev() - Return mac corresponding to pdev for mac
  *
@@ -5689,7 +5689,7 @@ dp_peer_create_wifi3(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 		dp_peer_cleanup(vdev, peer);
 
 		dp_peer_vdev_list_add(soc, vdev, peer);
-		dp_peer_find_hash_add(soc, peer);
+		dp_peer_find_hash_readd(soc, peer);
 
 		if (dp_peer_rx_tids_create(peer) != QDF_STATUS_SUCCESS) {
 			dp_alert("RX tid alloc fail for peer %pK (" QDF_MAC_ADDR_FMT ")",
@@ -6443,6 +6443,20 @@ free_vdev:
 
 qdf_export_symbol(dp_vdev_unref_delete);
 
+/**
+ * dp_peer_free_rcu() - free a peer once no hash lookup can reach it
+ * @head: RCU head of the peer
+ *
+ * Return: none
+ */
+static void dp_peer_free_rcu(qdf_rcu_head_t *head)
+{
+	struct dp_peer *peer = qdf_container_of(head, struct dp_peer,
+						rcu_head);
+
+	qdf_mem_free(peer);
+}
+
 void dp_peer_unref_delete(struct dp_peer *peer, enum dp_mod_id mod_id)
 {
 	struct dp_vdev *vdev = peer->vdev;
@@ -6508,7 +6522,11 @@ void dp_peer_unref_delete(struct dp_peer *peer, enum dp_mod_id mod_id)
 		dp_txrx_peer_detach(soc, peer);
 		dp_cfg_event_record_peer_evt(soc, DP_CFG_EVENT_PEER_UNREF_DEL,
 					     peer, vdev, 0);
-		qdf_mem_free(peer);
+		/*
+		 * dp_peer_find_hash_find() may still be walking past the
+		 * peer without holding peer_hash_lock
+		 */
+		qdf_call_rcu(&peer->rcu_head, dp_peer_free_rcu);
 
 		/*
 		 * Decrement ref count taken at peer create
@@ -7879,6 +7897,7 @@ dp_print_host_stats(struct dp_vdev *vdev,
 	case TXRX_AST_STATS:
 		dp_print_ast_stats(pdev->soc);
 		dp_print_mec_stats(pdev->soc);
+		dp_print_peer_hash_stats(pdev->soc);
 		dp_print_peer_table(vdev);
 		if (soc->arch_ops.dp_mlo_print_ptnr_info)
 			soc->arch_ops.dp_mlo_print_ptnr_info(vdev);
@@ -8586,6 +8605,8 @@ static void dp_rx_update_peer_delay_stats(struct dp_soc *soc,
 		delay_stats = peer->txrx_peer->delay_stats;
 		ring_id = QDF_NBUF_CB_RX_CTX_ID(nbuf);
 		dp_rx_compute_tid_delay(&delay_stats->delay_tid_stats[tid][ring_id],
+					dp_peer_delay_log_get(delay_stats, tid,
+							      ring_id),
 					nbuf);
 	}
 	dp_peer_unref_delete(peer, DP_MOD_ID_CDP);
@@ -352,34 +352,156 @@ static QDF_STATUS dp_peer_find_map_attach(struct dp_soc *soc)
 #define DP_AST_HASH_LOAD_MULT  2
 #define DP_AST_HASH_LOAD_SHIFT 0
 
+/* 2^32 divided by the golden ratio */
+#define DP_PEER_HASH_GOLDEN_RATIO 0x9e3779b9
+
 static inline uint32_t
 dp_peer_find_hash_index(struct dp_soc *soc,
 			union dp_align_mac_addr *mac_addr)
 {
 	uint32_t index;
 
-	index =
-		mac_addr->align2.bytes_ab ^
-		mac_addr->align2.bytes_cd ^
-		mac_addr->align2.bytes_ef;
+	/*
+	 * Multiplicative hash of the address: stations of a same vendor
+	 * only differ in their lower bytes, which the multiplications
+	 * spread over the whole word before it is folded into the mask.
+	 */
+	index = ((uint32_t)mac_addr->align2.bytes_cd << 16) |
+		mac_addr->align2.bytes_ab;
+	index *= DP_PEER_HASH_GOLDEN_RATIO;
+	index ^= mac_addr->align2.bytes_ef;
+	index *= DP_PEER_HASH_GOLDEN_RATIO;
 
-	index ^= index >> soc->peer_hash.idx_bits;
+	index ^= index >> 16;
 	index &= soc->peer_hash.mask;
 	return index;
 }
 
+/*
+ * dp_peer_find_hash_find() walks the peer hash bins without peer_hash_lock.
+ * The writers, still serialized by the lock, only link a peer in a bin
+ * once it is fully set up and keep the next pointer of a removed peer, so
+ * that a lookup standing on it goes on with the rest of the bin. The peer
+ * itself is freed after an RCU grace period, see dp_peer_unref_delete().
+ * A removed peer that is reused is linked again at the head of its bin, so
+ * that a lookup still standing on it starts the bin over rather than
+ * stopping short, see dp_peer_find_hash_readd().
+ */
+#define DP_PEER_HASH_INSERT_TAIL_RCU(head, elm) do {			\
+	TAILQ_NEXT((elm), hash_list_elem) = NULL;			\
+	(elm)->hash_list_elem.tqe_prev = (head)->tqh_last;		\
+	qdf_rcu_assign_pointer(*(head)->tqh_last, (elm));		\
+	(head)->tqh_last = &TAILQ_NEXT((elm), hash_list_elem);		\
+} while (0)
+
+#define DP_PEER_HASH_INSERT_HEAD_RCU(head, elm) do {			\
+	if (TAILQ_FIRST(head))						\
+		TAILQ_FIRST(head)->hash_list_elem.tqe_prev =		\
+			&TAILQ_NEXT((elm), hash_list_elem);		\
+	else								\
+		(head)->tqh_last = &TAILQ_NEXT((elm), hash_list_elem);	\
+	qdf_rcu_assign_pointer(TAILQ_NEXT((elm), hash_list_elem),	\
+			       TAILQ_FIRST(head));			\
+	(elm)->hash_list_elem.tqe_prev = &TAILQ_FIRST(head);		\
+	qdf_rcu_assign_pointer(TAILQ_FIRST(head), (elm));		\
+} while (0)
+
+#define DP_PEER_HASH_REMOVE_RCU(head, elm) do {				\
+	if (TAILQ_NEXT((elm), hash_list_elem))				\
+		TAILQ_NEXT((elm), hash_list_elem)->hash_list_elem.tqe_prev = \
+			(elm)->hash_list_elem.tqe_prev;			\
+	else								\
+		(head)->tqh_last = (elm)->hash_list_elem.tqe_prev;	\
+	qdf_rcu_assign_pointer(*(elm)->hash_list_elem.tqe_prev,		\
+			       TAILQ_NEXT((elm), hash_list_elem));	\
+} while (0)
+
+/**
+ * dp_peer_hash_stats_update() - account a peer hash table lookup
+ * @stats: lookup stats of the current CPU
+ * @walk: number of peers compared by the lookup
+ * @miss: lookup did not return a peer
+ * @timed: lookup is one of the timed samples
+ * @start_ns: start time of the lookup, if @timed
+ *
+ * Return: none
+ */
+static inline void
+dp_peer_hash_stats_update(struct dp_peer_hash_stats *stats, uint32_t walk,
+			  bool miss, bool timed, uint64_t start_ns)
+{
+	uint64_t lat_ns;
+	uint8_t bucket = 0;
+
+	if (miss)
+		stats->miss++;
+
+	stats->walk += walk;
+	if (walk > stats->walk_max)
+		stats->walk_max = walk;
+	stats->walk_hist[QDF_MIN(walk, DP_PEER_HASH_WALK_BUCKETS - 1)]++;
+
+	if (!timed)
+		return;
+
+	lat_ns = qdf_ktime_to_ns(qdf_ktime_get()) - start_ns;
+	stats->lat_sample++;
+	stats->lat_sum_ns += lat_ns;
+	if (lat_ns > stats->lat_max_ns)
+		stats->lat_max_ns = lat_ns;
+
+	lat_ns >>= DP_PEER_HASH_LAT_MIN_SHIFT;
+	while (lat_ns && bucket < DP_PEER_HASH_LAT_BUCKETS - 1) {
+		lat_ns >>= 1;
+		bucket++;
+	}
+	stats->lat_hist[bucket]++;
+}
+
+/**
+ * dp_peer_unref_not_last() - release a peer reference unless it is the last
+ * @peer: DP peer
+ * @mod_id: id of module releasing the reference
+ *
+ * Unlike dp_peer_unref_delete(), never tears the peer down, so it can be
+ * used inside an RCU read section.
+ *
+ * Return: false if the reference is the last one, which is then still held
+ */
+static inline bool
+dp_peer_unref_not_last(struct dp_peer *peer, enum dp_mod_id mod_id)
+{
+	if (!qdf_atomic_add_unless(&peer->ref_cnt, -1, 1))
+		return false;
+
+	if (mod_id > DP_MOD_ID_RX)
+		QDF_ASSERT(qdf_atomic_dec_return(&peer->mod_refs[mod_id]) >= 0);
+
+	return true;
+}
+
 struct dp_peer *dp_peer_find_hash_find(
 				struct dp_soc *soc, uint8_t *peer_mac_addr,
 				int mac_addr_is_aligned, uint8_t vdev_id,
 				enum dp_mod_id mod_id)
 {
 	union dp_align_mac_addr local_mac_addr_aligned, *mac_addr;
-	uint32_t index;
-	struct dp_peer *peer;
+	struct dp_peer_hash_stats *stats;
+	uint32_t index, walk = 0;
+	uint64_t start_ns = 0;
+	struct dp_peer *peer, *dying;
+	bool timed;
 
 	if (!soc->peer_hash.bins)
 		return NULL;
 
+	/* stay on this CPU until its stats entry is updated */
+	stats = &soc->stats.peer_hash[qdf_get_cpu_hold()];
+	timed = !(stats->lookup++ &
+		  ((1 << DP_PEER_HASH_LAT_SAMPLE_SHIFT) - 1));
+	if (timed)
+		start_ns = qdf_ktime_to_ns(qdf_ktime_get());
+
 	if (mac_addr_is_aligned) {
 		mac_addr = (union dp_align_mac_addr *)peer_mac_addr;
 	} else {
@@ -389,22 +511,50 @@ struct dp_peer *dp_peer_find_hash_find(
 		mac_addr = &local_mac_addr_aligned;
 	}
 	index = dp_peer_find_hash_index(soc, mac_addr);
-	qdf_spin_lock_bh(&soc->peer_hash_lock);
-	TAILQ_FOREACH(peer, &soc->peer_hash.bins[index], hash_list_elem) {
-		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) == 0 &&
-		    ((peer->vdev->vdev_id == vdev_id) ||
-		     (vdev_id == DP_VDEV_ALL))) {
-			/* take peer reference before returning */
-			if (dp_peer_get_ref(soc, peer, mod_id) !=
-						QDF_STATUS_SUCCESS)
-				peer = NULL;
+again:
+	dying = NULL;
+	qdf_rcu_read_lock();
+	for (peer = qdf_rcu_dereference(TAILQ_FIRST(
+					&soc->peer_hash.bins[index]));
+	     peer;
+	     peer = qdf_rcu_dereference(TAILQ_NEXT(peer, hash_list_elem))) {
+		walk++;
+		if (dp_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr))
+			continue;
 
-			qdf_spin_unlock_bh(&soc->peer_hash_lock);
-			return peer;
+		/*
+		 * The hash table holds a reference on every peer linked in
+		 * it, so a peer whose count already dropped to zero is being
+		 * removed and is skipped. The reference also keeps the vdev
+		 * of the peer around while it is checked.
+		 */
+		if (dp_peer_get_ref(soc, peer, mod_id) != QDF_STATUS_SUCCESS)
+			continue;
+
+		if (peer->vdev->vdev_id == vdev_id || vdev_id == DP_VDEV_ALL)
+			break;
+
+		/*
+		 * Ours is only the last reference if the peer was removed
+		 * from the bin meanwhile. Its teardown waits until the read
+		 * section is over, and the walk then starts over without it.
+		 */
+		if (!dp_peer_unref_not_last(peer, mod_id)) {
+			dying = peer;
+			peer = NULL;
+			break;
 		}
 	}
-	qdf_spin_unlock_bh(&soc->peer_hash_lock);
-	return NULL; /* failure */
+	qdf_rcu_read_unlock();
+
+	if (dying) {
+		dp_peer_unref_delete(dying, mod_id);
+		goto again;
+	}
+
+	dp_peer_hash_stats_update(stats, walk, !peer, timed, start_ns);
+	qdf_put_cpu();
+	return peer;
 }
 
 qdf_export_symbol(dp_peer_find_hash_find);
@@ -419,6 +569,8 @@ qdf_export_symbol(dp_peer_find_hash_find);
 static void dp_peer_find_hash_detach(struct dp_soc *soc)
 {
 	if (soc->peer_hash.bins) {
+		/* let the deferred peer frees complete */
+		qdf_rcu_barrier();
 		qdf_mem_free(soc->peer_hash.bins);
 		soc->peer_hash.bins = NULL;
 		qdf_spinlock_destroy(&soc->peer_hash_lock);
@@ -490,8 +642,8 @@ void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 		 * this ensures that if two entries with the same MAC address
 		 * are stored, the one added first will be found first.
 		 */
-		TAILQ_INSERT_TAIL(&soc->peer_hash.bins[index], peer,
-				  hash_list_elem);
+		DP_PEER_HASH_INSERT_TAIL_RCU(&soc->peer_hash.bins[index],
+					     peer);
 
 		qdf_spin_unlock_bh(&soc->peer_hash_lock);
 	} else if (peer->peer_type == CDP_MLD_PEER_TYPE) {
@@ -523,8 +675,7 @@ void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 			}
 		}
 		QDF_ASSERT(found);
-		TAILQ_REMOVE(&soc->peer_hash.bins[index], peer,
-			     hash_list_elem);
+		DP_PEER_HASH_REMOVE_RCU(&soc->peer_hash.bins[index], peer);
 
 		dp_peer_unref_delete(peer, DP_MOD_ID_CONFIG);
 		qdf_spin_unlock_bh(&soc->peer_hash_lock);
@@ -576,6 +727,8 @@ static QDF_STATUS dp_peer_find_hash_attach(struct dp_soc *soc)
 static void dp_peer_find_hash_detach(struct dp_soc *soc)
 {
 	if (soc->peer_hash.bins) {
+		/* let the deferred peer frees complete */
+		qdf_rcu_barrier();
 		qdf_mem_free(soc->peer_hash.bins);
 		soc->peer_hash.bins = NULL;
 		qdf_spinlock_destroy(&soc->peer_hash_lock);
@@ -603,7 +756,7 @@ void dp_peer_find_hash_add(struct dp_soc *soc, struct dp_peer *peer)
 	 * the same MAC address are stored, the one added first will be
 	 * found first.
 	 */
-	TAILQ_INSERT_TAIL(&soc->peer_hash.bins[index], peer, hash_list_elem);
+	DP_PEER_HASH_INSERT_TAIL_RCU(&soc->peer_hash.bins[index], peer);
 
 	qdf_spin_unlock_bh(&soc->peer_hash_lock);
 }
@@ -626,7 +779,7 @@ void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 		}
 	}
 	QDF_ASSERT(found);
-	TAILQ_REMOVE(&soc->peer_hash.bins[index], peer, hash_list_elem);
+	DP_PEER_HASH_REMOVE_RCU(&soc->peer_hash.bins[index], peer);
 
 	dp_peer_unref_delete(peer, DP_MOD_ID_CONFIG);
 	qdf_spin_unlock_bh(&soc->peer_hash_lock);
@@ -635,6 +788,37 @@ void dp_peer_find_hash_remove(struct dp_soc *soc, struct dp_peer *peer)
 
 #endif/* WLAN_FEATURE_11BE_MLO */
 
+void dp_peer_find_hash_readd(struct dp_soc *soc, struct dp_peer *peer)
+{
+	unsigned int index;
+
+	if (IS_MLO_DP_MLD_PEER(peer)) {
+		dp_peer_find_hash_add(soc, peer);
+		return;
+	}
+
+	index = dp_peer_find_hash_index(soc, &peer->mac_addr);
+	qdf_spin_lock_bh(&soc->peer_hash_lock);
+
+	if (QDF_IS_STATUS_ERROR(dp_peer_get_ref(soc, peer, DP_MOD_ID_CONFIG))) {
+		dp_err("unable to get peer ref at reuse mac: "QDF_MAC_ADDR_FMT,
+		       QDF_MAC_ADDR_REF(peer->mac_addr.raw));
+		qdf_spin_unlock_bh(&soc->peer_hash_lock);
+		return;
+	}
+
+	/*
+	 * A lookup may still stand on the peer, from before it was removed,
+	 * and goes on with its next pointer. At the head of the bin, that
+	 * is the whole bin, whereas at the tail it would end the lookup.
+	 * If another vdev has a peer with the same MAC address, a lookup
+	 * for any vdev now finds the reused peer first.
+	 */
+	DP_PEER_HASH_INSERT_HEAD_RCU(&soc->peer_hash.bins[index], peer);
+
+	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+}
+
 void dp_peer_vdev_list_add(struct dp_soc *soc, struct dp_vdev *vdev,
 			   struct dp_peer *peer)
 {
@@ -3454,11 +3638,42 @@ dp_rx_sec_ind_handler(struct dp_soc *soc, uint16_t peer_id,
 }
 
 #ifdef QCA_PEER_EXT_STATS
-QDF_STATUS dp_peer_delay_stats_ctx_alloc(struct dp_soc *soc,
-					 struct dp_txrx_peer *txrx_peer)
+/**
+ * dp_peer_delay_stats_hist_init() - Initialize the peer delay histograms
+ * @delay_stats: peer delay stats
+ *
+ * Return: void
+ */
+static void
+dp_peer_delay_stats_hist_init(struct dp_peer_delay_stats *delay_stats)
 {
 	uint8_t tid, ctx_id;
 
+	for (tid = 0; tid < CDP_MAX_DATA_TIDS; tid++) {
+		for (ctx_id = 0; ctx_id < CDP_MAX_TXRX_CTX; ctx_id++) {
+			struct cdp_delay_tx_stats *tx_delay =
+			&delay_stats->delay_tid_stats[tid][ctx_id].tx_delay;
+			struct cdp_delay_rx_stats *rx_delay =
+			&delay_stats->delay_tid_stats[tid][ctx_id].rx_delay;
+
+			dp_hist_init(&tx_delay->tx_swq_delay,
+				     CDP_HIST_TYPE_SW_ENQEUE_DELAY);
+			dp_hist_init(&tx_delay->hwtx_delay,
+				     CDP_HIST_TYPE_HW_COMP_DELAY);
+			dp_hist_init(&rx_delay->to_stack_delay,
+				     CDP_HIST_TYPE_REAP_STACK);
+		}
+	}
+
+	if (delay_stats->log)
+		qdf_mem_zero(delay_stats->log,
+			     sizeof(struct dp_peer_delay_log) *
+			     CDP_MAX_DATA_TIDS * CDP_MAX_TXRX_CTX);
+}
+
+QDF_STATUS dp_peer_delay_stats_ctx_alloc(struct dp_soc *soc,
+					 struct dp_txrx_peer *txrx_peer)
+{
 	if (!soc || !txrx_peer) {
 		dp_warn("Null soc%pK or peer%pK", soc, txrx_peer);
 		return QDF_STATUS_E_INVAL;
@@ -3477,22 +3692,20 @@ QDF_STATUS dp_peer_delay_stats_ctx_alloc(struct dp_soc *soc,
 		return QDF_STATUS_E_NOMEM;
 	}
 
-	for (tid = 0; tid < CDP_MAX_DATA_TIDS; tid++) {
-		for (ctx_id = 0; ctx_id < CDP_MAX_TXRX_CTX; ctx_id++) {
-			struct cdp_delay_tx_stats *tx_delay =
-			&txrx_peer->delay_stats->delay_tid_stats[tid][ctx_id].tx_delay;
-			struct cdp_delay_rx_stats *rx_delay =
-			&txrx_peer->delay_stats->delay_tid_stats[tid][ctx_id].rx_delay;
-
-			dp_hist_init(&tx_delay->tx_swq_delay,
-				     CDP_HIST_TYPE_SW_ENQEUE_DELAY);
-			dp_hist_init(&tx_delay->hwtx_delay,
-				     CDP_HIST_TYPE_HW_COMP_DELAY);
-			dp_hist_init(&rx_delay->to_stack_delay,
-				     CDP_HIST_TYPE_REAP_STACK);
-		}
+	/*
+	 * The log-linear buckets are most of the size of the delay stats,
+	 * so they are only allocated when the percentiles are asked for.
+	 */
+	if (wlan_cfg_is_peer_delay_percentile_enabled(soc->wlan_cfg_ctx)) {
+		txrx_peer->delay_stats->log =
+			qdf_mem_malloc(sizeof(struct dp_peer_delay_log) *
+				       CDP_MAX_DATA_TIDS * CDP_MAX_TXRX_CTX);
+		if (!txrx_peer->delay_stats->log)
+			dp_warn("Peer delay percentiles alloc failed");
 	}
 
+	dp_peer_delay_stats_hist_init(txrx_peer->delay_stats);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -3510,15 +3723,23 @@ void dp_peer_delay_stats_ctx_dealloc(struct dp_soc *soc,
 	if (!txrx_peer->delay_stats)
 		return;
 
+	if (txrx_peer->delay_stats->log)
+		qdf_mem_free(txrx_peer->delay_stats->log);
 	qdf_mem_free(txrx_peer->delay_stats);
 	txrx_peer->delay_stats = NULL;
 }
 
 void dp_peer_delay_stats_ctx_clr(struct dp_txrx_peer *txrx_peer)
 {
-	if (txrx_peer->delay_stats)
-		qdf_mem_zero(txrx_peer->delay_stats,
-			     sizeof(struct dp_peer_delay_stats));
+	struct dp_peer_delay_stats *delay_stats = txrx_peer->delay_stats;
+
+	if (!delay_stats)
+		return;
+
+	/* the log-linear buckets stay allocated and are cleared on init */
+	qdf_mem_zero(delay_stats->delay_tid_stats,
+		     sizeof(delay_stats->delay_tid_stats));
+	dp_peer_delay_stats_hist_init(delay_stats);
 }
 #endif
 
@@ -1223,6 +1223,25 @@ void dp_peer_delay_stats_ctx_dealloc(struct dp_soc *soc,
  * Return: void
  */
 void dp_peer_delay_stats_ctx_clr(struct dp_txrx_peer *txrx_peer);
+
+/**
+ * dp_peer_delay_log_get() - Get the log-linear buckets of a TID and ring
+ * @delay_stats: peer delay stats
+ * @tid: TID
+ * @ctx_id: ring context
+ *
+ * Return: the buckets of the delay histograms of @tid and @ctx_id, NULL if
+ *	   the delay percentiles are not tracked
+ */
+static inline struct dp_peer_delay_log *
+dp_peer_delay_log_get(struct dp_peer_delay_stats *delay_stats, uint8_t tid,
+		      uint8_t ctx_id)
+{
+	if (!delay_stats->log)
+		return NULL;
+
+	return &delay_stats->log[tid * CDP_MAX_TXRX_CTX + ctx_id];
+}
 #else
 static inline
 QDF_STATUS dp_peer_delay_stats_ctx_alloc(struct dp_soc *soc,
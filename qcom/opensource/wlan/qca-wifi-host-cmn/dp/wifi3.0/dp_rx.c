@@ -1956,12 +1956,13 @@ bool dp_rx_is_sg_supported(void)
 
 #ifdef QCA_PEER_EXT_STATS
 void dp_rx_compute_tid_delay(struct cdp_delay_tid_stats *stats,
-			     qdf_nbuf_t nbuf)
+			     struct dp_peer_delay_log *log, qdf_nbuf_t nbuf)
 {
 	struct cdp_delay_rx_stats  *rx_delay = &stats->rx_delay;
 	uint32_t to_stack = qdf_nbuf_get_timedelta_ms(nbuf);
 
-	dp_hist_update_stats(&rx_delay->to_stack_delay, to_stack);
+	dp_hist_update_stats(&rx_delay->to_stack_delay,
+			     log ? &log->to_stack_delay : NULL, to_stack);
 }
 #endif /* QCA_PEER_EXT_STATS */
 
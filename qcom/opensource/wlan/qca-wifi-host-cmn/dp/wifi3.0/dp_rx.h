@@ -1865,11 +1865,13 @@ void dp_rx_compute_delay(struct dp_vdev *vdev, qdf_nbuf_t nbuf);
 /**
  * dp_rx_compute_tid_delay - Compute per TID delay stats
  * @stats: TID delay stats to update
+ * @log: Log-linear buckets of @stats, NULL if the percentiles are not tracked
  * @nbuf: NBuffer
  *
  * Return: Void
  */
 void dp_rx_compute_tid_delay(struct cdp_delay_tid_stats *stats,
+			     struct dp_peer_delay_log *log,
 			     qdf_nbuf_t nbuf);
 #endif /* QCA_PEER_EXT_STATS */
 
@@ -6848,11 +6848,13 @@ static void dp_print_jitter_stats(struct dp_peer *peer, struct dp_pdev *pdev)
  * dp_print_hist_stats() - Print delay histogram
  * @hstats: Histogram stats
  * @hist_type: histogram type
+ * @percentiles: the percentiles of @hstats are tracked and get printed
  *
  * Return: void
  */
 static void dp_print_hist_stats(struct cdp_hist_stats *hstats,
-				enum cdp_hist_types hist_type)
+				enum cdp_hist_types hist_type,
+				bool percentiles)
 {
 	uint8_t index = 0;
 	uint64_t count = 0;
@@ -6884,7 +6886,14 @@ static void dp_print_hist_stats(struct cdp_hist_stats *hstats,
 	if (hist_delay_data) {
 		DP_PRINT_STATS("Min = %u", hstats->min);
 		DP_PRINT_STATS("Max = %u", hstats->max);
-		DP_PRINT_STATS("Avg = %u\n", hstats->avg);
+		if (!percentiles) {
+			DP_PRINT_STATS("Avg = %u\n", hstats->avg);
+			return;
+		}
+		DP_PRINT_STATS("Avg = %u", hstats->avg);
+		DP_PRINT_STATS("P50 = %u", hstats->p50);
+		DP_PRINT_STATS("P99 = %u", hstats->p99);
+		DP_PRINT_STATS("P99.9 = %u\n", hstats->p999);
 	}
 }
 
@@ -6940,67 +6949,85 @@ static void dp_accumulate_delay_avg_stats(struct cdp_delay_tid_stats stats[]
  * dp_accumulate_delay_tid_stats(): Accumulate the tid stats to the
  *                                  hist stats.
  * @soc: DP SoC handle
- * @stats: cdp_delay_tid stats
+ * @delay_stats: peer delay stats
  * @dst_hstats: Destination histogram to copy tid stats
+ * @dst_log: Log-linear buckets of @dst_hstats, NULL if the percentiles
+ *	     are not worked out
  * @tid: TID value
  * @mode:
  *
  * Return: void
  */
 static void dp_accumulate_delay_tid_stats(struct dp_soc *soc,
-					  struct cdp_delay_tid_stats stats[]
-					  [CDP_MAX_TXRX_CTX],
+					  struct dp_peer_delay_stats
+					  *delay_stats,
 					  struct cdp_hist_stats *dst_hstats,
+					  struct cdp_hist_log *dst_log,
 					  uint8_t tid, uint32_t mode)
 {
 	uint8_t ring_id;
 
 	if (wlan_cfg_get_dp_soc_nss_cfg(soc->wlan_cfg_ctx)) {
 		struct cdp_delay_tid_stats *dstats =
-				&stats[tid][0];
+				&delay_stats->delay_tid_stats[tid][0];
+		struct dp_peer_delay_log *log =
+				dp_peer_delay_log_get(delay_stats, tid, 0);
 		struct cdp_hist_stats *src_hstats = NULL;
+		struct cdp_hist_log *src_log = NULL;
 
 		switch (mode) {
 		case CDP_HIST_TYPE_SW_ENQEUE_DELAY:
 			src_hstats = &dstats->tx_delay.tx_swq_delay;
+			src_log = log ? &log->tx_swq_delay : NULL;
 			break;
 		case CDP_HIST_TYPE_HW_COMP_DELAY:
 			src_hstats = &dstats->tx_delay.hwtx_delay;
+			src_log = log ? &log->hwtx_delay : NULL;
 			break;
 		case CDP_HIST_TYPE_REAP_STACK:
 			src_hstats = &dstats->rx_delay.to_stack_delay;
+			src_log = log ? &log->to_stack_delay : NULL;
 			break;
 		default:
 			break;
 		}
 
 		if (src_hstats)
-			dp_copy_hist_stats(src_hstats, dst_hstats);
+			dp_copy_hist_stats(src_hstats, src_log,
+					   dst_hstats, dst_log);
 
 		return;
 	}
 
 	for (ring_id = 0; ring_id < CDP_MAX_TXRX_CTX; ring_id++) {
 		struct cdp_delay_tid_stats *dstats =
-				&stats[tid][ring_id];
+				&delay_stats->delay_tid_stats[tid][ring_id];
+		struct dp_peer_delay_log *log =
+				dp_peer_delay_log_get(delay_stats, tid,
+						      ring_id);
 		struct cdp_hist_stats *src_hstats = NULL;
+		struct cdp_hist_log *src_log = NULL;
 
 		switch (mode) {
 		case CDP_HIST_TYPE_SW_ENQEUE_DELAY:
 			src_hstats = &dstats->tx_delay.tx_swq_delay;
+			src_log = log ? &log->tx_swq_delay : NULL;
 			break;
 		case CDP_HIST_TYPE_HW_COMP_DELAY:
 			src_hstats = &dstats->tx_delay.hwtx_delay;
+			src_log = log ? &log->hwtx_delay : NULL;
 			break;
 		case CDP_HIST_TYPE_REAP_STACK:
 			src_hstats = &dstats->rx_delay.to_stack_delay;
+			src_log = log ? &log->to_stack_delay : NULL;
 			break;
 		default:
 			break;
 		}
 
 		if (src_hstats)
-			dp_accumulate_hist_stats(src_hstats, dst_hstats);
+			dp_accumulate_hist_stats(src_hstats, src_log,
+						 dst_hstats, dst_log);
 	}
 }
 
@@ -7017,6 +7044,7 @@ static void dp_peer_print_tx_delay_stats(struct dp_pdev *pdev,
 	struct dp_peer_delay_stats *delay_stats;
 	struct dp_soc *soc = NULL;
 	struct cdp_hist_stats hist_stats;
+	struct cdp_hist_log hist_log, *log;
 	uint8_t tid;
 
 	if (!peer || !peer->txrx_peer)
@@ -7033,21 +7061,26 @@ static void dp_peer_print_tx_delay_stats(struct dp_pdev *pdev,
 	if (!delay_stats)
 		return;
 
+	log = delay_stats->log ? &hist_log : NULL;
 	for (tid = 0; tid < CDP_MAX_DATA_TIDS; tid++) {
 		DP_PRINT_STATS("----TID: %d----", tid);
 		DP_PRINT_STATS("Software Enqueue Delay:");
 		dp_hist_init(&hist_stats, CDP_HIST_TYPE_SW_ENQEUE_DELAY);
-		dp_accumulate_delay_tid_stats(soc, delay_stats->delay_tid_stats,
-					      &hist_stats, tid,
+		qdf_mem_zero(&hist_log, sizeof(hist_log));
+		dp_accumulate_delay_tid_stats(soc, delay_stats, &hist_stats,
+					      log, tid,
 					      CDP_HIST_TYPE_SW_ENQEUE_DELAY);
-		dp_print_hist_stats(&hist_stats, CDP_HIST_TYPE_SW_ENQEUE_DELAY);
+		dp_print_hist_stats(&hist_stats, CDP_HIST_TYPE_SW_ENQEUE_DELAY,
+				    !!log);
 
 		DP_PRINT_STATS("Hardware Transmission Delay:");
 		dp_hist_init(&hist_stats, CDP_HIST_TYPE_HW_COMP_DELAY);
-		dp_accumulate_delay_tid_stats(soc, delay_stats->delay_tid_stats,
-					      &hist_stats, tid,
+		qdf_mem_zero(&hist_log, sizeof(hist_log));
+		dp_accumulate_delay_tid_stats(soc, delay_stats, &hist_stats,
+					      log, tid,
 					      CDP_HIST_TYPE_HW_COMP_DELAY);
-		dp_print_hist_stats(&hist_stats, CDP_HIST_TYPE_HW_COMP_DELAY);
+		dp_print_hist_stats(&hist_stats, CDP_HIST_TYPE_HW_COMP_DELAY,
+				    !!log);
 	}
 }
 
@@ -7064,6 +7097,7 @@ static void dp_peer_print_rx_delay_stats(struct dp_pdev *pdev,
 	struct dp_peer_delay_stats *delay_stats;
 	struct dp_soc *soc = NULL;
 	struct cdp_hist_stats hist_stats;
+	struct cdp_hist_log hist_log, *log;
 	uint8_t tid;
 
 	if (!peer || !peer->txrx_peer)
@@ -7080,14 +7114,17 @@ static void dp_peer_print_rx_delay_stats(struct dp_pdev *pdev,
 	if (!delay_stats)
 		return;
 
+	log = delay_stats->log ? &hist_log : NULL;
 	for (tid = 0; tid < CDP_MAX_DATA_TIDS; tid++) {
 		DP_PRINT_STATS("----TID: %d----", tid);
 		DP_PRINT_STATS("Rx Reap2stack Deliver Delay:");
 		dp_hist_init(&hist_stats, CDP_HIST_TYPE_REAP_STACK);
-		dp_accumulate_delay_tid_stats(soc, delay_stats->delay_tid_stats,
-					      &hist_stats, tid,
+		qdf_mem_zero(&hist_log, sizeof(hist_log));
+		dp_accumulate_delay_tid_stats(soc, delay_stats, &hist_stats,
+					      log, tid,
 					      CDP_HIST_TYPE_REAP_STACK);
-		dp_print_hist_stats(&hist_stats, CDP_HIST_TYPE_REAP_STACK);
+		dp_print_hist_stats(&hist_stats, CDP_HIST_TYPE_REAP_STACK,
+				    !!log);
 	}
 }
 
@@ -8597,6 +8634,79 @@ dp_print_soc_rx_stats(struct dp_soc *soc)
 	dp_print_assert_war_stats(soc);
 }
 
+void dp_print_peer_hash_stats(struct dp_soc *soc)
+{
+	struct dp_peer_hash_stats total = {0};
+	struct dp_peer_hash_stats *stats;
+	uint32_t chain_hist[DP_PEER_HASH_WALK_BUCKETS] = {0};
+	uint32_t i, j, len, max_len = 0, used = 0;
+	struct dp_peer *peer;
+
+	for (i = 0; i < NR_CPUS; i++) {
+		stats = &soc->stats.peer_hash[i];
+		total.lookup += stats->lookup;
+		total.miss += stats->miss;
+		total.walk += stats->walk;
+		total.walk_max = QDF_MAX(total.walk_max, stats->walk_max);
+		total.lat_sample += stats->lat_sample;
+		total.lat_sum_ns += stats->lat_sum_ns;
+		total.lat_max_ns = QDF_MAX(total.lat_max_ns,
+					   stats->lat_max_ns);
+		for (j = 0; j < DP_PEER_HASH_WALK_BUCKETS; j++)
+			total.walk_hist[j] += stats->walk_hist[j];
+		for (j = 0; j < DP_PEER_HASH_LAT_BUCKETS; j++)
+			total.lat_hist[j] += stats->lat_hist[j];
+	}
+
+	DP_PRINT_STATS("Peer Hash Stats:");
+	DP_PRINT_STATS("	Lookups = %llu", total.lookup);
+	DP_PRINT_STATS("	Misses = %llu", total.miss);
+	DP_PRINT_STATS("	Peers compared: avg = %llu.%02llu max = %u",
+		       total.lookup ? total.walk / total.lookup : 0,
+		       total.lookup ?
+		       (total.walk * 100 / total.lookup) % 100 : 0,
+		       total.walk_max);
+	for (j = 0; j < DP_PEER_HASH_WALK_BUCKETS - 1; j++)
+		DP_PRINT_STATS("	%u compared = %u", j,
+			       total.walk_hist[j]);
+	DP_PRINT_STATS("	%u+ compared = %u", j, total.walk_hist[j]);
+
+	DP_PRINT_STATS("	Timed lookups = %u avg = %llu ns max = %llu ns",
+		       total.lat_sample,
+		       total.lat_sample ?
+		       total.lat_sum_ns / total.lat_sample : 0,
+		       total.lat_max_ns);
+	for (j = 0; j < DP_PEER_HASH_LAT_BUCKETS - 1; j++)
+		DP_PRINT_STATS("	< %u ns = %u",
+			       1 << (DP_PEER_HASH_LAT_MIN_SHIFT + j),
+			       total.lat_hist[j]);
+	DP_PRINT_STATS("	>= %u ns = %u",
+		       1 << (DP_PEER_HASH_LAT_MIN_SHIFT + j - 1),
+		       total.lat_hist[j]);
+
+	if (!soc->peer_hash.bins)
+		return;
+
+	qdf_spin_lock_bh(&soc->peer_hash_lock);
+	for (i = 0; i <= soc->peer_hash.mask; i++) {
+		len = 0;
+		TAILQ_FOREACH(peer, &soc->peer_hash.bins[i], hash_list_elem)
+			len++;
+		if (len)
+			used++;
+		max_len = QDF_MAX(max_len, len);
+		chain_hist[QDF_MIN(len, DP_PEER_HASH_WALK_BUCKETS - 1)]++;
+	}
+	qdf_spin_unlock_bh(&soc->peer_hash_lock);
+
+	DP_PRINT_STATS("	Bins = %u used = %u longest chain = %u",
+		       soc->peer_hash.mask + 1, used, max_len);
+	for (j = 0; j < DP_PEER_HASH_WALK_BUCKETS - 1; j++)
+		DP_PRINT_STATS("	Chains of %u peers = %u", j,
+			       chain_hist[j]);
+	DP_PRINT_STATS("	Chains of %u+ peers = %u", j, chain_hist[j]);
+}
+
 #ifdef FEATURE_TSO_STATS
 void dp_print_tso_stats(struct dp_soc *soc,
 			enum qdf_stats_verbosity_level level)
@@ -9720,6 +9830,33 @@ QDF_STATUS dp_txrx_get_soc_stats(struct cdp_soc_t *soc_hdl,
 }
 
 #ifdef QCA_PEER_EXT_STATS
+/**
+ * dp_accumulate_peer_delay_hist() - Accumulate a peer delay histogram into
+ *				     a caller provided one
+ * @soc: DP SoC handle
+ * @pext_stats: peer delay stats
+ * @dst_hstats: Destination histogram
+ * @tid: TID value
+ * @mode: histogram type
+ *
+ * The log-linear buckets used to work out the percentiles of @dst_hstats
+ * only live for the duration of the call.
+ *
+ * Return: void
+ */
+static void dp_accumulate_peer_delay_hist(struct dp_soc *soc,
+					  struct dp_peer_delay_stats *pext_stats,
+					  struct cdp_hist_stats *dst_hstats,
+					  uint8_t tid, uint32_t mode)
+{
+	struct cdp_hist_log hist_log;
+
+	qdf_mem_zero(&hist_log, sizeof(hist_log));
+	dp_accumulate_delay_tid_stats(soc, pext_stats, dst_hstats,
+				      pext_stats->log ? &hist_log : NULL,
+				      tid, mode);
+}
+
 QDF_STATUS
 dp_txrx_get_peer_delay_stats(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 			     uint8_t *peer_mac,
@@ -9756,17 +9893,17 @@ dp_txrx_get_peer_delay_stats(struct cdp_soc_t *soc_hdl, uint8_t vdev_id,
 
 	for (tid = 0; tid < CDP_MAX_DATA_TIDS; tid++) {
 		rx_delay = &delay_stats[tid].rx_delay;
-		dp_accumulate_delay_tid_stats(soc, pext_stats->delay_tid_stats,
+		dp_accumulate_peer_delay_hist(soc, pext_stats,
 					      &rx_delay->to_stack_delay, tid,
 					      CDP_HIST_TYPE_REAP_STACK);
 		tx_delay = &delay_stats[tid].tx_delay;
 		dp_accumulate_delay_avg_stats(pext_stats->delay_tid_stats,
 					      tx_delay,
 					      tid);
-		dp_accumulate_delay_tid_stats(soc, pext_stats->delay_tid_stats,
+		dp_accumulate_peer_delay_hist(soc, pext_stats,
 					      &tx_delay->tx_swq_delay, tid,
 					      CDP_HIST_TYPE_SW_ENQEUE_DELAY);
-		dp_accumulate_delay_tid_stats(soc, pext_stats->delay_tid_stats,
+		dp_accumulate_peer_delay_hist(soc, pext_stats,
 					      &tx_delay->hwtx_delay, tid,
 					      CDP_HIST_TYPE_HW_COMP_DELAY);
 	}
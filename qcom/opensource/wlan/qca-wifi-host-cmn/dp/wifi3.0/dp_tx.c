@@ -4820,6 +4820,7 @@ dp_tx_compute_delay_avg(struct cdp_delay_tx_stats *tx_delay,
 #ifdef QCA_PEER_EXT_STATS
 #ifdef WLAN_CONFIG_TX_DELAY
 static void dp_tx_compute_tid_delay(struct cdp_delay_tid_stats *stats,
+				    struct dp_peer_delay_log *log,
 				    struct dp_tx_desc_s *tx_desc,
 				    struct hal_tx_completion_status *ts,
 				    struct dp_vdev *vdev)
@@ -4836,12 +4837,15 @@ static void dp_tx_compute_tid_delay(struct cdp_delay_tid_stats *stats,
 	timestamp_hw_enqueue = qdf_ktime_to_us(tx_desc->timestamp);
 
 	sw_enqueue_delay = (uint32_t)(timestamp_hw_enqueue - timestamp_ingress);
-	dp_hist_update_stats(&tx_delay->tx_swq_delay, sw_enqueue_delay);
+	dp_hist_update_stats(&tx_delay->tx_swq_delay,
+			     log ? &log->tx_swq_delay : NULL,
+			     sw_enqueue_delay);
 
 	if (soc->arch_ops.dp_tx_compute_hw_delay)
 		if (!soc->arch_ops.dp_tx_compute_hw_delay(soc, vdev, ts,
 							  &fwhw_transmit_delay))
 			dp_hist_update_stats(&tx_delay->hwtx_delay,
+					     log ? &log->hwtx_delay : NULL,
 					     fwhw_transmit_delay);
 
 	dp_tx_compute_delay_avg(tx_delay, 0, sw_enqueue_delay,
@@ -4851,6 +4855,7 @@ static void dp_tx_compute_tid_delay(struct cdp_delay_tid_stats *stats,
 /**
  * dp_tx_compute_tid_delay() - Compute per TID delay
  * @stats: Per TID delay stats
+ * @log: Log-linear buckets of @stats, NULL if the percentiles are not tracked
  * @tx_desc: Software Tx descriptor
  * @ts: Tx completion status
  * @vdev: vdev
@@ -4861,6 +4866,7 @@ static void dp_tx_compute_tid_delay(struct cdp_delay_tid_stats *stats,
  * Return: void
  */
 static void dp_tx_compute_tid_delay(struct cdp_delay_tid_stats *stats,
+				    struct dp_peer_delay_log *log,
 				    struct dp_tx_desc_s *tx_desc,
 				    struct hal_tx_completion_status *ts,
 				    struct dp_vdev *vdev)
@@ -4879,8 +4885,12 @@ static void dp_tx_compute_tid_delay(struct cdp_delay_tid_stats *stats,
 	/*
 	 * Update the Tx software enqueue delay and HW enque-Completion delay.
 	 */
-	dp_hist_update_stats(&tx_delay->tx_swq_delay, sw_enqueue_delay);
-	dp_hist_update_stats(&tx_delay->hwtx_delay, fwhw_transmit_delay);
+	dp_hist_update_stats(&tx_delay->tx_swq_delay,
+			     log ? &log->tx_swq_delay : NULL,
+			     sw_enqueue_delay);
+	dp_hist_update_stats(&tx_delay->hwtx_delay,
+			     log ? &log->hwtx_delay : NULL,
+			     fwhw_transmit_delay);
 }
 #endif
 
@@ -4923,6 +4933,8 @@ static void dp_tx_update_peer_delay_stats(struct dp_txrx_peer *txrx_peer,
 		tid = CDP_MAX_DATA_TIDS - 1;
 
 	dp_tx_compute_tid_delay(&delay_stats->delay_tid_stats[tid][ring_id],
+				dp_peer_delay_log_get(delay_stats, tid,
+						      ring_id),
 				tx_desc, ts, txrx_peer->vdev);
 }
 #else
@@ -919,9 +919,30 @@ struct dp_reo_cmd_info {
 	TAILQ_ENTRY(dp_reo_cmd_info) reo_cmd_list_elem;
 };
 
+/**
+ * struct dp_peer_delay_log - Log-linear buckets of the delay histograms of
+ *			      one TID and ring context
+ * @tx_swq_delay: buckets of the software enqueue delay
+ * @hwtx_delay: buckets of the HW enqueue to completion delay
+ * @to_stack_delay: buckets of the to stack delay
+ */
+struct dp_peer_delay_log {
+	struct cdp_hist_log tx_swq_delay;
+	struct cdp_hist_log hwtx_delay;
+	struct cdp_hist_log to_stack_delay;
+};
+
+/**
+ * struct dp_peer_delay_stats - Peer extended delay stats
+ * @delay_tid_stats: delay stats per TID and ring context
+ * @log: log-linear buckets of the delay histograms, indexed as
+ *	 [tid * CDP_MAX_TXRX_CTX + ring], only allocated when the delay
+ *	 percentiles are enabled
+ */
 struct dp_peer_delay_stats {
 	struct cdp_delay_tid_stats delay_tid_stats[CDP_MAX_DATA_TIDS]
 						  [CDP_MAX_TXRX_CTX];
+	struct dp_peer_delay_log *log;
 };
 
 /* Rx TID defrag*/
@@ -1206,6 +1227,43 @@ struct htt_t2h_msg_stats {
 	uint32_t ml_peer_unmap;
 };
 
+#define DP_PEER_HASH_WALK_BUCKETS 8
+#define DP_PEER_HASH_LAT_BUCKETS 8
+/* first latency bucket holds lookups under 2^DP_PEER_HASH_LAT_MIN_SHIFT ns */
+#define DP_PEER_HASH_LAT_MIN_SHIFT 7
+/* one in 2^DP_PEER_HASH_LAT_SAMPLE_SHIFT lookups is timed */
+#define DP_PEER_HASH_LAT_SAMPLE_SHIFT 6
+
+/**
+ * struct dp_peer_hash_stats - peer hash table lookup stats of a CPU
+ * @lookup: number of lookups
+ * @miss: number of lookups which did not return a peer
+ * @walk: number of peers compared by all the lookups
+ * @walk_max: highest number of peers compared by a single lookup
+ * @walk_hist: lookups per number of peers compared, the last bucket
+ *             counting all the longer walks
+ * @lat_sample: number of timed lookups
+ * @lat_max_ns: longest timed lookup
+ * @lat_sum_ns: total time of the timed lookups
+ * @lat_hist: timed lookups per power of two of the lookup time, bucket 0
+ *            counting the ones under 2^DP_PEER_HASH_LAT_MIN_SHIFT ns and the
+ *            last bucket all the longer ones
+ *
+ * Each CPU updates only its own entry, with preemption disabled, and the
+ * entries are cache line aligned so that they do not share lines.
+ */
+struct dp_peer_hash_stats {
+	uint64_t lookup;
+	uint64_t miss;
+	uint64_t walk;
+	uint32_t walk_max;
+	uint32_t walk_hist[DP_PEER_HASH_WALK_BUCKETS];
+	uint32_t lat_sample;
+	uint64_t lat_max_ns;
+	uint64_t lat_sum_ns;
+	uint32_t lat_hist[DP_PEER_HASH_LAT_BUCKETS];
+} qdf_cacheline_aligned;
+
 /* SoC level data path statistics */
 struct dp_soc_stats {
 	struct {
@@ -1221,6 +1279,9 @@ struct dp_soc_stats {
 		uint32_t deleted;
 	} mec;
 
+	/* peer hash table lookups per CPU */
+	struct dp_peer_hash_stats peer_hash[NR_CPUS];
+
 	/* SOC level TX stats */
 	struct {
 		/* Total packets transmitted */
@@ -5085,6 +5146,8 @@ struct dp_peer {
 	TAILQ_ENTRY(dp_peer) peer_list_elem;
 	/* node in the hash table bin's list of peers */
 	TAILQ_ENTRY(dp_peer) hash_list_elem;
+	/* frees the peer once the lockless hash lookups are done with it */
+	qdf_rcu_head_t rcu_head;
 
 	/* TID structures pointer */
 	struct dp_rx_tid *rx_tid;
@@ -200,7 +200,6 @@ hal_rx_flow_delete_entry(hal_soc_handle_t hal_soc_hdl,
 
 qdf_export_symbol(hal_rx_flow_delete_entry);
 
-#ifndef WLAN_SUPPORT_RX_FISA
 /**
  * hal_rx_fst_key_configure() - Configure the Toeplitz key in the FST
  * @fst: Pointer to the Rx Flow Search Table
@@ -225,11 +224,6 @@ static void hal_rx_fst_key_configure(struct hal_rx_fst *fst)
 	key_bitwise_shift_left(key_bytes, HAL_FST_HASH_KEY_SIZE_BYTES, 5);
 	key_reverse(fst->shifted_key, key_bytes, HAL_FST_HASH_KEY_SIZE_BYTES);
 }
-#else
-static void hal_rx_fst_key_configure(struct hal_rx_fst *fst)
-{
-}
-#endif
 
 /**
  * hal_rx_fst_get_base() - Retrieve the virtual base address of the Rx FST
@@ -285,7 +279,6 @@ hal_rx_flow_get_tuple_info(hal_soc_handle_t hal_soc_hdl,
 	return NULL;
 }
 
-#ifndef WLAN_SUPPORT_RX_FISA
 /**
  * hal_flow_toeplitz_create_cache() - Calculate hashes for each possible
  *                                    byte value with the key taken as is
@@ -346,11 +339,17 @@ static void hal_flow_toeplitz_create_cache(struct hal_rx_fst *fst)
 		cur_key = cur_key << 8 | new_key_byte;
 	}
 }
-#else
-static void hal_flow_toeplitz_create_cache(struct hal_rx_fst *fst)
+
+void hal_rx_fst_key_init(struct hal_rx_fst *fst, uint8_t *hash_key)
 {
+	fst->key = hash_key;
+	if (!hash_key)
+		return;
+
+	hal_rx_fst_key_configure(fst);
+	hal_flow_toeplitz_create_cache(fst);
 }
-#endif
+qdf_export_symbol(hal_rx_fst_key_init);
 
 struct hal_rx_fst *
 hal_rx_fst_attach(hal_soc_handle_t hal_soc_hdl,
@@ -417,8 +416,7 @@ hal_rx_fst_attach(hal_soc_handle_t hal_soc_hdl,
 		    (fst->max_entries * fst_entry_size), 0);
 
 out:
-	hal_rx_fst_key_configure(fst);
-	hal_flow_toeplitz_create_cache(fst);
+	hal_rx_fst_key_init(fst, hash_key);
 
 	return fst;
 }
@@ -446,36 +444,98 @@ void hal_rx_fst_detach(hal_soc_handle_t hal_soc_hdl, struct hal_rx_fst *rx_fst,
 }
 qdf_export_symbol(hal_rx_fst_detach);
 
-#ifndef WLAN_SUPPORT_RX_FISA
+/*
+ * Row of key_cache[] used for each byte of the Toeplitz input. The input
+ * is consumed from its last byte (protocol) to its first (source IP), so
+ * the ports come first and each IP word is hashed from its LSB up.
+ */
+#define HAL_FST_HASH_POS_PROTO		0
+#define HAL_FST_HASH_POS_DEST_PORT	1
+#define HAL_FST_HASH_POS_SRC_PORT	3
+#define HAL_FST_HASH_POS_DEST_IP	5
+#define HAL_FST_HASH_POS_SRC_IP		21
+
+/**
+ * hal_flow_toeplitz_hash_word() - Hash one 32-bit word of the input
+ * @fst: FST Handle
+ * @pos: key_cache[] row of the LSB of the word
+ * @val: word in host byte order
+ *
+ * A zero byte always hashes to zero, so zero words can be skipped.
+ *
+ * Return: partial hash of the word
+ */
+static inline uint32_t
+hal_flow_toeplitz_hash_word(struct hal_rx_fst *fst, int pos, uint32_t val)
+{
+	if (!val)
+		return 0;
+
+	return fst->key_cache[pos][val & 0xff] ^
+	       fst->key_cache[pos + 1][(val >> 8) & 0xff] ^
+	       fst->key_cache[pos + 2][(val >> 16) & 0xff] ^
+	       fst->key_cache[pos + 3][val >> 24];
+}
+
+/**
+ * hal_flow_toeplitz_hash_tuple() - Toeplitz hash of a 5-tuple
+ * @fst: FST Handle
+ * @tuple: 5-tuple of the flow
+ *
+ * Bit exact with hashing the 37 byte input buffer through key_cache[],
+ * without building it. IPv4 tuples only hash 13 bytes.
+ *
+ * Return: untruncated hash
+ */
+static inline uint32_t
+hal_flow_toeplitz_hash_tuple(struct hal_rx_fst *fst,
+			     struct hal_flow_tuple_info *tuple)
+{
+	uint32_t (*key_cache)[1 << 8] = fst->key_cache;
+	uint32_t hash;
+
+	hash = key_cache[HAL_FST_HASH_POS_PROTO][tuple->l4_protocol & 0xff] ^
+	       key_cache[HAL_FST_HASH_POS_DEST_PORT][tuple->dest_port >> 8] ^
+	       key_cache[HAL_FST_HASH_POS_DEST_PORT + 1][tuple->dest_port &
+							 0xff] ^
+	       key_cache[HAL_FST_HASH_POS_SRC_PORT][tuple->src_port >> 8] ^
+	       key_cache[HAL_FST_HASH_POS_SRC_PORT + 1][tuple->src_port &
+							0xff];
+
+	hash ^= hal_flow_toeplitz_hash_word(fst, HAL_FST_HASH_POS_DEST_IP,
+					    tuple->dest_ip_31_0);
+	hash ^= hal_flow_toeplitz_hash_word(fst, HAL_FST_HASH_POS_SRC_IP,
+					    tuple->src_ip_31_0);
+
+	/* IPv4 short tuple, the upper IPv6 words are all zero */
+	if (!(tuple->dest_ip_127_96 | tuple->dest_ip_95_64 |
+	      tuple->dest_ip_63_32 | tuple->src_ip_127_96 |
+	      tuple->src_ip_95_64 | tuple->src_ip_63_32))
+		return hash;
+
+	hash ^= hal_flow_toeplitz_hash_word(fst, HAL_FST_HASH_POS_DEST_IP + 4,
+					    tuple->dest_ip_63_32);
+	hash ^= hal_flow_toeplitz_hash_word(fst, HAL_FST_HASH_POS_DEST_IP + 8,
+					    tuple->dest_ip_95_64);
+	hash ^= hal_flow_toeplitz_hash_word(fst, HAL_FST_HASH_POS_DEST_IP + 12,
+					    tuple->dest_ip_127_96);
+	hash ^= hal_flow_toeplitz_hash_word(fst, HAL_FST_HASH_POS_SRC_IP + 4,
+					    tuple->src_ip_63_32);
+	hash ^= hal_flow_toeplitz_hash_word(fst, HAL_FST_HASH_POS_SRC_IP + 8,
+					    tuple->src_ip_95_64);
+	hash ^= hal_flow_toeplitz_hash_word(fst, HAL_FST_HASH_POS_SRC_IP + 12,
+					    tuple->src_ip_127_96);
+
+	return hash;
+}
+
 uint32_t
 hal_flow_toeplitz_hash(void *hal_fst, struct hal_rx_flow *flow)
 {
-	int i, j;
-	uint32_t hash = 0;
 	struct hal_rx_fst *fst = (struct hal_rx_fst *)hal_fst;
-	uint32_t input[HAL_FST_HASH_KEY_SIZE_WORDS];
-	uint8_t *tuple;
-
-	qdf_mem_zero(input, HAL_FST_HASH_KEY_SIZE_BYTES);
-	*(uint32_t *)&input[0] = qdf_htonl(flow->tuple_info.src_ip_127_96);
-	*(uint32_t *)&input[1] = qdf_htonl(flow->tuple_info.src_ip_95_64);
-	*(uint32_t *)&input[2] = qdf_htonl(flow->tuple_info.src_ip_63_32);
-	*(uint32_t *)&input[3] = qdf_htonl(flow->tuple_info.src_ip_31_0);
-	*(uint32_t *)&input[4] = qdf_htonl(flow->tuple_info.dest_ip_127_96);
-	*(uint32_t *)&input[5] = qdf_htonl(flow->tuple_info.dest_ip_95_64);
-	*(uint32_t *)&input[6] = qdf_htonl(flow->tuple_info.dest_ip_63_32);
-	*(uint32_t *)&input[7] = qdf_htonl(flow->tuple_info.dest_ip_31_0);
-	*(uint32_t *)&input[8] = (flow->tuple_info.dest_port << 16) |
-				 (flow->tuple_info.src_port);
-	*(uint32_t *)&input[9] = flow->tuple_info.l4_protocol;
-
-	tuple = (uint8_t *)input;
-	QDF_TRACE_HEX_DUMP(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_DEBUG,
-			   tuple, sizeof(input));
-	for (i = 0, j = HAL_FST_HASH_DATA_SIZE - 1;
-	     i < HAL_FST_HASH_KEY_SIZE_BYTES && j >= 0; i++, j--) {
-		hash ^= fst->key_cache[i][tuple[j]];
-	}
+	uint32_t hash;
+
+	hash = hal_flow_toeplitz_hash_tuple(fst, &flow->tuple_info);
 
 	QDF_TRACE(QDF_MODULE_ID_DP, QDF_TRACE_LEVEL_INFO_LOW,
 		  "Hash value %u %u truncated hash %u\n", hash,
@@ -486,14 +546,22 @@ hal_flow_toeplitz_hash(void *hal_fst, struct hal_rx_flow *flow)
 
 	return hash;
 }
-#else
-uint32_t
-hal_flow_toeplitz_hash(void *hal_fst, struct hal_rx_flow *flow)
+
+void
+hal_flow_toeplitz_hash_batch(void *hal_fst,
+			     struct hal_flow_tuple_info *tuples,
+			     uint32_t num, uint32_t *hashes)
 {
-	return 0;
+	struct hal_rx_fst *fst = (struct hal_rx_fst *)hal_fst;
+	uint32_t mask = fst->max_entries - 1;
+	uint32_t i;
+
+	for (i = 0; i < num; i++)
+		hashes[i] = (hal_flow_toeplitz_hash_tuple(fst, &tuples[i]) >>
+			     12) & mask;
 }
-#endif
 qdf_export_symbol(hal_flow_toeplitz_hash);
+qdf_export_symbol(hal_flow_toeplitz_hash_batch);
 
 uint32_t hal_rx_get_hal_hash(struct hal_rx_fst *hal_fst, uint32_t flow_hash)
 {
@@ -583,3 +651,76 @@ hal_rx_find_flow_from_tuple(hal_soc_handle_t hal_soc_hdl,
 	return QDF_STATUS_SUCCESS;
 }
 qdf_export_symbol(hal_rx_find_flow_from_tuple);
+
+/**
+ * hal_rx_flow_tuple_match() - Compare two 5-tuples field by field
+ * @a: first 5-tuple
+ * @b: second 5-tuple
+ *
+ * Return: true if both describe the same flow
+ */
+static inline bool
+hal_rx_flow_tuple_match(struct hal_flow_tuple_info *a,
+			struct hal_flow_tuple_info *b)
+{
+	return !((a->dest_ip_31_0 ^ b->dest_ip_31_0) |
+		 (a->src_ip_31_0 ^ b->src_ip_31_0) |
+		 (a->dest_port ^ b->dest_port) |
+		 (a->src_port ^ b->src_port) |
+		 (a->l4_protocol ^ b->l4_protocol) |
+		 (a->dest_ip_63_32 ^ b->dest_ip_63_32) |
+		 (a->dest_ip_95_64 ^ b->dest_ip_95_64) |
+		 (a->dest_ip_127_96 ^ b->dest_ip_127_96) |
+		 (a->src_ip_63_32 ^ b->src_ip_63_32) |
+		 (a->src_ip_95_64 ^ b->src_ip_95_64) |
+		 (a->src_ip_127_96 ^ b->src_ip_127_96));
+}
+
+uint32_t
+hal_rx_find_flows_from_tuples(hal_soc_handle_t hal_soc_hdl,
+			      struct hal_rx_fst *fst,
+			      struct hal_flow_tuple_info *tuples,
+			      uint32_t num, uint32_t *flow_hashes,
+			      uint32_t *flow_idx, QDF_STATUS *status)
+{
+	struct hal_flow_tuple_info hal_tuple_info = { 0 };
+	uint32_t hal_hash;
+	uint32_t found = 0;
+	uint32_t i;
+	int j;
+
+	hal_flow_toeplitz_hash_batch(fst, tuples, num, flow_hashes);
+
+	/* Get the first entry of every flow on its way in before probing */
+	if (fst->base_vaddr) {
+		for (i = 0; i < num; i++) {
+			hal_hash = hal_rx_get_hal_hash(fst, flow_hashes[i]);
+			qdf_prefetch(fst->base_vaddr +
+				     hal_hash * fst->fst_entry_size);
+		}
+	}
+
+	for (i = 0; i < num; i++) {
+		status[i] = QDF_STATUS_E_RANGE;
+
+		for (j = 0; j < fst->max_skid_length; j++) {
+			hal_hash = hal_rx_get_hal_hash(fst,
+						       flow_hashes[i] + j);
+			if (!hal_rx_flow_get_tuple_info(hal_soc_hdl, fst,
+							hal_hash,
+							&hal_tuple_info))
+				continue;
+
+			if (hal_rx_flow_tuple_match(&hal_tuple_info,
+						    &tuples[i])) {
+				flow_idx[i] = hal_hash;
+				status[i] = QDF_STATUS_SUCCESS;
+				found++;
+				break;
+			}
+		}
+	}
+
+	return found;
+}
+qdf_export_symbol(hal_rx_find_flows_from_tuples);
@@ -130,6 +130,16 @@ hal_rx_flow_get_tuple_info(hal_soc_handle_t hal_soc_hdl,
 			   uint32_t hal_hash,
 			   struct hal_flow_tuple_info *tuple_info);
 
+/**
+ * hal_rx_fst_key_init() - Set the Toeplitz key of an FST and build the
+ *			   per byte hash cache of it
+ * @fst: Pointer to the Rx Flow Search Table
+ * @hash_key: Toeplitz key used for the hash FST
+ *
+ * Return: None
+ */
+void hal_rx_fst_key_init(struct hal_rx_fst *fst, uint8_t *hash_key);
+
 /**
  * hal_rx_fst_attach() - Initialize Rx flow search table in HW FST
  * @hal_soc_hdl: HAL SOC handle
@@ -210,6 +220,42 @@ uint32_t hal_rx_get_hal_hash(struct hal_rx_fst *hal_fst, uint32_t flow_hash);
 uint32_t
 hal_flow_toeplitz_hash(void *hal_fst, struct hal_rx_flow *flow);
 
+/**
+ * hal_flow_toeplitz_hash_batch() - Calculate Toeplitz hashes of many flows
+ * @hal_fst: FST Handle
+ * @tuples: 5-tuples of the flows
+ * @num: number of flows
+ * @hashes: hash of each flow, as hal_flow_toeplitz_hash() returns it
+ *
+ * Return: None
+ */
+void
+hal_flow_toeplitz_hash_batch(void *hal_fst,
+			     struct hal_flow_tuple_info *tuples,
+			     uint32_t num, uint32_t *hashes);
+
+/**
+ * hal_rx_find_flows_from_tuples() - Hash and find many flows in the FST
+ * @hal_soc_hdl: HAL SOC handle
+ * @fst: HAL Rx FST Handle
+ * @tuples: 5-tuples of the flows
+ * @num: number of flows
+ * @flow_hashes: filled with the hash of each flow
+ * @flow_idx: filled with the index of each flow found in the table
+ * @status: filled with the result of the lookup of each flow, as
+ *	    hal_rx_find_flow_from_tuple() would return it
+ *
+ * The first entry of every flow is prefetched before any is probed.
+ *
+ * Return: number of flows found
+ */
+uint32_t
+hal_rx_find_flows_from_tuples(hal_soc_handle_t hal_soc_hdl,
+			      struct hal_rx_fst *fst,
+			      struct hal_flow_tuple_info *tuples,
+			      uint32_t num, uint32_t *flow_hashes,
+			      uint32_t *flow_idx, QDF_STATUS *status);
+
 /**
  * hal_rx_dump_fse_table() - Dump the RX FSE table
  * @fst: HAL RX FST table to dump
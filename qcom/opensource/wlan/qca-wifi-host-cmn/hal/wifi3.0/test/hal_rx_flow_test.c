@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2023 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_time.h"
+#include "qdf_trace.h"
+#include "qdf_util.h"
+#include "hal_rx_flow.h"
+#include "hal_rx_flow_test.h"
+
+#define hal_rx_flow_test_flows 1024
+#define hal_rx_flow_test_entries 2048
+#define hal_rx_flow_test_skid 16
+#define hal_rx_flow_test_rounds 64
+
+/* The default RSS key of the Microsoft spec */
+static uint8_t hal_rx_flow_test_key[HAL_FST_HASH_KEY_SIZE_BYTES] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+struct hal_rx_flow_test_entry {
+	bool valid;
+	struct hal_flow_tuple_info tuple;
+};
+
+/* Stands in for the HW FST behind the fake hal_rx_flow_get_tuple_info op */
+static struct hal_rx_flow_test_entry *hal_rx_flow_test_table;
+
+static void *
+hal_rx_flow_test_get_tuple_info(uint8_t *rx_fst, uint32_t hal_hash,
+				uint8_t *tuple_info)
+{
+	struct hal_rx_flow_test_entry *entry =
+					&hal_rx_flow_test_table[hal_hash];
+
+	if (!entry->valid)
+		return NULL;
+
+	qdf_mem_copy(tuple_info, &entry->tuple, sizeof(entry->tuple));
+
+	return entry;
+}
+
+static uint32_t hal_rx_flow_test_get_fse_size(void)
+{
+	return sizeof(struct hal_rx_flow_test_entry);
+}
+
+static struct hal_hw_txrx_ops hal_rx_flow_test_ops = {
+	.hal_rx_flow_get_tuple_info = hal_rx_flow_test_get_tuple_info,
+	.hal_rx_fst_get_fse_size = hal_rx_flow_test_get_fse_size,
+};
+
+static uint32_t hal_rx_flow_test_rand(uint32_t *seed)
+{
+	/* xorshift32 */
+	*seed ^= *seed << 13;
+	*seed ^= *seed >> 17;
+	*seed ^= *seed << 5;
+
+	return *seed;
+}
+
+static void
+hal_rx_flow_test_fill_tuples(struct hal_flow_tuple_info *tuples, int num)
+{
+	uint32_t seed = 0x1f2e3d4c;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		struct hal_flow_tuple_info *tuple = &tuples[i];
+
+		tuple->src_ip_31_0 = hal_rx_flow_test_rand(&seed);
+		tuple->dest_ip_31_0 = hal_rx_flow_test_rand(&seed);
+		tuple->src_port = hal_rx_flow_test_rand(&seed);
+		tuple->dest_port = hal_rx_flow_test_rand(&seed);
+		/* TCP or UDP */
+		tuple->l4_protocol = (i & 1) ? 6 : 17;
+
+		/* Every fourth flow is IPv6 */
+		if (i % 4)
+			continue;
+
+		tuple->src_ip_127_96 = hal_rx_flow_test_rand(&seed);
+		tuple->src_ip_95_64 = hal_rx_flow_test_rand(&seed);
+		tuple->src_ip_63_32 = hal_rx_flow_test_rand(&seed);
+		tuple->dest_ip_127_96 = hal_rx_flow_test_rand(&seed);
+		tuple->dest_ip_95_64 = 0;
+		tuple->dest_ip_63_32 = hal_rx_flow_test_rand(&seed);
+	}
+}
+
+/**
+ * hal_rx_flow_test_input() - Build the Toeplitz input buffer of a tuple
+ * @tuple: 5-tuple of the flow
+ * @input: input buffer, hashed from its last byte to its first
+ *
+ * Return: None
+ */
+static void
+hal_rx_flow_test_input(struct hal_flow_tuple_info *tuple,
+		       uint32_t input[HAL_FST_HASH_KEY_SIZE_WORDS])
+{
+	qdf_mem_zero(input, HAL_FST_HASH_KEY_SIZE_WORDS * sizeof(*input));
+	input[0] = qdf_htonl(tuple->src_ip_127_96);
+	input[1] = qdf_htonl(tuple->src_ip_95_64);
+	input[2] = qdf_htonl(tuple->src_ip_63_32);
+	input[3] = qdf_htonl(tuple->src_ip_31_0);
+	input[4] = qdf_htonl(tuple->dest_ip_127_96);
+	input[5] = qdf_htonl(tuple->dest_ip_95_64);
+	input[6] = qdf_htonl(tuple->dest_ip_63_32);
+	input[7] = qdf_htonl(tuple->dest_ip_31_0);
+	input[8] = (tuple->dest_port << 16) | tuple->src_port;
+	input[9] = tuple->l4_protocol;
+}
+
+/**
+ * hal_rx_flow_test_ref_hash() - Toeplitz hash the way it was first done
+ * @fst: FST Handle
+ * @tuple: 5-tuple of the flow
+ *
+ * Builds the 40 byte input buffer and looks up each of its bytes in the
+ * key cache. This is what the fast path has to agree with, bit for bit.
+ *
+ * Return: truncated hash
+ */
+static uint32_t
+hal_rx_flow_test_ref_hash(struct hal_rx_fst *fst,
+			  struct hal_flow_tuple_info *tuple)
+{
+	uint32_t input[HAL_FST_HASH_KEY_SIZE_WORDS];
+	uint8_t *data = (uint8_t *)input;
+	uint32_t hash = 0;
+	int i, j;
+
+	hal_rx_flow_test_input(tuple, input);
+	for (i = 0, j = HAL_FST_HASH_DATA_SIZE - 1;
+	     i < HAL_FST_HASH_KEY_SIZE_BYTES && j >= 0; i++, j--)
+		hash ^= fst->key_cache[i][data[j]];
+
+	return (hash >> 12) & (fst->max_entries - 1);
+}
+
+/**
+ * hal_rx_flow_test_bit_hash() - Toeplitz hash one input bit at a time
+ * @fst: FST Handle
+ * @tuple: 5-tuple of the flow
+ *
+ * Textbook Toeplitz over the shifted key, without the key cache: each set
+ * input bit XORs in the 32 key bits starting at its position.
+ *
+ * Return: truncated hash
+ */
+static uint32_t
+hal_rx_flow_test_bit_hash(struct hal_rx_fst *fst,
+			  struct hal_flow_tuple_info *tuple)
+{
+	uint32_t input[HAL_FST_HASH_KEY_SIZE_WORDS];
+	uint8_t *data = (uint8_t *)input;
+	uint32_t hash = 0;
+	uint32_t window;
+	int pos, bit, k;
+
+	hal_rx_flow_test_input(tuple, input);
+	for (pos = 0; pos < HAL_FST_HASH_DATA_SIZE * 8; pos++) {
+		if (!(data[HAL_FST_HASH_DATA_SIZE - 1 - pos / 8] &
+		      (0x80 >> (pos % 8))))
+			continue;
+
+		window = 0;
+		for (bit = 0; bit < 32; bit++) {
+			k = pos + bit;
+			window <<= 1;
+			if (k < HAL_FST_HASH_KEY_SIZE_BYTES * 8 &&
+			    (fst->shifted_key[k / 8] & (0x80 >> (k % 8))))
+				window |= 1;
+		}
+		hash ^= window;
+	}
+
+	return (hash >> 12) & (fst->max_entries - 1);
+}
+
+static uint64_t hal_rx_flow_test_rate(uint64_t hashes, uint64_t time_ns)
+{
+	uint64_t time_us = qdf_do_div(time_ns, 1000);
+
+	if (!time_us)
+		return 0;
+
+	return qdf_do_div(hashes * 1000000, time_us);
+}
+
+static uint32_t
+hal_rx_flow_test_hash(struct hal_rx_fst *fst,
+		      struct hal_flow_tuple_info *tuples, uint32_t *hashes)
+{
+	struct hal_rx_flow *flow;
+	uint64_t ref_ns, single_ns, batch_ns, start;
+	uint64_t num = hal_rx_flow_test_flows * hal_rx_flow_test_rounds;
+	uint32_t errors = 0;
+	uint32_t distinct = 0;
+	uint32_t sum = 0;
+	uint8_t *seen;
+	int round, i;
+
+	flow = qdf_mem_malloc(sizeof(*flow));
+	seen = qdf_mem_malloc(hal_rx_flow_test_entries);
+	if (!flow || !seen) {
+		errors++;
+		goto out;
+	}
+
+	/*
+	 * The batched hashes must match hal_flow_toeplitz_hash() of each
+	 * tuple, and both the cached and the bit serial reference ...
+	 */
+	hal_flow_toeplitz_hash_batch(fst, tuples, hal_rx_flow_test_flows,
+				     hashes);
+	for (i = 0; i < hal_rx_flow_test_flows; i++) {
+		uint32_t ref = hal_rx_flow_test_ref_hash(fst, &tuples[i]);
+		uint32_t bit = hal_rx_flow_test_bit_hash(fst, &tuples[i]);
+		uint32_t single;
+
+		qdf_mem_copy(&flow->tuple_info, &tuples[i],
+			     sizeof(flow->tuple_info));
+		single = hal_flow_toeplitz_hash(fst, flow);
+
+		if (hashes[i] != single || single != ref || ref != bit) {
+			qdf_nofl_alert("FAIL: flow %d batch %u single %u; expected %u/%u",
+				       i, hashes[i], single, ref, bit);
+			errors++;
+		}
+
+		if (!seen[hashes[i]]) {
+			seen[hashes[i]] = 1;
+			distinct++;
+		}
+	}
+
+	/*
+	 * ... which only means something if the hashes do spread: random
+	 * flows fill about 40% of the buckets, a missing key fills one.
+	 */
+	if (distinct < hal_rx_flow_test_flows / 2) {
+		qdf_nofl_alert("FAIL: %u flows hash to %u buckets only",
+			       hal_rx_flow_test_flows, distinct);
+		errors++;
+	}
+
+	/* ... and should be faster at it */
+	start = qdf_sched_clock();
+	for (round = 0; round < hal_rx_flow_test_rounds; round++)
+		for (i = 0; i < hal_rx_flow_test_flows; i++)
+			sum += hal_rx_flow_test_ref_hash(fst, &tuples[i]);
+	ref_ns = qdf_sched_clock() - start;
+
+	start = qdf_sched_clock();
+	for (round = 0; round < hal_rx_flow_test_rounds; round++) {
+		for (i = 0; i < hal_rx_flow_test_flows; i++) {
+			qdf_mem_copy(&flow->tuple_info, &tuples[i],
+				     sizeof(flow->tuple_info));
+			sum += hal_flow_toeplitz_hash(fst, flow);
+		}
+	}
+	single_ns = qdf_sched_clock() - start;
+
+	start = qdf_sched_clock();
+	for (round = 0; round < hal_rx_flow_test_rounds; round++)
+		hal_flow_toeplitz_hash_batch(fst, tuples,
+					     hal_rx_flow_test_flows, hashes);
+	batch_ns = qdf_sched_clock() - start;
+
+	qdf_nofl_info("hashes/sec: reference %llu single %llu batch %llu (%u)",
+		      hal_rx_flow_test_rate(num, ref_ns),
+		      hal_rx_flow_test_rate(num, single_ns),
+		      hal_rx_flow_test_rate(num, batch_ns), sum);
+
+out:
+	qdf_mem_free(seen);
+	qdf_mem_free(flow);
+
+	return errors;
+}
+
+static uint32_t
+hal_rx_flow_test_lookup(hal_soc_handle_t hal_soc_hdl, struct hal_rx_fst *fst,
+			struct hal_flow_tuple_info *tuples, uint32_t *hashes)
+{
+	struct hal_rx_flow *flow;
+	uint32_t *flow_idx;
+	QDF_STATUS *status;
+	uint32_t inserted = 0;
+	uint32_t errors = 0;
+	uint32_t found;
+	int i;
+
+	flow = qdf_mem_malloc(sizeof(*flow));
+	flow_idx = qdf_mem_malloc(hal_rx_flow_test_flows * sizeof(*flow_idx));
+	status = qdf_mem_malloc(hal_rx_flow_test_flows * sizeof(*status));
+	if (!flow || !flow_idx || !status) {
+		errors++;
+		goto out;
+	}
+
+	/* Insert every other flow, the rest must not be found */
+	for (i = 0; i < hal_rx_flow_test_flows; i += 2) {
+		uint32_t hash, idx;
+
+		qdf_mem_copy(&flow->tuple_info, &tuples[i],
+			     sizeof(flow->tuple_info));
+		hash = hal_flow_toeplitz_hash(fst, flow);
+		if (hal_rx_insert_flow_entry(hal_soc_hdl, fst, hash,
+					     &tuples[i], &idx) !=
+		    QDF_STATUS_SUCCESS)
+			continue;
+
+		hal_rx_flow_test_table[idx].valid = true;
+		qdf_mem_copy(&hal_rx_flow_test_table[idx].tuple, &tuples[i],
+			     sizeof(tuples[i]));
+		inserted++;
+	}
+
+	found = hal_rx_find_flows_from_tuples(hal_soc_hdl, fst, tuples,
+					      hal_rx_flow_test_flows, hashes,
+					      flow_idx, status);
+	if (found != inserted) {
+		qdf_nofl_alert("FAIL: found %u flows; expected %u",
+			       found, inserted);
+		errors++;
+	}
+
+	/* The batched lookup must agree with the single one, flow by flow */
+	for (i = 0; i < hal_rx_flow_test_flows; i++) {
+		QDF_STATUS exp_status;
+		uint32_t exp_idx = 0;
+
+		exp_status = hal_rx_find_flow_from_tuple(hal_soc_hdl, fst,
+							 hashes[i], &tuples[i],
+							 &exp_idx);
+		if (status[i] != exp_status ||
+		    (exp_status == QDF_STATUS_SUCCESS &&
+		     flow_idx[i] != exp_idx)) {
+			qdf_nofl_alert("FAIL: flow %d status %d idx %u; expected status %d idx %u",
+				       i, status[i], flow_idx[i], exp_status,
+				       exp_idx);
+			errors++;
+		}
+	}
+
+out:
+	qdf_mem_free(status);
+	qdf_mem_free(flow_idx);
+	qdf_mem_free(flow);
+
+	return errors;
+}
+
+uint32_t hal_rx_flow_unit_test(void)
+{
+	struct hal_flow_tuple_info *tuples;
+	struct hal_soc *hal_soc;
+	struct hal_rx_fst *fst;
+	uint32_t *hashes;
+	uint32_t errors = 0;
+
+	hal_soc = qdf_mem_malloc(sizeof(*hal_soc));
+	fst = qdf_mem_malloc(sizeof(*fst));
+	tuples = qdf_mem_malloc(hal_rx_flow_test_flows * sizeof(*tuples));
+	hashes = qdf_mem_malloc(hal_rx_flow_test_flows * sizeof(*hashes));
+	hal_rx_flow_test_table =
+		qdf_mem_malloc(hal_rx_flow_test_entries *
+			       sizeof(*hal_rx_flow_test_table));
+	if (!hal_soc || !fst || !tuples || !hashes ||
+	    !hal_rx_flow_test_table) {
+		errors++;
+		goto out;
+	}
+
+	/* An FST without any HW table behind it */
+	hal_soc->ops = &hal_rx_flow_test_ops;
+	fst->max_entries = hal_rx_flow_test_entries;
+	fst->hash_mask = hal_rx_flow_test_entries - 1;
+	fst->max_skid_length = hal_rx_flow_test_skid;
+	fst->fst_entry_size = hal_rx_flow_test_get_fse_size();
+	hal_rx_fst_key_init(fst, hal_rx_flow_test_key);
+
+	hal_rx_flow_test_fill_tuples(tuples, hal_rx_flow_test_flows);
+
+	errors += hal_rx_flow_test_hash(fst, tuples, hashes);
+	errors += hal_rx_flow_test_lookup((hal_soc_handle_t)hal_soc, fst,
+					  tuples, hashes);
+
+out:
+	qdf_mem_free(hal_rx_flow_test_table);
+	hal_rx_flow_test_table = NULL;
+	qdf_mem_free(hashes);
+	qdf_mem_free(tuples);
+	qdf_mem_free(fst);
+	qdf_mem_free(hal_soc);
+
+	return errors;
+}
@@ -177,6 +177,20 @@ static inline int32_t qdf_atomic_inc_not_zero(qdf_atomic_t *v)
 	return __qdf_atomic_inc_not_zero(v);
 }
 
+/**
+ * qdf_atomic_add_unless() - add to an atomic variable unless it has a
+ * given value
+ * @v: A pointer to an opaque atomic variable
+ * @a: The amount to add to v
+ * @u: The value v must not have for a to be added
+ *
+ * Return: Returns non-zero if a was added and zero otherwise
+ */
+static inline int32_t qdf_atomic_add_unless(qdf_atomic_t *v, int a, int u)
+{
+	return __qdf_atomic_add_unless(v, a, u);
+}
+
 /**
  * qdf_atomic_set_bit - Atomically set a bit in memory
  * @nr: bit to set
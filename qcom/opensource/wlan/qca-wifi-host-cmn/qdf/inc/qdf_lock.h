@@ -265,6 +265,14 @@ typedef __qdf_semaphore_t qdf_semaphore_t;
  */
 typedef __qdf_mutex_t qdf_mutex_t;
 
+/**
+ * typedef qdf_rcu_head_t - Abstracted RCU callback head
+ *
+ * Abstracted object. Clients must not make any assumptions about the
+ * composition of this object
+ */
+typedef __qdf_rcu_head_t qdf_rcu_head_t;
+
 QDF_STATUS qdf_mutex_create(qdf_mutex_t *lock, const char *func, int line);
 
 /**
@@ -936,4 +944,64 @@ QDF_STATUS qdf_rtpm_sync_resume(void)
 
 #endif /* FEATURE_RUNTIME_PM */
 
+/**
+ * qdf_rcu_read_lock() - enter an RCU read side critical section
+ *
+ * Return: none
+ */
+#define qdf_rcu_read_lock() __qdf_rcu_read_lock()
+
+/**
+ * qdf_rcu_read_unlock() - leave an RCU read side critical section
+ *
+ * Return: none
+ */
+#define qdf_rcu_read_unlock() __qdf_rcu_read_unlock()
+
+/**
+ * qdf_rcu_dereference() - read a pointer published with
+ * qdf_rcu_assign_pointer()
+ * @ptr: pointer to read, from within an RCU read side critical section
+ *
+ * Return: value of @ptr
+ */
+#define qdf_rcu_dereference(ptr) __qdf_rcu_dereference(ptr)
+
+/**
+ * qdf_rcu_assign_pointer() - publish a pointer to RCU readers
+ * @ptr: pointer to update
+ * @val: new value, the object it points to is initialized before @ptr is
+ *       updated
+ *
+ * Return: none
+ */
+#define qdf_rcu_assign_pointer(ptr, val) __qdf_rcu_assign_pointer(ptr, val)
+
+/**
+ * qdf_call_rcu() - call a function once all the current RCU read side
+ * critical sections are done
+ * @head: RCU callback head, embedded in the object to release
+ * @func: function to call, in softirq context
+ *
+ * Return: none
+ */
+#define qdf_call_rcu(head, func) __qdf_call_rcu(head, func)
+
+/**
+ * qdf_rcu_barrier() - wait for all the pending qdf_call_rcu() callbacks
+ *
+ * Return: none
+ */
+#define qdf_rcu_barrier() __qdf_rcu_barrier()
+
+/**
+ * qdf_synchronize_rcu() - wait until all the current RCU read side
+ * critical sections are done
+ *
+ * May sleep, must not be called in atomic context.
+ *
+ * Return: none
+ */
+#define qdf_synchronize_rcu() __qdf_synchronize_rcu()
+
 #endif /* _QDF_LOCK_H */
@@ -32,6 +32,8 @@
 #include <qdf_atomic.h>
 
 #define QDF_CACHE_LINE_SZ __qdf_cache_line_sz
+/* align a structure on a cache line, e.g. per-CPU counters */
+#define qdf_cacheline_aligned __qdf_cacheline_aligned
 
 /**
  * qdf_align() - align to the given size.
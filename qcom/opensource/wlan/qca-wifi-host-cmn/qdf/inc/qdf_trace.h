@@ -125,11 +125,17 @@ typedef int (qdf_abstract_print)(void *priv, const char *fmt, ...);
  * iwpriv wlan0 dump_dp_trace 1 0 -> enable live view mode
  * iwpriv wlan0 dump_dp_trace 2 0 -> clear dp trace buffer
  * iwpriv wlan0 dump_dp_trace 3 0 -> disable live view mode
+ * iwpriv wlan0 dump_dp_trace 4 0 -> enable per-CPU recording mode
+ * iwpriv wlan0 dump_dp_trace 5 0 -> disable per-CPU recording mode
+ * iwpriv wlan0 dump_dp_trace 6 n -> benchmark with n thousand records per CPU
  */
 #define DUMP_DP_TRACE			0
 #define ENABLE_DP_TRACE_LIVE_MODE	1
 #define CLEAR_DP_TRACE_BUFFER		2
 #define DISABLE_DP_TRACE_LIVE_MODE	3
+#define ENABLE_DP_TRACE_PERCPU_MODE	4
+#define DISABLE_DP_TRACE_PERCPU_MODE	5
+#define BENCHMARK_DP_TRACE		6
 
 
 #ifdef TRACE_RECORD
@@ -232,6 +238,11 @@ enum diag_tx_status wlan_get_diag_tx_status(enum qdf_dp_tx_rx_status tx_status);
 #define MAX_QDF_DP_TRACE_RECORDS       2000
 #endif
 
+/* records per CPU in per-CPU mode, must be a power of 2 */
+#ifndef QDF_DP_TRACE_PERCPU_RECORDS
+#define QDF_DP_TRACE_PERCPU_RECORDS    1024
+#endif
+
 #define QDF_DP_TRACE_RECORD_SIZE       66 /* bytes */
 #define INVALID_QDF_DP_TRACE_ADDR      0xffffffff
 #define QDF_DP_TRACE_VERBOSITY_HIGH		4
@@ -513,6 +524,8 @@ struct qdf_dp_trace_record_s {
  * @force_live_mode: flag to enable live mode all the time for all packets.
  *                  This can be set/unset from userspace and overrides other
  *                  live mode flags.
+ * @percpu_mode: records are stored in per-CPU rings without taking the DP
+ *               trace lock, and merged by timestamp when dumped
  * @dynamic_verbosity_modify: Dynamic user configured verbosity overrides all
  * @print_pkt_cnt: count of number of packets printed in live mode
  * @high_tput_thresh: thresh beyond which live mode is turned off
@@ -561,6 +574,7 @@ struct s_qdf_dp_trace_data {
 	uint32_t curr_pos;
 	uint32_t saved_tail;
 	bool force_live_mode;
+	bool percpu_mode;
 	bool dynamic_verbosity_modify;
 	uint8_t print_pkt_cnt;
 	uint8_t high_tput_thresh;
@@ -1248,6 +1262,33 @@ void qdf_dp_trace_enable_live_mode(void);
  */
 void qdf_dp_trace_clear_buffer(void);
 
+/**
+ * qdf_dp_trace_set_percpu_mode() - switch dptrace recording mode
+ * @enable: true to record in per-CPU rings, false to record in the
+ *          global ring under the DP trace lock
+ *
+ * Per-CPU rings are allocated on first use. The buffer is cleared when the
+ * mode changes.
+ *
+ * Return: QDF_STATUS_SUCCESS on success, error code if the per-CPU rings
+ *         could not be allocated
+ */
+QDF_STATUS qdf_dp_trace_set_percpu_mode(bool enable);
+
+/**
+ * qdf_dp_trace_benchmark() - measure the dptrace recording rate
+ * @num_records: number of records to add from each online CPU
+ *
+ * Adds @num_records records from a work item on each online CPU, once in
+ * the global ring mode and once in the per-CPU mode, and logs the records
+ * per second reached in each mode. The live records are set aside for the
+ * run and put back with the recording mode afterwards, records the traffic
+ * adds meanwhile are dropped.
+ *
+ * Return: none
+ */
+void qdf_dp_trace_benchmark(uint32_t num_records);
+
 /**
  * qdf_dp_trace_mgmt_pkt() - record mgmt packet
  * @code: dptrace code
@@ -1442,6 +1483,17 @@ void qdf_dp_trace_clear_buffer(void)
 {
 }
 
+static inline
+QDF_STATUS qdf_dp_trace_set_percpu_mode(bool enable)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline
+void qdf_dp_trace_benchmark(uint32_t num_records)
+{
+}
+
 static inline
 void qdf_dp_trace_apply_tput_policy(bool is_data_traffic)
 {
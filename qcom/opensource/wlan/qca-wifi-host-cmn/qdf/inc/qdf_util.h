@@ -706,6 +706,31 @@ int qdf_get_cpu(void)
 	return __qdf_get_cpu();
 }
 
+/**
+ * qdf_get_cpu_hold() - get cpu_index and stay on that CPU
+ *
+ * Preemption is disabled until qdf_put_cpu(), so data indexed by the
+ * returned cpu_index is not updated from another CPU meanwhile.
+ *
+ * Return: cpu_index
+ */
+static inline
+int qdf_get_cpu_hold(void)
+{
+	return __qdf_get_cpu_hold();
+}
+
+/**
+ * qdf_put_cpu() - release the CPU taken by qdf_get_cpu_hold()
+ *
+ * Return: none
+ */
+static inline
+void qdf_put_cpu(void)
+{
+	__qdf_put_cpu();
+}
+
 /**
  * qdf_get_hweight8() - count num of 1's in 8-bit bitmap
  * @w: input bitmap
@@ -39,6 +39,7 @@
 #endif
 #include <linux/interrupt.h>
 #include <linux/pm_wakeup.h>
+#include <linux/rcupdate.h>
 
 /* define for flag */
 #define QDF_LINUX_UNLOCK_BH  1
@@ -91,6 +92,11 @@ typedef struct __qdf_spinlock {
  */
 typedef struct semaphore __qdf_semaphore_t;
 
+/**
+ * typedef __qdf_rcu_head_t - RCU callback head abstraction
+ */
+typedef struct rcu_head __qdf_rcu_head_t;
+
 /**
  * typedef qdf_wake_lock_t - wakelock abstraction
  * @lock: this lock needs to be used in kernel version < 5.4
@@ -360,6 +366,14 @@ static inline bool __qdf_in_softirq(void)
 	return in_softirq();
 }
 
+#define __qdf_rcu_read_lock() rcu_read_lock()
+#define __qdf_rcu_read_unlock() rcu_read_unlock()
+#define __qdf_rcu_dereference(ptr) rcu_dereference(ptr)
+#define __qdf_rcu_assign_pointer(ptr, val) rcu_assign_pointer(ptr, val)
+#define __qdf_call_rcu(head, func) call_rcu(head, func)
+#define __qdf_rcu_barrier() rcu_barrier()
+#define __qdf_synchronize_rcu() synchronize_rcu()
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -40,6 +40,7 @@
 #include <linux/cache.h> /* L1_CACHE_BYTES */
 
 #define __qdf_cache_line_sz L1_CACHE_BYTES
+#define __qdf_cacheline_aligned ____cacheline_aligned
 #include "queue.h"
 
 #else
@@ -314,12 +314,35 @@ int __qdf_get_cpu(void)
 	put_cpu();
 	return cpu_index;
 }
+
+static inline
+int __qdf_get_cpu_hold(void)
+{
+	return get_cpu();
+}
+
+static inline
+void __qdf_put_cpu(void)
+{
+	put_cpu();
+}
 #else
 static inline
 int __qdf_get_cpu(void)
 {
 	return 0;
 }
+
+static inline
+int __qdf_get_cpu_hold(void)
+{
+	return 0;
+}
+
+static inline
+void __qdf_put_cpu(void)
+{
+}
 #endif
 
 static inline int __qdf_device_init_wakeup(__qdf_device_t qdf_dev, bool enable)
@@ -819,6 +819,8 @@ struct qdf_nbuf_event {
 static qdf_atomic_t qdf_nbuf_history_index;
 static struct qdf_nbuf_event qdf_nbuf_history[QDF_NBUF_HISTORY_SIZE];
 
+static bool qdf_net_buf_debug_sampled(qdf_nbuf_t net_buf);
+
 void qdf_nbuf_ssr_register_region(void)
 {
 	qdf_ssr_driver_dump_register_region("qdf_nbuf_history",
@@ -849,9 +851,15 @@ void
 qdf_nbuf_history_add(qdf_nbuf_t nbuf, const char *func, uint32_t line,
 		     enum qdf_nbuf_event_type type)
 {
-	int32_t idx = qdf_nbuf_circular_index_next(&qdf_nbuf_history_index,
-						   QDF_NBUF_HISTORY_SIZE);
-	struct qdf_nbuf_event *event = &qdf_nbuf_history[idx];
+	int32_t idx;
+	struct qdf_nbuf_event *event;
+
+	if (nbuf && !qdf_net_buf_debug_sampled(nbuf))
+		return;
+
+	idx = qdf_nbuf_circular_index_next(&qdf_nbuf_history_index,
+					   QDF_NBUF_HISTORY_SIZE);
+	event = &qdf_nbuf_history[idx];
 
 	if (qdf_atomic_read(&smmu_crashed)) {
 		g_histroy_add_drop++;
@@ -897,7 +905,7 @@ static void qdf_nbuf_smmu_map_tracking_deinit(void)
 static QDF_STATUS
 qdf_nbuf_track_smmu_map(qdf_nbuf_t nbuf, const char *func, uint32_t line)
 {
-	if (is_initial_mem_debug_disabled)
+	if (is_initial_mem_debug_disabled || !qdf_net_buf_debug_sampled(nbuf))
 		return QDF_STATUS_SUCCESS;
 
 	return qdf_tracker_track(&qdf_nbuf_smmu_map_tracker, nbuf, func, line);
@@ -906,7 +914,7 @@ qdf_nbuf_track_smmu_map(qdf_nbuf_t nbuf, const char *func, uint32_t line)
 static void
 qdf_nbuf_untrack_smmu_map(qdf_nbuf_t nbuf, const char *func, uint32_t line)
 {
-	if (is_initial_mem_debug_disabled)
+	if (is_initial_mem_debug_disabled || !qdf_net_buf_debug_sampled(nbuf))
 		return;
 
 	qdf_nbuf_history_add(nbuf, func, line, QDF_NBUF_SMMU_UNMAP);
@@ -1060,7 +1068,7 @@ static void qdf_nbuf_map_tracking_deinit(void)
 static QDF_STATUS
 qdf_nbuf_track_map(qdf_nbuf_t nbuf, const char *func, uint32_t line)
 {
-	if (is_initial_mem_debug_disabled)
+	if (is_initial_mem_debug_disabled || !qdf_net_buf_debug_sampled(nbuf))
 		return QDF_STATUS_SUCCESS;
 
 	return qdf_tracker_track(&qdf_nbuf_map_tracker, nbuf, func, line);
@@ -1069,7 +1077,7 @@ qdf_nbuf_track_map(qdf_nbuf_t nbuf, const char *func, uint32_t line)
 static void
 qdf_nbuf_untrack_map(qdf_nbuf_t nbuf, const char *func, uint32_t line)
 {
-	if (is_initial_mem_debug_disabled)
+	if (is_initial_mem_debug_disabled || !qdf_net_buf_debug_sampled(nbuf))
 		return;
 
 	qdf_nbuf_history_add(nbuf, func, line, QDF_NBUF_UNMAP);
@@ -2852,22 +2860,79 @@ static uint32_t qdf_net_buf_track_max_free;
 static uint32_t qdf_net_buf_track_max_allocated;
 static uint32_t qdf_net_buf_track_fail_count;
 
+/* track 1 in nbuf_track_sample_rate nbufs, 0 or 1 to track all of them */
+static uint32_t nbuf_track_sample_rate;
+qdf_declare_param(nbuf_track_sample_rate, uint);
+
+/* nbuf_track_sample_rate as latched by qdf_net_buf_debug_init() */
+static uint32_t qdf_net_buf_track_sample_rate;
+
+/* cookies moved at once between a CPU cache and the global freelist */
+#define QDF_NBUF_TRACK_CPU_BATCH 32
+/* cookies a CPU cache holds before it gives a batch back */
+#define QDF_NBUF_TRACK_CPU_MAX (2 * QDF_NBUF_TRACK_CPU_BATCH)
+
+/**
+ * struct qdf_nbuf_track_cpu_cache - nbuf tracking cookies cached by a CPU
+ * @free_list: free cookies
+ * @free_count: number of cookies in @free_list
+ * @used: cookies allocated minus cookies freed on this CPU, may be negative
+ *
+ * Only accessed by its CPU with interrupts disabled, the global freelist
+ * lock is only taken to move a batch of cookies in or out of the cache.
+ */
+struct qdf_nbuf_track_cpu_cache {
+	QDF_NBUF_TRACK *free_list;
+	uint32_t free_count;
+	int used;
+};
+
+static DEFINE_PER_CPU(struct qdf_nbuf_track_cpu_cache,
+		      qdf_nbuf_track_cpu_cache);
+
+/**
+ * qdf_nbuf_track_cpu_sum() - sum up the per-CPU cookie caches
+ * @cached: filled with the number of free cookies in the CPU caches
+ *
+ * The result is a snapshot, other CPUs keep going meanwhile.
+ *
+ * Return: number of cookies in use
+ */
+static uint32_t qdf_nbuf_track_cpu_sum(uint32_t *cached)
+{
+	struct qdf_nbuf_track_cpu_cache *cache;
+	int used = 0;
+	int cpu;
+
+	*cached = 0;
+	for_each_possible_cpu(cpu) {
+		cache = per_cpu_ptr(&qdf_nbuf_track_cpu_cache, cpu);
+		used += READ_ONCE(cache->used);
+		*cached += READ_ONCE(cache->free_count);
+	}
+
+	return used > 0 ? used : 0;
+}
+
 /**
  * update_max_used() - update qdf_net_buf_track_max_used tracking variable
  *
  * tracks the max number of network buffers that the wlan driver was tracking
- * at any one time.
+ * at any one time. Called with the freelist lock held, each time a CPU moves
+ * a batch of cookies in or out of its cache.
  *
  * Return: none
  */
 static inline void update_max_used(void)
 {
+	uint32_t cached;
 	int sum;
 
+	qdf_net_buf_track_used_list_count = qdf_nbuf_track_cpu_sum(&cached);
 	if (qdf_net_buf_track_max_used <
 	    qdf_net_buf_track_used_list_count)
 		qdf_net_buf_track_max_used = qdf_net_buf_track_used_list_count;
-	sum = qdf_net_buf_track_free_list_count +
+	sum = qdf_net_buf_track_free_list_count + cached +
 		qdf_net_buf_track_used_list_count;
 	if (qdf_net_buf_track_max_allocated < sum)
 		qdf_net_buf_track_max_allocated = sum;
@@ -2887,12 +2952,84 @@ static inline void update_max_free(void)
 		qdf_net_buf_track_max_free = qdf_net_buf_track_free_list_count;
 }
 
+/**
+ * qdf_nbuf_track_cpu_refill() - refill a CPU cache from the global freelist
+ * @cache: cache of the current CPU
+ *
+ * Called with interrupts disabled.
+ *
+ * Return: none
+ */
+static void qdf_nbuf_track_cpu_refill(struct qdf_nbuf_track_cpu_cache *cache)
+{
+	QDF_NBUF_TRACK *node;
+
+	spin_lock(&qdf_net_buf_track_free_list_lock);
+	while (qdf_net_buf_track_free_list &&
+	       cache->free_count < QDF_NBUF_TRACK_CPU_BATCH) {
+		node = qdf_net_buf_track_free_list;
+		qdf_net_buf_track_free_list = node->p_next;
+		qdf_net_buf_track_free_list_count--;
+		node->p_next = cache->free_list;
+		cache->free_list = node;
+		cache->free_count++;
+	}
+	update_max_used();
+	spin_unlock(&qdf_net_buf_track_free_list_lock);
+}
+
+/* FREEQ_POOLSIZE initial and minimum desired freelist poolsize */
+#define FREEQ_POOLSIZE 2048
+
+/**
+ * qdf_nbuf_track_cpu_flush() - give cookies of a CPU cache back
+ * @cache: cache of the current CPU, or of any CPU once tracking is over
+ * @count: number of cookies to give back
+ *
+ * Called with interrupts disabled.
+ *
+ * Return: none
+ */
+static void qdf_nbuf_track_cpu_flush(struct qdf_nbuf_track_cpu_cache *cache,
+				     uint32_t count)
+{
+	QDF_NBUF_TRACK *node;
+
+	spin_lock(&qdf_net_buf_track_free_list_lock);
+	update_max_used();
+	while (cache->free_list && count--) {
+		node = cache->free_list;
+		cache->free_list = node->p_next;
+		cache->free_count--;
+
+		/* Try to shrink the freelist if free_list_count > than
+		 * FREEQ_POOLSIZE only shrink the freelist if it is bigger than
+		 * twice the number of nbufs in use. If the driver is stalling
+		 * in a consistent bursty fashion, this will keep 3/4 of thee
+		 * allocations from the free list while also allowing the
+		 * system to recover memory as less frantic traffic occurs.
+		 */
+		if (qdf_net_buf_track_free_list_count > FREEQ_POOLSIZE &&
+		    (qdf_net_buf_track_free_list_count >
+		     qdf_net_buf_track_used_list_count << 1)) {
+			kmem_cache_free(nbuf_tracking_cache, node);
+		} else {
+			node->p_next = qdf_net_buf_track_free_list;
+			qdf_net_buf_track_free_list = node;
+			qdf_net_buf_track_free_list_count++;
+		}
+	}
+	update_max_free();
+	spin_unlock(&qdf_net_buf_track_free_list_lock);
+}
+
 /**
  * qdf_nbuf_track_alloc() - allocate a cookie to track nbufs allocated by wlan
  *
- * This function pulls from a freelist if possible and uses kmem_cache_alloc.
- * This function also ads fexibility to adjust the allocation and freelist
- * scheems.
+ * This function pulls from the freelist of the current CPU if possible, which
+ * is refilled in batches from the global freelist, and uses kmem_cache_alloc
+ * otherwise. This function also ads fexibility to adjust the allocation and
+ * freelist scheems.
  *
  * Return: a pointer to an unused QDF_NBUF_TRACK structure may not be zeroed.
  */
@@ -2900,18 +3037,20 @@ static QDF_NBUF_TRACK *qdf_nbuf_track_alloc(void)
 {
 	int flags = GFP_KERNEL;
 	unsigned long irq_flag;
-	QDF_NBUF_TRACK *new_node = NULL;
+	struct qdf_nbuf_track_cpu_cache *cache;
+	QDF_NBUF_TRACK *new_node;
 
-	spin_lock_irqsave(&qdf_net_buf_track_free_list_lock, irq_flag);
-	qdf_net_buf_track_used_list_count++;
-	if (qdf_net_buf_track_free_list) {
-		new_node = qdf_net_buf_track_free_list;
-		qdf_net_buf_track_free_list =
-			qdf_net_buf_track_free_list->p_next;
-		qdf_net_buf_track_free_list_count--;
+	local_irq_save(irq_flag);
+	cache = this_cpu_ptr(&qdf_nbuf_track_cpu_cache);
+	cache->used++;
+	if (!cache->free_list)
+		qdf_nbuf_track_cpu_refill(cache);
+	new_node = cache->free_list;
+	if (new_node) {
+		cache->free_list = new_node->p_next;
+		cache->free_count--;
 	}
-	update_max_used();
-	spin_unlock_irqrestore(&qdf_net_buf_track_free_list_lock, irq_flag);
+	local_irq_restore(irq_flag);
 
 	if (new_node)
 		return new_node;
@@ -2922,48 +3061,34 @@ static QDF_NBUF_TRACK *qdf_nbuf_track_alloc(void)
 	return kmem_cache_alloc(nbuf_tracking_cache, flags);
 }
 
-/* FREEQ_POOLSIZE initial and minimum desired freelist poolsize */
-#define FREEQ_POOLSIZE 2048
-
 /**
  * qdf_nbuf_track_free() - free the nbuf tracking cookie.
  * @node: nbuf tracking node
  *
  * Matches calls to qdf_nbuf_track_alloc.
- * Either frees the tracking cookie to kernel or an internal
- * freelist based on the size of the freelist.
+ * Puts the tracking cookie in the freelist of the current CPU, and gives a
+ * batch back to the global freelist, or to the kernel based on the size of
+ * the global freelist, when the CPU freelist is full.
  *
  * Return: none
  */
 static void qdf_nbuf_track_free(QDF_NBUF_TRACK *node)
 {
 	unsigned long irq_flag;
+	struct qdf_nbuf_track_cpu_cache *cache;
 
 	if (!node)
 		return;
 
-	/* Try to shrink the freelist if free_list_count > than FREEQ_POOLSIZE
-	 * only shrink the freelist if it is bigger than twice the number of
-	 * nbufs in use. If the driver is stalling in a consistent bursty
-	 * fashion, this will keep 3/4 of thee allocations from the free list
-	 * while also allowing the system to recover memory as less frantic
-	 * traffic occurs.
-	 */
-
-	spin_lock_irqsave(&qdf_net_buf_track_free_list_lock, irq_flag);
-
-	qdf_net_buf_track_used_list_count--;
-	if (qdf_net_buf_track_free_list_count > FREEQ_POOLSIZE &&
-	   (qdf_net_buf_track_free_list_count >
-	    qdf_net_buf_track_used_list_count << 1)) {
-		kmem_cache_free(nbuf_tracking_cache, node);
-	} else {
-		node->p_next = qdf_net_buf_track_free_list;
-		qdf_net_buf_track_free_list = node;
-		qdf_net_buf_track_free_list_count++;
-	}
-	update_max_free();
-	spin_unlock_irqrestore(&qdf_net_buf_track_free_list_lock, irq_flag);
+	local_irq_save(irq_flag);
+	cache = this_cpu_ptr(&qdf_nbuf_track_cpu_cache);
+	cache->used--;
+	node->p_next = cache->free_list;
+	cache->free_list = node;
+	cache->free_count++;
+	if (cache->free_count >= QDF_NBUF_TRACK_CPU_MAX)
+		qdf_nbuf_track_cpu_flush(cache, QDF_NBUF_TRACK_CPU_BATCH);
+	local_irq_restore(irq_flag);
 }
 
 /**
@@ -3033,8 +3158,19 @@ static void qdf_nbuf_track_memory_manager_destroy(void)
 {
 	QDF_NBUF_TRACK *node, *tmp;
 	unsigned long irq_flag;
+	struct qdf_nbuf_track_cpu_cache *cache;
+	int cpu;
+
+	/* tracking is over, the CPU caches can be emptied from here */
+	local_irq_save(irq_flag);
+	for_each_possible_cpu(cpu) {
+		cache = per_cpu_ptr(&qdf_nbuf_track_cpu_cache, cpu);
+		qdf_nbuf_track_cpu_flush(cache, cache->free_count);
+	}
+	local_irq_restore(irq_flag);
 
 	spin_lock_irqsave(&qdf_net_buf_track_free_list_lock, irq_flag);
+	update_max_used();
 	node = qdf_net_buf_track_free_list;
 
 	if (qdf_net_buf_track_max_used > FREEQ_POOLSIZE * 4)
@@ -3086,6 +3222,9 @@ static void qdf_nbuf_track_memory_manager_destroy(void)
 	spin_unlock_irqrestore(&qdf_net_buf_track_free_list_lock, irq_flag);
 	kmem_cache_destroy(nbuf_tracking_cache);
 	qdf_net_buf_track_free_list = NULL;
+
+	for_each_possible_cpu(cpu)
+		per_cpu_ptr(&qdf_nbuf_track_cpu_cache, cpu)->used = 0;
 }
 
 void qdf_net_buf_debug_init(void)
@@ -3099,6 +3238,12 @@ void qdf_net_buf_debug_init(void)
 
 	qdf_atomic_set(&qdf_nbuf_history_index, -1);
 
+	/* the rate can't change while nbufs are tracked, see below */
+	qdf_net_buf_track_sample_rate = nbuf_track_sample_rate;
+	if (qdf_net_buf_track_sample_rate > 1)
+		qdf_info("Tracking 1 in %u nbufs",
+			 qdf_net_buf_track_sample_rate);
+
 	qdf_nbuf_map_tracking_init();
 	qdf_nbuf_smmu_map_tracking_init();
 	qdf_nbuf_track_memory_manager_create();
@@ -3146,6 +3291,10 @@ void qdf_net_buf_debug_exit(void)
 	qdf_nbuf_map_tracking_deinit();
 	qdf_nbuf_smmu_map_tracking_deinit();
 
+	if (count && qdf_net_buf_track_sample_rate > 1)
+		qdf_info("%u SKB leaks found tracking 1 in %u nbufs",
+			 count, qdf_net_buf_track_sample_rate);
+
 #ifdef CONFIG_HALT_KMEMLEAK
 	if (count) {
 		qdf_err("%d SKBs leaked .. please fix the SKB leak", count);
@@ -3172,6 +3321,26 @@ static uint32_t qdf_net_buf_debug_hash(qdf_nbuf_t net_buf)
 	return i;
 }
 
+static DEFINE_PER_CPU(uint32_t, qdf_net_buf_track_sample_count);
+
+/**
+ * qdf_net_buf_debug_sample() - pick the network buffers to track
+ *
+ * When sampling, 1 in qdf_net_buf_track_sample_rate allocations is tracked,
+ * with full call site attribution, counted per CPU so that the pick does not
+ * depend on which address the allocator hands out.
+ *
+ * Return: true if the buffer being allocated is to be tracked
+ */
+static inline bool qdf_net_buf_debug_sample(void)
+{
+	if (qdf_net_buf_track_sample_rate <= 1)
+		return true;
+
+	return !(this_cpu_inc_return(qdf_net_buf_track_sample_count) %
+		 qdf_net_buf_track_sample_rate);
+}
+
 /**
  * qdf_net_buf_debug_look_up() - look up network buffer in debug hash table
  * @net_buf: network buffer
@@ -3196,6 +3365,34 @@ static QDF_NBUF_TRACK *qdf_net_buf_debug_look_up(qdf_nbuf_t net_buf)
 	return NULL;
 }
 
+/**
+ * qdf_net_buf_debug_sampled() - check if a network buffer is tracked
+ * @net_buf: network buffer
+ *
+ * The pick made by qdf_net_buf_debug_sample() when the buffer was allocated
+ * is kept as its node in the tracking table, so the history and map/unmap
+ * tracking follow it for as long as the buffer lives, from whichever path
+ * they are called.
+ *
+ * Return: true if @net_buf is tracked
+ */
+static bool qdf_net_buf_debug_sampled(qdf_nbuf_t net_buf)
+{
+	uint32_t i;
+	unsigned long irq_flag;
+	bool sampled;
+
+	if (qdf_net_buf_track_sample_rate <= 1)
+		return true;
+
+	i = qdf_net_buf_debug_hash(net_buf);
+	spin_lock_irqsave(&g_qdf_net_buf_track_lock[i], irq_flag);
+	sampled = !!qdf_net_buf_debug_look_up(net_buf);
+	spin_unlock_irqrestore(&g_qdf_net_buf_track_lock[i], irq_flag);
+
+	return sampled;
+}
+
 void qdf_net_buf_debug_add_node(qdf_nbuf_t net_buf, size_t size,
 				const char *func_name, uint32_t line_num)
 {
@@ -3204,7 +3401,7 @@ void qdf_net_buf_debug_add_node(qdf_nbuf_t net_buf, size_t size,
 	QDF_NBUF_TRACK *p_node;
 	QDF_NBUF_TRACK *new_node;
 
-	if (is_initial_mem_debug_disabled)
+	if (is_initial_mem_debug_disabled || !qdf_net_buf_debug_sample())
 		return;
 
 	new_node = qdf_nbuf_track_alloc();
@@ -3428,7 +3625,8 @@ done:
 	if (p_node) {
 		qdf_mem_skb_dec(p_node->size);
 		qdf_nbuf_track_free(p_node);
-	} else {
+	} else if (qdf_net_buf_track_sample_rate <= 1) {
+		/* when sampling, most buffers are not tracked */
 		if (qdf_net_buf_track_fail_count) {
 			qdf_print("Untracked net_buf free: %pK with tracking failures count: %u",
 				  net_buf, qdf_net_buf_track_fail_count);
@@ -3590,8 +3788,9 @@ void qdf_nbuf_free_debug(qdf_nbuf_t nbuf, const char *func, uint32_t line)
 	/* Remove SKB from internal QDF tracking table */
 	qdf_nbuf_panic_on_free_if_smmu_mapped(nbuf, func, line);
 	qdf_nbuf_panic_on_free_if_mapped(nbuf, func, line);
-	qdf_net_buf_debug_delete_node(nbuf);
+	/* while the node qdf_nbuf_history_add() samples by is there */
 	qdf_nbuf_history_add(nbuf, func, line, QDF_NBUF_FREE);
+	qdf_net_buf_debug_delete_node(nbuf);
 
 	/* Take care to delete the debug entries for frags */
 	num_nr_frags = qdf_nbuf_get_nr_frags(nbuf);
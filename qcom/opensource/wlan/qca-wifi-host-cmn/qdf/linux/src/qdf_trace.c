@@ -31,6 +31,13 @@
 #include <qdf_util.h>
 #include <qdf_mem.h>
 #include <qdf_list.h>
+#ifdef CONFIG_DP_TRACE
+#include <linux/cpu.h>
+#include <linux/mutex.h>
+#include <linux/percpu.h>
+#include <linux/rcupdate.h>
+#include <linux/workqueue.h>
+#endif
 
 /* macro to map qdf trace levels into the bitmask */
 #define QDF_TRACE_LEVEL_TO_MODULE_BITMASK(_level) ((1 << (_level)))
@@ -103,6 +110,37 @@ static struct qdf_dp_trace_record_s
 #endif
 static spinlock_t l_dp_trace_lock;
 
+/**
+ * struct qdf_dp_trace_percpu_ring - DP trace records of one CPU
+ * @written: number of records published in @rec, the next one goes to slot
+ *           @written % QDF_DP_TRACE_PERCPU_RECORDS
+ * @floor: value of @written when the buffer was last cleared
+ * @merge_pos: next record to merge, protected by l_dp_trace_lock
+ * @merge_end: value of @written when the merge started, protected by
+ *             l_dp_trace_lock
+ * @rec: QDF_DP_TRACE_PERCPU_RECORDS records
+ *
+ * Only the owning CPU writes to its ring, with bottom halves disabled, so no
+ * lock is needed. A reader copies a record, then checks with @written that
+ * the writer did not get back to that slot meanwhile.
+ */
+struct qdf_dp_trace_percpu_ring {
+	unsigned long written;
+	unsigned long floor;
+	unsigned long merge_pos;
+	unsigned long merge_end;
+	struct qdf_dp_trace_record_s *rec;
+};
+
+QDF_COMPILE_TIME_ASSERT(qdf_dp_trace_percpu_records_pow2,
+			!(QDF_DP_TRACE_PERCPU_RECORDS &
+			  (QDF_DP_TRACE_PERCPU_RECORDS - 1)));
+
+static DEFINE_PER_CPU(struct qdf_dp_trace_percpu_ring, qdf_dp_trace_percpu);
+static bool qdf_dp_trace_percpu_allocated;
+/* serializes recording mode changes, benchmark runs and ring (de)allocation */
+static DEFINE_MUTEX(qdf_dp_trace_mode_lock);
+
 /*
  * all the options to configure/control DP trace are
  * defined in this structure
@@ -560,6 +598,55 @@ static inline void free_g_qdf_dp_trace_tbl_buffer(void)
 { }
 #endif
 
+/**
+ * qdf_dp_trace_percpu_free() - free the per-CPU rings
+ *
+ * Return: none
+ */
+static void qdf_dp_trace_percpu_free(void)
+{
+	struct qdf_dp_trace_percpu_ring *ring;
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&qdf_dp_trace_percpu, cpu);
+		qdf_mem_vfree(ring->rec);
+		ring->rec = NULL;
+		ring->written = 0;
+		ring->floor = 0;
+	}
+	qdf_dp_trace_percpu_allocated = false;
+}
+
+/**
+ * qdf_dp_trace_percpu_alloc() - allocate the per-CPU rings
+ *
+ * Return: QDF_STATUS_SUCCESS if the rings are allocated
+ */
+static QDF_STATUS qdf_dp_trace_percpu_alloc(void)
+{
+	struct qdf_dp_trace_percpu_ring *ring;
+	int cpu;
+
+	if (qdf_dp_trace_percpu_allocated)
+		return QDF_STATUS_SUCCESS;
+
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&qdf_dp_trace_percpu, cpu);
+		ring->rec = qdf_mem_valloc(QDF_DP_TRACE_PERCPU_RECORDS *
+					   sizeof(*ring->rec));
+		if (!ring->rec) {
+			qdf_dp_trace_percpu_free();
+			return QDF_STATUS_E_NOMEM;
+		}
+		ring->written = 0;
+		ring->floor = 0;
+	}
+	qdf_dp_trace_percpu_allocated = true;
+
+	return QDF_STATUS_SUCCESS;
+}
+
 #define QDF_DP_TRACE_PREPEND_STR_SIZE 100
 /*
  * one dp trace record can't be greater than 300 bytes.
@@ -641,8 +728,17 @@ void qdf_dp_trace_deinit(void)
 	spin_lock_bh(&l_dp_trace_lock);
 	g_qdf_dp_trace_data.enable = false;
 	g_qdf_dp_trace_data.no_of_record = 0;
+	g_qdf_dp_trace_data.percpu_mode = false;
 	spin_unlock_bh(&l_dp_trace_lock);
 
+	mutex_lock(&qdf_dp_trace_mode_lock);
+	if (qdf_dp_trace_percpu_allocated) {
+		/* per-CPU writers run with BHs disabled, an RCU read section */
+		synchronize_rcu();
+		qdf_dp_trace_percpu_free();
+	}
+	mutex_unlock(&qdf_dp_trace_mode_lock);
+
 	free_g_qdf_dp_trace_tbl_buffer();
 }
 
@@ -1205,6 +1301,81 @@ end:
 	rec->size = data_to_copy;
 }
 
+/**
+ * qdf_dp_trace_live_check() - check if a record is to be printed
+ * @print: true to print it in kmsg
+ * @info: info of the record, updated if live mode gets throttled
+ *
+ * Should be called with l_dp_trace_lock held.
+ *
+ * Return: true if the record is to be printed
+ */
+static bool qdf_dp_trace_live_check(bool print, u8 *info)
+{
+	if (print || g_qdf_dp_trace_data.force_live_mode)
+		return true;
+
+	if (g_qdf_dp_trace_data.live_mode != 1)
+		return false;
+
+	g_qdf_dp_trace_data.print_pkt_cnt++;
+	if (g_qdf_dp_trace_data.print_pkt_cnt >
+			g_qdf_dp_trace_data.high_tput_thresh) {
+		g_qdf_dp_trace_data.live_mode = 0;
+		g_qdf_dp_trace_data.verbosity =
+				QDF_DP_TRACE_VERBOSITY_ULTRA_LOW;
+		*info |= QDF_DP_TRACE_RECORD_INFO_THROTTLED;
+	}
+
+	return true;
+}
+
+/**
+ * qdf_dp_add_percpu_record() - add dp trace record to the ring of this CPU
+ * @code: dptrace code
+ * @pdev_id: pdev_id
+ * @data: data pointer
+ * @data_size: size of data to be copied
+ * @meta_data: meta data to be prepended to data
+ * @metadata_size: sizeof meta data
+ * @index: filled with the slot of the record in the ring
+ *
+ * Should be called with bottom halves disabled. The ring is only written
+ * by its CPU, so no lock is taken.
+ *
+ * Return: the record
+ */
+static struct qdf_dp_trace_record_s *
+qdf_dp_add_percpu_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
+			 uint8_t *data, uint8_t data_size,
+			 uint8_t *meta_data, uint8_t metadata_size,
+			 int *index)
+{
+	struct qdf_dp_trace_percpu_ring *ring;
+	struct qdf_dp_trace_record_s *rec;
+
+	ring = this_cpu_ptr(&qdf_dp_trace_percpu);
+	*index = ring->written & (QDF_DP_TRACE_PERCPU_RECORDS - 1);
+	rec = &ring->rec[*index];
+	rec->code = code;
+	rec->pdev_id = pdev_id;
+	rec->size = 0;
+	qdf_dp_fill_record_data(rec, data, data_size,
+				meta_data, metadata_size);
+	rec->time = qdf_get_log_timestamp();
+	rec->pid = (in_interrupt() ? 0 : current->pid);
+
+	/*
+	 * Publish the record, and order the publication before the writes
+	 * of the next record to the slot a reader may be copying.
+	 */
+	smp_wmb();
+	WRITE_ONCE(ring->written, ring->written + 1);
+	smp_wmb();
+
+	return rec;
+}
+
 /**
  * qdf_dp_add_record() - add dp trace record
  * @code: dptrace code
@@ -1236,22 +1407,31 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 		return;
 	}
 
-	spin_lock_bh(&l_dp_trace_lock);
-
-	if (print || g_qdf_dp_trace_data.force_live_mode) {
-		print_this_record = true;
-	} else if (g_qdf_dp_trace_data.live_mode == 1) {
-		print_this_record = true;
-		g_qdf_dp_trace_data.print_pkt_cnt++;
-		if (g_qdf_dp_trace_data.print_pkt_cnt >
-				g_qdf_dp_trace_data.high_tput_thresh) {
-			g_qdf_dp_trace_data.live_mode = 0;
-			g_qdf_dp_trace_data.verbosity =
-					QDF_DP_TRACE_VERBOSITY_ULTRA_LOW;
-			info |= QDF_DP_TRACE_RECORD_INFO_THROTTLED;
+	/*
+	 * The mode is checked with BHs disabled so that the per-CPU rings
+	 * are not freed under a writer, see qdf_dp_trace_deinit().
+	 */
+	local_bh_disable();
+
+	if (g_qdf_dp_trace_data.percpu_mode) {
+		if (print || g_qdf_dp_trace_data.force_live_mode ||
+		    g_qdf_dp_trace_data.live_mode) {
+			spin_lock(&l_dp_trace_lock);
+			print_this_record = qdf_dp_trace_live_check(print,
+								    &info);
+			spin_unlock(&l_dp_trace_lock);
 		}
+		rec = qdf_dp_add_percpu_record(code, pdev_id, data, data_size,
+					       meta_data, metadata_size,
+					       &index);
+		local_bh_enable();
+		goto out;
 	}
 
+	spin_lock(&l_dp_trace_lock);
+
+	print_this_record = qdf_dp_trace_live_check(print, &info);
+
 	g_qdf_dp_trace_data.num++;
 
 	if (g_qdf_dp_trace_data.num > MAX_QDF_DP_TRACE_RECORDS)
@@ -1286,15 +1466,10 @@ static void qdf_dp_add_record(enum QDF_DP_TRACE_ID code, uint8_t pdev_id,
 	rec->time = qdf_get_log_timestamp();
 	rec->pid = (in_interrupt() ? 0 : current->pid);
 
-	if (rec->code >= QDF_DP_TRACE_MAX) {
-		QDF_TRACE_ERROR(QDF_MODULE_ID_QDF,
-				"invalid record code %u, max code %u",
-				rec->code, QDF_DP_TRACE_MAX);
-		return;
-	}
-
-	spin_unlock_bh(&l_dp_trace_lock);
+	spin_unlock(&l_dp_trace_lock);
+	local_bh_enable();
 
+out:
 	info |= QDF_DP_TRACE_RECORD_INFO_LIVE;
 	if (print_this_record)
 		qdf_dp_trace_cb_table[rec->code] (rec, index,
@@ -2672,9 +2847,179 @@ void qdf_dp_trace_clear_buffer(void)
 		memset(g_qdf_dp_trace_tbl, 0,
 		       MAX_QDF_DP_TRACE_RECORDS *
 		       sizeof(struct qdf_dp_trace_record_s));
+
+	/* writers never touch floor, records from before it are skipped */
+	if (qdf_dp_trace_percpu_allocated) {
+		struct qdf_dp_trace_percpu_ring *ring;
+		int cpu;
+
+		for_each_possible_cpu(cpu) {
+			ring = per_cpu_ptr(&qdf_dp_trace_percpu, cpu);
+			ring->floor = READ_ONCE(ring->written);
+		}
+	}
 }
 qdf_export_symbol(qdf_dp_trace_clear_buffer);
 
+/**
+ * qdf_dp_trace_percpu_oldest() - get the oldest record a reader may copy
+ * @ring: per-CPU ring
+ * @written: written value of @ring
+ *
+ * The writer may be overwriting the slot of the record before it.
+ *
+ * Return: sequence number of the record
+ */
+static inline unsigned long
+qdf_dp_trace_percpu_oldest(struct qdf_dp_trace_percpu_ring *ring,
+			   unsigned long written)
+{
+	unsigned long oldest = 0;
+
+	if (written >= QDF_DP_TRACE_PERCPU_RECORDS)
+		oldest = written - QDF_DP_TRACE_PERCPU_RECORDS + 1;
+
+	return oldest > ring->floor ? oldest : ring->floor;
+}
+
+/**
+ * qdf_dp_trace_percpu_merge() - merge the per-CPU rings into the global one
+ *
+ * Copies the last MAX_QDF_DP_TRACE_RECORDS records of the per-CPU rings to
+ * the global ring in timestamp order, so that the dump functions walk it as
+ * they do in the global ring mode. Writers keep going meanwhile, a record
+ * overwritten while being copied is dropped.
+ *
+ * Return: none
+ */
+static void qdf_dp_trace_percpu_merge(void)
+{
+	struct qdf_dp_trace_percpu_ring *ring, *next;
+	struct qdf_dp_trace_record_s *rec, *best;
+	unsigned long seq;
+	uint32_t num = 0;
+	int cpu;
+
+	if (!qdf_dp_trace_percpu_allocated)
+		return;
+
+	spin_lock_bh(&l_dp_trace_lock);
+
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&qdf_dp_trace_percpu, cpu);
+		ring->merge_end = READ_ONCE(ring->written);
+		ring->merge_pos = ring->merge_end;
+	}
+	smp_rmb();
+
+	/*
+	 * Walk back from the newest records to where the merge starts, the
+	 * log timestamp being common to all CPUs.
+	 */
+	while (num < MAX_QDF_DP_TRACE_RECORDS) {
+		next = NULL;
+		best = NULL;
+		for_each_possible_cpu(cpu) {
+			ring = per_cpu_ptr(&qdf_dp_trace_percpu, cpu);
+			if (ring->merge_pos <=
+			    qdf_dp_trace_percpu_oldest(ring, ring->merge_end))
+				continue;
+
+			rec = &ring->rec[(ring->merge_pos - 1) &
+					 (QDF_DP_TRACE_PERCPU_RECORDS - 1)];
+			if (!best || rec->time > best->time) {
+				best = rec;
+				next = ring;
+			}
+		}
+		if (!next)
+			break;
+		next->merge_pos--;
+		num++;
+	}
+
+	/* then merge forward, oldest record first */
+	num = 0;
+	for (;;) {
+		next = NULL;
+		best = NULL;
+		for_each_possible_cpu(cpu) {
+			ring = per_cpu_ptr(&qdf_dp_trace_percpu, cpu);
+			if (ring->merge_pos == ring->merge_end)
+				continue;
+
+			rec = &ring->rec[ring->merge_pos &
+					 (QDF_DP_TRACE_PERCPU_RECORDS - 1)];
+			if (!best || rec->time < best->time) {
+				best = rec;
+				next = ring;
+			}
+		}
+		if (!next)
+			break;
+
+		seq = next->merge_pos++;
+		g_qdf_dp_trace_tbl[num] = *best;
+		smp_rmb();
+		if (seq < qdf_dp_trace_percpu_oldest(next,
+						     READ_ONCE(next->written)))
+			continue;
+		num++;
+	}
+
+	g_qdf_dp_trace_data.num = num;
+	g_qdf_dp_trace_data.head = num ? 0 : INVALID_QDF_DP_TRACE_ADDR;
+	g_qdf_dp_trace_data.tail = num ? num - 1 : INVALID_QDF_DP_TRACE_ADDR;
+
+	spin_unlock_bh(&l_dp_trace_lock);
+}
+
+/**
+ * qdf_dp_trace_switch_mode() - switch dptrace recording mode
+ * @percpu: true for the per-CPU rings, false for the global ring
+ *
+ * Should be called with qdf_dp_trace_mode_lock held.
+ *
+ * Return: QDF_STATUS_SUCCESS on success
+ */
+static QDF_STATUS qdf_dp_trace_switch_mode(bool percpu)
+{
+	if (percpu && qdf_dp_trace_percpu_alloc() != QDF_STATUS_SUCCESS)
+		return QDF_STATUS_E_NOMEM;
+
+	if (g_qdf_dp_trace_data.percpu_mode == percpu)
+		return QDF_STATUS_SUCCESS;
+
+	spin_lock_bh(&l_dp_trace_lock);
+	g_qdf_dp_trace_data.percpu_mode = percpu;
+	spin_unlock_bh(&l_dp_trace_lock);
+
+	/* let the records started in the previous mode complete */
+	synchronize_rcu();
+	qdf_dp_trace_clear_buffer();
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS qdf_dp_trace_set_percpu_mode(bool enable)
+{
+	QDF_STATUS status;
+
+	if (!g_qdf_dp_trace_data.enable)
+		return QDF_STATUS_E_INVAL;
+
+	mutex_lock(&qdf_dp_trace_mode_lock);
+	status = qdf_dp_trace_switch_mode(enable);
+	mutex_unlock(&qdf_dp_trace_mode_lock);
+
+	if (QDF_IS_STATUS_ERROR(status))
+		QDF_TRACE_ERROR(QDF_MODULE_ID_QDF,
+				"Failed to allocate DP trace per-CPU rings");
+
+	return status;
+}
+qdf_export_symbol(qdf_dp_trace_set_percpu_mode);
+
 void qdf_dp_trace_dump_stats(void)
 {
 		DPTRACE_PRINT("STATS |DPT: tx %u rx %u icmp(%u %u) arp(%u %u) icmpv6(%u %u %u %u %u %u) dhcp(%u %u %u %u %u %u) eapol(%u %u %u %u %u)",
@@ -2880,7 +3225,7 @@ uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
 {
 	uint32_t i = 0;
 	uint32_t tail;
-	uint32_t count = g_qdf_dp_trace_data.num;
+	uint32_t count;
 
 	if (!g_qdf_dp_trace_data.enable) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
@@ -2888,6 +3233,12 @@ uint32_t qdf_dpt_get_curr_pos_debugfs(qdf_debugfs_file_t file,
 		return QDF_STATUS_E_EMPTY;
 	}
 
+	if (g_qdf_dp_trace_data.percpu_mode &&
+	    state != QDF_DPT_DEBUGFS_STATE_SHOW_IN_PROGRESS)
+		qdf_dp_trace_percpu_merge();
+
+	count = g_qdf_dp_trace_data.num;
+
 	if (!count) {
 		QDF_TRACE(QDF_MODULE_ID_QDF, QDF_TRACE_LEVEL_DEBUG,
 		  "%s: no packets", __func__);
@@ -3111,6 +3462,9 @@ void qdf_dp_trace_dump_all(uint32_t count, uint8_t pdev_id)
 		return;
 	}
 
+	if (g_qdf_dp_trace_data.percpu_mode)
+		qdf_dp_trace_percpu_merge();
+
 	DPTRACE_PRINT(
 		"DPT: config - bitmap 0x%x verb %u #rec %u live_config %u thresh %u time_limit %u",
 		g_qdf_dp_trace_data.proto_bitmap,
@@ -3167,6 +3521,272 @@ void qdf_dp_trace_dump_all(uint32_t count, uint8_t pdev_id)
 }
 qdf_export_symbol(qdf_dp_trace_dump_all);
 
+/**
+ * struct qdf_dp_trace_bench_work - dptrace benchmark work of one CPU
+ * @work: work item, queued on the CPU
+ * @num_records: number of records to add
+ */
+struct qdf_dp_trace_bench_work {
+	struct work_struct work;
+	uint32_t num_records;
+};
+
+/**
+ * qdf_dp_trace_bench_work_fn() - add the benchmark records of one CPU
+ * @work: work item
+ *
+ * Return: none
+ */
+static void qdf_dp_trace_bench_work_fn(struct work_struct *work)
+{
+	struct qdf_dp_trace_bench_work *bench =
+		container_of(work, struct qdf_dp_trace_bench_work, work);
+	uint8_t data[QDF_DP_TRACE_RECORD_SIZE] = { 0 };
+	uint32_t i;
+
+	for (i = 0; i < bench->num_records; i++) {
+		qdf_dp_add_record(QDF_DP_TRACE_EVENT_RECORD,
+				  QDF_TRACE_DEFAULT_PDEV_ID, data,
+				  sizeof(data), NULL, 0, false);
+		if (!(i & 1023))
+			cond_resched();
+	}
+}
+
+/**
+ * qdf_dp_trace_bench_run() - run the benchmark in the current mode
+ * @bench: work items, one per possible CPU
+ * @num_records: number of records to add from each online CPU
+ * @num_cpus: filled with the number of CPUs the records were added from
+ *
+ * Return: time taken in ns
+ */
+static uint64_t qdf_dp_trace_bench_run(struct qdf_dp_trace_bench_work *bench,
+				       uint32_t num_records,
+				       uint32_t *num_cpus)
+{
+	uint64_t start, elapsed;
+	int cpu;
+
+	*num_cpus = 0;
+	cpus_read_lock();
+	start = qdf_ktime_get_ns();
+	for_each_online_cpu(cpu) {
+		INIT_WORK(&bench[cpu].work, qdf_dp_trace_bench_work_fn);
+		bench[cpu].num_records = num_records;
+		schedule_work_on(cpu, &bench[cpu].work);
+		(*num_cpus)++;
+	}
+	for_each_online_cpu(cpu)
+		flush_work(&bench[cpu].work);
+	elapsed = qdf_ktime_get_ns() - start;
+	cpus_read_unlock();
+
+	return elapsed ? elapsed : 1;
+}
+
+/**
+ * struct qdf_dp_trace_saved - live dptrace state saved by the benchmark
+ * @tbl: copy of the global ring
+ * @head: saved head of the global ring
+ * @tail: saved tail of the global ring
+ * @num: saved number of records in the global ring
+ * @dump_counter: saved dump counter
+ * @num_records_to_dump: saved number of records to dump
+ * @rings: live per-CPU rings, one per possible CPU
+ */
+struct qdf_dp_trace_saved {
+	struct qdf_dp_trace_record_s *tbl;
+	uint32_t head;
+	uint32_t tail;
+	uint32_t num;
+	uint16_t dump_counter;
+	uint16_t num_records_to_dump;
+	struct qdf_dp_trace_percpu_ring *rings;
+};
+
+/**
+ * qdf_dp_trace_bench_free_rings() - free per-CPU records saved aside
+ * @rings: rings whose records are freed, one per possible CPU
+ *
+ * Return: none
+ */
+static void
+qdf_dp_trace_bench_free_rings(struct qdf_dp_trace_percpu_ring *rings)
+{
+	int cpu;
+
+	for_each_possible_cpu(cpu)
+		qdf_mem_vfree(rings[cpu].rec);
+	qdf_mem_free(rings);
+}
+
+/**
+ * qdf_dp_trace_bench_swap_rings() - swap the per-CPU rings with saved ones
+ * @rings: rings to install, filled with the ones they replace
+ *
+ * Should be called in the global ring mode, once the per-CPU writers are
+ * done, and with l_dp_trace_lock held to keep the merge out.
+ *
+ * Return: none
+ */
+static void
+qdf_dp_trace_bench_swap_rings(struct qdf_dp_trace_percpu_ring *rings)
+{
+	struct qdf_dp_trace_percpu_ring *ring, tmp;
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		ring = per_cpu_ptr(&qdf_dp_trace_percpu, cpu);
+		tmp = *ring;
+		*ring = rings[cpu];
+		rings[cpu] = tmp;
+	}
+}
+
+/**
+ * qdf_dp_trace_bench_save() - set the live records aside
+ * @saved: filled with the live state
+ *
+ * Copies the global ring and swaps the per-CPU rings with empty private
+ * ones, so that the benchmark does not overwrite the live records. Leaves
+ * dptrace in the global ring mode. Should be called with
+ * qdf_dp_trace_mode_lock held.
+ *
+ * Return: QDF_STATUS_SUCCESS if the live state is saved
+ */
+static QDF_STATUS qdf_dp_trace_bench_save(struct qdf_dp_trace_saved *saved)
+{
+	int cpu;
+
+	if (qdf_dp_trace_percpu_alloc() != QDF_STATUS_SUCCESS)
+		return QDF_STATUS_E_NOMEM;
+
+	saved->tbl = qdf_mem_valloc(MAX_QDF_DP_TRACE_RECORDS *
+				    sizeof(*saved->tbl));
+	saved->rings = qdf_mem_malloc(nr_cpu_ids * sizeof(*saved->rings));
+	if (!saved->tbl || !saved->rings)
+		goto fail;
+
+	for_each_possible_cpu(cpu) {
+		saved->rings[cpu].rec =
+			qdf_mem_valloc(QDF_DP_TRACE_PERCPU_RECORDS *
+				       sizeof(*saved->rings[cpu].rec));
+		if (!saved->rings[cpu].rec)
+			goto fail;
+	}
+
+	spin_lock_bh(&l_dp_trace_lock);
+	g_qdf_dp_trace_data.percpu_mode = false;
+	spin_unlock_bh(&l_dp_trace_lock);
+
+	/* let the per-CPU writers complete before taking their rings */
+	synchronize_rcu();
+
+	spin_lock_bh(&l_dp_trace_lock);
+	qdf_dp_trace_bench_swap_rings(saved->rings);
+	qdf_mem_copy(saved->tbl, g_qdf_dp_trace_tbl,
+		     MAX_QDF_DP_TRACE_RECORDS * sizeof(*saved->tbl));
+	saved->head = g_qdf_dp_trace_data.head;
+	saved->tail = g_qdf_dp_trace_data.tail;
+	saved->num = g_qdf_dp_trace_data.num;
+	saved->dump_counter = g_qdf_dp_trace_data.dump_counter;
+	saved->num_records_to_dump = g_qdf_dp_trace_data.num_records_to_dump;
+	spin_unlock_bh(&l_dp_trace_lock);
+
+	return QDF_STATUS_SUCCESS;
+
+fail:
+	if (saved->rings)
+		qdf_dp_trace_bench_free_rings(saved->rings);
+	qdf_mem_vfree(saved->tbl);
+	return QDF_STATUS_E_NOMEM;
+}
+
+/**
+ * qdf_dp_trace_bench_restore() - put the live records back
+ * @saved: live state saved by qdf_dp_trace_bench_save()
+ * @percpu_mode: recording mode to restore
+ *
+ * Records added by the traffic while the benchmark ran are dropped.
+ * Should be called with qdf_dp_trace_mode_lock held.
+ *
+ * Return: none
+ */
+static void qdf_dp_trace_bench_restore(struct qdf_dp_trace_saved *saved,
+				       bool percpu_mode)
+{
+	qdf_dp_trace_switch_mode(false);
+
+	spin_lock_bh(&l_dp_trace_lock);
+	qdf_dp_trace_bench_swap_rings(saved->rings);
+	qdf_mem_copy(g_qdf_dp_trace_tbl, saved->tbl,
+		     MAX_QDF_DP_TRACE_RECORDS * sizeof(*saved->tbl));
+	g_qdf_dp_trace_data.head = saved->head;
+	g_qdf_dp_trace_data.tail = saved->tail;
+	g_qdf_dp_trace_data.num = saved->num;
+	g_qdf_dp_trace_data.dump_counter = saved->dump_counter;
+	g_qdf_dp_trace_data.num_records_to_dump = saved->num_records_to_dump;
+	g_qdf_dp_trace_data.percpu_mode = percpu_mode;
+	spin_unlock_bh(&l_dp_trace_lock);
+
+	qdf_dp_trace_bench_free_rings(saved->rings);
+	qdf_mem_vfree(saved->tbl);
+}
+
+void qdf_dp_trace_benchmark(uint32_t num_records)
+{
+	struct qdf_dp_trace_bench_work *bench;
+	struct qdf_dp_trace_saved saved = { 0 };
+	bool percpu_mode, live_mode, force_live_mode;
+	uint64_t elapsed, rate;
+	uint32_t num_cpus;
+	int mode;
+
+	if (!g_qdf_dp_trace_data.enable || !num_records)
+		return;
+
+	bench = qdf_mem_malloc(nr_cpu_ids * sizeof(*bench));
+	if (!bench)
+		return;
+
+	mutex_lock(&qdf_dp_trace_mode_lock);
+	percpu_mode = g_qdf_dp_trace_data.percpu_mode;
+	if (QDF_IS_STATUS_ERROR(qdf_dp_trace_bench_save(&saved))) {
+		mutex_unlock(&qdf_dp_trace_mode_lock);
+		qdf_nofl_info("DPT: benchmark: no memory to save the records");
+		qdf_mem_free(bench);
+		return;
+	}
+
+	live_mode = g_qdf_dp_trace_data.live_mode;
+	force_live_mode = g_qdf_dp_trace_data.force_live_mode;
+	g_qdf_dp_trace_data.live_mode = false;
+	g_qdf_dp_trace_data.force_live_mode = false;
+
+	for (mode = 0; mode < 2; mode++) {
+		qdf_dp_trace_switch_mode(mode);
+		qdf_dp_trace_clear_buffer();
+
+		elapsed = qdf_dp_trace_bench_run(bench, num_records,
+						 &num_cpus);
+		rate = div64_u64((uint64_t)num_cpus * num_records *
+				 NSEC_PER_SEC, elapsed);
+		qdf_nofl_info("DPT: benchmark: %s: %u CPUs x %u records in %llu us, %llu records/s",
+			      mode ? "per-CPU rings" : "global ring",
+			      num_cpus, num_records,
+			      div64_u64(elapsed, NSEC_PER_USEC), rate);
+	}
+
+	qdf_dp_trace_bench_restore(&saved, percpu_mode);
+	g_qdf_dp_trace_data.live_mode = live_mode;
+	g_qdf_dp_trace_data.force_live_mode = force_live_mode;
+	mutex_unlock(&qdf_dp_trace_mode_lock);
+
+	qdf_mem_free(bench);
+}
+qdf_export_symbol(qdf_dp_trace_benchmark);
+
 void qdf_dp_trace_throttle_live_mode(bool high_bw_request)
 {
 	static int bw_interval_counter;
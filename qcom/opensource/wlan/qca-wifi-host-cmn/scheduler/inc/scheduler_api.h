@@ -78,9 +78,9 @@ typedef void (*hdd_suspend_callback)(void);
  *   callback in message body pointer for those messages which have taken ref
  *   count for above mentioned common objects.
  * @node: list node for queue membership
+ * @queued_at_us: timestamp when the message was queued in microseconds
  * @queue_id: Id of the queue the message was added to
  * @queue_depth: depth of the queue when the message was queued
- * @queued_at_us: timestamp when the message was queued in microseconds
  */
 struct scheduler_msg {
 	uint16_t type;
@@ -90,10 +90,10 @@ struct scheduler_msg {
 	scheduler_msg_process_fn_t callback;
 	scheduler_msg_process_fn_t flush_callback;
 	qdf_list_node_t node;
+	uint64_t queued_at_us;
 #ifdef WLAN_SCHED_HISTORY_SIZE
 	QDF_MODULE_ID queue_id;
 	uint32_t queue_depth;
-	uint64_t queued_at_us;
 #endif /* WLAN_SCHED_HISTORY_SIZE */
 };
 
@@ -24,6 +24,7 @@
 #include <qdf_timer.h>
 #include <scheduler_api.h>
 #include <qdf_list.h>
+#include <qdf_debugfs.h>
 
 #ifndef SCHEDULER_CORE_MAX_MESSAGES
 #define SCHEDULER_CORE_MAX_MESSAGES 4000
@@ -34,6 +35,13 @@
 #define SCHEDULER_NUMBER_OF_MSG_QUEUE 6
 #define SCHEDULER_WRAPPER_MAX_FAIL_COUNT (SCHEDULER_CORE_MAX_MESSAGES * 3)
 #define SCHEDULER_WATCHDOG_TIMEOUT (10 * 1000) /* 10s */
+/* max messages processed from a queue before higher priority ones are due */
+#ifndef SCHEDULER_BATCH_BUDGET
+#define SCHEDULER_BATCH_BUDGET 8
+#endif
+#define SCHEDULER_LATENCY_BUCKETS 10
+/* first latency bucket holds the waits under 2^SCHEDULER_LATENCY_SHIFT us */
+#define SCHEDULER_LATENCY_SHIFT 4
 
 #ifdef CONFIG_AP_PLATFORM
 #define SCHED_DEBUG_PANIC(msg)
@@ -66,16 +74,41 @@
 #define sched_enter() sched_debug("Enter")
 #define sched_exit() sched_debug("Exit")
 
+/**
+ * struct scheduler_mq_stats - scheduler message queue statistics
+ * @enqueued: number of messages queued
+ * @dispatched: number of messages processed
+ * @batches: number of batches the messages were processed in
+ * @max_depth: highest number of messages waiting in the queue
+ * @max_latency_us: longest time a message waited in the queue
+ * @total_latency_us: total time the processed messages waited in the queue
+ * @latency_hist: processed messages per time waited in the queue, bucket n
+ *	counting the waits under 2^(SCHEDULER_LATENCY_SHIFT + 2n) us and the
+ *	last bucket all the longer ones
+ */
+struct scheduler_mq_stats {
+	uint64_t enqueued;
+	uint64_t dispatched;
+	uint64_t batches;
+	uint32_t max_depth;
+	uint32_t max_latency_us;
+	uint64_t total_latency_us;
+	uint32_t latency_hist[SCHEDULER_LATENCY_BUCKETS];
+};
+
 /**
  * struct scheduler_mq_type -  scheduler message queue
  * @mq_lock: message queue lock
  * @mq_list: message queue list
  * @qid: queue id
+ * @stats: queue statistics, the enqueue side is protected by @mq_lock and
+ *	the dispatch side only written by the scheduler thread
  */
 struct scheduler_mq_type {
 	qdf_spinlock_t mq_lock;
 	qdf_list_t mq_list;
 	QDF_MODULE_ID qid;
+	struct scheduler_mq_stats stats;
 };
 
 /**
@@ -109,6 +142,8 @@ struct scheduler_mq_ctx {
  * @timeout: timeout value for scheduler watchdog timer
  * @watchdog_timer: timer for triggering a scheduler watchdog bite
  * @watchdog_callback: the callback of the current msg being processed
+ * @batch_budget: max messages processed from a queue in a row
+ * @debugfs_dir: scheduler debugfs directory
  */
 struct scheduler_ctx {
 	struct scheduler_mq_ctx queue_ctx;
@@ -127,6 +162,8 @@ struct scheduler_ctx {
 	uint32_t timeout;
 	qdf_timer_t watchdog_timer;
 	void *watchdog_callback;
+	uint32_t batch_budget;
+	qdf_dentry_t debugfs_dir;
 };
 
 /**
@@ -246,4 +283,24 @@ QDF_STATUS scheduler_queues_deinit(struct scheduler_ctx *sched_ctx);
  * Return: none
  */
 void scheduler_queues_flush(struct scheduler_ctx *sched_ctx);
+
+/**
+ * scheduler_debugfs_init() - create the scheduler debugfs entries
+ * @sched_ctx: pointer to scheduler context
+ *
+ * Creates "scheduler/queue_stats", which shows the depth high watermark and
+ * the enqueue to dispatch latency histogram of each message queue. Writing
+ * to it clears the statistics.
+ *
+ * Return: none
+ */
+void scheduler_debugfs_init(struct scheduler_ctx *sched_ctx);
+
+/**
+ * scheduler_debugfs_deinit() - remove the scheduler debugfs entries
+ * @sched_ctx: pointer to scheduler context
+ *
+ * Return: none
+ */
+void scheduler_debugfs_deinit(struct scheduler_ctx *sched_ctx);
 #endif
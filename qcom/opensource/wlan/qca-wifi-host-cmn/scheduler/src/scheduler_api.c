@@ -177,6 +177,7 @@ QDF_STATUS scheduler_init(void)
 	qdf_init_waitqueue_head(&sched_ctx->sch_wait_queue);
 	sched_ctx->sch_event_flag = 0;
 	sched_ctx->timeout = SCHEDULER_WATCHDOG_TIMEOUT;
+	sched_ctx->batch_budget = SCHEDULER_BATCH_BUDGET;
 	qdf_timer_init(NULL,
 		       &sched_ctx->watchdog_timer,
 		       &scheduler_watchdog_timeout,
@@ -184,6 +185,7 @@ QDF_STATUS scheduler_init(void)
 		       QDF_TIMER_TYPE_SW);
 
 	qdf_register_mc_timer_callback(scheduler_mc_timer_callback);
+	scheduler_debugfs_init(sched_ctx);
 
 	return QDF_STATUS_SUCCESS;
 
@@ -214,6 +216,7 @@ QDF_STATUS scheduler_deinit(void)
 	if (!sched_ctx)
 		return QDF_STATUS_E_INVAL;
 
+	scheduler_debugfs_deinit(sched_ctx);
 	qdf_timer_free(&sched_ctx->watchdog_timer);
 	qdf_spinlock_destroy(&sched_ctx->sch_thread_lock);
 	qdf_event_destroy(&sched_ctx->resume_sch_event);
@@ -68,12 +68,11 @@ static void sched_history_queue(struct scheduler_mq_type *queue,
 {
 	msg->queue_id = queue->qid;
 	msg->queue_depth = qdf_list_size(&queue->mq_list);
-	msg->queued_at_us = qdf_get_log_timestamp_usecs();
 }
 
-static void sched_history_start(struct scheduler_msg *msg)
+static void sched_history_start(struct scheduler_msg *msg,
+				uint64_t started_at_us)
 {
-	uint64_t started_at_us = qdf_get_log_timestamp_usecs();
 	struct sched_history_item hist = {
 		.callback = msg->callback,
 		.type_id = msg->type,
@@ -140,7 +139,8 @@ void sched_history_print(void)
 
 static inline void sched_history_queue(struct scheduler_mq_type *queue,
 				       struct scheduler_msg *msg) { }
-static inline void sched_history_start(struct scheduler_msg *msg) { }
+static inline void sched_history_start(struct scheduler_msg *msg,
+				       uint64_t started_at_us) { }
 static inline void sched_history_stop(void) { }
 void sched_history_print(void) { }
 
@@ -248,21 +248,70 @@ static QDF_STATUS scheduler_all_queues_deinit(struct scheduler_ctx *sched_ctx)
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * scheduler_mq_stats_queue() - account a message added to a queue
+ * @msg_q: the queue the message was added to, with its lock held
+ *
+ * Return: none
+ */
+static void scheduler_mq_stats_queue(struct scheduler_mq_type *msg_q)
+{
+	uint32_t depth = qdf_list_size(&msg_q->mq_list);
+
+	msg_q->stats.enqueued++;
+	if (depth > msg_q->stats.max_depth)
+		msg_q->stats.max_depth = depth;
+}
+
+/**
+ * scheduler_mq_stats_dispatch() - account a message about to be processed
+ * @msg_q: the queue the message was taken from
+ * @msg: the message
+ * @now_us: current timestamp in microseconds
+ *
+ * Return: none
+ */
+static void scheduler_mq_stats_dispatch(struct scheduler_mq_type *msg_q,
+					struct scheduler_msg *msg,
+					uint64_t now_us)
+{
+	uint64_t latency_us = now_us - msg->queued_at_us;
+	uint8_t bucket = 0;
+
+	msg_q->stats.dispatched++;
+	msg_q->stats.total_latency_us += latency_us;
+	if (latency_us > msg_q->stats.max_latency_us)
+		msg_q->stats.max_latency_us = latency_us;
+
+	latency_us >>= SCHEDULER_LATENCY_SHIFT;
+	while (latency_us && bucket < SCHEDULER_LATENCY_BUCKETS - 1) {
+		latency_us >>= 2;
+		bucket++;
+	}
+	msg_q->stats.latency_hist[bucket]++;
+}
+
 void scheduler_mq_put(struct scheduler_mq_type *msg_q,
 		      struct scheduler_msg *msg)
 {
+	msg->queued_at_us = qdf_get_log_timestamp_usecs();
+
 	qdf_spin_lock_irqsave(&msg_q->mq_lock);
 	sched_history_queue(msg_q, msg);
 	qdf_list_insert_back(&msg_q->mq_list, &msg->node);
+	scheduler_mq_stats_queue(msg_q);
 	qdf_spin_unlock_irqrestore(&msg_q->mq_lock);
 }
 
 void scheduler_mq_put_front(struct scheduler_mq_type *msg_q,
 			    struct scheduler_msg *msg)
 {
+	msg->queued_at_us = qdf_get_log_timestamp_usecs();
+
 	qdf_spin_lock_irqsave(&msg_q->mq_lock);
 	sched_history_queue(msg_q, msg);
 	qdf_list_insert_front(&msg_q->mq_list, &msg->node);
+	scheduler_mq_stats_queue(msg_q);
 	qdf_spin_unlock_irqrestore(&msg_q->mq_lock);
 }
 
@@ -348,11 +397,59 @@ void scheduler_core_msg_free(struct scheduler_msg *msg)
 	qdf_atomic_dec(&__sched_queue_depth);
 }
 
+/**
+ * scheduler_thread_process_batch() - process messages of a queue in a row
+ * @sch_ctx: scheduler context
+ * @qidx: index of the queue
+ * @msg: first message, already taken from the queue
+ *
+ * Processes up to batch_budget messages of the queue before the caller
+ * looks at the higher priority queues again, so that a burst on a queue does
+ * not pay a rescan of all the queues per message. The watchdog is armed once
+ * for the whole batch, the message it reports is the one being processed.
+ *
+ * Return: none
+ */
+static void scheduler_thread_process_batch(struct scheduler_ctx *sch_ctx,
+					   int qidx, struct scheduler_msg *msg)
+{
+	struct scheduler_mq_type *msg_q = &sch_ctx->queue_ctx.sch_msg_q[qidx];
+	uint32_t budget = sch_ctx->batch_budget ? sch_ctx->batch_budget : 1;
+	uint64_t now_us;
+	QDF_STATUS status;
+
+	msg_q->stats.batches++;
+	qdf_timer_start(&sch_ctx->watchdog_timer, sch_ctx->timeout);
+
+	do {
+		sch_ctx->watchdog_msg_type = msg->type;
+		sch_ctx->watchdog_callback = msg->callback;
+
+		now_us = qdf_get_log_timestamp_usecs();
+		scheduler_mq_stats_dispatch(msg_q, msg, now_us);
+		sched_history_start(msg, now_us);
+		status = sch_ctx->queue_ctx.scheduler_msg_process_fn[qidx](msg);
+		sched_history_stop();
+
+		if (QDF_IS_STATUS_ERROR(status))
+			sched_err("Failed processing Qid[%d] message",
+				  msg_q->qid);
+
+		scheduler_core_msg_free(msg);
+
+		if (!--budget ||
+		    qdf_atomic_test_bit(MC_SHUTDOWN_EVENT_MASK,
+					&sch_ctx->sch_event_flag))
+			break;
+	} while ((msg = scheduler_mq_get(msg_q)));
+
+	qdf_timer_stop(&sch_ctx->watchdog_timer);
+}
+
 static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 					    bool *shutdown)
 {
 	int i;
-	QDF_STATUS status;
 	struct scheduler_msg *msg;
 
 	if (!sch_ctx) {
@@ -387,24 +484,8 @@ static void scheduler_thread_process_queues(struct scheduler_ctx *sch_ctx,
 			continue;
 		}
 
-		if (sch_ctx->queue_ctx.scheduler_msg_process_fn[i]) {
-			sch_ctx->watchdog_msg_type = msg->type;
-			sch_ctx->watchdog_callback = msg->callback;
-
-			sched_history_start(msg);
-			qdf_timer_start(&sch_ctx->watchdog_timer,
-					sch_ctx->timeout);
-			status = sch_ctx->queue_ctx.
-					scheduler_msg_process_fn[i](msg);
-			qdf_timer_stop(&sch_ctx->watchdog_timer);
-			sched_history_stop();
-
-			if (QDF_IS_STATUS_ERROR(status))
-				sched_err("Failed processing Qid[%d] message",
-					  sch_ctx->queue_ctx.sch_msg_q[i].qid);
-
-			scheduler_core_msg_free(msg);
-		}
+		if (sch_ctx->queue_ctx.scheduler_msg_process_fn[i])
+			scheduler_thread_process_batch(sch_ctx, i, msg);
 
 		/* start again with highest priority queue at index 0 */
 		i = 0;
@@ -502,3 +583,98 @@ void scheduler_queues_flush(struct scheduler_ctx *sched_ctx)
 	}
 }
 
+#define SCHEDULER_DEBUGFS_DIR "scheduler"
+#define SCHEDULER_DEBUGFS_STATS "queue_stats"
+#define SCHEDULER_DEBUGFS_PERM (QDF_FILE_USR_READ | QDF_FILE_USR_WRITE | \
+				QDF_FILE_GRP_READ | QDF_FILE_OTH_READ)
+
+static QDF_STATUS scheduler_debugfs_stats_show(qdf_debugfs_file_t file,
+					       void *arg)
+{
+	struct scheduler_ctx *sched_ctx = arg;
+	struct scheduler_mq_type *mq;
+	struct scheduler_mq_stats *stats;
+	uint32_t depth;
+	int i, j;
+
+	qdf_debugfs_printf(file, "batch budget: %u\n", sched_ctx->batch_budget);
+
+	for (i = 0; i < SCHEDULER_NUMBER_OF_MSG_QUEUE; i++) {
+		mq = &sched_ctx->queue_ctx.sch_msg_q[i];
+		stats = &mq->stats;
+
+		qdf_spin_lock_irqsave(&mq->mq_lock);
+		depth = qdf_list_size(&mq->mq_list);
+		qdf_spin_unlock_irqrestore(&mq->mq_lock);
+
+		qdf_debugfs_printf(file,
+				   "\nqueue %d qid %d: depth %u max depth %u\n",
+				   i, mq->qid, depth, stats->max_depth);
+		qdf_debugfs_printf(file, "enqueued %llu dispatched %llu",
+				   stats->enqueued, stats->dispatched);
+		qdf_debugfs_printf(file, " batches %llu\n", stats->batches);
+		qdf_debugfs_printf(file, "latency avg %llu us max %u us\n",
+				   stats->dispatched ?
+				   stats->total_latency_us / stats->dispatched :
+				   0, stats->max_latency_us);
+
+		for (j = 0; j < SCHEDULER_LATENCY_BUCKETS - 1; j++)
+			qdf_debugfs_printf(file, "  < %u us: %u\n",
+					   1 << (SCHEDULER_LATENCY_SHIFT +
+						 2 * j),
+					   stats->latency_hist[j]);
+		qdf_debugfs_printf(file, "  >= %u us: %u\n",
+				   1 << (SCHEDULER_LATENCY_SHIFT + 2 * j - 2),
+				   stats->latency_hist[j]);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static QDF_STATUS scheduler_debugfs_stats_write(void *priv, const char *buf,
+						qdf_size_t len)
+{
+	struct scheduler_ctx *sched_ctx = priv;
+	struct scheduler_mq_type *mq;
+	int i;
+
+	for (i = 0; i < SCHEDULER_NUMBER_OF_MSG_QUEUE; i++) {
+		mq = &sched_ctx->queue_ctx.sch_msg_q[i];
+		qdf_spin_lock_irqsave(&mq->mq_lock);
+		qdf_mem_zero(&mq->stats, sizeof(mq->stats));
+		qdf_spin_unlock_irqrestore(&mq->mq_lock);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static struct qdf_debugfs_fops scheduler_debugfs_stats_fops = {
+	.show = scheduler_debugfs_stats_show,
+	.write = scheduler_debugfs_stats_write,
+};
+
+void scheduler_debugfs_init(struct scheduler_ctx *sched_ctx)
+{
+	sched_ctx->debugfs_dir = qdf_debugfs_create_dir(SCHEDULER_DEBUGFS_DIR,
+							NULL);
+	if (!sched_ctx->debugfs_dir) {
+		sched_debug("scheduler debugfs not available");
+		return;
+	}
+
+	scheduler_debugfs_stats_fops.priv = sched_ctx;
+	if (!qdf_debugfs_create_file(SCHEDULER_DEBUGFS_STATS,
+				     SCHEDULER_DEBUGFS_PERM,
+				     sched_ctx->debugfs_dir,
+				     &scheduler_debugfs_stats_fops)) {
+		sched_err("Failed to create scheduler queue stats file");
+		qdf_debugfs_remove_dir(sched_ctx->debugfs_dir);
+		sched_ctx->debugfs_dir = NULL;
+	}
+}
+
+void scheduler_debugfs_deinit(struct scheduler_ctx *sched_ctx)
+{
+	qdf_debugfs_remove_dir_recursive(sched_ctx->debugfs_dir);
+	sched_ctx->debugfs_dir = NULL;
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Host build stand-in for the qdf headers used by scheduler_core.c, see
+ * ../sched_replay.c. The replay is single threaded: locks, events and wait
+ * queues do nothing, and the watchdog timer only counts its operations.
+ */
+
+#ifndef __SCHED_REPLAY_QDF_TYPES_H
+#define __SCHED_REPLAY_QDF_TYPES_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef int QDF_STATUS;
+#define QDF_STATUS_SUCCESS 0
+#define QDF_STATUS_E_FAILURE 1
+#define QDF_STATUS_E_INVAL 2
+#define QDF_STATUS_E_EMPTY 3
+#define QDF_IS_STATUS_ERROR(status) ((status) != QDF_STATUS_SUCCESS)
+
+typedef int QDF_MODULE_ID;
+#define QDF_MODULE_ID_SCHEDULER 0
+#define QDF_MODULE_ID_MAX 64
+
+typedef size_t qdf_size_t;
+
+#define QDF_BUG(cond) do { if (!(cond)) abort(); } while (0)
+#define QDF_DEBUG_PANIC(fmt, ...) abort()
+
+#define QDF_TRACE_FATAL(mod, fmt, ...) fprintf(stderr, fmt "\n", ##__VA_ARGS__)
+#define QDF_TRACE_ERROR(mod, fmt, ...) fprintf(stderr, fmt "\n", ##__VA_ARGS__)
+#define QDF_TRACE_WARN(mod, fmt, ...)
+#define QDF_TRACE_INFO(mod, fmt, ...)
+#define QDF_TRACE_DEBUG(mod, fmt, ...)
+#define QDF_TRACE_FATAL_NO_FL QDF_TRACE_FATAL
+#define QDF_TRACE_ERROR_NO_FL QDF_TRACE_ERROR
+#define QDF_TRACE_WARN_NO_FL QDF_TRACE_WARN
+#define QDF_TRACE_INFO_NO_FL QDF_TRACE_INFO
+#define QDF_TRACE_DEBUG_NO_FL QDF_TRACE_DEBUG
+
+#define qdf_container_of(ptr, type, field) \
+	((type *)((char *)(ptr) - offsetof(type, field)))
+
+#define qdf_mem_copy(dst, src, len) memcpy(dst, src, len)
+#define qdf_mem_zero(ptr, len) memset(ptr, 0, len)
+#define qdf_mem_malloc(len) calloc(1, len)
+#define qdf_mem_free(ptr) free(ptr)
+
+static inline uint64_t qdf_get_log_timestamp_usecs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* locks and events */
+typedef int qdf_spinlock_t;
+#define qdf_spinlock_create(lock) (void)(lock)
+#define qdf_spinlock_destroy(lock) (void)(lock)
+#define qdf_spin_lock(lock) (void)(lock)
+#define qdf_spin_unlock(lock) (void)(lock)
+#define qdf_spin_lock_irqsave(lock) (void)(lock)
+#define qdf_spin_unlock_irqrestore(lock) (void)(lock)
+
+typedef int qdf_event_t;
+#define qdf_event_set(event) (void)(event)
+#define qdf_event_reset(event) (void)(event)
+#define qdf_wait_single_event(event, timeout) QDF_STATUS_SUCCESS
+
+typedef int qdf_wait_queue_head_t;
+#define qdf_wait_queue_interruptible(wq, cond) 0
+#define ERESTARTSYS 512
+
+typedef void qdf_thread_t;
+struct sched_replay_task {
+	int pid;
+	char comm[16];
+};
+
+static struct sched_replay_task sched_replay_current = { 1, "replay" };
+#define current (&sched_replay_current)
+#define qdf_set_user_nice(task, nice) (void)(task)
+
+/* atomics and bit operations */
+typedef struct {
+	long counter;
+} qdf_atomic_t;
+
+static inline void qdf_atomic_set(qdf_atomic_t *v, long i)
+{
+	v->counter = i;
+}
+
+static inline long qdf_atomic_inc_return(qdf_atomic_t *v)
+{
+	return ++v->counter;
+}
+
+static inline void qdf_atomic_dec(qdf_atomic_t *v)
+{
+	v->counter--;
+}
+
+static inline bool qdf_atomic_test_bit(int nr, unsigned long *addr)
+{
+	return *addr & (1UL << nr);
+}
+
+static inline bool qdf_atomic_test_and_clear_bit(int nr, unsigned long *addr)
+{
+	bool set = qdf_atomic_test_bit(nr, addr);
+
+	*addr &= ~(1UL << nr);
+	return set;
+}
+
+static inline void qdf_atomic_clear_bit(int nr, unsigned long *addr)
+{
+	*addr &= ~(1UL << nr);
+}
+
+/* watchdog timer, counting the operations done on it */
+typedef struct {
+	uint64_t ops;
+} qdf_timer_t;
+
+#define qdf_timer_start(timer, msec) ((timer)->ops++)
+#define qdf_timer_stop(timer) ((timer)->ops++)
+
+typedef struct qdf_mc_timer qdf_mc_timer_t;
+typedef void (*qdf_mc_timer_callback_t)(void *data);
+
+/* message list */
+typedef struct qdf_list_node {
+	struct qdf_list_node *next;
+	struct qdf_list_node *prev;
+} qdf_list_node_t;
+
+typedef struct {
+	qdf_list_node_t anchor;
+	uint32_t count;
+} qdf_list_t;
+
+static inline void qdf_list_create(qdf_list_t *list, uint32_t max_size)
+{
+	list->anchor.next = &list->anchor;
+	list->anchor.prev = &list->anchor;
+	list->count = 0;
+}
+
+static inline void qdf_list_destroy(qdf_list_t *list)
+{
+}
+
+static inline uint32_t qdf_list_size(qdf_list_t *list)
+{
+	return list->count;
+}
+
+static inline void qdf_list_link(qdf_list_node_t *prev, qdf_list_node_t *node,
+				 qdf_list_node_t *next)
+{
+	node->prev = prev;
+	node->next = next;
+	prev->next = node;
+	next->prev = node;
+}
+
+static inline QDF_STATUS qdf_list_insert_back(qdf_list_t *list,
+					      qdf_list_node_t *node)
+{
+	qdf_list_link(list->anchor.prev, node, &list->anchor);
+	list->count++;
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline QDF_STATUS qdf_list_insert_front(qdf_list_t *list,
+					       qdf_list_node_t *node)
+{
+	qdf_list_link(&list->anchor, node, list->anchor.next);
+	list->count++;
+	return QDF_STATUS_SUCCESS;
+}
+
+static inline QDF_STATUS qdf_list_remove_front(qdf_list_t *list,
+					       qdf_list_node_t **node)
+{
+	if (!list->count)
+		return QDF_STATUS_E_EMPTY;
+
+	*node = list->anchor.next;
+	(*node)->next->prev = &list->anchor;
+	list->anchor.next = (*node)->next;
+	list->count--;
+	return QDF_STATUS_SUCCESS;
+}
+
+/* message pool */
+struct qdf_flex_mem_pool {
+	size_t item_size;
+};
+
+#define DEFINE_QDF_FLEX_MEM_POOL(name, size, limit) \
+	struct qdf_flex_mem_pool name = { size }
+
+#define qdf_flex_mem_init(pool) (void)(pool)
+#define qdf_flex_mem_deinit(pool) (void)(pool)
+#define qdf_flex_mem_alloc(pool) malloc((pool)->item_size)
+#define qdf_flex_mem_free(pool, ptr) free(ptr)
+
+/* debugfs, the replay calls the show callback on stdout itself */
+typedef void *qdf_dentry_t;
+typedef FILE *qdf_debugfs_file_t;
+
+#define QDF_FILE_USR_READ 00400
+#define QDF_FILE_USR_WRITE 00200
+#define QDF_FILE_GRP_READ 00040
+#define QDF_FILE_OTH_READ 00004
+
+struct qdf_debugfs_fops {
+	QDF_STATUS(*show)(qdf_debugfs_file_t file, void *arg);
+	QDF_STATUS(*write)(void *priv, const char *buf, qdf_size_t len);
+	void *priv;
+};
+
+static inline void qdf_debugfs_printf(qdf_debugfs_file_t file,
+				      const char *fmt, ...)
+{
+	va_list args;
+
+	va_start(args, fmt);
+	vfprintf(file, fmt, args);
+	va_end(args);
+}
+
+#define qdf_debugfs_create_dir(name, parent) NULL
+#define qdf_debugfs_create_file(name, mode, parent, fops) NULL
+#define qdf_debugfs_remove_dir(dentry) (void)(dentry)
+#define qdf_debugfs_remove_dir_recursive(dentry) (void)(dentry)
+
+#endif /* __SCHED_REPLAY_QDF_TYPES_H */
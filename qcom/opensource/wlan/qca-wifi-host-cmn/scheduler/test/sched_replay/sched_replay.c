@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * sched_replay - host replay of a synthetic message mix through the
+ * scheduler thread
+ *
+ * Posts bursts of messages to the six scheduler queues, the way a scan or
+ * roam storm does, and drains them with scheduler_thread_process_queues()
+ * from scheduler_core.c, built as is. Some messages post follow up
+ * messages to a higher priority queue from their callback, as timer and
+ * target_if work does. Each run checks that every message is processed
+ * once and in order within its queue, and reports the cost per message,
+ * the watchdog timer operations per message, the longest priority
+ * inversion (lower priority messages processed while a higher priority one
+ * was waiting) and the queue statistics shown in debugfs.
+ *
+ * The mix is replayed with a batch budget of 1, the one message per
+ * priority rescan behavior, and with the budget given by -b. See the
+ * Makefile for the build.
+ *
+ * Usage: sched_replay [-n messages] [-B burst] [-b budget] [-f followup%]
+ *                     [-w work] [-s seed]
+ */
+
+#include <unistd.h>
+#include "scheduler_core.c"
+
+#define REPLAY_NUM_QUEUES SCHEDULER_NUMBER_OF_MSG_QUEUE
+
+/**
+ * struct replay_queue - synthetic traffic of a scheduler queue
+ * @name: name of the queue in the reports
+ * @weight: share of the posted messages, in percent
+ */
+struct replay_queue {
+	const char *name;
+	uint32_t weight;
+};
+
+/* in priority order, as the queues are registered by the driver */
+static const struct replay_queue replay_queues[REPLAY_NUM_QUEUES] = {
+	{ "timer", 10 },
+	{ "target_if", 35 },
+	{ "os_if", 5 },
+	{ "scan", 35 },
+	{ "mlme", 10 },
+	{ "sys", 5 },
+};
+
+/**
+ * struct replay_state - state of a replay run
+ * @work: busy loop iterations per message callback
+ * @followup_pct: percentage of messages posting a higher priority message
+ * @posted: messages posted per queue
+ * @processed: messages processed per queue
+ * @waiting_since: processed count when the oldest message still waiting in
+ *	each queue was posted, UINT64_MAX if the queue is empty
+ * @total_processed: messages processed in all the queues
+ * @max_inversion: longest run of lower priority messages processed while
+ *	a higher priority one was waiting
+ * @order_errors: messages processed out of order within their queue
+ * @post_errors: messages that could not be posted
+ * @seed: state of the random generator
+ */
+struct replay_state {
+	uint32_t work;
+	uint32_t followup_pct;
+	uint64_t posted[REPLAY_NUM_QUEUES];
+	uint64_t processed[REPLAY_NUM_QUEUES];
+	uint64_t waiting_since[REPLAY_NUM_QUEUES];
+	uint64_t total_processed;
+	uint64_t max_inversion;
+	uint64_t order_errors;
+	uint64_t post_errors;
+	uint32_t seed;
+};
+
+static struct replay_state replay;
+
+static uint32_t replay_rand(void)
+{
+	replay.seed = replay.seed * 1103515245 + 12345;
+	return replay.seed >> 8;
+}
+
+static int replay_pick_queue(void)
+{
+	uint32_t r = replay_rand() % 100;
+	int i;
+
+	for (i = 0; i < REPLAY_NUM_QUEUES - 1; i++) {
+		if (r < replay_queues[i].weight)
+			break;
+		r -= replay_queues[i].weight;
+	}
+
+	return i;
+}
+
+static void replay_post(struct scheduler_ctx *ctx, int qidx)
+{
+	struct scheduler_msg msg = {0};
+	struct scheduler_msg *queue_msg;
+
+	msg.type = qidx;
+	msg.bodyval = replay.posted[qidx];
+
+	queue_msg = scheduler_core_msg_dup(&msg);
+	if (!queue_msg) {
+		replay.post_errors++;
+		return;
+	}
+
+	if (!qdf_list_size(&ctx->queue_ctx.sch_msg_q[qidx].mq_list))
+		replay.waiting_since[qidx] = replay.total_processed;
+	replay.posted[qidx]++;
+	scheduler_mq_put(&ctx->queue_ctx.sch_msg_q[qidx], queue_msg);
+}
+
+static QDF_STATUS replay_process(struct scheduler_msg *msg)
+{
+	struct scheduler_ctx *ctx = scheduler_get_context();
+	int qidx = msg->type;
+	volatile uint32_t sink = 0;
+	uint32_t i;
+	int j;
+
+	if (msg->bodyval != (uint32_t)replay.processed[qidx])
+		replay.order_errors++;
+	replay.processed[qidx]++;
+
+	for (j = 0; j < qidx; j++) {
+		if (replay.waiting_since[j] == UINT64_MAX)
+			continue;
+		if (replay.total_processed - replay.waiting_since[j] >
+		    replay.max_inversion)
+			replay.max_inversion = replay.total_processed -
+					       replay.waiting_since[j];
+	}
+
+	replay.total_processed++;
+	if (!qdf_list_size(&ctx->queue_ctx.sch_msg_q[qidx].mq_list))
+		replay.waiting_since[qidx] = UINT64_MAX;
+	else
+		replay.waiting_since[qidx] = replay.total_processed;
+
+	for (i = 0; i < replay.work; i++)
+		sink += i;
+
+	if (qidx && replay_rand() % 100 < replay.followup_pct)
+		replay_post(ctx, replay_rand() % qidx);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static uint64_t replay_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int replay_run(uint32_t budget, uint32_t num_msgs, uint32_t burst,
+		      uint32_t seed)
+{
+	struct scheduler_ctx *ctx;
+	uint64_t start_ns, run_ns, posted = 0, processed = 0;
+	uint32_t sent = 0, n;
+	bool shutdown = false;
+	int i;
+
+	memset(&replay.posted, 0, sizeof(replay.posted));
+	memset(&replay.processed, 0, sizeof(replay.processed));
+	for (i = 0; i < REPLAY_NUM_QUEUES; i++)
+		replay.waiting_since[i] = UINT64_MAX;
+	replay.total_processed = 0;
+	replay.max_inversion = 0;
+	replay.order_errors = 0;
+	replay.post_errors = 0;
+	replay.seed = seed;
+
+	scheduler_create_ctx();
+	ctx = scheduler_get_context();
+	memset(ctx, 0, sizeof(*ctx));
+	if (QDF_IS_STATUS_ERROR(scheduler_queues_init(ctx)))
+		return 1;
+
+	for (i = 0; i < REPLAY_NUM_QUEUES; i++) {
+		ctx->queue_ctx.sch_msg_q[i].qid = i;
+		ctx->queue_ctx.scheduler_msg_process_fn[i] = replay_process;
+	}
+	ctx->batch_budget = budget;
+	ctx->timeout = SCHEDULER_WATCHDOG_TIMEOUT;
+
+	start_ns = replay_now_ns();
+	while (sent < num_msgs) {
+		/* a burst is posted before the thread gets to run */
+		for (n = 0; n < burst && sent < num_msgs; n++, sent++)
+			replay_post(ctx, replay_pick_queue());
+		scheduler_thread_process_queues(ctx, &shutdown);
+	}
+	run_ns = replay_now_ns() - start_ns;
+
+	for (i = 0; i < REPLAY_NUM_QUEUES; i++) {
+		posted += replay.posted[i];
+		processed += replay.processed[i];
+	}
+
+	printf("budget %u: %llu msgs, %llu ns/msg, %.2f timer ops/msg, max inversion %llu\n",
+	       budget, (unsigned long long)processed,
+	       (unsigned long long)(processed ? run_ns / processed : 0),
+	       processed ? (double)ctx->watchdog_timer.ops / processed : 0,
+	       (unsigned long long)replay.max_inversion);
+	scheduler_debugfs_stats_show(stdout, ctx);
+	printf("\n");
+
+	scheduler_queues_deinit(ctx);
+	scheduler_destroy_ctx();
+
+	if (posted != processed || replay.order_errors ||
+	    replay.post_errors) {
+		fprintf(stderr,
+			"budget %u: posted %llu processed %llu, %llu out of order, %llu post failures\n",
+			budget, (unsigned long long)posted,
+			(unsigned long long)processed,
+			(unsigned long long)replay.order_errors,
+			(unsigned long long)replay.post_errors);
+		return 1;
+	}
+
+	if (budget > 1 && replay.max_inversion >= budget * REPLAY_NUM_QUEUES) {
+		fprintf(stderr, "budget %u: priority inversion of %llu\n",
+			budget, (unsigned long long)replay.max_inversion);
+		return 1;
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t num_msgs = 200000, burst = 256, budget = SCHEDULER_BATCH_BUDGET;
+	uint32_t seed = 1;
+	int opt, ret;
+
+	replay.work = 200;
+	replay.followup_pct = 10;
+
+	while ((opt = getopt(argc, argv, "n:B:b:f:w:s:")) != -1) {
+		switch (opt) {
+		case 'n':
+			num_msgs = strtoul(optarg, NULL, 0);
+			break;
+		case 'B':
+			burst = strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			budget = strtoul(optarg, NULL, 0);
+			break;
+		case 'f':
+			replay.followup_pct = strtoul(optarg, NULL, 0);
+			break;
+		case 'w':
+			replay.work = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr,
+				"usage: %s [-n messages] [-B burst] [-b budget] [-f followup%%] [-w work] [-s seed]\n",
+				argv[0]);
+			return 2;
+		}
+	}
+
+	if (!burst || burst > SCHEDULER_CORE_MAX_MESSAGES / 2) {
+		fprintf(stderr, "burst must be 1 to %d\n",
+			SCHEDULER_CORE_MAX_MESSAGES / 2);
+		return 2;
+	}
+
+	ret = replay_run(1, num_msgs, burst, seed);
+	ret |= replay_run(budget, num_msgs, burst, seed);
+
+	return ret;
+}
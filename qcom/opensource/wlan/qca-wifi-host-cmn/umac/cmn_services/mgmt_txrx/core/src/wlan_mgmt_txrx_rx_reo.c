@@ -110,27 +110,6 @@ mgmt_rx_reo_subtract_pkt_ctrs(uint16_t ctr1, uint16_t ctr2)
 	return delta;
 }
 
-#define MGMT_RX_REO_GLOBAL_TS_HALF_RANGE (0x80000000)
-/**
- * mgmt_rx_reo_compare_global_timestamps_gte()-Compare given global timestamps
- * @ts1: Global timestamp1
- * @ts2: Global timestamp2
- *
- * We can't directly use the comparison operator here because the timestamps can
- * overflow. But these timestamps have a property that the difference between
- * them can never be greater than half the range of the data type.
- * We can make use of this condition to detect which one is actually greater.
- *
- * Return: true if @ts1 is greater than or equal to @ts2, else false
- */
-static inline bool
-mgmt_rx_reo_compare_global_timestamps_gte(uint32_t ts1, uint32_t ts2)
-{
-	uint32_t delta = ts1 - ts2;
-
-	return delta <= MGMT_RX_REO_GLOBAL_TS_HALF_RANGE;
-}
-
 #ifdef WLAN_MGMT_RX_REO_ERROR_HANDLING
 /**
  * handle_snapshot_sanity_failures() - Handle snapshot sanity failure
@@ -1794,6 +1773,31 @@ struct mgmt_rx_reo_list_entry_debug_info {
 	struct mgmt_rx_reo_list_entry *entry;
 };
 
+/**
+ * mgmt_rx_reo_list_resolve() - Make the wait counts and the status of the
+ * entries in the reorder list up to date
+ * @reo_list: Pointer to reorder list
+ *
+ * Wait count updates of the ingress list entries are queued in the ingress
+ * list index, push them to all the entries. This walks the whole list and
+ * has to be called with the list lock held.
+ *
+ * Return: void
+ */
+static void
+mgmt_rx_reo_list_resolve(struct mgmt_rx_reo_list *reo_list)
+{
+	struct mgmt_rx_reo_list_entry *cur_entry;
+
+	mgmt_rx_reo_index_resolve(&reo_list->index);
+
+	qdf_list_for_each(&reo_list->list, cur_entry, node) {
+		if (cur_entry->wait_count.total_count == 0)
+			cur_entry->status &=
+				~STATUS_WAIT_FOR_FRAME_ON_OTHER_LINKS;
+	}
+}
+
 /**
  * mgmt_rx_reo_list_display() - API to print the entries in the reorder list
  * @reo_list: Pointer to reorder list
@@ -1831,6 +1835,8 @@ mgmt_rx_reo_list_display(struct mgmt_rx_reo_list *reo_list)
 		return QDF_STATUS_E_NOMEM;
 	}
 
+	mgmt_rx_reo_list_resolve(reo_list);
+
 	index = 0;
 	qdf_list_for_each(&reo_list->list, cur_entry, node) {
 		debug_info[index].link_id =
@@ -3216,13 +3222,14 @@ mgmt_rx_reo_check_sanity_list(struct mgmt_rx_reo_list *reo_list)
  * Check the sanity of ingress reorder list and egress reorder list.
  * This API does the following sanity checks.
  *
- * 1. Ingress list entries should be in the non decreasing order of global
- *    time stamp.
- * 2. Egress list entries should be in the non decreasing order of global
+ * 1. Egress list entries should be in the non decreasing order of global
  *    time stamp.
- * 3. All the entries in egress list should have global time stamp less
+ * 2. All the entries in egress list should have global time stamp less
  *    than or equal to all the entries in ingress list.
  *
+ * Ingress list entries are kept in the non decreasing order of global time
+ * stamp by the ingress list index, so the ingress list is not walked here.
+ *
  * Return: QDF_STATUS
  */
 static QDF_STATUS
@@ -3251,12 +3258,6 @@ mgmt_rx_reo_check_sanity_lists(struct mgmt_rx_reo_list *reo_egress_list,
 		return status;
 	}
 
-	status = mgmt_rx_reo_check_sanity_list(reo_ingress_list);
-	if (QDF_IS_STATUS_ERROR(status)) {
-		mgmt_rx_reo_err("Sanity check of ingress list failed");
-		return status;
-	}
-
 	if (qdf_list_empty(&reo_egress_list->list) ||
 	    qdf_list_empty(&reo_ingress_list->list))
 		return QDF_STATUS_SUCCESS;
@@ -3375,6 +3376,24 @@ mgmt_rx_reo_move_entries_ingress_to_egress_list
 				ingress_list_cur_size - ingress_list_max_size;
 
 	qdf_list_for_each(&reo_ingress_list->list, ingress_list_entry, node) {
+		struct mgmt_rx_reo_index_node *node;
+
+		/*
+		 * Resolves the pending wait count updates of the entry. The
+		 * entries stay in the index until they leave the list.
+		 */
+		node = mgmt_rx_reo_index_nth(&reo_ingress_list->index,
+					     num_frames_ready_to_deliver);
+		if (node != &ingress_list_entry->index_node) {
+			mgmt_rx_reo_err("Ingress list and index out of sync");
+			status = QDF_STATUS_E_INVAL;
+			goto exit_unlock_ingress_list;
+		}
+
+		if (ingress_list_entry->wait_count.total_count == 0)
+			ingress_list_entry->status &=
+					~STATUS_WAIT_FOR_FRAME_ON_OTHER_LINKS;
+
 		if (num_overflow_frames > 0) {
 			ingress_list_entry->status |=
 						STATUS_INGRESS_LIST_OVERFLOW;
@@ -3421,6 +3440,9 @@ mgmt_rx_reo_move_entries_ingress_to_egress_list
 			goto exit_unlock_ingress_list;
 		}
 
+		mgmt_rx_reo_index_remove_first_n(&reo_ingress_list->index,
+						 num_frames_ready_to_deliver);
+
 		qdf_spin_lock_bh(&reo_egress_list->list_lock);
 
 		status = qdf_list_join(&reo_egress_list->list,
@@ -3777,6 +3799,12 @@ mgmt_rx_reo_update_wait_count(
  *      all the frames in the reorder list with global time stamp > current
  *      frame's global time stamp.
  *
+ * The updates a) and c) are done through the ingress list index, which
+ * queues them on its subtrees instead of walking the list. The wait count
+ * of an ingress list entry, and its STATUS_WAIT_FOR_FRAME_ON_OTHER_LINKS
+ * flag, are hence only up to date once the index has resolved the entry,
+ * see mgmt_rx_reo_index_first() and mgmt_rx_reo_list_resolve().
+ *
  * Return: QDF_STATUS
  */
 static QDF_STATUS
@@ -3786,11 +3814,13 @@ mgmt_rx_reo_update_ingress_list(struct mgmt_rx_reo_ingress_list *ingress_list,
 				bool *is_queued)
 {
 	struct mgmt_rx_reo_list *reo_ingress_list;
-	struct mgmt_rx_reo_list_entry *cur;
+	struct mgmt_rx_reo_index *index;
+	struct mgmt_rx_reo_index_node *least_greater_node;
+	struct mgmt_rx_reo_index_node *new_node = NULL;
 	struct mgmt_rx_reo_list_entry *least_greater = NULL;
-	bool least_greater_entry_found = false;
 	QDF_STATUS status;
-	uint16_t list_insertion_pos = 0;
+	uint32_t num_older;
+	uint32_t num_older_non_parallel_rx;
 	uint32_t ts_new;
 
 	if (!ingress_list) {
@@ -3798,6 +3828,7 @@ mgmt_rx_reo_update_ingress_list(struct mgmt_rx_reo_ingress_list *ingress_list,
 		return QDF_STATUS_E_NULL_VALUE;
 	}
 	reo_ingress_list = &ingress_list->reo_list;
+	index = &reo_ingress_list->index;
 
 	if (!frame_desc) {
 		mgmt_rx_reo_err("Mgmt frame descriptor is null");
@@ -3832,43 +3863,32 @@ mgmt_rx_reo_update_ingress_list(struct mgmt_rx_reo_ingress_list *ingress_list,
 	frame_desc->ingress_list_size_rx =
 				qdf_list_size(&reo_ingress_list->list);
 
-	qdf_list_for_each(&reo_ingress_list->list, cur, node) {
-		uint32_t ts_cur;
-
-		ts_cur = mgmt_rx_reo_get_global_ts(cur->rx_params);
-
-		least_greater_entry_found =
-		     !mgmt_rx_reo_compare_global_timestamps_gte(ts_new, ts_cur);
-		if (least_greater_entry_found) {
-			least_greater = cur;
-			break;
-		}
-
-		qdf_assert_always(!frame_desc->is_stale || cur->is_parallel_rx);
-
-		list_insertion_pos++;
+	least_greater_node =
+		mgmt_rx_reo_index_begin_update(index, ts_new,
+					       &frame_desc->wait_count,
+					       &num_older,
+					       &num_older_non_parallel_rx);
+	if (least_greater_node)
+		least_greater = qdf_container_of(least_greater_node,
+						 struct mgmt_rx_reo_list_entry,
+						 index_node);
 
-		status = mgmt_rx_reo_update_wait_count(&cur->wait_count,
-						       &frame_desc->wait_count);
-		if (QDF_IS_STATUS_ERROR(status))
-			return status;
+	qdf_assert_always(!frame_desc->is_stale || !num_older_non_parallel_rx);
 
-		if (cur->wait_count.total_count == 0)
-			cur->status &= ~STATUS_WAIT_FOR_FRAME_ON_OTHER_LINKS;
-	}
+	status = QDF_STATUS_SUCCESS;
 
 	if (frame_desc->type == MGMT_RX_REO_FRAME_DESC_HOST_CONSUMED_FRAME &&
 	    !frame_desc->is_stale && frame_desc->reo_required &&
 	    (frame_desc->queued_list != MGMT_RX_REO_LIST_TYPE_EGRESS)) {
 		bool overflow;
 
-		if (least_greater_entry_found) {
+		if (least_greater) {
 			status = mgmt_rx_reo_update_wait_count(
 					&new->wait_count,
 					&least_greater->wait_count);
 
 			if (QDF_IS_STATUS_ERROR(status))
-				return status;
+				goto end_index_update;
 
 			frame_desc->wait_count = new->wait_count;
 
@@ -3880,9 +3900,9 @@ mgmt_rx_reo_update_ingress_list(struct mgmt_rx_reo_ingress_list *ingress_list,
 		new->ingress_list_insertion_ts = qdf_get_log_timestamp();
 		new->ingress_timestamp = frame_desc->ingress_timestamp;
 		new->is_parallel_rx = frame_desc->is_parallel_rx;
-		frame_desc->ingress_list_insertion_pos = list_insertion_pos;
+		frame_desc->ingress_list_insertion_pos = num_older;
 
-		if (least_greater_entry_found)
+		if (least_greater)
 			status = qdf_list_insert_before(
 					&reo_ingress_list->list, &new->node,
 					&least_greater->node);
@@ -3891,7 +3911,12 @@ mgmt_rx_reo_update_ingress_list(struct mgmt_rx_reo_ingress_list *ingress_list,
 					&reo_ingress_list->list, &new->node);
 
 		if (QDF_IS_STATUS_ERROR(status))
-			return status;
+			goto end_index_update;
+
+		mgmt_rx_reo_index_node_init(index, &new->index_node,
+					    &new->wait_count, ts_new,
+					    new->is_parallel_rx);
+		new_node = &new->index_node;
 
 		*is_queued = true;
 		frame_desc->queued_list = MGMT_RX_REO_LIST_TYPE_INGRESS;
@@ -3912,66 +3937,34 @@ mgmt_rx_reo_update_ingress_list(struct mgmt_rx_reo_ingress_list *ingress_list,
 		if (new->wait_count.total_count == 0)
 			frame_desc->zero_wait_count_rx = true;
 
-		if (frame_desc->zero_wait_count_rx &&
-		    qdf_list_first_entry_or_null(&reo_ingress_list->list,
-						 struct mgmt_rx_reo_list_entry,
-						 node) == new)
+		if (frame_desc->zero_wait_count_rx && !num_older)
 			frame_desc->immediate_delivery = true;
 	}
 
-	if (least_greater_entry_found) {
-		cur = least_greater;
-
-		qdf_list_for_each_from(&reo_ingress_list->list, cur, node) {
-			uint8_t frame_link_id;
-			struct mgmt_rx_reo_wait_count *wait_count;
-
-			/**
-			 * In some cases, the current frame and its associated
-			 * rx_params/reo_params may get freed immediately after
-			 * the frame is queued to egress list. Hence fetching
-			 * the link ID from
-			 * "frame_desc->rx_params->reo_params" could lead to
-			 * use after free. Store a copy of "reo_params" in the
-			 * frame descriptor and access the copy after the frame
-			 * is queued to egress list.
-			 *
-			 * TODO:- Fix this cleanly using refcount mechanism or
-			 * structure duplication.
-			 */
-			frame_link_id = frame_desc->reo_params_copy.link_id;
-			wait_count = &cur->wait_count;
-			if (wait_count->per_link_count[frame_link_id]) {
-				uint32_t old_wait_count;
-				uint32_t new_wait_count;
-				uint32_t wait_count_diff;
-				uint16_t pkt_ctr_delta;
-
-				pkt_ctr_delta = frame_desc->pkt_ctr_delta;
-				old_wait_count =
-				      wait_count->per_link_count[frame_link_id];
-
-				if (old_wait_count >= pkt_ctr_delta)
-					new_wait_count = old_wait_count -
-							 pkt_ctr_delta;
-				else
-					new_wait_count = 0;
-
-				wait_count_diff = old_wait_count -
-						  new_wait_count;
-
-				wait_count->per_link_count[frame_link_id] =
-								new_wait_count;
-				wait_count->total_count -= wait_count_diff;
-
-				if (wait_count->total_count == 0)
-					cur->status &=
-					  ~STATUS_WAIT_FOR_FRAME_ON_OTHER_LINKS;
-			}
-		}
+end_index_update:
+	/**
+	 * In some cases, the current frame and its associated
+	 * rx_params/reo_params may get freed immediately after the frame is
+	 * queued to egress list. Hence fetching the link ID from
+	 * "frame_desc->rx_params->reo_params" could lead to use after free.
+	 * Store a copy of "reo_params" in the frame descriptor and access the
+	 * copy after the frame is queued to egress list.
+	 *
+	 * TODO:- Fix this cleanly using refcount mechanism or structure
+	 * duplication.
+	 */
+	mgmt_rx_reo_index_end_update(index, frame_desc->reo_params_copy.link_id,
+				     frame_desc->pkt_ctr_delta, new_node);
+
+	if (mgmt_rx_reo_index_size(index) !=
+	    qdf_list_size(&reo_ingress_list->list)) {
+		mgmt_rx_reo_err("Ingress list size %u, index size %u",
+				qdf_list_size(&reo_ingress_list->list),
+				mgmt_rx_reo_index_size(index));
+		return QDF_STATUS_E_INVAL;
 	}
 
-	return QDF_STATUS_SUCCESS;
+	return status;
 }
 
 static QDF_STATUS
@@ -4190,12 +4183,6 @@ mgmt_rx_reo_update_lists(struct mgmt_rx_reo_ingress_list *ingress_list,
 		goto exit_release_ingress_list_lock;
 	}
 
-	status = mgmt_rx_reo_check_sanity_list(reo_ingress_list);
-	if (QDF_IS_STATUS_ERROR(status)) {
-		mgmt_rx_reo_err("Sanity check of ingress list failed");
-		goto exit_release_ingress_list_lock;
-	}
-
 	status = QDF_STATUS_SUCCESS;
 	goto exit_release_ingress_list_lock;
 
@@ -4256,6 +4243,7 @@ mgmt_rx_reo_ingress_list_init(struct mgmt_rx_reo_ingress_list *ingress_list)
 	qdf_list_create(&reo_ingress_list->list,
 			reo_ingress_list->max_list_size);
 	qdf_spinlock_create(&reo_ingress_list->list_lock);
+	mgmt_rx_reo_index_init(&reo_ingress_list->index);
 	qdf_mem_zero(&reo_ingress_list->last_inserted_frame,
 		     sizeof(reo_ingress_list->last_inserted_frame));
 	qdf_mem_zero(&reo_ingress_list->last_released_frame,
@@ -4302,6 +4290,7 @@ mgmt_rx_reo_egress_list_init(struct mgmt_rx_reo_egress_list *egress_list)
 	reo_egress_list->max_list_size = MGMT_RX_REO_EGRESS_LIST_MAX_SIZE;
 	qdf_list_create(&reo_egress_list->list, reo_egress_list->max_list_size);
 	qdf_spinlock_create(&reo_egress_list->list_lock);
+	mgmt_rx_reo_index_init(&reo_egress_list->index);
 	qdf_mem_zero(&reo_egress_list->last_inserted_frame,
 		     sizeof(reo_egress_list->last_inserted_frame));
 	qdf_mem_zero(&reo_egress_list->last_released_frame,
@@ -7391,6 +7380,7 @@ mgmt_rx_reo_flush_list(struct mgmt_rx_reo_list *reo_list)
 
 		qdf_mem_free(cur_entry);
 	}
+	mgmt_rx_reo_index_init(&reo_list->index);
 
 	qdf_spin_unlock_bh(&reo_list->list_lock);
 
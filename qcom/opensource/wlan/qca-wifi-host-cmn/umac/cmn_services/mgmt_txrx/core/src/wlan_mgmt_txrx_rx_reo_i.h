@@ -35,6 +35,7 @@
 #include <wlan_objmgr_pdev_obj.h>
 #include <wlan_objmgr_psoc_obj.h>
 #include <wlan_mlo_mgr_public_structs.h>
+#include "wlan_mgmt_txrx_rx_reo_index_i.h"
 
 #define MGMT_RX_REO_INGRESS_LIST_MAX_SIZE                  (512)
 #define MGMT_RX_REO_INGRESS_LIST_TIMEOUT_US                (250 * USEC_PER_MSEC)
@@ -326,6 +327,8 @@ struct mgmt_rx_reo_frame_info {
  * @last_overflow_ts: Host time stamp of last overflow
  * @last_inserted_frame: Information about the last frame inserted to the list
  * @last_released_frame: Information about the last frame released from the list
+ * @index: Global time stamp ordered index of the list entries, maintained for
+ * the ingress list only. Protected by @list_lock.
  */
 struct mgmt_rx_reo_list {
 	qdf_list_t list;
@@ -335,6 +338,7 @@ struct mgmt_rx_reo_list {
 	uint64_t last_overflow_ts;
 	struct mgmt_rx_reo_frame_info last_inserted_frame;
 	struct mgmt_rx_reo_frame_info last_released_frame;
+	struct mgmt_rx_reo_index index;
 };
 
 /**
@@ -362,21 +366,10 @@ struct mgmt_rx_reo_egress_list {
 	qdf_timer_t egress_inactivity_timer;
 };
 
-/*
- * struct mgmt_rx_reo_wait_count - Wait count for a mgmt frame
- * @per_link_count: Array of wait counts for all MLO links. Each array entry
- * holds the number of frames this mgmt frame should wait for on that
- * particular link.
- * @total_count: Sum of entries in @per_link_count
- */
-struct mgmt_rx_reo_wait_count {
-	unsigned int per_link_count[MAX_MLO_LINKS];
-	unsigned long long int total_count;
-};
-
 /**
  * struct mgmt_rx_reo_list_entry - Entry in the Management reorder list
  * @node: List node
+ * @index_node: Node of the ingress list index
  * @nbuf: nbuf corresponding to this frame
  * @rx_params: Management rx event parameters
  * @wait_count: Wait counts for the frame
@@ -414,6 +407,7 @@ struct mgmt_rx_reo_wait_count {
  */
 struct mgmt_rx_reo_list_entry {
 	qdf_list_node_t node;
+	struct mgmt_rx_reo_index_node index_node;
 	qdf_nbuf_t nbuf;
 	struct mgmt_rx_event_params *rx_params;
 	struct mgmt_rx_reo_wait_count wait_count;
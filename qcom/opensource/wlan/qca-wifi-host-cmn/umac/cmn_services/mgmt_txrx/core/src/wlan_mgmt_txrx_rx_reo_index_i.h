@@ -0,0 +1,667 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ *  DOC: wlan_mgmt_txrx_rx_reo_index_i.h
+ *  This file contains the global time stamp ordered index of the management
+ *  rx reorder ingress list.
+ *
+ *  Every frame received by the reorder module updates the wait counts of all
+ *  the frames pending in the ingress list: the frames older than it have
+ *  their per link wait counts capped by the wait counts of the frame, and
+ *  the frames newer than it wait for pkt_ctr_delta frames less on its link.
+ *  The index is a treap keyed by global time stamp which keeps these two
+ *  updates as pending tags on its subtrees, so that a frame costs
+ *  O(log n) whatever the number of frames pending. The wait count of an
+ *  entry is exact once the tags of its ancestors are pushed down, which
+ *  the lookups of the index do on their way.
+ */
+
+#ifndef _WLAN_MGMT_TXRX_RX_REO_INDEX_I_H
+#define _WLAN_MGMT_TXRX_RX_REO_INDEX_I_H
+
+#include <qdf_types.h>
+#include <wlan_mlo_mgr_public_structs.h>
+
+#define MGMT_RX_REO_GLOBAL_TS_HALF_RANGE (0x80000000)
+#define MGMT_RX_REO_INDEX_NO_CAP         (UINT_MAX)
+#define MGMT_RX_REO_INDEX_SEED           (0x9e3779b9)
+
+/**
+ * mgmt_rx_reo_compare_global_timestamps_gte()-Compare given global timestamps
+ * @ts1: Global timestamp1
+ * @ts2: Global timestamp2
+ *
+ * We can't directly use the comparison operator here because the timestamps can
+ * overflow. But these timestamps have a property that the difference between
+ * them can never be greater than half the range of the data type.
+ * We can make use of this condition to detect which one is actually greater.
+ *
+ * Return: true if @ts1 is greater than or equal to @ts2, else false
+ */
+static inline bool
+mgmt_rx_reo_compare_global_timestamps_gte(uint32_t ts1, uint32_t ts2)
+{
+	uint32_t delta = ts1 - ts2;
+
+	return delta <= MGMT_RX_REO_GLOBAL_TS_HALF_RANGE;
+}
+
+/*
+ * struct mgmt_rx_reo_wait_count - Wait count for a mgmt frame
+ * @per_link_count: Array of wait counts for all MLO links. Each array entry
+ * holds the number of frames this mgmt frame should wait for on that
+ * particular link.
+ * @total_count: Sum of entries in @per_link_count
+ */
+struct mgmt_rx_reo_wait_count {
+	unsigned int per_link_count[MAX_MLO_LINKS];
+	unsigned long long int total_count;
+};
+
+/**
+ * struct mgmt_rx_reo_index_update - Wait count update pending for the
+ * entries of a subtree of the index
+ * @sub: Per link count to subtract from the wait count, floored at zero
+ * @cap: Per link upper bound of the wait count, applied after @sub
+ * @pending: Whether the update changes any wait count
+ *
+ * Both the updates done on frame reception are of this form, and so is
+ * any sequence of them, see mgmt_rx_reo_index_apply().
+ */
+struct mgmt_rx_reo_index_update {
+	uint32_t sub[MAX_MLO_LINKS];
+	uint32_t cap[MAX_MLO_LINKS];
+	bool pending;
+};
+
+/**
+ * struct mgmt_rx_reo_index_node - Node of the ingress list index, one per
+ * ingress list entry
+ * @left: Subtree of the entries older than this one
+ * @right: Subtree of the entries newer than this one
+ * @wait_count: Wait count of the entry
+ * @update: Update pending for the descendants of this node
+ * @global_ts: Global time stamp of the frame
+ * @priority: Heap priority of the node
+ * @size: Number of nodes in the subtree rooted at this node
+ * @num_non_parallel_rx: Number of nodes in the subtree which are not
+ * received in parallel to the last frame delivered to the upper layer
+ * @is_parallel_rx: Whether the frame is received in parallel to the last
+ * frame delivered to the upper layer
+ */
+struct mgmt_rx_reo_index_node {
+	struct mgmt_rx_reo_index_node *left;
+	struct mgmt_rx_reo_index_node *right;
+	struct mgmt_rx_reo_wait_count *wait_count;
+	struct mgmt_rx_reo_index_update update;
+	uint32_t global_ts;
+	uint32_t priority;
+	uint32_t size;
+	uint32_t num_non_parallel_rx;
+	bool is_parallel_rx;
+};
+
+/**
+ * struct mgmt_rx_reo_index - Global time stamp ordered index of the ingress
+ * list
+ * @root: Root of the treap
+ * @older: Entries not newer than the frame being received, between
+ * mgmt_rx_reo_index_begin_update() and mgmt_rx_reo_index_end_update()
+ * @newer: Entries newer than the frame being received, between
+ * mgmt_rx_reo_index_begin_update() and mgmt_rx_reo_index_end_update()
+ * @seed: State of the generator of node priorities
+ *
+ * Entries with the same global time stamp are kept in their order of
+ * insertion, like in the ingress list.
+ */
+struct mgmt_rx_reo_index {
+	struct mgmt_rx_reo_index_node *root;
+	struct mgmt_rx_reo_index_node *older;
+	struct mgmt_rx_reo_index_node *newer;
+	uint32_t seed;
+};
+
+/**
+ * mgmt_rx_reo_index_update_init() - Initialize an index update to the
+ * update which changes no wait count
+ * @update: Pointer to the update
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_update_init(struct mgmt_rx_reo_index_update *update)
+{
+	uint8_t link;
+
+	for (link = 0; link < MAX_MLO_LINKS; link++) {
+		update->sub[link] = 0;
+		update->cap[link] = MGMT_RX_REO_INDEX_NO_CAP;
+	}
+	update->pending = false;
+}
+
+/**
+ * mgmt_rx_reo_index_apply() - Apply an update to the subtree rooted at a node
+ * @node: Root of the subtree
+ * @update: Update to apply
+ *
+ * The wait count of @node is updated right away, the update is queued on
+ * the node for its descendants. For a link, an update maps a wait count
+ * w to min(max(w - sub, 0), cap). Applying (sub2, cap2) on top of a
+ * pending (sub1, cap1) gives (sub1 + sub2, min(max(cap1 - sub2, 0), cap2)),
+ * so a node has at most one update pending whatever the number of frames
+ * received since it was last pushed down.
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_apply(struct mgmt_rx_reo_index_node *node,
+			const struct mgmt_rx_reo_index_update *update)
+{
+	struct mgmt_rx_reo_wait_count *wait_count;
+	struct mgmt_rx_reo_index_update *pending;
+	uint8_t link;
+
+	if (!node || !update->pending)
+		return;
+
+	wait_count = node->wait_count;
+	pending = &node->update;
+
+	for (link = 0; link < MAX_MLO_LINKS; link++) {
+		uint32_t sub = update->sub[link];
+		uint32_t cap = update->cap[link];
+		uint32_t old_count = wait_count->per_link_count[link];
+		uint32_t new_count;
+
+		new_count = old_count > sub ? old_count - sub : 0;
+		if (new_count > cap)
+			new_count = cap;
+
+		wait_count->per_link_count[link] = new_count;
+		wait_count->total_count -= old_count - new_count;
+
+		if (pending->sub[link] > UINT_MAX - sub)
+			pending->sub[link] = UINT_MAX;
+		else
+			pending->sub[link] += sub;
+
+		if (pending->cap[link] > sub)
+			pending->cap[link] -= sub;
+		else
+			pending->cap[link] = 0;
+
+		if (pending->cap[link] > cap)
+			pending->cap[link] = cap;
+	}
+
+	pending->pending = true;
+}
+
+/**
+ * mgmt_rx_reo_index_push() - Push the update pending on a node down to its
+ * children
+ * @node: Pointer to the node
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_push(struct mgmt_rx_reo_index_node *node)
+{
+	if (!node->update.pending)
+		return;
+
+	mgmt_rx_reo_index_apply(node->left, &node->update);
+	mgmt_rx_reo_index_apply(node->right, &node->update);
+	mgmt_rx_reo_index_update_init(&node->update);
+}
+
+/**
+ * mgmt_rx_reo_index_pull() - Recompute the subtree counters of a node from
+ * its children
+ * @node: Pointer to the node
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_pull(struct mgmt_rx_reo_index_node *node)
+{
+	node->size = 1;
+	node->num_non_parallel_rx = !node->is_parallel_rx;
+
+	if (node->left) {
+		node->size += node->left->size;
+		node->num_non_parallel_rx += node->left->num_non_parallel_rx;
+	}
+
+	if (node->right) {
+		node->size += node->right->size;
+		node->num_non_parallel_rx += node->right->num_non_parallel_rx;
+	}
+}
+
+/**
+ * mgmt_rx_reo_index_split() - Split a subtree by global time stamp
+ * @node: Root of the subtree
+ * @global_ts: Global time stamp to split at
+ * @older: Filled with the subtree of the nodes with global time stamp less
+ * than or equal to @global_ts
+ * @newer: Filled with the subtree of the nodes with global time stamp
+ * greater than @global_ts
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_split(struct mgmt_rx_reo_index_node *node,
+			uint32_t global_ts,
+			struct mgmt_rx_reo_index_node **older,
+			struct mgmt_rx_reo_index_node **newer)
+{
+	if (!node) {
+		*older = NULL;
+		*newer = NULL;
+		return;
+	}
+
+	mgmt_rx_reo_index_push(node);
+
+	if (mgmt_rx_reo_compare_global_timestamps_gte(global_ts,
+						      node->global_ts)) {
+		mgmt_rx_reo_index_split(node->right, global_ts,
+					&node->right, newer);
+		*older = node;
+	} else {
+		mgmt_rx_reo_index_split(node->left, global_ts,
+					older, &node->left);
+		*newer = node;
+	}
+
+	mgmt_rx_reo_index_pull(node);
+}
+
+/**
+ * mgmt_rx_reo_index_merge() - Merge two subtrees
+ * @older: Subtree of the older nodes
+ * @newer: Subtree of the newer nodes
+ *
+ * Return: Root of the merged subtree
+ */
+static inline struct mgmt_rx_reo_index_node *
+mgmt_rx_reo_index_merge(struct mgmt_rx_reo_index_node *older,
+			struct mgmt_rx_reo_index_node *newer)
+{
+	if (!older)
+		return newer;
+
+	if (!newer)
+		return older;
+
+	if (older->priority > newer->priority) {
+		mgmt_rx_reo_index_push(older);
+		older->right = mgmt_rx_reo_index_merge(older->right, newer);
+		mgmt_rx_reo_index_pull(older);
+
+		return older;
+	}
+
+	mgmt_rx_reo_index_push(newer);
+	newer->left = mgmt_rx_reo_index_merge(older, newer->left);
+	mgmt_rx_reo_index_pull(newer);
+
+	return newer;
+}
+
+/**
+ * mgmt_rx_reo_index_split_first() - Split a subtree by position
+ * @node: Root of the subtree
+ * @n: Number of nodes to split off
+ * @older: Filled with the subtree of the @n oldest nodes
+ * @newer: Filled with the subtree of the remaining nodes
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_split_first(struct mgmt_rx_reo_index_node *node,
+			      uint32_t n,
+			      struct mgmt_rx_reo_index_node **older,
+			      struct mgmt_rx_reo_index_node **newer)
+{
+	uint32_t left_size;
+
+	if (!node) {
+		*older = NULL;
+		*newer = NULL;
+		return;
+	}
+
+	mgmt_rx_reo_index_push(node);
+
+	left_size = node->left ? node->left->size : 0;
+	if (n <= left_size) {
+		mgmt_rx_reo_index_split_first(node->left, n,
+					      older, &node->left);
+		*newer = node;
+	} else {
+		mgmt_rx_reo_index_split_first(node->right, n - left_size - 1,
+					      &node->right, newer);
+		*older = node;
+	}
+
+	mgmt_rx_reo_index_pull(node);
+}
+
+/**
+ * mgmt_rx_reo_index_leftmost() - Get the oldest node of a subtree
+ * @node: Root of the subtree
+ *
+ * Pushes the pending updates down on the way, so the wait count of the
+ * node returned is exact.
+ *
+ * Return: Oldest node, NULL if the subtree is empty
+ */
+static inline struct mgmt_rx_reo_index_node *
+mgmt_rx_reo_index_leftmost(struct mgmt_rx_reo_index_node *node)
+{
+	if (!node)
+		return NULL;
+
+	mgmt_rx_reo_index_push(node);
+	while (node->left) {
+		node = node->left;
+		mgmt_rx_reo_index_push(node);
+	}
+
+	return node;
+}
+
+/**
+ * mgmt_rx_reo_index_remove_leftmost() - Remove the oldest node of a subtree
+ * @node: Root of the subtree, not empty
+ *
+ * Return: Root of the subtree without its oldest node
+ */
+static inline struct mgmt_rx_reo_index_node *
+mgmt_rx_reo_index_remove_leftmost(struct mgmt_rx_reo_index_node *node)
+{
+	mgmt_rx_reo_index_push(node);
+
+	if (!node->left)
+		return node->right;
+
+	node->left = mgmt_rx_reo_index_remove_leftmost(node->left);
+	mgmt_rx_reo_index_pull(node);
+
+	return node;
+}
+
+/**
+ * mgmt_rx_reo_index_push_all() - Push the pending updates of a subtree down
+ * to all its nodes
+ * @node: Root of the subtree
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_push_all(struct mgmt_rx_reo_index_node *node)
+{
+	if (!node)
+		return;
+
+	mgmt_rx_reo_index_push(node);
+	mgmt_rx_reo_index_push_all(node->left);
+	mgmt_rx_reo_index_push_all(node->right);
+}
+
+/**
+ * mgmt_rx_reo_index_init() - Initialize an empty index
+ * @index: Pointer to the index
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_init(struct mgmt_rx_reo_index *index)
+{
+	index->root = NULL;
+	index->older = NULL;
+	index->newer = NULL;
+	index->seed = MGMT_RX_REO_INDEX_SEED;
+}
+
+/**
+ * mgmt_rx_reo_index_size() - Get the number of entries in the index
+ * @index: Pointer to the index
+ *
+ * Return: Number of entries
+ */
+static inline uint32_t
+mgmt_rx_reo_index_size(struct mgmt_rx_reo_index *index)
+{
+	return index->root ? index->root->size : 0;
+}
+
+/**
+ * mgmt_rx_reo_index_node_init() - Initialize the index node of an entry
+ * before it is inserted
+ * @index: Pointer to the index
+ * @node: Pointer to the node
+ * @wait_count: Wait count of the entry, kept up to date by the index
+ * @global_ts: Global time stamp of the frame
+ * @is_parallel_rx: Whether the frame is received in parallel to the last
+ * frame delivered to the upper layer
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_node_init(struct mgmt_rx_reo_index *index,
+			    struct mgmt_rx_reo_index_node *node,
+			    struct mgmt_rx_reo_wait_count *wait_count,
+			    uint32_t global_ts, bool is_parallel_rx)
+{
+	/* xorshift32, priorities only need to be independent of the keys */
+	index->seed ^= index->seed << 13;
+	index->seed ^= index->seed >> 17;
+	index->seed ^= index->seed << 5;
+
+	node->left = NULL;
+	node->right = NULL;
+	node->wait_count = wait_count;
+	mgmt_rx_reo_index_update_init(&node->update);
+	node->global_ts = global_ts;
+	node->priority = index->seed;
+	node->is_parallel_rx = is_parallel_rx;
+	mgmt_rx_reo_index_pull(node);
+}
+
+/**
+ * mgmt_rx_reo_index_begin_update() - Start the update of the index for a
+ * frame received
+ * @index: Pointer to the index
+ * @global_ts: Global time stamp of the frame
+ * @wait_count: Wait count of the frame
+ * @num_older: Filled with the number of entries with global time stamp less
+ * than or equal to @global_ts
+ * @num_older_non_parallel_rx: Filled with the number of those entries which
+ * are not received in parallel to the last frame delivered
+ *
+ * Caps the wait counts of the entries not newer than the frame by the wait
+ * count of the frame. mgmt_rx_reo_index_end_update() must be called next.
+ *
+ * Return: Entry with the least global time stamp greater than @global_ts,
+ * with an exact wait count, NULL if there is none
+ */
+static inline struct mgmt_rx_reo_index_node *
+mgmt_rx_reo_index_begin_update(struct mgmt_rx_reo_index *index,
+			       uint32_t global_ts,
+			       const struct mgmt_rx_reo_wait_count *wait_count,
+			       uint32_t *num_older,
+			       uint32_t *num_older_non_parallel_rx)
+{
+	struct mgmt_rx_reo_index_update update;
+	uint8_t link;
+
+	mgmt_rx_reo_index_split(index->root, global_ts,
+				&index->older, &index->newer);
+	index->root = NULL;
+
+	*num_older = 0;
+	*num_older_non_parallel_rx = 0;
+	if (index->older) {
+		*num_older = index->older->size;
+		*num_older_non_parallel_rx = index->older->num_non_parallel_rx;
+
+		mgmt_rx_reo_index_update_init(&update);
+		for (link = 0; link < MAX_MLO_LINKS; link++)
+			update.cap[link] = wait_count->per_link_count[link];
+		update.pending = true;
+
+		mgmt_rx_reo_index_apply(index->older, &update);
+	}
+
+	return mgmt_rx_reo_index_leftmost(index->newer);
+}
+
+/**
+ * mgmt_rx_reo_index_end_update() - Complete the update of the index for a
+ * frame received
+ * @index: Pointer to the index
+ * @link_id: Link of the frame
+ * @pkt_ctr_delta: Number of frames the frame accounts for on @link_id
+ * @new: Index node of the frame if it is queued to the ingress list, else
+ * NULL. Initialized with mgmt_rx_reo_index_node_init().
+ *
+ * Reduces the wait count on @link_id of the entries newer than the frame
+ * by @pkt_ctr_delta and inserts @new between the older and newer entries.
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_end_update(struct mgmt_rx_reo_index *index,
+			     uint8_t link_id, uint16_t pkt_ctr_delta,
+			     struct mgmt_rx_reo_index_node *new)
+{
+	struct mgmt_rx_reo_index_update update;
+
+	if (index->newer && pkt_ctr_delta) {
+		mgmt_rx_reo_index_update_init(&update);
+		update.sub[link_id] = pkt_ctr_delta;
+		update.pending = true;
+
+		mgmt_rx_reo_index_apply(index->newer, &update);
+	}
+
+	index->root = mgmt_rx_reo_index_merge(
+			mgmt_rx_reo_index_merge(index->older, new),
+			index->newer);
+	index->older = NULL;
+	index->newer = NULL;
+}
+
+/**
+ * mgmt_rx_reo_index_first() - Get the oldest entry of the index
+ * @index: Pointer to the index
+ *
+ * Return: Oldest entry, with an exact wait count, NULL if the index is
+ * empty
+ */
+static inline struct mgmt_rx_reo_index_node *
+mgmt_rx_reo_index_first(struct mgmt_rx_reo_index *index)
+{
+	return mgmt_rx_reo_index_leftmost(index->root);
+}
+
+/**
+ * mgmt_rx_reo_index_remove_first() - Remove the oldest entry of the index
+ * @index: Pointer to the index
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_remove_first(struct mgmt_rx_reo_index *index)
+{
+	if (index->root)
+		index->root = mgmt_rx_reo_index_remove_leftmost(index->root);
+}
+
+/**
+ * mgmt_rx_reo_index_nth() - Get the entry of the index at a position
+ * @index: Pointer to the index
+ * @n: Position of the entry, 0 for the oldest one
+ *
+ * Pushes the pending updates down on the way, so the wait count of the
+ * entry returned is exact. Nothing is removed from the index.
+ *
+ * Return: Entry at position @n, NULL if the index has fewer entries
+ */
+static inline struct mgmt_rx_reo_index_node *
+mgmt_rx_reo_index_nth(struct mgmt_rx_reo_index *index, uint32_t n)
+{
+	struct mgmt_rx_reo_index_node *node = index->root;
+	uint32_t left_size;
+
+	while (node) {
+		mgmt_rx_reo_index_push(node);
+
+		left_size = node->left ? node->left->size : 0;
+		if (n == left_size)
+			return node;
+
+		if (n < left_size) {
+			node = node->left;
+		} else {
+			n -= left_size + 1;
+			node = node->right;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * mgmt_rx_reo_index_remove_first_n() - Remove the oldest entries of the
+ * index
+ * @index: Pointer to the index
+ * @n: Number of entries to remove
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_remove_first_n(struct mgmt_rx_reo_index *index,
+				 uint32_t n)
+{
+	struct mgmt_rx_reo_index_node *removed;
+
+	mgmt_rx_reo_index_split_first(index->root, n, &removed, &index->root);
+}
+
+/**
+ * mgmt_rx_reo_index_resolve() - Make the wait counts of all the entries of
+ * the index exact
+ * @index: Pointer to the index
+ *
+ * This walks the whole index, it is meant for the paths which read the wait
+ * counts of all the entries, not for the per frame ones.
+ *
+ * Return: void
+ */
+static inline void
+mgmt_rx_reo_index_resolve(struct mgmt_rx_reo_index *index)
+{
+	mgmt_rx_reo_index_push_all(index->root);
+}
+#endif /* _WLAN_MGMT_TXRX_RX_REO_INDEX_I_H */
@@ -0,0 +1,646 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * rx_reo_bench - host benchmark of the management rx reorder ingress list
+ *
+ * Simulates the management frames of an MLO group the way the reorder
+ * simulation of wlan_mgmt_txrx_rx_reo.c does: every link receives frames
+ * on air at a fixed interval with some jitter, and hands them to the host
+ * with a per link delay, so that the frames of the slow links hold back the
+ * ones of the fast links in the ingress list. Some frames are lost before
+ * the host (the next frame of the link then accounts for them through its
+ * pkt_ctr_delta) and some are consumed by FW (they update the wait counts
+ * of the frames pending but are not queued).
+ *
+ * Every frame received runs the ingress list update of
+ * mgmt_rx_reo_update_ingress_list(), then the frames with no wait count
+ * left are released from the head of the list, like
+ * mgmt_rx_reo_move_entries_ingress_to_egress_list() does. This is done
+ * with the ingress list index and with the linear list walk the reorder
+ * module used before it. Reports, for 2, 3 and 4 links (or the number of
+ * links given), the frames per second processed and the release latency,
+ * in simulated time, of the frames. With -c, the wait counts of all the
+ * pending frames are compared between the two after every frame.
+ *
+ * Usage: rx_reo_bench [-l links] [-n frames] [-i interval_us] [-d skew_us]
+ *                     [-j jitter_us] [-x lost_pct] [-f fw_pct] [-s seed]
+ *                     [-c]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "wlan_mgmt_txrx_rx_reo_index_i.h"
+
+#define BENCH_MAX_LINKS 4
+#define BENCH_TS_BASE 0xfff00000
+
+/**
+ * struct bench_frame - frame handed to the reorder module
+ * @arrival_us: host time stamp of the frame
+ * @global_ts: global time stamp of the frame
+ * @pkt_ctr_delta: number of frames the frame accounts for on its link
+ * @link_id: link of the frame
+ * @fw_consumed: frame is consumed by FW and not queued
+ * @wait_count: wait count computed for the frame on reception
+ */
+struct bench_frame {
+	uint64_t arrival_us;
+	uint32_t global_ts;
+	uint16_t pkt_ctr_delta;
+	uint8_t link_id;
+	bool fw_consumed;
+	struct mgmt_rx_reo_wait_count wait_count;
+};
+
+/**
+ * struct bench_entry - ingress list entry
+ * @prev: previous entry of the list walked by the linear update
+ * @next: next entry of the list walked by the linear update
+ * @index_node: node of the ingress list index
+ * @wait_count: wait count of the frame
+ * @frame: frame of the entry
+ */
+struct bench_entry {
+	struct bench_entry *prev;
+	struct bench_entry *next;
+	struct mgmt_rx_reo_index_node index_node;
+	struct mgmt_rx_reo_wait_count wait_count;
+	const struct bench_frame *frame;
+};
+
+/**
+ * struct bench_list - ingress list of the linear update
+ * @head: oldest entry
+ * @tail: newest entry
+ */
+struct bench_list {
+	struct bench_entry *head;
+	struct bench_entry *tail;
+};
+
+/**
+ * struct bench_stats - result of a run
+ * @ns: time spent updating the ingress list and releasing frames
+ * @num_released: number of frames released
+ * @pending_sum: sum of the ingress list sizes seen by the frames
+ * @pending_max: largest ingress list size
+ * @latency_us: release latency of the frames released
+ */
+struct bench_stats {
+	uint64_t ns;
+	uint32_t num_released;
+	uint64_t pending_sum;
+	uint32_t pending_max;
+	uint64_t *latency_us;
+};
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t bench_rand(uint32_t max)
+{
+	return max ? (uint32_t)rand() % max : 0;
+}
+
+static int bench_cmp_frame(const void *a, const void *b)
+{
+	const struct bench_frame *fa = a, *fb = b;
+
+	if (fa->arrival_us != fb->arrival_us)
+		return fa->arrival_us < fb->arrival_us ? -1 : 1;
+
+	return (int)fa->link_id - (int)fb->link_id;
+}
+
+static int bench_cmp_u64(const void *a, const void *b)
+{
+	const uint64_t *ua = a, *ub = b;
+
+	return *ua < *ub ? -1 : *ua > *ub;
+}
+
+/**
+ * bench_gen() - generate the frames handed to the reorder module
+ * @num_links: number of links
+ * @num: number of frames on air, over all the links
+ * @interval_us: interval between two frames of a link on air
+ * @skew_us: extra host delay of a link over the previous one
+ * @jitter_us: random part of the on air interval and of the host delay
+ * @lost_pct: percentage of frames not handed to the host
+ * @fw_pct: percentage of frames consumed by FW
+ * @num_frames: filled with the number of frames handed to the host
+ *
+ * The wait count of a frame, for each other link, is the number of frames
+ * of that link older than it on air which the host has not been handed
+ * yet, lost ones included, as the MAC HW snapshots would tell.
+ *
+ * Return: frames in host arrival order
+ */
+static struct bench_frame *
+bench_gen(uint32_t num_links, uint32_t num, uint32_t interval_us,
+	  uint32_t skew_us, uint32_t jitter_us, uint32_t lost_pct,
+	  uint32_t fw_pct, uint32_t *num_frames)
+{
+	uint64_t *air_us[BENCH_MAX_LINKS];
+	uint32_t per_link = num / num_links;
+	uint32_t received[BENCH_MAX_LINKS] = {0};
+	struct bench_frame *frames;
+	uint32_t link, i, n = 0;
+
+	*num_frames = 0;
+	frames = calloc(num, sizeof(*frames));
+	if (!frames)
+		return NULL;
+
+	for (link = 0; link < num_links; link++) {
+		uint64_t air = link * interval_us / num_links;
+		uint64_t arrival = 0;
+
+		air_us[link] = calloc(per_link, sizeof(uint64_t));
+		if (!air_us[link])
+			return NULL;
+
+		for (i = 0; i < per_link; i++) {
+			uint64_t at;
+
+			air += interval_us + bench_rand(jitter_us);
+			air_us[link][i] = air;
+
+			at = air + link * skew_us + bench_rand(jitter_us);
+			arrival = at > arrival ? at : arrival + 1;
+
+			if (bench_rand(100) < lost_pct)
+				continue;
+
+			frames[n].arrival_us = arrival;
+			frames[n].global_ts = (uint32_t)(BENCH_TS_BASE + air);
+			frames[n].link_id = link;
+			/* Position of the frame on its link, for now */
+			frames[n].pkt_ctr_delta = 0;
+			frames[n].wait_count.total_count = i;
+			frames[n].fw_consumed = bench_rand(100) < fw_pct;
+			n++;
+		}
+	}
+
+	qsort(frames, n, sizeof(*frames), bench_cmp_frame);
+
+	for (i = 0; i < n; i++) {
+		struct bench_frame *frame = &frames[i];
+		uint32_t pos = frame->wait_count.total_count;
+		uint64_t air = air_us[frame->link_id][pos];
+
+		memset(&frame->wait_count, 0, sizeof(frame->wait_count));
+		for (link = 0; link < num_links; link++) {
+			uint32_t lo = 0, hi = per_link;
+
+			if (link == frame->link_id)
+				continue;
+
+			/* Frames of the link older than this one on air */
+			while (lo < hi) {
+				uint32_t mid = (lo + hi) / 2;
+
+				if (air_us[link][mid] < air)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+
+			if (lo > received[link]) {
+				frame->wait_count.per_link_count[link] =
+							lo - received[link];
+				frame->wait_count.total_count +=
+							lo - received[link];
+			}
+		}
+
+		frame->pkt_ctr_delta = pos + 1 - received[frame->link_id];
+		received[frame->link_id] = pos + 1;
+	}
+
+	for (link = 0; link < num_links; link++)
+		free(air_us[link]);
+
+	*num_frames = n;
+	return frames;
+}
+
+/* Same as mgmt_rx_reo_update_wait_count() */
+static void bench_cap(struct mgmt_rx_reo_wait_count *old_frame,
+		      const struct mgmt_rx_reo_wait_count *new_frame)
+{
+	uint8_t link;
+
+	for (link = 0; link < MAX_MLO_LINKS; link++) {
+		uint32_t old_count = old_frame->per_link_count[link];
+		uint32_t new_count = new_frame->per_link_count[link];
+
+		if (old_count > new_count) {
+			old_frame->per_link_count[link] = new_count;
+			old_frame->total_count -= old_count - new_count;
+		}
+	}
+}
+
+static void bench_release(struct bench_stats *stats,
+			  const struct bench_entry *entry,
+			  const struct bench_frame *cur)
+{
+	stats->latency_us[stats->num_released++] =
+				cur->arrival_us - entry->frame->arrival_us;
+}
+
+/**
+ * bench_list_rx() - linear ingress list update, as done before the index
+ * @list: ingress list
+ * @frame: frame received
+ * @new: entry of the frame, NULL if it is not queued
+ * @stats: run statistics
+ *
+ * Return: none
+ */
+static void bench_list_rx(struct bench_list *list,
+			  const struct bench_frame *frame,
+			  struct bench_entry *new, struct bench_stats *stats)
+{
+	struct bench_entry *cur, *least_greater;
+	uint32_t link = frame->link_id;
+
+	for (cur = list->head; cur; cur = cur->next) {
+		if (!mgmt_rx_reo_compare_global_timestamps_gte
+				(frame->global_ts, cur->frame->global_ts))
+			break;
+
+		bench_cap(&cur->wait_count, &frame->wait_count);
+	}
+	least_greater = cur;
+
+	if (new) {
+		new->wait_count = frame->wait_count;
+		if (least_greater)
+			bench_cap(&new->wait_count, &least_greater->wait_count);
+
+		new->next = least_greater;
+		new->prev = least_greater ? least_greater->prev : list->tail;
+		if (new->prev)
+			new->prev->next = new;
+		else
+			list->head = new;
+		if (least_greater)
+			least_greater->prev = new;
+		else
+			list->tail = new;
+	}
+
+	for (cur = least_greater; cur; cur = cur->next) {
+		uint32_t old_count = cur->wait_count.per_link_count[link];
+		uint32_t new_count;
+
+		if (!old_count)
+			continue;
+
+		new_count = old_count >= frame->pkt_ctr_delta ?
+			    old_count - frame->pkt_ctr_delta : 0;
+		cur->wait_count.per_link_count[link] = new_count;
+		cur->wait_count.total_count -= old_count - new_count;
+	}
+
+	while (list->head && !list->head->wait_count.total_count) {
+		cur = list->head;
+		list->head = cur->next;
+		if (list->head)
+			list->head->prev = NULL;
+		else
+			list->tail = NULL;
+		bench_release(stats, cur, frame);
+	}
+}
+
+/**
+ * bench_index_rx() - ingress list update through the index
+ * @index: ingress list index
+ * @frame: frame received
+ * @new: entry of the frame, NULL if it is not queued
+ * @stats: run statistics
+ *
+ * Return: none
+ */
+static void bench_index_rx(struct mgmt_rx_reo_index *index,
+			   const struct bench_frame *frame,
+			   struct bench_entry *new, struct bench_stats *stats)
+{
+	struct mgmt_rx_reo_index_node *least_greater, *first;
+	struct mgmt_rx_reo_index_node *new_node = NULL;
+	uint32_t num_older, num_older_non_parallel_rx;
+	uint32_t num_ready = 0;
+
+	least_greater = mgmt_rx_reo_index_begin_update(
+					index, frame->global_ts,
+					&frame->wait_count, &num_older,
+					&num_older_non_parallel_rx);
+
+	if (new) {
+		new->wait_count = frame->wait_count;
+		if (least_greater)
+			bench_cap(&new->wait_count, least_greater->wait_count);
+
+		mgmt_rx_reo_index_node_init(index, &new->index_node,
+					    &new->wait_count, frame->global_ts,
+					    false);
+		new_node = &new->index_node;
+	}
+
+	mgmt_rx_reo_index_end_update(index, frame->link_id,
+				     frame->pkt_ctr_delta, new_node);
+
+	/* count the ready entries first, then drop them all, as on release */
+	while ((first = mgmt_rx_reo_index_nth(index, num_ready)) &&
+	       !first->wait_count->total_count) {
+		bench_release(stats,
+			      (struct bench_entry *)((char *)first -
+				offsetof(struct bench_entry, index_node)),
+			      frame);
+		num_ready++;
+	}
+	mgmt_rx_reo_index_remove_first_n(index, num_ready);
+}
+
+static void bench_index_walk(struct mgmt_rx_reo_index_node *node,
+			     struct mgmt_rx_reo_index_node **nodes,
+			     uint32_t *n)
+{
+	if (!node)
+		return;
+
+	bench_index_walk(node->left, nodes, n);
+	nodes[(*n)++] = node;
+	bench_index_walk(node->right, nodes, n);
+}
+
+/**
+ * bench_check() - compare the pending frames of the two ingress lists
+ * @list: ingress list of the linear update
+ * @index: ingress list index
+ * @nodes: scratch array, as big as the number of frames
+ *
+ * Return: true if both hold the same frames with the same wait counts
+ */
+static bool bench_check(struct bench_list *list,
+			struct mgmt_rx_reo_index *index,
+			struct mgmt_rx_reo_index_node **nodes)
+{
+	struct bench_entry *cur;
+	uint32_t n = 0, i = 0;
+
+	mgmt_rx_reo_index_resolve(index);
+	bench_index_walk(index->root, nodes, &n);
+
+	for (cur = list->head; cur; cur = cur->next, i++) {
+		if (i >= n || memcmp(&cur->wait_count, nodes[i]->wait_count,
+				     sizeof(cur->wait_count)) ||
+		    cur->frame->global_ts != nodes[i]->global_ts)
+			return false;
+	}
+
+	return i == n && n == mgmt_rx_reo_index_size(index);
+}
+
+static void bench_report(const char *name, uint32_t num_links,
+			 uint32_t num_frames, struct bench_stats *stats)
+{
+	uint64_t *lat = stats->latency_us;
+	uint32_t n = stats->num_released;
+	uint64_t sum = 0;
+	uint32_t i;
+
+	qsort(lat, n, sizeof(*lat), bench_cmp_u64);
+	for (i = 0; i < n; i++)
+		sum += lat[i];
+
+	printf("%u links %-6s %10.0f frames/s %7.1f ns/frame, pending avg %.1f max %u, released %u, latency us avg %.0f p50 %llu p99 %llu max %llu\n",
+	       num_links, name,
+	       stats->ns ? (double)num_frames * 1e9 / stats->ns : 0.0,
+	       num_frames ? (double)stats->ns / num_frames : 0.0,
+	       num_frames ? (double)stats->pending_sum / num_frames : 0.0,
+	       stats->pending_max, n, n ? (double)sum / n : 0.0,
+	       n ? (unsigned long long)lat[n / 2] : 0ULL,
+	       n ? (unsigned long long)lat[(uint64_t)n * 99 / 100] : 0ULL,
+	       n ? (unsigned long long)lat[n - 1] : 0ULL);
+}
+
+/**
+ * bench_run() - run the linear update and the index on the same frames
+ * @num_links: number of links
+ * @num: number of frames on air
+ * @interval_us: see bench_gen()
+ * @skew_us: see bench_gen()
+ * @jitter_us: see bench_gen()
+ * @lost_pct: see bench_gen()
+ * @fw_pct: see bench_gen()
+ * @check: compare the two after every frame
+ *
+ * Return: 0 on success, 1 on failure or mismatch
+ */
+static int bench_run(uint32_t num_links, uint32_t num, uint32_t interval_us,
+		     uint32_t skew_us, uint32_t jitter_us, uint32_t lost_pct,
+		     uint32_t fw_pct, bool check)
+{
+	struct bench_stats list_stats = {0}, index_stats = {0};
+	struct mgmt_rx_reo_index_node **nodes = NULL;
+	struct bench_entry *list_entries, *index_entries;
+	struct mgmt_rx_reo_index index;
+	struct bench_list list = {0};
+	struct bench_frame *frames;
+	uint32_t num_frames, i;
+	uint64_t start;
+	int ret = 0;
+
+	frames = bench_gen(num_links, num, interval_us, skew_us, jitter_us,
+			   lost_pct, fw_pct, &num_frames);
+	list_entries = calloc(num_frames, sizeof(*list_entries));
+	index_entries = calloc(num_frames, sizeof(*index_entries));
+	list_stats.latency_us = calloc(num_frames, sizeof(uint64_t));
+	index_stats.latency_us = calloc(num_frames, sizeof(uint64_t));
+	if (check)
+		nodes = calloc(num_frames, sizeof(*nodes));
+	if (!frames || !list_entries || !index_entries ||
+	    !list_stats.latency_us || !index_stats.latency_us ||
+	    (check && !nodes))
+		return 1;
+
+	for (i = 0; i < num_frames; i++) {
+		list_entries[i].frame = &frames[i];
+		index_entries[i].frame = &frames[i];
+	}
+
+	mgmt_rx_reo_index_init(&index);
+
+	if (check) {
+		for (i = 0; i < num_frames; i++) {
+			struct bench_entry *new = NULL;
+
+			if (!frames[i].fw_consumed)
+				new = &list_entries[i];
+			bench_list_rx(&list, &frames[i], new, &list_stats);
+
+			if (!frames[i].fw_consumed)
+				new = &index_entries[i];
+			bench_index_rx(&index, &frames[i], new, &index_stats);
+
+			if (!bench_check(&list, &index, nodes)) {
+				fprintf(stderr, "%u links: mismatch at frame %u\n",
+					num_links, i);
+				ret = 1;
+				break;
+			}
+		}
+
+		if (!ret && (list_stats.num_released !=
+			     index_stats.num_released ||
+			     memcmp(list_stats.latency_us,
+				    index_stats.latency_us,
+				    list_stats.num_released *
+				    sizeof(uint64_t)))) {
+			fprintf(stderr, "%u links: releases differ\n",
+				num_links);
+			ret = 1;
+		}
+
+		printf("%u links: %u frames checked, %s\n", num_links,
+		       num_frames, ret ? "FAIL" : "ok");
+		goto out;
+	}
+
+	start = bench_now_ns();
+	for (i = 0; i < num_frames; i++)
+		bench_list_rx(&list, &frames[i],
+			      frames[i].fw_consumed ? NULL : &list_entries[i],
+			      &list_stats);
+	list_stats.ns = bench_now_ns() - start;
+
+	start = bench_now_ns();
+	for (i = 0; i < num_frames; i++)
+		bench_index_rx(&index, &frames[i],
+			       frames[i].fw_consumed ? NULL : &index_entries[i],
+			       &index_stats);
+	index_stats.ns = bench_now_ns() - start;
+
+	/* Ingress list sizes seen by the frames, replayed untimed */
+	list.head = NULL;
+	list.tail = NULL;
+	list_stats.num_released = 0;
+	for (i = 0; i < num_frames; i++) {
+		struct bench_entry *cur;
+		uint32_t size = 0;
+
+		for (cur = list.head; cur; cur = cur->next)
+			size++;
+		list_stats.pending_sum += size;
+		if (size > list_stats.pending_max)
+			list_stats.pending_max = size;
+
+		bench_list_rx(&list, &frames[i],
+			      frames[i].fw_consumed ? NULL : &list_entries[i],
+			      &list_stats);
+	}
+	index_stats.pending_sum = list_stats.pending_sum;
+	index_stats.pending_max = list_stats.pending_max;
+
+	bench_report("list", num_links, num_frames, &list_stats);
+	bench_report("index", num_links, num_frames, &index_stats);
+
+out:
+	free(nodes);
+	free(list_stats.latency_us);
+	free(index_stats.latency_us);
+	free(index_entries);
+	free(list_entries);
+	free(frames);
+
+	return ret;
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t num = 200000, interval_us = 100, skew_us = 20000;
+	uint32_t jitter_us = 50, lost_pct = 2, fw_pct = 10, seed = 1;
+	uint32_t links = 0, link;
+	bool check = false;
+	int opt, ret = 0;
+
+	while ((opt = getopt(argc, argv, "l:n:i:d:j:x:f:s:c")) != -1) {
+		switch (opt) {
+		case 'l':
+			links = strtoul(optarg, NULL, 0);
+			if (links < 2 || links > BENCH_MAX_LINKS)
+				links = 2;
+			break;
+		case 'n':
+			num = strtoul(optarg, NULL, 0);
+			break;
+		case 'i':
+			interval_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'd':
+			skew_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'j':
+			jitter_us = strtoul(optarg, NULL, 0);
+			break;
+		case 'x':
+			lost_pct = strtoul(optarg, NULL, 0);
+			break;
+		case 'f':
+			fw_pct = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		case 'c':
+			check = true;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-l links] [-n frames] "
+				"[-i interval_us] [-d skew_us] [-j jitter_us] "
+				"[-x lost_pct] [-f fw_pct] [-s seed] [-c]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+
+	for (link = 2; link <= BENCH_MAX_LINKS; link++) {
+		if (links && link != links)
+			continue;
+
+		srand(seed);
+		ret |= bench_run(link, num, interval_us, skew_us, jitter_us,
+				 lost_pct, fw_pct, check);
+	}
+
+	return ret;
+}
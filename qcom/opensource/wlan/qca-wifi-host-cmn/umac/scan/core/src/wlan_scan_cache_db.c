@@ -292,24 +292,114 @@ static void scm_add_rnr_channel_db(struct wlan_objmgr_pdev *pdev,
 #endif
 
 /**
- * scm_del_scan_node() - API to remove scan node from the list
- * @list: hash list
+ * enum scm_db_link - lists of the scan db a scan node is linked in
+ * @SCM_DB_LINK_HASH: bssid hash table, through scan_cache_node.node
+ * @SCM_DB_LINK_BSSID_FREQ: bssid and frequency hash table, through
+ *                          scan_cache_node.bssid_freq_node
+ * @SCM_DB_LINK_AGE: age list, through scan_cache_node.age_node
+ */
+enum scm_db_link {
+	SCM_DB_LINK_HASH,
+	SCM_DB_LINK_BSSID_FREQ,
+	SCM_DB_LINK_AGE,
+};
+
+/**
+ * scm_get_bssid_freq_hash() - get the bssid and frequency hash of an entry
+ * @bssid: bssid of the entry
+ * @freq: frequency of the entry
+ *
+ * Unlike SCAN_GET_HASH(), all the bytes of @bssid are mixed in, so that
+ * BSSIDs sharing their last byte, like the ones of a multi-radio AP or of
+ * an MBSSID set, still spread over the table.
+ *
+ * Return: index in scan_bssid_freq_tbl
+ */
+static inline uint8_t scm_get_bssid_freq_hash(const uint8_t *bssid,
+					      uint32_t freq)
+{
+	uint32_t hash = freq;
+	int i;
+
+	for (i = 0; i < QDF_MAC_ADDR_SIZE; i++)
+		hash = hash * 31 + bssid[i];
+
+	return (hash ^ (hash >> 8) ^ (hash >> 16)) % SCAN_BSSID_FREQ_HASH_SIZE;
+}
+
+/**
+ * scm_link_to_node() - get the scan node of a list node
+ * @link_node: list node
+ * @link: list @link_node belongs to
+ *
+ * Return: scan node
+ */
+static inline struct scan_cache_node *
+scm_link_to_node(qdf_list_node_t *link_node, enum scm_db_link link)
+{
+	switch (link) {
+	case SCM_DB_LINK_BSSID_FREQ:
+		return qdf_container_of(link_node, struct scan_cache_node,
+					bssid_freq_node);
+	case SCM_DB_LINK_AGE:
+		return qdf_container_of(link_node, struct scan_cache_node,
+					age_node);
+	default:
+		return qdf_container_of(link_node, struct scan_cache_node,
+					node);
+	}
+}
+
+/**
+ * scm_node_to_link() - get the list node of a scan node
+ * @scan_node: scan node
+ * @link: list to get the list node for
+ *
+ * Return: list node
+ */
+static inline qdf_list_node_t *
+scm_node_to_link(struct scan_cache_node *scan_node, enum scm_db_link link)
+{
+	switch (link) {
+	case SCM_DB_LINK_BSSID_FREQ:
+		return &scan_node->bssid_freq_node;
+	case SCM_DB_LINK_AGE:
+		return &scan_node->age_node;
+	default:
+		return &scan_node->node;
+	}
+}
+
+/**
+ * scm_del_scan_node() - API to remove scan node from the lists of the db
+ * @scan_db: scan database
  * @scan_node: node to be removed
  *
  * This should be called while holding scan_db_lock.
  *
  * Return: void
  */
-static void scm_del_scan_node(qdf_list_t *list,
-	struct scan_cache_node *scan_node)
+static void scm_del_scan_node(struct scan_dbs *scan_db,
+			      struct scan_cache_node *scan_node)
 {
+	struct scan_cache_entry *entry = scan_node->entry;
 	QDF_STATUS status;
+	uint8_t hash_idx;
 
-	status = qdf_list_remove_node(list, &scan_node->node);
-	if (QDF_IS_STATUS_SUCCESS(status)) {
-		util_scan_free_cache_entry(scan_node->entry);
-		qdf_mem_free(scan_node);
-	}
+	hash_idx = SCAN_GET_HASH(entry->bssid.bytes);
+	status = qdf_list_remove_node(&scan_db->scan_hash_tbl[hash_idx],
+				      &scan_node->node);
+	if (QDF_IS_STATUS_ERROR(status))
+		return;
+
+	hash_idx = scm_get_bssid_freq_hash(entry->bssid.bytes,
+					   entry->channel.chan_freq);
+	qdf_list_remove_node(&scan_db->scan_bssid_freq_tbl[hash_idx],
+			     &scan_node->bssid_freq_node);
+	qdf_list_remove_node(&scan_db->scan_age_list, &scan_node->age_node);
+
+	util_scan_free_cache_entry(entry);
+	qdf_mem_free(scan_node);
 }
 
 /**
@@ -326,13 +416,11 @@ static QDF_STATUS scm_del_scan_node_from_db(struct scan_dbs *scan_db,
 	struct scan_cache_node *scan_node)
 {
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
-	uint8_t hash_idx;
 
 	if (!scan_node)
 		return QDF_STATUS_E_INVAL;
 
-	hash_idx = SCAN_GET_HASH(scan_node->entry->bssid.bytes);
-	scm_del_scan_node(&scan_db->scan_hash_tbl[hash_idx], scan_node);
+	scm_del_scan_node(scan_db, scan_node);
 	scan_db->num_entries--;
 
 	return status;
@@ -431,6 +519,11 @@ static void scm_scan_entry_del(struct scan_dbs *scan_db,
  * @dup_node: node before which new node to be added
  * if it's not NULL, otherwise add node to tail
  *
+ * The node is also added to the bssid and frequency hash list, before
+ * @dup_node if it's in the same list, and to the tail of the age list.
+ * Entries are added in the order their frames are processed, so the age
+ * list stays sorted by scan_entry_time.
+ *
  * Call must be protected by scan_db->scan_db_lock
  *
  * Return: void
@@ -439,6 +532,8 @@ static void scm_add_scan_node(struct scan_dbs *scan_db,
 	struct scan_cache_node *scan_node,
 	struct scan_cache_node *dup_node)
 {
+	struct scan_cache_entry *entry = scan_node->entry;
+	struct scan_cache_entry *dup_entry;
 	uint8_t hash_idx;
 
 	hash_idx =
@@ -454,6 +549,23 @@ static void scm_add_scan_node(struct scan_dbs *scan_db,
 		qdf_list_insert_before(&scan_db->scan_hash_tbl[hash_idx],
 				       &scan_node->node, &dup_node->node);
 
+	hash_idx = scm_get_bssid_freq_hash(entry->bssid.bytes,
+					   entry->channel.chan_freq);
+	if (dup_node) {
+		dup_entry = dup_node->entry;
+		if (hash_idx != scm_get_bssid_freq_hash(dup_entry->bssid.bytes,
+						dup_entry->channel.chan_freq))
+			dup_node = NULL;
+	}
+	if (!dup_node)
+		qdf_list_insert_back(&scan_db->scan_bssid_freq_tbl[hash_idx],
+				     &scan_node->bssid_freq_node);
+	else
+		qdf_list_insert_before(&scan_db->scan_bssid_freq_tbl[hash_idx],
+				       &scan_node->bssid_freq_node,
+				       &dup_node->bssid_freq_node);
+	qdf_list_insert_back(&scan_db->scan_age_list, &scan_node->age_node);
+
 	scan_db->num_entries++;
 }
 
@@ -463,6 +575,7 @@ static void scm_add_scan_node(struct scan_dbs *scan_db,
  * the list
  * @list: hash list
  * @cur_node: current node pointer
+ * @link: which list of the db @list is
  *
  * API to get next active node from the list. If cur_node is NULL
  * it will return first node of the list.
@@ -472,7 +585,7 @@ static void scm_add_scan_node(struct scan_dbs *scan_db,
  */
 static qdf_list_node_t *
 scm_get_next_valid_node(qdf_list_t *list,
-	qdf_list_node_t *cur_node)
+	qdf_list_node_t *cur_node, enum scm_db_link link)
 {
 	qdf_list_node_t *next_node = NULL;
 	qdf_list_node_t *temp_node = NULL;
@@ -484,8 +597,7 @@ scm_get_next_valid_node(qdf_list_t *list,
 		qdf_list_peek_front(list, &next_node);
 
 	while (next_node) {
-		scan_node = qdf_container_of(next_node,
-			struct scan_cache_node, node);
+		scan_node = scm_link_to_node(next_node, link);
 		if (scan_node->cookie == SCAN_NODE_ACTIVE_COOKIE)
 			return next_node;
 		/*
@@ -501,37 +613,40 @@ scm_get_next_valid_node(qdf_list_t *list,
 }
 
 /**
- * scm_get_next_node() - API get the next scan node from
- * the list
+ * scm_get_next_linked_node() - API get the next scan node from
+ * one of the lists of the db
  * @scan_db: scan data base
- * @list: hash list
+ * @list: list to walk
  * @cur_node: current node pointer
+ * @link: which list of the db @list is
  *
  * API get the next node from the list. If cur_node is NULL
- * it will return first node of the list
+ * it will return first node of the list. A reference is taken on the
+ * returned node and the one on @cur_node is released.
  *
  * Return: next scan cache node
  */
 static struct scan_cache_node *
-scm_get_next_node(struct scan_dbs *scan_db,
-	qdf_list_t *list, struct scan_cache_node *cur_node)
+scm_get_next_linked_node(struct scan_dbs *scan_db, qdf_list_t *list,
+			 struct scan_cache_node *cur_node,
+			 enum scm_db_link link)
 {
 	struct scan_cache_node *next_node = NULL;
 	qdf_list_node_t *next_list = NULL;
 
 	qdf_spin_lock_bh(&scan_db->scan_db_lock);
 	if (cur_node) {
-		next_list = scm_get_next_valid_node(list, &cur_node->node);
+		next_list = scm_get_next_valid_node(list,
+				scm_node_to_link(cur_node, link), link);
 		/* Decrement the ref count of the previous node */
 		scm_scan_entry_put_ref(scan_db,
 			cur_node, false);
 	} else {
-		next_list = scm_get_next_valid_node(list, NULL);
+		next_list = scm_get_next_valid_node(list, NULL, link);
 	}
 	/* Increase the ref count of the obtained node */
 	if (next_list) {
-		next_node = qdf_container_of(next_list,
-			struct scan_cache_node, node);
+		next_node = scm_link_to_node(next_list, link);
 		scm_scan_entry_get_ref(next_node);
 	}
 	qdf_spin_unlock_bh(&scan_db->scan_db_lock);
@@ -540,26 +655,23 @@ scm_get_next_node(struct scan_dbs *scan_db,
 }
 
 /**
- * scm_check_and_age_out() - check and age out the old entries
- * @scan_db: scan db
- * @node: node to check for age out
- * @scan_aging_time: scan cache aging time
+ * scm_get_next_node() - API get the next scan node from
+ * the list
+ * @scan_db: scan data base
+ * @list: hash list
+ * @cur_node: current node pointer
  *
- * Return: void
+ * API get the next node from the list. If cur_node is NULL
+ * it will return first node of the list
+ *
+ * Return: next scan cache node
  */
-static void scm_check_and_age_out(struct scan_dbs *scan_db,
-	struct scan_cache_node *node,
-	qdf_time_t scan_aging_time)
+static struct scan_cache_node *
+scm_get_next_node(struct scan_dbs *scan_db,
+	qdf_list_t *list, struct scan_cache_node *cur_node)
 {
-	if (util_scan_entry_age(node->entry) >=
-	   scan_aging_time) {
-		scm_debug("Aging out BSSID: "QDF_MAC_ADDR_FMT" with age %lu ms",
-			  QDF_MAC_ADDR_REF(node->entry->bssid.bytes),
-			  util_scan_entry_age(node->entry));
-		qdf_spin_lock_bh(&scan_db->scan_db_lock);
-		scm_scan_entry_del(scan_db, node);
-		qdf_spin_unlock_bh(&scan_db->scan_db_lock);
-	}
+	return scm_get_next_linked_node(scan_db, list, cur_node,
+					SCM_DB_LINK_HASH);
 }
 
 static bool scm_bss_is_connected(struct scan_cache_entry *entry)
@@ -573,26 +685,28 @@ static bool scm_bss_is_connected(struct scan_cache_entry *entry)
  * scm_get_conn_node() - Get the scan cache entry node of the connected BSS
  * @scan_db: scan DB pointer
  *
+ * Call must be protected by scan_db->scan_db_lock, no reference is taken
+ * on the returned node.
+ *
  * Return: scan cache entry node of connected BSS if exists, NULL otherwise
  */
 static
 struct scan_cache_node *scm_get_conn_node(struct scan_dbs *scan_db)
 {
-	int i;
-	struct scan_cache_node *cur_node = NULL;
-	struct scan_cache_node *next_node = NULL;
+	qdf_list_node_t *cur_lst = NULL;
+	qdf_list_node_t *next_lst = NULL;
+	struct scan_cache_node *cur_node;
 
-	for (i = 0 ; i < SCAN_HASH_SIZE; i++) {
-		cur_node = scm_get_next_node(scan_db,
-			&scan_db->scan_hash_tbl[i], NULL);
-		while (cur_node) {
-			if (scm_bss_is_connected(cur_node->entry))
-				return cur_node;
-			next_node = scm_get_next_node(scan_db,
-				&scan_db->scan_hash_tbl[i], cur_node);
-			cur_node = next_node;
-			next_node = NULL;
-		}
+	qdf_list_peek_front(&scan_db->scan_age_list, &cur_lst);
+	while (cur_lst) {
+		cur_node = scm_link_to_node(cur_lst, SCM_DB_LINK_AGE);
+		if (cur_node->cookie == SCAN_NODE_ACTIVE_COOKIE &&
+		    scm_bss_is_connected(cur_node->entry))
+			return cur_node;
+
+		qdf_list_peek_next(&scan_db->scan_age_list, cur_lst, &next_lst);
+		cur_lst = next_lst;
+		next_lst = NULL;
 	}
 
 	return NULL;
@@ -614,10 +728,11 @@ scm_bss_is_nontx_of_conn_bss(struct scan_cache_node *conn_node,
 void scm_age_out_entries(struct wlan_objmgr_psoc *psoc,
 	struct scan_dbs *scan_db)
 {
-	int i;
-	struct scan_cache_node *cur_node = NULL;
-	struct scan_cache_node *next_node = NULL;
+	qdf_list_node_t *cur_lst = NULL;
+	qdf_list_node_t *next_lst = NULL;
+	struct scan_cache_node *cur_node;
 	struct scan_cache_node *conn_node = NULL;
+	bool conn_node_found = false;
 	struct scan_default_params *def_param;
 
 	def_param = wlan_scan_psoc_get_def_params(psoc);
@@ -626,84 +741,71 @@ void scm_age_out_entries(struct wlan_objmgr_psoc *psoc,
 		return;
 	}
 
-	conn_node = scm_get_conn_node(scan_db);
-	for (i = 0 ; i < SCAN_HASH_SIZE; i++) {
-		cur_node = scm_get_next_node(scan_db,
-			&scan_db->scan_hash_tbl[i], NULL);
-		while (cur_node) {
-			if (!conn_node /* if there is no connected node */ ||
-			    /* OR cur_node is not part of the MBSSID of the
-			     * connected node
-			     */
-			    (!scm_bss_is_connected(cur_node->entry) &&
-			     !scm_bss_is_nontx_of_conn_bss(conn_node,
-							  cur_node))) {
-				scm_check_and_age_out(scan_db, cur_node,
-					def_param->scan_cache_aging_time);
-			}
-			next_node = scm_get_next_node(scan_db,
-				&scan_db->scan_hash_tbl[i], cur_node);
-			cur_node = next_node;
-			next_node = NULL;
+	/*
+	 * The age list is sorted oldest first, so the walk stops at the first
+	 * entry younger than the aging time and only the expired entries, and
+	 * the connected ones kept alive, are visited. The connected node is
+	 * only looked up once an entry has expired.
+	 */
+	qdf_spin_lock_bh(&scan_db->scan_db_lock);
+	qdf_list_peek_front(&scan_db->scan_age_list, &cur_lst);
+	while (cur_lst) {
+		qdf_list_peek_next(&scan_db->scan_age_list, cur_lst, &next_lst);
+		cur_node = scm_link_to_node(cur_lst, SCM_DB_LINK_AGE);
+		cur_lst = next_lst;
+		next_lst = NULL;
+
+		if (cur_node->cookie != SCAN_NODE_ACTIVE_COOKIE)
+			continue;
+
+		if (util_scan_entry_age(cur_node->entry) <
+		    def_param->scan_cache_aging_time)
+			break;
+
+		if (!conn_node_found) {
+			conn_node = scm_get_conn_node(scan_db);
+			conn_node_found = true;
 		}
-	}
 
-	if (conn_node)
-		scm_scan_entry_put_ref(scan_db, conn_node, true);
+		/*
+		 * Keep the connected node and the nodes of the MBSSID of the
+		 * connected node.
+		 */
+		if (conn_node &&
+		    (scm_bss_is_connected(cur_node->entry) ||
+		     scm_bss_is_nontx_of_conn_bss(conn_node, cur_node)))
+			continue;
+
+		scm_debug("Aging out BSSID: "QDF_MAC_ADDR_FMT" with age %lu ms",
+			  QDF_MAC_ADDR_REF(cur_node->entry->bssid.bytes),
+			  util_scan_entry_age(cur_node->entry));
+		scm_scan_entry_del(scan_db, cur_node);
+	}
+	qdf_spin_unlock_bh(&scan_db->scan_db_lock);
 }
 
 /**
- * scm_flush_oldest_entry() - Iterate over scan db and flust out the
- *  oldest entry
+ * scm_flush_oldest_entry() - Flush out the oldest entry of the scan db
  * @scan_db: scan db from which oldest entry needs to be flushed
  *
  * Return: QDF_STATUS
  */
 static QDF_STATUS scm_flush_oldest_entry(struct scan_dbs *scan_db)
 {
-	int i;
-	struct scan_cache_node *oldest_node = NULL;
-	struct scan_cache_node *cur_node;
-
-	for (i = 0 ; i < SCAN_HASH_SIZE; i++) {
-		/* Get the first valid node for the hash */
-		cur_node = scm_get_next_node(scan_db,
-					     &scan_db->scan_hash_tbl[i],
-					     NULL);
-		 /* Iterate scan db and flush out oldest node
-		  * take ref_cnt for oldest_node
-		  */
-
-		while (cur_node) {
-			if (!oldest_node ||
-			   (util_scan_entry_age(oldest_node->entry) <
-			    util_scan_entry_age(cur_node->entry))) {
-				if (oldest_node)
-					scm_scan_entry_put_ref(scan_db,
-							       oldest_node,
-							       true);
-				qdf_spin_lock_bh(&scan_db->scan_db_lock);
-				oldest_node = cur_node;
-				scm_scan_entry_get_ref(oldest_node);
-				qdf_spin_unlock_bh(&scan_db->scan_db_lock);
-			}
-
-			cur_node = scm_get_next_node(scan_db,
-					&scan_db->scan_hash_tbl[i],
-					cur_node);
-		};
-	}
+	qdf_list_node_t *oldest_lst;
+	struct scan_cache_node *oldest_node;
 
-	if (oldest_node) {
+	qdf_spin_lock_bh(&scan_db->scan_db_lock);
+	oldest_lst = scm_get_next_valid_node(&scan_db->scan_age_list, NULL,
+					     SCM_DB_LINK_AGE);
+	if (oldest_lst) {
+		oldest_node = scm_link_to_node(oldest_lst, SCM_DB_LINK_AGE);
 		scm_debug("Flush oldest BSSID: "QDF_MAC_ADDR_FMT" with age %lu ms",
 			  QDF_MAC_ADDR_REF(oldest_node->entry->bssid.bytes),
 			  util_scan_entry_age(oldest_node->entry));
-		/* Release ref_cnt taken for oldest_node and delete it */
-		qdf_spin_lock_bh(&scan_db->scan_db_lock);
 		scm_scan_entry_del(scan_db, oldest_node);
-		scm_scan_entry_put_ref(scan_db, oldest_node, false);
-		qdf_spin_unlock_bh(&scan_db->scan_db_lock);
 	}
+	qdf_spin_unlock_bh(&scan_db->scan_db_lock);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -1601,6 +1703,85 @@ qdf_list_t *scm_get_scan_result(struct wlan_objmgr_pdev *pdev,
 	return tmp_list;
 }
 
+QDF_STATUS scm_scan_db_iter_start(struct wlan_objmgr_pdev *pdev,
+				  struct scan_filter *filter,
+				  struct scan_db_iter *iter)
+{
+	struct wlan_objmgr_psoc *psoc;
+	struct scan_dbs *scan_db;
+
+	if (!iter) {
+		scm_err("iter is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+	qdf_mem_zero(iter, sizeof(*iter));
+
+	if (!pdev) {
+		scm_err("pdev is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	psoc = wlan_pdev_get_psoc(pdev);
+	if (!psoc) {
+		scm_err("psoc is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	scan_db = wlan_pdev_get_scan_db(psoc, pdev);
+	if (!scan_db) {
+		scm_err("scan_db is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	scm_age_out_entries(psoc, scan_db);
+
+	iter->psoc = psoc;
+	iter->scan_db = scan_db;
+	iter->filter = filter;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+struct scan_cache_entry *scm_scan_db_iter_next(struct scan_db_iter *iter)
+{
+	struct scan_dbs *scan_db = iter->scan_db;
+	struct scan_cache_node *cur_node;
+
+	if (!scan_db)
+		return NULL;
+
+	cur_node = scm_get_next_linked_node(scan_db, &scan_db->scan_age_list,
+					    iter->node, SCM_DB_LINK_AGE);
+	while (cur_node) {
+		qdf_mem_zero(&iter->security, sizeof(iter->security));
+		if (!iter->filter ||
+		    scm_filter_match(iter->psoc, cur_node->entry, iter->filter,
+				     &iter->security))
+			break;
+		cur_node = scm_get_next_linked_node(scan_db,
+						    &scan_db->scan_age_list,
+						    cur_node, SCM_DB_LINK_AGE);
+	}
+
+	iter->node = cur_node;
+	if (!cur_node) {
+		/* Do not restart from the oldest entry on the next call */
+		iter->scan_db = NULL;
+		return NULL;
+	}
+
+	return cur_node->entry;
+}
+
+void scm_scan_db_iter_stop(struct scan_db_iter *iter)
+{
+	if (iter->node)
+		scm_scan_entry_put_ref(iter->scan_db, iter->node, true);
+
+	iter->node = NULL;
+	iter->scan_db = NULL;
+}
+
 /**
  * scm_iterate_db_and_call_func() - iterate and call the func
  * @scan_db: scan db
@@ -1924,6 +2105,10 @@ QDF_STATUS scm_db_init(struct wlan_objmgr_psoc *psoc)
 		for (j = 0; j < SCAN_HASH_SIZE; j++)
 			qdf_list_create(&scan_db->scan_hash_tbl[j],
 				MAX_SCAN_CACHE_SIZE);
+		for (j = 0; j < SCAN_BSSID_FREQ_HASH_SIZE; j++)
+			qdf_list_create(&scan_db->scan_bssid_freq_tbl[j],
+					MAX_SCAN_CACHE_SIZE);
+		qdf_list_create(&scan_db->scan_age_list, MAX_SCAN_CACHE_SIZE);
 		scm_reset_scan_chan_info(psoc, i);
 	}
 	return QDF_STATUS_SUCCESS;
@@ -1950,6 +2135,9 @@ QDF_STATUS scm_db_deinit(struct wlan_objmgr_psoc *psoc)
 		scm_flush_scan_entries(psoc, scan_db, NULL, i);
 		for (j = 0; j < SCAN_HASH_SIZE; j++)
 			qdf_list_destroy(&scan_db->scan_hash_tbl[j]);
+		for (j = 0; j < SCAN_BSSID_FREQ_HASH_SIZE; j++)
+			qdf_list_destroy(&scan_db->scan_bssid_freq_tbl[j]);
+		qdf_list_destroy(&scan_db->scan_age_list);
 		qdf_spinlock_destroy(&scan_db->scan_db_lock);
 	}
 
@@ -2145,6 +2333,7 @@ QDF_STATUS scm_scan_update_mlme_by_bssinfo(struct wlan_objmgr_pdev *pdev,
 {
 	uint8_t hash_idx;
 	struct scan_dbs *scan_db;
+	qdf_list_t *list;
 	struct scan_cache_node *cur_node;
 	struct scan_cache_node *next_node = NULL;
 	struct wlan_objmgr_psoc *psoc;
@@ -2161,9 +2350,11 @@ QDF_STATUS scm_scan_update_mlme_by_bssinfo(struct wlan_objmgr_pdev *pdev,
 		return QDF_STATUS_E_INVAL;
 	}
 
-	hash_idx = SCAN_GET_HASH(bss_info->bssid.bytes);
-	cur_node = scm_get_next_node(scan_db,
-			&scan_db->scan_hash_tbl[hash_idx], NULL);
+	hash_idx = scm_get_bssid_freq_hash(bss_info->bssid.bytes,
+					   bss_info->freq);
+	list = &scan_db->scan_bssid_freq_tbl[hash_idx];
+	cur_node = scm_get_next_linked_node(scan_db, list, NULL,
+					    SCM_DB_LINK_BSSID_FREQ);
 	while (cur_node) {
 		entry = cur_node->entry;
 		if (qdf_is_macaddr_equal(&bss_info->bssid, &entry->bssid) &&
@@ -2182,8 +2373,8 @@ QDF_STATUS scm_scan_update_mlme_by_bssinfo(struct wlan_objmgr_pdev *pdev,
 			qdf_spin_unlock_bh(&scan_db->scan_db_lock);
 			return QDF_STATUS_SUCCESS;
 		}
-		next_node = scm_get_next_node(scan_db,
-				&scan_db->scan_hash_tbl[hash_idx], cur_node);
+		next_node = scm_get_next_linked_node(scan_db, list, cur_node,
+						     SCM_DB_LINK_BSSID_FREQ);
 		cur_node = next_node;
 	}
 
@@ -2213,51 +2404,140 @@ uint32_t scm_get_last_scan_time_per_channel(struct wlan_objmgr_vdev *vdev,
 	return 0;
 }
 
-struct scan_cache_entry *
-scm_scan_get_scan_entry_by_mac_freq(struct wlan_objmgr_pdev *pdev,
-				    struct qdf_mac_addr *bssid,
-				    uint16_t freq)
+/**
+ * scm_scan_get_latest_node() - get the latest scan node of a BSSID
+ * @pdev: pdev info
+ * @bssid: BSSID of the node
+ * @freq: frequency of the node, 0 for any frequency
+ * @scan_db: scan db of @pdev, set if a node is returned
+ * @security: negotiated security of the node, set if a node is returned
+ *
+ * Entries older than the aging time are aged out first, as
+ * scm_get_scan_result() does. Only the hash list @bssid and @freq fall in is
+ * walked, and a node must match the filter scm_get_scan_result() would be
+ * called with. The last node matching in list order is the one
+ * scm_get_scan_result() would return at the front of its list.
+ *
+ * Return: scan node with a reference held, NULL if not found
+ */
+static struct scan_cache_node *
+scm_scan_get_latest_node(struct wlan_objmgr_pdev *pdev,
+			 struct qdf_mac_addr *bssid, uint32_t freq,
+			 struct scan_dbs **scan_db,
+			 struct security_info *security)
 {
+	struct wlan_objmgr_psoc *psoc;
+	struct scan_dbs *db;
 	struct scan_filter *scan_filter;
-	qdf_list_t *list = NULL;
-	struct scan_cache_node *first_node = NULL;
-	qdf_list_node_t *cur_node = NULL;
-	struct scan_cache_entry *scan_entry = NULL;
+	struct security_info cur_security;
+	struct scan_cache_node *cur_node;
+	struct scan_cache_node *latest_node = NULL;
+	enum scm_db_link link;
+	qdf_list_t *list;
+
+	if (!pdev) {
+		scm_err("pdev is NULL");
+		return NULL;
+	}
+
+	psoc = wlan_pdev_get_psoc(pdev);
+	if (!psoc) {
+		scm_err("psoc is NULL");
+		return NULL;
+	}
+
+	db = wlan_pdev_get_scan_db(psoc, pdev);
+	if (!db) {
+		scm_err("scan_db is NULL");
+		return NULL;
+	}
 
 	scan_filter = qdf_mem_malloc(sizeof(*scan_filter));
 	if (!scan_filter)
 		return NULL;
 	scan_filter->num_of_bssid = 1;
-	scan_filter->chan_freq_list[0] = freq;
-	scan_filter->num_of_channels = 1;
 	qdf_copy_macaddr(&scan_filter->bssid_list[0], bssid);
 
-	list = scm_get_scan_result(pdev, scan_filter);
+	if (freq) {
+		scan_filter->chan_freq_list[0] = freq;
+		scan_filter->num_of_channels = 1;
+		link = SCM_DB_LINK_BSSID_FREQ;
+		list = &db->scan_bssid_freq_tbl[
+			scm_get_bssid_freq_hash(bssid->bytes, freq)];
+	} else {
+		link = SCM_DB_LINK_HASH;
+		list = &db->scan_hash_tbl[SCAN_GET_HASH(bssid->bytes)];
+	}
+
+	scm_age_out_entries(psoc, db);
+
+	cur_node = scm_get_next_linked_node(db, list, NULL, link);
+	while (cur_node) {
+		qdf_mem_zero(&cur_security, sizeof(cur_security));
+		if (qdf_is_macaddr_equal(bssid, &cur_node->entry->bssid) &&
+		    scm_filter_match(psoc, cur_node->entry, scan_filter,
+				     &cur_security)) {
+			if (latest_node)
+				scm_scan_entry_put_ref(db, latest_node, true);
+			qdf_spin_lock_bh(&db->scan_db_lock);
+			latest_node = cur_node;
+			scm_scan_entry_get_ref(latest_node);
+			qdf_spin_unlock_bh(&db->scan_db_lock);
+			qdf_mem_copy(security, &cur_security,
+				     sizeof(*security));
+		}
+		cur_node = scm_get_next_linked_node(db, list, cur_node, link);
+	}
 	qdf_mem_free(scan_filter);
-	if (!list || (list && !qdf_list_size(list))) {
+
+	*scan_db = db;
+
+	return latest_node;
+}
+
+/**
+ * scm_scan_copy_latest_entry() - copy the latest scan entry of a BSSID
+ * @pdev: pdev info
+ * @bssid: BSSID of the entry
+ * @freq: frequency of the entry, 0 for any frequency
+ *
+ * Return: copy of the scan entry if found, else NULL
+ */
+static struct scan_cache_entry *
+scm_scan_copy_latest_entry(struct wlan_objmgr_pdev *pdev,
+			   struct qdf_mac_addr *bssid, uint32_t freq)
+{
+	struct scan_dbs *scan_db;
+	struct security_info security;
+	struct scan_cache_node *node;
+	struct scan_cache_entry *scan_entry;
+
+	node = scm_scan_get_latest_node(pdev, bssid, freq, &scan_db,
+					&security);
+	if (!node)
+		return NULL;
+
+	scan_entry = util_scan_copy_cache_entry(node->entry);
+	if (scan_entry)
+		qdf_mem_copy(&scan_entry->neg_sec_info, &security,
+			     sizeof(scan_entry->neg_sec_info));
+	scm_scan_entry_put_ref(scan_db, node, true);
+
+	return scan_entry;
+}
+
+struct scan_cache_entry *
+scm_scan_get_scan_entry_by_mac_freq(struct wlan_objmgr_pdev *pdev,
+				    struct qdf_mac_addr *bssid,
+				    uint16_t freq)
+{
+	struct scan_cache_entry *scan_entry;
+
+	scan_entry = scm_scan_copy_latest_entry(pdev, bssid, freq);
+	if (!scan_entry)
 		scm_debug("Scan entry for bssid:"
 			  QDF_MAC_ADDR_FMT "and freq %d not found",
 			  QDF_MAC_ADDR_REF(bssid->bytes), freq);
-		goto done;
-	}
-	/*
-	 * There might be multiple scan results in the scan db with given mac
-	 * address(e.g. SSID/some capabilities of the AP have just changed and
-	 * old entry is not aged out yet). scm_get_scan_result() inserts the
-	 * latest scan result at the front of the given list. So, it's ok to
-	 * pick scan result from the front node alone.
-	 */
-	qdf_list_peek_front(list, &cur_node);
-	first_node = qdf_container_of(cur_node,
-				      struct scan_cache_node,
-				      node);
-
-	if (first_node && first_node->entry)
-		scan_entry = util_scan_copy_cache_entry(first_node->entry);
-
-done:
-	if (list)
-		scm_purge_scan_results(list);
 
 	return scan_entry;
 }
@@ -2267,49 +2547,23 @@ scm_scan_get_entry_by_mac_addr(struct wlan_objmgr_pdev *pdev,
 			       struct qdf_mac_addr *bssid,
 			       struct element_info *frame)
 {
-	struct scan_filter *scan_filter;
-	qdf_list_t *list = NULL;
-	struct scan_cache_node *first_node = NULL;
-	qdf_list_node_t *cur_node = NULL;
+	struct scan_dbs *scan_db;
+	struct security_info security;
+	struct scan_cache_node *node;
 	QDF_STATUS status = QDF_STATUS_SUCCESS;
 
-	scan_filter = qdf_mem_malloc(sizeof(*scan_filter));
-	if (!scan_filter)
-		return QDF_STATUS_E_NOMEM;
-	scan_filter->num_of_bssid = 1;
-	qdf_copy_macaddr(&scan_filter->bssid_list[0], bssid);
-	list = scm_get_scan_result(pdev, scan_filter);
-	qdf_mem_free(scan_filter);
-	if (!list || (list && !qdf_list_size(list))) {
-		status = QDF_STATUS_E_INVAL;
-		goto done;
-	}
-	/*
-	 * There might be multiple scan results in the scan db with given mac
-	 * address(e.g. SSID/some capabilities of the AP have just changed and
-	 * old entry is not aged out yet). scm_get_scan_result() inserts the
-	 * latest scan result at the front of the given list. So, it's ok to
-	 * pick scan result from the front node alone.
-	 */
-	qdf_list_peek_front(list, &cur_node);
-	first_node = qdf_container_of(cur_node,
-				      struct scan_cache_node,
-				      node);
-	if (first_node && first_node->entry) {
-		frame->len = first_node->entry->raw_frame.len;
-		frame->ptr = qdf_mem_malloc(frame->len);
-		if (!frame->ptr) {
-			status = QDF_STATUS_E_NOMEM;
-			goto done;
-		}
-		qdf_mem_copy(frame->ptr,
-			     first_node->entry->raw_frame.ptr,
-			     frame->len);
-	}
+	node = scm_scan_get_latest_node(pdev, bssid, 0, &scan_db, &security);
+	if (!node)
+		return QDF_STATUS_E_INVAL;
 
-done:
-	if (list)
-		scm_purge_scan_results(list);
+	frame->len = node->entry->raw_frame.len;
+	frame->ptr = qdf_mem_malloc(frame->len);
+	if (!frame->ptr)
+		status = QDF_STATUS_E_NOMEM;
+	else
+		qdf_mem_copy(frame->ptr, node->entry->raw_frame.ptr,
+			     frame->len);
+	scm_scan_entry_put_ref(scan_db, node, true);
 
 	return status;
 }
@@ -2346,41 +2600,15 @@ struct scan_cache_entry *
 scm_scan_get_entry_by_bssid(struct wlan_objmgr_pdev *pdev,
 			    struct qdf_mac_addr *bssid)
 {
-	struct scan_filter *scan_filter;
-	qdf_list_t *list = NULL;
-	struct scan_cache_node *first_node = NULL;
-	qdf_list_node_t *cur_node = NULL;
-	struct scan_cache_entry *entry = NULL, *scan_entry = NULL;
+	struct scan_cache_entry *scan_entry;
 
 	if (!pdev)
 		return NULL;
 
-	scan_filter = qdf_mem_malloc(sizeof(*scan_filter));
-	if (!scan_filter)
-		return NULL;
-
-	scan_filter->num_of_bssid = 1;
-	qdf_mem_copy(scan_filter->bssid_list[0].bytes,
-		     bssid, sizeof(struct qdf_mac_addr));
-	list = scm_get_scan_result(pdev, scan_filter);
-	qdf_mem_free(scan_filter);
-
-	if (!list || (!qdf_list_size(list))) {
+	scan_entry = scm_scan_copy_latest_entry(pdev, bssid, 0);
+	if (!scan_entry)
 		scm_debug("Scan entry for bssid: "QDF_MAC_ADDR_FMT" not found",
 			  QDF_MAC_ADDR_REF(bssid->bytes));
-		goto exit;
-	}
-
-	qdf_list_peek_front(list, &cur_node);
-	first_node = qdf_container_of(cur_node, struct scan_cache_node,
-				      node);
-	if (first_node && first_node->entry) {
-		entry = first_node->entry;
-		scan_entry = util_scan_copy_cache_entry(entry);
-	}
-exit:
-	if (list)
-		scm_purge_scan_results(list);
 
 	return scan_entry;
 }
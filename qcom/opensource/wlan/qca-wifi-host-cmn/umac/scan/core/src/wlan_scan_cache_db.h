@@ -34,19 +34,27 @@
 #define SCAN_GET_HASH(addr) \
 	(((const uint8_t *)(addr))[QDF_MAC_ADDR_SIZE - 1] % SCAN_HASH_SIZE)
 
+#define SCAN_BSSID_FREQ_HASH_SIZE 256
+
 #define ADJACENT_CHANNEL_RSSI_THRESHOLD -80
 #define ADJACENT_CHANNEL_RSSI_DIFF_THRESHOLD 40
 
 /**
  * struct scan_dbs - scan cache data base definition
  * @num_entries: number of scan entries
- * @scan_db_lock: lock for @scan_hash_tbl
+ * @scan_db_lock: lock for @scan_hash_tbl, @scan_bssid_freq_tbl and
+ *                @scan_age_list
  * @scan_hash_tbl: link list of bssid hashed scan cache entries for a pdev
+ * @scan_bssid_freq_tbl: link list of bssid and frequency hashed scan cache
+ *                       entries for a pdev
+ * @scan_age_list: scan cache entries of a pdev, oldest first
  */
 struct scan_dbs {
 	uint32_t num_entries;
 	qdf_spinlock_t scan_db_lock;
 	qdf_list_t scan_hash_tbl[SCAN_HASH_SIZE];
+	qdf_list_t scan_bssid_freq_tbl[SCAN_BSSID_FREQ_HASH_SIZE];
+	qdf_list_t scan_age_list;
 };
 
 /**
@@ -109,6 +117,43 @@ void scm_age_out_entries(struct wlan_objmgr_psoc *psoc,
 qdf_list_t *scm_get_scan_result(struct wlan_objmgr_pdev *pdev,
 	struct scan_filter *filter);
 
+/**
+ * scm_scan_db_iter_start() - start a zero-copy iteration of the scan db
+ * @pdev: pdev info
+ * @filter: filter the entries must match, NULL for all entries
+ * @iter: iterator to initialize
+ *
+ * Entries older than the aging time are aged out first. @filter must stay
+ * valid until scm_scan_db_iter_stop() is called.
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS scm_scan_db_iter_start(struct wlan_objmgr_pdev *pdev,
+				  struct scan_filter *filter,
+				  struct scan_db_iter *iter);
+
+/**
+ * scm_scan_db_iter_next() - get the next entry of a scan db iteration
+ * @iter: iterator from scm_scan_db_iter_start()
+ *
+ * The entries are returned oldest first. The entry returned is not a copy:
+ * it stays valid, and must not be modified, until the next call to
+ * scm_scan_db_iter_next() or scm_scan_db_iter_stop().
+ *
+ * Return: next scan entry matching the filter, NULL at the end
+ */
+struct scan_cache_entry *scm_scan_db_iter_next(struct scan_db_iter *iter);
+
+/**
+ * scm_scan_db_iter_stop() - stop a scan db iteration
+ * @iter: iterator from scm_scan_db_iter_start()
+ *
+ * Releases the entry returned last, if any.
+ *
+ * Return: void
+ */
+void scm_scan_db_iter_stop(struct scan_db_iter *iter);
+
 /**
  * scm_purge_scan_results() - purge the scan list
  * @scan_result: scan list to be purged
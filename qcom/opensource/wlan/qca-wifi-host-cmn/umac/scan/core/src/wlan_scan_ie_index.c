@@ -0,0 +1,635 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * DOC: contains the IE index of a beacon/probe response and the generation
+ * of nontransmitted BSSID profiles from it
+ */
+
+#include <qdf_types.h>
+#include <qdf_mem.h>
+#include <wlan_scan_public_structs.h>
+#ifdef WLAN_FEATURE_ACTION_OUI
+#include <wlan_action_oui_main.h>
+#include <wlan_action_oui_public_struct.h>
+#endif
+#include "wlan_scan_main.h"
+#include "wlan_scan_ie_index.h"
+
+struct scm_ie_index *scm_ie_index_alloc(uint32_t max_len)
+{
+	struct scm_ie_index *index;
+	uint32_t max_ies;
+
+	max_ies = max_len / MIN_IE_LEN + 1;
+	if (max_ies > SCM_IE_INDEX_INVALID)
+		max_ies = SCM_IE_INDEX_INVALID;
+
+	index = qdf_mem_malloc(sizeof(*index) +
+			       max_ies * sizeof(*index->entry));
+	if (!index)
+		return NULL;
+
+	index->entry = (struct scm_ie_index_entry *)(index + 1);
+	index->max_ies = max_ies;
+
+	return index;
+}
+
+void scm_ie_index_free(struct scm_ie_index *index)
+{
+	qdf_mem_free(index);
+}
+
+void scm_ie_index_build(struct scm_ie_index *index, uint8_t *ies,
+			uint32_t len)
+{
+	struct scm_ie_index_entry *entry = index->entry;
+	uint32_t offset = 0;
+	uint16_t pos;
+	uint8_t eid;
+
+	index->ies = ies;
+	index->len = len;
+	index->num_ies = 0;
+	qdf_mem_set(index->first, sizeof(index->first), 0xff);
+
+	while ((len - offset) >= MIN_IE_LEN &&
+	       (len - offset) >=
+	       (uint32_t)ies[offset + TAG_LEN_POS] + MIN_IE_LEN &&
+	       index->num_ies < index->max_ies) {
+		entry[index->num_ies].offset = offset;
+		entry[index->num_ies].taken = false;
+		index->num_ies++;
+		offset += ies[offset + TAG_LEN_POS] + MIN_IE_LEN;
+	}
+
+	/* Link the IEs sharing an element ID, in list order */
+	for (pos = index->num_ies; pos-- > 0;) {
+		eid = ies[entry[pos].offset];
+		entry[pos].next = index->first[eid];
+		index->first[eid] = pos;
+	}
+}
+
+void scm_ie_index_take(struct scm_ie_index *index, uint16_t pos)
+{
+	struct scm_ie_index_entry *entry = index->entry;
+	uint16_t *link;
+
+	if (entry[pos].taken)
+		return;
+
+	entry[pos].taken = true;
+	link = &index->first[index->ies[entry[pos].offset]];
+	while (*link != pos)
+		link = &entry[*link].next;
+	*link = entry[pos].next;
+}
+
+#ifdef WLAN_FEATURE_MBSSID
+/*
+ * util_is_noninh_ie() - find the noninhertance information element
+ * in the received frame's IE list, so that we can stop inheriting that IE
+ * in the caller function.
+ *
+ * @elem_id: Element ID in the received frame's IE, which is being processed.
+ * @non_inh_list: pointer to the non inherited list of element IDs or
+ *                list of extension element IDs.
+ * @len: Length of non inheritance IE list
+ *
+ * Return: False if the element ID is not found or else return true
+ */
+static bool util_is_noninh_ie(uint8_t elem_id,
+			      const uint8_t *non_inh_list,
+			      int8_t len)
+{
+	int count;
+
+	for (count = 0; count < len; count++) {
+		if (elem_id == non_inh_list[count])
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * util_parse_noninheritance_list() - This block of code will be executed only
+ * if there is a valid non inheritance IE present in the nontx profile.
+ * Host need not inherit those list of element IDs and list of element ID
+ * extensions from the transmitted BSSID profile.
+ * Since non-inheritance element is an element ID extension, it should
+ * be part of extension element. So first we need to find if there are
+ * any extension element present in the nontransmitted BSSID profile.
+ * @extn_elem: If valid, it points to the element ID field of
+ * extension element tag in the nontransmitted BSSID profile.
+ * It may or may not have non inheritance tag present.
+ *      _____________________________________________
+ *     |         |       |       |List of|List of    |
+ *     | Element |Length |Element|Element|Element ID |
+ *     |  ID     |       |ID extn| IDs   |Extension  |
+ *     |_________|_______|_______|_______|___________|
+ * List of Element IDs:
+ *      __________________
+ *     |         |        |
+ *     |  Length |Element |
+ *     |         |ID List |
+ *     |_________|________|
+ * List of Element ID Extensions:
+ *      __________________________
+ *     |         |                |
+ *     |  Length |Element ID      |
+ *     |         |extension List  |
+ *     |_________|________________|
+ * @elem_list: Element ID list
+ * @extn_elem_list: Element ID exiension list
+ * @ninh: Non inheritance IE information
+ *
+ * Return: true if the element is corrupt and is not to be copied to the
+ * frame of the nontransmitted BSSID, else false
+ */
+static bool util_parse_noninheritance_list(const uint8_t *extn_elem,
+					   const uint8_t **elem_list,
+					   const uint8_t **extn_elem_list,
+					   struct non_inheritance_ie *ninh)
+{
+	int8_t extn_rem_len = 0;
+	bool corrupt = false;
+
+	if (extn_elem[ELEM_ID_LIST_LEN_POS] < extn_elem[TAG_LEN_POS]) {
+		/*
+		 * extn_rem_len represents the number of bytes after
+		 * the length subfield of list of Element IDs.
+		 * So here, extn_rem_len should be equal to
+		 * Element ID list + Length subfield of Element ID
+		 * extension list + Element ID extension list.
+		 *
+		 * Here we have taken two pointers pointing to the
+		 * element ID list and element ID extension list
+		 * which we will use to detect the same elements
+		 * in the transmitted BSSID profile and choose not
+		 * to inherit those elements while constructing the
+		 * frame for nontransmitted BSSID profile.
+		 */
+		extn_rem_len = extn_elem[TAG_LEN_POS] - MIN_IE_LEN;
+		ninh->non_inherit = true;
+
+		if (extn_rem_len && extn_elem[ELEM_ID_LIST_LEN_POS]) {
+			if (extn_rem_len >= extn_elem[ELEM_ID_LIST_LEN_POS]) {
+				ninh->list_len =
+					extn_elem[ELEM_ID_LIST_LEN_POS];
+				*elem_list = extn_elem + ELEM_ID_LIST_POS;
+				extn_rem_len -= ninh->list_len;
+			} else {
+				/*
+				 * Corrupt frame. length subfield of
+				 * element ID list is greater than
+				 * what it should be. Go ahead with
+				 * frame generation but do not honour
+				 * the non inheritance part. Also, let
+				 * the caller know that this element
+				 * info is not to be copied.
+				 */
+				ninh->non_inherit = false;
+				corrupt = true;
+			}
+		}
+
+		extn_rem_len--;
+		if (extn_rem_len > 0) {
+			if (!ninh->list_len) {
+				ninh->extn_len =
+					extn_elem[ELEM_ID_LIST_LEN_POS + 1];
+			} else {
+				ninh->extn_len =
+					extn_elem[ELEM_ID_LIST_POS +
+					ninh->list_len];
+			}
+
+			if (extn_rem_len != ninh->extn_len) {
+				/*
+				 * Corrupt frame. length subfield of
+				 * element ID extn list is not
+				 * what it should be. Go ahead with
+				 * frame generation but do not honour
+				 * the non inheritance part. Also, let
+				 * the caller know that this element
+				 * info is not to be copied.
+				 */
+				ninh->non_inherit = false;
+				corrupt = true;
+			}
+
+			if (ninh->extn_len) {
+				*extn_elem_list =
+					(extn_elem + ninh->list_len +
+					 ELEM_ID_LIST_POS + 1);
+			}
+		}
+	}
+
+	return corrupt;
+}
+
+#ifdef WLAN_FEATURE_11BE_MLO
+/**
+ * util_handle_rnr_ie_for_mbssid() - parse and modify RNR IE for MBSSID feature
+ * @rnr: The pointer to RNR IE
+ * @bssid_index: BSSID index from MBSSID index IE
+ * @pos: The buffer pointer to save the transformed RNR IE, caller is expected
+ *       to supply a buffer that is at least as big as @rnr
+ *
+ * Per the description about Neighbor AP Information field about MLD
+ * parameters subfield in section 9.4.2.170.2 of Draft P802.11be_D1.4.
+ * If the reported AP is affiliated with the same MLD of the reporting AP,
+ * the TBTT information is skipped; If the reported AP is affiliated with
+ * the same MLD of the nontransmitted BSSID, the TBTT information is
+ * copied and the MLD ID is changed to 0.
+ *
+ * Return: Length of the element written to @pos
+ */
+static int util_handle_rnr_ie_for_mbssid(const uint8_t *rnr,
+					 uint8_t bssid_index, uint8_t *pos)
+{
+	size_t rnr_len;
+	const uint8_t *data, *rnr_end;
+	uint8_t *rnr_new;
+	struct neighbor_ap_info_field *neighbor_ap_info;
+	struct rnr_mld_info *mld_param;
+	uint8_t tbtt_type, tbtt_len, tbtt_count;
+	uint8_t mld_pos, mld_id;
+	int32_t i, copy_len;
+	/* The count of TBTT info field whose MLD ID equals to 0 in a neighbor
+	 * AP information field.
+	 */
+	uint32_t tbtt_info_field_count;
+	/* The total bytes of TBTT info fields whose MLD ID equals to 0 in
+	 * current RNR IE.
+	 */
+	uint32_t tbtt_info_field_len = 0;
+	uint8_t nbr_ap_info_len = sizeof(struct neighbor_ap_info_field);
+
+	rnr_len = rnr[TAG_LEN_POS];
+	rnr_end = rnr + rnr_len + MIN_IE_LEN;
+	rnr_new = pos;
+	qdf_mem_copy(pos, rnr, MIN_IE_LEN);
+	pos += MIN_IE_LEN;
+
+	data = rnr + PAYLOAD_START_POS;
+	while (data + sizeof(struct neighbor_ap_info_field) <= rnr_end) {
+		neighbor_ap_info = (struct neighbor_ap_info_field *)data;
+		tbtt_count = neighbor_ap_info->tbtt_header.tbtt_info_count;
+		tbtt_len = neighbor_ap_info->tbtt_header.tbtt_info_length;
+		tbtt_type = neighbor_ap_info->tbtt_header.tbbt_info_fieldtype;
+		scm_debug("channel number %d, op class %d, bssid_index %d",
+			  neighbor_ap_info->channel_number,
+			  neighbor_ap_info->operting_class, bssid_index);
+		scm_debug("tbtt_count %d, tbtt_length %d, tbtt_type %d",
+			  tbtt_count, tbtt_len, tbtt_type);
+
+		copy_len = tbtt_len * (tbtt_count + 1) +
+			   nbr_ap_info_len;
+		if (data + copy_len > rnr_end)
+			return 0;
+
+		if (tbtt_len >=
+		    TBTT_NEIGHBOR_AP_BSSID_S_SSID_BSS_PARAM_20MHZ_PSD_MLD_PARAM)
+			mld_pos =
+			     TBTT_NEIGHBOR_AP_BSSID_S_SSID_BSS_PARAM_20MHZ_PSD;
+		else
+			mld_pos = 0;
+
+		/* If MLD params do not exist, copy this neighbor AP
+		 * information field.
+		 * Per Draft P802.11be_D1.4, tbtt_type value 1, 2 and 3
+		 * are reserved,
+		 */
+		if (mld_pos == 0 || tbtt_type != 0) {
+			scm_debug("no MLD params, tbtt_type %d", tbtt_type);
+			qdf_mem_copy(pos, data, copy_len);
+			pos += copy_len;
+			data += copy_len;
+			continue;
+		}
+
+		qdf_mem_copy(pos, data, nbr_ap_info_len);
+		neighbor_ap_info = (struct neighbor_ap_info_field *)pos;
+		pos += nbr_ap_info_len;
+		data += nbr_ap_info_len;
+
+		tbtt_info_field_count = 0;
+		for (i = 0; i < tbtt_count + 1; i++) {
+			mld_param = (struct rnr_mld_info *)&data[mld_pos];
+			mld_id = mld_param->mld_id;
+
+			/* Refer to Draft P802.11be_D1.4
+			 * 9.4.2.170.2 Neighbor AP Information field about
+			 * MLD parameters subfield
+			 */
+			if (mld_id == 0) {
+				/* Skip this TBTT information since this
+				 * reported AP is affiliated with the same MLD
+				 * of the reporting AP who sending the frame
+				 * carrying this element.
+				 */
+				tbtt_info_field_len += tbtt_len;
+				data += tbtt_len;
+				tbtt_info_field_count++;
+			} else if (mld_id == bssid_index) {
+				/* Copy this TBTT information and change MLD
+				 * to 0 as this reported AP is affiliated with
+				 * the same MLD of the nontransmitted BSSID.
+				 */
+				qdf_mem_copy(pos, data, tbtt_len);
+				mld_param =
+					(struct rnr_mld_info *)&pos[mld_pos];
+				scm_debug("change MLD ID from %d to 0",
+					  mld_param->mld_id);
+				mld_param->mld_id = 0;
+				data += tbtt_len;
+				pos += tbtt_len;
+			} else {
+				qdf_mem_copy(pos, data, tbtt_len);
+				data += tbtt_len;
+				pos += tbtt_len;
+			}
+		}
+
+		scm_debug("skip %d neighbor info", tbtt_info_field_count);
+		if (tbtt_info_field_count == (tbtt_count + 1)) {
+			/* If all the TBTT information are skipped, then also
+			 * revert the neighbor AP info which has been copied.
+			 */
+			pos -= nbr_ap_info_len;
+			tbtt_info_field_len += nbr_ap_info_len;
+		} else {
+			neighbor_ap_info->tbtt_header.tbtt_info_count -=
+							tbtt_info_field_count;
+		}
+	}
+
+	rnr_new[TAG_LEN_POS] = rnr_len - tbtt_info_field_len;
+	if (rnr_new[TAG_LEN_POS] > 0)
+		rnr_len = rnr_new[TAG_LEN_POS] + MIN_IE_LEN;
+	else
+		rnr_len = 0;
+
+	return rnr_len;
+}
+#else
+static int util_handle_rnr_ie_for_mbssid(const uint8_t *rnr,
+					 uint8_t bssid_index, uint8_t *pos)
+{
+	return 0;
+}
+#endif
+
+#ifdef WLAN_FEATURE_ACTION_OUI
+static uint8_t *util_copy_reporting_ap_vendor_ies(struct wlan_objmgr_psoc *psoc,
+						  const uint8_t *ie,
+						  uint32_t ie_len,
+						  uint8_t *buf_ie)
+{
+	struct action_oui_search_attr attr = {0};
+	enum action_oui_id oui_id = ACTION_OUI_RESTRICT_MAX_MLO_LINKS;
+
+	attr.ie_data = (uint8_t *)ie;
+	attr.ie_length = ie_len;
+
+	if (wlan_action_oui_search(psoc, &attr, oui_id)) {
+		qdf_mem_copy(buf_ie, ie, ie_len);
+		buf_ie += ie_len;
+	}
+
+	return buf_ie;
+}
+#else
+static inline uint8_t *
+util_copy_reporting_ap_vendor_ies(struct wlan_objmgr_psoc *psoc,
+				  const uint8_t *ie, uint32_t ie_len,
+				  uint8_t *buf_ie)
+{
+	return buf_ie;
+}
+#endif
+
+uint32_t scm_mbssid_gen_new_ie(struct wlan_objmgr_psoc *psoc,
+			       struct scm_ie_index *tx_index,
+			       struct scm_ie_index *prof_index,
+			       uint8_t *subelement, uint32_t subie_len,
+			       uint8_t *new_ie, uint8_t bssid_index)
+{
+	uint8_t *ie = tx_index->ies;
+	uint32_t ielen = tx_index->len;
+	uint8_t *pos, *tmp, *tmp_old, *extn_elem = NULL;
+	const uint8_t *elem_list = NULL, *extn_elem_list = NULL;
+	struct non_inheritance_ie ninh = {0};
+	uint16_t old_pos, sub_pos;
+	uint32_t old_offset;
+	size_t tmp_rem_len;
+
+	/*
+	 * The profile is indexed rather than copied: the IEs that get
+	 * merged into new_ie are marked as taken in the index, instead of
+	 * clearing their element ID in a copy of the profile.
+	 */
+	scm_ie_index_build(prof_index, subelement, subie_len);
+
+	pos = &new_ie[0];
+
+	/* new ssid */
+	tmp = scm_ie_index_find(prof_index, WLAN_ELEMID_SSID);
+	if (tmp) {
+		scm_debug(" SSID " QDF_SSID_FMT,
+			  QDF_SSID_REF(tmp[1], &tmp[PAYLOAD_START_POS]));
+		if ((pos + tmp[1] + MIN_IE_LEN) <= (new_ie + ielen)) {
+			qdf_mem_copy(pos, tmp, (tmp[1] + MIN_IE_LEN));
+			pos += (tmp[1] + MIN_IE_LEN);
+		}
+	}
+
+	for (sub_pos = scm_ie_index_first(prof_index, WLAN_ELEMID_EXTN_ELEM);
+	     sub_pos != SCM_IE_INDEX_INVALID;
+	     sub_pos = scm_ie_index_next(prof_index, sub_pos)) {
+		extn_elem = scm_ie_index_ie(prof_index, sub_pos);
+		if (extn_elem[TAG_LEN_POS] &&
+		    extn_elem[ELEM_ID_EXTN_POS] ==
+		    WLAN_EXTN_ELEMID_NONINHERITANCE)
+			break;
+	}
+
+	if (sub_pos != SCM_IE_INDEX_INVALID &&
+	    extn_elem[TAG_LEN_POS] >= VALID_ELEM_LEAST_LEN) {
+		if (util_parse_noninheritance_list(extn_elem, &elem_list,
+						   &extn_elem_list, &ninh))
+			scm_ie_index_take(prof_index, sub_pos);
+	}
+
+	/* go through IEs in ie (skip SSID) and subelement,
+	 * merge them into new_ie
+	 */
+	old_pos = scm_ie_index_first(tx_index, WLAN_ELEMID_SSID);
+	if (old_pos == SCM_IE_INDEX_INVALID) {
+		old_pos = 0;
+		old_offset = 0;
+	} else {
+		tmp_old = scm_ie_index_ie(tx_index, old_pos);
+		old_offset = tx_index->entry[old_pos].offset +
+			     tmp_old[TAG_LEN_POS] + MIN_IE_LEN;
+		old_pos++;
+	}
+
+	if ((old_offset + MIN_IE_LEN) >= ielen)
+		return 0;
+
+	for (; old_pos < tx_index->num_ies; old_pos++) {
+		tmp_old = scm_ie_index_ie(tx_index, old_pos);
+		if ((tmp_old - ie) + MIN_IE_LEN >= ielen)
+			break;
+
+		ninh.non_inh_ie_found = 0;
+		if (ninh.non_inherit) {
+			if (ninh.list_len) {
+				ninh.non_inh_ie_found =
+					util_is_noninh_ie(tmp_old[0],
+							  elem_list,
+							  ninh.list_len);
+			}
+
+			if (!ninh.non_inh_ie_found &&
+			    ninh.extn_len &&
+			    (tmp_old[0] == WLAN_ELEMID_EXTN_ELEM)) {
+				ninh.non_inh_ie_found =
+					util_is_noninh_ie(tmp_old[2],
+							  extn_elem_list,
+							  ninh.extn_len);
+			}
+		}
+
+		if (ninh.non_inh_ie_found || (tmp_old[0] == 0))
+			continue;
+
+		sub_pos = scm_ie_index_first(prof_index, tmp_old[0]);
+		if (sub_pos == SCM_IE_INDEX_INVALID) {
+			/* ie in old ie but not in subelement */
+			if (tmp_old[0] == WLAN_ELEMID_REDUCED_NEIGHBOR_REPORT) {
+				/* handle rnr ie for mbssid*/
+				pos +=
+				    util_handle_rnr_ie_for_mbssid(tmp_old,
+								  bssid_index,
+								  pos);
+			} else if (tmp_old[0] != WLAN_ELEMID_MULTIPLE_BSSID) {
+				if ((pos + tmp_old[1] + MIN_IE_LEN) <=
+				    (new_ie + ielen)) {
+					qdf_mem_copy(pos, tmp_old,
+						     (tmp_old[1] +
+						      MIN_IE_LEN));
+					pos += tmp_old[1] + MIN_IE_LEN;
+				}
+			}
+			continue;
+		}
+
+		/* ie in transmitting ie also in subelement,
+		 * copy from subelement and take the ie in subelement
+		 * out of the index as copied.
+		 * To determine if the vendor ies are same:
+		 * 1. For Cisco OUI, compare only OUI + type
+		 * 2. For other OUI, compare OUI + type + subType
+		 */
+		tmp = scm_ie_index_ie(prof_index, sub_pos);
+		tmp_rem_len = subie_len - (tmp - subelement);
+		if (tmp_old[0] == WLAN_ELEMID_VENDOR &&
+		    tmp_rem_len >= MIN_VENDOR_TAG_LEN) {
+			/*
+			 * In order to identify few Vendor APs the
+			 * generated frame should contain the reporting
+			 * APs matching VSIE or else the entry generated
+			 * will not have this VSIE and logic kept to
+			 * take certain action on specific Vendor APs
+			 * will fail.
+			 */
+			pos = util_copy_reporting_ap_vendor_ies(psoc, tmp_old,
+								tmp_old[1] +
+								MIN_IE_LEN,
+								pos);
+			/* If Vendor IE also presents in STA profile,
+			 * then ignore the Vendor IE which is for
+			 * reporting STA. It only needs to copy Vendor
+			 * IE from STA profile for reported BSSID.
+			 * The copy happens when going through the
+			 * remaining IEs.
+			 */
+		} else if (tmp_old[0] == WLAN_ELEMID_EXTN_ELEM &&
+			   tmp_rem_len >= (MIN_IE_LEN + 1)) {
+			if (tmp_old[PAYLOAD_START_POS] ==
+			    tmp[PAYLOAD_START_POS]) {
+				/* same ie, copy from subelement */
+				if ((pos + tmp[1] + MIN_IE_LEN) <=
+				    (new_ie + ielen)) {
+					qdf_mem_copy(pos, tmp,
+						     tmp[1] + MIN_IE_LEN);
+					pos += tmp[1] + MIN_IE_LEN;
+					scm_ie_index_take(prof_index, sub_pos);
+				}
+			} else {
+				if ((pos + tmp_old[1] + MIN_IE_LEN) <=
+				    (new_ie + ielen)) {
+					qdf_mem_copy(pos, tmp_old,
+						     tmp_old[1] + MIN_IE_LEN);
+					pos += tmp_old[1] + MIN_IE_LEN;
+				}
+			}
+		} else {
+			/* copy ie from subelement into new ie */
+			if ((pos + tmp[1] + MIN_IE_LEN) <= (new_ie + ielen)) {
+				qdf_mem_copy(pos, tmp, tmp[1] + MIN_IE_LEN);
+				pos += tmp[1] + MIN_IE_LEN;
+				scm_ie_index_take(prof_index, sub_pos);
+			}
+		}
+	}
+
+	/* go through subelement again to check if there is any ie not
+	 * copied to new ie, skip ssid, capability, bssid-index ie
+	 */
+	for (sub_pos = 0; sub_pos < prof_index->num_ies; sub_pos++) {
+		if (prof_index->entry[sub_pos].taken)
+			continue;
+
+		tmp = scm_ie_index_ie(prof_index, sub_pos);
+		if (tmp[0] == WLAN_ELEMID_NONTX_BSSID_CAP ||
+		    tmp[0] == WLAN_ELEMID_SSID ||
+		    tmp[0] == WLAN_ELEMID_MULTI_BSSID_IDX ||
+		    ((tmp[0] == WLAN_ELEMID_EXTN_ELEM) && tmp[1] &&
+		     (tmp[2] == WLAN_EXTN_ELEMID_NONINHERITANCE)))
+			continue;
+
+		if ((pos + tmp[1] + MIN_IE_LEN) <= (new_ie + ielen)) {
+			qdf_mem_copy(pos, tmp, tmp[1] + MIN_IE_LEN);
+			pos += tmp[1] + MIN_IE_LEN;
+		}
+	}
+
+	if (pos > new_ie)
+		return pos - new_ie;
+	else
+		return 0;
+}
+#endif
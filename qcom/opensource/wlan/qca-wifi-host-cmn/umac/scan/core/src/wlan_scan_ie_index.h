@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * DOC: contains the IE index of a beacon/probe response and the generation
+ * of nontransmitted BSSID profiles from it
+ */
+
+#ifndef _WLAN_SCAN_IE_INDEX_H_
+#define _WLAN_SCAN_IE_INDEX_H_
+
+#include <qdf_types.h>
+#include <wlan_objmgr_psoc_obj.h>
+#include <wlan_scan_public_structs.h>
+
+#define SCM_IE_INDEX_NUM_EID 256
+#define SCM_IE_INDEX_INVALID 0xffff
+
+/**
+ * struct scm_ie_index_entry - one IE of an indexed IE list
+ * @offset: offset of the element ID of the IE from the start of the list
+ * @next: position of the next IE with the same element ID, or
+ *        SCM_IE_INDEX_INVALID
+ * @taken: IE has been consumed and is no longer returned by lookups
+ */
+struct scm_ie_index_entry {
+	uint16_t offset;
+	uint16_t next;
+	bool taken;
+};
+
+/**
+ * struct scm_ie_index - IE list indexed by element ID in a single pass
+ * @ies: IE list, not owned by the index
+ * @len: length of @ies
+ * @num_ies: number of complete IEs found in @ies
+ * @max_ies: number of IEs the index can hold
+ * @first: position of the first IE not taken yet, per element ID
+ * @entry: IEs in the order they appear in @ies
+ *
+ * An IE is complete, and indexed, if its header and its payload both fit in
+ * @len. The walk stops at the first IE that does not, as util_scan_find_ie()
+ * does.
+ */
+struct scm_ie_index {
+	uint8_t *ies;
+	uint32_t len;
+	uint16_t num_ies;
+	uint16_t max_ies;
+	uint16_t first[SCM_IE_INDEX_NUM_EID];
+	struct scm_ie_index_entry *entry;
+};
+
+/**
+ * scm_ie_index_alloc() - allocate an IE index
+ * @max_len: length of the longest IE list the index is built for
+ *
+ * Return: IE index on success, NULL on failure
+ */
+struct scm_ie_index *scm_ie_index_alloc(uint32_t max_len);
+
+/**
+ * scm_ie_index_free() - free an IE index
+ * @index: IE index from scm_ie_index_alloc()
+ *
+ * Return: none
+ */
+void scm_ie_index_free(struct scm_ie_index *index);
+
+/**
+ * scm_ie_index_build() - index an IE list
+ * @index: IE index, the previous content is discarded
+ * @ies: IE list
+ * @len: length of @ies, at most the max_len @index was allocated for
+ *
+ * Walks @ies once and records the offset of every complete IE in it.
+ *
+ * Return: none
+ */
+void scm_ie_index_build(struct scm_ie_index *index, uint8_t *ies,
+			uint32_t len);
+
+/**
+ * scm_ie_index_ie() - get an IE by position
+ * @index: IE index
+ * @pos: position of the IE in the list, less than num_ies
+ *
+ * Return: pointer to the element ID of the IE
+ */
+static inline uint8_t *scm_ie_index_ie(struct scm_ie_index *index,
+				       uint16_t pos)
+{
+	return index->ies + index->entry[pos].offset;
+}
+
+/**
+ * scm_ie_index_first() - get the position of the first IE not taken yet
+ * @index: IE index
+ * @eid: element ID
+ *
+ * Return: position of the IE, SCM_IE_INDEX_INVALID if there is none
+ */
+static inline uint16_t scm_ie_index_first(struct scm_ie_index *index,
+					  uint8_t eid)
+{
+	return index->first[eid];
+}
+
+/**
+ * scm_ie_index_find() - find the first IE not taken yet
+ * @index: IE index
+ * @eid: element ID
+ *
+ * Return: pointer to the element ID of the IE, NULL if there is none
+ */
+static inline uint8_t *scm_ie_index_find(struct scm_ie_index *index,
+					 uint8_t eid)
+{
+	uint16_t pos = index->first[eid];
+
+	if (pos == SCM_IE_INDEX_INVALID)
+		return NULL;
+
+	return scm_ie_index_ie(index, pos);
+}
+
+/**
+ * scm_ie_index_next() - get the position of the next IE with the same
+ * element ID
+ * @index: IE index
+ * @pos: position of an IE
+ *
+ * Return: position of the next IE, SCM_IE_INDEX_INVALID if there is none
+ */
+static inline uint16_t scm_ie_index_next(struct scm_ie_index *index,
+					 uint16_t pos)
+{
+	return index->entry[pos].next;
+}
+
+/**
+ * scm_ie_index_take() - take an IE out of the lookups
+ * @index: IE index
+ * @pos: position of the IE
+ *
+ * The IE is still part of the list, but scm_ie_index_find() and
+ * scm_ie_index_first() no longer return it.
+ *
+ * Return: none
+ */
+void scm_ie_index_take(struct scm_ie_index *index, uint16_t pos);
+
+#ifdef WLAN_FEATURE_MBSSID
+/**
+ * scm_mbssid_gen_new_ie() - generate the IEs of a nontransmitted BSSID
+ * @psoc: psoc object
+ * @tx_index: IE index of the frame carrying the MBSSID IE
+ * @prof_index: IE index to use for @subelement, rebuilt by this function
+ * @subelement: nontransmitted BSSID profile
+ * @subie_len: length of @subelement
+ * @new_ie: buffer for the IEs, at least as big as the IEs of @tx_index
+ * @bssid_index: BSSID index from the MBSSID index IE of the profile
+ *
+ * Merges the IEs of the transmitted BSSID with the ones of the profile, as
+ * per the inheritance rules. Both are read in place from the two indexes,
+ * so each of them is walked once whatever the number of IEs in the other.
+ *
+ * Return: length of the IEs written to @new_ie, 0 on failure
+ */
+uint32_t scm_mbssid_gen_new_ie(struct wlan_objmgr_psoc *psoc,
+			       struct scm_ie_index *tx_index,
+			       struct scm_ie_index *prof_index,
+			       uint8_t *subelement, uint32_t subie_len,
+			       uint8_t *new_ie, uint8_t bssid_index);
+#endif
+#endif
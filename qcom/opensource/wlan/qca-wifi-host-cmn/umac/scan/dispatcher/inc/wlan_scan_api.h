@@ -385,6 +385,54 @@ static inline qdf_list_t *wlan_scan_get_result(struct wlan_objmgr_pdev *pdev,
 	return scm_get_scan_result(pdev, filter);
 }
 
+/**
+ * wlan_scan_db_iter_start() - The Public API to start a zero-copy
+ * iteration of the scan results
+ * @pdev: pdev info
+ * @filter: Filters, NULL for all the scan results
+ * @iter: iterator to initialize
+ *
+ * Unlike wlan_scan_get_result(), the scan entries are not copied. Each one
+ * is only valid until the next call to wlan_scan_db_iter_next() or
+ * wlan_scan_db_iter_stop(), which must be called once done.
+ *
+ * Return: QDF_STATUS
+ */
+static inline QDF_STATUS
+wlan_scan_db_iter_start(struct wlan_objmgr_pdev *pdev,
+			struct scan_filter *filter,
+			struct scan_db_iter *iter)
+{
+	return scm_scan_db_iter_start(pdev, filter, iter);
+}
+
+/**
+ * wlan_scan_db_iter_next() - The Public API to get the next scan result
+ * of an iteration
+ * @iter: iterator from wlan_scan_db_iter_start()
+ *
+ * The negotiated security of the entry is in @iter->security.
+ *
+ * Return: scan entry, NULL once all the scan results are returned
+ */
+static inline struct scan_cache_entry *
+wlan_scan_db_iter_next(struct scan_db_iter *iter)
+{
+	return scm_scan_db_iter_next(iter);
+}
+
+/**
+ * wlan_scan_db_iter_stop() - The Public API to stop an iteration of the
+ * scan results
+ * @iter: iterator from wlan_scan_db_iter_start()
+ *
+ * Return: void
+ */
+static inline void wlan_scan_db_iter_stop(struct scan_db_iter *iter)
+{
+	scm_scan_db_iter_stop(iter);
+}
+
 /**
  * wlan_scan_update_mlme_by_bssinfo() - The Public API to update mlme
  * info in the scan entry
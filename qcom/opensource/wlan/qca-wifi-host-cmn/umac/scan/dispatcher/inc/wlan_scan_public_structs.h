@@ -334,12 +334,16 @@ struct bss_info {
 /**
  * struct scan_cache_node - Scan cache entry node
  * @node: node pointers
+ * @bssid_freq_node: node pointers in the bssid and frequency hash table
+ * @age_node: node pointers in the age list
  * @ref_cnt: ref count if in use
  * @cookie: cookie to check if entry is logically active
  * @entry: scan entry pointer
  */
 struct scan_cache_node {
 	qdf_list_node_t node;
+	qdf_list_node_t bssid_freq_node;
+	qdf_list_node_t age_node;
 	qdf_atomic_t ref_cnt;
 	uint32_t cookie;
 	struct scan_cache_entry *entry;
@@ -1629,6 +1633,24 @@ typedef void (*update_beacon_cb) (struct wlan_objmgr_pdev *pdev,
 typedef QDF_STATUS (*scan_iterator_func) (void *arg,
 	struct scan_cache_entry *scan_entry);
 
+struct scan_dbs;
+
+/**
+ * struct scan_db_iter - zero-copy iterator of a scan db
+ * @psoc: psoc object
+ * @scan_db: scan db being iterated
+ * @filter: filter the entries must match, NULL for all entries
+ * @node: node of the entry returned last, a reference is held on it
+ * @security: negotiated security of the entry returned last
+ */
+struct scan_db_iter {
+	struct wlan_objmgr_psoc *psoc;
+	struct scan_dbs *scan_db;
+	struct scan_filter *filter;
+	struct scan_cache_node *node;
+	struct security_info security;
+};
+
 /**
  * enum scan_config - scan configuration definitions
  * @SCAN_CFG_DISABLE_SCAN_COMMAND_TIMEOUT: disable scan command timeout
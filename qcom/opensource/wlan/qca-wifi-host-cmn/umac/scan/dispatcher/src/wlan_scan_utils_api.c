@@ -26,6 +26,7 @@
 #include <wlan_scan_utils_api.h>
 #include <../../core/src/wlan_scan_cache_db.h>
 #include <../../core/src/wlan_scan_main.h>
+#include <../../core/src/wlan_scan_ie_index.h>
 #include <wlan_reg_services_api.h>
 #if defined(WLAN_SAE_SINGLE_PMK) && defined(WLAN_FEATURE_ROAM_OFFLOAD)
 #include <wlan_mlme_api.h>
@@ -2651,66 +2652,6 @@ util_scan_gen_scan_entry(struct wlan_objmgr_pdev *pdev,
 	return status;
 }
 
-#ifdef WLAN_FEATURE_MBSSID
-/*
- * util_is_noninh_ie() - find the noninhertance information element
- * in the received frame's IE list, so that we can stop inheriting that IE
- * in the caller function.
- *
- * @elem_id: Element ID in the received frame's IE, which is being processed.
- * @non_inh_list: pointer to the non inherited list of element IDs or
- *                list of extension element IDs.
- * @len: Length of non inheritance IE list
- *
- * Return: False if the element ID is not found or else return true
- */
-static bool util_is_noninh_ie(uint8_t elem_id,
-			      uint8_t *non_inh_list,
-			      int8_t len)
-{
-	int count;
-
-	for (count = 0; count < len; count++) {
-		if (elem_id == non_inh_list[count])
-			return true;
-	}
-
-	return false;
-}
-
-/*
- * util_scan_find_noninheritance_ie() - find noninheritance information element
- * This block of code is to identify if there is any non-inheritance element
- * present as part of the nontransmitted BSSID profile.
- * @elem_id: element id
- * @ies: pointer consisting of IEs
- * @len: IE length
- *
- * Return: NULL if the element ID is not found or if IE pointer is NULL else
- * pointer to the first byte of the requested element
- */
-static uint8_t
-*util_scan_find_noninheritance_ie(uint8_t elem_id, uint8_t *ies,
-				  int32_t len)
-{
-	if (!ies)
-		return NULL;
-
-	while ((len >= MIN_IE_LEN + 1) && len >= ies[TAG_LEN_POS] + MIN_IE_LEN)
-	{
-		if ((ies[ID_POS] == elem_id) &&
-		    (ies[ELEM_ID_EXTN_POS] ==
-		     WLAN_EXTN_ELEMID_NONINHERITANCE)) {
-			return ies;
-		}
-		len -= ies[TAG_LEN_POS] + MIN_IE_LEN;
-		ies += ies[TAG_LEN_POS] + MIN_IE_LEN;
-	}
-
-	return NULL;
-}
-#endif
-
 /*
  * util_scan_find_ie() - find information element
  * @eid: element id
@@ -2753,521 +2694,6 @@ static void util_gen_new_bssid(uint8_t *bssid, uint8_t max_bssid,
 	new_bssid_addr[5] |= (lsb_n + mbssid_index) % (1 << max_bssid);
 }
 
-/*
- * util_parse_noninheritance_list() - This block of code will be executed only
- * if there is a valid non inheritance IE present in the nontx profile.
- * Host need not inherit those list of element IDs and list of element ID
- * extensions from the transmitted BSSID profile.
- * Since non-inheritance element is an element ID extension, it should
- * be part of extension element. So first we need to find if there are
- * any extension element present in the nontransmitted BSSID profile.
- * @extn_elem: If valid, it points to the element ID field of
- * extension element tag in the nontransmitted BSSID profile.
- * It may or may not have non inheritance tag present.
- *      _____________________________________________
- *     |         |       |       |List of|List of    |
- *     | Element |Length |Element|Element|Element ID |
- *     |  ID     |       |ID extn| IDs   |Extension  |
- *     |_________|_______|_______|_______|___________|
- * List of Element IDs:
- *      __________________
- *     |         |        |
- *     |  Length |Element |
- *     |         |ID List |
- *     |_________|________|
- * List of Element ID Extensions:
- *      __________________________
- *     |         |                |
- *     |  Length |Element ID      |
- *     |         |extension List  |
- *     |_________|________________|
- * @elem_list: Element ID list
- * @extn_elem_list: Element ID exiension list
- * @non_inheritance_ie: Non inheritance IE information
- */
-
-static void util_parse_noninheritance_list(uint8_t *extn_elem,
-					   uint8_t **elem_list,
-					   uint8_t **extn_elem_list,
-					   struct non_inheritance_ie *ninh)
-{
-	int8_t extn_rem_len = 0;
-
-	if (extn_elem[ELEM_ID_LIST_LEN_POS] < extn_elem[TAG_LEN_POS]) {
-		/*
-		 * extn_rem_len represents the number of bytes after
-		 * the length subfield of list of Element IDs.
-		 * So here, extn_rem_len should be equal to
-		 * Element ID list + Length subfield of Element ID
-		 * extension list + Element ID extension list.
-		 *
-		 * Here we have taken two pointers pointing to the
-		 * element ID list and element ID extension list
-		 * which we will use to detect the same elements
-		 * in the transmitted BSSID profile and choose not
-		 * to inherit those elements while constructing the
-		 * frame for nontransmitted BSSID profile.
-		 */
-		extn_rem_len = extn_elem[TAG_LEN_POS] - MIN_IE_LEN;
-		ninh->non_inherit = true;
-
-		if (extn_rem_len && extn_elem[ELEM_ID_LIST_LEN_POS]) {
-			if (extn_rem_len >= extn_elem[ELEM_ID_LIST_LEN_POS]) {
-				ninh->list_len =
-					extn_elem[ELEM_ID_LIST_LEN_POS];
-				*elem_list = extn_elem + ELEM_ID_LIST_POS;
-				extn_rem_len -= ninh->list_len;
-			} else {
-				/*
-				 * Corrupt frame. length subfield of
-				 * element ID list is greater than
-				 * what it should be. Go ahead with
-				 * frame generation but do not honour
-				 * the non inheritance part. Also, mark
-				 * the element ID in subcopy as 0, so
-				 * that this element info will not
-				 * be copied.
-				 */
-				ninh->non_inherit = false;
-				extn_elem[0] = 0;
-			}
-		}
-
-		extn_rem_len--;
-		if (extn_rem_len > 0) {
-			if (!ninh->list_len) {
-				ninh->extn_len =
-					extn_elem[ELEM_ID_LIST_LEN_POS + 1];
-			} else {
-				ninh->extn_len =
-					extn_elem[ELEM_ID_LIST_POS +
-					ninh->list_len];
-			}
-
-			if (extn_rem_len != ninh->extn_len) {
-				/*
-				 * Corrupt frame. length subfield of
-				 * element ID extn list is not
-				 * what it should be. Go ahead with
-				 * frame generation but do not honour
-				 * the non inheritance part. Also, mark
-				 * the element ID in subcopy as 0, so
-				 * that this element info will not
-				 * be copied.
-				 */
-				ninh->non_inherit = false;
-				extn_elem[0] = 0;
-			}
-
-			if (ninh->extn_len) {
-				*extn_elem_list =
-					(extn_elem + ninh->list_len +
-					 ELEM_ID_LIST_POS + 1);
-			}
-		}
-	}
-}
-
-#ifdef WLAN_FEATURE_11BE_MLO
-/**
- * util_handle_rnr_ie_for_mbssid() - parse and modify RNR IE for MBSSID feature
- * @rnr: The pointer to RNR IE
- * @bssid_index: BSSID index from MBSSID index IE
- * @pos: The buffer pointer to save the transformed RNR IE, caller is expected
- *       to supply a buffer that is at least as big as @rnr
- *
- * Per the description about Neighbor AP Information field about MLD
- * parameters subfield in section 9.4.2.170.2 of Draft P802.11be_D1.4.
- * If the reported AP is affiliated with the same MLD of the reporting AP,
- * the TBTT information is skipped; If the reported AP is affiliated with
- * the same MLD of the nontransmitted BSSID, the TBTT information is
- * copied and the MLD ID is changed to 0.
- *
- * Return: Length of the element written to @pos
- */
-static int util_handle_rnr_ie_for_mbssid(const uint8_t *rnr,
-					 uint8_t bssid_index, uint8_t *pos)
-{
-	size_t rnr_len;
-	const uint8_t *data, *rnr_end;
-	uint8_t *rnr_new;
-	struct neighbor_ap_info_field *neighbor_ap_info;
-	struct rnr_mld_info *mld_param;
-	uint8_t tbtt_type, tbtt_len, tbtt_count;
-	uint8_t mld_pos, mld_id;
-	int32_t i, copy_len;
-	/* The count of TBTT info field whose MLD ID equals to 0 in a neighbor
-	 * AP information field.
-	 */
-	uint32_t tbtt_info_field_count;
-	/* The total bytes of TBTT info fields whose MLD ID equals to 0 in
-	 * current RNR IE.
-	 */
-	uint32_t tbtt_info_field_len = 0;
-	uint8_t nbr_ap_info_len = sizeof(struct neighbor_ap_info_field);
-
-	rnr_len = rnr[TAG_LEN_POS];
-	rnr_end = rnr + rnr_len + MIN_IE_LEN;
-	rnr_new = pos;
-	qdf_mem_copy(pos, rnr, MIN_IE_LEN);
-	pos += MIN_IE_LEN;
-
-	data = rnr + PAYLOAD_START_POS;
-	while (data + sizeof(struct neighbor_ap_info_field) <= rnr_end) {
-		neighbor_ap_info = (struct neighbor_ap_info_field *)data;
-		tbtt_count = neighbor_ap_info->tbtt_header.tbtt_info_count;
-		tbtt_len = neighbor_ap_info->tbtt_header.tbtt_info_length;
-		tbtt_type = neighbor_ap_info->tbtt_header.tbbt_info_fieldtype;
-		scm_debug("channel number %d, op class %d, bssid_index %d",
-			  neighbor_ap_info->channel_number,
-			  neighbor_ap_info->operting_class, bssid_index);
-		scm_debug("tbtt_count %d, tbtt_length %d, tbtt_type %d",
-			  tbtt_count, tbtt_len, tbtt_type);
-
-		copy_len = tbtt_len * (tbtt_count + 1) +
-			   nbr_ap_info_len;
-		if (data + copy_len > rnr_end)
-			return 0;
-
-		if (tbtt_len >=
-		    TBTT_NEIGHBOR_AP_BSSID_S_SSID_BSS_PARAM_20MHZ_PSD_MLD_PARAM)
-			mld_pos =
-			     TBTT_NEIGHBOR_AP_BSSID_S_SSID_BSS_PARAM_20MHZ_PSD;
-		else
-			mld_pos = 0;
-
-		/* If MLD params do not exist, copy this neighbor AP
-		 * information field.
-		 * Per Draft P802.11be_D1.4, tbtt_type value 1, 2 and 3
-		 * are reserved,
-		 */
-		if (mld_pos == 0 || tbtt_type != 0) {
-			scm_debug("no MLD params, tbtt_type %d", tbtt_type);
-			qdf_mem_copy(pos, data, copy_len);
-			pos += copy_len;
-			data += copy_len;
-			continue;
-		}
-
-		qdf_mem_copy(pos, data, nbr_ap_info_len);
-		neighbor_ap_info = (struct neighbor_ap_info_field *)pos;
-		pos += nbr_ap_info_len;
-		data += nbr_ap_info_len;
-
-		tbtt_info_field_count = 0;
-		for (i = 0; i < tbtt_count + 1; i++) {
-			mld_param = (struct rnr_mld_info *)&data[mld_pos];
-			mld_id = mld_param->mld_id;
-
-			/* Refer to Draft P802.11be_D1.4
-			 * 9.4.2.170.2 Neighbor AP Information field about
-			 * MLD parameters subfield
-			 */
-			if (mld_id == 0) {
-				/* Skip this TBTT information since this
-				 * reported AP is affiliated with the same MLD
-				 * of the reporting AP who sending the frame
-				 * carrying this element.
-				 */
-				tbtt_info_field_len += tbtt_len;
-				data += tbtt_len;
-				tbtt_info_field_count++;
-			} else if (mld_id == bssid_index) {
-				/* Copy this TBTT information and change MLD
-				 * to 0 as this reported AP is affiliated with
-				 * the same MLD of the nontransmitted BSSID.
-				 */
-				qdf_mem_copy(pos, data, tbtt_len);
-				mld_param =
-					(struct rnr_mld_info *)&pos[mld_pos];
-				scm_debug("change MLD ID from %d to 0",
-					  mld_param->mld_id);
-				mld_param->mld_id = 0;
-				data += tbtt_len;
-				pos += tbtt_len;
-			} else {
-				qdf_mem_copy(pos, data, tbtt_len);
-				data += tbtt_len;
-				pos += tbtt_len;
-			}
-		}
-
-		scm_debug("skip %d neighbor info", tbtt_info_field_count);
-		if (tbtt_info_field_count == (tbtt_count + 1)) {
-			/* If all the TBTT information are skipped, then also
-			 * revert the neighbor AP info which has been copied.
-			 */
-			pos -= nbr_ap_info_len;
-			tbtt_info_field_len += nbr_ap_info_len;
-		} else {
-			neighbor_ap_info->tbtt_header.tbtt_info_count -=
-							tbtt_info_field_count;
-		}
-	}
-
-	rnr_new[TAG_LEN_POS] = rnr_len - tbtt_info_field_len;
-	if (rnr_new[TAG_LEN_POS] > 0)
-		rnr_len = rnr_new[TAG_LEN_POS] + MIN_IE_LEN;
-	else
-		rnr_len = 0;
-
-	return rnr_len;
-}
-#else
-static int util_handle_rnr_ie_for_mbssid(const uint8_t *rnr,
-					 uint8_t bssid_index, uint8_t *pos)
-{
-	return 0;
-}
-#endif
-
-#ifdef WLAN_FEATURE_ACTION_OUI
-static uint8_t *util_copy_reporting_ap_vendor_ies(struct wlan_objmgr_psoc *psoc,
-						  const uint8_t *ie,
-						  uint32_t ie_len,
-						  uint8_t *buf_ie)
-{
-	struct action_oui_search_attr attr = {0};
-	enum action_oui_id oui_id = ACTION_OUI_RESTRICT_MAX_MLO_LINKS;
-
-	attr.ie_data = (uint8_t *)ie;
-	attr.ie_length = ie_len;
-
-	if (wlan_action_oui_search(psoc, &attr, oui_id)) {
-		qdf_mem_copy(buf_ie, ie, ie_len);
-		buf_ie += ie_len;
-	}
-
-	return buf_ie;
-}
-#else
-static inline uint8_t *
-util_copy_reporting_ap_vendor_ies(struct wlan_objmgr_psoc *psoc,
-				  const uint8_t *ie, uint32_t ie_len,
-				  uint8_t *buf_ie)
-{
-	return buf_ie;
-}
-#endif
-
-static uint32_t util_gen_new_ie(struct wlan_objmgr_pdev *pdev,
-				uint8_t *ie, uint32_t ielen,
-				uint8_t *subelement,
-				size_t subie_len, uint8_t *new_ie,
-				uint8_t bssid_index)
-{
-	struct wlan_objmgr_psoc *psoc;
-	uint8_t *pos, *tmp;
-	const uint8_t *tmp_old, *tmp_new;
-	uint8_t *sub_copy, *extn_elem = NULL;
-	struct non_inheritance_ie ninh = {0};
-	uint8_t *elem_list = NULL, *extn_elem_list = NULL;
-	size_t tmp_rem_len;
-
-	psoc = wlan_pdev_get_psoc(pdev);
-	if (!psoc) {
-		scm_err("NULL PSOC");
-		return 0;
-	}
-
-	/* copy subelement as we need to change its content to
-	 * mark an ie after it is processed.
-	 */
-	sub_copy = qdf_mem_malloc(subie_len);
-	if (!sub_copy)
-		return 0;
-	qdf_mem_copy(sub_copy, subelement, subie_len);
-
-	pos = &new_ie[0];
-
-	/* new ssid */
-	tmp_new = util_scan_find_ie(WLAN_ELEMID_SSID, sub_copy, subie_len);
-	if (tmp_new) {
-		scm_debug(" SSID " QDF_SSID_FMT,
-			  QDF_SSID_REF(tmp_new[1],
-				       &tmp_new[PAYLOAD_START_POS]));
-		if ((pos + tmp_new[1] + MIN_IE_LEN) <=
-		    (new_ie + ielen)) {
-			qdf_mem_copy(pos, tmp_new,
-				     (tmp_new[1] + MIN_IE_LEN));
-			pos += (tmp_new[1] + MIN_IE_LEN);
-		}
-	}
-
-	extn_elem = util_scan_find_noninheritance_ie(WLAN_ELEMID_EXTN_ELEM,
-						     sub_copy, subie_len);
-
-	if (extn_elem && extn_elem[TAG_LEN_POS] >= VALID_ELEM_LEAST_LEN) {
-		if (((extn_elem + extn_elem[1] + MIN_IE_LEN) - sub_copy)
-		    <= subie_len)
-			util_parse_noninheritance_list(extn_elem, &elem_list,
-						       &extn_elem_list, &ninh);
-	}
-
-	/* go through IEs in ie (skip SSID) and subelement,
-	 * merge them into new_ie
-	 */
-	tmp_old = util_scan_find_ie(WLAN_ELEMID_SSID, ie, ielen);
-	tmp_old = (tmp_old) ? tmp_old + tmp_old[1] + MIN_IE_LEN : ie;
-
-	if (((tmp_old + MIN_IE_LEN) - ie) >= ielen) {
-		qdf_mem_free(sub_copy);
-		return 0;
-	}
-
-	while (((tmp_old + tmp_old[1] + MIN_IE_LEN) - ie) <= ielen) {
-		ninh.non_inh_ie_found = 0;
-		if (ninh.non_inherit) {
-			if (ninh.list_len) {
-				ninh.non_inh_ie_found =
-					util_is_noninh_ie(tmp_old[0],
-							  elem_list,
-							  ninh.list_len);
-			}
-
-			if (!ninh.non_inh_ie_found &&
-			    ninh.extn_len &&
-			    (tmp_old[0] == WLAN_ELEMID_EXTN_ELEM)) {
-				ninh.non_inh_ie_found =
-					util_is_noninh_ie(tmp_old[2],
-							  extn_elem_list,
-							  ninh.extn_len);
-			}
-		}
-
-		if (ninh.non_inh_ie_found || (tmp_old[0] == 0)) {
-			if (((tmp_old + tmp_old[1] + MIN_IE_LEN) - ie) >=
-			    (ielen - MIN_IE_LEN))
-				break;
-			tmp_old += tmp_old[1] + MIN_IE_LEN;
-			continue;
-		}
-
-		tmp = (uint8_t *)util_scan_find_ie(tmp_old[0], sub_copy,
-						   subie_len);
-		if (!tmp) {
-			/* ie in old ie but not in subelement */
-			if (tmp_old[0] == WLAN_ELEMID_REDUCED_NEIGHBOR_REPORT) {
-				/* handle rnr ie for mbssid*/
-				pos +=
-				    util_handle_rnr_ie_for_mbssid(tmp_old,
-								  bssid_index,
-								  pos);
-			} else if (tmp_old[0] != WLAN_ELEMID_MULTIPLE_BSSID) {
-				if ((pos + tmp_old[1] + MIN_IE_LEN) <=
-				    (new_ie + ielen)) {
-					qdf_mem_copy(pos, tmp_old,
-						     (tmp_old[1] +
-						      MIN_IE_LEN));
-					pos += tmp_old[1] + MIN_IE_LEN;
-				}
-			}
-		} else {
-			/* ie in transmitting ie also in subelement,
-			 * copy from subelement and flag the ie in subelement
-			 * as copied (by setting eid field to 0xff).
-			 * To determine if the vendor ies are same:
-			 * 1. For Cisco OUI, compare only OUI + type
-			 * 2. For other OUI, compare OUI + type + subType
-			 */
-			tmp_rem_len = subie_len - (tmp - sub_copy);
-			if (tmp_old[0] == WLAN_ELEMID_VENDOR &&
-			    tmp_rem_len >= MIN_VENDOR_TAG_LEN) {
-				/*
-				 * In order to identify few Vendor APs the
-				 * generated frame should contain the reporting
-				 * APs matching VSIE or else the entry generated
-				 * will not have this VSIE and logic kept to
-				 * take certain action on specific Vendor APs
-				 * will fail.
-				 */
-				pos = util_copy_reporting_ap_vendor_ies(psoc,
-									tmp_old,
-									tmp_old[1] + MIN_IE_LEN,
-									pos);
-				/* If Vendor IE also presents in STA profile,
-				 * then ignore the Vendor IE which is for
-				 * reporting STA. It only needs to copy Vendor
-				 * IE from STA profile for reported BSSID.
-				 * The copy happens when going through the
-				 * remaining IEs.
-				 */
-			} else if (tmp_old[0] == WLAN_ELEMID_EXTN_ELEM &&
-				   tmp_rem_len >= (MIN_IE_LEN + 1)) {
-				if (tmp_old[PAYLOAD_START_POS] ==
-				    tmp[PAYLOAD_START_POS]) {
-					/* same ie, copy from subelement */
-					if ((pos + tmp[1] + MIN_IE_LEN) <=
-					    (new_ie + ielen)) {
-						qdf_mem_copy(pos, tmp,
-							     tmp[1] +
-							     MIN_IE_LEN);
-						pos += tmp[1] + MIN_IE_LEN;
-						tmp[0] = 0;
-					}
-				} else {
-					if ((pos + tmp_old[1] + MIN_IE_LEN) <=
-					    (new_ie + ielen)) {
-						qdf_mem_copy(pos, tmp_old,
-							     tmp_old[1] +
-							     MIN_IE_LEN);
-						pos += tmp_old[1] +
-							MIN_IE_LEN;
-					}
-				}
-
-			} else {
-				/* copy ie from subelement into new ie */
-				if ((pos + tmp[1] + MIN_IE_LEN) <=
-				    (new_ie + ielen)) {
-					qdf_mem_copy(pos, tmp,
-						     tmp[1] + MIN_IE_LEN);
-					pos += tmp[1] + MIN_IE_LEN;
-					tmp[0] = 0;
-				}
-			}
-		}
-
-		if (((tmp_old + tmp_old[1] + MIN_IE_LEN) - ie) >=
-		    (ielen - MIN_IE_LEN))
-			break;
-
-		tmp_old += tmp_old[1] + MIN_IE_LEN;
-	}
-
-	/* go through subelement again to check if there is any ie not
-	 * copied to new ie, skip ssid, capability, bssid-index ie
-	 */
-	tmp_new = sub_copy;
-	while ((subie_len > 0) &&
-	       (((tmp_new + tmp_new[1] + MIN_IE_LEN) - sub_copy) <=
-		subie_len)) {
-		if (!(tmp_new[0] == WLAN_ELEMID_NONTX_BSSID_CAP ||
-		      tmp_new[0] == WLAN_ELEMID_SSID ||
-		      tmp_new[0] == WLAN_ELEMID_MULTI_BSSID_IDX ||
-		      ((tmp_new[0] == WLAN_ELEMID_EXTN_ELEM) && tmp_new[1] &&
-		       (tmp_new[2] == WLAN_EXTN_ELEMID_NONINHERITANCE)))) {
-			if ((pos + tmp_new[1] + MIN_IE_LEN) <=
-			    (new_ie + ielen)) {
-				qdf_mem_copy(pos, tmp_new,
-					     tmp_new[1] + MIN_IE_LEN);
-				pos += tmp_new[1] + MIN_IE_LEN;
-			}
-		}
-		if (((tmp_new + tmp_new[1] + MIN_IE_LEN) - sub_copy) >=
-		    (subie_len - 1))
-			break;
-		tmp_new += tmp_new[1] + MIN_IE_LEN;
-	}
-
-	qdf_mem_free(sub_copy);
-
-	if (pos > new_ie)
-		return pos - new_ie;
-	else
-		return 0;
-}
-
 static enum nontx_profile_reasoncode
 util_handle_nontx_prof(uint8_t *mbssid_elem, uint8_t *subelement,
 		       uint8_t *next_subelement,
@@ -3363,32 +2789,19 @@ util_handle_nontx_prof(uint8_t *mbssid_elem, uint8_t *subelement,
  * capability element, then it's a split profile case.
  */
 static bool util_scan_is_split_prof_found(uint8_t *next_elem,
+					  uint8_t *next_mbssid_elem,
 					  uint8_t *ie, uint32_t ielen)
 {
-	uint8_t *next_mbssid_elem;
-
 	if ((next_elem + MIN_IE_LEN + VALID_ELEM_LEAST_LEN) > (ie + ielen))
 		return false;
 
-	if (next_elem[0] == WLAN_ELEMID_MULTIPLE_BSSID) {
-		if ((next_elem[TAG_LEN_POS] >= VALID_ELEM_LEAST_LEN) &&
-		    (next_elem[SUBELEM_DATA_POS_FROM_MBSSID] !=
-		     WLAN_ELEMID_NONTX_BSSID_CAP)) {
-			return true;
-		}
-	} else {
-		next_mbssid_elem =
-			util_scan_find_ie(WLAN_ELEMID_MULTIPLE_BSSID,
-					  next_elem,
-					  ielen - (next_elem - ie));
-		if (!next_mbssid_elem)
-			return false;
+	if (!next_mbssid_elem)
+		return false;
 
-		if ((next_mbssid_elem[TAG_LEN_POS] >= VALID_ELEM_LEAST_LEN) &&
-		    (next_mbssid_elem[SUBELEM_DATA_POS_FROM_MBSSID] !=
-		     WLAN_ELEMID_NONTX_BSSID_CAP)) {
-			return true;
-		}
+	if ((next_mbssid_elem[TAG_LEN_POS] >= VALID_ELEM_LEAST_LEN) &&
+	    (next_mbssid_elem[SUBELEM_DATA_POS_FROM_MBSSID] !=
+	     WLAN_ELEMID_NONTX_BSSID_CAP)) {
+		return true;
 	}
 
 	return false;
@@ -3404,9 +2817,9 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 	struct wlan_bcn_frame *bcn;
 	struct wlan_frame_hdr *hdr;
 	struct scan_mbssid_info mbssid_info = {0};
-	QDF_STATUS status;
-	uint8_t *pos, *subelement, *next_elem;
-	uint8_t *mbssid_elem;
+	QDF_STATUS status = QDF_STATUS_SUCCESS;
+	uint8_t *subelement, *next_elem;
+	uint8_t *mbssid_elem, *next_mbssid_elem;
 	uint32_t subie_len, new_ie_len, ielen;
 	uint8_t *next_subelement = NULL;
 	uint8_t new_bssid[QDF_MAC_ADDR_SIZE], bssid[QDF_MAC_ADDR_SIZE];
@@ -3415,6 +2828,8 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 	int new_frame_len = 0, split_prof_len = 0;
 	enum nontx_profile_reasoncode retval;
 	uint8_t *nontx_profile = NULL;
+	struct scm_ie_index *tx_index, *prof_index = NULL;
+	uint16_t mbssid_pos;
 
 	scan_obj = wlan_pdev_get_scan_obj(pdev);
 	if (!scan_obj)
@@ -3428,21 +2843,46 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 			   offsetof(struct wlan_bcn_frame, ie));
 	qdf_mem_copy(bssid, hdr->i_addr3, QDF_MAC_ADDR_SIZE);
 
-	if (!util_scan_find_ie(WLAN_ELEMID_MULTIPLE_BSSID, ie, ielen))
+	/*
+	 * Index the IEs of the frame once; every nontx profile is then
+	 * generated from this index and from an index of the profile,
+	 * without walking the frame again or copying the profile.
+	 */
+	tx_index = scm_ie_index_alloc(ielen);
+	if (!tx_index)
+		return QDF_STATUS_E_NOMEM;
+
+	scm_ie_index_build(tx_index, ie, ielen);
+	mbssid_pos = scm_ie_index_first(tx_index, WLAN_ELEMID_MULTIPLE_BSSID);
+	if (mbssid_pos == SCM_IE_INDEX_INVALID) {
+		scm_ie_index_free(tx_index);
 		return QDF_STATUS_E_FAILURE;
+	}
 
-	pos = ie;
+	prof_index = scm_ie_index_alloc(ielen);
+	if (!prof_index) {
+		status = QDF_STATUS_E_NOMEM;
+		goto free_index;
+	}
 
-	new_ie = qdf_mem_malloc(ielen);
-	if (!new_ie)
-		return QDF_STATUS_E_NOMEM;
+	/*
+	 * The IEs of each nontx profile are generated in place in a single
+	 * frame buffer, which is reused for all the profiles. Only the
+	 * addresses and the capability differ in the fixed part.
+	 */
+	new_frame = qdf_mem_malloc(frame_len);
+	if (!new_frame) {
+		status = QDF_STATUS_E_NOMEM;
+		goto free_index;
+	}
 
-	while (pos < (ie + ielen + MIN_IE_LEN)) {
-		mbssid_elem =
-			util_scan_find_ie(WLAN_ELEMID_MULTIPLE_BSSID, pos,
-					  ielen - (pos - ie));
-		if (!mbssid_elem)
-			break;
+	qdf_mem_copy(new_frame, frame, FIXED_LENGTH);
+	new_ie = new_frame + sizeof(struct wlan_frame_hdr) +
+		 offsetof(struct wlan_bcn_frame, ie);
+
+	for (; mbssid_pos != SCM_IE_INDEX_INVALID;
+	     mbssid_pos = scm_ie_index_next(tx_index, mbssid_pos)) {
+		mbssid_elem = scm_ie_index_ie(tx_index, mbssid_pos);
 
 		/*
 		 * The max_bssid_indicator field is mandatory, therefore the
@@ -3472,8 +2912,18 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 		 * the other fragmented part of the non Tx profile.
 		 */
 
+		next_mbssid_elem = NULL;
+		if (scm_ie_index_next(tx_index, mbssid_pos) !=
+		    SCM_IE_INDEX_INVALID)
+			next_mbssid_elem =
+				scm_ie_index_ie(tx_index,
+						scm_ie_index_next(tx_index,
+								  mbssid_pos));
+
 		mbssid_info.split_profile =
-			util_scan_is_split_prof_found(next_elem, ie, ielen);
+			util_scan_is_split_prof_found(next_elem,
+						      next_mbssid_elem,
+						      ie, ielen);
 
 		for (subelement = mbssid_elem + SUBELEMENT_START_POS;
 		     subelement < (next_elem - 1);
@@ -3498,13 +2948,8 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 					     subie_len,
 					     mbssid_info.split_prof_continue,
 					     mbssid_info.prof_residue);
-				if (mbssid_info.split_prof_continue) {
-					qdf_mem_free(split_prof_start);
-					split_prof_start = NULL;
-				}
-
-				qdf_mem_free(new_ie);
-				return QDF_STATUS_E_INVAL;
+				status = QDF_STATUS_E_INVAL;
+				goto free_index;
 			}
 
 			if ((next_elem - subelement) <
@@ -3521,10 +2966,8 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 				scm_debug_rl("Corrupt frame with ID_POS: %d,TAG_LEN_POS: %d",
 					     subelement[ID_POS],
 					     subelement[TAG_LEN_POS]);
-				qdf_mem_free(split_prof_start);
-				split_prof_start = NULL;
-				qdf_mem_free(new_ie);
-				return QDF_STATUS_E_INVAL;
+				status = QDF_STATUS_E_INVAL;
+				goto free_index;
 			} else if (retval == INVALID_NONTX_PROF) {
 				continue;
 			}
@@ -3557,8 +3000,8 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 						qdf_mem_malloc(ielen);
 					if (!split_prof_start) {
 						scm_err_rl("Malloc failed");
-						qdf_mem_free(new_ie);
-						return QDF_STATUS_E_NOMEM;
+						status = QDF_STATUS_E_NOMEM;
+						goto free_index;
 					}
 
 					qdf_mem_copy(split_prof_start,
@@ -3634,11 +3077,12 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 			}
 
 			new_ie_len =
-				util_gen_new_ie(pdev, ie, ielen,
-						(nontx_profile +
-						 PAYLOAD_START_POS),
-						subie_len, new_ie,
-						mbssid_info.profile_num);
+				scm_mbssid_gen_new_ie(wlan_pdev_get_psoc(pdev),
+						      tx_index, prof_index,
+						      (nontx_profile +
+						       PAYLOAD_START_POS),
+						      subie_len, new_ie,
+						      mbssid_info.profile_num);
 
 			if (!new_ie_len) {
 				if (mbssid_info.split_prof_continue) {
@@ -3653,36 +3097,18 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 			new_frame_len = frame_len - ielen + new_ie_len;
 
 			if (new_frame_len < 0 || new_frame_len > frame_len) {
-				if (mbssid_info.split_prof_continue) {
-					qdf_mem_free(split_prof_start);
-					split_prof_start = NULL;
-				}
-				qdf_mem_free(new_ie);
 				scm_debug_rl("Invalid frame:Stop MBSSIE parsing, Frame_len: %zu "
 					     "ielen:%u,new_ie_len:%u",
 					     frame_len, ielen, new_ie_len);
-				return QDF_STATUS_E_INVAL;
-			}
-
-			new_frame = qdf_mem_malloc(new_frame_len);
-			if (!new_frame) {
-				if (mbssid_info.split_prof_continue) {
-					qdf_mem_free(split_prof_start);
-					split_prof_start = NULL;
-				}
-				qdf_mem_free(new_ie);
-				scm_err_rl("Malloc for new_frame failed");
-				scm_err_rl("split_prof_continue: %d",
-					   mbssid_info.split_prof_continue);
-				return QDF_STATUS_E_NOMEM;
+				status = QDF_STATUS_E_INVAL;
+				goto free_index;
 			}
 
 			/*
-			 * Copy the header(24byte), timestamp(8 byte),
-			 * beaconinterval(2byte) and capability(2byte)
+			 * The header(24byte), timestamp(8 byte) and
+			 * beaconinterval(2byte) are the ones of the frame,
+			 * the new ie is already in place after them.
 			 */
-			qdf_mem_copy(new_frame, frame, FIXED_LENGTH);
-			/* Copy the new ie generated from MBSSID profile*/
 			hdr = (struct wlan_frame_hdr *)new_frame;
 			qdf_mem_copy(hdr->i_addr2, new_bssid,
 				     QDF_MAC_ADDR_SIZE);
@@ -3695,11 +3121,6 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 				     nontx_profile + CAP_INFO_POS,
 				     CAP_INFO_LEN);
 
-			/* Copy the new ie generated from MBSSID profile*/
-			qdf_mem_copy(new_frame +
-				     offsetof(struct wlan_bcn_frame, ie) +
-				     sizeof(struct wlan_frame_hdr),
-				     new_ie, new_ie_len);
 			if (scan_obj->cb.inform_mbssid_bcn_prb_rsp)
 				scan_obj->cb.inform_mbssid_bcn_prb_rsp(
 						       new_frame, new_frame_len,
@@ -3720,7 +3141,6 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 					qdf_mem_zero(&mbssid_info,
 						     sizeof(mbssid_info));
 				}
-				qdf_mem_free(new_frame);
 				scm_debug_rl("failed to generate a scan entry "
 					     "split_prof_continue: %d",
 					     mbssid_info.split_prof_continue);
@@ -3733,17 +3153,20 @@ static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
 				split_prof_end = NULL;
 				split_prof_len = 0;
 			}
-			qdf_mem_free(new_frame);
 		}
-
-		pos = next_elem;
 	}
-	qdf_mem_free(new_ie);
+	status = QDF_STATUS_SUCCESS;
 
+free_index:
 	if (split_prof_start)
 		qdf_mem_free(split_prof_start);
+	if (new_frame)
+		qdf_mem_free(new_frame);
+	if (prof_index)
+		scm_ie_index_free(prof_index);
+	scm_ie_index_free(tx_index);
 
-	return QDF_STATUS_SUCCESS;
+	return status;
 }
 #else
 static QDF_STATUS util_scan_parse_mbssid(struct wlan_objmgr_pdev *pdev,
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Host build stand-in for qdf_mem.h, see ../scan_ie_replay.c.
+ */
+
+#ifndef __SCAN_IE_REPLAY_QDF_MEM_H
+#define __SCAN_IE_REPLAY_QDF_MEM_H
+
+#include <stdlib.h>
+#include <string.h>
+
+#define qdf_mem_malloc(size) calloc(1, size)
+#define qdf_mem_free free
+#define qdf_mem_copy memcpy
+#define qdf_mem_set(ptr, num_bytes, value) memset(ptr, value, num_bytes)
+
+#endif /* __SCAN_IE_REPLAY_QDF_MEM_H */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * Host build stand-in for wlan_scan_public_structs.h and wlan_scan_main.h:
+ * the element IDs, the positions and the scm_ logging used by
+ * wlan_scan_ie_index.c, see ../scan_ie_replay.c.
+ */
+
+#ifndef __SCAN_IE_REPLAY_WLAN_SCAN_PUBLIC_STRUCTS_H
+#define __SCAN_IE_REPLAY_WLAN_SCAN_PUBLIC_STRUCTS_H
+
+#include <qdf_types.h>
+
+#define WLAN_ELEMID_SSID 0
+#define WLAN_ELEMID_MULTIPLE_BSSID 71
+#define WLAN_ELEMID_NONTX_BSSID_CAP 83
+#define WLAN_ELEMID_MULTI_BSSID_IDX 85
+#define WLAN_ELEMID_REDUCED_NEIGHBOR_REPORT 201
+#define WLAN_ELEMID_VENDOR 221
+#define WLAN_ELEMID_EXTN_ELEM 255
+#define WLAN_EXTN_ELEMID_NONINHERITANCE 56
+
+#define MBSSID_INDICATOR_POS 2
+#define MIN_IE_LEN 2
+#define TAG_LEN_POS 1
+#define VALID_ELEM_LEAST_LEN 4
+#define SUBELEMENT_START_POS 3
+#define MAX_SUBELEM_LEN 252
+#define PAYLOAD_START_POS 2
+#define FIXED_LENGTH 36
+#define ID_POS 0
+#define BSS_INDEX_POS 2
+#define MIN_VENDOR_TAG_LEN 7
+#define ELEM_ID_EXTN_POS 2
+#define ELEM_ID_LIST_LEN_POS 3
+#define ELEM_ID_LIST_POS 4
+
+struct non_inheritance_ie {
+	uint8_t list_len;
+	uint8_t extn_len;
+	bool non_inherit;
+	bool non_inh_ie_found;
+};
+
+#define scm_debug(params...)
+#define scm_err(params...)
+
+#endif /* __SCAN_IE_REPLAY_WLAN_SCAN_PUBLIC_STRUCTS_H */
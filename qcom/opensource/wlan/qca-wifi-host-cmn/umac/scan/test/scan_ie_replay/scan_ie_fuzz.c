@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * scan_ie_fuzz - differential fuzz of the nontx BSSID profile generation
+ *
+ * Generates random transmitted BSSID IE lists and nontx profiles and checks
+ * that scm_mbssid_gen_new_ie(), which reads both through IE indexes, writes
+ * the same IEs as the copy based util_gen_new_ie() it replaced, kept in
+ * scan_ie_ref.c. It also checks that the profile is left as it was, since
+ * the index based generation no longer works on a copy of it.
+ *
+ * The lists mix well formed IEs with the corruptions beacons come with: IEs
+ * cut short at the end of the list, zero element IDs, repeated IEs and non
+ * inheritance elements whose list lengths do not add up. Extension elements
+ * always have an extension ID: util_gen_new_ie() read past a zero-length
+ * one, and scm_mbssid_gen_new_ie() does not take it as non inheritance.
+ *
+ * Usage: scan_ie_fuzz [-n iterations] [-s seed]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <qdf_types.h>
+#include "wlan_scan_ie_index.h"
+#include "scan_ie_ref.h"
+
+#define FUZZ_MAX_IE_LEN 2048
+#define FUZZ_TX_IE_LEN 1500
+#define FUZZ_PROF_LEN MAX_SUBELEM_LEN
+#define FUZZ_MAX_IE_BODY 24
+#define FUZZ_MAX_IES 20
+#define FUZZ_MAX_REPORTS 4
+
+static const uint8_t fuzz_eids[] = {
+	WLAN_ELEMID_SSID, 1, 3, 5, 45, 48, 61,
+	WLAN_ELEMID_MULTIPLE_BSSID, WLAN_ELEMID_NONTX_BSSID_CAP,
+	WLAN_ELEMID_MULTI_BSSID_IDX, 191, 192,
+	WLAN_ELEMID_REDUCED_NEIGHBOR_REPORT, WLAN_ELEMID_VENDOR,
+	WLAN_ELEMID_EXTN_ELEM,
+};
+
+static const uint8_t fuzz_extn_eids[] = {
+	35, 36, WLAN_EXTN_ELEMID_NONINHERITANCE, 106, 108,
+};
+
+#define FUZZ_PICK(_a) ((_a)[rand() % sizeof(_a)])
+
+/* Mostly small values, so that the IEs of both lists collide */
+static uint8_t fuzz_byte(void)
+{
+	return rand() % 4 ? rand() % 8 : rand();
+}
+
+/*
+ * Non inheritance body after the extension ID: the element ID list and the
+ * extension ID list, with their lengths right four times out of five.
+ */
+static void fuzz_put_noninh(uint8_t *body, uint8_t len)
+{
+	uint8_t list_len, i;
+
+	list_len = rand() % (len - 1);
+	body[1] = rand() % 5 ? list_len : rand() % 30;
+	for (i = 0; i < list_len; i++)
+		body[2 + i] = FUZZ_PICK(fuzz_eids);
+
+	if (2 + list_len >= len)
+		return;
+
+	body[2 + list_len] = rand() % 5 ? len - 3 - list_len : rand() % 9;
+	for (i = 3 + list_len; i < len; i++)
+		body[i] = FUZZ_PICK(fuzz_extn_eids);
+}
+
+static uint32_t fuzz_put_ie(uint8_t *buf)
+{
+	uint8_t eid = FUZZ_PICK(fuzz_eids);
+	uint8_t len = rand() % 6 ? rand() % FUZZ_MAX_IE_BODY : 0;
+	uint8_t *body = buf + MIN_IE_LEN;
+	uint8_t i;
+
+	if (eid == WLAN_ELEMID_EXTN_ELEM && !len)
+		len = 1;
+
+	buf[ID_POS] = eid;
+	buf[TAG_LEN_POS] = len;
+	for (i = 0; i < len; i++)
+		body[i] = fuzz_byte();
+
+	if (eid == WLAN_ELEMID_EXTN_ELEM) {
+		body[0] = FUZZ_PICK(fuzz_extn_eids);
+		if (body[0] == WLAN_EXTN_ELEMID_NONINHERITANCE && len >= 3)
+			fuzz_put_noninh(body, len);
+	}
+
+	/* Microsoft WMM/WME, so that vendor IEs compare equal */
+	if (eid == WLAN_ELEMID_VENDOR && len >= 4) {
+		body[0] = 0x00;
+		body[1] = 0x50;
+		body[2] = 0xf2;
+	}
+
+	if (eid == WLAN_ELEMID_MULTI_BSSID_IDX && len)
+		body[0] = rand() % 4;
+
+	return len + MIN_IE_LEN;
+}
+
+/*
+ * A transmitted BSSID IE list, most of the time starting with its SSID, or
+ * a nontx profile, starting with its capability.
+ */
+static uint32_t fuzz_gen(uint8_t *buf, uint32_t max_len, bool prof)
+{
+	uint32_t len = 0, num_ies = rand() % FUZZ_MAX_IES, trail;
+
+	if (prof) {
+		buf[len++] = WLAN_ELEMID_NONTX_BSSID_CAP;
+		buf[len++] = 2;
+		buf[len++] = rand();
+		buf[len++] = rand();
+	} else if (rand() % 8) {
+		buf[len++] = WLAN_ELEMID_SSID;
+		buf[len++] = 4;
+		memcpy(buf + len, "ssid", 4);
+		len += 4;
+	}
+
+	while (num_ies-- &&
+	       len + FUZZ_MAX_IE_BODY + MIN_IE_LEN * 2 + 3 <= max_len)
+		len += fuzz_put_ie(buf + len);
+
+	/* An IE cut short */
+	if (!(rand() % 4)) {
+		trail = rand() % 4;
+		while (trail--)
+			buf[len++] = rand();
+	}
+
+	return len;
+}
+
+static void fuzz_dump(const char *name, const uint8_t *buf, uint32_t len)
+{
+	uint32_t i;
+
+	printf("  %-8s", name);
+	for (i = 0; i < len; i++)
+		printf("%02x", buf[i]);
+	printf("\n");
+}
+
+int main(int argc, char *argv[])
+{
+	static uint8_t ie[FUZZ_MAX_IE_LEN], prof[FUZZ_MAX_IE_LEN];
+	static uint8_t prof_copy[FUZZ_MAX_IE_LEN];
+	static uint8_t ref_ie[FUZZ_MAX_IE_LEN], new_ie[FUZZ_MAX_IE_LEN];
+	struct scm_ie_index *tx_index, *prof_index;
+	uint32_t iters = 1000000, seed = 1, i, mismatches = 0;
+	uint32_t ielen, prof_len, ref_len, new_len;
+	uint8_t bssid_index;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:s:")) != -1) {
+		switch (opt) {
+		case 'n':
+			iters = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-n iterations] [-s seed]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+
+	tx_index = scm_ie_index_alloc(FUZZ_MAX_IE_LEN);
+	prof_index = scm_ie_index_alloc(FUZZ_MAX_IE_LEN);
+	if (!tx_index || !prof_index)
+		return 1;
+
+	srand(seed);
+	for (i = 0; i < iters; i++) {
+		ielen = fuzz_gen(ie, FUZZ_TX_IE_LEN, false);
+		prof_len = fuzz_gen(prof, FUZZ_PROF_LEN, true);
+		bssid_index = 1 + rand() % 8;
+		memcpy(prof_copy, prof, prof_len);
+
+		/* Bytes written past the returned length show up as well */
+		memset(ref_ie, 0xaa, sizeof(ref_ie));
+		memset(new_ie, 0xaa, sizeof(new_ie));
+
+		ref_len = scan_ie_ref_gen_new_ie(ie, ielen, prof, prof_len,
+						 ref_ie, bssid_index);
+		scm_ie_index_build(tx_index, ie, ielen);
+		new_len = scm_mbssid_gen_new_ie(NULL, tx_index, prof_index,
+						prof, prof_len, new_ie,
+						bssid_index);
+
+		if (ref_len == new_len && !memcmp(ref_ie, new_ie, ielen) &&
+		    !memcmp(prof, prof_copy, prof_len))
+			continue;
+
+		if (mismatches++ < FUZZ_MAX_REPORTS) {
+			printf("iteration %u: %u bytes, expected %u\n", i,
+			       new_len, ref_len);
+			fuzz_dump("ies", ie, ielen);
+			fuzz_dump("profile", prof_copy, prof_len);
+			fuzz_dump("expected", ref_ie, ref_len);
+			fuzz_dump("got", new_ie, new_len);
+		}
+	}
+
+	printf("%u iterations, %u mismatches\n", iters, mismatches);
+
+	scm_ie_index_free(prof_index);
+	scm_ie_index_free(tx_index);
+
+	return mismatches ? 1 : 0;
+}
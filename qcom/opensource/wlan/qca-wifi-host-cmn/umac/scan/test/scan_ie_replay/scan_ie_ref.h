@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __SCAN_IE_REPLAY_SCAN_IE_REF_H
+#define __SCAN_IE_REPLAY_SCAN_IE_REF_H
+
+#include <qdf_types.h>
+
+/**
+ * scan_ie_ref_gen_new_ie() - generate the IEs of a nontransmitted BSSID the
+ * way util_gen_new_ie() did before the IE index
+ * @ie: IEs of the frame carrying the MBSSID IE
+ * @ielen: length of @ie
+ * @subelement: nontransmitted BSSID profile
+ * @subie_len: length of @subelement
+ * @new_ie: buffer for the IEs, at least @ielen long
+ * @bssid_index: BSSID index from the MBSSID index IE of the profile
+ *
+ * Return: length of the IEs written to @new_ie, 0 on failure
+ */
+uint32_t scan_ie_ref_gen_new_ie(uint8_t *ie, uint32_t ielen,
+				uint8_t *subelement, size_t subie_len,
+				uint8_t *new_ie, uint8_t bssid_index);
+
+#endif /* __SCAN_IE_REPLAY_SCAN_IE_REF_H */
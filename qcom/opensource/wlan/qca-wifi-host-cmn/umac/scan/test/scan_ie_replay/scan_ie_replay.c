@@ -0,0 +1,408 @@
+/*
+ * Copyright (c) 2025 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * scan_ie_replay - host replay of the scan IE indexing and MBSSID expansion
+ *
+ * Replays a corpus of beacons and probe responses through the IE index and
+ * the nontransmitted BSSID profile generation of wlan_scan_ie_index.c, the
+ * way util_scan_parse_mbssid() does on the scheduler thread: the frame is
+ * indexed once, then for every nontx profile of its MBSSID elements the IEs
+ * of the new BSSID are generated and indexed in turn. Reports the number of
+ * scan entries (transmitted and nontransmitted BSSIDs) produced per second.
+ *
+ * The corpus is a text file with one frame per line, "<hex>", where <hex>
+ * is the whole frame starting with the 802.11 MAC header. Without one,
+ * beacons carrying an MBSSID element are synthesized. Profiles split over
+ * two MBSSID elements are not expanded. See the Makefile for the build.
+ *
+ * Usage: scan_ie_replay [-f corpus] [-n frames] [-p profiles] [-r rounds]
+ *                       [-s seed]
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <qdf_types.h>
+#include <qdf_mem.h>
+#include "wlan_scan_ie_index.h"
+
+#define REPLAY_MAX_FRAME 4096
+#define REPLAY_HDR_LEN 24
+#define REPLAY_MAX_PROFILES 64
+
+struct replay_frame {
+	uint32_t len;
+	uint8_t *data;
+};
+
+/**
+ * struct replay_ie - IE used to synthesize frames
+ * @eid: element ID
+ * @len: length of the IE body
+ * @prefix_len: number of valid bytes in @prefix
+ * @prefix: fixed leading bytes of the body (extension EID, OUI, ...)
+ * @pct: percentage of profiles overriding the IE of the transmitted BSSID,
+ *       for the IEs of a profile
+ */
+struct replay_ie {
+	uint8_t eid;
+	uint8_t len;
+	uint8_t prefix_len;
+	uint8_t prefix[5];
+	uint8_t pct;
+};
+
+static const struct replay_ie replay_tx_ies[] = {
+	{ 1, 8, 0, {0}, 0 },				/* Supported rates */
+	{ 3, 1, 0, {0}, 0 },				/* DS params */
+	{ 5, 4, 0, {0}, 0 },				/* TIM */
+	{ 7, 8, 0, {0}, 0 },				/* Country */
+	{ 11, 5, 0, {0}, 0 },				/* BSS load */
+	{ 45, 26, 0, {0}, 0 },				/* HT capabilities */
+	{ 48, 20, 0, {0}, 0 },				/* RSN */
+	{ 61, 22, 0, {0}, 0 },				/* HT operation */
+	{ 127, 10, 0, {0}, 0 },				/* Extended caps */
+	{ 191, 12, 0, {0}, 0 },				/* VHT capabilities */
+	{ 192, 5, 0, {0}, 0 },				/* VHT operation */
+	{ 201, 13, 0, {0}, 0 },				/* RNR */
+	{ 255, 26, 1, {35}, 0 },			/* HE capabilities */
+	{ 255, 7, 1, {36}, 0 },				/* HE operation */
+	{ 255, 14, 1, {38}, 0 },			/* MU EDCA */
+	{ 255, 3, 1, {59}, 0 },				/* HE 6 GHz band caps */
+	{ 221, 24, 5, {0x00, 0x50, 0xf2, 0x02, 0x01}, 0 }, /* WMM */
+	{ 221, 7, 4, {0x50, 0x6f, 0x9a, 0x16}, 0 },	/* MBO/OCE */
+	{ 221, 9, 3, {0x00, 0xa0, 0xc6}, 0 },		/* Qualcomm */
+};
+
+static const struct replay_ie replay_prof_ies[] = {
+	{ 48, 20, 0, {0}, 50 },				/* RSN */
+	{ 127, 10, 0, {0}, 30 },			/* Extended caps */
+	{ 255, 7, 1, {36}, 20 },			/* HE operation */
+	{ 221, 24, 5, {0x00, 0x50, 0xf2, 0x02, 0x01}, 30 }, /* WMM */
+	{ 221, 7, 4, {0x50, 0x6f, 0x9a, 0x16}, 20 },	/* MBO/OCE */
+	{ 255, 4, 1, {56}, 10 },			/* Non inheritance */
+};
+
+static uint64_t replay_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t replay_put_ie(uint8_t *buf, const struct replay_ie *ie)
+{
+	uint32_t i;
+
+	buf[0] = ie->eid;
+	buf[1] = ie->len;
+	for (i = 0; i < ie->len; i++)
+		buf[2 + i] = i < ie->prefix_len ? ie->prefix[i] : rand();
+
+	/* Non inheritance: do not inherit the RNR, no extension list */
+	if (ie->eid == WLAN_ELEMID_EXTN_ELEM && ie->prefix[0] == 56) {
+		buf[3] = 1;
+		buf[4] = WLAN_ELEMID_REDUCED_NEIGHBOR_REPORT;
+		buf[5] = 0;
+	}
+
+	return ie->len + MIN_IE_LEN;
+}
+
+static uint32_t replay_synth_prof(uint8_t *buf, uint32_t bssid_index)
+{
+	char ssid[16];
+	uint32_t len = 0, ssid_len, i;
+
+	/* Nontransmitted BSSID capability, SSID, Multiple BSSID-Index */
+	buf[len++] = WLAN_ELEMID_NONTX_BSSID_CAP;
+	buf[len++] = 2;
+	buf[len++] = 0x11;
+	buf[len++] = 0x04;
+	ssid_len = snprintf(ssid, sizeof(ssid), "nontx-%u", bssid_index);
+	buf[len++] = WLAN_ELEMID_SSID;
+	buf[len++] = ssid_len;
+	memcpy(buf + len, ssid, ssid_len);
+	len += ssid_len;
+	buf[len++] = WLAN_ELEMID_MULTI_BSSID_IDX;
+	buf[len++] = 1;
+	buf[len++] = bssid_index;
+
+	for (i = 0; i < sizeof(replay_prof_ies) / sizeof(replay_prof_ies[0]);
+	     i++) {
+		if (rand() % 100 < replay_prof_ies[i].pct)
+			len += replay_put_ie(buf + len, &replay_prof_ies[i]);
+	}
+
+	return len;
+}
+
+static uint32_t replay_synth(uint8_t *buf, uint32_t num_prof)
+{
+	uint8_t prof[MAX_SUBELEM_LEN];
+	uint8_t *mbssid = NULL;
+	uint32_t len = 0, prof_len, i;
+
+	/* Beacon, BSSID 00:03:7f:00:00:00 + random lower bits */
+	memset(buf, 0, REPLAY_HDR_LEN);
+	buf[0] = 0x80;
+	for (i = 0; i < QDF_MAC_ADDR_SIZE; i++) {
+		buf[10 + i] = i < 3 ? "\x00\x03\x7f"[i] : rand() & 0xf0;
+		buf[16 + i] = buf[10 + i];
+	}
+	len = REPLAY_HDR_LEN;
+
+	/* timestamp, beacon interval and capabilities */
+	for (i = 0; i < 12; i++)
+		buf[len++] = rand();
+
+	buf[len++] = WLAN_ELEMID_SSID;
+	buf[len++] = 7;
+	memcpy(buf + len, "tx-bssid", 7);
+	len += 7;
+
+	for (i = 0; i < sizeof(replay_tx_ies) / sizeof(replay_tx_ies[0]); i++)
+		len += replay_put_ie(buf + len, &replay_tx_ies[i]);
+
+	/*
+	 * Pack the profiles in as many MBSSID elements as needed, each one
+	 * starting with the MaxBSSID indicator.
+	 */
+	for (i = 1; i <= num_prof; i++) {
+		prof_len = replay_synth_prof(prof, i);
+		if (len + prof_len + 2 * MIN_IE_LEN + 1 > REPLAY_MAX_FRAME)
+			break;
+
+		if (!mbssid || mbssid[TAG_LEN_POS] + MIN_IE_LEN + prof_len >
+			       MAX_SUBELEM_LEN + SUBELEMENT_START_POS) {
+			mbssid = buf + len;
+			mbssid[0] = WLAN_ELEMID_MULTIPLE_BSSID;
+			mbssid[TAG_LEN_POS] = 1;
+			mbssid[MBSSID_INDICATOR_POS] = 6;
+			len += SUBELEMENT_START_POS;
+		}
+
+		buf[len++] = 0;
+		buf[len++] = prof_len;
+		memcpy(buf + len, prof, prof_len);
+		len += prof_len;
+		mbssid[TAG_LEN_POS] += MIN_IE_LEN + prof_len;
+	}
+
+	return len;
+}
+
+static int replay_hex(int c)
+{
+	if (isdigit(c))
+		return c - '0';
+	c = tolower(c);
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+static uint32_t replay_load(const char *path, struct replay_frame *frames,
+			    uint32_t max)
+{
+	static char line[2 * REPLAY_MAX_FRAME + 64];
+	uint8_t data[REPLAY_MAX_FRAME];
+	uint32_t n = 0, len;
+	char *p;
+	FILE *fp;
+
+	fp = fopen(path, "r");
+	if (!fp) {
+		perror(path);
+		exit(1);
+	}
+
+	while (n < max && fgets(line, sizeof(line), fp)) {
+		if (line[0] == '#' || isspace(line[0]))
+			continue;
+
+		len = 0;
+		p = line;
+		while (len < REPLAY_MAX_FRAME && replay_hex(p[0]) >= 0 &&
+		       replay_hex(p[1]) >= 0) {
+			data[len++] = replay_hex(p[0]) << 4 | replay_hex(p[1]);
+			p += 2;
+		}
+
+		if (len < FIXED_LENGTH)
+			continue;
+
+		frames[n].len = len;
+		frames[n].data = malloc(len);
+		memcpy(frames[n].data, data, len);
+		n++;
+	}
+
+	fclose(fp);
+	return n;
+}
+
+/*
+ * Index the frame, then generate and index the IEs of every nontx profile
+ * it carries. Returns the number of scan entries, the transmitted BSSID
+ * included.
+ */
+static uint32_t replay_frame(struct replay_frame *frame,
+			     struct scm_ie_index *tx_index,
+			     struct scm_ie_index *prof_index,
+			     struct scm_ie_index *entry_index,
+			     uint8_t *new_ie)
+{
+	uint8_t *ie = frame->data + FIXED_LENGTH;
+	uint32_t ielen = frame->len - FIXED_LENGTH;
+	uint8_t *mbssid, *sub, *end, *bssid_idx;
+	uint32_t entries = 1, new_ie_len;
+	uint16_t pos;
+
+	scm_ie_index_build(tx_index, ie, ielen);
+
+	for (pos = scm_ie_index_first(tx_index, WLAN_ELEMID_MULTIPLE_BSSID);
+	     pos != SCM_IE_INDEX_INVALID;
+	     pos = scm_ie_index_next(tx_index, pos)) {
+		mbssid = scm_ie_index_ie(tx_index, pos);
+		end = mbssid + mbssid[TAG_LEN_POS] + MIN_IE_LEN;
+
+		for (sub = mbssid + SUBELEMENT_START_POS;
+		     sub + MIN_IE_LEN <= end &&
+		     sub + MIN_IE_LEN + sub[TAG_LEN_POS] <= end;
+		     sub += MIN_IE_LEN + sub[TAG_LEN_POS]) {
+			if (sub[ID_POS] ||
+			    sub[TAG_LEN_POS] < VALID_ELEM_LEAST_LEN ||
+			    sub[PAYLOAD_START_POS] !=
+			    WLAN_ELEMID_NONTX_BSSID_CAP)
+				continue;
+
+			new_ie_len =
+				scm_mbssid_gen_new_ie(NULL, tx_index,
+						      prof_index,
+						      sub + PAYLOAD_START_POS,
+						      sub[TAG_LEN_POS], new_ie,
+						      0);
+			if (!new_ie_len)
+				continue;
+
+			bssid_idx = scm_ie_index_find(prof_index,
+						      WLAN_ELEMID_MULTI_BSSID_IDX);
+			if (!bssid_idx || !bssid_idx[TAG_LEN_POS])
+				continue;
+
+			/* The pass util_scan_populate_bcn_ie_list() makes */
+			scm_ie_index_build(entry_index, new_ie, new_ie_len);
+			entries++;
+		}
+	}
+
+	return entries;
+}
+
+int main(int argc, char *argv[])
+{
+	struct scm_ie_index *tx_index, *prof_index, *entry_index;
+	struct replay_frame *frames;
+	const char *path = NULL;
+	uint32_t num = 1000, rounds = 50, seed = 1, num_prof = 16;
+	uint32_t i, r, entries = 0;
+	uint8_t buf[REPLAY_MAX_FRAME];
+	uint8_t new_ie[REPLAY_MAX_FRAME];
+	uint64_t start, ns, ies = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "f:n:p:r:s:")) != -1) {
+		switch (opt) {
+		case 'f':
+			path = optarg;
+			break;
+		case 'n':
+			num = strtoul(optarg, NULL, 0);
+			break;
+		case 'p':
+			num_prof = strtoul(optarg, NULL, 0);
+			if (num_prof > REPLAY_MAX_PROFILES)
+				num_prof = REPLAY_MAX_PROFILES;
+			break;
+		case 'r':
+			rounds = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-f corpus] [-n frames] "
+				"[-p profiles] [-r rounds] [-s seed]\n",
+				argv[0]);
+			return 1;
+		}
+	}
+
+	frames = calloc(num, sizeof(*frames));
+	tx_index = scm_ie_index_alloc(REPLAY_MAX_FRAME);
+	prof_index = scm_ie_index_alloc(REPLAY_MAX_FRAME);
+	entry_index = scm_ie_index_alloc(REPLAY_MAX_FRAME);
+	if (!frames || !tx_index || !prof_index || !entry_index)
+		return 1;
+
+	if (path) {
+		num = replay_load(path, frames, num);
+	} else {
+		srand(seed);
+		for (i = 0; i < num; i++) {
+			frames[i].len = replay_synth(buf, num_prof);
+			frames[i].data = malloc(frames[i].len);
+			memcpy(frames[i].data, buf, frames[i].len);
+		}
+	}
+
+	for (i = 0; i < num; i++) {
+		entries += replay_frame(&frames[i], tx_index, prof_index,
+					entry_index, new_ie);
+		ies += tx_index->num_ies;
+	}
+
+	start = replay_now_ns();
+	for (r = 0; r < rounds; r++)
+		for (i = 0; i < num; i++)
+			replay_frame(&frames[i], tx_index, prof_index,
+				     entry_index, new_ie);
+	ns = replay_now_ns() - start;
+
+	printf("frames %u, %.1f IEs per frame, %.1f entries per frame, %u rounds\n",
+	       num, num ? (double)ies / num : 0.0,
+	       num ? (double)entries / num : 0.0, rounds);
+	printf("%.1f ns/frame, %.1f ns/entry, %.0f entries/s\n",
+	       num ? (double)ns / ((uint64_t)num * rounds) : 0.0,
+	       entries ? (double)ns / ((uint64_t)entries * rounds) : 0.0,
+	       ns ? (double)entries * rounds * 1e9 / ns : 0.0);
+
+	for (i = 0; i < num; i++)
+		free(frames[i].data);
+	free(frames);
+	scm_ie_index_free(entry_index);
+	scm_ie_index_free(prof_index);
+	scm_ie_index_free(tx_index);
+
+	return 0;
+}
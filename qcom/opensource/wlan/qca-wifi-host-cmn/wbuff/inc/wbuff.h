@@ -35,6 +35,9 @@
 enum wbuff_module_id {
 	WBUFF_MODULE_WMI_TX,
 	WBUFF_MODULE_CE_RX,
+#ifdef WLAN_WBUFF_TEST
+	WBUFF_MODULE_TEST,
+#endif
 	WBUFF_MAX_MODULES,
 };
 
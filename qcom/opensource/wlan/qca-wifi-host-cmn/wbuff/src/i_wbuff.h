@@ -34,6 +34,12 @@
 #define WBUFF_POOL_ID_SHIFT 1
 #define WBUFF_POOL_ID_BITMASK 0xE
 
+/*
+ * Upper bound of buffers a CPU keeps in its magazine for a pool. The
+ * actual size is scaled down for small pools, see wbuff_pcpu_cache_size().
+ */
+#define WBUFF_PCPU_CACHE_SIZE 16
+
 /**
  * struct wbuff_handle - wbuff handle to the registered module
  * @id: the identifier for the registered module.
@@ -42,14 +48,40 @@ struct wbuff_handle {
 	uint8_t id;
 };
 
+/**
+ * struct wbuff_pcpu_cache - per CPU magazine and stats of a wbuff pool
+ * @bufs: buffers cached by this CPU
+ * @count: number of valid entries in @bufs
+ * @alloc_success: Successful allocations on this CPU
+ * @alloc_fail: Failed allocations on this CPU
+ * @cache_hit: Allocations served from @bufs without taking the pool lock
+ * @refill: Number of bulk refills of @bufs from the shared pool
+ * @spill: Number of bulk returns of @bufs to the shared pool
+ * @pending_returns: Buffers handed out minus buffers returned on this CPU
+ *
+ * Only ever touched by its own CPU with bottom halves disabled; readers sum
+ * the stats of all the CPUs.
+ */
+struct wbuff_pcpu_cache {
+	qdf_nbuf_t bufs[WBUFF_PCPU_CACHE_SIZE];
+	uint16_t count;
+	uint64_t alloc_success;
+	uint64_t alloc_fail;
+	uint64_t cache_hit;
+	uint64_t refill;
+	uint64_t spill;
+	int64_t pending_returns;
+} ____cacheline_aligned_in_smp;
+
 /**
  * struct wbuff_pool - structure representing wbuff pool
  * @initialized: To identify whether pool is initialized
  * @pool: nbuf pool
  * @buffer_size: size of the buffer in this @pool
  * @pool_id: pool identifier
- * @alloc_success: Successful allocations for this pool
- * @alloc_fail: Failed allocations for this pool
+ * @cache_size: buffers each CPU may cache, 0 if the magazines are bypassed
+ * @cache_batch: buffers moved per refill/spill between a magazine and @pool
+ * @pcpu: per CPU magazines and stats, QDF_MAX_AVAILABLE_CPU entries
  * @mem_alloc: Memory allocated for this pool
  */
 struct wbuff_pool {
@@ -57,16 +89,15 @@ struct wbuff_pool {
 	qdf_nbuf_t pool;
 	uint16_t buffer_size;
 	uint8_t pool_id;
-	uint64_t alloc_success;
-	uint64_t alloc_fail;
+	uint16_t cache_size;
+	uint16_t cache_batch;
+	struct wbuff_pcpu_cache *pcpu;
 	uint64_t mem_alloc;
 };
 
 /**
  * struct wbuff_module - allocation holder for wbuff registered module
  * @registered: To identify whether module is registered
- * @pending_returns: Number of buffers pending to be returned to
- * wbuff by the module
  * @lock: Lock for accessing per module buffer pools
  * @handle: wbuff handle for the registered module
  * @reserve: nbuf headroom to start with
@@ -75,7 +106,6 @@ struct wbuff_pool {
  */
 struct wbuff_module {
 	bool registered;
-	uint16_t pending_returns;
 	qdf_spinlock_t lock;
 	struct wbuff_handle handle;
 	int reserve;
@@ -26,6 +26,10 @@
 #include <linux/debugfs.h>
 #include <linux/seq_file.h>
 #include <qdf_debugfs.h>
+#include <qdf_defer.h>
+#include <qdf_dev.h>
+#include <qdf_lock.h>
+#include <qdf_util.h>
 #include "i_wbuff.h"
 
 /*
@@ -116,6 +120,110 @@ static qdf_nbuf_t wbuff_prepare_nbuf(uint8_t module_id, uint8_t pool_id,
 	return buf;
 }
 
+/**
+ * wbuff_pcpu_cache_size() - number of buffers each CPU may cache for a pool
+ * @pool_size: number of buffers in the pool
+ *
+ * At most half of the pool is allowed to sit in the magazines, so that a CPU
+ * which only allocates is not starved by buffers cached on other CPUs.
+ *
+ * Return: magazine size, 0 if the pool is too small to be worth caching
+ */
+static uint16_t wbuff_pcpu_cache_size(uint16_t pool_size)
+{
+	uint32_t num_cpus = 0;
+	uint32_t size;
+	int cpu;
+
+	qdf_for_each_possible_cpu(cpu)
+		num_cpus++;
+
+	size = pool_size / (2 * QDF_MAX(num_cpus, 1));
+	if (size < 2)
+		return 0;
+
+	return QDF_MIN(size, WBUFF_PCPU_CACHE_SIZE);
+}
+
+/**
+ * wbuff_pool_pop_bulk() - take buffers from the shared pool
+ * @mod: wbuff module reference
+ * @wbuff_pool: wbuff pool reference
+ * @bufs: array to fill with the buffers
+ * @num: maximum number of buffers to take
+ *
+ * Return: number of buffers placed in @bufs
+ */
+static uint16_t wbuff_pool_pop_bulk(struct wbuff_module *mod,
+				    struct wbuff_pool *wbuff_pool,
+				    qdf_nbuf_t *bufs, uint16_t num)
+{
+	uint16_t i = 0;
+
+	qdf_spin_lock(&mod->lock);
+	while (i < num && wbuff_pool->pool) {
+		bufs[i] = wbuff_pool->pool;
+		wbuff_pool->pool = qdf_nbuf_next(bufs[i]);
+		i++;
+	}
+	qdf_spin_unlock(&mod->lock);
+
+	return i;
+}
+
+/**
+ * wbuff_pool_push_bulk() - give buffers back to the shared pool
+ * @mod: wbuff module reference
+ * @wbuff_pool: wbuff pool reference
+ * @bufs: buffers to return
+ * @num: number of buffers in @bufs
+ *
+ * Return: void
+ */
+static void wbuff_pool_push_bulk(struct wbuff_module *mod,
+				 struct wbuff_pool *wbuff_pool,
+				 qdf_nbuf_t *bufs, uint16_t num)
+{
+	uint16_t i;
+
+	if (!num)
+		return;
+
+	for (i = 0; i < num - 1; i++)
+		qdf_nbuf_set_next(bufs[i], bufs[i + 1]);
+
+	qdf_spin_lock(&mod->lock);
+	qdf_nbuf_set_next(bufs[num - 1], wbuff_pool->pool);
+	wbuff_pool->pool = bufs[0];
+	qdf_spin_unlock(&mod->lock);
+}
+
+/**
+ * wbuff_pool_drain_pcpu() - move every cached buffer back to the shared pool
+ * @mod: wbuff module reference
+ * @wbuff_pool: wbuff pool reference
+ *
+ * Must only be called once no CPU can touch its magazine any more.
+ *
+ * Return: void
+ */
+static void wbuff_pool_drain_pcpu(struct wbuff_module *mod,
+				  struct wbuff_pool *wbuff_pool)
+{
+	struct wbuff_pcpu_cache *cache;
+	int cpu;
+
+	if (!wbuff_pool->pcpu)
+		return;
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		cache = &wbuff_pool->pcpu[cpu];
+		wbuff_pool_push_bulk(mod, wbuff_pool, cache->bufs,
+				     cache->count);
+		cache->count = 0;
+	}
+}
+
 /**
  * wbuff_is_valid_handle() - validate wbuff handle
  * @handle: wbuff handle passed by module
@@ -143,6 +251,11 @@ static char *wbuff_get_mod_name(enum wbuff_module_id module_id)
 	case WBUFF_MODULE_CE_RX:
 		str = "WBUFF_MODULE_CE_RX";
 		break;
+#ifdef WLAN_WBUFF_TEST
+	case WBUFF_MODULE_TEST:
+		str = "WBUFF_MODULE_TEST";
+		break;
+#endif
 	default:
 		str = "Invalid Module ID";
 		break;
@@ -164,7 +277,11 @@ static int wbuff_stats_debugfs_show(qdf_debugfs_file_t file, void *data)
 {
 	struct wbuff_module *mod;
 	struct wbuff_pool *wbuff_pool;
-	int i, j;
+	struct wbuff_pcpu_cache *cache;
+	uint64_t success, fail, hit, refill, spill;
+	int64_t pending;
+	uint32_t cached;
+	int i, j, cpu;
 
 	wbuff_debugfs_print(file, "WBUFF POOL STATS:\n");
 	wbuff_debugfs_print(file, "=================\n");
@@ -178,21 +295,42 @@ static int wbuff_stats_debugfs_show(qdf_debugfs_file_t file, void *data)
 		wbuff_debugfs_print(file, "Module (%d) : %s\n", i,
 				    wbuff_get_mod_name(i));
 
-		wbuff_debugfs_print(file, "%s %25s %20s %20s\n", "Pool ID",
-				    "Mem Allocated (In Bytes)",
-				    "Wbuff Success Count",
-				    "Wbuff Fail Count");
+		wbuff_debugfs_print(file,
+				    "%s %25s %20s %20s %15s %10s %10s %10s %10s\n",
+				    "Pool ID", "Mem Allocated (In Bytes)",
+				    "Wbuff Success Count", "Wbuff Fail Count",
+				    "Cache Hit", "Refill", "Spill", "Cached",
+				    "Pending");
 
 		for (j = 0; j < WBUFF_MAX_POOLS; j++) {
 			wbuff_pool = &mod->wbuff_pool[j];
 
-			if (!wbuff_pool->initialized)
+			if (!wbuff_pool->initialized || !wbuff_pool->pcpu)
 				continue;
 
-			wbuff_debugfs_print(file, "%d %30llu %20llu %20llu\n",
-					    j, wbuff_pool->mem_alloc,
-					    wbuff_pool->alloc_success,
-					    wbuff_pool->alloc_fail);
+			success = 0;
+			fail = 0;
+			hit = 0;
+			refill = 0;
+			spill = 0;
+			pending = 0;
+			cached = 0;
+			for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+				cache = &wbuff_pool->pcpu[cpu];
+				success += cache->alloc_success;
+				fail += cache->alloc_fail;
+				hit += cache->cache_hit;
+				refill += cache->refill;
+				spill += cache->spill;
+				pending += cache->pending_returns;
+				cached += cache->count;
+			}
+
+			wbuff_debugfs_print(file,
+					    "%d %30llu %20llu %20llu %15llu %10llu %10llu %10u %10lld\n",
+					    j, wbuff_pool->mem_alloc, success,
+					    fail, hit, refill, spill, cached,
+					    pending);
 		}
 		wbuff_debugfs_print(file, "\n");
 	}
@@ -346,6 +484,13 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num_pools,
 			wbuff_pool->pool = buf;
 		}
 
+		wbuff_pool->pcpu = qdf_mem_malloc(sizeof(*wbuff_pool->pcpu) *
+						  QDF_MAX_AVAILABLE_CPU);
+		if (!wbuff_pool->pcpu)
+			goto free_pools;
+
+		wbuff_pool->cache_size = wbuff_pcpu_cache_size(pool_size);
+		wbuff_pool->cache_batch = wbuff_pool->cache_size / 2;
 		wbuff_pool->pool_id = pool_id;
 		wbuff_pool->buffer_size = len;
 		wbuff_pool->initialized = true;
@@ -357,6 +502,24 @@ wbuff_module_register(struct wbuff_alloc_request *req, uint8_t num_pools,
 
 
 	return (struct wbuff_mod_handle *)&mod->handle;
+
+free_pools:
+	for (pool_id = 0; pool_id < WBUFF_MAX_POOLS; pool_id++) {
+		wbuff_pool = &mod->wbuff_pool[pool_id];
+
+		while (wbuff_pool->pool) {
+			buf = wbuff_pool->pool;
+			wbuff_pool->pool = qdf_nbuf_next(buf);
+			qdf_nbuf_free(buf);
+		}
+
+		qdf_mem_free(wbuff_pool->pcpu);
+		wbuff_pool->pcpu = NULL;
+		wbuff_pool->mem_alloc = 0;
+		wbuff_pool->initialized = false;
+	}
+
+	return NULL;
 }
 
 QDF_STATUS wbuff_module_deregister(struct wbuff_mod_handle *hdl)
@@ -380,26 +543,37 @@ QDF_STATUS wbuff_module_deregister(struct wbuff_mod_handle *hdl)
 	mod = &wbuff.mod[module_id];
 
 	qdf_spin_lock_bh(&mod->lock);
+	mod->registered = false;
+	qdf_spin_unlock_bh(&mod->lock);
+
+	/*
+	 * wbuff_buff_get() and wbuff_buff_put() only touch the magazines with
+	 * bottom halves disabled and after checking @registered, so once the
+	 * grace period has elapsed no CPU can be using its magazine.
+	 */
+	qdf_synchronize_rcu();
+
 	for (pool_id = 0; pool_id < WBUFF_MAX_POOLS; pool_id++) {
 		wbuff_pool = &mod->wbuff_pool[pool_id];
 
 		if (!wbuff_pool->initialized)
 			continue;
 
+		wbuff_pool_drain_pcpu(mod, wbuff_pool);
+
 		first = wbuff_pool->pool;
 		while (first) {
 			buf = first;
 			first = qdf_nbuf_next(buf);
 			qdf_nbuf_free(buf);
 		}
+		wbuff_pool->pool = NULL;
 
 		wbuff_pool->mem_alloc = 0;
-		wbuff_pool->alloc_success = 0;
-		wbuff_pool->alloc_fail = 0;
-
+		qdf_mem_free(wbuff_pool->pcpu);
+		wbuff_pool->pcpu = NULL;
+		wbuff_pool->initialized = false;
 	}
-	mod->registered = false;
-	qdf_spin_unlock_bh(&mod->lock);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -411,6 +585,7 @@ wbuff_buff_get(struct wbuff_mod_handle *hdl, uint8_t pool_id, uint32_t len,
 	struct wbuff_handle *handle;
 	struct wbuff_module *mod = NULL;
 	struct wbuff_pool *wbuff_pool;
+	struct wbuff_pcpu_cache *cache;
 	uint8_t module_id = 0;
 	qdf_nbuf_t buf = NULL;
 
@@ -437,20 +612,40 @@ wbuff_buff_get(struct wbuff_mod_handle *hdl, uint8_t pool_id, uint32_t len,
 	if (!wbuff_pool->initialized)
 		return NULL;
 
-	qdf_spin_lock_bh(&mod->lock);
-	if (wbuff_pool->pool) {
-		buf = wbuff_pool->pool;
-		wbuff_pool->pool = qdf_nbuf_next(buf);
-		mod->pending_returns++;
+	qdf_local_bh_disable();
+	if (qdf_unlikely(!mod->registered)) {
+		qdf_local_bh_enable();
+		return NULL;
 	}
-	qdf_spin_unlock_bh(&mod->lock);
+
+	cache = &wbuff_pool->pcpu[qdf_get_smp_processor_id()];
+	if (!wbuff_pool->cache_size) {
+		wbuff_pool_pop_bulk(mod, wbuff_pool, &buf, 1);
+	} else {
+		if (cache->count) {
+			cache->cache_hit++;
+		} else {
+			cache->count = wbuff_pool_pop_bulk(mod, wbuff_pool,
+							   cache->bufs,
+							   wbuff_pool->cache_batch);
+			cache->refill++;
+		}
+
+		if (cache->count)
+			buf = cache->bufs[--cache->count];
+	}
+
+	if (buf) {
+		cache->alloc_success++;
+		cache->pending_returns++;
+	} else {
+		cache->alloc_fail++;
+	}
+	qdf_local_bh_enable();
 
 	if (buf) {
 		qdf_nbuf_set_next(buf, NULL);
 		qdf_net_buf_debug_update_node(buf, func_name, line_num);
-		wbuff_pool->alloc_success++;
-	} else {
-		wbuff_pool->alloc_fail++;
 	}
 
 	return buf;
@@ -461,7 +656,10 @@ qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf)
 	qdf_nbuf_t buffer = buf;
 	unsigned long pool_info = 0;
 	uint8_t module_id = 0, pool_id = 0;
+	struct wbuff_module *mod;
 	struct wbuff_pool *wbuff_pool;
+	struct wbuff_pcpu_cache *cache;
+	uint16_t batch;
 
 	if (qdf_nbuf_get_users(buffer) > 1)
 		return buffer;
@@ -480,21 +678,35 @@ qdf_nbuf_t wbuff_buff_put(qdf_nbuf_t buf)
 	if (module_id >= WBUFF_MAX_MODULES || pool_id >= WBUFF_MAX_POOLS)
 		return buffer;
 
-	wbuff_pool = &wbuff.mod[module_id].wbuff_pool[pool_id];
+	mod = &wbuff.mod[module_id];
+	wbuff_pool = &mod->wbuff_pool[pool_id];
 	if (!wbuff_pool->initialized)
 		return buffer;
 
-	qdf_nbuf_reset(buffer, wbuff.mod[module_id].reserve,
-		       wbuff.mod[module_id].align);
+	qdf_nbuf_reset(buffer, mod->reserve, mod->align);
+
+	qdf_local_bh_disable();
+	if (qdf_unlikely(!mod->registered)) {
+		qdf_local_bh_enable();
+		return buffer;
+	}
+
+	cache = &wbuff_pool->pcpu[qdf_get_smp_processor_id()];
+	if (!wbuff_pool->cache_size) {
+		wbuff_pool_push_bulk(mod, wbuff_pool, &buffer, 1);
+	} else {
+		if (cache->count == wbuff_pool->cache_size) {
+			batch = wbuff_pool->cache_batch;
+			cache->count -= batch;
+			wbuff_pool_push_bulk(mod, wbuff_pool,
+					     &cache->bufs[cache->count], batch);
+			cache->spill++;
+		}
 
-	qdf_spin_lock_bh(&wbuff.mod[module_id].lock);
-	if (wbuff.mod[module_id].registered) {
-		qdf_nbuf_set_next(buffer, wbuff_pool->pool);
-		wbuff_pool->pool = buffer;
-		wbuff.mod[module_id].pending_returns--;
-		buffer = NULL;
+		cache->bufs[cache->count++] = buffer;
 	}
-	qdf_spin_unlock_bh(&wbuff.mod[module_id].lock);
+	cache->pending_returns--;
+	qdf_local_bh_enable();
 
-	return buffer;
+	return NULL;
 }
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2023 Qualcomm Innovation Center, Inc. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include "qdf_mem.h"
+#include "qdf_threads.h"
+#include "qdf_trace.h"
+#include "qdf_dev.h"
+#include "wbuff.h"
+#include "i_wbuff.h"
+#include "wbuff_test.h"
+
+#define wbuff_ut_pool_id 0
+#define wbuff_ut_pool_size 512
+#define wbuff_ut_buf_size 256
+#define wbuff_ut_iterations 100000
+#define wbuff_ut_hold 8
+
+extern struct wbuff_holder wbuff;
+
+/**
+ * struct wbuff_ut_ctx - per thread context of the stress test
+ * @hdl: wbuff handle of the test module
+ * @thread: thread hammering the pool
+ * @id: identifier stamped into the buffers this thread owns
+ * @errors: number of errors seen by this thread
+ */
+struct wbuff_ut_ctx {
+	struct wbuff_mod_handle *hdl;
+	qdf_thread_t *thread;
+	uint32_t id;
+	uint32_t errors;
+};
+
+/**
+ * wbuff_ut_count() - count the buffers owned by the test pool
+ * @pending: filled with the sum of the per CPU pending returns
+ *
+ * Return: buffers in the shared pool plus the buffers in the magazines
+ */
+static uint32_t wbuff_ut_count(int64_t *pending)
+{
+	struct wbuff_module *mod = &wbuff.mod[WBUFF_MODULE_TEST];
+	struct wbuff_pool *wbuff_pool = &mod->wbuff_pool[wbuff_ut_pool_id];
+	qdf_nbuf_t buf;
+	uint32_t count = 0;
+	int cpu;
+
+	*pending = 0;
+
+	qdf_spin_lock_bh(&mod->lock);
+	for (buf = wbuff_pool->pool; buf; buf = qdf_nbuf_next(buf))
+		count++;
+	qdf_spin_unlock_bh(&mod->lock);
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		count += wbuff_pool->pcpu[cpu].count;
+		*pending += wbuff_pool->pcpu[cpu].pending_returns;
+	}
+
+	return count;
+}
+
+static QDF_STATUS wbuff_ut_stress_thread(void *context)
+{
+	struct wbuff_ut_ctx *ctx = context;
+	qdf_nbuf_t held[wbuff_ut_hold];
+	uint32_t i, j, num, tag;
+
+	for (i = 0; i < wbuff_ut_iterations; i++) {
+		num = (i % wbuff_ut_hold) + 1;
+
+		for (j = 0; j < num; j++) {
+			held[j] = wbuff_buff_get(ctx->hdl, wbuff_ut_pool_id, 0,
+						 __func__, __LINE__);
+			if (!held[j])
+				continue;
+
+			/* a buffer handed out twice gets its tag overwritten */
+			tag = (ctx->id << 24) | ((i & 0xffff) << 8) | j;
+			*(uint32_t *)qdf_nbuf_data(held[j]) = tag;
+		}
+
+		for (j = 0; j < num; j++) {
+			if (!held[j])
+				continue;
+
+			tag = (ctx->id << 24) | ((i & 0xffff) << 8) | j;
+			if (*(uint32_t *)qdf_nbuf_data(held[j]) != tag) {
+				qdf_nofl_alert("FAIL: thread %u buffer %pK shared",
+					       ctx->id, held[j]);
+				ctx->errors++;
+			}
+
+			held[j] = wbuff_buff_put(held[j]);
+			if (held[j]) {
+				qdf_nofl_alert("FAIL: thread %u put refused",
+					       ctx->id);
+				ctx->errors++;
+				qdf_nbuf_free(held[j]);
+			}
+		}
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static uint32_t wbuff_ut_stress(void)
+{
+	struct wbuff_alloc_request req = {
+		.pool_id = wbuff_ut_pool_id,
+		.pool_size = wbuff_ut_pool_size,
+		.buffer_size = wbuff_ut_buf_size,
+	};
+	struct wbuff_mod_handle *hdl;
+	struct wbuff_ut_ctx *ctx;
+	qdf_cpu_mask mask;
+	uint32_t before, after, errors = 0;
+	int64_t pending;
+	int cpu;
+
+	hdl = wbuff_module_register(&req, 1, 0, 4, WBUFF_MODULE_TEST);
+	if (!hdl) {
+		qdf_nofl_alert("FAIL: wbuff test module registration");
+		return 1;
+	}
+
+	ctx = qdf_mem_malloc(sizeof(*ctx) * QDF_MAX_AVAILABLE_CPU);
+	if (!ctx) {
+		wbuff_module_deregister(hdl);
+		return 1;
+	}
+
+	before = wbuff_ut_count(&pending);
+
+	qdf_for_each_online_cpu(cpu) {
+		ctx[cpu].hdl = hdl;
+		ctx[cpu].id = cpu;
+		ctx[cpu].thread = qdf_thread_run(wbuff_ut_stress_thread,
+						 &ctx[cpu]);
+		if (!ctx[cpu].thread) {
+			errors++;
+			continue;
+		}
+
+		qdf_cpumask_clear(&mask);
+		qdf_cpumask_set_cpu(cpu, &mask);
+		qdf_thread_set_cpus_allowed_mask(ctx[cpu].thread, &mask);
+	}
+
+	for (cpu = 0; cpu < QDF_MAX_AVAILABLE_CPU; cpu++) {
+		if (!ctx[cpu].thread)
+			continue;
+
+		qdf_thread_join(ctx[cpu].thread);
+		errors += ctx[cpu].errors;
+	}
+
+	after = wbuff_ut_count(&pending);
+	if (after != before) {
+		qdf_nofl_alert("FAIL: %u buffers before stress, %u after",
+			       before, after);
+		errors++;
+	}
+
+	if (pending) {
+		qdf_nofl_alert("FAIL: %lld buffers pending return", pending);
+		errors++;
+	}
+
+	qdf_mem_free(ctx);
+
+	if (QDF_IS_STATUS_ERROR(wbuff_module_deregister(hdl)))
+		errors++;
+
+	return errors;
+}
+
+uint32_t wbuff_unit_test(void)
+{
+	uint32_t errors = 0;
+
+	errors += wbuff_ut_stress();
+
+	return errors;
+}
@@ -1564,6 +1564,25 @@
 		CFG_INI_BOOL("peer_ext_stats", \
 		false, "Peer extended stats")
 
+/*
+ * <ini>
+ * peer_delay_percentile - Enable/Disable the peer delay percentiles
+ * @Default: false
+ *
+ * This ini adds log-linear buckets to each peer extended delay histogram,
+ * from which the p50/p99/p99.9 delays are reported. It costs about 64KB
+ * more per peer.
+ *
+ * Related: peer_ext_stats
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_PEER_DELAY_PERCENTILE \
+		CFG_INI_BOOL("peer_delay_percentile", \
+		false, "Peer delay percentiles")
+
 #if defined QCA_ENHANCED_STATS_SUPPORT || defined DP_MLO_LINK_STATS_SUPPORT
 #define DEFAULT_PEER_LINK_STATS_VALUE true
 #else
@@ -2157,6 +2176,7 @@
 		CFG(CFG_DP_FULL_MON_MODE) \
 		CFG(CFG_DP_REO_RINGS_MAP) \
 		CFG(CFG_DP_PEER_EXT_STATS) \
+		CFG(CFG_DP_PEER_DELAY_PERCENTILE) \
 		CFG(CFG_DP_PEER_JITTER_STATS) \
 		CFG(CFG_DP_PEER_LINK_STATS) \
 		CFG(CFG_DP_RX_BUFF_POOL_ENABLE) \
@@ -287,6 +287,7 @@ struct wlan_srng_cfg {
  * @reo_rings_mapping:
  * @rx_rings_mapping: DP RX rings mapping mask
  * @pext_stats_enabled: Flag to enable and disabled peer extended stats
+ * @delay_percentile_enabled: Flag to track the peer delay percentiles
  * @is_rx_buff_pool_enabled: flag to enable/disable emergency RX buffer
  *                           pool support
  * @is_rx_refill_buff_pool_enabled: flag to enable/disable RX refill buffer
@@ -485,6 +486,7 @@ struct wlan_cfg_dp_soc_ctxt {
 	uint32_t reo_rings_mapping;
 	uint32_t rx_rings_mapping;
 	bool pext_stats_enabled;
+	bool delay_percentile_enabled;
 	bool is_rx_buff_pool_enabled;
 	bool is_rx_refill_buff_pool_enabled;
 	bool enable_dp_buf_page_frag_alloc;
@@ -2137,6 +2139,18 @@ wlan_cfg_set_peer_jitter_stats(struct wlan_cfg_dp_soc_ctxt *cfg,
 bool
 wlan_cfg_is_peer_ext_stats_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
 
+/**
+ * wlan_cfg_is_peer_delay_percentile_enabled() - Check if the percentiles
+ *                                               of the peer delay stats
+ *                                               are tracked
+ *
+ * @cfg: soc configuration context
+ *
+ * Return: bool
+ */
+bool
+wlan_cfg_is_peer_delay_percentile_enabled(struct wlan_cfg_dp_soc_ctxt *cfg);
+
 /**
  * wlan_cfg_is_peer_jitter_stats_enabled() - check if jitter stats are enabled
  *
@@ -464,6 +464,12 @@ void dp_set_dump_dp_trace(uint16_t cmd_type, uint16_t count)
 		qdf_dp_trace_clear_buffer();
 	else if (cmd_type == DISABLE_DP_TRACE_LIVE_MODE)
 		qdf_dp_trace_disable_live_mode();
+	else if (cmd_type == ENABLE_DP_TRACE_PERCPU_MODE)
+		qdf_dp_trace_set_percpu_mode(true);
+	else if (cmd_type == DISABLE_DP_TRACE_PERCPU_MODE)
+		qdf_dp_trace_set_percpu_mode(false);
+	else if (cmd_type == BENCHMARK_DP_TRACE)
+		qdf_dp_trace_benchmark(count * 1000);
 }
 #else
 void dp_trace_init(struct wlan_objmgr_psoc *psoc)
@@ -23,6 +23,7 @@
  * debugfs unit_test_host
  */
 #include "wlan_hdd_main.h"
+#include "hal_rx_flow_test.h"
 #include "qdf_delayed_work_test.h"
 #include "qdf_hashtable_test.h"
 #include "qdf_periodic_work_test.h"
@@ -33,6 +34,7 @@
 #include "qdf_trace.h"
 #include "qdf_tracker_test.h"
 #include "qdf_types_test.h"
+#include "wbuff_test.h"
 #include "wlan_dsc_test.h"
 #include "wlan_hdd_unit_test.h"
 
@@ -45,6 +47,7 @@ struct hdd_ut_entry {
 
 struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "dsc", .callback = dsc_unit_test },
+	{ .name = "hal_rx_flow", .callback = hal_rx_flow_unit_test },
 	{ .name = "qdf_delayed_work", .callback = qdf_delayed_work_unit_test },
 	{ .name = "qdf_ht", .callback = qdf_ht_unit_test },
 	{ .name = "qdf_periodic_work",
@@ -54,6 +57,7 @@ struct hdd_ut_entry hdd_ut_entries[] = {
 	{ .name = "qdf_talloc", .callback = qdf_talloc_unit_test },
 	{ .name = "qdf_tracker", .callback = qdf_tracker_unit_test },
 	{ .name = "qdf_types", .callback = qdf_types_unit_test },
+	{ .name = "wbuff", .callback = wbuff_unit_test },
 };
 
 #define hdd_for_each_ut_entry(cursor) \
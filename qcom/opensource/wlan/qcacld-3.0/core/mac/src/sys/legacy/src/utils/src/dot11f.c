@@ -77,6 +77,28 @@ typedef struct sIEDefn {
 	tFRAMES_BOOL  fMandatory;
 } tIEDefn;
 
+/*
+ * Per IE table dispatch index, so that an IE is matched to its tIEDefn
+ * without scanning the table:
+ * eid: 1 + index of the first defn for an EID, or DOT11F_IE_INDEX_OUI when
+ *      all the defns for the EID carry an OUI of 3 bytes or more
+ * extn_eid: 1 + index of the first defn for an extension EID
+ * oui: 1 + index of the first OUI defn in a DOT11F_IE_INDEX_OUI_HASH bucket
+ * next: 1 + index of the next defn of the same eid/extn_eid/oui chain
+ * A 0 entry ends the chain; chains are in table order.
+ */
+typedef struct sIEIndex {
+	const uint8_t *eid;
+	const uint8_t *extn_eid;
+	const uint8_t *oui;
+	const uint8_t *next;
+} tIEIndex;
+
+#define DOT11F_IE_INDEX_OUI 0x80
+#define DOT11F_IE_INDEX_OUI_BUCKETS 16
+#define DOT11F_IE_INDEX_OUI_HASH(oui) \
+	(((oui)[0] ^ (oui)[1] ^ (oui)[2]) & (DOT11F_IE_INDEX_OUI_BUCKETS - 1))
+
 #if !defined(countof)
 #define countof(x) (sizeof((x)) / sizeof((x)[0]))
 #endif
@@ -286,43 +308,91 @@ static void frameshtonq(tpAniSirGlobal    pCtx,
 #endif
 }
 
+static inline bool ie_defn_match(tpAniSirGlobal pCtx,
+				 uint8_t *pBuf,
+				 uint32_t nBuf,
+				 const tIEDefn *pIe)
+{
+	if (*pBuf != pIe->eid)
+		return false;
+
+	if (pIe->eid == 0xff)
+		return (nBuf > 2) && (*(pBuf + 2)) == pIe->extn_eid;
+
+	if (0 == pIe->noui)
+		return true;
+
+	return (nBuf > (uint32_t)(pIe->noui + 2)) &&
+	       (!DOT11F_MEMCMP(pCtx, pBuf + 2, pIe->oui, pIe->noui));
+}
+
+#ifdef DOT11F_LINEAR_IE_LOOKUP
 static const tIEDefn *find_ie_defn(tpAniSirGlobal pCtx,
 				   uint8_t *pBuf,
 				   uint32_t nBuf,
-				   const tIEDefn  IEs[])
+				   const tIEDefn  IEs[],
+				   const tIEIndex *IEX)
 {
 	const tIEDefn *pIe;
 	(void)pCtx;
+	(void)IEX;
 
 	pIe = &(IEs[0]);
 	while (0xff != pIe->eid || pIe->extn_eid) {
-		if (*pBuf == pIe->eid) {
-			if (pIe->eid == 0xff) {
-				if ((nBuf > 2) &&
-				    (*(pBuf + 2)) == pIe->extn_eid)
-					return pIe;
-			} else {
-				if (0 == pIe->noui)
-					return pIe;
+		if (ie_defn_match(pCtx, pBuf, nBuf, pIe))
+			return pIe;
 
-				if ((nBuf > (uint32_t)(pIe->noui + 2)) &&
-				    (!DOT11F_MEMCMP(pCtx, pBuf + 2, pIe->oui,
-						      pIe->noui)))
-					return pIe;
-			}
+		++pIe;
+	}
+
+	return NULL;
+}
+#else
+static const tIEDefn *find_ie_defn(tpAniSirGlobal pCtx,
+				   uint8_t *pBuf,
+				   uint32_t nBuf,
+				   const tIEDefn  IEs[],
+				   const tIEIndex *IEX)
+{
+	const tIEDefn *pIe;
+	uint8_t idx;
+	(void)pCtx;
+
+	if (!IEX->eid)
+		return NULL;
+
+	if (*pBuf == 0xff) {
+		if (!IEX->extn_eid || nBuf <= 2)
+			return NULL;
+		idx = IEX->extn_eid[*(pBuf + 2)];
+	} else {
+		idx = IEX->eid[*pBuf];
+		if (idx == DOT11F_IE_INDEX_OUI) {
+			/* every defn of this EID needs at least 3 OUI bytes */
+			if (nBuf <= 5)
+				return NULL;
+			idx = IEX->oui[DOT11F_IE_INDEX_OUI_HASH(pBuf + 2)];
 		}
+	}
 
-		++pIe;
+	while (idx) {
+		pIe = &IEs[idx - 1];
+		if (ie_defn_match(pCtx, pBuf, nBuf, pIe))
+			return pIe;
+
+		idx = IEX->next[idx - 1];
 	}
 
 	return NULL;
 }
+#endif /* DOT11F_LINEAR_IE_LOOKUP */
 
 static uint32_t get_container_ies_len(tpAniSirGlobal pCtx,
 				      uint8_t *pBuf,
 				      uint32_t  nBuf,
 				      uint8_t *pnConsumed,
-				      const tIEDefn  IEs[])
+				      const tIEDefn  IEs[],
+				      const tIEIndex *IEX)
 {
 	const tIEDefn *pIe, *pIeFirst;
 	uint8_t *pBufRemaining = pBuf;
@@ -337,7 +407,7 @@ static uint32_t get_container_ies_len(tpAniSirGlobal pCtx,
 	pBufRemaining += len + 2;
 	len += 2;
 	while (len + 1 < nBuf) {
-		pIe = find_ie_defn(pCtx, pBufRemaining, nBuf - len, IEs);
+		pIe = find_ie_defn(pCtx, pBufRemaining, nBuf - len, IEs, IEX);
 		if (NULL == pIe)
 			break;
 		if (pIe->eid == pIeFirst->eid)
@@ -359,6 +429,7 @@ static uint32_t unpack_core(tpAniSirGlobal pCtx,
 			    uint32_t nBuf,
 			    const tFFDefn  FFs[],
 			    const tIEDefn  IEs[],
+			    const tIEIndex *IEX,
 			    uint8_t *pFrm,
 			    size_t nFrm,
 			    bool append_ie);
@@ -3887,6 +3958,22 @@ static const tIEDefn IES_neighbor_rpt[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_neighbor_rpt_eid[256] = {
+	[DOT11F_EID_TSFINFO] = 1,
+	[DOT11F_EID_CONDENSEDCOUNTRYSTR] = 2,
+	[DOT11F_EID_MEASUREMENTPILOT] = 3,
+	[DOT11F_EID_RRMENABLEDCAP] = 4,
+	[DOT11F_EID_MULTIBSSID] = 5,
+};
+
+static const uint8_t IEX_neighbor_rpt_next[] = {
+	0, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_neighbor_rpt = {
+	IEX_neighbor_rpt_eid, NULL, NULL, IEX_neighbor_rpt_next,
+};
+
 uint32_t dot11f_unpack_ie_neighbor_rpt(tpAniSirGlobal pCtx,
 				       uint8_t *pBuf,
 				       uint8_t ielen,
@@ -3972,7 +4059,7 @@ uint32_t dot11f_unpack_ie_neighbor_rpt(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_neighbor_rpt,
-				IES_neighbor_rpt,
+				IES_neighbor_rpt, &IEX_neighbor_rpt,
 				(uint8_t *)pDst,
 				sizeof(*pDst),
 				append_ie);
@@ -4445,6 +4532,23 @@ static const tIEDefn IES_ChannelSwitchWrapper[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_ChannelSwitchWrapper_eid[256] = {
+	[DOT11F_EID_WIDERBWCHANSWITCHANN] = 1,
+	[DOT11F_EID_TRANSMIT_POWER_ENV] = 2,
+};
+
+static const uint8_t IEX_ChannelSwitchWrapper_extn_eid[256] = {
+	[135] = 3,
+};
+
+static const uint8_t IEX_ChannelSwitchWrapper_next[] = {
+	0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_ChannelSwitchWrapper = {
+	IEX_ChannelSwitchWrapper_eid, IEX_ChannelSwitchWrapper_extn_eid, NULL, IEX_ChannelSwitchWrapper_next,
+};
+
 uint32_t dot11f_unpack_ie_channel_switch_wrapper(tpAniSirGlobal pCtx,
 					       uint8_t *pBuf,
 					       uint8_t ielen,
@@ -4461,7 +4565,7 @@ uint32_t dot11f_unpack_ie_channel_switch_wrapper(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_ChannelSwitchWrapper,
-				IES_ChannelSwitchWrapper,
+				IES_ChannelSwitchWrapper, &IEX_ChannelSwitchWrapper,
 				(uint8_t *)pDst,
 				sizeof(*pDst),
 				append_ie);
@@ -5117,6 +5221,21 @@ static const tIEDefn IES_FTInfo[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_FTInfo_eid[256] = {
+	[DOT11F_EID_R1KH_ID] = 1,
+	[DOT11F_EID_GTK] = 2,
+	[DOT11F_EID_R0KH_ID] = 3,
+	[DOT11F_EID_IGTK] = 4,
+};
+
+static const uint8_t IEX_FTInfo_next[] = {
+	0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_FTInfo = {
+	IEX_FTInfo_eid, NULL, NULL, IEX_FTInfo_next,
+};
+
 uint32_t dot11f_unpack_ie_ft_info(tpAniSirGlobal pCtx,
 				 uint8_t *pBuf,
 				 uint8_t ielen,
@@ -5168,7 +5287,7 @@ uint32_t dot11f_unpack_ie_ft_info(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_FTInfo,
-				IES_FTInfo,
+				IES_FTInfo, &IEX_FTInfo,
 				(uint8_t *)pDst,
 				sizeof(*pDst),
 				append_ie);
@@ -5509,6 +5628,19 @@ static const tIEDefn IES_reportchannel_load_report[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_reportchannel_load_report_eid[256] = {
+	[DOT11F_EID_WIDE_BW_CHAN_SWITCH] = 1,
+	[DOT11F_EID_BW_INDICATION] = 2,
+};
+
+static const uint8_t IEX_reportchannel_load_report_next[] = {
+	0, 0, 0,
+};
+
+static const tIEIndex IEX_reportchannel_load_report = {
+	IEX_reportchannel_load_report_eid, NULL, NULL, IEX_reportchannel_load_report_next,
+};
+
 static const tFFDefn FFS_reportBeacon[] = {
 	{ NULL, 0, 0, 0,},
 };
@@ -5534,6 +5666,20 @@ static const tIEDefn IES_reportBeacon[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_reportBeacon_eid[256] = {
+	[DOT11F_EID_BEACONREPORTFRMBODY] = 1,
+	[DOT11F_EID_BEACON_REPORT_FRM_BODY_FRAGMENT_ID] = 2,
+	[DOT11F_EID_LAST_BEACON_REPORT_INDICATION] = 3,
+};
+
+static const uint8_t IEX_reportBeacon_next[] = {
+	0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_reportBeacon = {
+	IEX_reportBeacon_eid, NULL, NULL, IEX_reportBeacon_next,
+};
+
 static const tFFDefn FFS_reportsta_stats[] = {
 	{ NULL, 0, 0, 0,},
 };
@@ -5546,6 +5692,18 @@ static const tIEDefn IES_reportsta_stats[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_reportsta_stats_eid[256] = {
+	[DOT11F_EID_REPORTING_REASON] = 1,
+};
+
+static const uint8_t IEX_reportsta_stats_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_reportsta_stats = {
+	IEX_reportsta_stats_eid, NULL, NULL, IEX_reportsta_stats_next,
+};
+
 uint32_t dot11f_unpack_ie_measurement_report(tpAniSirGlobal pCtx,
 					    uint8_t *pBuf,
 					    uint8_t ielen,
@@ -5801,7 +5959,7 @@ uint32_t dot11f_unpack_ie_measurement_report(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_reportchannel_load_report,
-				IES_reportchannel_load_report,
+				IES_reportchannel_load_report, &IEX_reportchannel_load_report,
 				(uint8_t *)pDst,
 				sizeof(*pDst), append_ie);
 			break;
@@ -5892,7 +6050,7 @@ uint32_t dot11f_unpack_ie_measurement_report(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_reportBeacon,
-				IES_reportBeacon,
+				IES_reportBeacon, &IEX_reportBeacon,
 				(uint8_t *)pDst,
 				sizeof(*pDst), append_ie);
 			break;
@@ -6191,7 +6349,7 @@ uint32_t dot11f_unpack_ie_measurement_report(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_reportsta_stats,
-				IES_reportsta_stats,
+				IES_reportsta_stats, &IEX_reportsta_stats,
 				(uint8_t *)pDst,
 				sizeof(*pDst), append_ie);
 			break;
@@ -6227,6 +6385,20 @@ static const tIEDefn IES_measurement_requestchannel_load[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_measurement_requestchannel_load_eid[256] = {
+	[DOT11F_EID_RRM_REPORTING] = 1,
+	[DOT11F_EID_WIDE_BW_CHAN_SWITCH] = 2,
+	[DOT11F_EID_BW_INDICATION] = 3,
+};
+
+static const uint8_t IEX_measurement_requestchannel_load_next[] = {
+	0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_measurement_requestchannel_load = {
+	IEX_measurement_requestchannel_load_eid, NULL, NULL, IEX_measurement_requestchannel_load_next,
+};
+
 static const tFFDefn FFS_measurement_requestBeacon[] = {
 	{ NULL, 0, 0, 0,},
 };
@@ -6268,6 +6440,24 @@ static const tIEDefn IES_measurement_requestBeacon[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_measurement_requestBeacon_eid[256] = {
+	[DOT11F_EID_SSID] = 1,
+	[DOT11F_EID_RRM_REPORTING] = 2,
+	[DOT11F_EID_BCNREPORTINGDETAIL] = 3,
+	[DOT11F_EID_REQUESTEDINFO] = 4,
+	[DOT11F_EID_EXTREQUESTEDINFO] = 5,
+	[DOT11F_EID_APCHANNELREPORT] = 6,
+	[DOT11F_EID_LAST_BEACON_REPORT_INDICATION] = 7,
+};
+
+static const uint8_t IEX_measurement_requestBeacon_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_measurement_requestBeacon = {
+	IEX_measurement_requestBeacon_eid, NULL, NULL, IEX_measurement_requestBeacon_next,
+};
+
 static const tFFDefn FFS_measurement_requestlci[] = {
 	{ NULL, 0, 0, 0,},
 };
@@ -6292,6 +6482,21 @@ static const tIEDefn IES_measurement_requestlci[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_measurement_requestlci_eid[256] = {
+	[DOT11F_EID_AZIMUTH_REQ] = 1,
+	[DOT11F_EID_REQ_MAC_ADDR] = 2,
+	[DOT11F_EID_TGT_MAC_ADDR] = 3,
+	[DOT11F_EID_MAX_AGE] = 4,
+};
+
+static const uint8_t IEX_measurement_requestlci_next[] = {
+	0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_measurement_requestlci = {
+	IEX_measurement_requestlci_eid, NULL, NULL, IEX_measurement_requestlci_next,
+};
+
 static const tFFDefn FFS_measurement_requestftmrr[] = {
 	{ NULL, 0, 0, 0,},
 };
@@ -6308,6 +6513,19 @@ static const tIEDefn IES_measurement_requestftmrr[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_measurement_requestftmrr_eid[256] = {
+	[DOT11F_EID_NEIGHBOR_RPT] = 1,
+	[DOT11F_EID_MAX_AGE] = 2,
+};
+
+static const uint8_t IEX_measurement_requestftmrr_next[] = {
+	0, 0, 0,
+};
+
+static const tIEIndex IEX_measurement_requestftmrr = {
+	IEX_measurement_requestftmrr_eid, NULL, NULL, IEX_measurement_requestftmrr_next,
+};
+
 uint32_t dot11f_unpack_ie_measurement_request(tpAniSirGlobal pCtx,
 					     uint8_t *pBuf,
 					     uint8_t ielen,
@@ -6466,7 +6684,7 @@ uint32_t dot11f_unpack_ie_measurement_request(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_measurement_requestchannel_load,
-				IES_measurement_requestchannel_load,
+				IES_measurement_requestchannel_load, &IEX_measurement_requestchannel_load,
 				(uint8_t *)pDst,
 				sizeof(*pDst), append_ie);
 		break;
@@ -6523,7 +6741,7 @@ uint32_t dot11f_unpack_ie_measurement_request(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_measurement_requestBeacon,
-				IES_measurement_requestBeacon,
+				IES_measurement_requestBeacon, &IEX_measurement_requestBeacon,
 				(uint8_t *)pDst,
 				sizeof(*pDst), append_ie);
 		break;
@@ -6540,7 +6758,7 @@ uint32_t dot11f_unpack_ie_measurement_request(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_measurement_requestlci,
-				IES_measurement_requestlci,
+				IES_measurement_requestlci, &IEX_measurement_requestlci,
 				(uint8_t *)pDst,
 				sizeof(*pDst), append_ie);
 		break;
@@ -6565,7 +6783,7 @@ uint32_t dot11f_unpack_ie_measurement_request(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_measurement_requestftmrr,
-				IES_measurement_requestftmrr,
+				IES_measurement_requestftmrr, &IEX_measurement_requestftmrr,
 				(uint8_t *)pDst,
 				sizeof(*pDst), append_ie);
 		break;
@@ -6674,6 +6892,22 @@ static const tIEDefn IES_NeighborReport[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_NeighborReport_eid[256] = {
+	[DOT11F_EID_TSFINFO] = 1,
+	[DOT11F_EID_CONDENSEDCOUNTRYSTR] = 2,
+	[DOT11F_EID_MEASUREMENTPILOT] = 3,
+	[DOT11F_EID_RRMENABLEDCAP] = 4,
+	[DOT11F_EID_MULTIBSSID] = 5,
+};
+
+static const uint8_t IEX_NeighborReport_next[] = {
+	0, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_NeighborReport = {
+	IEX_NeighborReport_eid, NULL, NULL, IEX_NeighborReport_next,
+};
+
 uint32_t dot11f_unpack_ie_neighbor_report(tpAniSirGlobal pCtx,
 					 uint8_t *pBuf,
 					 uint8_t ielen,
@@ -6759,7 +6993,7 @@ uint32_t dot11f_unpack_ie_neighbor_report(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_NeighborReport,
-				IES_NeighborReport,
+				IES_NeighborReport, &IEX_NeighborReport,
 				(uint8_t *)pDst,
 				sizeof(*pDst),
 				append_ie);
@@ -7560,6 +7794,29 @@ static const tIEDefn IES_RICDataDesc[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_RICDataDesc_eid[256] = {
+	[DOT11F_EID_RICDATA] = 1,
+	[DOT11F_EID_RICDESCRIPTOR] = 2,
+	[DOT11F_EID_TSPEC] = 3,
+	[DOT11F_EID_TCLAS] = 4,
+	[DOT11F_EID_TCLASSPROC] = 5,
+	[DOT11F_EID_TSDELAY] = 6,
+	[DOT11F_EID_SCHEDULE] = 7,
+	[DOT11F_EID_WMMTSPEC] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_RICDataDesc_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 8,
+};
+
+static const uint8_t IEX_RICDataDesc_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 9, 10, 11, 12, 0, 0,
+};
+
+static const tIEIndex IEX_RICDataDesc = {
+	IEX_RICDataDesc_eid, NULL, IEX_RICDataDesc_oui, IEX_RICDataDesc_next,
+};
+
 uint32_t dot11f_unpack_ie_ric_data_desc(tpAniSirGlobal pCtx,
 				      uint8_t *pBuf,
 				      uint8_t ielen,
@@ -7576,7 +7833,7 @@ uint32_t dot11f_unpack_ie_ric_data_desc(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_RICDataDesc,
-				IES_RICDataDesc,
+				IES_RICDataDesc, &IEX_RICDataDesc,
 				(uint8_t *)pDst,
 				sizeof(*pDst),
 				append_ie);
@@ -9386,6 +9643,22 @@ static const tIEDefn IES_descriptor_element[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_descriptor_element_eid[256] = {
+	[DOT11F_EID_MSCS_STATUS] = 2,
+};
+
+static const uint8_t IEX_descriptor_element_extn_eid[256] = {
+	[89] = 1,
+};
+
+static const uint8_t IEX_descriptor_element_next[] = {
+	0, 0, 0,
+};
+
+static const tIEIndex IEX_descriptor_element = {
+	IEX_descriptor_element_eid, IEX_descriptor_element_extn_eid, NULL, IEX_descriptor_element_next,
+};
+
 uint32_t dot11f_unpack_ie_descriptor_element(tpAniSirGlobal pCtx,
 					     uint8_t *pBuf,
 					     uint8_t ielen,
@@ -9426,7 +9699,7 @@ uint32_t dot11f_unpack_ie_descriptor_element(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_descriptor_element,
-				IES_descriptor_element,
+				IES_descriptor_element, &IEX_descriptor_element,
 				(uint8_t *)pDst,
 				sizeof(*pDst),
 				append_ie);
@@ -11492,6 +11765,19 @@ static const tIEDefn IES_vendor_vht_ie[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },
 };
 
+static const uint8_t IEX_vendor_vht_ie_eid[256] = {
+	[DOT11F_EID_VHTCAPS] = 1,
+	[DOT11F_EID_VHTOPERATION] = 2,
+};
+
+static const uint8_t IEX_vendor_vht_ie_next[] = {
+	0, 0, 0,
+};
+
+static const tIEIndex IEX_vendor_vht_ie = {
+	IEX_vendor_vht_ie_eid, NULL, NULL, IEX_vendor_vht_ie_next,
+};
+
 uint32_t dot11f_unpack_ie_vendor_vht_ie(tpAniSirGlobal pCtx,
 					 uint8_t *pBuf,
 					 uint8_t ielen,
@@ -11516,7 +11802,7 @@ uint32_t dot11f_unpack_ie_vendor_vht_ie(tpAniSirGlobal pCtx,
 				pBuf,
 				ielen,
 				FFS_vendor_vht_ie,
-				IES_vendor_vht_ie,
+				IES_vendor_vht_ie, &IEX_vendor_vht_ie,
 				(uint8_t *)pDst,
 				sizeof(*pDst),
 				append_ie);
@@ -11564,6 +11850,26 @@ static const tIEDefn IES_AddTSRequest[] = {
 	4, DOT11F_EID_ESETRAFSTRMRATESET, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_AddTSRequest_eid[256] = {
+	[DOT11F_EID_TSPEC] = 1,
+	[DOT11F_EID_TCLAS] = 2,
+	[DOT11F_EID_TCLASSPROC] = 3,
+	[DOT11F_EID_WMMTSPEC] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_AddTSRequest_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 4,
+	[6] = 7,
+};
+
+static const uint8_t IEX_AddTSRequest_next[] = {
+	0, 0, 0, 5, 6, 0, 0, 0,
+};
+
+static const tIEIndex IEX_AddTSRequest = {
+	IEX_AddTSRequest_eid, NULL, IEX_AddTSRequest_oui, IEX_AddTSRequest_next,
+};
+
 uint32_t dot11f_unpack_add_ts_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fAddTSRequest *pFrm, bool append_ie)
@@ -11571,7 +11877,7 @@ uint32_t dot11f_unpack_add_ts_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_AddTSRequest, IES_AddTSRequest,
+		      FFS_AddTSRequest, IES_AddTSRequest, &IEX_AddTSRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -11633,6 +11939,28 @@ static const tIEDefn IES_AddTSResponse[] = {
 	4, DOT11F_EID_ESETRAFSTRMMET, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_AddTSResponse_eid[256] = {
+	[DOT11F_EID_TSDELAY] = 1,
+	[DOT11F_EID_TSPEC] = 2,
+	[DOT11F_EID_TCLAS] = 3,
+	[DOT11F_EID_TCLASSPROC] = 4,
+	[DOT11F_EID_SCHEDULE] = 5,
+	[DOT11F_EID_WMMTSDELAY] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_AddTSResponse_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 6,
+	[6] = 11,
+};
+
+static const uint8_t IEX_AddTSResponse_next[] = {
+	0, 0, 0, 0, 0, 7, 8, 9, 10, 0, 0, 0,
+};
+
+static const tIEIndex IEX_AddTSResponse = {
+	IEX_AddTSResponse_eid, NULL, IEX_AddTSResponse_oui, IEX_AddTSResponse_next,
+};
+
 uint32_t dot11f_unpack_add_ts_response(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fAddTSResponse *pFrm, bool append_ie)
@@ -11640,7 +11968,7 @@ uint32_t dot11f_unpack_add_ts_response(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_AddTSResponse, IES_AddTSResponse,
+		      FFS_AddTSResponse, IES_AddTSResponse, &IEX_AddTSResponse,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -11813,6 +12141,59 @@ static const tIEDefn IES_AssocRequest[] = {
 	{80, 111, 154, 29, 0}, 4, DOT11F_EID_ROAMING_CONSORTIUM_SEL, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_AssocRequest_eid[256] = {
+	[DOT11F_EID_SSID] = 1,
+	[DOT11F_EID_SUPPRATES] = 2,
+	[DOT11F_EID_EXTSUPPRATES] = 3,
+	[DOT11F_EID_POWERCAPS] = 4,
+	[DOT11F_EID_SUPPCHANNELS] = 5,
+	[DOT11F_EID_RSNOPAQUE] = 6,
+	[DOT11F_EID_QOSCAPSSTATION] = 7,
+	[DOT11F_EID_RRMENABLEDCAP] = 8,
+	[DOT11F_EID_MOBILITYDOMAIN] = 9,
+	[DOT11F_EID_SUPPOPERATINGCLASSES] = 10,
+	[DOT11F_EID_HTCAPS] = 11,
+	[DOT11F_EID_EXTCAP] = 12,
+	[DOT11F_EID_VHTCAPS] = 13,
+	[DOT11F_EID_OPERATINGMODE] = 14,
+	[DOT11F_EID_BSS_MAX_IDLE_PERIOD] = 19,
+	[DOT11F_EID_FTINFO] = 20,
+	[DOT11F_EID_WAPIOPAQUE] = 23,
+	[DOT11F_EID_QOSMAPSET] = 25,
+	[DOT11F_EID_FRAGMENT_IE] = 26,
+	[DOT11F_EID_WPAOPAQUE] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_AssocRequest_extn_eid[256] = {
+	[4] = 15,
+	[12] = 16,
+	[3] = 17,
+	[5] = 18,
+	[35] = 21,
+	[59] = 22,
+	[32] = 27,
+	[108] = 28,
+	[107] = 29,
+	[109] = 30,
+};
+
+static const uint8_t IEX_AssocRequest_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[1] = 41,
+	[2] = 31,
+	[5] = 37,
+	[6] = 35,
+	[12] = 39,
+};
+
+static const uint8_t IEX_AssocRequest_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 24, 0,
+	0, 0, 0, 0, 0, 0, 32, 33, 34, 0, 36, 0, 38, 40, 0, 42, 0, 43, 0, 0,
+};
+
+static const tIEIndex IEX_AssocRequest = {
+	IEX_AssocRequest_eid, IEX_AssocRequest_extn_eid, IEX_AssocRequest_oui, IEX_AssocRequest_next,
+};
+
 uint32_t dot11f_unpack_assoc_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fAssocRequest *pFrm, bool append_ie)
@@ -11820,7 +12201,7 @@ uint32_t dot11f_unpack_assoc_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_AssocRequest, IES_AssocRequest,
+		      FFS_AssocRequest, IES_AssocRequest, &IEX_AssocRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12013,6 +12394,68 @@ static const tIEDefn IES_AssocResponse[] = {
 	{0, 0, 0, 0, 0}, 0, DOT11F_EID_REDUCED_NEIGHBOR_REPORT, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_AssocResponse_eid[256] = {
+	[DOT11F_EID_SUPPRATES] = 1,
+	[DOT11F_EID_EXTSUPPRATES] = 2,
+	[DOT11F_EID_EDCAPARAMSET] = 3,
+	[DOT11F_EID_RCPIIE] = 4,
+	[DOT11F_EID_RSNIIE] = 5,
+	[DOT11F_EID_RRMENABLEDCAP] = 6,
+	[DOT11F_EID_MOBILITYDOMAIN] = 7,
+	[DOT11F_EID_FTINFO] = 8,
+	[DOT11F_EID_TIMEOUTINTERVAL] = 9,
+	[DOT11F_EID_HTCAPS] = 10,
+	[DOT11F_EID_HTINFO] = 11,
+	[DOT11F_EID_OBSSSCANPARAMETERS] = 12,
+	[DOT11F_EID_EXTCAP] = 13,
+	[DOT11F_EID_BSS_MAX_IDLE_PERIOD] = 14,
+	[DOT11F_EID_QOSMAPSET] = 15,
+	[DOT11F_EID_VHTCAPS] = 16,
+	[DOT11F_EID_VHTOPERATION] = 17,
+	[DOT11F_EID_OPERATINGMODE] = 18,
+	[DOT11F_EID_RICDATADESC] = 29,
+	[DOT11F_EID_ESETXMITPOWER] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_FRAGMENT_IE] = 31,
+	[DOT11F_EID_WPA] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_REDUCED_NEIGHBOR_REPORT] = 48,
+};
+
+static const uint8_t IEX_AssocResponse_extn_eid[256] = {
+	[4] = 19,
+	[12] = 20,
+	[3] = 21,
+	[5] = 22,
+	[35] = 23,
+	[36] = 24,
+	[39] = 25,
+	[42] = 26,
+	[38] = 27,
+	[59] = 28,
+	[7] = 32,
+	[108] = 33,
+	[106] = 34,
+	[107] = 35,
+	[109] = 36,
+};
+
+static const uint8_t IEX_AssocResponse_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[1] = 46,
+	[2] = 37,
+	[5] = 44,
+	[6] = 30,
+	[12] = 45,
+};
+
+static const uint8_t IEX_AssocResponse_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 40, 0, 0, 0, 0, 0, 0, 38, 39, 42, 41, 0, 43, 0, 47, 0, 0,
+	0, 0, 0,
+};
+
+static const tIEIndex IEX_AssocResponse = {
+	IEX_AssocResponse_eid, IEX_AssocResponse_extn_eid, IEX_AssocResponse_oui, IEX_AssocResponse_next,
+};
+
 uint32_t dot11f_unpack_assoc_response(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fAssocResponse *pFrm, bool append_ie)
@@ -12020,7 +12463,7 @@ uint32_t dot11f_unpack_assoc_response(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_AssocResponse, IES_AssocResponse,
+		      FFS_AssocResponse, IES_AssocResponse, &IEX_AssocResponse,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12084,6 +12527,31 @@ static const tIEDefn IES_Authentication[] = {
 	0, DOT11F_EID_MLO_IE, 107, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_Authentication_eid[256] = {
+	[DOT11F_EID_CHALLENGETEXT] = 1,
+	[DOT11F_EID_RSNOPAQUE] = 2,
+	[DOT11F_EID_MOBILITYDOMAIN] = 3,
+	[DOT11F_EID_FTINFO] = 4,
+	[DOT11F_EID_TIMEOUTINTERVAL] = 5,
+	[DOT11F_EID_RICDATADESC] = 6,
+};
+
+static const uint8_t IEX_Authentication_extn_eid[256] = {
+	[13] = 7,
+	[4] = 8,
+	[8] = 9,
+	[1] = 10,
+	[107] = 11,
+};
+
+static const uint8_t IEX_Authentication_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_Authentication = {
+	IEX_Authentication_eid, IEX_Authentication_extn_eid, NULL, IEX_Authentication_next,
+};
+
 uint32_t dot11f_unpack_authentication(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fAuthentication *pFrm, bool append_ie)
@@ -12091,7 +12559,7 @@ uint32_t dot11f_unpack_authentication(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_Authentication, IES_Authentication,
+		      FFS_Authentication, IES_Authentication, &IEX_Authentication,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12341,6 +12809,85 @@ static const tIEDefn IES_Beacon[] = {
 	{0, 0, 0, 0, 0}, 0, DOT11F_EID_REDUCED_NEIGHBOR_REPORT, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_Beacon_eid[256] = {
+	[DOT11F_EID_SSID] = 1,
+	[DOT11F_EID_SUPPRATES] = 2,
+	[DOT11F_EID_FHPARAMSET] = 3,
+	[DOT11F_EID_DSPARAMS] = 4,
+	[DOT11F_EID_CFPARAMS] = 5,
+	[DOT11F_EID_TIM] = 6,
+	[DOT11F_EID_COUNTRY] = 7,
+	[DOT11F_EID_FHPARAMS] = 8,
+	[DOT11F_EID_FHPATTTABLE] = 9,
+	[DOT11F_EID_POWERCONSTRAINTS] = 10,
+	[DOT11F_EID_CHANSWITCHANN] = 11,
+	[DOT11F_EID_QUIET] = 12,
+	[DOT11F_EID_TPCREPORT] = 13,
+	[DOT11F_EID_ERPINFO] = 14,
+	[DOT11F_EID_EXTSUPPRATES] = 15,
+	[DOT11F_EID_RSNOPAQUE] = 16,
+	[DOT11F_EID_QBSSLOAD] = 17,
+	[DOT11F_EID_EDCAPARAMSET] = 18,
+	[DOT11F_EID_QOSCAPSAP] = 19,
+	[DOT11F_EID_APCHANNELREPORT] = 20,
+	[DOT11F_EID_RRMENABLEDCAP] = 21,
+	[DOT11F_EID_MOBILITYDOMAIN] = 22,
+	[DOT11F_EID_EXT_CHAN_SWITCH_ANN] = 23,
+	[DOT11F_EID_SUPPOPERATINGCLASSES] = 24,
+	[DOT11F_EID_HTCAPS] = 25,
+	[DOT11F_EID_HTINFO] = 26,
+	[DOT11F_EID_OBSSSCANPARAMETERS] = 27,
+	[DOT11F_EID_EXTCAP] = 28,
+	[DOT11F_EID_VHTCAPS] = 29,
+	[DOT11F_EID_VHTOPERATION] = 30,
+	[DOT11F_EID_TRANSMIT_POWER_ENV] = 31,
+	[DOT11F_EID_CHANNELSWITCHWRAPPER] = 32,
+	[DOT11F_EID_VHTEXTBSSLOAD] = 33,
+	[DOT11F_EID_OPERATINGMODE] = 34,
+	[DOT11F_EID_FILS_INDICATION] = 35,
+	[DOT11F_EID_SEC_CHAN_OFFSET_ELE] = 44,
+	[DOT11F_EID_WAPI] = 45,
+	[DOT11F_EID_ESETXMITPOWER] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_WIDERBWCHANSWITCHANN] = 47,
+	[DOT11F_EID_WPA] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_REDUCED_NEIGHBOR_REPORT] = 68,
+};
+
+static const uint8_t IEX_Beacon_extn_eid[256] = {
+	[52] = 36,
+	[11] = 37,
+	[35] = 38,
+	[36] = 39,
+	[39] = 40,
+	[42] = 41,
+	[38] = 42,
+	[59] = 43,
+	[108] = 48,
+	[106] = 49,
+	[107] = 50,
+	[109] = 51,
+};
+
+static const uint8_t IEX_Beacon_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[1] = 67,
+	[2] = 52,
+	[4] = 63,
+	[5] = 60,
+	[6] = 46,
+	[8] = 61,
+	[12] = 62,
+};
+
+static const uint8_t IEX_Beacon_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 56, 0, 0,
+	0, 0, 0, 53, 54, 55, 59, 57, 58, 65, 0, 64, 0, 0, 0, 66, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_Beacon = {
+	IEX_Beacon_eid, IEX_Beacon_extn_eid, IEX_Beacon_oui, IEX_Beacon_next,
+};
+
 uint32_t dot11f_unpack_beacon(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fBeacon *pFrm, bool append_ie)
@@ -12348,7 +12895,7 @@ uint32_t dot11f_unpack_beacon(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_Beacon, IES_Beacon,
+		      FFS_Beacon, IES_Beacon, &IEX_Beacon,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12377,6 +12924,20 @@ static const tIEDefn IES_Beacon1[] = {
 	0, DOT11F_EID_DSPARAMS, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_Beacon1_eid[256] = {
+	[DOT11F_EID_SSID] = 1,
+	[DOT11F_EID_SUPPRATES] = 2,
+	[DOT11F_EID_DSPARAMS] = 3,
+};
+
+static const uint8_t IEX_Beacon1_next[] = {
+	0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_Beacon1 = {
+	IEX_Beacon1_eid, NULL, NULL, IEX_Beacon1_next,
+};
+
 uint32_t dot11f_unpack_beacon1(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fBeacon1 *pFrm, bool append_ie)
@@ -12384,7 +12945,7 @@ uint32_t dot11f_unpack_beacon1(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_Beacon1, IES_Beacon1,
+		      FFS_Beacon1, IES_Beacon1, &IEX_Beacon1,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12598,6 +13159,75 @@ static const tIEDefn IES_Beacon2[] = {
 	{0, 0, 0, 0, 0}, 0, DOT11F_EID_REDUCED_NEIGHBOR_REPORT, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_Beacon2_eid[256] = {
+	[DOT11F_EID_COUNTRY] = 1,
+	[DOT11F_EID_POWERCONSTRAINTS] = 2,
+	[DOT11F_EID_CHANSWITCHANN] = 3,
+	[DOT11F_EID_QUIET] = 4,
+	[DOT11F_EID_TPCREPORT] = 5,
+	[DOT11F_EID_ERPINFO] = 6,
+	[DOT11F_EID_EXTSUPPRATES] = 7,
+	[DOT11F_EID_RSNOPAQUE] = 8,
+	[DOT11F_EID_EDCAPARAMSET] = 9,
+	[DOT11F_EID_APCHANNELREPORT] = 10,
+	[DOT11F_EID_RRMENABLEDCAP] = 11,
+	[DOT11F_EID_MOBILITYDOMAIN] = 12,
+	[DOT11F_EID_EXT_CHAN_SWITCH_ANN] = 13,
+	[DOT11F_EID_SUPPOPERATINGCLASSES] = 14,
+	[DOT11F_EID_HTCAPS] = 15,
+	[DOT11F_EID_HTINFO] = 16,
+	[DOT11F_EID_OBSSSCANPARAMETERS] = 17,
+	[DOT11F_EID_EXTCAP] = 18,
+	[DOT11F_EID_VHTCAPS] = 19,
+	[DOT11F_EID_VHTOPERATION] = 20,
+	[DOT11F_EID_TRANSMIT_POWER_ENV] = 21,
+	[DOT11F_EID_CHANNELSWITCHWRAPPER] = 22,
+	[DOT11F_EID_VHTEXTBSSLOAD] = 23,
+	[DOT11F_EID_OPERATINGMODE] = 24,
+	[DOT11F_EID_FILS_INDICATION] = 25,
+	[DOT11F_EID_SEC_CHAN_OFFSET_ELE] = 34,
+	[DOT11F_EID_WAPI] = 35,
+	[DOT11F_EID_ESETXMITPOWER] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_WIDERBWCHANSWITCHANN] = 37,
+	[DOT11F_EID_WPA] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_REDUCED_NEIGHBOR_REPORT] = 57,
+};
+
+static const uint8_t IEX_Beacon2_extn_eid[256] = {
+	[52] = 26,
+	[11] = 27,
+	[35] = 28,
+	[36] = 29,
+	[39] = 30,
+	[42] = 31,
+	[38] = 32,
+	[59] = 33,
+	[108] = 38,
+	[106] = 39,
+	[107] = 40,
+	[109] = 41,
+};
+
+static const uint8_t IEX_Beacon2_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[1] = 56,
+	[2] = 42,
+	[4] = 52,
+	[5] = 49,
+	[6] = 36,
+	[8] = 50,
+	[12] = 51,
+};
+
+static const uint8_t IEX_Beacon2_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 46, 0, 0, 0, 0, 0, 43, 44, 45, 48, 47,
+	54, 0, 53, 0, 0, 0, 0, 55, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_Beacon2 = {
+	IEX_Beacon2_eid, IEX_Beacon2_extn_eid, IEX_Beacon2_oui, IEX_Beacon2_next,
+};
+
 uint32_t dot11f_unpack_beacon2(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fBeacon2 *pFrm, bool append_ie)
@@ -12605,7 +13235,7 @@ uint32_t dot11f_unpack_beacon2(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_Beacon2, IES_Beacon2,
+		      FFS_Beacon2, IES_Beacon2, &IEX_Beacon2,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12856,6 +13486,85 @@ static const tIEDefn IES_BeaconIEs[] = {
 	{0, 0, 0, 0, 0}, 0, DOT11F_EID_REDUCED_NEIGHBOR_REPORT, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_BeaconIEs_eid[256] = {
+	[DOT11F_EID_SSID] = 1,
+	[DOT11F_EID_SUPPRATES] = 2,
+	[DOT11F_EID_FHPARAMSET] = 3,
+	[DOT11F_EID_DSPARAMS] = 4,
+	[DOT11F_EID_CFPARAMS] = 5,
+	[DOT11F_EID_TIM] = 6,
+	[DOT11F_EID_COUNTRY] = 7,
+	[DOT11F_EID_FHPARAMS] = 8,
+	[DOT11F_EID_FHPATTTABLE] = 9,
+	[DOT11F_EID_POWERCONSTRAINTS] = 10,
+	[DOT11F_EID_CHANSWITCHANN] = 11,
+	[DOT11F_EID_QUIET] = 12,
+	[DOT11F_EID_TPCREPORT] = 13,
+	[DOT11F_EID_ERPINFO] = 14,
+	[DOT11F_EID_EXTSUPPRATES] = 15,
+	[DOT11F_EID_RSNOPAQUE] = 16,
+	[DOT11F_EID_QBSSLOAD] = 17,
+	[DOT11F_EID_EDCAPARAMSET] = 18,
+	[DOT11F_EID_QOSCAPSAP] = 19,
+	[DOT11F_EID_APCHANNELREPORT] = 20,
+	[DOT11F_EID_RRMENABLEDCAP] = 21,
+	[DOT11F_EID_MOBILITYDOMAIN] = 22,
+	[DOT11F_EID_EXT_CHAN_SWITCH_ANN] = 23,
+	[DOT11F_EID_SUPPOPERATINGCLASSES] = 24,
+	[DOT11F_EID_HTCAPS] = 25,
+	[DOT11F_EID_HTINFO] = 26,
+	[DOT11F_EID_OBSSSCANPARAMETERS] = 27,
+	[DOT11F_EID_EXTCAP] = 28,
+	[DOT11F_EID_VHTCAPS] = 29,
+	[DOT11F_EID_VHTOPERATION] = 30,
+	[DOT11F_EID_TRANSMIT_POWER_ENV] = 31,
+	[DOT11F_EID_CHANNELSWITCHWRAPPER] = 32,
+	[DOT11F_EID_VHTEXTBSSLOAD] = 33,
+	[DOT11F_EID_OPERATINGMODE] = 34,
+	[DOT11F_EID_FILS_INDICATION] = 35,
+	[DOT11F_EID_SEC_CHAN_OFFSET_ELE] = 44,
+	[DOT11F_EID_WAPI] = 45,
+	[DOT11F_EID_ESETXMITPOWER] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_WIDERBWCHANSWITCHANN] = 47,
+	[DOT11F_EID_WPA] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_REDUCED_NEIGHBOR_REPORT] = 68,
+};
+
+static const uint8_t IEX_BeaconIEs_extn_eid[256] = {
+	[52] = 36,
+	[11] = 37,
+	[35] = 38,
+	[36] = 39,
+	[39] = 40,
+	[42] = 41,
+	[38] = 42,
+	[59] = 43,
+	[108] = 48,
+	[106] = 49,
+	[107] = 50,
+	[109] = 51,
+};
+
+static const uint8_t IEX_BeaconIEs_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[1] = 67,
+	[2] = 52,
+	[4] = 63,
+	[5] = 60,
+	[6] = 46,
+	[8] = 61,
+	[12] = 62,
+};
+
+static const uint8_t IEX_BeaconIEs_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 56, 0, 0,
+	0, 0, 0, 53, 54, 55, 59, 57, 58, 65, 0, 64, 0, 0, 0, 66, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_BeaconIEs = {
+	IEX_BeaconIEs_eid, IEX_BeaconIEs_extn_eid, IEX_BeaconIEs_oui, IEX_BeaconIEs_next,
+};
+
 uint32_t dot11f_unpack_beacon_i_es(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fBeaconIEs *pFrm, bool append_ie)
@@ -12863,7 +13572,7 @@ uint32_t dot11f_unpack_beacon_i_es(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_BeaconIEs, IES_BeaconIEs,
+		      FFS_BeaconIEs, IES_BeaconIEs, &IEX_BeaconIEs,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12894,6 +13603,20 @@ static const tIEDefn IES_ChannelSwitch[] = {
 	{0, 0, 0, 0, 0}, 0, DOT11F_EID_WIDERBWCHANSWITCHANN, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_ChannelSwitch_eid[256] = {
+	[DOT11F_EID_CHANSWITCHANN] = 1,
+	[DOT11F_EID_SEC_CHAN_OFFSET_ELE] = 2,
+	[DOT11F_EID_WIDERBWCHANSWITCHANN] = 3,
+};
+
+static const uint8_t IEX_ChannelSwitch_next[] = {
+	0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_ChannelSwitch = {
+	IEX_ChannelSwitch_eid, NULL, NULL, IEX_ChannelSwitch_next,
+};
+
 uint32_t dot11f_unpack_channel_switch(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fChannelSwitch *pFrm, bool append_ie)
@@ -12901,7 +13624,7 @@ uint32_t dot11f_unpack_channel_switch(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_ChannelSwitch, IES_ChannelSwitch,
+		      FFS_ChannelSwitch, IES_ChannelSwitch, &IEX_ChannelSwitch,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12921,6 +13644,22 @@ static const tIEDefn IES_DeAuth[] = {
 	4, DOT11F_EID_P2PDEAUTH, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_DeAuth_eid[256] = {
+	[DOT11F_EID_P2PDEAUTH] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_DeAuth_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[5] = 1,
+};
+
+static const uint8_t IEX_DeAuth_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_DeAuth = {
+	IEX_DeAuth_eid, NULL, IEX_DeAuth_oui, IEX_DeAuth_next,
+};
+
 uint32_t dot11f_unpack_de_auth(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fDeAuth *pFrm, bool append_ie)
@@ -12928,7 +13667,7 @@ uint32_t dot11f_unpack_de_auth(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_DeAuth, IES_DeAuth,
+		      FFS_DeAuth, IES_DeAuth, &IEX_DeAuth,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12951,6 +13690,8 @@ static const tFFDefn FFS_DelTS[] = {
 static const tIEDefn IES_DelTS[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_DelTS = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_del_ts(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fDelTS *pFrm, bool append_ie)
@@ -12958,7 +13699,7 @@ uint32_t dot11f_unpack_del_ts(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_DelTS, IES_DelTS,
+		      FFS_DelTS, IES_DelTS, &IEX_DelTS,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -12979,6 +13720,22 @@ static const tIEDefn IES_Disassociation[] = {
 	4, DOT11F_EID_P2PDISASSOC, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_Disassociation_eid[256] = {
+	[DOT11F_EID_P2PDISASSOC] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_Disassociation_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[5] = 1,
+};
+
+static const uint8_t IEX_Disassociation_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_Disassociation = {
+	IEX_Disassociation_eid, NULL, IEX_Disassociation_oui, IEX_Disassociation_next,
+};
+
 uint32_t dot11f_unpack_disassociation(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fDisassociation *pFrm, bool append_ie)
@@ -12986,7 +13743,7 @@ uint32_t dot11f_unpack_disassociation(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_Disassociation, IES_Disassociation,
+		      FFS_Disassociation, IES_Disassociation, &IEX_Disassociation,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13023,6 +13780,8 @@ static const tFFDefn FFS_LinkMeasurementReport[] = {
 static const tIEDefn IES_LinkMeasurementReport[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_LinkMeasurementReport = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_link_measurement_report(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fLinkMeasurementReport *pFrm, bool append_ie)
@@ -13030,7 +13789,7 @@ uint32_t dot11f_unpack_link_measurement_report(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_LinkMeasurementReport, IES_LinkMeasurementReport,
+		      FFS_LinkMeasurementReport, IES_LinkMeasurementReport, &IEX_LinkMeasurementReport,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13055,6 +13814,8 @@ static const tFFDefn FFS_LinkMeasurementRequest[] = {
 static const tIEDefn IES_LinkMeasurementRequest[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_LinkMeasurementRequest = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_link_measurement_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fLinkMeasurementRequest *pFrm, bool append_ie)
@@ -13062,7 +13823,7 @@ uint32_t dot11f_unpack_link_measurement_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_LinkMeasurementRequest, IES_LinkMeasurementRequest,
+		      FFS_LinkMeasurementRequest, IES_LinkMeasurementRequest, &IEX_LinkMeasurementRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13087,6 +13848,18 @@ static const tIEDefn IES_MeasurementReport[] = {
 	0, DOT11F_EID_MEASUREMENTREPORT, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_MeasurementReport_eid[256] = {
+	[DOT11F_EID_MEASUREMENTREPORT] = 1,
+};
+
+static const uint8_t IEX_MeasurementReport_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_MeasurementReport = {
+	IEX_MeasurementReport_eid, NULL, NULL, IEX_MeasurementReport_next,
+};
+
 uint32_t dot11f_unpack_measurement_report(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fMeasurementReport *pFrm, bool append_ie)
@@ -13094,7 +13867,7 @@ uint32_t dot11f_unpack_measurement_report(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_MeasurementReport, IES_MeasurementReport,
+		      FFS_MeasurementReport, IES_MeasurementReport, &IEX_MeasurementReport,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13120,6 +13893,18 @@ static const tIEDefn IES_MeasurementRequest[] = {
 	0, DOT11F_EID_MEASUREMENTREQUEST, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_MeasurementRequest_eid[256] = {
+	[DOT11F_EID_MEASUREMENTREQUEST] = 1,
+};
+
+static const uint8_t IEX_MeasurementRequest_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_MeasurementRequest = {
+	IEX_MeasurementRequest_eid, NULL, NULL, IEX_MeasurementRequest_next,
+};
+
 uint32_t dot11f_unpack_measurement_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fMeasurementRequest *pFrm, bool append_ie)
@@ -13127,7 +13912,7 @@ uint32_t dot11f_unpack_measurement_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_MeasurementRequest, IES_MeasurementRequest,
+		      FFS_MeasurementRequest, IES_MeasurementRequest, &IEX_MeasurementRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13151,6 +13936,18 @@ static const tIEDefn IES_NeighborReportRequest[] = {
 	0, DOT11F_EID_SSID, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_NeighborReportRequest_eid[256] = {
+	[DOT11F_EID_SSID] = 1,
+};
+
+static const uint8_t IEX_NeighborReportRequest_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_NeighborReportRequest = {
+	IEX_NeighborReportRequest_eid, NULL, NULL, IEX_NeighborReportRequest_next,
+};
+
 uint32_t dot11f_unpack_neighbor_report_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fNeighborReportRequest *pFrm, bool append_ie)
@@ -13158,7 +13955,7 @@ uint32_t dot11f_unpack_neighbor_report_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_NeighborReportRequest, IES_NeighborReportRequest,
+		      FFS_NeighborReportRequest, IES_NeighborReportRequest, &IEX_NeighborReportRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13184,6 +13981,18 @@ static const tIEDefn IES_NeighborReportResponse[] = {
 	0, DOT11F_EID_NEIGHBORREPORT, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_NeighborReportResponse_eid[256] = {
+	[DOT11F_EID_NEIGHBORREPORT] = 1,
+};
+
+static const uint8_t IEX_NeighborReportResponse_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_NeighborReportResponse = {
+	IEX_NeighborReportResponse_eid, NULL, NULL, IEX_NeighborReportResponse_next,
+};
+
 uint32_t dot11f_unpack_neighbor_report_response(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fNeighborReportResponse *pFrm, bool append_ie)
@@ -13191,7 +14000,7 @@ uint32_t dot11f_unpack_neighbor_report_response(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_NeighborReportResponse, IES_NeighborReportResponse,
+		      FFS_NeighborReportResponse, IES_NeighborReportResponse, &IEX_NeighborReportResponse,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13212,6 +14021,8 @@ static const tFFDefn FFS_OperatingMode[] = {
 static const tIEDefn IES_OperatingMode[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_OperatingMode = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_operating_mode(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fOperatingMode *pFrm, bool append_ie)
@@ -13219,7 +14030,7 @@ uint32_t dot11f_unpack_operating_mode(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_OperatingMode, IES_OperatingMode,
+		      FFS_OperatingMode, IES_OperatingMode, &IEX_OperatingMode,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13286,6 +14097,39 @@ static const tIEDefn IES_ProbeRequest[] = {
 	4, DOT11F_EID_QCN_IE, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_ProbeRequest_eid[256] = {
+	[DOT11F_EID_SSID] = 1,
+	[DOT11F_EID_SUPPRATES] = 2,
+	[DOT11F_EID_REQUESTEDINFO] = 3,
+	[DOT11F_EID_EXTSUPPRATES] = 4,
+	[DOT11F_EID_DSPARAMS] = 5,
+	[DOT11F_EID_HTCAPS] = 6,
+	[DOT11F_EID_EXTCAP] = 7,
+	[DOT11F_EID_VHTCAPS] = 8,
+	[DOT11F_EID_WSCPROBEREQ] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_ProbeRequest_extn_eid[256] = {
+	[35] = 9,
+	[59] = 10,
+	[108] = 11,
+	[107] = 12,
+};
+
+static const uint8_t IEX_ProbeRequest_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[1] = 16,
+	[2] = 13,
+	[5] = 15,
+};
+
+static const uint8_t IEX_ProbeRequest_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 14, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_ProbeRequest = {
+	IEX_ProbeRequest_eid, IEX_ProbeRequest_extn_eid, IEX_ProbeRequest_oui, IEX_ProbeRequest_next,
+};
+
 uint32_t dot11f_unpack_probe_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fProbeRequest *pFrm, bool append_ie)
@@ -13293,7 +14137,7 @@ uint32_t dot11f_unpack_probe_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_ProbeRequest, IES_ProbeRequest,
+		      FFS_ProbeRequest, IES_ProbeRequest, &IEX_ProbeRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13541,6 +14385,81 @@ static const tIEDefn IES_ProbeResponse[] = {
 	{0, 0, 0, 0, 0}, 0, DOT11F_EID_REDUCED_NEIGHBOR_REPORT, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_ProbeResponse_eid[256] = {
+	[DOT11F_EID_SSID] = 1,
+	[DOT11F_EID_SUPPRATES] = 2,
+	[DOT11F_EID_FHPARAMSET] = 3,
+	[DOT11F_EID_DSPARAMS] = 4,
+	[DOT11F_EID_CFPARAMS] = 5,
+	[DOT11F_EID_COUNTRY] = 6,
+	[DOT11F_EID_FHPARAMS] = 7,
+	[DOT11F_EID_FHPATTTABLE] = 8,
+	[DOT11F_EID_POWERCONSTRAINTS] = 9,
+	[DOT11F_EID_CHANSWITCHANN] = 10,
+	[DOT11F_EID_QUIET] = 11,
+	[DOT11F_EID_TPCREPORT] = 12,
+	[DOT11F_EID_ERPINFO] = 13,
+	[DOT11F_EID_EXTSUPPRATES] = 14,
+	[DOT11F_EID_RSNOPAQUE] = 15,
+	[DOT11F_EID_QBSSLOAD] = 16,
+	[DOT11F_EID_EDCAPARAMSET] = 17,
+	[DOT11F_EID_RRMENABLEDCAP] = 18,
+	[DOT11F_EID_APCHANNELREPORT] = 19,
+	[DOT11F_EID_MOBILITYDOMAIN] = 20,
+	[DOT11F_EID_EXT_CHAN_SWITCH_ANN] = 21,
+	[DOT11F_EID_SUPPOPERATINGCLASSES] = 22,
+	[DOT11F_EID_HTCAPS] = 23,
+	[DOT11F_EID_HTINFO] = 24,
+	[DOT11F_EID_OBSSSCANPARAMETERS] = 25,
+	[DOT11F_EID_EXTCAP] = 26,
+	[DOT11F_EID_VHTCAPS] = 27,
+	[DOT11F_EID_VHTOPERATION] = 28,
+	[DOT11F_EID_TRANSMIT_POWER_ENV] = 29,
+	[DOT11F_EID_CHANNELSWITCHWRAPPER] = 30,
+	[DOT11F_EID_VHTEXTBSSLOAD] = 31,
+	[DOT11F_EID_FILS_INDICATION] = 32,
+	[DOT11F_EID_SEC_CHAN_OFFSET_ELE] = 41,
+	[DOT11F_EID_WAPI] = 42,
+	[DOT11F_EID_ESETXMITPOWER] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_WPA] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_REDUCED_NEIGHBOR_REPORT] = 64,
+};
+
+static const uint8_t IEX_ProbeResponse_extn_eid[256] = {
+	[52] = 33,
+	[11] = 34,
+	[35] = 35,
+	[36] = 36,
+	[39] = 37,
+	[42] = 38,
+	[38] = 39,
+	[59] = 40,
+	[108] = 44,
+	[106] = 45,
+	[107] = 46,
+	[109] = 47,
+};
+
+static const uint8_t IEX_ProbeResponse_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[1] = 63,
+	[2] = 48,
+	[4] = 59,
+	[5] = 56,
+	[6] = 43,
+	[8] = 57,
+	[12] = 58,
+};
+
+static const uint8_t IEX_ProbeResponse_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 52, 0, 0, 0, 0,
+	49, 50, 51, 55, 53, 54, 61, 0, 60, 0, 0, 0, 62, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_ProbeResponse = {
+	IEX_ProbeResponse_eid, IEX_ProbeResponse_extn_eid, IEX_ProbeResponse_oui, IEX_ProbeResponse_next,
+};
+
 uint32_t dot11f_unpack_probe_response(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fProbeResponse *pFrm, bool append_ie)
@@ -13548,7 +14467,7 @@ uint32_t dot11f_unpack_probe_response(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_ProbeResponse, IES_ProbeResponse,
+		      FFS_ProbeResponse, IES_ProbeResponse, &IEX_ProbeResponse,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13571,6 +14490,18 @@ static const tIEDefn IES_QosMapConfigure[] = {
 	0, DOT11F_EID_QOSMAPSET, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_QosMapConfigure_eid[256] = {
+	[DOT11F_EID_QOSMAPSET] = 1,
+};
+
+static const uint8_t IEX_QosMapConfigure_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_QosMapConfigure = {
+	IEX_QosMapConfigure_eid, NULL, NULL, IEX_QosMapConfigure_next,
+};
+
 uint32_t dot11f_unpack_qos_map_configure(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fQosMapConfigure *pFrm, bool append_ie)
@@ -13578,7 +14509,7 @@ uint32_t dot11f_unpack_qos_map_configure(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_QosMapConfigure, IES_QosMapConfigure,
+		      FFS_QosMapConfigure, IES_QosMapConfigure, &IEX_QosMapConfigure,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13604,6 +14535,18 @@ static const tIEDefn IES_RadioMeasurementReport[] = {
 	0, DOT11F_EID_MEASUREMENTREPORT, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_RadioMeasurementReport_eid[256] = {
+	[DOT11F_EID_MEASUREMENTREPORT] = 1,
+};
+
+static const uint8_t IEX_RadioMeasurementReport_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_RadioMeasurementReport = {
+	IEX_RadioMeasurementReport_eid, NULL, NULL, IEX_RadioMeasurementReport_next,
+};
+
 uint32_t dot11f_unpack_radio_measurement_report(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fRadioMeasurementReport *pFrm, bool append_ie)
@@ -13611,7 +14554,7 @@ uint32_t dot11f_unpack_radio_measurement_report(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_RadioMeasurementReport, IES_RadioMeasurementReport,
+		      FFS_RadioMeasurementReport, IES_RadioMeasurementReport, &IEX_RadioMeasurementReport,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13640,6 +14583,18 @@ static const tIEDefn IES_RadioMeasurementRequest[] = {
 	0, DOT11F_EID_MEASUREMENTREQUEST, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_RadioMeasurementRequest_eid[256] = {
+	[DOT11F_EID_MEASUREMENTREQUEST] = 1,
+};
+
+static const uint8_t IEX_RadioMeasurementRequest_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_RadioMeasurementRequest = {
+	IEX_RadioMeasurementRequest_eid, NULL, NULL, IEX_RadioMeasurementRequest_next,
+};
+
 uint32_t dot11f_unpack_radio_measurement_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fRadioMeasurementRequest *pFrm, bool append_ie)
@@ -13647,7 +14602,7 @@ uint32_t dot11f_unpack_radio_measurement_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_RadioMeasurementRequest, IES_RadioMeasurementRequest,
+		      FFS_RadioMeasurementRequest, IES_RadioMeasurementRequest, &IEX_RadioMeasurementRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13811,6 +14766,54 @@ static const tIEDefn IES_ReAssocRequest[] = {
 	4, DOT11F_EID_HS20VENDOR_IE, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_ReAssocRequest_eid[256] = {
+	[DOT11F_EID_SSID] = 1,
+	[DOT11F_EID_SUPPRATES] = 2,
+	[DOT11F_EID_EXTSUPPRATES] = 3,
+	[DOT11F_EID_POWERCAPS] = 4,
+	[DOT11F_EID_SUPPCHANNELS] = 5,
+	[DOT11F_EID_RSNOPAQUE] = 6,
+	[DOT11F_EID_QOSCAPSSTATION] = 7,
+	[DOT11F_EID_RRMENABLEDCAP] = 8,
+	[DOT11F_EID_MOBILITYDOMAIN] = 9,
+	[DOT11F_EID_FTINFO] = 10,
+	[DOT11F_EID_RICDATADESC] = 11,
+	[DOT11F_EID_SUPPOPERATINGCLASSES] = 12,
+	[DOT11F_EID_HTCAPS] = 13,
+	[DOT11F_EID_EXTCAP] = 14,
+	[DOT11F_EID_VHTCAPS] = 15,
+	[DOT11F_EID_OPERATINGMODE] = 16,
+	[DOT11F_EID_BSS_MAX_IDLE_PERIOD] = 17,
+	[DOT11F_EID_WAPIOPAQUE] = 20,
+	[DOT11F_EID_QOSMAPSET] = 22,
+	[DOT11F_EID_ESECCKMOPAQUE] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_WPAOPAQUE] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_ReAssocRequest_extn_eid[256] = {
+	[35] = 18,
+	[59] = 19,
+	[108] = 24,
+	[107] = 25,
+	[109] = 26,
+};
+
+static const uint8_t IEX_ReAssocRequest_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 27,
+	[5] = 35,
+	[6] = 23,
+	[12] = 37,
+};
+
+static const uint8_t IEX_ReAssocRequest_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 21, 0, 0, 31,
+	0, 0, 0, 28, 29, 30, 33, 32, 34, 0, 0, 36, 38, 0, 0, 0,
+};
+
+static const tIEIndex IEX_ReAssocRequest = {
+	IEX_ReAssocRequest_eid, IEX_ReAssocRequest_extn_eid, IEX_ReAssocRequest_oui, IEX_ReAssocRequest_next,
+};
+
 uint32_t dot11f_unpack_re_assoc_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fReAssocRequest *pFrm, bool append_ie)
@@ -13818,7 +14821,7 @@ uint32_t dot11f_unpack_re_assoc_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_ReAssocRequest, IES_ReAssocRequest,
+		      FFS_ReAssocRequest, IES_ReAssocRequest, &IEX_ReAssocRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -13994,6 +14997,61 @@ static const tIEDefn IES_ReAssocResponse[] = {
 	{0, 0, 0, 0, 0}, 0, DOT11F_EID_REDUCED_NEIGHBOR_REPORT, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_ReAssocResponse_eid[256] = {
+	[DOT11F_EID_SUPPRATES] = 1,
+	[DOT11F_EID_EXTSUPPRATES] = 2,
+	[DOT11F_EID_EDCAPARAMSET] = 3,
+	[DOT11F_EID_RCPIIE] = 4,
+	[DOT11F_EID_RSNIIE] = 5,
+	[DOT11F_EID_RRMENABLEDCAP] = 6,
+	[DOT11F_EID_RSNOPAQUE] = 7,
+	[DOT11F_EID_MOBILITYDOMAIN] = 8,
+	[DOT11F_EID_FTINFO] = 9,
+	[DOT11F_EID_RICDATADESC] = 10,
+	[DOT11F_EID_TIMEOUTINTERVAL] = 11,
+	[DOT11F_EID_HTCAPS] = 12,
+	[DOT11F_EID_HTINFO] = 13,
+	[DOT11F_EID_OBSSSCANPARAMETERS] = 14,
+	[DOT11F_EID_EXTCAP] = 15,
+	[DOT11F_EID_BSS_MAX_IDLE_PERIOD] = 16,
+	[DOT11F_EID_VHTCAPS] = 17,
+	[DOT11F_EID_VHTOPERATION] = 18,
+	[DOT11F_EID_OPERATINGMODE] = 19,
+	[DOT11F_EID_QOSMAPSET] = 26,
+	[DOT11F_EID_ESETXMITPOWER] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_WPA] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_REDUCED_NEIGHBOR_REPORT] = 42,
+};
+
+static const uint8_t IEX_ReAssocResponse_extn_eid[256] = {
+	[35] = 20,
+	[36] = 21,
+	[39] = 22,
+	[42] = 23,
+	[38] = 24,
+	[59] = 25,
+	[108] = 28,
+	[106] = 29,
+	[107] = 30,
+	[109] = 31,
+};
+
+static const uint8_t IEX_ReAssocResponse_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 32,
+	[5] = 39,
+	[6] = 27,
+	[12] = 40,
+};
+
+static const uint8_t IEX_ReAssocResponse_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 34, 0, 0, 0, 0, 33, 36, 35, 37, 38, 0, 0, 41, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_ReAssocResponse = {
+	IEX_ReAssocResponse_eid, IEX_ReAssocResponse_extn_eid, IEX_ReAssocResponse_oui, IEX_ReAssocResponse_next,
+};
+
 uint32_t dot11f_unpack_re_assoc_response(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fReAssocResponse *pFrm, bool append_ie)
@@ -14001,7 +15059,7 @@ uint32_t dot11f_unpack_re_assoc_response(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_ReAssocResponse, IES_ReAssocResponse,
+		      FFS_ReAssocResponse, IES_ReAssocResponse, &IEX_ReAssocResponse,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14022,6 +15080,8 @@ static const tFFDefn FFS_SMPowerSave[] = {
 static const tIEDefn IES_SMPowerSave[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_SMPowerSave = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_sm_power_save(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fSMPowerSave *pFrm, bool append_ie)
@@ -14029,7 +15089,7 @@ uint32_t dot11f_unpack_sm_power_save(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_SMPowerSave, IES_SMPowerSave,
+		      FFS_SMPowerSave, IES_SMPowerSave, &IEX_SMPowerSave,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14052,6 +15112,21 @@ static const tIEDefn IES_SaQueryReq[] = {
 	"oci", 0, 5, 5, SigIeoci, {0, 0, 0, 0, 0}, 0, DOT11F_EID_OCI, 54, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_SaQueryReq_eid[256] = {
+};
+
+static const uint8_t IEX_SaQueryReq_extn_eid[256] = {
+	[54] = 1,
+};
+
+static const uint8_t IEX_SaQueryReq_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_SaQueryReq = {
+	IEX_SaQueryReq_eid, IEX_SaQueryReq_extn_eid, NULL, IEX_SaQueryReq_next,
+};
+
 uint32_t dot11f_unpack_sa_query_req(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fSaQueryReq *pFrm, bool append_ie)
@@ -14059,7 +15134,7 @@ uint32_t dot11f_unpack_sa_query_req(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_SaQueryReq, IES_SaQueryReq,
+		      FFS_SaQueryReq, IES_SaQueryReq, &IEX_SaQueryReq,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14082,6 +15157,21 @@ static const tIEDefn IES_SaQueryRsp[] = {
 	"oci", 0, 5, 5, SigIeoci, {0, 0, 0, 0, 0}, 0, DOT11F_EID_OCI, 54, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_SaQueryRsp_eid[256] = {
+};
+
+static const uint8_t IEX_SaQueryRsp_extn_eid[256] = {
+	[54] = 1,
+};
+
+static const uint8_t IEX_SaQueryRsp_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_SaQueryRsp = {
+	IEX_SaQueryRsp_eid, IEX_SaQueryRsp_extn_eid, NULL, IEX_SaQueryRsp_next,
+};
+
 uint32_t dot11f_unpack_sa_query_rsp(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fSaQueryRsp *pFrm, bool append_ie)
@@ -14089,7 +15179,7 @@ uint32_t dot11f_unpack_sa_query_rsp(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_SaQueryRsp, IES_SaQueryRsp,
+		      FFS_SaQueryRsp, IES_SaQueryRsp, &IEX_SaQueryRsp,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14114,6 +15204,18 @@ static const tIEDefn IES_TDLSDisReq[] = {
 	0, DOT11F_EID_LINKIDENTIFIER, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TDLSDisReq_eid[256] = {
+	[DOT11F_EID_LINKIDENTIFIER] = 1,
+};
+
+static const uint8_t IEX_TDLSDisReq_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_TDLSDisReq = {
+	IEX_TDLSDisReq_eid, NULL, NULL, IEX_TDLSDisReq_next,
+};
+
 uint32_t dot11f_unpack_tdls_dis_req(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTDLSDisReq *pFrm, bool append_ie)
@@ -14121,7 +15223,7 @@ uint32_t dot11f_unpack_tdls_dis_req(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TDLSDisReq, IES_TDLSDisReq,
+		      FFS_TDLSDisReq, IES_TDLSDisReq, &IEX_TDLSDisReq,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14191,6 +15293,34 @@ static const tIEDefn IES_TDLSDisRsp[] = {
 	0, DOT11F_EID_HE_CAP, 35, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TDLSDisRsp_eid[256] = {
+	[DOT11F_EID_SUPPRATES] = 1,
+	[DOT11F_EID_EXTSUPPRATES] = 2,
+	[DOT11F_EID_SUPPCHANNELS] = 3,
+	[DOT11F_EID_SUPPOPERATINGCLASSES] = 4,
+	[DOT11F_EID_RSN] = 5,
+	[DOT11F_EID_EXTCAP] = 6,
+	[DOT11F_EID_FTINFO] = 7,
+	[DOT11F_EID_TIMEOUTINTERVAL] = 8,
+	[DOT11F_EID_RICDATA] = 9,
+	[DOT11F_EID_HTCAPS] = 10,
+	[DOT11F_EID_HT2040_BSS_COEXISTENCE] = 11,
+	[DOT11F_EID_LINKIDENTIFIER] = 12,
+	[DOT11F_EID_VHTCAPS] = 13,
+};
+
+static const uint8_t IEX_TDLSDisRsp_extn_eid[256] = {
+	[35] = 14,
+};
+
+static const uint8_t IEX_TDLSDisRsp_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_TDLSDisRsp = {
+	IEX_TDLSDisRsp_eid, IEX_TDLSDisRsp_extn_eid, NULL, IEX_TDLSDisRsp_next,
+};
+
 uint32_t dot11f_unpack_tdls_dis_rsp(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTDLSDisRsp *pFrm, bool append_ie)
@@ -14198,7 +15328,7 @@ uint32_t dot11f_unpack_tdls_dis_rsp(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TDLSDisRsp, IES_TDLSDisRsp,
+		      FFS_TDLSDisRsp, IES_TDLSDisRsp, &IEX_TDLSDisRsp,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14231,6 +15361,20 @@ static const tIEDefn IES_TDLSPeerTrafficInd[] = {
 	0, DOT11F_EID_PUBUFFERSTATUS, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TDLSPeerTrafficInd_eid[256] = {
+	[DOT11F_EID_LINKIDENTIFIER] = 1,
+	[DOT11F_EID_PTICONTROL] = 2,
+	[DOT11F_EID_PUBUFFERSTATUS] = 3,
+};
+
+static const uint8_t IEX_TDLSPeerTrafficInd_next[] = {
+	0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_TDLSPeerTrafficInd = {
+	IEX_TDLSPeerTrafficInd_eid, NULL, NULL, IEX_TDLSPeerTrafficInd_next,
+};
+
 uint32_t dot11f_unpack_tdls_peer_traffic_ind(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTDLSPeerTrafficInd *pFrm, bool append_ie)
@@ -14238,7 +15382,7 @@ uint32_t dot11f_unpack_tdls_peer_traffic_ind(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TDLSPeerTrafficInd, IES_TDLSPeerTrafficInd,
+		      FFS_TDLSPeerTrafficInd, IES_TDLSPeerTrafficInd, &IEX_TDLSPeerTrafficInd,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14263,6 +15407,18 @@ static const tIEDefn IES_TDLSPeerTrafficRsp[] = {
 	0, DOT11F_EID_LINKIDENTIFIER, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TDLSPeerTrafficRsp_eid[256] = {
+	[DOT11F_EID_LINKIDENTIFIER] = 1,
+};
+
+static const uint8_t IEX_TDLSPeerTrafficRsp_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_TDLSPeerTrafficRsp = {
+	IEX_TDLSPeerTrafficRsp_eid, NULL, NULL, IEX_TDLSPeerTrafficRsp_next,
+};
+
 uint32_t dot11f_unpack_tdls_peer_traffic_rsp(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTDLSPeerTrafficRsp *pFrm, bool append_ie)
@@ -14270,7 +15426,7 @@ uint32_t dot11f_unpack_tdls_peer_traffic_rsp(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TDLSPeerTrafficRsp, IES_TDLSPeerTrafficRsp,
+		      FFS_TDLSPeerTrafficRsp, IES_TDLSPeerTrafficRsp, &IEX_TDLSPeerTrafficRsp,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14327,6 +15483,34 @@ static const tIEDefn IES_TDLSSetupCnf[] = {
 	0, DOT11F_EID_HE_OP, 36, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TDLSSetupCnf_eid[256] = {
+	[DOT11F_EID_RSN] = 1,
+	[DOT11F_EID_EDCAPARAMSET] = 2,
+	[DOT11F_EID_FTINFO] = 3,
+	[DOT11F_EID_TIMEOUTINTERVAL] = 4,
+	[DOT11F_EID_HTINFO] = 5,
+	[DOT11F_EID_LINKIDENTIFIER] = 6,
+	[DOT11F_EID_WMMPARAMS] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_VHTOPERATION] = 8,
+	[DOT11F_EID_OPERATINGMODE] = 9,
+};
+
+static const uint8_t IEX_TDLSSetupCnf_extn_eid[256] = {
+	[36] = 10,
+};
+
+static const uint8_t IEX_TDLSSetupCnf_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 7,
+};
+
+static const uint8_t IEX_TDLSSetupCnf_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_TDLSSetupCnf = {
+	IEX_TDLSSetupCnf_eid, IEX_TDLSSetupCnf_extn_eid, IEX_TDLSSetupCnf_oui, IEX_TDLSSetupCnf_next,
+};
+
 uint32_t dot11f_unpack_tdls_setup_cnf(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTDLSSetupCnf *pFrm, bool append_ie)
@@ -14334,7 +15518,7 @@ uint32_t dot11f_unpack_tdls_setup_cnf(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TDLSSetupCnf, IES_TDLSSetupCnf,
+		      FFS_TDLSSetupCnf, IES_TDLSSetupCnf, &IEX_TDLSSetupCnf,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14421,6 +15605,43 @@ static const tIEDefn IES_TDLSSetupReq[] = {
 	0, DOT11F_EID_HE_6GHZ_BAND_CAP, 59, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TDLSSetupReq_eid[256] = {
+	[DOT11F_EID_SUPPRATES] = 1,
+	[DOT11F_EID_COUNTRY] = 2,
+	[DOT11F_EID_EXTSUPPRATES] = 3,
+	[DOT11F_EID_SUPPCHANNELS] = 4,
+	[DOT11F_EID_RSN] = 5,
+	[DOT11F_EID_EXTCAP] = 6,
+	[DOT11F_EID_SUPPOPERATINGCLASSES] = 7,
+	[DOT11F_EID_QOSCAPSSTATION] = 8,
+	[DOT11F_EID_FTINFO] = 9,
+	[DOT11F_EID_TIMEOUTINTERVAL] = 10,
+	[DOT11F_EID_RICDATA] = 11,
+	[DOT11F_EID_HTCAPS] = 12,
+	[DOT11F_EID_HT2040_BSS_COEXISTENCE] = 13,
+	[DOT11F_EID_LINKIDENTIFIER] = 14,
+	[DOT11F_EID_WMMINFOSTATION] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_AID] = 16,
+	[DOT11F_EID_VHTCAPS] = 17,
+};
+
+static const uint8_t IEX_TDLSSetupReq_extn_eid[256] = {
+	[35] = 18,
+	[59] = 19,
+};
+
+static const uint8_t IEX_TDLSSetupReq_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 15,
+};
+
+static const uint8_t IEX_TDLSSetupReq_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_TDLSSetupReq = {
+	IEX_TDLSSetupReq_eid, IEX_TDLSSetupReq_extn_eid, IEX_TDLSSetupReq_oui, IEX_TDLSSetupReq_next,
+};
+
 uint32_t dot11f_unpack_tdls_setup_req(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTDLSSetupReq *pFrm, bool append_ie)
@@ -14428,7 +15649,7 @@ uint32_t dot11f_unpack_tdls_setup_req(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TDLSSetupReq, IES_TDLSSetupReq,
+		      FFS_TDLSSetupReq, IES_TDLSSetupReq, &IEX_TDLSSetupReq,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14521,6 +15742,44 @@ static const tIEDefn IES_TDLSSetupRsp[] = {
 	0, DOT11F_EID_HE_6GHZ_BAND_CAP, 59, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TDLSSetupRsp_eid[256] = {
+	[DOT11F_EID_SUPPRATES] = 1,
+	[DOT11F_EID_COUNTRY] = 2,
+	[DOT11F_EID_EXTSUPPRATES] = 3,
+	[DOT11F_EID_SUPPCHANNELS] = 4,
+	[DOT11F_EID_RSN] = 5,
+	[DOT11F_EID_EXTCAP] = 6,
+	[DOT11F_EID_SUPPOPERATINGCLASSES] = 7,
+	[DOT11F_EID_QOSCAPSSTATION] = 8,
+	[DOT11F_EID_FTINFO] = 9,
+	[DOT11F_EID_TIMEOUTINTERVAL] = 10,
+	[DOT11F_EID_RICDATA] = 11,
+	[DOT11F_EID_HTCAPS] = 12,
+	[DOT11F_EID_HT2040_BSS_COEXISTENCE] = 13,
+	[DOT11F_EID_LINKIDENTIFIER] = 14,
+	[DOT11F_EID_WMMINFOSTATION] = DOT11F_IE_INDEX_OUI,
+	[DOT11F_EID_AID] = 16,
+	[DOT11F_EID_VHTCAPS] = 17,
+	[DOT11F_EID_OPERATINGMODE] = 18,
+};
+
+static const uint8_t IEX_TDLSSetupRsp_extn_eid[256] = {
+	[35] = 19,
+	[59] = 20,
+};
+
+static const uint8_t IEX_TDLSSetupRsp_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 15,
+};
+
+static const uint8_t IEX_TDLSSetupRsp_next[] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_TDLSSetupRsp = {
+	IEX_TDLSSetupRsp_eid, IEX_TDLSSetupRsp_extn_eid, IEX_TDLSSetupRsp_oui, IEX_TDLSSetupRsp_next,
+};
+
 uint32_t dot11f_unpack_tdls_setup_rsp(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTDLSSetupRsp *pFrm, bool append_ie)
@@ -14528,7 +15787,7 @@ uint32_t dot11f_unpack_tdls_setup_rsp(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TDLSSetupRsp, IES_TDLSSetupRsp,
+		      FFS_TDLSSetupRsp, IES_TDLSSetupRsp, &IEX_TDLSSetupRsp,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14556,6 +15815,19 @@ static const tIEDefn IES_TDLSTeardown[] = {
 	0, DOT11F_EID_LINKIDENTIFIER, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TDLSTeardown_eid[256] = {
+	[DOT11F_EID_FTINFO] = 1,
+	[DOT11F_EID_LINKIDENTIFIER] = 2,
+};
+
+static const uint8_t IEX_TDLSTeardown_next[] = {
+	0, 0, 0,
+};
+
+static const tIEIndex IEX_TDLSTeardown = {
+	IEX_TDLSTeardown_eid, NULL, NULL, IEX_TDLSTeardown_next,
+};
+
 uint32_t dot11f_unpack_tdls_teardown(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTDLSTeardown *pFrm, bool append_ie)
@@ -14563,7 +15835,7 @@ uint32_t dot11f_unpack_tdls_teardown(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TDLSTeardown, IES_TDLSTeardown,
+		      FFS_TDLSTeardown, IES_TDLSTeardown, &IEX_TDLSTeardown,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14587,6 +15859,18 @@ static const tIEDefn IES_TPCReport[] = {
 	0, DOT11F_EID_TPCREPORT, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TPCReport_eid[256] = {
+	[DOT11F_EID_TPCREPORT] = 1,
+};
+
+static const uint8_t IEX_TPCReport_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_TPCReport = {
+	IEX_TPCReport_eid, NULL, NULL, IEX_TPCReport_next,
+};
+
 uint32_t dot11f_unpack_tpc_report(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTPCReport *pFrm, bool append_ie)
@@ -14594,7 +15878,7 @@ uint32_t dot11f_unpack_tpc_report(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TPCReport, IES_TPCReport,
+		      FFS_TPCReport, IES_TPCReport, &IEX_TPCReport,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14618,6 +15902,18 @@ static const tIEDefn IES_TPCRequest[] = {
 	0, DOT11F_EID_TPCREQUEST, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TPCRequest_eid[256] = {
+	[DOT11F_EID_TPCREQUEST] = 1,
+};
+
+static const uint8_t IEX_TPCRequest_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_TPCRequest = {
+	IEX_TPCRequest_eid, NULL, NULL, IEX_TPCRequest_next,
+};
+
 uint32_t dot11f_unpack_tpc_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTPCRequest *pFrm, bool append_ie)
@@ -14625,7 +15921,7 @@ uint32_t dot11f_unpack_tpc_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TPCRequest, IES_TPCRequest,
+		      FFS_TPCRequest, IES_TPCRequest, &IEX_TPCRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14666,6 +15962,27 @@ static const tIEDefn IES_TimingAdvertisementFrame[] = {
 	3, DOT11F_EID_VENDOR3IE, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_TimingAdvertisementFrame_eid[256] = {
+	[DOT11F_EID_COUNTRY] = 1,
+	[DOT11F_EID_POWERCONSTRAINTS] = 2,
+	[DOT11F_EID_TIMEADVERTISEMENT] = 3,
+	[DOT11F_EID_EXTCAP] = 4,
+	[DOT11F_EID_VENDOR1IE] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_TimingAdvertisementFrame_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[4] = 6,
+	[8] = 5,
+};
+
+static const uint8_t IEX_TimingAdvertisementFrame_next[] = {
+	0, 0, 0, 0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_TimingAdvertisementFrame = {
+	IEX_TimingAdvertisementFrame_eid, NULL, IEX_TimingAdvertisementFrame_oui, IEX_TimingAdvertisementFrame_next,
+};
+
 uint32_t dot11f_unpack_timing_advertisement_frame(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fTimingAdvertisementFrame *pFrm, bool append_ie)
@@ -14673,7 +15990,7 @@ uint32_t dot11f_unpack_timing_advertisement_frame(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_TimingAdvertisementFrame, IES_TimingAdvertisementFrame,
+		      FFS_TimingAdvertisementFrame, IES_TimingAdvertisementFrame, &IEX_TimingAdvertisementFrame,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14699,6 +16016,8 @@ static const tFFDefn FFS_VHTGidManagementActionFrame[] = {
 static const tIEDefn IES_VHTGidManagementActionFrame[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_VHTGidManagementActionFrame = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_vht_gid_management_action_frame(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fVHTGidManagementActionFrame *pFrm, bool append_ie)
@@ -14706,7 +16025,7 @@ uint32_t dot11f_unpack_vht_gid_management_action_frame(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_VHTGidManagementActionFrame, IES_VHTGidManagementActionFrame,
+		      FFS_VHTGidManagementActionFrame, IES_VHTGidManagementActionFrame, &IEX_VHTGidManagementActionFrame,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14736,6 +16055,23 @@ static const tIEDefn IES_WMMAddTSRequest[] = {
 	4, DOT11F_EID_ESETRAFSTRMRATESET, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_WMMAddTSRequest_eid[256] = {
+	[DOT11F_EID_WMMTSPEC] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_WMMAddTSRequest_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 1,
+	[6] = 2,
+};
+
+static const uint8_t IEX_WMMAddTSRequest_next[] = {
+	0, 0, 0,
+};
+
+static const tIEIndex IEX_WMMAddTSRequest = {
+	IEX_WMMAddTSRequest_eid, NULL, IEX_WMMAddTSRequest_oui, IEX_WMMAddTSRequest_next,
+};
+
 uint32_t dot11f_unpack_wmm_add_ts_request(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fWMMAddTSRequest *pFrm, bool append_ie)
@@ -14743,7 +16079,7 @@ uint32_t dot11f_unpack_wmm_add_ts_request(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_WMMAddTSRequest, IES_WMMAddTSRequest,
+		      FFS_WMMAddTSRequest, IES_WMMAddTSRequest, &IEX_WMMAddTSRequest,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14774,6 +16110,23 @@ static const tIEDefn IES_WMMAddTSResponse[] = {
 	4, DOT11F_EID_ESETRAFSTRMMET, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_WMMAddTSResponse_eid[256] = {
+	[DOT11F_EID_WMMTSPEC] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_WMMAddTSResponse_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 1,
+	[6] = 2,
+};
+
+static const uint8_t IEX_WMMAddTSResponse_next[] = {
+	0, 0, 0,
+};
+
+static const tIEIndex IEX_WMMAddTSResponse = {
+	IEX_WMMAddTSResponse_eid, NULL, IEX_WMMAddTSResponse_oui, IEX_WMMAddTSResponse_next,
+};
+
 uint32_t dot11f_unpack_wmm_add_ts_response(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fWMMAddTSResponse *pFrm, bool append_ie)
@@ -14781,7 +16134,7 @@ uint32_t dot11f_unpack_wmm_add_ts_response(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_WMMAddTSResponse, IES_WMMAddTSResponse,
+		      FFS_WMMAddTSResponse, IES_WMMAddTSResponse, &IEX_WMMAddTSResponse,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14807,6 +16160,22 @@ static const tIEDefn IES_WMMDelTS[] = {
 	5, DOT11F_EID_WMMTSPEC, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_WMMDelTS_eid[256] = {
+	[DOT11F_EID_WMMTSPEC] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_WMMDelTS_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[2] = 1,
+};
+
+static const uint8_t IEX_WMMDelTS_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_WMMDelTS = {
+	IEX_WMMDelTS_eid, NULL, IEX_WMMDelTS_oui, IEX_WMMDelTS_next,
+};
+
 uint32_t dot11f_unpack_wmm_del_ts(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fWMMDelTS *pFrm, bool append_ie)
@@ -14814,7 +16183,7 @@ uint32_t dot11f_unpack_wmm_del_ts(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_WMMDelTS, IES_WMMDelTS,
+		      FFS_WMMDelTS, IES_WMMDelTS, &IEX_WMMDelTS,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14845,6 +16214,18 @@ static const tIEDefn IES_addba_req[] = {
 	0, DOT11F_EID_ADDBA_EXTN_ELEMENT, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_addba_req_eid[256] = {
+	[DOT11F_EID_ADDBA_EXTN_ELEMENT] = 1,
+};
+
+static const uint8_t IEX_addba_req_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_addba_req = {
+	IEX_addba_req_eid, NULL, NULL, IEX_addba_req_next,
+};
+
 uint32_t dot11f_unpack_addba_req(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11faddba_req *pFrm, bool append_ie)
@@ -14852,7 +16233,7 @@ uint32_t dot11f_unpack_addba_req(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_addba_req, IES_addba_req,
+		      FFS_addba_req, IES_addba_req, &IEX_addba_req,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14883,6 +16264,18 @@ static const tIEDefn IES_addba_rsp[] = {
 	0, DOT11F_EID_ADDBA_EXTN_ELEMENT, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_addba_rsp_eid[256] = {
+	[DOT11F_EID_ADDBA_EXTN_ELEMENT] = 1,
+};
+
+static const uint8_t IEX_addba_rsp_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_addba_rsp = {
+	IEX_addba_rsp_eid, NULL, NULL, IEX_addba_rsp_next,
+};
+
 uint32_t dot11f_unpack_addba_rsp(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11faddba_rsp *pFrm, bool append_ie)
@@ -14890,7 +16283,7 @@ uint32_t dot11f_unpack_addba_rsp(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_addba_rsp, IES_addba_rsp,
+		      FFS_addba_rsp, IES_addba_rsp, &IEX_addba_rsp,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14913,6 +16306,8 @@ static const tFFDefn FFS_delba_req[] = {
 static const tIEDefn IES_delba_req[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_delba_req = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_delba_req(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fdelba_req *pFrm, bool append_ie)
@@ -14920,7 +16315,7 @@ uint32_t dot11f_unpack_delba_req(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_delba_req, IES_delba_req,
+		      FFS_delba_req, IES_delba_req, &IEX_delba_req,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14941,6 +16336,8 @@ static const tFFDefn FFS_epcs_neg_req[] = {
 static const tIEDefn IES_epcs_neg_req[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_epcs_neg_req = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_epcs_neg_req(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fepcs_neg_req *pFrm, bool append_ie)
@@ -14948,7 +16345,7 @@ uint32_t dot11f_unpack_epcs_neg_req(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_epcs_neg_req, IES_epcs_neg_req,
+		      FFS_epcs_neg_req, IES_epcs_neg_req, &IEX_epcs_neg_req,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14971,6 +16368,8 @@ static const tFFDefn FFS_epcs_neg_rsp[] = {
 static const tIEDefn IES_epcs_neg_rsp[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_epcs_neg_rsp = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_epcs_neg_rsp(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fepcs_neg_rsp *pFrm, bool append_ie)
@@ -14978,7 +16377,7 @@ uint32_t dot11f_unpack_epcs_neg_rsp(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_epcs_neg_rsp, IES_epcs_neg_rsp,
+		      FFS_epcs_neg_rsp, IES_epcs_neg_rsp, &IEX_epcs_neg_rsp,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -14997,6 +16396,8 @@ static const tFFDefn FFS_epcs_teardown[] = {
 static const tIEDefn IES_epcs_teardown[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_epcs_teardown = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_epcs_teardown(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fepcs_teardown *pFrm, bool append_ie)
@@ -15004,7 +16405,7 @@ uint32_t dot11f_unpack_epcs_teardown(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_epcs_teardown, IES_epcs_teardown,
+		      FFS_epcs_teardown, IES_epcs_teardown, &IEX_epcs_teardown,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -15038,6 +16439,27 @@ static const tIEDefn IES_ext_channel_switch_action_frame[] = {
 	0, DOT11F_EID_BW_IND_ELEMENT, 135, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_ext_channel_switch_action_frame_eid[256] = {
+	[DOT11F_EID_WIDERBWCHANSWITCHANN] = 1,
+	[DOT11F_EID_QCN_IE] = DOT11F_IE_INDEX_OUI,
+};
+
+static const uint8_t IEX_ext_channel_switch_action_frame_extn_eid[256] = {
+	[135] = 3,
+};
+
+static const uint8_t IEX_ext_channel_switch_action_frame_oui[DOT11F_IE_INDEX_OUI_BUCKETS] = {
+	[1] = 2,
+};
+
+static const uint8_t IEX_ext_channel_switch_action_frame_next[] = {
+	0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_ext_channel_switch_action_frame = {
+	IEX_ext_channel_switch_action_frame_eid, IEX_ext_channel_switch_action_frame_extn_eid, IEX_ext_channel_switch_action_frame_oui, IEX_ext_channel_switch_action_frame_next,
+};
+
 uint32_t dot11f_unpack_ext_channel_switch_action_frame(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fext_channel_switch_action_frame *pFrm, bool append_ie)
@@ -15045,7 +16467,7 @@ uint32_t dot11f_unpack_ext_channel_switch_action_frame(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_ext_channel_switch_action_frame, IES_ext_channel_switch_action_frame,
+		      FFS_ext_channel_switch_action_frame, IES_ext_channel_switch_action_frame, &IEX_ext_channel_switch_action_frame,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -15075,6 +16497,19 @@ static const tIEDefn IES_ht2040_bss_coexistence_mgmt_action_frame[] = {
 	0, DOT11F_EID_HT2040_BSS_INTOLERANT_REPORT, 0, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_ht2040_bss_coexistence_mgmt_action_frame_eid[256] = {
+	[DOT11F_EID_HT2040_BSS_COEXISTENCE] = 1,
+	[DOT11F_EID_HT2040_BSS_INTOLERANT_REPORT] = 2,
+};
+
+static const uint8_t IEX_ht2040_bss_coexistence_mgmt_action_frame_next[] = {
+	0, 0, 0,
+};
+
+static const tIEIndex IEX_ht2040_bss_coexistence_mgmt_action_frame = {
+	IEX_ht2040_bss_coexistence_mgmt_action_frame_eid, NULL, NULL, IEX_ht2040_bss_coexistence_mgmt_action_frame_next,
+};
+
 uint32_t dot11f_unpack_ht2040_bss_coexistence_mgmt_action_frame(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fht2040_bss_coexistence_mgmt_action_frame *pFrm, bool append_ie)
@@ -15082,7 +16517,7 @@ uint32_t dot11f_unpack_ht2040_bss_coexistence_mgmt_action_frame(tpAniSirGlobal p
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_ht2040_bss_coexistence_mgmt_action_frame, IES_ht2040_bss_coexistence_mgmt_action_frame,
+		      FFS_ht2040_bss_coexistence_mgmt_action_frame, IES_ht2040_bss_coexistence_mgmt_action_frame, &IEX_ht2040_bss_coexistence_mgmt_action_frame,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -15107,6 +16542,21 @@ static const tIEDefn IES_mscs_request_action_frame[] = {
 	0, DOT11F_EID_DESCRIPTOR_ELEMENT, 88, 1, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_mscs_request_action_frame_eid[256] = {
+};
+
+static const uint8_t IEX_mscs_request_action_frame_extn_eid[256] = {
+	[88] = 1,
+};
+
+static const uint8_t IEX_mscs_request_action_frame_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_mscs_request_action_frame = {
+	IEX_mscs_request_action_frame_eid, IEX_mscs_request_action_frame_extn_eid, NULL, IEX_mscs_request_action_frame_next,
+};
+
 uint32_t dot11f_unpack_mscs_request_action_frame(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fmscs_request_action_frame *pFrm, bool append_ie)
@@ -15114,7 +16564,7 @@ uint32_t dot11f_unpack_mscs_request_action_frame(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_mscs_request_action_frame, IES_mscs_request_action_frame,
+		      FFS_mscs_request_action_frame, IES_mscs_request_action_frame, &IEX_mscs_request_action_frame,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -15148,6 +16598,20 @@ static const tIEDefn IES_p2p_oper_chan_change_confirm[] = {
 	0, DOT11F_EID_OPERATINGMODE, 0, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_p2p_oper_chan_change_confirm_eid[256] = {
+	[DOT11F_EID_HTCAPS] = 1,
+	[DOT11F_EID_VHTCAPS] = 2,
+	[DOT11F_EID_OPERATINGMODE] = 3,
+};
+
+static const uint8_t IEX_p2p_oper_chan_change_confirm_next[] = {
+	0, 0, 0, 0,
+};
+
+static const tIEIndex IEX_p2p_oper_chan_change_confirm = {
+	IEX_p2p_oper_chan_change_confirm_eid, NULL, NULL, IEX_p2p_oper_chan_change_confirm_next,
+};
+
 uint32_t dot11f_unpack_p2p_oper_chan_change_confirm(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fp2p_oper_chan_change_confirm *pFrm, bool append_ie)
@@ -15155,7 +16619,7 @@ uint32_t dot11f_unpack_p2p_oper_chan_change_confirm(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_p2p_oper_chan_change_confirm, IES_p2p_oper_chan_change_confirm,
+		      FFS_p2p_oper_chan_change_confirm, IES_p2p_oper_chan_change_confirm, &IEX_p2p_oper_chan_change_confirm,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -15180,6 +16644,21 @@ static const tIEDefn IES_t2lm_neg_req[] = {
 	0, DOT11F_EID_T2LM_IE, 109, 0, },
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const uint8_t IEX_t2lm_neg_req_eid[256] = {
+};
+
+static const uint8_t IEX_t2lm_neg_req_extn_eid[256] = {
+	[109] = 1,
+};
+
+static const uint8_t IEX_t2lm_neg_req_next[] = {
+	0, 0,
+};
+
+static const tIEIndex IEX_t2lm_neg_req = {
+	IEX_t2lm_neg_req_eid, IEX_t2lm_neg_req_extn_eid, NULL, IEX_t2lm_neg_req_next,
+};
+
 uint32_t dot11f_unpack_t2lm_neg_req(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11ft2lm_neg_req *pFrm, bool append_ie)
@@ -15187,7 +16666,7 @@ uint32_t dot11f_unpack_t2lm_neg_req(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_t2lm_neg_req, IES_t2lm_neg_req,
+		      FFS_t2lm_neg_req, IES_t2lm_neg_req, &IEX_t2lm_neg_req,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -15210,6 +16689,8 @@ static const tFFDefn FFS_t2lm_neg_rsp[] = {
 static const tIEDefn IES_t2lm_neg_rsp[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_t2lm_neg_rsp = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_t2lm_neg_rsp(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11ft2lm_neg_rsp *pFrm, bool append_ie)
@@ -15217,7 +16698,7 @@ uint32_t dot11f_unpack_t2lm_neg_rsp(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_t2lm_neg_rsp, IES_t2lm_neg_rsp,
+		      FFS_t2lm_neg_rsp, IES_t2lm_neg_rsp, &IEX_t2lm_neg_rsp,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -15236,6 +16717,8 @@ static const tFFDefn FFS_t2lm_teardown[] = {
 static const tIEDefn IES_t2lm_teardown[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_t2lm_teardown = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_t2lm_teardown(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11ft2lm_teardown *pFrm, bool append_ie)
@@ -15243,7 +16726,7 @@ uint32_t dot11f_unpack_t2lm_teardown(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_t2lm_teardown, IES_t2lm_teardown,
+		      FFS_t2lm_teardown, IES_t2lm_teardown, &IEX_t2lm_teardown,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -15265,6 +16748,8 @@ static const tFFDefn FFS_vendor_action_frame[] = {
 static const tIEDefn IES_vendor_action_frame[] = {
 	{0, 0, 0, NULL, 0, 0, 0, 0, {0, 0, 0, 0, 0}, 0, 0xff, 0, },};
 
+static const tIEIndex IEX_vendor_action_frame = { NULL, NULL, NULL, NULL, };
+
 uint32_t dot11f_unpack_vendor_action_frame(tpAniSirGlobal pCtx,
 		uint8_t *pBuf, uint32_t nBuf,
 		tDot11fvendor_action_frame *pFrm, bool append_ie)
@@ -15272,7 +16757,7 @@ uint32_t dot11f_unpack_vendor_action_frame(tpAniSirGlobal pCtx,
 	uint32_t i = 0;
 	uint32_t status = 0;
 	status = unpack_core(pCtx, pBuf, nBuf,
-		      FFS_vendor_action_frame, IES_vendor_action_frame,
+		      FFS_vendor_action_frame, IES_vendor_action_frame, &IEX_vendor_action_frame,
 		      (uint8_t *)pFrm, sizeof(*pFrm), append_ie);
 
 	(void)i;
@@ -15290,6 +16775,7 @@ static uint32_t unpack_core(tpAniSirGlobal pCtx,
 			    uint32_t nBuf,
 			    const tFFDefn  FFs[],
 			    const tIEDefn  IEs[],
+			    const tIEIndex *IEX,
 			    uint8_t *pFrm,
 			    size_t nFrm,
 			    bool append_ie)
@@ -15549,7 +17035,7 @@ static uint32_t unpack_core(tpAniSirGlobal pCtx,
 			goto MandatoryCheck;
 		}
 
-		pIe = find_ie_defn(pCtx, pBufRemaining, nBufRemaining, IEs);
+		pIe = find_ie_defn(pCtx, pBufRemaining, nBufRemaining, IEs, IEX);
 
 		eid = *pBufRemaining++; --nBufRemaining;
 		len = *pBufRemaining++; --nBufRemaining;
@@ -16584,7 +18070,7 @@ static uint32_t unpack_core(tpAniSirGlobal pCtx,
 						nBufRemaining += pIe->noui;
 						len += pIe->noui;
 					}
-					status |= get_container_ies_len(pCtx, pBufRemaining, nBufRemaining, &len, IES_RICDataDesc);
+					status |= get_container_ies_len(pCtx, pBufRemaining, nBufRemaining, &len, IES_RICDataDesc, &IEX_RICDataDesc);
 					if (status != DOT11F_PARSE_SUCCESS && status != DOT11F_UNKNOWN_IES)
 						 break;
 					status |=
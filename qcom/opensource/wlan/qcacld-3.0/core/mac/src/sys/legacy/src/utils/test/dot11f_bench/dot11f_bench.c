@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) Qualcomm Technologies, Inc. and/or its subsidiaries.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*
+ * dot11f_bench - host benchmark of the dot11f IE lookup
+ *
+ * Parses a corpus of beacons and probe responses with the indexed IE
+ * lookup of dot11f.c and with the linear table scan it replaced (dot11f.c
+ * built with DOT11F_LINEAR_IE_LOOKUP, symbols prefixed with ref_), checks
+ * that both produce byte for byte the same unpacked frame and status, and
+ * reports the time taken by each.
+ *
+ * The corpus is a text file with one frame per line, "beacon <hex>" or
+ * "probe_rsp <hex>", where <hex> is the frame body that follows the 802.11
+ * MAC header. Without one, frames are synthesized from a set of commonly
+ * seen IEs. See the Makefile for the build.
+ *
+ * Usage: dot11f_bench [-f corpus] [-n frames] [-r rounds] [-s seed]
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "ani_global.h"
+#include "dot11f.h"
+
+#define BENCH_MAX_FRAME 2048
+
+enum bench_frame_type {
+	BENCH_BEACON,
+	BENCH_PROBE_RSP,
+};
+
+struct bench_frame {
+	enum bench_frame_type type;
+	uint32_t len;
+	uint8_t *body;
+};
+
+uint32_t ref_dot11f_unpack_beacon(tpAniSirGlobal pCtx, uint8_t *pBuf,
+				  uint32_t nBuf, tDot11fBeacon *pFrm,
+				  bool append_ie);
+uint32_t ref_dot11f_unpack_probe_response(tpAniSirGlobal pCtx, uint8_t *pBuf,
+					  uint32_t nBuf,
+					  tDot11fProbeResponse *pFrm,
+					  bool append_ie);
+
+/**
+ * struct bench_ie - IE used to synthesize frames
+ * @eid: element ID
+ * @min_len: minimum length of the IE body
+ * @max_len: maximum length of the IE body
+ * @prefix_len: number of valid bytes in @prefix
+ * @prefix: fixed leading bytes of the body (extension EID, OUI, ...)
+ * @pct: percentage of frames carrying the IE
+ */
+struct bench_ie {
+	uint8_t eid;
+	uint8_t min_len;
+	uint8_t max_len;
+	uint8_t prefix_len;
+	uint8_t prefix[6];
+	uint8_t pct;
+};
+
+static const struct bench_ie bench_ies[] = {
+	{ 0, 0, 32, 0, {0}, 100 },			/* SSID */
+	{ 1, 8, 8, 0, {0}, 100 },			/* Supported rates */
+	{ 3, 1, 1, 0, {0}, 90 },			/* DS params */
+	{ 5, 4, 8, 0, {0}, 100 },			/* TIM */
+	{ 7, 6, 12, 0, {0}, 60 },			/* Country */
+	{ 11, 5, 5, 0, {0}, 50 },			/* BSS load */
+	{ 32, 1, 1, 0, {0}, 20 },			/* Power constraint */
+	{ 45, 26, 26, 0, {0}, 90 },			/* HT capabilities */
+	{ 48, 20, 26, 0, {0}, 80 },			/* RSN */
+	{ 50, 4, 4, 0, {0}, 60 },			/* Ext supported rates */
+	{ 54, 3, 3, 0, {0}, 10 },			/* Mobility domain */
+	{ 61, 22, 22, 0, {0}, 90 },			/* HT operation */
+	{ 70, 5, 5, 0, {0}, 50 },			/* RM enabled caps */
+	{ 127, 8, 10, 0, {0}, 90 },			/* Extended caps */
+	{ 191, 12, 12, 0, {0}, 70 },			/* VHT capabilities */
+	{ 192, 5, 5, 0, {0}, 70 },			/* VHT operation */
+	{ 195, 2, 5, 0, {0}, 30 },			/* Tx power envelope */
+	{ 200, 1, 20, 0, {0}, 10 },			/* unknown */
+	{ 255, 22, 30, 1, {35}, 60 },			/* HE capabilities */
+	{ 255, 7, 10, 1, {36}, 60 },			/* HE operation */
+	{ 255, 14, 14, 1, {38}, 40 },			/* MU EDCA */
+	{ 255, 3, 3, 1, {59}, 20 },			/* HE 6 GHz band caps */
+	{ 255, 9, 20, 1, {108}, 15 },			/* EHT capabilities */
+	{ 255, 5, 12, 1, {106}, 15 },			/* EHT operation */
+	{ 221, 22, 22, 4, {0x00, 0x50, 0xf2, 0x01}, 20 }, /* WPA */
+	{ 221, 24, 24, 5, {0x00, 0x50, 0xf2, 0x02, 0x01}, 90 }, /* WMM */
+	{ 221, 10, 40, 4, {0x00, 0x50, 0xf2, 0x04}, 30 }, /* WSC */
+	{ 221, 8, 30, 4, {0x50, 0x6f, 0x9a, 0x09}, 10 }, /* P2P */
+	{ 221, 7, 7, 4, {0x50, 0x6f, 0x9a, 0x16}, 20 }, /* MBO/OCE */
+	{ 221, 7, 9, 4, {0x50, 0x6f, 0x9a, 0x10}, 10 }, /* HS 2.0 */
+	{ 221, 7, 9, 3, {0x00, 0x10, 0x18}, 30 },	/* Broadcom */
+	{ 221, 6, 12, 3, {0x00, 0xa0, 0xc6}, 20 },	/* Qualcomm */
+	{ 221, 6, 12, 3, {0x00, 0x03, 0x7f}, 20 },	/* Atheros */
+	{ 221, 6, 12, 3, {0x8c, 0xfd, 0xf0}, 20 },	/* unknown vendor */
+};
+
+static uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint32_t bench_synth(uint8_t *buf)
+{
+	const struct bench_ie *ie;
+	uint32_t len = 12, i, n, j;
+
+	/* timestamp, beacon interval and capabilities */
+	for (i = 0; i < len; i++)
+		buf[i] = rand();
+
+	for (i = 0; i < sizeof(bench_ies) / sizeof(bench_ies[0]); i++) {
+		ie = &bench_ies[i];
+		if (rand() % 100 >= ie->pct)
+			continue;
+
+		n = ie->min_len + rand() % (ie->max_len - ie->min_len + 1);
+		if (len + 2 + n > BENCH_MAX_FRAME)
+			break;
+
+		buf[len++] = ie->eid;
+		buf[len++] = n;
+		for (j = 0; j < n; j++)
+			buf[len + j] = j < ie->prefix_len ? ie->prefix[j] : rand();
+		len += n;
+	}
+
+	return len;
+}
+
+static int bench_hex(int c)
+{
+	if (isdigit(c))
+		return c - '0';
+	c = tolower(c);
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+static uint32_t bench_load(const char *path, struct bench_frame *frames,
+			   uint32_t max)
+{
+	static char line[2 * BENCH_MAX_FRAME + 64];
+	uint8_t body[BENCH_MAX_FRAME];
+	char *p;
+	uint32_t n = 0, len;
+	FILE *fp;
+
+	fp = fopen(path, "r");
+	if (!fp) {
+		perror(path);
+		exit(1);
+	}
+
+	while (n < max && fgets(line, sizeof(line), fp)) {
+		if (line[0] == '#' || isspace(line[0]))
+			continue;
+
+		if (!strncmp(line, "beacon ", 7)) {
+			frames[n].type = BENCH_BEACON;
+			p = line + 7;
+		} else if (!strncmp(line, "probe_rsp ", 10)) {
+			frames[n].type = BENCH_PROBE_RSP;
+			p = line + 10;
+		} else {
+			continue;
+		}
+
+		len = 0;
+		while (len < BENCH_MAX_FRAME && bench_hex(p[0]) >= 0 &&
+		       bench_hex(p[1]) >= 0) {
+			body[len++] = bench_hex(p[0]) << 4 | bench_hex(p[1]);
+			p += 2;
+		}
+
+		frames[n].len = len;
+		frames[n].body = malloc(len);
+		memcpy(frames[n].body, body, len);
+		n++;
+	}
+
+	fclose(fp);
+	return n;
+}
+
+static uint32_t bench_unpack(struct bench_frame *frame, void *out, bool ref)
+{
+	if (frame->type == BENCH_BEACON) {
+		if (ref)
+			return ref_dot11f_unpack_beacon(NULL, frame->body,
+							frame->len, out, false);
+		return dot11f_unpack_beacon(NULL, frame->body, frame->len,
+					    out, false);
+	}
+
+	if (ref)
+		return ref_dot11f_unpack_probe_response(NULL, frame->body,
+							frame->len, out, false);
+	return dot11f_unpack_probe_response(NULL, frame->body, frame->len,
+					    out, false);
+}
+
+static uint64_t bench_time(struct bench_frame *frames, uint32_t num,
+			   uint32_t rounds, void *out, bool ref)
+{
+	uint64_t start;
+	uint32_t r, i;
+
+	start = bench_now_ns();
+	for (r = 0; r < rounds; r++)
+		for (i = 0; i < num; i++)
+			bench_unpack(&frames[i], out, ref);
+
+	return bench_now_ns() - start;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t out_size = sizeof(tDot11fBeacon) > sizeof(tDot11fProbeResponse) ?
+			  sizeof(tDot11fBeacon) : sizeof(tDot11fProbeResponse);
+	struct bench_frame *frames;
+	const char *path = NULL;
+	uint32_t num = 10000, rounds = 20, seed = 1;
+	uint32_t i, status, ref_status, mismatch = 0;
+	uint64_t ref_ns, new_ns, ies = 0;
+	uint8_t buf[BENCH_MAX_FRAME];
+	void *out, *ref_out;
+	uint32_t pos;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "f:n:r:s:")) != -1) {
+		switch (opt) {
+		case 'f':
+			path = optarg;
+			break;
+		case 'n':
+			num = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			rounds = strtoul(optarg, NULL, 0);
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-f corpus] [-n frames] "
+				"[-r rounds] [-s seed]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	frames = calloc(num, sizeof(*frames));
+	out = malloc(out_size);
+	ref_out = malloc(out_size);
+	if (!frames || !out || !ref_out)
+		return 1;
+
+	if (path) {
+		num = bench_load(path, frames, num);
+	} else {
+		srand(seed);
+		for (i = 0; i < num; i++) {
+			frames[i].type = i & 1 ? BENCH_PROBE_RSP : BENCH_BEACON;
+			frames[i].len = bench_synth(buf);
+			frames[i].body = malloc(frames[i].len);
+			memcpy(frames[i].body, buf, frames[i].len);
+		}
+	}
+
+	for (i = 0; i < num; i++) {
+		for (pos = 12; pos + 2 <= frames[i].len;
+		     pos += 2 + frames[i].body[pos + 1])
+			ies++;
+
+		memset(out, 0, out_size);
+		memset(ref_out, 0, out_size);
+		status = bench_unpack(&frames[i], out, false);
+		ref_status = bench_unpack(&frames[i], ref_out, true);
+		if (status != ref_status || memcmp(out, ref_out, out_size)) {
+			fprintf(stderr, "frame %u: output differs (status 0x%x, ref 0x%x)\n",
+				i, status, ref_status);
+			mismatch++;
+		}
+	}
+
+	ref_ns = bench_time(frames, num, rounds, ref_out, true);
+	new_ns = bench_time(frames, num, rounds, out, false);
+
+	printf("frames %u, %.1f IEs per frame, %u rounds\n", num,
+	       num ? (double)ies / num : 0.0, rounds);
+	printf("linear lookup:  %8.1f ns/frame\n",
+	       (double)ref_ns / ((uint64_t)num * rounds));
+	printf("indexed lookup: %8.1f ns/frame (%.2fx)\n",
+	       (double)new_ns / ((uint64_t)num * rounds),
+	       new_ns ? (double)ref_ns / new_ns : 0.0);
+	printf("mismatches: %u\n", mismatch);
+
+	return mismatch ? 1 : 0;
+}
@@ -495,6 +495,7 @@ _fixed_srcs = [
     "cmn/umac/scan/core/src/wlan_scan_11d.c",
     "cmn/umac/scan/core/src/wlan_scan_cache_db.c",
     "cmn/umac/scan/core/src/wlan_scan_filter.c",
+    "cmn/umac/scan/core/src/wlan_scan_ie_index.c",
     "cmn/umac/scan/core/src/wlan_scan_main.c",
     "cmn/umac/scan/core/src/wlan_scan_manager.c",
     "cmn/umac/scan/dispatcher/src/wlan_scan_api.c",